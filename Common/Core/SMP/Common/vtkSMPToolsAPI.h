@@ -219,6 +219,96 @@ public:
     }
   }
 
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename BinaryOp>
+  OutputIt InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        return this->SequentialBackend->InclusiveScan(inBegin, inEnd, outBegin, op);
+      case BackendType::STDThread:
+        return this->STDThreadBackend->InclusiveScan(inBegin, inEnd, outBegin, op);
+      case BackendType::TBB:
+        return this->TBBBackend->InclusiveScan(inBegin, inEnd, outBegin, op);
+      case BackendType::OpenMP:
+        return this->OpenMPBackend->InclusiveScan(inBegin, inEnd, outBegin, op);
+    }
+    return outBegin;
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  OutputIt ExclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        return this->SequentialBackend->ExclusiveScan(inBegin, inEnd, outBegin, init, op);
+      case BackendType::STDThread:
+        return this->STDThreadBackend->ExclusiveScan(inBegin, inEnd, outBegin, init, op);
+      case BackendType::TBB:
+        return this->TBBBackend->ExclusiveScan(inBegin, inEnd, outBegin, init, op);
+      case BackendType::OpenMP:
+        return this->OpenMPBackend->ExclusiveScan(inBegin, inEnd, outBegin, init, op);
+    }
+    return outBegin;
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename Iterator, typename T, typename BinaryOp>
+  T Reduce(Iterator begin, Iterator end, T init, BinaryOp op)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        return this->SequentialBackend->Reduce(begin, end, init, op);
+      case BackendType::STDThread:
+        return this->STDThreadBackend->Reduce(begin, end, init, op);
+      case BackendType::TBB:
+        return this->TBBBackend->Reduce(begin, end, init, op);
+      case BackendType::OpenMP:
+        return this->OpenMPBackend->Reduce(begin, end, init, op);
+    }
+    return init;
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename Predicate>
+  OutputIt CopyIf(InputIt inBegin, InputIt inEnd, OutputIt outBegin, Predicate pred)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        return this->SequentialBackend->CopyIf(inBegin, inEnd, outBegin, pred);
+      case BackendType::STDThread:
+        return this->STDThreadBackend->CopyIf(inBegin, inEnd, outBegin, pred);
+      case BackendType::TBB:
+        return this->TBBBackend->CopyIf(inBegin, inEnd, outBegin, pred);
+      case BackendType::OpenMP:
+        return this->OpenMPBackend->CopyIf(inBegin, inEnd, outBegin, pred);
+    }
+    return outBegin;
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename Iterator, typename Predicate>
+  Iterator Partition(Iterator begin, Iterator end, Predicate pred)
+  {
+    switch (this->ActivatedBackend)
+    {
+      case BackendType::Sequential:
+        return this->SequentialBackend->Partition(begin, end, pred);
+      case BackendType::STDThread:
+        return this->STDThreadBackend->Partition(begin, end, pred);
+      case BackendType::TBB:
+        return this->TBBBackend->Partition(begin, end, pred);
+      case BackendType::OpenMP:
+        return this->OpenMPBackend->Partition(begin, end, pred);
+    }
+    return begin;
+  }
+
   // disable copying
   vtkSMPToolsAPI(vtkSMPToolsAPI const&) = delete;
   void operator=(vtkSMPToolsAPI const&) = delete;
@@ -92,6 +92,26 @@ public:
   template <typename RandomAccessIterator, typename Compare>
   void Sort(RandomAccessIterator begin, RandomAccessIterator end, Compare comp);
 
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename BinaryOp>
+  OutputIt InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op);
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  OutputIt ExclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op);
+
+  //--------------------------------------------------------------------------------
+  template <typename Iterator, typename T, typename BinaryOp>
+  T Reduce(Iterator begin, Iterator end, T init, BinaryOp op);
+
+  //--------------------------------------------------------------------------------
+  template <typename InputIt, typename OutputIt, typename Predicate>
+  OutputIt CopyIf(InputIt inBegin, InputIt inEnd, OutputIt outBegin, Predicate pred);
+
+  //--------------------------------------------------------------------------------
+  template <typename Iterator, typename Predicate>
+  Iterator Partition(Iterator begin, Iterator end, Predicate pred);
+
   //--------------------------------------------------------------------------------
   vtkSMPToolsImpl();
 
@@ -4,7 +4,9 @@
 #ifndef vtkSMPToolsInternal_h
 #define vtkSMPToolsInternal_h
 
-#include <iterator> // For std::advance
+#include <algorithm> // For std::min
+#include <iterator>  // For std::advance
+#include <vector>    // For std::vector
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace vtk
@@ -90,6 +92,316 @@ public:
   T operator()(T vtkNotUsed(inValue)) { return Value; }
 };
 
+//--------------------------------------------------------------------------------
+// Helpers for the scan, reduce and compaction algorithms. The input range is
+// split in a few contiguous chunks per thread: a first parallel pass computes
+// one value per chunk (partial reduction or number of selected elements), a
+// short serial scan over the chunks turns these into chunk offsets and a second
+// parallel pass finalizes each chunk from its offset. Chunks are always
+// combined in order, so the binary operations only need to be associative.
+// These helpers are shared by the threaded backends through their For().
+template <typename Functor>
+class ChunkCall
+{
+  Functor& F;
+
+public:
+  ChunkCall(Functor& f)
+    : F(f)
+  {
+  }
+
+  void Execute(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType chunk = begin; chunk < end; ++chunk)
+    {
+      this->F(chunk);
+    }
+  }
+};
+
+struct ChunkedAlgorithms
+{
+  // Below this size the serial algorithm is faster than the two passes.
+  static constexpr vtkIdType MinimumChunkSize = 4096;
+
+  static vtkIdType GetNumberOfChunks(vtkIdType size, int numberOfThreads)
+  {
+    const vtkIdType maxChunks = static_cast<vtkIdType>(numberOfThreads) * 4;
+    const vtkIdType chunks = size / MinimumChunkSize;
+    return std::max<vtkIdType>(1, std::min(chunks, maxChunks));
+  }
+
+  static vtkIdType GetChunkBegin(vtkIdType chunk, vtkIdType numChunks, vtkIdType size)
+  {
+    return chunk * (size / numChunks) + std::min(chunk, size % numChunks);
+  }
+
+  template <typename Impl, typename Functor>
+  static void ForEachChunk(Impl& impl, vtkIdType numChunks, Functor f)
+  {
+    ChunkCall<Functor> call(f);
+    impl.For(0, numChunks, 1, call);
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename Impl, typename InputIt, typename OutputIt, typename BinaryOp>
+  static OutputIt InclusiveScan(
+    Impl& impl, InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+  {
+    using T = typename std::iterator_traits<InputIt>::value_type;
+    const vtkIdType size = std::distance(inBegin, inEnd);
+    const vtkIdType numChunks = GetNumberOfChunks(size, impl.GetEstimatedNumberOfThreads());
+    auto scanChunk = [&](vtkIdType begin, vtkIdType end, const T* prefix)
+    {
+      InputIt in = std::next(inBegin, begin);
+      OutputIt out = std::next(outBegin, begin);
+      T acc = prefix ? op(*prefix, static_cast<T>(*in)) : static_cast<T>(*in);
+      *out = acc;
+      for (vtkIdType i = begin + 1; i < end; ++i)
+      {
+        acc = op(acc, static_cast<T>(*++in));
+        *++out = acc;
+      }
+    };
+    if (size <= 0)
+    {
+      return outBegin;
+    }
+    if (numChunks == 1)
+    {
+      scanChunk(0, size, nullptr);
+      return std::next(outBegin, size);
+    }
+
+    std::vector<T> sums(numChunks);
+    ForEachChunk(impl, numChunks - 1,
+      [&](vtkIdType chunk)
+      {
+        const vtkIdType end = GetChunkBegin(chunk + 1, numChunks, size);
+        InputIt in = std::next(inBegin, GetChunkBegin(chunk, numChunks, size));
+        T acc = static_cast<T>(*in);
+        for (vtkIdType i = GetChunkBegin(chunk, numChunks, size) + 1; i < end; ++i)
+        {
+          acc = op(acc, static_cast<T>(*++in));
+        }
+        sums[chunk] = acc;
+      });
+    for (vtkIdType chunk = 1; chunk < numChunks - 1; ++chunk)
+    {
+      sums[chunk] = op(sums[chunk - 1], sums[chunk]);
+    }
+    ForEachChunk(impl, numChunks,
+      [&](vtkIdType chunk)
+      {
+        scanChunk(GetChunkBegin(chunk, numChunks, size),
+          GetChunkBegin(chunk + 1, numChunks, size), chunk > 0 ? &sums[chunk - 1] : nullptr);
+      });
+    return std::next(outBegin, size);
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename Impl, typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  static OutputIt ExclusiveScan(
+    Impl& impl, InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+  {
+    const vtkIdType size = std::distance(inBegin, inEnd);
+    const vtkIdType numChunks = GetNumberOfChunks(size, impl.GetEstimatedNumberOfThreads());
+    auto scanChunk = [&](vtkIdType begin, vtkIdType end, T acc)
+    {
+      InputIt in = std::next(inBegin, begin);
+      OutputIt out = std::next(outBegin, begin);
+      for (vtkIdType i = begin; i < end; ++i, ++in, ++out)
+      {
+        // Read before writing to support in place scans.
+        T value = static_cast<T>(*in);
+        *out = acc;
+        acc = op(acc, value);
+      }
+    };
+    if (size <= 0)
+    {
+      return outBegin;
+    }
+    if (numChunks == 1)
+    {
+      scanChunk(0, size, init);
+      return std::next(outBegin, size);
+    }
+
+    std::vector<T> sums(numChunks, init);
+    ForEachChunk(impl, numChunks - 1,
+      [&](vtkIdType chunk)
+      {
+        const vtkIdType end = GetChunkBegin(chunk + 1, numChunks, size);
+        InputIt in = std::next(inBegin, GetChunkBegin(chunk, numChunks, size));
+        T acc = static_cast<T>(*in);
+        for (vtkIdType i = GetChunkBegin(chunk, numChunks, size) + 1; i < end; ++i)
+        {
+          acc = op(acc, static_cast<T>(*++in));
+        }
+        sums[chunk + 1] = acc;
+      });
+    for (vtkIdType chunk = 1; chunk < numChunks; ++chunk)
+    {
+      sums[chunk] = op(sums[chunk - 1], sums[chunk]);
+    }
+    ForEachChunk(impl, numChunks,
+      [&](vtkIdType chunk)
+      {
+        scanChunk(GetChunkBegin(chunk, numChunks, size),
+          GetChunkBegin(chunk + 1, numChunks, size), sums[chunk]);
+      });
+    return std::next(outBegin, size);
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename Impl, typename Iterator, typename T, typename BinaryOp>
+  static T Reduce(Impl& impl, Iterator begin, Iterator end, T init, BinaryOp op)
+  {
+    const vtkIdType size = std::distance(begin, end);
+    const vtkIdType numChunks = GetNumberOfChunks(size, impl.GetEstimatedNumberOfThreads());
+    if (numChunks == 1)
+    {
+      for (; begin != end; ++begin)
+      {
+        init = op(init, static_cast<T>(*begin));
+      }
+      return init;
+    }
+
+    std::vector<T> sums(numChunks);
+    ForEachChunk(impl, numChunks,
+      [&](vtkIdType chunk)
+      {
+        const vtkIdType last = GetChunkBegin(chunk + 1, numChunks, size);
+        Iterator it = std::next(begin, GetChunkBegin(chunk, numChunks, size));
+        T acc = static_cast<T>(*it);
+        for (vtkIdType i = GetChunkBegin(chunk, numChunks, size) + 1; i < last; ++i)
+        {
+          acc = op(acc, static_cast<T>(*++it));
+        }
+        sums[chunk] = acc;
+      });
+    for (const T& sum : sums)
+    {
+      init = op(init, sum);
+    }
+    return init;
+  }
+
+  //--------------------------------------------------------------------------------
+  // Evaluate the predicate once per element, store the result in `flags` and
+  // return the exclusive scan of the number of selected elements per chunk,
+  // the last entry being the total.
+  template <typename Impl, typename InputIt, typename Predicate>
+  static std::vector<vtkIdType> Select(Impl& impl, InputIt inBegin, vtkIdType size,
+    vtkIdType numChunks, Predicate& pred, std::vector<unsigned char>& flags)
+  {
+    std::vector<vtkIdType> offsets(numChunks + 1, 0);
+    flags.resize(size);
+    ForEachChunk(impl, numChunks,
+      [&](vtkIdType chunk)
+      {
+        const vtkIdType begin = GetChunkBegin(chunk, numChunks, size);
+        const vtkIdType end = GetChunkBegin(chunk + 1, numChunks, size);
+        InputIt in = std::next(inBegin, begin);
+        vtkIdType count = 0;
+        for (vtkIdType i = begin; i < end; ++i, ++in)
+        {
+          flags[i] = pred(*in) ? 1 : 0;
+          count += flags[i];
+        }
+        offsets[chunk + 1] = count;
+      });
+    for (vtkIdType chunk = 1; chunk <= numChunks; ++chunk)
+    {
+      offsets[chunk] += offsets[chunk - 1];
+    }
+    return offsets;
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename Impl, typename InputIt, typename OutputIt, typename Predicate>
+  static OutputIt CopyIf(
+    Impl& impl, InputIt inBegin, InputIt inEnd, OutputIt outBegin, Predicate pred)
+  {
+    const vtkIdType size = std::distance(inBegin, inEnd);
+    const vtkIdType numChunks = GetNumberOfChunks(size, impl.GetEstimatedNumberOfThreads());
+    if (numChunks == 1)
+    {
+      for (; inBegin != inEnd; ++inBegin)
+      {
+        if (pred(*inBegin))
+        {
+          *outBegin = *inBegin;
+          ++outBegin;
+        }
+      }
+      return outBegin;
+    }
+
+    std::vector<unsigned char> flags;
+    auto offsets = Select(impl, inBegin, size, numChunks, pred, flags);
+    ForEachChunk(impl, numChunks,
+      [&](vtkIdType chunk)
+      {
+        const vtkIdType begin = GetChunkBegin(chunk, numChunks, size);
+        const vtkIdType end = GetChunkBegin(chunk + 1, numChunks, size);
+        InputIt in = std::next(inBegin, begin);
+        OutputIt out = std::next(outBegin, offsets[chunk]);
+        for (vtkIdType i = begin; i < end; ++i, ++in)
+        {
+          if (flags[i])
+          {
+            *out = *in;
+            ++out;
+          }
+        }
+      });
+    return std::next(outBegin, offsets[numChunks]);
+  }
+
+  //--------------------------------------------------------------------------------
+  template <typename Impl, typename Iterator, typename Predicate>
+  static Iterator Partition(Impl& impl, Iterator begin, Iterator end, Predicate pred)
+  {
+    using T = typename std::iterator_traits<Iterator>::value_type;
+    const vtkIdType size = std::distance(begin, end);
+    if (size <= 0)
+    {
+      return begin;
+    }
+    const vtkIdType numChunks = GetNumberOfChunks(size, impl.GetEstimatedNumberOfThreads());
+    std::vector<unsigned char> flags;
+    auto offsets = Select(impl, begin, size, numChunks, pred, flags);
+    const vtkIdType numSelected = offsets[numChunks];
+
+    std::vector<T> buffer(size);
+    ForEachChunk(impl, numChunks,
+      [&](vtkIdType chunk)
+      {
+        const vtkIdType first = GetChunkBegin(chunk, numChunks, size);
+        const vtkIdType last = GetChunkBegin(chunk + 1, numChunks, size);
+        vtkIdType selected = offsets[chunk];
+        vtkIdType rejected = numSelected + first - offsets[chunk];
+        Iterator it = std::next(begin, first);
+        for (vtkIdType i = first; i < last; ++i, ++it)
+        {
+          buffer[flags[i] ? selected++ : rejected++] = *it;
+        }
+      });
+    ForEachChunk(impl, numChunks,
+      [&](vtkIdType chunk)
+      {
+        const vtkIdType first = GetChunkBegin(chunk, numChunks, size);
+        const vtkIdType last = GetChunkBegin(chunk + 1, numChunks, size);
+        std::copy(buffer.begin() + first, buffer.begin() + last, std::next(begin, first));
+      });
+    return std::next(begin, numSelected);
+  }
+};
+
 VTK_ABI_NAMESPACE_END
 
 } // namespace smp
@@ -143,6 +143,50 @@ void vtkSMPToolsImpl<BackendType::OpenMP>::Sort(
   std::sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename BinaryOp>
+OutputIt vtkSMPToolsImpl<BackendType::OpenMP>::InclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+{
+  return ChunkedAlgorithms::InclusiveScan(*this, inBegin, inEnd, outBegin, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+OutputIt vtkSMPToolsImpl<BackendType::OpenMP>::ExclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+{
+  return ChunkedAlgorithms::ExclusiveScan(*this, inBegin, inEnd, outBegin, init, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename Iterator, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::OpenMP>::Reduce(Iterator begin, Iterator end, T init, BinaryOp op)
+{
+  return ChunkedAlgorithms::Reduce(*this, begin, end, init, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename Predicate>
+OutputIt vtkSMPToolsImpl<BackendType::OpenMP>::CopyIf(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, Predicate pred)
+{
+  return ChunkedAlgorithms::CopyIf(*this, inBegin, inEnd, outBegin, pred);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename Iterator, typename Predicate>
+Iterator vtkSMPToolsImpl<BackendType::OpenMP>::Partition(
+  Iterator begin, Iterator end, Predicate pred)
+{
+  return ChunkedAlgorithms::Partition(*this, begin, end, pred);
+}
+
 //--------------------------------------------------------------------------------
 template <>
 VTKCOMMONCORE_EXPORT void vtkSMPToolsImpl<BackendType::OpenMP>::Initialize(int);
@@ -115,6 +115,50 @@ void vtkSMPToolsImpl<BackendType::STDThread>::Sort(
   std::sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename BinaryOp>
+OutputIt vtkSMPToolsImpl<BackendType::STDThread>::InclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+{
+  return ChunkedAlgorithms::InclusiveScan(*this, inBegin, inEnd, outBegin, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+OutputIt vtkSMPToolsImpl<BackendType::STDThread>::ExclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+{
+  return ChunkedAlgorithms::ExclusiveScan(*this, inBegin, inEnd, outBegin, init, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename Iterator, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::STDThread>::Reduce(Iterator begin, Iterator end, T init, BinaryOp op)
+{
+  return ChunkedAlgorithms::Reduce(*this, begin, end, init, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename Predicate>
+OutputIt vtkSMPToolsImpl<BackendType::STDThread>::CopyIf(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, Predicate pred)
+{
+  return ChunkedAlgorithms::CopyIf(*this, inBegin, inEnd, outBegin, pred);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename Iterator, typename Predicate>
+Iterator vtkSMPToolsImpl<BackendType::STDThread>::Partition(
+  Iterator begin, Iterator end, Predicate pred)
+{
+  return ChunkedAlgorithms::Partition(*this, begin, end, pred);
+}
+
 //--------------------------------------------------------------------------------
 template <>
 VTKCOMMONCORE_EXPORT void vtkSMPToolsImpl<BackendType::STDThread>::Initialize(int);
@@ -4,7 +4,8 @@
 #ifndef SequentialvtkSMPToolsImpl_txx
 #define SequentialvtkSMPToolsImpl_txx
 
-#include <algorithm> // For std::sort, std::transform, std::fill
+#include <algorithm> // For std::sort, std::transform, std::fill, std::copy_if
+#include <numeric>   // For std::inclusive_scan, std::exclusive_scan, std::accumulate
 
 #include "SMP/Common/vtkSMPToolsImpl.h"
 #include "SMP/Common/vtkSMPToolsInternal.h" // For common vtk smp class
@@ -90,6 +91,53 @@ void vtkSMPToolsImpl<BackendType::Sequential>::Sort(
   std::sort(begin, end, comp);
 }
 
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename BinaryOp>
+OutputIt vtkSMPToolsImpl<BackendType::Sequential>::InclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+{
+  return std::inclusive_scan(inBegin, inEnd, outBegin, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+OutputIt vtkSMPToolsImpl<BackendType::Sequential>::ExclusiveScan(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+{
+  return std::exclusive_scan(inBegin, inEnd, outBegin, init, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename Iterator, typename T, typename BinaryOp>
+T vtkSMPToolsImpl<BackendType::Sequential>::Reduce(
+  Iterator begin, Iterator end, T init, BinaryOp op)
+{
+  return std::accumulate(begin, end, init, op);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename InputIt, typename OutputIt, typename Predicate>
+OutputIt vtkSMPToolsImpl<BackendType::Sequential>::CopyIf(
+  InputIt inBegin, InputIt inEnd, OutputIt outBegin, Predicate pred)
+{
+  return std::copy_if(inBegin, inEnd, outBegin, pred);
+}
+
+//--------------------------------------------------------------------------------
+template <>
+template <typename Iterator, typename Predicate>
+Iterator vtkSMPToolsImpl<BackendType::Sequential>::Partition(
+  Iterator begin, Iterator end, Predicate pred)
+{
+  // std::stable_partition requires swappable references, which vtkDataArray
+  // range iterators do not provide.
+  return ChunkedAlgorithms::Partition(*this, begin, end, pred);
+}
+
 //--------------------------------------------------------------------------------
 template <>
 VTKCOMMONCORE_EXPORT void vtkSMPToolsImpl<BackendType::Sequential>::Initialize(int);
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkDataArrayRange.h"
+#include "vtkIdTypeArray.h"
 #include "vtkNew.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
@@ -9,9 +10,11 @@
 #include "vtkSMPTools.h"
 #include "vtkStringScanner.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <deque>
 #include <functional>
+#include <iterator>
 #include <numeric>
 #include <set>
 #include <vector>
@@ -497,6 +500,96 @@ int doTestSMP()
       return EXIT_FAILURE;
     }
   }
+
+  // Test scans, reduction and compaction. The size is large enough to use
+  // several chunks on threaded backends.
+  constexpr vtkIdType scanSize = 100003;
+  vtkNew<vtkIdTypeArray> scanArray;
+  scanArray->SetNumberOfValues(scanSize);
+  auto scanRange = vtk::DataArrayValueRange<1>(scanArray);
+  for (vtkIdType i = 0; i < scanSize; ++i)
+  {
+    scanRange[i] = (i * 7) % 13;
+  }
+  std::vector<vtkIdType> scanExpected(scanSize);
+  std::vector<vtkIdType> scanResult(scanSize);
+
+  std::partial_sum(scanRange.cbegin(), scanRange.cend(), scanExpected.begin());
+  auto scanEnd = vtkSMPTools::InclusiveScan(scanRange.cbegin(), scanRange.cend(), scanResult.begin());
+  if (scanEnd != scanResult.end() || scanResult != scanExpected)
+  {
+    std::cerr << "Error: Invalid output for vtkSMPTools::InclusiveScan!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  scanExpected[0] = 5;
+  for (vtkIdType i = 1; i < scanSize; ++i)
+  {
+    scanExpected[i] = scanExpected[i - 1] + scanRange[i - 1];
+  }
+  vtkSMPTools::ExclusiveScan(scanRange.cbegin(), scanRange.cend(), scanResult.begin(), vtkIdType(5));
+  if (scanResult != scanExpected)
+  {
+    std::cerr << "Error: Invalid output for vtkSMPTools::ExclusiveScan!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // In place with a non commutative operation: keep the last non zero value.
+  auto lastNonZero = [](vtkIdType a, vtkIdType b) { return b != 0 ? b : a; };
+  std::vector<vtkIdType> inPlace(scanRange.cbegin(), scanRange.cend());
+  vtkSMPTools::InclusiveScan(inPlace.begin(), inPlace.end(), inPlace.begin(), lastNonZero);
+  vtkIdType last = 0;
+  for (vtkIdType i = 0; i < scanSize; ++i)
+  {
+    last = lastNonZero(last, scanRange[i]);
+    if (inPlace[i] != last)
+    {
+      std::cerr << "Error: Invalid output for in place vtkSMPTools::InclusiveScan!" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  const vtkIdType sum = vtkSMPTools::Reduce(scanRange.cbegin(), scanRange.cend(), vtkIdType(3));
+  const vtkIdType maxValue = vtkSMPTools::Reduce(scanRange.cbegin(), scanRange.cend(),
+    vtkIdType(0), [](vtkIdType a, vtkIdType b) { return std::max(a, b); });
+  if (sum != 3 + std::accumulate(scanRange.cbegin(), scanRange.cend(), vtkIdType(0)) ||
+    maxValue != 12)
+  {
+    std::cerr << "Error: Invalid output for vtkSMPTools::Reduce!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  auto isEven = [](vtkIdType value) { return value % 2 == 0; };
+  scanExpected.clear();
+  std::copy_if(scanRange.cbegin(), scanRange.cend(), std::back_inserter(scanExpected), isEven);
+  auto copyEnd =
+    vtkSMPTools::CopyIf(scanRange.cbegin(), scanRange.cend(), scanResult.begin(), isEven);
+  if (copyEnd - scanResult.begin() != static_cast<vtkIdType>(scanExpected.size()) ||
+    !std::equal(scanExpected.begin(), scanExpected.end(), scanResult.begin()))
+  {
+    std::cerr << "Error: Invalid output for vtkSMPTools::CopyIf!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<vtkIdType> partitionExpected(scanRange.cbegin(), scanRange.cend());
+  std::stable_partition(partitionExpected.begin(), partitionExpected.end(), isEven);
+  auto partitionPoint = vtkSMPTools::Partition(scanRange.begin(), scanRange.end(), isEven);
+  if (partitionPoint - scanRange.begin() != static_cast<vtkIdType>(scanExpected.size()) ||
+    !std::equal(partitionExpected.begin(), partitionExpected.end(), scanRange.cbegin()))
+  {
+    std::cerr << "Error: Invalid output for vtkSMPTools::Partition!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Empty ranges
+  std::vector<vtkIdType> empty;
+  if (vtkSMPTools::InclusiveScan(empty.begin(), empty.end(), empty.begin()) != empty.begin() ||
+    vtkSMPTools::Reduce(empty.begin(), empty.end(), vtkIdType(1)) != 1 ||
+    vtkSMPTools::Partition(empty.begin(), empty.end(), isEven) != empty.begin())
+  {
+    std::cerr << "Error: Invalid output for vtkSMPTools algorithms on empty ranges!" << std::endl;
+    return EXIT_FAILURE;
+  }
   return EXIT_SUCCESS;
 }
 
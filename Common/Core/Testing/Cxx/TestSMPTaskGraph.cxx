@@ -0,0 +1,259 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkSMPTaskGraph.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkStringScanner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+constexpr vtkIdType NumberOfValues = 100000;
+constexpr vtkIdType NumberOfBatches = 97;
+
+// Functor with Initialize/Reduce to check the continuation semantics.
+struct SumFunctor
+{
+  const std::vector<vtkIdType>& Values;
+  vtkSMPThreadLocal<vtkIdType> LocalSum;
+  vtkIdType Sum = 0;
+  int NumberOfReduce = 0;
+
+  SumFunctor(const std::vector<vtkIdType>& values)
+    : Values(values)
+  {
+  }
+
+  void Initialize() { this->LocalSum.Local() = 0; }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType& sum = this->LocalSum.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      sum += this->Values[i];
+    }
+  }
+
+  void Reduce()
+  {
+    this->Sum = 0;
+    for (vtkIdType sum : this->LocalSum)
+    {
+      this->Sum += sum;
+    }
+    ++this->NumberOfReduce;
+  }
+};
+
+int doTestSMPTaskGraph()
+{
+  // count -> scan -> fill, with an independent loop running alongside.
+  std::vector<vtkIdType> counts(NumberOfBatches);
+  std::vector<vtkIdType> offsets(NumberOfBatches + 1);
+  std::vector<vtkIdType> output;
+  std::vector<vtkIdType> independent(NumberOfValues, 0);
+
+  vtkSMPTaskGraph graph;
+  auto count = graph.AddFor(0, NumberOfBatches, 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType batch = begin; batch < end; ++batch)
+      {
+        counts[batch] = batch % 7;
+      }
+    });
+  auto scan = graph.AddTask(
+    [&]()
+    {
+      offsets[0] = 0;
+      std::partial_sum(counts.begin(), counts.end(), offsets.begin() + 1);
+      output.resize(offsets.back());
+    });
+  auto fill = graph.AddFor(0, NumberOfBatches, 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType batch = begin; batch < end; ++batch)
+      {
+        for (vtkIdType i = offsets[batch]; i < offsets[batch + 1]; ++i)
+        {
+          output[i] = batch;
+        }
+      }
+    });
+  graph.AddFor(0, NumberOfValues,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        independent[i] = i;
+      }
+    });
+  graph.AddDependency(count, scan);
+  graph.AddDependency(scan, fill);
+
+  if (graph.GetNumberOfTasks() != 4 || !graph.Execute())
+  {
+    std::cerr << "Error: vtkSMPTaskGraph failed to execute a valid graph." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkIdType index = 0;
+  for (vtkIdType batch = 0; batch < NumberOfBatches; ++batch)
+  {
+    for (vtkIdType i = 0; i < batch % 7; ++i, ++index)
+    {
+      if (output[index] != batch)
+      {
+        std::cerr << "Error: bad fill output at " << index << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  if (index != static_cast<vtkIdType>(output.size()))
+  {
+    std::cerr << "Error: bad fill output size." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < NumberOfValues; ++i)
+  {
+    if (independent[i] != i)
+    {
+      std::cerr << "Error: bad independent output at " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Initialize/Reduce functors, reduction must be visible to successors, and
+  // the graph can be executed several times.
+  std::vector<vtkIdType> values(NumberOfValues);
+  std::iota(values.begin(), values.end(), 0);
+  const vtkIdType expected = NumberOfValues * (NumberOfValues - 1) / 2;
+  SumFunctor sum(values);
+  vtkIdType seenSum = 0;
+  vtkSMPTaskGraph graph2;
+  auto reduce = graph2.AddFor(0, NumberOfValues, 1000, sum);
+  auto check = graph2.AddTask([&]() { seenSum = sum.Sum; });
+  graph2.AddDependency(reduce, check);
+  for (int run = 1; run <= 2; ++run)
+  {
+    if (!graph2.Execute() || sum.Sum != expected || seenSum != expected ||
+      sum.NumberOfReduce != run)
+    {
+      std::cerr << "Error: bad reduction with vtkSMPTaskGraph, got " << sum.Sum << " expected "
+                << expected << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Temporary functors are owned by the graph and outlive the scope that
+  // created them.
+  std::vector<vtkIdType> copied(NumberOfValues, 0);
+  vtkSMPTaskGraph owningGraph;
+  {
+    std::vector<vtkIdType> source(values);
+    owningGraph.AddFor(0, NumberOfValues,
+      [&copied, source](vtkIdType begin, vtkIdType end)
+      { std::copy(source.begin() + begin, source.begin() + end, copied.begin() + begin); });
+  }
+  if (!owningGraph.Execute() || copied != values)
+  {
+    std::cerr << "Error: bad temporary functor with vtkSMPTaskGraph." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Diamond with many leaves: each node must run exactly once and after its
+  // predecessors.
+  constexpr int numLeaves = 64;
+  std::atomic<int> leavesDone(0);
+  std::atomic<int> errors(0);
+  std::atomic<int> rootDone(0);
+  vtkSMPTaskGraph graph3;
+  auto root = graph3.AddTask([&]() { rootDone = 1; });
+  auto sink = graph3.AddTask(
+    [&]()
+    {
+      if (leavesDone != numLeaves)
+      {
+        ++errors;
+      }
+    });
+  for (int i = 0; i < numLeaves; ++i)
+  {
+    auto leaf = graph3.AddFor(0, 10,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        if (!rootDone)
+        {
+          ++errors;
+        }
+        // Nested parallelism inside a task
+        vtkSMPTools::For(0, 100, [](vtkIdType, vtkIdType) {});
+        if (begin == 0 && end > 0)
+        {
+          ++leavesDone;
+        }
+      });
+    graph3.AddDependency(root, leaf);
+    graph3.AddDependency(leaf, sink);
+  }
+  // Empty loops must still release their successors.
+  auto empty = graph3.AddFor(0, 0, [&](vtkIdType, vtkIdType) { ++errors; });
+  graph3.AddDependency(empty, sink);
+  if (!graph3.Execute() || errors != 0 || leavesDone != numLeaves)
+  {
+    std::cerr << "Error: bad ordering with vtkSMPTaskGraph." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Cycles are rejected
+  vtkSMPTaskGraph cycle;
+  bool cycleRan = false;
+  auto a = cycle.AddTask([&]() { cycleRan = true; });
+  auto b = cycle.AddTask([&]() { cycleRan = true; });
+  cycle.AddDependency(a, b);
+  cycle.AddDependency(b, a);
+  if (cycle.Execute() || cycleRan)
+  {
+    std::cerr << "Error: vtkSMPTaskGraph executed a cyclic graph." << std::endl;
+    return EXIT_FAILURE;
+  }
+  cycle.Clear();
+  if (cycle.GetNumberOfTasks() != 0 || !cycle.Execute())
+  {
+    std::cerr << "Error: vtkSMPTaskGraph::Clear failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+}
+
+int TestSMPTaskGraph(int argc, char* argv[])
+{
+  int returnValue = EXIT_SUCCESS;
+  for (int i = 1; i < argc; i++)
+  {
+    std::string argument(argv[i] + 2);
+    std::size_t separator = argument.find('=');
+    std::string backend = argument.substr(0, separator);
+    int value;
+    VTK_FROM_CHARS_IF_ERROR_RETURN(argument.substr(separator + 1), value, EXIT_FAILURE);
+    if (value)
+    {
+      vtkSMPTools::SetBackend(backend.c_str());
+      if (doTestSMPTaskGraph() != EXIT_SUCCESS)
+      {
+        std::cerr << "With backend " << backend << std::endl;
+        returnValue = EXIT_FAILURE;
+      }
+    }
+  }
+  return returnValue;
+}
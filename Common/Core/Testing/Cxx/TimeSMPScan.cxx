@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Time the vtkSMPTools scan, reduce and compaction algorithms on every enabled
+// backend, against their serial std counterparts. Results are also checked.
+
+#include "vtkDataArrayRange.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkStringScanner.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+constexpr vtkIdType NumberOfValues = 10000000;
+
+bool TimeBackend(const char* backend, vtkIdTypeArray* input)
+{
+  const auto in = vtk::DataArrayValueRange<1>(input);
+  std::vector<vtkIdType> expected(NumberOfValues);
+  std::vector<vtkIdType> result(NumberOfValues);
+  vtkNew<vtkTimerLog> timer;
+  auto isSelected = [](vtkIdType value) { return value % 3 == 0; };
+  bool status = true;
+
+  auto report = [&](const char* name, double serial, double parallel, bool valid)
+  {
+    std::cout << backend << " " << name << ": std " << serial << " s, vtkSMPTools " << parallel
+              << " s, speedup " << (parallel > 0 ? serial / parallel : 0.0) << "\n";
+    if (!valid)
+    {
+      std::cerr << "Error: invalid result for " << name << " with backend " << backend << "\n";
+      status = false;
+    }
+  };
+
+  timer->StartTimer();
+  std::inclusive_scan(in.cbegin(), in.cend(), expected.begin());
+  timer->StopTimer();
+  double serial = timer->GetElapsedTime();
+  timer->StartTimer();
+  vtkSMPTools::InclusiveScan(in.cbegin(), in.cend(), result.begin());
+  timer->StopTimer();
+  report("InclusiveScan", serial, timer->GetElapsedTime(), result == expected);
+
+  timer->StartTimer();
+  std::exclusive_scan(in.cbegin(), in.cend(), expected.begin(), vtkIdType(0));
+  timer->StopTimer();
+  serial = timer->GetElapsedTime();
+  timer->StartTimer();
+  vtkSMPTools::ExclusiveScan(in.cbegin(), in.cend(), result.begin(), vtkIdType(0));
+  timer->StopTimer();
+  report("ExclusiveScan", serial, timer->GetElapsedTime(), result == expected);
+
+  timer->StartTimer();
+  const vtkIdType expectedSum = std::accumulate(in.cbegin(), in.cend(), vtkIdType(0));
+  timer->StopTimer();
+  serial = timer->GetElapsedTime();
+  timer->StartTimer();
+  const vtkIdType sum = vtkSMPTools::Reduce(in.cbegin(), in.cend(), vtkIdType(0));
+  timer->StopTimer();
+  report("Reduce", serial, timer->GetElapsedTime(), sum == expectedSum);
+
+  timer->StartTimer();
+  auto expectedEnd = std::copy_if(in.cbegin(), in.cend(), expected.begin(), isSelected);
+  timer->StopTimer();
+  serial = timer->GetElapsedTime();
+  timer->StartTimer();
+  auto resultEnd = vtkSMPTools::CopyIf(in.cbegin(), in.cend(), result.begin(), isSelected);
+  timer->StopTimer();
+  report("CopyIf", serial, timer->GetElapsedTime(),
+    expectedEnd - expected.begin() == resultEnd - result.begin() &&
+      std::equal(expected.begin(), expectedEnd, result.begin()));
+
+  std::copy(in.cbegin(), in.cend(), expected.begin());
+  std::copy(in.cbegin(), in.cend(), result.begin());
+  timer->StartTimer();
+  std::stable_partition(expected.begin(), expected.end(), isSelected);
+  timer->StopTimer();
+  serial = timer->GetElapsedTime();
+  timer->StartTimer();
+  vtkSMPTools::Partition(result.begin(), result.end(), isSelected);
+  timer->StopTimer();
+  report("Partition", serial, timer->GetElapsedTime(), result == expected);
+
+  return status;
+}
+}
+
+int TimeSMPScan(int argc, char* argv[])
+{
+  vtkNew<vtkIdTypeArray> input;
+  input->SetNumberOfValues(NumberOfValues);
+  auto range = vtk::DataArrayValueRange<1>(input);
+  for (vtkIdType i = 0; i < NumberOfValues; ++i)
+  {
+    range[i] = (i * 2654435761) % 101;
+  }
+
+  std::cout << "Timing for " << NumberOfValues << " values\n";
+  int returnValue = EXIT_SUCCESS;
+  for (int i = 1; i < argc; i++)
+  {
+    std::string argument(argv[i] + 2);
+    std::size_t separator = argument.find('=');
+    std::string backend = argument.substr(0, separator);
+    int value;
+    VTK_FROM_CHARS_IF_ERROR_RETURN(argument.substr(separator + 1), value, EXIT_FAILURE);
+    if (value && vtkSMPTools::SetBackend(backend.c_str()))
+    {
+      std::cout << "Backend " << backend << " with "
+                << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads\n";
+      if (!TimeBackend(backend.c_str(), input))
+      {
+        returnValue = EXIT_FAILURE;
+      }
+    }
+  }
+  return returnValue;
+}
@@ -136,8 +136,10 @@ list(APPEND vtk_smp_nowrap_headers
   "${vtk_smp_common_dir}/vtkSMPToolsInternal.h")
 
 list(APPEND vtk_smp_sources
+  vtkSMPTaskGraph.cxx
   vtkSMPTools.cxx)
 list(APPEND vtk_smp_headers
+  vtkSMPTaskGraph.h
   vtkSMPTools.h
   vtkSMPThreadLocal.h
   vtkSMPThreadLocalObject.h)
@@ -0,0 +1,354 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkSMPTaskGraph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+//------------------------------------------------------------------------------
+// A contiguous piece of a node to execute.
+struct Chunk
+{
+  vtkIdType Node;
+  vtkIdType Begin;
+  vtkIdType End;
+};
+
+//------------------------------------------------------------------------------
+// Deque of ready chunks owned by one worker. The owner pushes and pops at the
+// back, thieves steal from the front so that they take the oldest, usually
+// largest, amount of remaining work.
+struct WorkerQueue
+{
+  std::mutex Mutex;
+  std::deque<Chunk> Chunks;
+};
+
+//------------------------------------------------------------------------------
+// Number of task bodies being executed by the current thread. Some backends
+// (TBB) let a thread blocked in a nested parallel loop pick up another worker
+// job of the graph; such a worker must never wait on the graph completion as
+// the task it interrupted would never finish.
+thread_local int TaskDepth = 0;
+}
+
+//------------------------------------------------------------------------------
+class vtkSMPTaskGraph::vtkInternals
+{
+public:
+  struct Node
+  {
+    vtkIdType First;
+    vtkIdType Last;
+    vtkIdType Grain;
+    std::function<void()> Start;
+    std::function<void(vtkIdType, vtkIdType)> Body;
+    std::function<void()> Finish;
+    std::vector<TaskId> Successors;
+    vtkIdType NumberOfPredecessors = 0;
+  };
+
+  std::vector<Node> Nodes;
+
+  // Execution state, only valid during Execute()
+  std::unique_ptr<std::atomic<vtkIdType>[]> PendingPredecessors;
+  std::unique_ptr<std::atomic<vtkIdType>[]> PendingChunks;
+  std::vector<WorkerQueue> Queues;
+  std::atomic<vtkIdType> RemainingNodes{ 0 };
+  std::atomic<vtkIdType> QueuedChunks{ 0 };
+  std::mutex WaitMutex;
+  std::condition_variable WaitCondition;
+  int NumberOfWorkers = 1;
+
+  //------------------------------------------------------------------------------
+  bool IsAcyclic() const
+  {
+    std::vector<vtkIdType> indegree(this->Nodes.size());
+    std::vector<TaskId> stack;
+    for (std::size_t i = 0; i < this->Nodes.size(); ++i)
+    {
+      indegree[i] = this->Nodes[i].NumberOfPredecessors;
+      if (indegree[i] == 0)
+      {
+        stack.push_back(static_cast<TaskId>(i));
+      }
+    }
+    std::size_t visited = 0;
+    while (!stack.empty())
+    {
+      const TaskId id = stack.back();
+      stack.pop_back();
+      ++visited;
+      for (TaskId succ : this->Nodes[id].Successors)
+      {
+        if (--indegree[succ] == 0)
+        {
+          stack.push_back(succ);
+        }
+      }
+    }
+    return visited == this->Nodes.size();
+  }
+
+  //------------------------------------------------------------------------------
+  vtkIdType GetGrain(const Node& node) const
+  {
+    if (node.Grain > 0)
+    {
+      return node.Grain;
+    }
+    const vtkIdType estimate = (node.Last - node.First) / (this->NumberOfWorkers * 4);
+    return estimate > 0 ? estimate : 1;
+  }
+
+  //------------------------------------------------------------------------------
+  void Notify(bool all)
+  {
+    // Taking the lock avoids missing a wake up between the predicate check
+    // of a waiting worker and its call to wait().
+    std::lock_guard<std::mutex> lock(this->WaitMutex);
+    if (all)
+    {
+      this->WaitCondition.notify_all();
+    }
+    else
+    {
+      this->WaitCondition.notify_one();
+    }
+  }
+
+  //------------------------------------------------------------------------------
+  // Split a node whose predecessors all completed into chunks and push them on
+  // the queue of the given worker.
+  void Release(TaskId id, int worker)
+  {
+    Node& node = this->Nodes[id];
+    if (node.Start)
+    {
+      node.Start();
+    }
+    if (node.Last <= node.First)
+    {
+      this->PendingChunks[id] = 1;
+      this->Complete(id, worker);
+      return;
+    }
+    const vtkIdType grain = this->GetGrain(node);
+    const vtkIdType numChunks = (node.Last - node.First + grain - 1) / grain;
+    this->PendingChunks[id] = numChunks;
+    {
+      WorkerQueue& queue = this->Queues[worker];
+      std::lock_guard<std::mutex> lock(queue.Mutex);
+      // Push in reverse so that the owner pops chunks in increasing order.
+      for (vtkIdType c = numChunks - 1; c >= 0; --c)
+      {
+        const vtkIdType begin = node.First + c * grain;
+        queue.Chunks.push_back(Chunk{ id, begin, std::min(begin + grain, node.Last) });
+      }
+    }
+    this->QueuedChunks += numChunks;
+    this->Notify(numChunks > 1);
+  }
+
+  //------------------------------------------------------------------------------
+  // Called once a chunk of the node is done. The last chunk finalizes the node
+  // and releases its successors.
+  void Complete(TaskId id, int worker)
+  {
+    if (--this->PendingChunks[id] != 0)
+    {
+      return;
+    }
+    Node& node = this->Nodes[id];
+    if (node.Finish)
+    {
+      node.Finish();
+    }
+    for (TaskId succ : node.Successors)
+    {
+      if (--this->PendingPredecessors[succ] == 0)
+      {
+        this->Release(succ, worker);
+      }
+    }
+    if (--this->RemainingNodes == 0)
+    {
+      this->Notify(true);
+    }
+  }
+
+  //------------------------------------------------------------------------------
+  bool Pop(int worker, Chunk& chunk)
+  {
+    {
+      WorkerQueue& queue = this->Queues[worker];
+      std::lock_guard<std::mutex> lock(queue.Mutex);
+      if (!queue.Chunks.empty())
+      {
+        chunk = queue.Chunks.back();
+        queue.Chunks.pop_back();
+        --this->QueuedChunks;
+        return true;
+      }
+    }
+    for (int i = 1; i < this->NumberOfWorkers; ++i)
+    {
+      WorkerQueue& victim = this->Queues[(worker + i) % this->NumberOfWorkers];
+      std::lock_guard<std::mutex> lock(victim.Mutex);
+      if (!victim.Chunks.empty())
+      {
+        chunk = victim.Chunks.front();
+        victim.Chunks.pop_front();
+        --this->QueuedChunks;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  //------------------------------------------------------------------------------
+  void Work(int worker)
+  {
+    Chunk chunk;
+    while (this->RemainingNodes > 0)
+    {
+      if (this->Pop(worker, chunk))
+      {
+        ++TaskDepth;
+        this->Nodes[chunk.Node].Body(chunk.Begin, chunk.End);
+        --TaskDepth;
+        this->Complete(chunk.Node, worker);
+        continue;
+      }
+      if (TaskDepth > 0)
+      {
+        return;
+      }
+      std::unique_lock<std::mutex> lock(this->WaitMutex);
+      this->WaitCondition.wait(
+        lock, [this]() { return this->RemainingNodes == 0 || this->QueuedChunks > 0; });
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+vtkSMPTaskGraph::vtkSMPTaskGraph()
+  : Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkSMPTaskGraph::~vtkSMPTaskGraph() = default;
+
+//------------------------------------------------------------------------------
+vtkSMPTaskGraph::TaskId vtkSMPTaskGraph::AddTask(std::function<void()> task)
+{
+  return this->AddNode(
+    0, 1, 1, nullptr, [task](vtkIdType, vtkIdType) { task(); }, nullptr);
+}
+
+//------------------------------------------------------------------------------
+vtkSMPTaskGraph::TaskId vtkSMPTaskGraph::AddNode(vtkIdType first, vtkIdType last,
+  vtkIdType grain, std::function<void()> start, std::function<void(vtkIdType, vtkIdType)> body,
+  std::function<void()> finish)
+{
+  vtkInternals::Node node;
+  node.First = first;
+  node.Last = last;
+  node.Grain = grain;
+  node.Start = std::move(start);
+  node.Body = std::move(body);
+  node.Finish = std::move(finish);
+  this->Internals->Nodes.emplace_back(std::move(node));
+  return static_cast<TaskId>(this->Internals->Nodes.size() - 1);
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTaskGraph::AddDependency(TaskId before, TaskId after)
+{
+  auto& nodes = this->Internals->Nodes;
+  const TaskId size = static_cast<TaskId>(nodes.size());
+  if (before < 0 || after < 0 || before >= size || after >= size || before == after)
+  {
+    return;
+  }
+  nodes[before].Successors.push_back(after);
+  ++nodes[after].NumberOfPredecessors;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSMPTaskGraph::Execute()
+{
+  vtkInternals& internals = *this->Internals;
+  const vtkIdType numNodes = static_cast<vtkIdType>(internals.Nodes.size());
+  if (numNodes == 0)
+  {
+    return true;
+  }
+  if (!internals.IsAcyclic())
+  {
+    return false;
+  }
+
+  internals.NumberOfWorkers = std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads());
+  internals.Queues = std::vector<WorkerQueue>(internals.NumberOfWorkers);
+  internals.PendingPredecessors.reset(new std::atomic<vtkIdType>[numNodes]);
+  internals.PendingChunks.reset(new std::atomic<vtkIdType>[numNodes]);
+  internals.RemainingNodes = numNodes;
+  internals.QueuedChunks = 0;
+
+  std::vector<TaskId> roots;
+  for (vtkIdType i = 0; i < numNodes; ++i)
+  {
+    internals.PendingPredecessors[i] = internals.Nodes[i].NumberOfPredecessors;
+    internals.PendingChunks[i] = 0;
+    if (internals.Nodes[i].NumberOfPredecessors == 0)
+    {
+      roots.push_back(i);
+    }
+  }
+  // Roots are dealt round robin so that the workers start on distinct nodes.
+  // Releasing is done in reverse so that a single worker runs the roots in
+  // insertion order.
+  for (vtkIdType r = static_cast<vtkIdType>(roots.size()) - 1; r >= 0; --r)
+  {
+    internals.Release(roots[r], static_cast<int>(r % internals.NumberOfWorkers));
+  }
+
+  // One job per worker. Any worker is able to drain the whole graph, so this
+  // is safe even if the backend runs some of these jobs sequentially.
+  vtkSMPTools::For(0, internals.NumberOfWorkers, 1,
+    [&internals](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType worker = begin; worker < end; ++worker)
+      {
+        internals.Work(static_cast<int>(worker));
+      }
+    });
+
+  internals.Queues.clear();
+  internals.PendingPredecessors.reset();
+  internals.PendingChunks.reset();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPTaskGraph::Clear()
+{
+  this->Internals->Nodes.clear();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkSMPTaskGraph::GetNumberOfTasks() const
+{
+  return static_cast<vtkIdType>(this->Internals->Nodes.size());
+}
+VTK_ABI_NAMESPACE_END
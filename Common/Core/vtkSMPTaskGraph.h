@@ -0,0 +1,222 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkSMPTaskGraph
+ * @brief   A dependency graph of parallel tasks executed with work stealing.
+ *
+ * vtkSMPTools::For() is a fork/join construct: every call ends with an
+ * implicit barrier. Algorithms made of several dependent passes (count,
+ * prefix sum, fill...) pay that barrier between every pass even when only a
+ * part of the next pass actually depends on the previous one, and threads
+ * sit idle while the slowest chunk of a pass finishes.
+ *
+ * vtkSMPTaskGraph lets such algorithms describe their passes as nodes of a
+ * directed acyclic graph and only order what must be ordered. A node is
+ * either a serial task (AddTask()) or a parallel for loop (AddFor()) which
+ * is split into chunks following the same grain rules as vtkSMPTools::For().
+ * Edges are added with AddDependency(). Execute() then runs the whole graph
+ * in a single parallel region: each thread owns a deque of ready chunks,
+ * pops its own work in LIFO order and steals from other threads (FIFO) when
+ * it runs dry. As soon as the last chunk of a node completes, its successors
+ * become ready and are pushed on the deque of the thread that completed it,
+ * so they start without waiting on a global barrier.
+ *
+ * Functors given to AddFor() follow the vtkSMPTools::For() conventions:
+ * operator()(begin, end) is mandatory, and if the functor provides
+ * Initialize() and Reduce(), Initialize() is called once per thread before
+ * the first chunk executed by that thread, and Reduce() is called once, by
+ * the thread that completes the last chunk of the node, before any
+ * successor is started. vtkSMPThreadLocal can be used inside tasks.
+ *
+ * The graph is executed on top of the vtkSMPTools backend in use and thus
+ * works with every backend (Sequential, STDThread, TBB and OpenMP). With the
+ * Sequential backend, or when executed from a parallel scope without nested
+ * parallelism, a single thread drains the graph in a valid topological
+ * order.
+ *
+ * Usage example:
+ * \code
+ * vtkSMPTaskGraph graph;
+ * auto count = graph.AddFor(0, numBatches, [&](vtkIdType begin, vtkIdType end) { ... });
+ * auto scan = graph.AddTask([&]() { ... });
+ * auto fill = graph.AddFor(0, numBatches, [&](vtkIdType begin, vtkIdType end) { ... });
+ * auto other = graph.AddFor(0, numPoints, otherFunctor); // independent work
+ * graph.AddDependency(count, scan);
+ * graph.AddDependency(scan, fill);
+ * graph.Execute(); // `other` overlaps with count, scan and fill
+ * \endcode
+ *
+ * A graph can be executed several times. Functors given as lvalues are
+ * referenced, not copied, so they must outlive the calls to Execute() and
+ * their state (e.g. the result of Reduce()) can be read afterwards.
+ * Temporary functors, such as the lambdas of the example above, are moved
+ * into the graph. Tasks must not throw and must not wait on each other other
+ * than through graph dependencies.
+ *
+ * @sa
+ * vtkSMPTools vtkSMPThreadLocal
+ */
+
+#ifndef vtkSMPTaskGraph_h
+#define vtkSMPTaskGraph_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkSMPTools.h"         // For functor lookup helpers
+#include "vtkType.h"             // For vtkIdType
+
+#include <functional>  // For std::function
+#include <memory>      // For std::unique_ptr
+#include <type_traits> // For std::enable_if
+#include <utility>     // For std::move
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+VTK_ABI_NAMESPACE_BEGIN
+template <typename Functor, bool Init>
+struct vtkSMPTaskGraph_Reduce
+{
+  static void Reduce(Functor&) {}
+};
+
+template <typename Functor>
+struct vtkSMPTaskGraph_Reduce<Functor, true>
+{
+  static void Reduce(Functor& f) { f.Reduce(); }
+};
+VTK_ABI_NAMESPACE_END
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKCOMMONCORE_EXPORT vtkSMPTaskGraph
+{
+public:
+  /**
+   * Handle on a node of the graph, as returned by AddTask() and AddFor().
+   */
+  using TaskId = vtkIdType;
+
+  vtkSMPTaskGraph();
+  ~vtkSMPTaskGraph();
+
+  /**
+   * Add a serial task to the graph.
+   */
+  TaskId AddTask(std::function<void()> task);
+
+  ///@{
+  /**
+   * Add a parallel for loop over [first, last) to the graph. The grain has
+   * the same meaning as for vtkSMPTools::For(); a grain lower or equal to 0
+   * lets the graph pick one. A functor given as an lvalue is referenced, a
+   * temporary one is moved into the graph.
+   */
+  template <typename Functor>
+  TaskId AddFor(vtkIdType first, vtkIdType last, vtkIdType grain, Functor& f)
+  {
+    return this->AddForInternal<Functor,
+      vtk::detail::smp::vtkSMPTools_Has_Initialize<Functor>::value>(first, last, grain, f, nullptr);
+  }
+
+  template <typename Functor>
+  TaskId AddFor(vtkIdType first, vtkIdType last, vtkIdType grain, Functor const& f)
+  {
+    return this->AddForInternal<Functor const,
+      vtk::detail::smp::vtkSMPTools_Has_Initialize_const<Functor>::value>(
+      first, last, grain, f, nullptr);
+  }
+
+  template <typename Functor,
+    typename = typename std::enable_if<!std::is_lvalue_reference<Functor>::value>::type>
+  TaskId AddFor(vtkIdType first, vtkIdType last, vtkIdType grain, Functor&& f)
+  {
+    auto owned = std::make_shared<Functor>(std::move(f));
+    return this->AddForInternal<Functor,
+      vtk::detail::smp::vtkSMPTools_Has_Initialize<Functor>::value>(
+      first, last, grain, *owned, owned);
+  }
+
+  template <typename Functor>
+  TaskId AddFor(vtkIdType first, vtkIdType last, Functor& f)
+  {
+    return this->AddFor(first, last, 0, f);
+  }
+
+  template <typename Functor>
+  TaskId AddFor(vtkIdType first, vtkIdType last, Functor const& f)
+  {
+    return this->AddFor(first, last, 0, f);
+  }
+
+  template <typename Functor,
+    typename = typename std::enable_if<!std::is_lvalue_reference<Functor>::value>::type>
+  TaskId AddFor(vtkIdType first, vtkIdType last, Functor&& f)
+  {
+    return this->AddFor(first, last, 0, std::move(f));
+  }
+  ///@}
+
+  /**
+   * Require that the task `before` completes (including its Reduce()) before
+   * the task `after` starts. Invalid ids and self dependencies are ignored.
+   * Creating a cycle is an error that makes Execute() return false.
+   */
+  void AddDependency(TaskId before, TaskId after);
+
+  /**
+   * Execute all the tasks of the graph and return once they are all
+   * completed. Returns false, without executing anything, if the graph
+   * contains a cycle.
+   */
+  bool Execute();
+
+  /**
+   * Remove all tasks and dependencies.
+   */
+  void Clear();
+
+  /**
+   * Get the number of tasks in the graph.
+   */
+  vtkIdType GetNumberOfTasks() const;
+
+private:
+  vtkSMPTaskGraph(const vtkSMPTaskGraph&) = delete;
+  void operator=(const vtkSMPTaskGraph&) = delete;
+
+  template <typename Functor, bool Init>
+  TaskId AddForInternal(vtkIdType first, vtkIdType last, vtkIdType grain, Functor& f,
+    std::shared_ptr<void> owned)
+  {
+    using FunctorInternal = vtk::detail::smp::vtkSMPTools_FunctorInternal<Functor, Init>;
+    // The thread local initialization flags must be reset for each execution,
+    // so the internal functor is created when the node starts. `owned` keeps
+    // a temporary functor alive as long as the node.
+    auto fi = std::make_shared<std::unique_ptr<FunctorInternal>>();
+    return this->AddNode(
+      first, last, grain, [fi, &f, owned]() { fi->reset(new FunctorInternal(f)); },
+      [fi](vtkIdType begin, vtkIdType end) { (*fi)->Execute(begin, end); },
+      [fi, &f, owned]()
+      {
+        vtk::detail::smp::vtkSMPTaskGraph_Reduce<Functor, Init>::Reduce(f);
+        fi->reset();
+      });
+  }
+
+  TaskId AddNode(vtkIdType first, vtkIdType last, vtkIdType grain, std::function<void()> start,
+    std::function<void(vtkIdType, vtkIdType)> body, std::function<void()> finish);
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
+// VTK-HeaderTest-Exclude: vtkSMPTaskGraph.h
@@ -13,6 +13,7 @@
  * @sa
  * vtkSMPThreadLocal
  * vtkSMPThreadLocalObject
+ * vtkSMPTaskGraph
  */
 
 #ifndef vtkSMPTools_h
@@ -623,6 +624,118 @@ public:
     auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
     SMPToolsAPI.Sort(begin, end, comp);
   }
+
+  ///@{
+  /**
+   * A parallel drop in replacement for std::inclusive_scan(). The i-th output
+   * value is the combination, with the binary operation (std::plus<> by
+   * default), of the input values 0 to i. The operation must be associative
+   * but does not need to be commutative. Input and output ranges may be the
+   * same (in place scan) and must be random access ranges, e.g. vtkDataArray
+   * value ranges. Returns the end of the output range.
+   *
+   * Usage example with vtkDataArray:
+   * \code
+   * const auto counts = vtk::DataArrayValueRange<1>(countArray);
+   * auto offsets = vtk::DataArrayValueRange<1>(offsetArray);
+   * vtkSMPTools::InclusiveScan(counts.cbegin(), counts.cend(), offsets.begin());
+   * \endcode
+   */
+  template <typename InputIt, typename OutputIt, typename BinaryOp>
+  static OutputIt InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, BinaryOp op)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.InclusiveScan(inBegin, inEnd, outBegin, op);
+  }
+
+  template <typename InputIt, typename OutputIt>
+  static OutputIt InclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin)
+  {
+    return vtkSMPTools::InclusiveScan(inBegin, inEnd, outBegin, std::plus<>());
+  }
+  ///@}
+
+  ///@{
+  /**
+   * A parallel drop in replacement for std::exclusive_scan(). The i-th output
+   * value is the combination, with the binary operation (std::plus<> by
+   * default), of init and of the input values 0 to i-1. The operation must be
+   * associative but does not need to be commutative. Input and output ranges
+   * may be the same and must be random access ranges. Returns the end of the
+   * output range.
+   *
+   * This is the typical "count, scan, fill" building block:
+   * \code
+   * std::vector<vtkIdType> offsets(counts.size() + 1);
+   * vtkSMPTools::ExclusiveScan(counts.begin(), counts.end(), offsets.begin(), vtkIdType(0));
+   * offsets.back() = offsets[counts.size() - 1] + counts.back();
+   * \endcode
+   */
+  template <typename InputIt, typename OutputIt, typename T, typename BinaryOp>
+  static OutputIt ExclusiveScan(
+    InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init, BinaryOp op)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.ExclusiveScan(inBegin, inEnd, outBegin, init, op);
+  }
+
+  template <typename InputIt, typename OutputIt, typename T>
+  static OutputIt ExclusiveScan(InputIt inBegin, InputIt inEnd, OutputIt outBegin, T init)
+  {
+    return vtkSMPTools::ExclusiveScan(inBegin, inEnd, outBegin, init, std::plus<>());
+  }
+  ///@}
+
+  ///@{
+  /**
+   * A parallel replacement for std::accumulate(): combines init and all the
+   * values of the range with the binary operation (std::plus<> by default).
+   * The operation must be associative; values are always combined in the
+   * range order, so it does not need to be commutative. Note that the result
+   * of floating point sums may slightly differ between backends.
+   */
+  template <typename Iterator, typename T, typename BinaryOp>
+  static T Reduce(Iterator begin, Iterator end, T init, BinaryOp op)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.Reduce(begin, end, init, op);
+  }
+
+  template <typename Iterator, typename T>
+  static T Reduce(Iterator begin, Iterator end, T init)
+  {
+    return vtkSMPTools::Reduce(begin, end, init, std::plus<>());
+  }
+  ///@}
+
+  /**
+   * A parallel drop in replacement for std::copy_if(): copies the values for
+   * which the predicate returns true, preserving their relative order, and
+   * returns the end of the output range. The predicate is called exactly once
+   * per value, possibly concurrently. Ranges must be random access ranges and
+   * must not overlap.
+   */
+  template <typename InputIt, typename OutputIt, typename Predicate>
+  static OutputIt CopyIf(InputIt inBegin, InputIt inEnd, OutputIt outBegin, Predicate pred)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.CopyIf(inBegin, inEnd, outBegin, pred);
+  }
+
+  /**
+   * A parallel drop in replacement for std::stable_partition(): reorders the
+   * range so that the values for which the predicate returns true come first,
+   * preserving the relative order inside both groups, and returns an iterator
+   * to the first value of the second group. The predicate is called exactly
+   * once per value, possibly concurrently. A temporary copy of the range is
+   * allocated.
+   */
+  template <typename Iterator, typename Predicate>
+  static Iterator Partition(Iterator begin, Iterator end, Predicate pred)
+  {
+    auto& SMPToolsAPI = vtk::detail::smp::vtkSMPToolsAPI::GetInstance();
+    return SMPToolsAPI.Partition(begin, end, pred);
+  }
 };
 
 VTK_ABI_NAMESPACE_END
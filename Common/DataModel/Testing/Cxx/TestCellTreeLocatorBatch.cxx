@@ -0,0 +1,206 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that the parallel build of vtkCellTreeLocator does not depend on the
+// number of threads, and that the batched queries match the single point ones.
+
+#include "vtkCellArray.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkCellTypeSource.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkTransform.h"
+#include "vtkTransformFilter.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+void GenerateRepresentation(vtkCellTreeLocator* locator, vtkPolyData* representation)
+{
+  vtkNew<vtkPoints> points;
+  representation->SetPoints(points);
+  vtkNew<vtkCellArray> lines;
+  representation->SetLines(lines);
+  locator->GenerateRepresentation(-1, representation);
+}
+
+bool SameRepresentation(vtkCellTreeLocator* locator1, vtkCellTreeLocator* locator2)
+{
+  vtkNew<vtkPolyData> representation1;
+  GenerateRepresentation(locator1, representation1);
+  vtkNew<vtkPolyData> representation2;
+  GenerateRepresentation(locator2, representation2);
+  vtkPoints* points1 = representation1->GetPoints();
+  vtkPoints* points2 = representation2->GetPoints();
+  if (points1->GetNumberOfPoints() != points2->GetNumberOfPoints())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < points1->GetNumberOfPoints(); ++i)
+  {
+    double x1[3], x2[3];
+    points1->GetPoint(i, x1);
+    points2->GetPoint(i, x2);
+    if (x1[0] != x2[0] || x1[1] != x2[1] || x1[2] != x2[2])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The cells of the whole data set are listed leaf by leaf, so the lists are equal when the
+// leaves hold the same cells in the same order.
+bool SameLeaves(vtkCellTreeLocator* locator1, vtkCellTreeLocator* locator2, double bounds[6])
+{
+  vtkNew<vtkIdList> cellIds1;
+  locator1->FindCellsWithinBounds(bounds, cellIds1);
+  vtkNew<vtkIdList> cellIds2;
+  locator2->FindCellsWithinBounds(bounds, cellIds2);
+  if (cellIds1->GetNumberOfIds() != cellIds2->GetNumberOfIds())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < cellIds1->GetNumberOfIds(); ++i)
+  {
+    if (cellIds1->GetId(i) != cellIds2->GetId(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestCellTreeLocatorBatch(int, char*[])
+{
+  // A strongly anisotropic tetrahedral mesh.
+  vtkNew<vtkCellTypeSource> source;
+  source->SetCellType(VTK_TETRA);
+  source->SetBlocksDimensions(16, 16, 16);
+  source->SetOutputPrecision(vtkAlgorithm::DOUBLE_PRECISION);
+  vtkNew<vtkTransform> scale;
+  scale->Scale(100.0, 1.0, 0.01);
+  vtkNew<vtkTransformFilter> transform;
+  transform->SetInputConnection(source->GetOutputPort());
+  transform->SetTransform(scale);
+  transform->Update();
+  vtkUnstructuredGrid* grid = transform->GetUnstructuredGridOutput();
+
+  vtkNew<vtkCellTreeLocator> locator;
+  locator->SetDataSet(grid);
+  locator->BuildLocator();
+
+  vtkNew<vtkCellTreeLocator> serialLocator;
+  serialLocator->SetDataSet(grid);
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { serialLocator->BuildLocator(); });
+  double bounds[6];
+  grid->GetBounds(bounds);
+  if (!SameRepresentation(locator, serialLocator) || !SameLeaves(locator, serialLocator, bounds))
+  {
+    std::cerr << "The tree depends on the number of threads." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Probe points inside and around the mesh.
+  const vtkIdType numberOfPoints = 2000;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(42);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numberOfPoints);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    double x[3];
+    for (int d = 0; d < 3; ++d)
+    {
+      const double margin = 0.1 * (bounds[2 * d + 1] - bounds[2 * d]);
+      x[d] = random->GetNextRangeValue(bounds[2 * d] - margin, bounds[2 * d + 1] + margin);
+    }
+    points->SetPoint(i, x);
+  }
+
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> pcoords;
+  locator->FindCells(points, cellIds, pcoords);
+  if (cellIds->GetNumberOfIds() != numberOfPoints || pcoords->GetNumberOfTuples() != numberOfPoints)
+  {
+    std::cerr << "Wrong size of the FindCells output." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkGenericCell> cell;
+  std::vector<double> weights(grid->GetMaxCellSize());
+  vtkIdType numberOfFoundCells = 0;
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    double x[3], pc[3];
+    int subId;
+    points->GetPoint(i, x);
+    const vtkIdType cellId = locator->FindCell(x, 0.0, cell, subId, pc, weights.data());
+    if (cellId != cellIds->GetId(i))
+    {
+      std::cerr << "FindCells found cell " << cellIds->GetId(i) << " instead of " << cellId
+                << " for point " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (cellId >= 0)
+    {
+      ++numberOfFoundCells;
+      double batchPc[3];
+      pcoords->GetTypedTuple(i, batchPc);
+      if (batchPc[0] != pc[0] || batchPc[1] != pc[1] || batchPc[2] != pc[2])
+      {
+        std::cerr << "Wrong parametric coordinates for point " << i << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  if (numberOfFoundCells == 0 || numberOfFoundCells == numberOfPoints)
+  {
+    std::cerr << "The probe points must be both inside and outside the mesh." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Closest points are compared with the ones of another locator.
+  vtkNew<vtkPoints> closestPoints;
+  vtkNew<vtkDoubleArray> dist2;
+  locator->FindClosestPoints(points, closestPoints, cellIds, dist2);
+  vtkNew<vtkStaticCellLocator> staticLocator;
+  staticLocator->SetDataSet(grid);
+  staticLocator->BuildLocator();
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    double x[3], closestPoint[3], expectedDist2;
+    vtkIdType cellId;
+    int subId;
+    points->GetPoint(i, x);
+    staticLocator->FindClosestPoint(x, closestPoint, cellId, subId, expectedDist2);
+    if (cellIds->GetId(i) < 0 ||
+      std::abs(dist2->GetValue(i) - expectedDist2) > 1e-9 * (1.0 + expectedDist2))
+    {
+      std::cerr << "Wrong closest point for point " << i << ": distance " << dist2->GetValue(i)
+                << " instead of " << expectedDist2 << std::endl;
+      return EXIT_FAILURE;
+    }
+    locator->FindClosestPoint(x, closestPoint, cellId, subId, expectedDist2);
+    if (cellId != cellIds->GetId(i) || expectedDist2 != dist2->GetValue(i))
+    {
+      std::cerr << "FindClosestPoints differs from FindClosestPoint for point " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
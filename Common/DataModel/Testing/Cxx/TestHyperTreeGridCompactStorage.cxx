@@ -0,0 +1,309 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that the cursors see the same trees once they are compacted or built
+// in a compact storage, that modifying a compact grid leaves its copies
+// unchanged, and that the views on the trees are accounted for.
+
+#include "vtkBitArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkHyperTree.h"
+#include "vtkHyperTreeGrid.h"
+#include "vtkHyperTreeGridNonOrientedCursor.h"
+#include "vtkHyperTreeGridNonOrientedGeometryCursor.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkTypeInt64Array.h"
+#include "vtkUniformHyperTreeGrid.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+//------------------------------------------------------------------------------
+void InitializeGrid(vtkHyperTreeGrid* htg)
+{
+  htg->SetBranchFactor(2);
+  htg->SetDimensions(7, 6, 5);
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    vtkNew<vtkDoubleArray> coordinates;
+    coordinates->SetNumberOfValues(htg->GetDimensions()[axis]);
+    for (vtkIdType i = 0; i < coordinates->GetNumberOfValues(); ++i)
+    {
+      coordinates->SetValue(i, i * i + 0.5 * axis);
+    }
+    axis == 0 ? htg->SetXCoordinates(coordinates)
+              : (axis == 1 ? htg->SetYCoordinates(coordinates) : htg->SetZCoordinates(coordinates));
+  }
+}
+
+//------------------------------------------------------------------------------
+void RefineRandomly(
+  vtkHyperTreeGridNonOrientedCursor* cursor, vtkMinimalStandardRandomSequence* random)
+{
+  if (cursor->GetLevel() < 4 && random->GetNextRangeValue(0.0, 1.0) < 0.4)
+  {
+    cursor->SubdivideLeaf();
+    for (unsigned char ichild = 0; ichild < cursor->GetNumberOfChildren(); ++ichild)
+    {
+      cursor->ToChild(ichild);
+      RefineRandomly(cursor, random);
+      cursor->ToParent();
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+bool SameTree(vtkHyperTreeGridNonOrientedGeometryCursor* cursor1,
+  vtkHyperTreeGridNonOrientedGeometryCursor* cursor2)
+{
+  double bounds1[6], bounds2[6];
+  cursor1->GetBounds(bounds1);
+  cursor2->GetBounds(bounds2);
+  if (cursor1->IsLeaf() != cursor2->IsLeaf() || cursor1->GetLevel() != cursor2->GetLevel() ||
+    cursor1->GetGlobalNodeIndex() != cursor2->GetGlobalNodeIndex() ||
+    !std::equal(bounds1, bounds1 + 6, bounds2))
+  {
+    return false;
+  }
+  for (unsigned char ichild = 0; !cursor1->IsLeaf() && ichild < cursor1->GetNumberOfChildren();
+       ++ichild)
+  {
+    cursor1->ToChild(ichild);
+    cursor2->ToChild(ichild);
+    const bool same = SameTree(cursor1, cursor2);
+    cursor1->ToParent();
+    cursor2->ToParent();
+    if (!same)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool SameTrees(vtkHyperTreeGrid* htg1, vtkHyperTreeGrid* htg2)
+{
+  if (htg1->GetNumberOfNonEmptyTrees() != htg2->GetNumberOfNonEmptyTrees() ||
+    htg1->GetNumberOfCells() != htg2->GetNumberOfCells() ||
+    htg1->GetNumberOfLeaves() != htg2->GetNumberOfLeaves() ||
+    htg1->GetNumberOfLevels() != htg2->GetNumberOfLevels() ||
+    htg1->GetGlobalNodeIndexMax() != htg2->GetGlobalNodeIndexMax())
+  {
+    return false;
+  }
+  vtkHyperTreeGrid::vtkHyperTreeGridIterator it1;
+  htg1->InitializeTreeIterator(it1);
+  vtkHyperTreeGrid::vtkHyperTreeGridIterator it2;
+  htg2->InitializeTreeIterator(it2);
+  vtkIdType index1, index2;
+  vtkNew<vtkHyperTreeGridNonOrientedGeometryCursor> cursor1;
+  vtkNew<vtkHyperTreeGridNonOrientedGeometryCursor> cursor2;
+  while (it1.GetNextTree(index1))
+  {
+    if (!it2.GetNextTree(index2) || index1 != index2)
+    {
+      return false;
+    }
+    htg1->InitializeNonOrientedGeometryCursor(cursor1, index1);
+    htg2->InitializeNonOrientedGeometryCursor(cursor2, index2);
+    if (!SameTree(cursor1, cursor2))
+    {
+      return false;
+    }
+  }
+  return !it2.GetNextTree();
+}
+}
+
+//------------------------------------------------------------------------------
+int TestHyperTreeGridCompactStorage(int, char*[])
+{
+  // Random trees, leaving some of them empty
+  vtkNew<vtkHyperTreeGrid> htg;
+  InitializeGrid(htg);
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(3);
+  vtkNew<vtkHyperTreeGridNonOrientedCursor> cursor;
+  for (vtkIdType index = 0; index < htg->GetMaxNumberOfTrees(); ++index)
+  {
+    if (index % 7 != 3)
+    {
+      const vtkIdType globalIndexStart = htg->GetNumberOfCells();
+      htg->InitializeNonOrientedCursor(cursor, index, true);
+      cursor->SetGlobalIndexStart(globalIndexStart);
+      RefineRandomly(cursor, random);
+    }
+  }
+
+  vtkNew<vtkHyperTreeGrid> reference;
+  reference->DeepCopy(htg);
+  htg->CompactTrees();
+  if (!htg->HasCompactTrees() || !SameTrees(htg, reference))
+  {
+    std::cerr << "The compact trees differ from the original ones." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The trees are retrieved concurrently
+  vtkSMPThreadLocal<vtkIdType> numberOfCells(0);
+  vtkSMPTools::For(0, htg->GetMaxNumberOfTrees(),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType index = begin; index < end; ++index)
+      {
+        if (vtkHyperTree* tree = htg->GetTree(index))
+        {
+          numberOfCells.Local() += tree->GetNumberOfVertices();
+        }
+      }
+    });
+  vtkIdType totalNumberOfCells = 0;
+  for (vtkIdType count : numberOfCells)
+  {
+    totalNumberOfCells += count;
+  }
+  if (totalNumberOfCells != reference->GetNumberOfCells())
+  {
+    std::cerr << "Wrong number of cells in the concurrently retrieved trees." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Modifying a copy leaves the original compact grid unchanged
+  vtkNew<vtkHyperTreeGrid> copy;
+  copy->ShallowCopy(htg);
+  copy->InitializeNonOrientedCursor(cursor, 0);
+  while (!cursor->IsLeaf())
+  {
+    cursor->ToChild(0);
+  }
+  cursor->SubdivideLeaf();
+  const vtkIdType numberOfChildren = cursor->GetNumberOfChildren();
+  if (!SameTrees(htg, reference) ||
+    copy->GetNumberOfCells() != reference->GetNumberOfCells() + numberOfChildren)
+  {
+    std::cerr << "Modifying a compact tree changed the other grids." << std::endl;
+    return EXIT_FAILURE;
+  }
+  vtkNew<vtkHyperTreeGrid> modified;
+  modified->DeepCopy(copy);
+  copy->CompactTrees();
+  if (!copy->HasCompactTrees() || !SameTrees(copy, modified))
+  {
+    std::cerr << "The modified tree was not compacted." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Creating a tree moves the trees back to the default storage
+  copy->InitializeNonOrientedCursor(cursor, 3, true);
+  if (copy->HasCompactTrees() ||
+    copy->GetNumberOfNonEmptyTrees() != modified->GetNumberOfNonEmptyTrees() + 1)
+  {
+    std::cerr << "The trees were not moved back to the default storage." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Build the trees from their breadth first order descriptors, in the
+  // default storage and in the compact one
+  vtkNew<vtkIdTypeArray> treeIndices;
+  vtkNew<vtkBitArray> descriptor;
+  vtkNew<vtkIdTypeArray> numberOfBits;
+  vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
+  reference->InitializeTreeIterator(it);
+  vtkIdType index;
+  while (vtkHyperTree* tree = it.GetNextTree(index))
+  {
+    vtkNew<vtkTypeInt64Array> numberOfVerticesPerDepth;
+    vtkNew<vtkIdList> breadthFirstIdMap;
+    const vtkIdType size = descriptor->GetNumberOfValues();
+    tree->ComputeBreadthFirstOrderDescriptor(std::numeric_limits<unsigned int>::max(), nullptr,
+      numberOfVerticesPerDepth, descriptor, breadthFirstIdMap);
+    treeIndices->InsertNextValue(index);
+    numberOfBits->InsertNextValue(descriptor->GetNumberOfValues() - size);
+  }
+  vtkNew<vtkHyperTreeGrid> built;
+  InitializeGrid(built);
+  vtkIdType startIndex = 0;
+  for (vtkIdType i = 0; i < treeIndices->GetNumberOfValues(); ++i)
+  {
+    const vtkIdType globalIndexStart = built->GetNumberOfCells();
+    built->InitializeNonOrientedCursor(cursor, treeIndices->GetValue(i), true);
+    cursor->SetGlobalIndexStart(globalIndexStart);
+    cursor->GetTree()->BuildFromBreadthFirstOrderDescriptor(
+      descriptor, numberOfBits->GetValue(i), startIndex);
+    startIndex += numberOfBits->GetValue(i);
+  }
+  vtkNew<vtkHyperTreeGrid> compactBuilt;
+  InitializeGrid(compactBuilt);
+  if (!compactBuilt->BuildCompactTrees(treeIndices, descriptor, numberOfBits))
+  {
+    std::cerr << "The trees could not be built in the compact storage." << std::endl;
+    return EXIT_FAILURE;
+  }
+  const unsigned long storageSize = compactBuilt->GetActualMemorySizeBytes();
+
+  // The number of levels of a tree is read without creating its view
+  for (vtkIdType i = 0; i < treeIndices->GetNumberOfValues(); ++i)
+  {
+    const vtkIdType index = treeIndices->GetValue(i);
+    if (compactBuilt->GetNumberOfLevels(index) != built->GetNumberOfLevels(index))
+    {
+      std::cerr << "Wrong number of levels for tree " << index << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (compactBuilt->GetActualMemorySizeBytes() != storageSize)
+  {
+    std::cerr << "Views were created to get the number of levels of the trees." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!compactBuilt->HasCompactTrees() || !SameTrees(compactBuilt, built) ||
+    compactBuilt->GetNumberOfCells() != reference->GetNumberOfCells())
+  {
+    std::cerr << "The trees built in the compact storage differ from the others." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The views created by the comparison, then the data of a modified one,
+  // are counted in the memory size of the grid
+  const unsigned long viewsSize = compactBuilt->GetActualMemorySizeBytes();
+  compactBuilt->InitializeNonOrientedCursor(cursor, 0);
+  while (!cursor->IsLeaf())
+  {
+    cursor->ToChild(0);
+  }
+  cursor->SubdivideLeaf();
+  if (viewsSize <= storageSize || compactBuilt->GetActualMemorySizeBytes() <= viewsSize)
+  {
+    std::cerr << "Wrong memory size of the compact storage." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The views on the trees of a uniform grid share its scales
+  vtkNew<vtkUniformHyperTreeGrid> uniform;
+  uniform->SetBranchFactor(2);
+  uniform->SetDimensions(4, 3, 2);
+  for (vtkIdType i = 0; i < uniform->GetMaxNumberOfTrees(); ++i)
+  {
+    uniform->InitializeNonOrientedCursor(cursor, i, true);
+    cursor->SetGlobalIndexStart(i);
+  }
+  uniform->CompactTrees();
+  const vtkIdType lastIndex = uniform->GetMaxNumberOfTrees() - 1;
+  if (!uniform->HasCompactTrees() ||
+    uniform->GetTree(0)->GetScales() != uniform->GetTree(lastIndex)->GetScales())
+  {
+    std::cerr << "The trees of the uniform grid do not share their scales." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,200 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that the parallel build of vtkKdTree does not depend on the number of
+// threads, that the regions of a lattice of points are the expected ones, and
+// that the regions containing the cells are the expected ones.
+
+#include "vtkCell.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkKdTree.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Build a tree with the default number of threads, and another one serially.
+template <typename BuildT>
+void BuildInParallelAndSerially(vtkKdTree* tree, vtkKdTree* serialTree, BuildT&& build)
+{
+  build(tree);
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { build(serialTree); });
+}
+
+//------------------------------------------------------------------------------
+bool SameRegions(vtkKdTree* tree1, vtkKdTree* tree2)
+{
+  if (tree1->GetNumberOfRegions() != tree2->GetNumberOfRegions() ||
+    tree1->GetLevel() != tree2->GetLevel())
+  {
+    return false;
+  }
+  for (int region = 0; region < tree1->GetNumberOfRegions(); ++region)
+  {
+    double bounds1[6], bounds2[6], dataBounds1[6], dataBounds2[6];
+    tree1->GetRegionBounds(region, bounds1);
+    tree2->GetRegionBounds(region, bounds2);
+    tree1->GetRegionDataBounds(region, dataBounds1);
+    tree2->GetRegionDataBounds(region, dataBounds2);
+    if (!std::equal(bounds1, bounds1 + 6, bounds2) ||
+      !std::equal(dataBounds1, dataBounds1 + 6, dataBounds2))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// The first region whose bounds contain the point, like a traversal of the tree.
+int FindRegion(vtkKdTree* tree, const double x[3])
+{
+  for (int region = 0; region < tree->GetNumberOfRegions(); ++region)
+  {
+    double bounds[6];
+    tree->GetRegionBounds(region, bounds);
+    if (bounds[0] <= x[0] && x[0] <= bounds[1] && bounds[2] <= x[1] && x[1] <= bounds[3] &&
+      bounds[4] <= x[2] && x[2] <= bounds[5])
+    {
+      return region;
+    }
+  }
+  return -1;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestKdTreeParallelBuild(int, char*[])
+{
+  // A lattice of 128^3 points, more than the size above which the median of a
+  // region is found in parallel. Each coordinate is repeated many times.
+  const int n = 128;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  points->SetNumberOfPoints(n * n * n);
+  for (int k = 0, i = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int l = 0; l < n; ++l, ++i)
+      {
+        points->SetPoint(i, l, j, k);
+      }
+    }
+  }
+
+  vtkNew<vtkKdTree> pointTree;
+  pointTree->SetNumberOfRegionsOrMore(8);
+  vtkNew<vtkKdTree> serialPointTree;
+  serialPointTree->SetNumberOfRegionsOrMore(8);
+  BuildInParallelAndSerially(
+    pointTree, serialPointTree, [&](vtkKdTree* tree) { tree->BuildLocatorFromPoints(points); });
+  if (!SameRegions(pointTree, serialPointTree))
+  {
+    std::cerr << "The point tree depends on the number of threads." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (int region = 0; region < pointTree->GetNumberOfRegions(); ++region)
+  {
+    vtkIdTypeArray* ids = pointTree->GetPointsInRegion(region);
+    vtkIdTypeArray* serialIds = serialPointTree->GetPointsInRegion(region);
+    if (ids->GetNumberOfValues() != serialIds->GetNumberOfValues() ||
+      !std::equal(ids->Begin(), ids->End(), serialIds->Begin()))
+    {
+      std::cerr << "The order of the points of region " << region
+                << " depends on the number of threads." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The lattice is split at the median along x, then y, then z: each region is
+  // an octant of 64^3 points, cut at 63.5 from its neighbors.
+  if (pointTree->GetNumberOfRegions() != 8)
+  {
+    std::cerr << "Wrong number of regions: " << pointTree->GetNumberOfRegions() << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::vector<bool> octants(8, false);
+  for (int region = 0; region < 8; ++region)
+  {
+    double bounds[6], dataBounds[6];
+    pointTree->GetRegionBounds(region, bounds);
+    pointTree->GetRegionDataBounds(region, dataBounds);
+    int octant = 0;
+    for (int d = 0; d < 3; ++d)
+    {
+      const bool upper = dataBounds[2 * d] == n / 2;
+      const bool lower = dataBounds[2 * d] == 0.0 && dataBounds[2 * d + 1] == n / 2 - 1;
+      if ((!upper && !lower) || (upper && dataBounds[2 * d + 1] != n - 1) ||
+        bounds[upper ? 2 * d : 2 * d + 1] != (n - 1) / 2.0)
+      {
+        std::cerr << "Wrong bounds for region " << region << std::endl;
+        return EXIT_FAILURE;
+      }
+      octant |= upper << d;
+    }
+    if (pointTree->GetPointsInRegion(region)->GetNumberOfValues() != n * n * n / 8 ||
+      octants[octant])
+    {
+      std::cerr << "Wrong points in region " << region << std::endl;
+      return EXIT_FAILURE;
+    }
+    octants[octant] = true;
+  }
+
+  for (int i = 0; i < n * n * n; i += 997)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    if (pointTree->GetRegionContainingPoint(x[0], x[1], x[2]) != FindRegion(pointTree, x))
+    {
+      std::cerr << "Wrong region for point " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Cells, with the regions containing their centers.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(49, 49, 49);
+  image->SetSpacing(1.0, 0.8, 1.2);
+  vtkNew<vtkKdTree> cellTree;
+  vtkNew<vtkKdTree> serialCellTree;
+  BuildInParallelAndSerially(cellTree, serialCellTree,
+    [&](vtkKdTree* tree)
+    {
+      tree->SetMinCells(20);
+      tree->SetDataSet(image);
+      tree->BuildLocator();
+    });
+  if (!SameRegions(cellTree, serialCellTree))
+  {
+    std::cerr << "The cell tree depends on the number of threads." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const int* regions = cellTree->AllGetRegionContainingCell();
+  for (vtkIdType cellId = 0; cellId < image->GetNumberOfCells(); cellId += 13)
+  {
+    double pcoords[3], x[3], weights[8];
+    int subId = image->GetCell(cellId)->GetParametricCenter(pcoords);
+    image->GetCell(cellId)->EvaluateLocation(subId, pcoords, x, weights);
+    for (int d = 0; d < 3; ++d)
+    {
+      x[d] = static_cast<float>(x[d]);
+    }
+    if (regions[cellId] < 0 || regions[cellId] != FindRegion(cellTree, x))
+    {
+      std::cerr << "Wrong region for cell " << cellId << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,303 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that the batched queries of the point and cell locators match the
+// single point queries.
+
+#include "vtkCellArray.h"
+#include "vtkCellLocator.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkKdTreePointLocator.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStaticPointLocator.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A cell locator without search structure, which finds the cells with the data set.
+class DataSetCellLocator : public vtkAbstractCellLocator
+{
+public:
+  static DataSetCellLocator* New();
+  vtkTypeMacro(DataSetCellLocator, vtkAbstractCellLocator);
+  void BuildLocator() override {}
+  void FreeSearchStructure() override {}
+  void GenerateRepresentation(int, vtkPolyData*) override {}
+};
+vtkStandardNewMacro(DataSetCellLocator);
+
+//------------------------------------------------------------------------------
+void RandomPoints(vtkPoints* points, vtkIdType numberOfPoints, const double bounds[6], int seed)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(seed);
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numberOfPoints);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    double x[3];
+    for (int d = 0; d < 3; ++d)
+    {
+      x[d] = random->GetNextRangeValue(bounds[2 * d], bounds[2 * d + 1]);
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+//------------------------------------------------------------------------------
+// A sheared grid of hexahedra.
+void MakeGrid(vtkUnstructuredGrid* grid, int n)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  for (int k = 0; k <= n; ++k)
+  {
+    for (int j = 0; j <= n; ++j)
+    {
+      for (int i = 0; i <= n; ++i)
+      {
+        points->InsertNextPoint(i + 0.3 * j, j + 0.2 * k, k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->AllocateExact(n * n * n, 8);
+  auto id = [n](int i, int j, int k) -> vtkIdType { return i + (n + 1) * (j + (n + 1) * k); };
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        const vtkIdType hexahedron[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k),
+          id(i, j + 1, k), id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1),
+          id(i, j + 1, k + 1) };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hexahedron);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+bool TestPointLocator(vtkAbstractPointLocator* locator, vtkPoints* queries)
+{
+  locator->BuildLocator();
+
+  vtkNew<vtkIdList> closest;
+  locator->FindClosestPoints(queries, closest);
+  vtkNew<vtkCellArray> neighbors;
+  locator->FindPointsWithinRadius(0.05, queries, neighbors);
+  if (closest->GetNumberOfIds() != queries->GetNumberOfPoints() ||
+    neighbors->GetNumberOfCells() != queries->GetNumberOfPoints())
+  {
+    std::cerr << locator->GetClassName() << ": wrong size of the batched results" << std::endl;
+    return false;
+  }
+
+  vtkNew<vtkIdList> expected;
+  vtkNew<vtkIdList> ids;
+  vtkIdType numberOfNeighbors = 0;
+  for (vtkIdType i = 0; i < queries->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    queries->GetPoint(i, x);
+    if (closest->GetId(i) != locator->FindClosestPoint(x))
+    {
+      std::cerr << locator->GetClassName() << ": wrong closest point for point " << i
+                << std::endl;
+      return false;
+    }
+    locator->FindPointsWithinRadius(0.05, x, expected);
+    neighbors->GetCellAtId(i, ids);
+    numberOfNeighbors += ids->GetNumberOfIds();
+    if (ids->GetNumberOfIds() != expected->GetNumberOfIds() ||
+      !std::equal(ids->begin(), ids->end(), expected->begin()))
+    {
+      std::cerr << locator->GetClassName() << ": wrong points within radius for point " << i
+                << std::endl;
+      return false;
+    }
+  }
+  if (numberOfNeighbors == 0)
+  {
+    std::cerr << locator->GetClassName() << ": no point found within radius" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool TestCellLocator(vtkAbstractCellLocator* locator, vtkPoints* queries, vtkPoints* ends)
+{
+  locator->BuildLocator();
+  const vtkIdType numberOfPoints = queries->GetNumberOfPoints();
+  vtkNew<vtkGenericCell> cell;
+  std::vector<double> weights(locator->GetDataSet()->GetMaxCellSize());
+
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> pcoords;
+  locator->FindCells(queries, cellIds, pcoords);
+  vtkIdType numberOfFoundCells = 0;
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    double x[3], pc[3], batchPc[3];
+    int subId;
+    queries->GetPoint(i, x);
+    const vtkIdType cellId = locator->FindCell(x, 0.0, cell, subId, pc, weights.data());
+    if (cellId != cellIds->GetId(i))
+    {
+      std::cerr << locator->GetClassName() << ": wrong cell for point " << i << std::endl;
+      return false;
+    }
+    pcoords->GetTypedTuple(i, batchPc);
+    if (cellId >= 0 && (pc[0] != batchPc[0] || pc[1] != batchPc[1] || pc[2] != batchPc[2]))
+    {
+      std::cerr << locator->GetClassName() << ": wrong parametric coordinates for point " << i
+                << std::endl;
+      return false;
+    }
+    numberOfFoundCells += cellId >= 0;
+  }
+  if (numberOfFoundCells == 0 || numberOfFoundCells == numberOfPoints)
+  {
+    std::cerr << locator->GetClassName() << ": the points must be inside and outside the cells"
+              << std::endl;
+    return false;
+  }
+
+  vtkNew<vtkPoints> closestPoints;
+  vtkNew<vtkDoubleArray> dist2;
+  locator->FindClosestPoints(queries, closestPoints, cellIds, dist2);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    double x[3], closestPoint[3], d2;
+    vtkIdType cellId;
+    int subId;
+    queries->GetPoint(i, x);
+    locator->FindClosestPoint(x, closestPoint, cell, cellId, subId, d2);
+    if (cellId != cellIds->GetId(i) || d2 != dist2->GetValue(i))
+    {
+      std::cerr << locator->GetClassName() << ": wrong closest point for point " << i
+                << std::endl;
+      return false;
+    }
+  }
+
+  vtkNew<vtkPoints> intersections;
+  vtkNew<vtkDoubleArray> t;
+  locator->IntersectWithLines(queries, ends, 0.0, cellIds, intersections, t);
+  vtkIdType numberOfIntersections = 0;
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    double p1[3], p2[3], x[3], pc[3], tLine;
+    vtkIdType cellId = -1;
+    int subId;
+    queries->GetPoint(i, p1);
+    ends->GetPoint(i, p2);
+    if (!locator->IntersectWithLine(p1, p2, 0.0, tLine, x, pc, subId, cellId, cell))
+    {
+      cellId = -1;
+    }
+    if (cellId != cellIds->GetId(i) || (cellId >= 0 && tLine != t->GetValue(i)))
+    {
+      std::cerr << locator->GetClassName() << ": wrong intersection for segment " << i
+                << std::endl;
+      return false;
+    }
+    numberOfIntersections += cellId >= 0;
+  }
+  if (numberOfIntersections == 0)
+  {
+    std::cerr << locator->GetClassName() << ": no segment intersects the cells" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestLocatorBatchQueries(int, char*[])
+{
+  const double unitBounds[6] = { 0.0, 1.0, 0.0, 1.0, 0.0, 1.0 };
+  vtkNew<vtkPolyData> cloud;
+  vtkNew<vtkPoints> cloudPoints;
+  RandomPoints(cloudPoints, 20000, unitBounds, 1);
+  cloud->SetPoints(cloudPoints);
+  vtkNew<vtkPoints> pointQueries;
+  RandomPoints(pointQueries, 3000, unitBounds, 2);
+
+  vtkNew<vtkStaticPointLocator> staticPointLocator;
+  vtkNew<vtkPointLocator> pointLocator;
+  vtkNew<vtkKdTreePointLocator> kdTreePointLocator;
+  for (vtkAbstractPointLocator* locator :
+    { static_cast<vtkAbstractPointLocator*>(staticPointLocator),
+      static_cast<vtkAbstractPointLocator*>(pointLocator),
+      static_cast<vtkAbstractPointLocator*>(kdTreePointLocator) })
+  {
+    locator->SetDataSet(cloud);
+    if (!TestPointLocator(locator, pointQueries))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid, 12);
+  double bounds[6];
+  grid->GetBounds(bounds);
+  for (int d = 0; d < 3; ++d)
+  {
+    bounds[2 * d] -= 1.0;
+    bounds[2 * d + 1] += 1.0;
+  }
+  vtkNew<vtkPoints> cellQueries;
+  RandomPoints(cellQueries, 3000, bounds, 3);
+  vtkNew<vtkPoints> ends;
+  RandomPoints(ends, 3000, bounds, 4);
+
+  vtkNew<vtkStaticCellLocator> staticCellLocator;
+  vtkNew<vtkCellLocator> cellLocator;
+  vtkNew<vtkCellTreeLocator> cellTreeLocator;
+  for (vtkAbstractCellLocator* locator :
+    { static_cast<vtkAbstractCellLocator*>(staticCellLocator),
+      static_cast<vtkAbstractCellLocator*>(cellLocator),
+      static_cast<vtkAbstractCellLocator*>(cellTreeLocator) })
+  {
+    locator->SetDataSet(grid);
+    if (!TestCellLocator(locator, cellQueries, ends))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The default FindCells() gives its tolerance to FindCell(), which falls back to the data set.
+  vtkNew<DataSetCellLocator> dataSetLocator;
+  dataSetLocator->SetDataSet(grid);
+  vtkNew<vtkPoints> belowGrid;
+  belowGrid->InsertNextPoint(0.65, 0.5, -5e-7);
+  vtkNew<vtkIdList> cellIds;
+  vtkObject::GlobalWarningDisplayOff();
+  dataSetLocator->FindCells(belowGrid, cellIds);
+  const vtkIdType cellIdWithoutTolerance = cellIds->GetId(0);
+  dataSetLocator->FindCells(belowGrid, cellIds, nullptr, 1e-10);
+  vtkObject::GlobalWarningDisplayOn();
+  if (cellIdWithoutTolerance != -1 || cellIds->GetId(0) != 0)
+  {
+    std::cerr << "The tolerance of FindCells() is not used" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include "vtkAbstractCellLocator.h"
+#include "vtkAbstractCellLocator.txx"
 
 #include "vtkCellArray.h"
 #include "vtkDataArrayRange.h"
@@ -16,6 +17,8 @@
 #include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <atomic>
+
 //------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
 vtkAbstractCellLocator::vtkAbstractCellLocator()
@@ -245,12 +248,11 @@ vtkIdType vtkAbstractCellLocator::FindCell(
 {
   vtkIdType returnVal = -1;
   //
-  static bool warning_shown = false;
-  if (!warning_shown)
+  static std::atomic<bool> warning_shown(false);
+  if (!warning_shown.exchange(true))
   {
     vtkWarningMacro(<< this->GetClassName() << " Does not implement FindCell"
                     << " Reverting to slow DataSet implementation");
-    warning_shown = true;
   }
   //
   if (this->DataSet)
@@ -260,6 +262,51 @@ vtkIdType vtkAbstractCellLocator::FindCell(
   return returnVal;
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindCells(
+  vtkPoints* points, vtkIdList* cellIds, vtkDoubleArray* pcoords, double tol2)
+{
+  this->BuildLocator();
+  const bool empty = !this->DataSet || this->DataSet->GetNumberOfCells() == 0;
+  this->BatchFindCells(points, cellIds, pcoords,
+    [this, empty, tol2](double x[3], vtkGenericCell* cell, int& subId, double pc[3],
+      double* weights) { return empty ? -1 : this->FindCell(x, tol2, cell, subId, pc, weights); });
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindClosestPoints(
+  vtkPoints* points, vtkPoints* closestPoints, vtkIdList* cellIds, vtkDoubleArray* dist2)
+{
+  this->BuildLocator();
+  const bool empty = !this->DataSet || this->DataSet->GetNumberOfCells() == 0;
+  this->BatchFindClosestPoints(points, closestPoints, cellIds, dist2,
+    [this, empty](double x[3], double closestPoint[3], vtkGenericCell* cell, vtkIdType& cellId,
+      int& subId, double& d2, double*) -> vtkIdType
+    {
+      cellId = -1;
+      if (!empty)
+      {
+        this->FindClosestPoint(x, closestPoint, cell, cellId, subId, d2);
+      }
+      return cellId >= 0 ? 1 : 0;
+    });
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractCellLocator::IntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol,
+  vtkIdList* cellIds, vtkPoints* points, vtkDoubleArray* t)
+{
+  this->BuildLocator();
+  const bool empty = !this->DataSet || this->DataSet->GetNumberOfCells() == 0;
+  this->BatchIntersectWithLines(p1, p2, tol, cellIds, points, t,
+    [this, empty](const double a[3], const double b[3], double tolerance, double& tLine,
+      double x[3], double pc[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+    {
+      return empty ? 0
+                   : this->IntersectWithLine(a, b, tolerance, tLine, x, pc, subId, cellId, cell);
+    });
+}
+
 //------------------------------------------------------------------------------
 bool vtkAbstractCellLocator::InsideCellBounds(double x[3], vtkIdType cell_ID)
 {
@@ -34,6 +34,7 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkCellArray;
+class vtkDoubleArray;
 class vtkGenericCell;
 class vtkIdList;
 class vtkPoints;
@@ -287,6 +288,42 @@ public:
     double pcoords[3], double* weights);
   ///@}
 
+  /**
+   * Find the cells containing the points of `points`. `cellIds` is resized to the number of
+   * points and filled with the id of the cell containing each point, or -1. If `pcoords` is not
+   * null, it is filled with the parametric coordinates of each point in its cell, as 3-component
+   * tuples, which are undefined for the points outside of the cells. `tol2` is the squared
+   * tolerance given to FindCell().
+   *
+   * The default implementation calls FindCell() concurrently for all the points.
+   */
+  virtual void FindCells(
+    vtkPoints* points, vtkIdList* cellIds, vtkDoubleArray* pcoords = nullptr, double tol2 = 0.0);
+
+  /**
+   * Find the closest point on the cells to each point of `points`. `closestPoints` and
+   * `cellIds` are resized to the number of points and filled with the closest points and the
+   * ids of the cells they lie on. If `dist2` is not null, it is filled with the squared
+   * distances to the closest points. The cell id of a point is -1 if no closest point is found,
+   * for instance if the data set has no cells.
+   *
+   * The default implementation calls FindClosestPoint() concurrently for all the points.
+   */
+  virtual void FindClosestPoints(vtkPoints* points, vtkPoints* closestPoints, vtkIdList* cellIds,
+    vtkDoubleArray* dist2 = nullptr);
+
+  /**
+   * Intersect the line segments going from the points of `p1` to the points of `p2` with the
+   * data set. `cellIds` is resized to the number of segments and filled with the id of the cell
+   * intersected by each segment as IntersectWithLine() would return it, or -1. If they are not
+   * null, `points` is filled with the intersection points and `t` with their parametric
+   * coordinates along the segments, which are undefined when no cell is intersected.
+   *
+   * The default implementation calls IntersectWithLine() concurrently for all the segments.
+   */
+  virtual void IntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol, vtkIdList* cellIds,
+    vtkPoints* points = nullptr, vtkDoubleArray* t = nullptr);
+
   /**
    * Quickly test if a point is inside the bounds of a particular cell.
    * Some locators cache cell bounds and this function can make use
@@ -323,6 +360,31 @@ protected:
    */
   void UpdateInternalWeights();
 
+  ///@{
+  /**
+   * Implement the batched queries FindCells(), FindClosestPoints() and IntersectWithLines() by
+   * calling a thread safe query concurrently, with thread local cells and weights. The outputs
+   * are resized as the batched queries do. Subclasses use them with their own queries, to skip
+   * the checks done for each point. The queries are callables invoked as:
+   * - `findCell(x, cell, subId, pcoords, weights)`, returning the cell id or -1,
+   * - `findClosestPoint(x, closestPoint, cell, cellId, subId, dist2, weights)`, returning 0 when
+   *   nothing is found,
+   * - `intersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId, cell)`, returning 0 when
+   *   there is no intersection.
+   *
+   * They are defined in vtkAbstractCellLocator.txx.
+   */
+  template <typename FindCellT>
+  void BatchFindCells(
+    vtkPoints* points, vtkIdList* cellIds, vtkDoubleArray* pcoords, FindCellT&& findCell);
+  template <typename FindClosestPointT>
+  void BatchFindClosestPoints(vtkPoints* points, vtkPoints* closestPoints, vtkIdList* cellIds,
+    vtkDoubleArray* dist2, FindClosestPointT&& findClosestPoint);
+  template <typename IntersectWithLineT>
+  void BatchIntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol, vtkIdList* cellIds,
+    vtkPoints* points, vtkDoubleArray* t, IntersectWithLineT&& intersectWithLine);
+  ///@}
+
   int NumberOfCellsPerNode;
   vtkTypeBool RetainCellLists;
   vtkTypeBool CacheCellBounds;
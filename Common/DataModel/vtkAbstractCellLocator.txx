@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkAbstractCellLocator_txx
+#define vtkAbstractCellLocator_txx
+
+#include "vtkAbstractCellLocator.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+//------------------------------------------------------------------------------
+VTK_ABI_NAMESPACE_BEGIN
+template <typename FindCellT>
+void vtkAbstractCellLocator::BatchFindCells(
+  vtkPoints* points, vtkIdList* cellIds, vtkDoubleArray* pcoords, FindCellT&& findCell)
+{
+  const vtkIdType numberOfPoints = points ? points->GetNumberOfPoints() : 0;
+  cellIds->SetNumberOfIds(numberOfPoints);
+  if (pcoords)
+  {
+    pcoords->SetNumberOfComponents(3);
+    pcoords->SetNumberOfTuples(numberOfPoints);
+  }
+
+  const int maxCellSize = this->DataSet ? this->DataSet->GetMaxCellSize() : 0;
+  vtkSMPThreadLocalObject<vtkGenericCell> localCell;
+  vtkSMPThreadLocal<std::vector<double>> localWeights;
+  vtkSMPTools::For(0, numberOfPoints,
+    [&](vtkIdType first, vtkIdType last)
+    {
+      vtkGenericCell* cell = localCell.Local();
+      std::vector<double>& weights = localWeights.Local();
+      weights.resize(maxCellSize);
+      double x[3], pc[3];
+      int subId;
+      for (vtkIdType i = first; i < last; ++i)
+      {
+        points->GetPoint(i, x);
+        cellIds->SetId(i, findCell(x, cell, subId, pc, weights.data()));
+        if (pcoords)
+        {
+          pcoords->SetTypedTuple(i, pc);
+        }
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+template <typename FindClosestPointT>
+void vtkAbstractCellLocator::BatchFindClosestPoints(vtkPoints* points, vtkPoints* closestPoints,
+  vtkIdList* cellIds, vtkDoubleArray* dist2, FindClosestPointT&& findClosestPoint)
+{
+  const vtkIdType numberOfPoints = points ? points->GetNumberOfPoints() : 0;
+  closestPoints->SetNumberOfPoints(numberOfPoints);
+  cellIds->SetNumberOfIds(numberOfPoints);
+  if (dist2)
+  {
+    dist2->SetNumberOfComponents(1);
+    dist2->SetNumberOfTuples(numberOfPoints);
+  }
+
+  const int maxCellSize = this->DataSet ? this->DataSet->GetMaxCellSize() : 0;
+  vtkSMPThreadLocalObject<vtkGenericCell> localCell;
+  vtkSMPThreadLocal<std::vector<double>> localWeights;
+  vtkSMPTools::For(0, numberOfPoints,
+    [&](vtkIdType first, vtkIdType last)
+    {
+      vtkGenericCell* cell = localCell.Local();
+      std::vector<double>& weights = localWeights.Local();
+      weights.resize(maxCellSize);
+      double x[3], closestPoint[3], d2;
+      vtkIdType cellId;
+      int subId;
+      for (vtkIdType i = first; i < last; ++i)
+      {
+        points->GetPoint(i, x);
+        if (!findClosestPoint(x, closestPoint, cell, cellId, subId, d2, weights.data()))
+        {
+          cellId = -1;
+          d2 = VTK_DOUBLE_MAX;
+          std::copy_n(x, 3, closestPoint);
+        }
+        closestPoints->SetPoint(i, closestPoint);
+        cellIds->SetId(i, cellId);
+        if (dist2)
+        {
+          dist2->SetValue(i, d2);
+        }
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+template <typename IntersectWithLineT>
+void vtkAbstractCellLocator::BatchIntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol,
+  vtkIdList* cellIds, vtkPoints* points, vtkDoubleArray* t, IntersectWithLineT&& intersectWithLine)
+{
+  vtkIdType numberOfLines = p1 ? p1->GetNumberOfPoints() : 0;
+  if (!p2 || p2->GetNumberOfPoints() != numberOfLines)
+  {
+    if (numberOfLines > 0)
+    {
+      vtkErrorMacro("The two sets of points must have the same number of points.");
+    }
+    numberOfLines = 0;
+  }
+  cellIds->SetNumberOfIds(numberOfLines);
+  if (points)
+  {
+    points->SetNumberOfPoints(numberOfLines);
+  }
+  if (t)
+  {
+    t->SetNumberOfComponents(1);
+    t->SetNumberOfTuples(numberOfLines);
+  }
+
+  vtkSMPThreadLocalObject<vtkGenericCell> localCell;
+  vtkSMPTools::For(0, numberOfLines,
+    [&](vtkIdType first, vtkIdType last)
+    {
+      vtkGenericCell* cell = localCell.Local();
+      double a[3], b[3], x[3], pc[3], tLine;
+      vtkIdType cellId;
+      int subId;
+      for (vtkIdType i = first; i < last; ++i)
+      {
+        p1->GetPoint(i, a);
+        p2->GetPoint(i, b);
+        cellId = -1;
+        if (!intersectWithLine(a, b, tol, tLine, x, pc, subId, cellId, cell))
+        {
+          cellId = -1;
+          tLine = 0.0;
+          std::copy_n(a, 3, x);
+        }
+        cellIds->SetId(i, cellId);
+        if (points)
+        {
+          points->SetPoint(i, x);
+        }
+        if (t)
+        {
+          t->SetValue(i, tLine);
+        }
+      }
+    });
+}
+VTK_ABI_NAMESPACE_END
+
+#endif
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkAbstractPointLocator.h"
+#include "vtkAbstractPointLocator.txx"
 
 #include "vtkDataSet.h"
 #include "vtkIdList.h"
@@ -53,6 +54,24 @@ void vtkAbstractPointLocator::FindPointsWithinRadius(
   this->FindPointsWithinRadius(R, p, result);
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindClosestPoints(vtkPoints* points, vtkIdList* result)
+{
+  this->BuildLocator();
+  this->BatchFindClosestPoints(
+    points, result, [this](const double x[3]) { return this->FindClosestPoint(x); });
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindPointsWithinRadius(
+  double R, vtkPoints* points, vtkCellArray* result)
+{
+  this->BuildLocator();
+  this->BatchFindPointsWithinRadius(R, points, result,
+    [this](double radius, const double x[3], vtkIdList* ids)
+    { this->FindPointsWithinRadius(radius, x, ids); });
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractPointLocator::GetBounds(double* bnds)
 {
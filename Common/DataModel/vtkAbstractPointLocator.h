@@ -21,8 +21,11 @@
 #include "vtkCommonDataModelModule.h" // For export macro
 #include "vtkLocator.h"
 
+
 VTK_ABI_NAMESPACE_BEGIN
+class vtkCellArray;
 class vtkIdList;
+class vtkPoints;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractPointLocator : public vtkLocator
 {
@@ -78,6 +81,23 @@ public:
   void FindPointsWithinRadius(double R, double x, double y, double z, vtkIdList* result);
   ///@}
 
+  /**
+   * Find the closest point to each point of `points`. `result` is resized to the number of
+   * points and filled with the ids of the closest points, or -1.
+   *
+   * The default implementation calls FindClosestPoint() concurrently for all the points.
+   */
+  virtual void FindClosestPoints(vtkPoints* points, vtkIdList* result);
+
+  /**
+   * Find all points within a specified radius R of each point of `points`. `result` is reset
+   * and filled with one cell per point of `points`, listing the ids of the points within the
+   * radius in the order FindPointsWithinRadius() returns them.
+   *
+   * The default implementation calls FindPointsWithinRadius() concurrently for all the points.
+   */
+  virtual void FindPointsWithinRadius(double R, vtkPoints* points, vtkCellArray* result);
+
   ///@{
   /**
    * Provide an accessor to the bounds. Valid after the locator is built.
@@ -98,6 +118,22 @@ protected:
   vtkAbstractPointLocator();
   ~vtkAbstractPointLocator() override;
 
+  ///@{
+  /**
+   * Implement the batched queries FindClosestPoints() and FindPointsWithinRadius() by calling a
+   * thread safe query concurrently. Subclasses use them with their own queries, to skip the
+   * checks done for each point. The queries are callables invoked as `findClosestPoint(x)`,
+   * returning the point id, and `findPointsWithinRadius(R, x, ids)`. They are defined in
+   * vtkAbstractPointLocator.txx.
+   */
+  template <typename FindClosestPointT>
+  void BatchFindClosestPoints(
+    vtkPoints* points, vtkIdList* result, FindClosestPointT&& findClosestPoint);
+  template <typename FindPointsWithinRadiusT>
+  void BatchFindPointsWithinRadius(double R, vtkPoints* points, vtkCellArray* result,
+    FindPointsWithinRadiusT&& findPointsWithinRadius);
+  ///@}
+
   double Bounds[6];          // bounds of points
   vtkIdType NumberOfBuckets; // total size of locator
 
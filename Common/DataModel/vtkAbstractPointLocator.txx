@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkAbstractPointLocator_txx
+#define vtkAbstractPointLocator_txx
+
+#include "vtkAbstractPointLocator.h"
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+//------------------------------------------------------------------------------
+VTK_ABI_NAMESPACE_BEGIN
+template <typename FindClosestPointT>
+void vtkAbstractPointLocator::BatchFindClosestPoints(
+  vtkPoints* points, vtkIdList* result, FindClosestPointT&& findClosestPoint)
+{
+  const vtkIdType numberOfPoints = points ? points->GetNumberOfPoints() : 0;
+  result->SetNumberOfIds(numberOfPoints);
+  vtkSMPTools::For(0, numberOfPoints,
+    [&](vtkIdType first, vtkIdType last)
+    {
+      double x[3];
+      for (vtkIdType i = first; i < last; ++i)
+      {
+        points->GetPoint(i, x);
+        result->SetId(i, findClosestPoint(x));
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+template <typename FindPointsWithinRadiusT>
+void vtkAbstractPointLocator::BatchFindPointsWithinRadius(double R, vtkPoints* points,
+  vtkCellArray* result, FindPointsWithinRadiusT&& findPointsWithinRadius)
+{
+  const vtkIdType numberOfPoints = points ? points->GetNumberOfPoints() : 0;
+
+  // The ids are gathered by blocks of points, then copied to their final location once the
+  // offsets are known, so that the result does not depend on the number of threads.
+  const vtkIdType blockSize = 1024;
+  const vtkIdType numberOfBlocks = (numberOfPoints + blockSize - 1) / blockSize;
+  std::vector<std::vector<vtkIdType>> blockIds(numberOfBlocks);
+  std::vector<vtkIdType> counts(numberOfPoints + 1, 0);
+  vtkSMPThreadLocalObject<vtkIdList> localIds;
+  vtkSMPTools::For(0, numberOfBlocks, 1,
+    [&](vtkIdType firstBlock, vtkIdType lastBlock)
+    {
+      vtkIdList* ids = localIds.Local();
+      double x[3];
+      for (vtkIdType block = firstBlock; block < lastBlock; ++block)
+      {
+        const vtkIdType last = std::min(numberOfPoints, (block + 1) * blockSize);
+        for (vtkIdType i = block * blockSize; i < last; ++i)
+        {
+          points->GetPoint(i, x);
+          ids->Reset();
+          findPointsWithinRadius(R, x, ids);
+          counts[i] = ids->GetNumberOfIds();
+          blockIds[block].insert(blockIds[block].end(), ids->begin(), ids->end());
+        }
+      }
+    });
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numberOfPoints + 1);
+  vtkSMPTools::ExclusiveScan(counts.begin(), counts.end(), offsets->GetPointer(0), vtkIdType(0));
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(offsets->GetValue(numberOfPoints));
+  vtkSMPTools::For(0, numberOfBlocks, 1,
+    [&](vtkIdType firstBlock, vtkIdType lastBlock)
+    {
+      for (vtkIdType block = firstBlock; block < lastBlock; ++block)
+      {
+        std::copy(blockIds[block].begin(), blockIds[block].end(),
+          connectivity->GetPointer(offsets->GetValue(block * blockSize)));
+      }
+    });
+  result->SetData(offsets, connectivity);
+}
+VTK_ABI_NAMESPACE_END
+
+#endif
@@ -3,16 +3,23 @@
 
 #include "vtkCellTreeLocator.h"
 
+#include "vtkAbstractCellLocator.txx"
 #include "vtkBoundingBox.h"
 #include "vtkBox.h"
 #include "vtkCellArray.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
 #include <array>
+#include <queue>
 #include <stack>
 #include <vector>
 
@@ -44,10 +51,12 @@ struct vtkCellTree
   double DataBBox[6]; // This store the bounding values of the dataset
   vtkCellTreeLocator* Locator;
   vtkDataSet* DataSet;
+  int MaxCellSize; // Size of the weights needed to evaluate a position in any cell
 
   vtkCellTree(vtkCellTreeLocator* locator)
     : Locator(locator)
     , DataSet(locator->GetDataSet())
+    , MaxCellSize(this->DataSet ? this->DataSet->GetMaxCellSize() : 0)
   {
   }
 
@@ -61,6 +70,9 @@ struct vtkCellTree
     double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell) = 0;
   virtual int IntersectWithLine(const double p1[3], const double p2[3], double tol,
     vtkPoints* points, vtkIdList* cellIds, vtkGenericCell* cell) = 0;
+  virtual vtkIdType FindClosestPointWithinRadius(const double x[3], double radius,
+    double closestPoint[3], vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2,
+    int& inside, double* weights) = 0;
   virtual void GenerateRepresentation(int level, vtkPolyData* pd) = 0;
 
   // Utility methods
@@ -203,6 +215,9 @@ struct CellTree : public vtkCellTree
     double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell) override;
   int IntersectWithLine(const double p1[3], const double p2[3], double tol, vtkPoints* points,
     vtkIdList* cellIds, vtkGenericCell* cell) override;
+  vtkIdType FindClosestPointWithinRadius(const double x[3], double radius, double closestPoint[3],
+    vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2, int& inside,
+    double* weights) override;
   void GenerateRepresentation(int level, vtkPolyData* pd) override;
 };
 
@@ -307,6 +322,13 @@ private:
       this->Min = std::min(min, this->Min);
       this->Max = std::max(max, this->Max);
     }
+
+    void Merge(const Bucket& other)
+    {
+      this->Cnt += other.Cnt;
+      this->Min = std::min(other.Min, this->Min);
+      this->Max = std::max(other.Max, this->Max);
+    }
   };
 
   struct CellInfo
@@ -340,7 +362,10 @@ private:
     {
     }
 
-    bool operator()(const CellInfo& pc) { return pc.Min[this->D] + pc.Max[this->D] < this->P; }
+    bool operator()(const CellInfo& pc) const
+    {
+      return pc.Min[this->D] + pc.Max[this->D] < this->P;
+    }
   };
 
   struct SplitInfo
@@ -365,6 +390,10 @@ private:
   vtkDataSet* DataSet;
   int NumberOfBuckets;
   int NumberOfNodesPerLeaf;
+  // Nodes holding at least SubtreeSize cells are split one at a time using parallel loops.
+  // The smaller ones are the roots of independent subtrees, built concurrently. SubtreeSize
+  // depends on the number of threads, so both ways of splitting must order the cells alike.
+  T SubtreeSize;
 
   std::vector<CellInfo> CellsInfo;
   std::vector<CellTreeNode<T>> Nodes;
@@ -422,31 +451,47 @@ private:
   }
 
   // -------------------------------------------------------------------------
-  void Split(T index, double min[3], double max[3], BucketsType& buckets)
+  void FindMinMax(
+    const CellInfo* begin, const CellInfo* end, double* min, double* max, bool parallel)
   {
-    const T& start = this->Nodes[index].Start();
-    const T& size = this->Nodes[index].Size();
-
-    if (size < this->NumberOfNodesPerLeaf)
+    if (!parallel || begin == end)
     {
+      this->FindMinMax(begin, end, min, max);
       return;
     }
 
-    CellInfo* begin = &(this->CellsInfo[start]);
-    CellInfo* end = this->CellsInfo.data() + start + size;
-    CellInfo* mid = begin;
-
-    const double ext[3] = { max[0] - min[0], max[1] - min[1], max[2] - min[2] };
-    double iext[3];
+    using MinMaxType = std::array<double, 6>;
+    vtkSMPThreadLocal<MinMaxType> localMinMax(MinMaxType{ VTK_DOUBLE_MAX, VTK_DOUBLE_MAX,
+      VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX });
+    vtkSMPTools::For(0, end - begin,
+      [&](vtkIdType first, vtkIdType last)
+      {
+        MinMaxType& minMax = localMinMax.Local();
+        double chunkMin[3], chunkMax[3];
+        this->FindMinMax(begin + first, begin + last, chunkMin, chunkMax);
+        for (uint8_t d = 0; d < 3; ++d)
+        {
+          minMax[d] = std::min(minMax[d], chunkMin[d]);
+          minMax[d + 3] = std::max(minMax[d + 3], chunkMax[d]);
+        }
+      });
 
-    for (uint8_t comp = 0; comp < 3; ++comp)
+    std::fill(min, min + 3, VTK_DOUBLE_MAX);
+    std::fill(max, max + 3, -VTK_DOUBLE_MAX);
+    for (const MinMaxType& minMax : localMinMax)
     {
-      double const ext_comp = ext[comp];
-      iext[comp] = ext_comp == 0.0 ? this->NumberOfBuckets : this->NumberOfBuckets / ext_comp;
+      for (uint8_t d = 0; d < 3; ++d)
+      {
+        min[d] = std::min(min[d], minMax[d]);
+        max[d] = std::max(max[d], minMax[d + 3]);
+      }
     }
+  }
 
-    buckets.Reset();
-
+  // -------------------------------------------------------------------------
+  void FillBuckets(const CellInfo* begin, const CellInfo* end, const double min[3],
+    const double iext[3], BucketsType& buckets)
+  {
     for (const CellInfo* pc = begin; pc != end; ++pc)
     {
       for (uint8_t d = 0; d < 3; ++d)
@@ -459,6 +504,64 @@ private:
         buckets[d][ind].Add(pc->Min[d], pc->Max[d]);
       }
     }
+  }
+
+  // -------------------------------------------------------------------------
+  void FillBuckets(const CellInfo* begin, const CellInfo* end, const double min[3],
+    const double iext[3], BucketsType& buckets, bool parallel)
+  {
+    buckets.Reset();
+    if (!parallel)
+    {
+      this->FillBuckets(begin, end, min, iext, buckets);
+      return;
+    }
+
+    vtkSMPThreadLocal<BucketsType> localBuckets(BucketsType(this->NumberOfBuckets));
+    vtkSMPTools::For(0, end - begin,
+      [&](vtkIdType first, vtkIdType last)
+      { this->FillBuckets(begin + first, begin + last, min, iext, localBuckets.Local()); });
+
+    for (const BucketsType& local : localBuckets)
+    {
+      for (uint8_t d = 0; d < 3; ++d)
+      {
+        for (int n = 0; n < this->NumberOfBuckets; ++n)
+        {
+          buckets[d][n].Merge(local[d][n]);
+        }
+      }
+    }
+  }
+
+  // -------------------------------------------------------------------------
+  // Split the leaf `index` of `nodes` in two, and push its children onto `splitStack`. When
+  // `parallel` is true, the cells of the leaf are sorted using parallel loops.
+  void Split(std::vector<TCellTreeNode>& nodes, std::stack<SplitInfo>& splitStack, T index,
+    double min[3], double max[3], BucketsType& buckets, bool parallel)
+  {
+    const T start = nodes[index].Start();
+    const T size = nodes[index].Size();
+
+    if (size < this->NumberOfNodesPerLeaf)
+    {
+      return;
+    }
+
+    CellInfo* begin = &(this->CellsInfo[start]);
+    CellInfo* end = this->CellsInfo.data() + start + size;
+    CellInfo* mid = begin;
+
+    const double ext[3] = { max[0] - min[0], max[1] - min[1], max[2] - min[2] };
+    double iext[3];
+
+    for (uint8_t comp = 0; comp < 3; ++comp)
+    {
+      double const ext_comp = ext[comp];
+      iext[comp] = ext_comp == 0.0 ? this->NumberOfBuckets : this->NumberOfBuckets / ext_comp;
+    }
+
+    this->FillBuckets(begin, end, min, iext, buckets, parallel);
 
     double cost = VTK_DOUBLE_MAX;
     double plane = VTK_DOUBLE_MIN; // bad value in case it doesn't get setx
@@ -513,7 +616,9 @@ private:
 
     if (cost != VTK_DOUBLE_MAX)
     {
-      mid = std::partition(begin, end, LeftPredicate(dim, plane));
+      // vtkSMPTools::Partition is stable, so the serial partition must be too.
+      mid = parallel ? vtkSMPTools::Partition(begin, end, LeftPredicate(dim, plane))
+                     : std::stable_partition(begin, end, LeftPredicate(dim, plane));
     }
 
     // fallback
@@ -527,8 +632,8 @@ private:
 
     double lMin[3], lMax[3], rMin[3], rMax[3];
 
-    this->FindMinMax(begin, mid, lMin, lMax);
-    this->FindMinMax(mid, end, rMin, rMax);
+    this->FindMinMax(begin, mid, lMin, lMax, parallel);
+    this->FindMinMax(mid, end, rMin, rMax, parallel);
 
     double clip[2] = { lMax[dim], rMin[dim] };
 
@@ -536,11 +641,30 @@ private:
     child[0].MakeLeaf(begin - this->CellsInfo.data(), mid - begin);
     child[1].MakeLeaf(mid - this->CellsInfo.data(), end - mid);
 
-    this->Nodes[index].MakeNode(static_cast<T>(this->Nodes.size()), dim, clip);
-    this->Nodes.insert(this->Nodes.end(), child, child + 2);
+    nodes[index].MakeNode(static_cast<T>(nodes.size()), dim, clip);
+    nodes.insert(nodes.end(), child, child + 2);
+
+    splitStack.emplace(nodes[index].GetRightChildIndex(), rMin, rMax);
+    splitStack.emplace(nodes[index].GetLeftChildIndex(), lMin, lMax);
+  }
 
-    this->SplitStack.emplace(this->Nodes[index].GetRightChildIndex(), rMin, rMax);
-    this->SplitStack.emplace(this->Nodes[index].GetLeftChildIndex(), lMin, lMax);
+  // -------------------------------------------------------------------------
+  // Build the subtree whose root is the leaf `root.Index` of this->Nodes. The nodes of the
+  // subtree are stored in `nodes`, starting with its root.
+  void BuildSubtree(
+    SplitInfo root, std::vector<TCellTreeNode>& nodes, BucketsType& buckets)
+  {
+    nodes.clear();
+    nodes.push_back(this->Nodes[root.Index]);
+    root.Index = 0;
+    std::stack<SplitInfo> splitStack;
+    splitStack.push(root);
+    while (!splitStack.empty())
+    {
+      auto splitInfo = std::move(splitStack.top());
+      splitStack.pop();
+      this->Split(nodes, splitStack, splitInfo.Index, splitInfo.Min, splitInfo.Max, buckets, false);
+    }
   }
 
 public:
@@ -562,28 +686,30 @@ public:
       -VTK_DOUBLE_MAX,
     };
 
+    // This is done to cause non-thread safe initialization to occur due to
+    // side effects from GetCellBounds().
     double cellBounds[6], *cellBoundsPtr;
     cellBoundsPtr = cellBounds;
-    for (T i = 0; i < numberOfCells; ++i)
-    {
-      this->CellsInfo[i].Ind = i;
-      this->Locator->GetCellBounds(i, cellBoundsPtr);
+    this->Locator->GetCellBounds(0, cellBoundsPtr);
 
-      for (uint8_t d = 0; d < 3; ++d)
+    vtkSMPTools::For(0, static_cast<vtkIdType>(numberOfCells),
+      [&](vtkIdType first, vtkIdType last)
       {
-        this->CellsInfo[i].Min[d] = cellBoundsPtr[2 * d + 0];
-        this->CellsInfo[i].Max[d] = cellBoundsPtr[2 * d + 1];
-
-        if (this->CellsInfo[i].Min[d] < min[d])
+        double bounds[6], *boundsPtr = bounds;
+        for (vtkIdType i = first; i < last; ++i)
         {
-          min[d] = this->CellsInfo[i].Min[d];
-        }
-        if (this->CellsInfo[i].Max[d] > max[d])
-        {
-          max[d] = this->CellsInfo[i].Max[d];
+          CellInfo& cellInfo = this->CellsInfo[i];
+          cellInfo.Ind = static_cast<T>(i);
+          this->Locator->GetCellBounds(i, boundsPtr);
+          for (uint8_t d = 0; d < 3; ++d)
+          {
+            cellInfo.Min[d] = boundsPtr[2 * d + 0];
+            cellInfo.Max[d] = boundsPtr[2 * d + 1];
+          }
         }
-      }
-    }
+      });
+    this->FindMinMax(this->CellsInfo.data(), this->CellsInfo.data() + numberOfCells, min, max,
+      true);
 
     this->Tree.DataBBox[0] = min[0];
     this->Tree.DataBBox[1] = max[0];
@@ -597,6 +723,9 @@ public:
     this->Nodes.push_back(root);
 
     this->SplitStack.emplace(0, min, max);
+
+    const auto numberOfThreads = static_cast<T>(vtkSMPTools::GetEstimatedNumberOfThreads());
+    this->SubtreeSize = std::max<T>(numberOfCells / (8 * numberOfThreads), 1024);
   }
 
   void Initialize()
@@ -607,12 +736,50 @@ public:
 
   void operator()()
   {
+    // Split the large nodes near the root, and gather the roots of the subtrees.
     auto& buckets = this->Buckets;
+    std::vector<SplitInfo> subtreeRoots;
     while (!this->SplitStack.empty())
     {
       auto splitInfo = std::move(this->SplitStack.top());
       this->SplitStack.pop();
-      this->Split(splitInfo.Index, splitInfo.Min, splitInfo.Max, buckets);
+      if (this->Nodes[splitInfo.Index].Size() < this->SubtreeSize)
+      {
+        subtreeRoots.push_back(std::move(splitInfo));
+      }
+      else
+      {
+        this->Split(this->Nodes, this->SplitStack, splitInfo.Index, splitInfo.Min, splitInfo.Max,
+          buckets, true);
+      }
+    }
+
+    // The subtrees hold disjoint ranges of cells, so they are built concurrently.
+    std::vector<std::vector<TCellTreeNode>> subtrees(subtreeRoots.size());
+    vtkSMPThreadLocal<BucketsType> localBuckets(BucketsType(this->NumberOfBuckets));
+    vtkSMPTools::For(0, static_cast<vtkIdType>(subtreeRoots.size()), 1,
+      [&](vtkIdType first, vtkIdType last)
+      {
+        for (vtkIdType i = first; i < last; ++i)
+        {
+          this->BuildSubtree(subtreeRoots[i], subtrees[i], localBuckets.Local());
+        }
+      });
+
+    // Append the nodes of each subtree, offsetting their child indices.
+    for (size_t i = 0; i < subtrees.size(); ++i)
+    {
+      std::vector<TCellTreeNode>& nodes = subtrees[i];
+      const T offset = static_cast<T>(this->Nodes.size()) - 1;
+      for (TCellTreeNode& node : nodes)
+      {
+        if (node.IsNode())
+        {
+          node.SetChildren(node.GetLeftChildIndex() + offset);
+        }
+      }
+      this->Nodes[subtreeRoots[i].Index] = nodes.front();
+      this->Nodes.insert(this->Nodes.end(), nodes.begin() + 1, nodes.end());
     }
   }
 
@@ -636,10 +803,14 @@ public:
 
     const auto numberOfCells = static_cast<size_t>(this->DataSet->GetNumberOfCells());
     this->Tree.Leaves.resize(numberOfCells);
-    for (size_t i = 0; i < numberOfCells; ++i)
-    {
-      this->Tree.Leaves[i] = this->CellsInfo[i].Ind;
-    }
+    vtkSMPTools::For(0, static_cast<vtkIdType>(numberOfCells),
+      [&](vtkIdType first, vtkIdType last)
+      {
+        for (vtkIdType i = first; i < last; ++i)
+        {
+          this->Tree.Leaves[i] = this->CellsInfo[i].Ind;
+        }
+      });
     this->CellsInfo.clear();
   }
 };
@@ -679,6 +850,106 @@ vtkIdType CellTree<T>::FindCell(
   return -1;
 }
 
+//------------------------------------------------------------------------------
+// Squared distance from x to an axis-aligned box, 0 if x is inside the box.
+double Distance2ToBounds(const double x[3], const double bounds[6])
+{
+  double dist2 = 0.0;
+  for (int d = 0; d < 3; ++d)
+  {
+    double delta = 0.0;
+    if (x[d] < bounds[2 * d])
+    {
+      delta = bounds[2 * d] - x[d];
+    }
+    else if (x[d] > bounds[2 * d + 1])
+    {
+      delta = x[d] - bounds[2 * d + 1];
+    }
+    dist2 += delta * delta;
+  }
+  return dist2;
+}
+
+//------------------------------------------------------------------------------
+// Visit the nodes in increasing order of distance to their box, until the boxes are further
+// away than the closest point found so far.
+template <typename T>
+vtkIdType CellTree<T>::FindClosestPointWithinRadius(const double x[3], double radius,
+  double closestPoint[3], vtkGenericCell* cell, vtkIdType& closestCellId, int& closestSubId,
+  double& minDist2, int& inside, double* weights)
+{
+  struct NodeBounds
+  {
+    double Dist2;
+    T Index;
+    double Bounds[6];
+
+    bool operator>(const NodeBounds& other) const { return this->Dist2 > other.Dist2; }
+  };
+  std::priority_queue<NodeBounds, std::vector<NodeBounds>, std::greater<>> queue;
+
+  double pcoords[3], point[3], dist2, cellBounds[6], *cellBoundsPtr;
+  cellBoundsPtr = cellBounds;
+  int subId, stat;
+  vtkIdType retVal = 0;
+
+  minDist2 = radius * radius;
+  NodeBounds root;
+  root.Index = 0;
+  std::copy_n(this->DataBBox, 6, root.Bounds);
+  root.Dist2 = Distance2ToBounds(x, root.Bounds);
+  queue.push(root);
+
+  while (!queue.empty() && queue.top().Dist2 <= minDist2)
+  {
+    const NodeBounds nodeBounds = queue.top();
+    queue.pop();
+    const TCellTreeNode& node = this->Nodes[nodeBounds.Index];
+
+    if (node.IsNode())
+    {
+      // The left child ends at LeftMax along the split dimension, the right one starts at
+      // RightMin.
+      const T d = node.GetDimension();
+      NodeBounds left = nodeBounds;
+      left.Index = node.GetLeftChildIndex();
+      left.Bounds[2 * d + 1] = node.GetLeftMaxValue();
+      left.Dist2 = Distance2ToBounds(x, left.Bounds);
+      NodeBounds right = nodeBounds;
+      right.Index = node.GetRightChildIndex();
+      right.Bounds[2 * d] = node.GetRightMinValue();
+      right.Dist2 = Distance2ToBounds(x, right.Bounds);
+      queue.push(left);
+      queue.push(right);
+      continue;
+    }
+
+    const T* begin = &(this->Leaves[node.Start()]);
+    const T* end = begin + node.Size();
+    for (; begin != end; ++begin)
+    {
+      this->Locator->GetCellBounds(*begin, cellBoundsPtr);
+      if (Distance2ToBounds(x, cellBoundsPtr) < minDist2)
+      {
+        this->DataSet->GetCell(*begin, cell);
+        // stat == -1 is a numerical error, 0 means outside and 1 inside.
+        stat = cell->EvaluatePosition(x, point, subId, pcoords, dist2, weights);
+        if (stat != -1 && dist2 < minDist2)
+        {
+          retVal = 1;
+          inside = stat;
+          minDist2 = dist2;
+          closestCellId = *begin;
+          closestSubId = subId;
+          std::copy_n(point, 3, closestPoint);
+        }
+      }
+    }
+  }
+  return retVal;
+}
+
 //------------------------------------------------------------------------------
 template <typename T>
 int CellTree<T>::IntersectWithLine(const double p1[3], const double p2[3], double tol, double& t,
@@ -1308,7 +1579,7 @@ void vtkCellTreeLocator::BuildLocatorInternal()
 {
   using namespace detail;
   vtkIdType numCells;
-  if (!this->DataSet || (numCells = this->DataSet->GetNumberOfCells() < 1))
+  if (!this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1)
   {
     vtkErrorMacro(<< " No Cells in the data set\n");
     return;
@@ -1354,6 +1625,49 @@ vtkIdType vtkCellTreeLocator::FindCell(
   return this->Tree->FindCell(pos, cell, subId, pcoords, weights);
 }
 
+//------------------------------------------------------------------------------
+vtkIdType vtkCellTreeLocator::FindClosestPointWithinRadius(double x[3], double radius,
+  double closestPoint[3], vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2,
+  int& inside)
+{
+  this->BuildLocator();
+  if (!this->Tree)
+  {
+    return 0;
+  }
+  std::vector<double> weights(this->Tree->MaxCellSize);
+  return this->Tree->FindClosestPointWithinRadius(
+    x, radius, closestPoint, cell, cellId, subId, dist2, inside, weights.data());
+}
+
+//------------------------------------------------------------------------------
+void vtkCellTreeLocator::FindCells(
+  vtkPoints* points, vtkIdList* cellIds, vtkDoubleArray* pcoords, double)
+{
+  this->BuildLocator();
+  detail::vtkCellTree* tree = this->Tree;
+  this->BatchFindCells(points, cellIds, pcoords,
+    [tree](double x[3], vtkGenericCell* cell, int& subId, double pc[3], double* weights)
+    { return tree ? tree->FindCell(x, cell, subId, pc, weights) : -1; });
+}
+
+//------------------------------------------------------------------------------
+void vtkCellTreeLocator::FindClosestPoints(
+  vtkPoints* points, vtkPoints* closestPoints, vtkIdList* cellIds, vtkDoubleArray* dist2)
+{
+  this->BuildLocator();
+  detail::vtkCellTree* tree = this->Tree;
+  this->BatchFindClosestPoints(points, closestPoints, cellIds, dist2,
+    [tree](double x[3], double closestPoint[3], vtkGenericCell* cell, vtkIdType& cellId,
+      int& subId, double& d2, double* weights) -> vtkIdType
+    {
+      int inside;
+      return tree ? tree->FindClosestPointWithinRadius(
+                      x, vtkMath::Inf(), closestPoint, cell, cellId, subId, d2, inside, weights)
+                  : 0;
+    });
+}
+
 //------------------------------------------------------------------------------
 void vtkCellTreeLocator::FindCellsWithinBounds(double* bbox, vtkIdList* cells)
 {
@@ -18,6 +18,11 @@
  * - CacheCellBounds             (default true)
  * - UseExistingSearchStructure  (default false)
  *
+ * The tree is built top-down in parallel: the nodes near the root are split using parallel
+ * loops, then the subtrees below them are built concurrently. The tree does not depend on the
+ * number of threads. FindCells() and FindClosestPoints() query a whole set of points in
+ * parallel.
+ *
  * vtkCellTreeLocator does NOT utilize the following parameters:
  * - Automatic
  * - Level
@@ -98,6 +103,7 @@ public:
 
   // Reuse any superclass signatures that we don't override.
   using vtkAbstractCellLocator::FindCell;
+  using vtkAbstractCellLocator::FindClosestPointWithinRadius;
   using vtkAbstractCellLocator::IntersectWithLine;
 
   /**
@@ -147,6 +153,32 @@ public:
   vtkIdType FindCell(double pos[3], double vtkNotUsed(tol2), vtkGenericCell* cell, int& subId,
     double pcoords[3], double* weights) override;
 
+  /**
+   * Return the closest point within a specified radius and the cell which is
+   * closest to the point x. The closest point is somewhere on a cell, it
+   * need not be one of the vertices of the cell. This method returns 1 if a
+   * point is found within the specified radius. If there are no cells within
+   * the specified radius, the method returns 0 and the values of
+   * closestPoint, cellId, subId, and dist2 are undefined. If a closest point
+   * is found, inside returns the return value of the EvaluatePosition call to
+   * the closest cell; inside(=1) or outside(=0).
+   *
+   * For other FindClosestPoint and FindClosestPointWithinRadius signatures, see
+   * vtkAbstractCellLocator.
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius, double closestPoint[3],
+    vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2, int& inside) override;
+
+  ///@{
+  /**
+   * Reimplemented to query the tree in parallel, with a single check that the tree is built.
+   */
+  void FindCells(vtkPoints* points, vtkIdList* cellIds, vtkDoubleArray* pcoords = nullptr,
+    double vtkNotUsed(tol2) = 0.0) override;
+  void FindClosestPoints(vtkPoints* points, vtkPoints* closestPoints, vtkIdList* cellIds,
+    vtkDoubleArray* dist2 = nullptr) override;
+  ///@}
+
   ///@{
   /**
    * Satisfy vtkLocator abstract interface.
@@ -34,31 +34,35 @@ void vtkHyperTree::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "BranchFactor: " << static_cast<int>(this->BranchFactor) << "\n";
   os << indent << "NumberOfChildren: " << static_cast<vtkIdType>(this->NumberOfChildren) << "\n";
 
-  os << indent << "NumberOfLevels: " << this->Datas->NumberOfLevels << "\n";
-  os << indent << "NumberOfVertices (coarse and leaves): " << this->Datas->NumberOfVertices << "\n";
-  os << indent << "NumberOfNodes (coarse): " << this->Datas->NumberOfNodes << "\n";
+  os << indent << "NumberOfLevels: " << this->GetNumberOfLevels() << "\n";
+  os << indent << "NumberOfVertices (coarse and leaves): " << this->GetNumberOfVertices() << "\n";
+  os << indent << "NumberOfNodes (coarse): " << this->GetNumberOfNodes() << "\n";
+  os << indent << "CompactStorage: " << (this->CompactEntry ? "On" : "Off") << "\n";
 
   if (this->IsGlobalIndexImplicit())
   {
     os << indent << "Implicit global index mapping\n";
-    os << indent << "GlobalIndexStart: " << this->Datas->GlobalIndexStart << "\n";
+    os << indent << "GlobalIndexStart: " << this->GetGlobalIndexStart() << "\n";
   }
   else
   {
     os << indent << "Explicit global index mapping\n";
   }
 
-  os << indent << "ParentToElderChild: " << this->Datas->ParentToElderChild.size() << endl;
-  for (unsigned int i = 0; i < this->Datas->ParentToElderChild.size(); ++i)
+  size_t size;
+  const unsigned int* parentToElderChild = this->GetParentToElderChild(size);
+  os << indent << "ParentToElderChild: " << size << endl;
+  for (size_t i = 0; i < size; ++i)
   {
-    os << this->Datas->ParentToElderChild[i] << " ";
+    os << parentToElderChild[i] << " ";
   }
   os << endl;
 
+  const vtkIdType* globalIndexTable = this->GetGlobalIndexTable(size);
   os << indent << "GlobalIndexTable: ";
-  for (unsigned int i = 0; i < this->Datas->GlobalIndexTable.size(); ++i)
+  for (size_t i = 0; i < size; ++i)
   {
-    os << " " << this->Datas->GlobalIndexTable[i];
+    os << " " << globalIndexTable[i];
   }
   os << endl;
 }
@@ -73,20 +77,10 @@ void vtkHyperTree::Initialize(
 //------------------------------------------------------------------------------
 bool vtkHyperTree::Initialize(const unsigned char branchFactor, const unsigned char dimension)
 {
-  if (branchFactor < 2 || 3 < branchFactor)
+  if (!this->InitializeShape(branchFactor, dimension))
   {
-    vtkGenericWarningMacro("Bad branching factor " << branchFactor);
     return false;
   }
-  if (dimension < 1 || 3 < dimension)
-  {
-    vtkGenericWarningMacro("Bad dimension " << static_cast<int>(dimension));
-    return false;
-  }
-
-  this->BranchFactor = branchFactor;
-  this->Dimension = dimension;
-  this->NumberOfChildren = pow(branchFactor, dimension);
 
   this->Datas = std::make_shared<vtkHyperTreeData>();
   this->Datas->TreeIndex = -1;
@@ -101,6 +95,43 @@ bool vtkHyperTree::Initialize(const unsigned char branchFactor, const unsigned c
   this->Datas->ParentToElderChild[0] = std::numeric_limits<unsigned int>::max();
   // By default, the root doesn't have a parent
   this->Datas->GlobalIndexTable.clear();
+  this->CompactStorage = nullptr;
+  this->CompactEntry = nullptr;
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHyperTree::Initialize(unsigned char branchFactor, unsigned char dimension,
+  std::shared_ptr<const vtkHyperTreeCompactStorage> storage, vtkIdType entry)
+{
+  if (!this->InitializeShape(branchFactor, dimension))
+  {
+    return false;
+  }
+
+  this->SetCompactStorage(std::move(storage), entry);
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHyperTree::InitializeShape(const unsigned char branchFactor, const unsigned char dimension)
+{
+  if (branchFactor < 2 || 3 < branchFactor)
+  {
+    vtkGenericWarningMacro("Bad branching factor " << branchFactor);
+    return false;
+  }
+  if (dimension < 1 || 3 < dimension)
+  {
+    vtkGenericWarningMacro("Bad dimension " << static_cast<int>(dimension));
+    return false;
+  }
+
+  this->BranchFactor = branchFactor;
+  this->Dimension = dimension;
+  this->NumberOfChildren = pow(branchFactor, dimension);
 
   this->Scales = nullptr;
 
@@ -112,8 +143,19 @@ void vtkHyperTree::CopyStructure(vtkHyperTree* ht)
 {
   assert("pre: ht_exists" && ht != nullptr);
 
-  // Copy ht data
-  this->Datas = std::make_shared<vtkHyperTreeData>(*ht->Datas);
+  // Copy ht data, sharing the compact storage that is never modified
+  if (ht->CompactEntry)
+  {
+    this->Datas = nullptr;
+    this->CompactStorage = ht->CompactStorage;
+    this->CompactEntry = ht->CompactEntry;
+  }
+  else
+  {
+    this->Datas = std::make_shared<vtkHyperTreeData>(*ht->Datas);
+    this->CompactStorage = nullptr;
+    this->CompactEntry = nullptr;
+  }
   this->SetScales(std::make_shared<vtkHyperTreeGridScales>(
     ht->Scales->GetBranchFactor(), ht->Scales->ComputeScale(0)));
   this->BranchFactor = ht->BranchFactor;
@@ -121,6 +163,100 @@ void vtkHyperTree::CopyStructure(vtkHyperTree* ht)
   this->NumberOfChildren = ht->NumberOfChildren;
 }
 
+//------------------------------------------------------------------------------
+void vtkHyperTree::SetCompactStorage(
+  std::shared_ptr<const vtkHyperTreeCompactStorage> storage, vtkIdType entry)
+{
+  assert("pre: storage_exists" && storage != nullptr);
+  assert("pre: valid_entry" && entry >= 0 &&
+    entry < static_cast<vtkIdType>(storage->Trees.size()));
+  this->CompactStorage = std::move(storage);
+  this->CompactEntry = &this->CompactStorage->Trees[entry];
+  this->Datas = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkHyperTree::FillCompactEntry(vtkHyperTreeCompactEntry& entry) const
+{
+  size_t parentToElderChildSize, globalIndexTableSize;
+  this->GetParentToElderChild(parentToElderChildSize);
+  this->GetGlobalIndexTable(globalIndexTableSize);
+  entry.TreeIndex = this->GetTreeIndex();
+  entry.NumberOfVertices = this->GetNumberOfVertices();
+  entry.NumberOfNodes = this->GetNumberOfNodes();
+  entry.GlobalIndexStart = this->GetGlobalIndexStart();
+  entry.GlobalIndexTableSize = static_cast<vtkIdType>(globalIndexTableSize);
+  entry.ParentToElderChildSize = static_cast<unsigned int>(parentToElderChildSize);
+  entry.NumberOfLevels = this->GetNumberOfLevels();
+}
+
+//------------------------------------------------------------------------------
+void vtkHyperTree::CopyToCompactStorage(
+  vtkHyperTreeCompactStorage* storage, const vtkHyperTreeCompactEntry& entry) const
+{
+  size_t size;
+  const unsigned int* parentToElderChild = this->GetParentToElderChild(size);
+  assert("pre: same_size" && size == entry.ParentToElderChildSize);
+  std::copy(parentToElderChild, parentToElderChild + size,
+    storage->ParentToElderChild.begin() + entry.ParentToElderChildOffset);
+  const vtkIdType* globalIndexTable = this->GetGlobalIndexTable(size);
+  assert("pre: same_size" && static_cast<vtkIdType>(size) == entry.GlobalIndexTableSize);
+  std::copy(globalIndexTable, globalIndexTable + size,
+    storage->GlobalIndexTable.begin() + entry.GlobalIndexTableOffset);
+}
+
+//------------------------------------------------------------------------------
+const unsigned int* vtkHyperTree::GetParentToElderChild(size_t& size) const
+{
+  if (this->CompactEntry)
+  {
+    size = this->CompactEntry->ParentToElderChildSize;
+    return this->CompactStorage->ParentToElderChild.data() +
+      this->CompactEntry->ParentToElderChildOffset;
+  }
+  size = this->Datas->ParentToElderChild.size();
+  return this->Datas->ParentToElderChild.data();
+}
+
+//------------------------------------------------------------------------------
+const vtkIdType* vtkHyperTree::GetGlobalIndexTable(size_t& size) const
+{
+  if (this->CompactEntry)
+  {
+    size = static_cast<size_t>(this->CompactEntry->GlobalIndexTableSize);
+    return this->CompactStorage->GlobalIndexTable.data() +
+      this->CompactEntry->GlobalIndexTableOffset;
+  }
+  size = this->Datas->GlobalIndexTable.size();
+  return this->Datas->GlobalIndexTable.data();
+}
+
+//------------------------------------------------------------------------------
+void vtkHyperTree::DetachFromCompactStorage()
+{
+  if (!this->CompactEntry)
+  {
+    return;
+  }
+  const vtkHyperTreeCompactEntry& entry = *this->CompactEntry;
+  auto datas = std::make_shared<vtkHyperTreeData>();
+  datas->TreeIndex = entry.TreeIndex;
+  datas->NumberOfLevels = entry.NumberOfLevels;
+  datas->NumberOfVertices = entry.NumberOfVertices;
+  datas->NumberOfNodes = entry.NumberOfNodes;
+  datas->GlobalIndexStart = entry.GlobalIndexStart;
+  auto parentToElderChild =
+    this->CompactStorage->ParentToElderChild.begin() + entry.ParentToElderChildOffset;
+  datas->ParentToElderChild.assign(
+    parentToElderChild, parentToElderChild + entry.ParentToElderChildSize);
+  auto globalIndexTable =
+    this->CompactStorage->GlobalIndexTable.begin() + entry.GlobalIndexTableOffset;
+  datas->GlobalIndexTable.assign(globalIndexTable, globalIndexTable + entry.GlobalIndexTableSize);
+  this->Datas = datas;
+  this->CompactStorage = nullptr;
+  this->CompactEntry = nullptr;
+}
+
 //------------------------------------------------------------------------------
 std::shared_ptr<vtkHyperTreeGridScales> vtkHyperTree::InitializeScales(
   const double* scales, bool reinitialize)
@@ -195,6 +331,7 @@ void vtkHyperTree::ComputeBreadthFirstOrderDescriptor(const unsigned int depthLi
 void vtkHyperTree::BuildFromBreadthFirstOrderDescriptor(
   vtkBitArray* descriptor, vtkIdType numberOfBits, vtkIdType startIndex)
 {
+  this->DetachFromCompactStorage();
   this->Datas->ParentToElderChild.clear();
   int numberOfDepths = 1;
   vtkIdType numberOfCoarseVertices = 0;
@@ -240,6 +377,7 @@ void vtkHyperTree::InitializeForReader(vtkIdType numberOfLevels, vtkIdType nbVer
   vtkIdType nbVerticesOfLastdepth, vtkBitArray* isParent, vtkBitArray* isMasked,
   vtkBitArray* outIsMasked)
 {
+  this->DetachFromCompactStorage();
   if (isParent == nullptr)
   {
     this->Datas->ParentToElderChild.resize(1);
@@ -316,18 +454,24 @@ void vtkHyperTree::InitializeForReader(vtkIdType numberOfLevels, vtkIdType nbVer
 //---------------------------------------------------------------------------
 bool vtkHyperTree::IsGlobalIndexImplicit()
 {
-  return this->Datas->GlobalIndexStart == -1;
+  return this->GetGlobalIndexStart() == -1;
 }
 
 //---------------------------------------------------------------------------
 void vtkHyperTree::SetGlobalIndexStart(vtkIdType start)
 {
+  if (this->CompactEntry && this->CompactEntry->GlobalIndexStart == start)
+  {
+    return;
+  }
+  this->DetachFromCompactStorage();
   this->Datas->GlobalIndexStart = start;
 }
 
 //---------------------------------------------------------------------------
 void vtkHyperTree::SetGlobalIndexFromLocal(vtkIdType index, vtkIdType global)
 {
+  this->DetachFromCompactStorage();
   assert("pre: not_globalindex_from_local_if_use_globalindex_start" &&
     this->Datas->GlobalIndexStart < 0);
 
@@ -346,36 +490,36 @@ void vtkHyperTree::SetGlobalIndexFromLocal(vtkIdType index, vtkIdType global)
 //---------------------------------------------------------------------------
 vtkIdType vtkHyperTree::GetGlobalIndexFromLocal(vtkIdType index) const
 {
-  if (!this->Datas->GlobalIndexTable.empty())
+  size_t size;
+  const vtkIdType* globalIndexTable = this->GetGlobalIndexTable(size);
+  if (size)
   {
     // Case explicit global node index
-    assert("pre: not_validindex" && index >= 0 &&
-      index < (vtkIdType)this->Datas->GlobalIndexTable.size());
-    assert("pre: not_positive_globalindex" && this->Datas->GlobalIndexTable[index] >= 0);
-    return this->Datas->GlobalIndexTable[index];
+    assert("pre: not_validindex" && index >= 0 && index < static_cast<vtkIdType>(size));
+    assert("pre: not_positive_globalindex" && globalIndexTable[index] >= 0);
+    return globalIndexTable[index];
   }
   // Case implicit global node index
-  assert("pre: not_positive_startindex" && this->Datas->GlobalIndexStart >= 0);
+  assert("pre: not_positive_startindex" && this->GetGlobalIndexStart() >= 0);
   assert("pre: not_validindex" && index >= 0);
-  return this->Datas->GlobalIndexStart + index;
+  return this->GetGlobalIndexStart() + index;
 }
 
 //---------------------------------------------------------------------------
 vtkIdType vtkHyperTree::GetGlobalNodeIndexMax() const
 {
-  if (static_cast<vtkIdType>(!this->Datas->GlobalIndexTable.empty()))
+  size_t size;
+  const vtkIdType* globalIndexTable = this->GetGlobalIndexTable(size);
+  if (size)
   {
     // Case explicit global node index
-    const std::vector<vtkIdType>::iterator it_end = this->Datas->GlobalIndexTable.end();
-    const std::vector<vtkIdType>::iterator elt_found =
-      std::max_element(this->Datas->GlobalIndexTable.begin(), it_end);
-    assert("pre: not_positive_globalindex" &&
-      (*std::max_element(this->Datas->GlobalIndexTable.begin(), it_end)) >= 0);
+    const vtkIdType* elt_found = std::max_element(globalIndexTable, globalIndexTable + size);
+    assert("pre: not_positive_globalindex" && *elt_found >= 0);
     return *elt_found;
   }
   // Case implicit global node index
-  assert("pre: not_positive_startindex" && this->Datas->GlobalIndexStart >= 0);
-  return this->Datas->GlobalIndexStart + this->Datas->NumberOfVertices - 1;
+  assert("pre: not_positive_startindex" && this->GetGlobalIndexStart() >= 0);
+  return this->GetGlobalIndexStart() + this->GetNumberOfVertices() - 1;
 }
 
 //---------------------------------------------------------------------------
@@ -385,8 +529,9 @@ vtkIdType vtkHyperTree::GetGlobalNodeIndexMax() const
 vtkIdType vtkHyperTree::GetElderChildIndex(unsigned int index_parent) const
 {
   assert(
-    "pre: valid_range" && index_parent < static_cast<unsigned int>(this->Datas->NumberOfVertices));
-  return this->Datas->ParentToElderChild[index_parent];
+    "pre: valid_range" && index_parent < static_cast<unsigned int>(this->GetNumberOfVertices()));
+  size_t size;
+  return this->GetParentToElderChild(size)[index_parent];
 }
 
 //---------------------------------------------------------------------------
@@ -395,13 +540,13 @@ vtkIdType vtkHyperTree::GetElderChildIndex(unsigned int index_parent) const
 // not modification.
 const unsigned int* vtkHyperTree::GetElderChildIndexArray(size_t& nbElements) const
 {
-  nbElements = this->Datas->ParentToElderChild.size();
-  return this->Datas->ParentToElderChild.data();
+  return this->GetParentToElderChild(nbElements);
 }
 
 //---------------------------------------------------------------------------
 void vtkHyperTree::SubdivideLeaf(vtkIdType index, unsigned int depth)
 {
+  this->DetachFromCompactStorage();
   assert("pre: not_validindex" && index < static_cast<vtkIdType>(this->Datas->NumberOfVertices));
   assert("pre: not_leaf" && this->IsLeaf(index));
   // The leaf becomes a node and is not anymore a leaf
@@ -427,32 +572,39 @@ void vtkHyperTree::SubdivideLeaf(vtkIdType index, unsigned int depth)
 //---------------------------------------------------------------------------
 unsigned long vtkHyperTree::GetActualMemorySizeBytes()
 {
-  // in bytes
+  // in bytes, counting the part of the compact storage used by the tree
+  size_t parentToElderChildSize, globalIndexTableSize;
+  this->GetParentToElderChild(parentToElderChildSize);
+  this->GetGlobalIndexTable(globalIndexTableSize);
   // NOLINTNEXTLINE(readability-redundant-casting): needed on Windows
-  return static_cast<unsigned long>(sizeof(unsigned int) * this->Datas->ParentToElderChild.size() +
-    sizeof(vtkIdType) * this->Datas->GlobalIndexTable.size() + 3 * sizeof(unsigned char) +
+  return static_cast<unsigned long>(sizeof(unsigned int) * parentToElderChildSize +
+    sizeof(vtkIdType) * globalIndexTableSize + 3 * sizeof(unsigned char) +
     6 * sizeof(vtkIdType));
 }
 
 //---------------------------------------------------------------------------
 bool vtkHyperTree::IsChildLeaf(vtkIdType index_parent, unsigned int ichild) const
 {
-  assert("pre: valid_range" && index_parent >= 0 && index_parent < this->Datas->NumberOfVertices);
-  if (static_cast<unsigned long>(index_parent) >= this->Datas->ParentToElderChild.size())
+  assert("pre: valid_range" && index_parent >= 0 && index_parent < this->GetNumberOfVertices());
+  size_t size;
+  const unsigned int* parentToElderChild = this->GetParentToElderChild(size);
+  if (static_cast<size_t>(index_parent) >= size)
   {
     return false;
   }
   assert("pre: valid_range" && ichild < this->NumberOfChildren);
-  vtkIdType index_child = this->Datas->ParentToElderChild[index_parent] + ichild;
-  return static_cast<unsigned long>(index_child) >= this->Datas->ParentToElderChild.size() ||
-    this->Datas->ParentToElderChild[index_child] == std::numeric_limits<unsigned int>::max();
+  vtkIdType index_child = parentToElderChild[index_parent] + ichild;
+  return static_cast<size_t>(index_child) >= size ||
+    parentToElderChild[index_child] == std::numeric_limits<unsigned int>::max();
 }
 
 //---------------------------------------------------------------------------
 bool vtkHyperTree::IsTerminalNode(vtkIdType index) const
 {
-  assert("pre: valid_range" && index >= 0 && index < this->Datas->NumberOfVertices);
-  if (static_cast<unsigned long>(index) >= this->Datas->ParentToElderChild.size())
+  assert("pre: valid_range" && index >= 0 && index < this->GetNumberOfVertices());
+  size_t size;
+  this->GetParentToElderChild(size);
+  if (static_cast<size_t>(index) >= size)
   {
     return false;
   }
@@ -470,10 +622,12 @@ bool vtkHyperTree::IsTerminalNode(vtkIdType index) const
 //---------------------------------------------------------------------------
 bool vtkHyperTree::IsLeaf(vtkIdType index) const
 {
-  assert("pre: valid_range" && index >= 0 && index < this->Datas->NumberOfVertices);
-  return static_cast<unsigned long>(index) >= this->Datas->ParentToElderChild.size() ||
-    this->Datas->ParentToElderChild[index] == std::numeric_limits<unsigned int>::max() ||
-    this->Datas->NumberOfVertices == 1;
+  assert("pre: valid_range" && index >= 0 && index < this->GetNumberOfVertices());
+  size_t size;
+  const unsigned int* parentToElderChild = this->GetParentToElderChild(size);
+  return static_cast<size_t>(index) >= size ||
+    parentToElderChild[index] == std::numeric_limits<unsigned int>::max() ||
+    this->GetNumberOfVertices() == 1;
 }
 
 //---------------------------------------------------------------------------
@@ -50,6 +50,8 @@
  *
  * By construction, an hypertree is efficient in memory usage. The LoD
  * feature allows for quick culling of part of the dataobject.
+ * The trees of a compact hypertree grid are views on the storage shared by
+ * all the trees of the grid, see vtkHyperTreeGrid::CompactTrees().
  *
  * @par Case octree with f=2, d=3:
  * For each node (coarse cell), 8 children are encoded in a child index
@@ -118,8 +120,9 @@
 #ifndef vtkHyperTree_h
 #define vtkHyperTree_h
 
-#include "vtkCommonDataModelModule.h" // For export macro
-#include "vtkDeprecation.h"           // Include the macros.
+#include "vtkCommonDataModelModule.h"  // For export macro
+#include "vtkDeprecation.h"            // Include the macros.
+#include "vtkHyperTreeCompactStorage.h" // For vtkHyperTreeCompactEntry
 #include "vtkObject.h"
 
 #include <cassert> // Used internally
@@ -193,6 +196,16 @@ public:
    */
   bool Initialize(unsigned char branchFactor, unsigned char dimension);
 
+  /**
+   * Initialize the tree as a view on the given entry of the compact storage
+   * of its hypertree grid, see SetCompactStorage(). The tree does not
+   * allocate data of its own until it is modified.
+   *
+   * @returns True if the tree was initialized, false otherwise.
+   */
+  bool Initialize(unsigned char branchFactor, unsigned char dimension,
+    std::shared_ptr<const vtkHyperTreeCompactStorage> storage, vtkIdType entry);
+
   /**
    * Restore a state from read data, without using a cursor
    * Call after create hypertree with initialize.
@@ -289,6 +302,31 @@ public:
    */
   void CopyStructure(vtkHyperTree* ht);
 
+  ///@{
+  /**
+   * Make this tree a view on the given entry of the compact storage of its
+   * hypertree grid, see vtkHyperTreeGrid::CompactTrees(). The storage is
+   * never modified: the tree gets its own copy of its data the first time
+   * it is modified.
+   * Services for internal use between hypertree grid and hypertree.
+   */
+  void SetCompactStorage(
+    std::shared_ptr<const vtkHyperTreeCompactStorage> storage, vtkIdType entry);
+  const vtkHyperTreeCompactEntry* GetCompactStorageEntry() const { return this->CompactEntry; }
+  ///@}
+
+  ///@{
+  /**
+   * Fill the counts and the sizes of an entry of a compact storage with the
+   * ones of this tree, then copy the data of the tree in the storage at the
+   * offsets of the entry.
+   * Services for internal use between hypertree grid and hypertree.
+   */
+  void FillCompactEntry(vtkHyperTreeCompactEntry& entry) const;
+  void CopyToCompactStorage(
+    vtkHyperTreeCompactStorage* storage, const vtkHyperTreeCompactEntry& entry) const;
+  ///@}
+
   VTK_DEPRECATED_IN_9_6_0("No effect, do not use.")
   virtual vtkHyperTree* Freeze(const char* vtkNotUsed(mode)) { return this; };
 
@@ -299,11 +337,23 @@ public:
    */
   void SetTreeIndex(vtkIdType treeIndex)
   {
+    if (this->CompactEntry)
+    {
+      if (this->CompactEntry->TreeIndex == treeIndex)
+      {
+        return;
+      }
+      this->DetachFromCompactStorage();
+    }
     assert("pre: datas_non_nullptr" && this->Datas != nullptr);
     this->Datas->TreeIndex = treeIndex;
   }
   vtkIdType GetTreeIndex() const
   {
+    if (this->CompactEntry)
+    {
+      return this->CompactEntry->TreeIndex;
+    }
     assert("pre: datas_non_nullptr" && this->Datas != nullptr);
     return this->Datas->TreeIndex;
   }
@@ -314,6 +364,10 @@ public:
    */
   unsigned int GetNumberOfLevels() const
   {
+    if (this->CompactEntry)
+    {
+      return this->CompactEntry->NumberOfLevels;
+    }
     assert("pre: datas_non_nullptr" && this->Datas != nullptr);
     assert("post: result_greater_or_equal_to_one" && this->Datas->NumberOfLevels >= 1);
     return this->Datas->NumberOfLevels;
@@ -324,6 +378,10 @@ public:
    */
   vtkIdType GetNumberOfVertices() const
   {
+    if (this->CompactEntry)
+    {
+      return this->CompactEntry->NumberOfVertices;
+    }
     assert("pre: datas_non_nullptr" && this->Datas != nullptr);
     return this->Datas->NumberOfVertices;
   }
@@ -333,6 +391,10 @@ public:
    */
   vtkIdType GetNumberOfNodes() const
   {
+    if (this->CompactEntry)
+    {
+      return this->CompactEntry->NumberOfNodes;
+    }
     assert("pre: datas_non_nullptr" && this->Datas != nullptr);
     return this->Datas->NumberOfNodes;
   }
@@ -342,6 +404,10 @@ public:
    */
   vtkIdType GetNumberOfLeaves() const
   {
+    if (this->CompactEntry)
+    {
+      return this->CompactEntry->NumberOfVertices - this->CompactEntry->NumberOfNodes;
+    }
     assert("pre: datas_non_nullptr" && this->Datas != nullptr);
     return this->Datas->NumberOfVertices - this->Datas->NumberOfNodes;
   }
@@ -445,6 +511,10 @@ public:
    */
   vtkIdType GetGlobalIndexStart() const
   {
+    if (this->CompactEntry)
+    {
+      return this->CompactEntry->GlobalIndexStart;
+    }
     assert("pre: datas_non_nullptr" && this->Datas != nullptr);
     return this->Datas->GlobalIndexStart;
   }
@@ -550,6 +620,26 @@ private:
 
   bool IsChildLeaf(vtkIdType index_parent, unsigned int ichild) const;
 
+  /**
+   * Set the branch factor and the dimension of the tree, and reset its
+   * scales. Return false if they are invalid.
+   */
+  bool InitializeShape(unsigned char branchFactor, unsigned char dimension);
+
+  ///@{
+  /**
+   * Return the elder child and the explicit global index arrays of the tree,
+   * in Datas or in the compact storage.
+   */
+  const unsigned int* GetParentToElderChild(size_t& size) const;
+  const vtkIdType* GetGlobalIndexTable(size_t& size) const;
+  ///@}
+
+  /**
+   * Copy the data of the tree out of the compact storage before modifying it.
+   */
+  void DetachFromCompactStorage();
+
   /**
    * Recursive implementation used by ComputeBreadthFirstOrderDescriptor to
    * compute per depth tree descriptor (`descriptorPerDepth`), its id mapping
@@ -576,6 +666,11 @@ private:
   //-- Local information
   std::shared_ptr<vtkHyperTreeData> Datas;
 
+  // Compact storage of the hypertree grid when the tree is a view on it,
+  // in which case Datas is not allocated.
+  std::shared_ptr<const vtkHyperTreeCompactStorage> CompactStorage;
+  const vtkHyperTreeCompactEntry* CompactEntry = nullptr;
+
   // Storage of pre-computed per-level cell scales
   // In hypertree grid, one description by hypertree.
   // In Uniform hypertree grid, one description by hypertree grid
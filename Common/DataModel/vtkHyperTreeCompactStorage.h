@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkHyperTreeCompactStorage
+ * @brief   Contiguous storage of all the hypertrees of a grid
+ *
+ * The elder child indices and the explicit global indices of all the trees
+ * of a vtkHyperTreeGrid are stored one tree after the other in two arrays.
+ * Each tree is described by an entry giving its counts and its ranges in
+ * these arrays, the entries being sorted by tree index.
+ *
+ * The storage is never modified once built. The vtkHyperTree of a compact
+ * grid are views on their entry, and get their own copy of the data when
+ * they are modified.
+ *
+ * @sa
+ * vtkHyperTree vtkHyperTreeGrid
+ */
+
+#ifndef vtkHyperTreeCompactStorage_h
+#define vtkHyperTreeCompactStorage_h
+
+#include "vtkABINamespace.h"
+#include "vtkType.h" // For vtkIdType
+
+#include <algorithm> // For std::lower_bound
+#include <vector>    // For std::vector
+
+VTK_ABI_NAMESPACE_BEGIN
+//=============================================================================
+struct vtkHyperTreeCompactEntry
+{
+  // Index of the tree in the hypertree grid
+  vtkIdType TreeIndex;
+
+  // Number of vertices (coarse and leaves) and of nodes of the tree
+  vtkIdType NumberOfVertices;
+  vtkIdType NumberOfNodes;
+
+  // Offset of the implicit global index mapping, -1 if explicit
+  vtkIdType GlobalIndexStart;
+
+  // Ranges of the tree in the arrays of the storage
+  vtkIdType ParentToElderChildOffset;
+  vtkIdType GlobalIndexTableOffset;
+  vtkIdType GlobalIndexTableSize;
+  unsigned int ParentToElderChildSize;
+
+  // Number of levels in the tree
+  unsigned int NumberOfLevels;
+};
+
+//=============================================================================
+class vtkHyperTreeCompactStorage
+{
+public:
+  /**
+   * Return the entry of the tree with given index, -1 if there is none.
+   */
+  vtkIdType FindTree(vtkIdType treeIndex) const
+  {
+    auto it = std::lower_bound(this->Trees.begin(), this->Trees.end(), treeIndex,
+      [](const vtkHyperTreeCompactEntry& entry, vtkIdType index)
+      { return entry.TreeIndex < index; });
+    return it != this->Trees.end() && it->TreeIndex == treeIndex ? it - this->Trees.begin() : -1;
+  }
+
+  // One entry per non empty tree, sorted by tree index
+  std::vector<vtkHyperTreeCompactEntry> Trees;
+
+  // Elder child of each vertex of all the trees
+  std::vector<unsigned int> ParentToElderChild;
+
+  // Explicit global index of each vertex of the trees not using the implicit mapping
+  std::vector<vtkIdType> GlobalIndexTable;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
+// VTK-HeaderTest-Exclude: vtkHyperTreeCompactStorage.h
@@ -9,6 +9,7 @@
 #include "vtkDoubleArray.h"
 #include "vtkFieldData.h"
 #include "vtkHyperTree.h"
+#include "vtkHyperTreeCompactStorage.h"
 #include "vtkHyperTreeGridNonOrientedCursor.h"
 #include "vtkHyperTreeGridNonOrientedGeometryCursor.h"
 #include "vtkHyperTreeGridNonOrientedMooreSuperCursor.h"
@@ -28,13 +29,17 @@
 #include "vtkMath.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStructuredData.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <deque>
+#include <mutex>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkInformationKeyMacro(vtkHyperTreeGrid, LEVELS, Integer);
@@ -122,6 +127,140 @@ vtkDataArray* vtkHyperTreeGrid::GetZCoordinates()
       : nullptr))
 #define GetHyperTreeFromThisMacro(_index_) GetHyperTreeFromOtherMacro(this, _index_)
 
+//------------------------------------------------------------------------------
+// The compact storage of the trees, and the views on its entries created on
+// demand. A view may have been modified since, and then no longer matches
+// its entry.
+class vtkHyperTreeGrid::vtkCompactTrees
+{
+public:
+  explicit vtkCompactTrees(std::shared_ptr<const vtkHyperTreeCompactStorage> storage)
+    : Storage(std::move(storage))
+    , Trees(new std::atomic<vtkHyperTree*>[this->Storage->Trees.size()]())
+  {
+  }
+
+  ~vtkCompactTrees()
+  {
+    for (vtkIdType entry = 0; entry < this->GetNumberOfTrees(); ++entry)
+    {
+      if (vtkHyperTree* tree = this->Trees[entry].load(std::memory_order_relaxed))
+      {
+        tree->Delete();
+      }
+    }
+  }
+
+  vtkIdType GetNumberOfTrees() const { return static_cast<vtkIdType>(this->Storage->Trees.size()); }
+
+  /**
+   * Return the view on the given entry, nullptr if it was not created yet.
+   */
+  vtkHyperTree* FindTree(vtkIdType entry) const
+  {
+    return this->Trees[entry].load(std::memory_order_acquire);
+  }
+
+  /**
+   * Return the view on the given entry, creating it if needed. Thread safe.
+   */
+  vtkHyperTree* GetTree(vtkHyperTreeGrid* grid, vtkIdType entry)
+  {
+    if (vtkHyperTree* tree = this->FindTree(entry))
+    {
+      return tree;
+    }
+    std::lock_guard<std::mutex> lock(this->TreesMutex);
+    if (vtkHyperTree* tree = this->Trees[entry].load(std::memory_order_relaxed))
+    {
+      return tree;
+    }
+    vtkHyperTree* tree = vtkHyperTree::New();
+    tree->Initialize(grid->GetBranchFactor(), grid->GetDimension(), this->Storage, entry);
+    tree->SetScales(grid->GetTreeScales(tree->GetTreeIndex()));
+    this->Trees[entry].store(tree, std::memory_order_release);
+    return tree;
+  }
+
+  /**
+   * Return the description of the tree of the given entry, which is the one
+   * of its view when it exists.
+   */
+  const vtkHyperTreeCompactEntry& GetEntry(vtkIdType entry, vtkHyperTreeCompactEntry& buffer) const
+  {
+    if (vtkHyperTree* tree = this->FindTree(entry))
+    {
+      tree->FillCompactEntry(buffer);
+      return buffer;
+    }
+    return this->Storage->Trees[entry];
+  }
+
+  /**
+   * Return the memory used by the views created so far, and by the data of
+   * the ones that no longer match their entry.
+   */
+  size_t GetViewsMemorySizeBytes() const
+  {
+    size_t size = 0;
+    for (vtkIdType entry = 0; entry < this->GetNumberOfTrees(); ++entry)
+    {
+      if (vtkHyperTree* tree = this->FindTree(entry))
+      {
+        size += sizeof(vtkHyperTree);
+        if (tree->GetCompactStorageEntry() != &this->Storage->Trees[entry])
+        {
+          size += tree->GetActualMemorySizeBytes();
+        }
+      }
+    }
+    return size;
+  }
+
+  /**
+   * Return true if a view no longer matches its entry.
+   */
+  bool HasModifiedTrees() const
+  {
+    for (vtkIdType entry = 0; entry < this->GetNumberOfTrees(); ++entry)
+    {
+      vtkHyperTree* tree = this->FindTree(entry);
+      if (tree && tree->GetCompactStorageEntry() != &this->Storage->Trees[entry])
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Copy the storage, which is shared, and the views that no longer match
+   * their entry.
+   */
+  std::unique_ptr<vtkCompactTrees> NewCopy(vtkHyperTreeGrid* grid) const
+  {
+    auto copy = std::unique_ptr<vtkCompactTrees>(new vtkCompactTrees(this->Storage));
+    for (vtkIdType entry = 0; entry < this->GetNumberOfTrees(); ++entry)
+    {
+      vtkHyperTree* tree = this->FindTree(entry);
+      if (tree && tree->GetCompactStorageEntry() != &this->Storage->Trees[entry])
+      {
+        vtkHyperTree* treeCopy = vtkHyperTree::New();
+        treeCopy->Initialize(grid->GetBranchFactor(), grid->GetDimension());
+        treeCopy->CopyStructure(tree);
+        copy->Trees[entry].store(treeCopy, std::memory_order_relaxed);
+      }
+    }
+    return copy;
+  }
+
+  std::shared_ptr<const vtkHyperTreeCompactStorage> Storage;
+
+private:
+  std::unique_ptr<std::atomic<vtkHyperTree*>[]> Trees;
+  std::mutex TreesMutex;
+};
+
 //------------------------------------------------------------------------------
 vtkHyperTreeGrid::vtkHyperTreeGrid()
   : XCoordinates(vtkSmartPointer<vtkDoubleArray>::New())
@@ -179,6 +318,7 @@ void vtkHyperTreeGrid::Initialize()
   this->CellData->Initialize();
   // Delete existing trees
   this->HyperTrees.clear();
+  this->Compact = nullptr;
 
   // Grid topology
   this->TransposedRootIndexing = false;
@@ -310,6 +450,8 @@ void vtkHyperTreeGrid::PrintSelf(ostream& os, vtkIndent indent)
     os << indent << "Non explicit coordinates" << endl;
   }
   os << indent << "HyperTrees: " << this->HyperTrees.size() << endl;
+  os << indent << "CompactTrees: " << (this->Compact ? this->Compact->GetNumberOfTrees() : 0)
+     << endl;
 
   os << indent << "CellData:" << endl;
   this->CellData->PrintSelf(os, indent.GetNextIndent());
@@ -410,6 +552,7 @@ void vtkHyperTreeGrid::CopyStructure(vtkDataObject* ds)
 
   // Search for hyper tree with given index
   this->HyperTrees.clear();
+  this->Compact = htg->Compact ? htg->Compact->NewCopy(this) : nullptr;
 
   for (std::map<vtkIdType, vtkSmartPointer<vtkHyperTree>>::const_iterator it =
          htg->HyperTrees.begin();
@@ -656,6 +799,13 @@ vtkIdType vtkHyperTreeGrid::GetMaxNumberOfTrees() const
 //------------------------------------------------------------------------------
 unsigned int vtkHyperTreeGrid::GetNumberOfLevels(vtkIdType index)
 {
+  // Read the compact storage without creating the tree
+  if (this->Compact)
+  {
+    const vtkIdType entry = this->Compact->Storage->FindTree(index);
+    vtkHyperTreeCompactEntry buffer;
+    return entry < 0 ? 0 : this->Compact->GetEntry(entry, buffer).NumberOfLevels;
+  }
   vtkHyperTree* tree = GetHyperTreeFromThisMacro(index);
   return tree ? tree->GetNumberOfLevels() : 0;
 }
@@ -665,6 +815,18 @@ unsigned int vtkHyperTreeGrid::GetNumberOfLevels()
 {
   vtkIdType nLevels = 0;
 
+  // Read the compact storage without creating the trees
+  if (this->Compact)
+  {
+    vtkHyperTreeCompactEntry buffer;
+    for (vtkIdType entry = 0; entry < this->Compact->GetNumberOfTrees(); ++entry)
+    {
+      const vtkIdType nl = this->Compact->GetEntry(entry, buffer).NumberOfLevels;
+      nLevels = std::max(nl, nLevels);
+    }
+    return nLevels;
+  }
+
   // Iterate over all individual trees
   vtkHyperTreeGrid::vtkHyperTreeGridIterator it;
   this->InitializeTreeIterator(it);
@@ -681,7 +843,7 @@ unsigned int vtkHyperTreeGrid::GetNumberOfLevels()
 //------------------------------------------------------------------------------
 vtkIdType vtkHyperTreeGrid::GetNumberOfNonEmptyTrees()
 {
-  return this->HyperTrees.size();
+  return this->Compact ? this->Compact->GetNumberOfTrees() : this->HyperTrees.size();
 }
 
 //------------------------------------------------------------------------------
@@ -689,6 +851,17 @@ vtkIdType vtkHyperTreeGrid::GetNumberOfCells()
 {
   vtkIdType nVertices = 0;
 
+  // Read the compact storage without creating the trees
+  if (this->Compact)
+  {
+    vtkHyperTreeCompactEntry buffer;
+    for (vtkIdType entry = 0; entry < this->Compact->GetNumberOfTrees(); ++entry)
+    {
+      nVertices += this->Compact->GetEntry(entry, buffer).NumberOfVertices;
+    }
+    return nVertices;
+  }
+
   // Iterate over all trees in grid
   vtkHyperTreeGridIterator it;
   it.Initialize(this);
@@ -704,6 +877,18 @@ vtkIdType vtkHyperTreeGrid::GetNumberOfLeaves()
 {
   vtkIdType nLeaves = 0;
 
+  // Read the compact storage without creating the trees
+  if (this->Compact)
+  {
+    vtkHyperTreeCompactEntry buffer;
+    for (vtkIdType entry = 0; entry < this->Compact->GetNumberOfTrees(); ++entry)
+    {
+      const vtkHyperTreeCompactEntry& treeEntry = this->Compact->GetEntry(entry, buffer);
+      nLeaves += treeEntry.NumberOfVertices - treeEntry.NumberOfNodes;
+    }
+    return nLeaves;
+  }
+
   // Iterate over all trees in grid
   vtkHyperTreeGridIterator it;
   it.Initialize(this);
@@ -1014,6 +1199,17 @@ vtkHyperTree* vtkHyperTreeGrid::GetTree(vtkIdType index, bool create)
 {
   assert("pre: not_tree" && index < this->GetMaxNumberOfTrees());
 
+  // Trees are added to the default storage
+  if (this->Compact)
+  {
+    vtkHyperTree* tree = this->GetCompactTree(index);
+    if (tree || !create)
+    {
+      return tree;
+    }
+    this->ExpandTrees();
+  }
+
   // Wrap convenience macro for outside use
   vtkHyperTree* tree = GetHyperTreeFromThisMacro(index);
 
@@ -1032,20 +1228,27 @@ vtkHyperTree* vtkHyperTreeGrid::GetTree(vtkIdType index, bool create)
 
     if (!tree->HasScales())
     {
-      double origin[3];
-      double scale[3];
-      this->GetLevelZeroOriginAndSizeFromIndex(tree->GetTreeIndex(), origin, scale);
-      tree->SetScales(std::make_shared<vtkHyperTreeGridScales>(this->BranchFactor, scale));
+      tree->SetScales(this->GetTreeScales(index));
     }
   }
 
   return tree;
 }
 
+//------------------------------------------------------------------------------
+std::shared_ptr<vtkHyperTreeGridScales> vtkHyperTreeGrid::GetTreeScales(vtkIdType index)
+{
+  double origin[3];
+  double scale[3];
+  this->GetLevelZeroOriginAndSizeFromIndex(index, origin, scale);
+  return std::make_shared<vtkHyperTreeGridScales>(this->BranchFactor, scale);
+}
+
 //------------------------------------------------------------------------------
 void vtkHyperTreeGrid::SetTree(vtkIdType index, vtkHyperTree* tree)
 {
   // Assign given tree at given index of hyper tree grid
+  this->ExpandTrees();
   tree->SetTreeIndex(index);
   this->HyperTrees[index] = tree;
 }
@@ -1053,9 +1256,204 @@ void vtkHyperTreeGrid::SetTree(vtkIdType index, vtkHyperTree* tree)
 //------------------------------------------------------------------------------
 size_t vtkHyperTreeGrid::RemoveTree(vtkIdType index)
 {
+  this->ExpandTrees();
   return this->HyperTrees.erase(index);
 }
 
+//------------------------------------------------------------------------------
+vtkHyperTree* vtkHyperTreeGrid::GetCompactTree(vtkIdType index)
+{
+  assert("pre: compact_trees" && this->Compact != nullptr);
+  const vtkIdType entry = this->Compact->Storage->FindTree(index);
+  return entry < 0 ? nullptr : this->Compact->GetTree(this, entry);
+}
+
+//------------------------------------------------------------------------------
+void vtkHyperTreeGrid::ExpandTrees()
+{
+  if (!this->Compact)
+  {
+    return;
+  }
+  for (vtkIdType entry = 0; entry < this->Compact->GetNumberOfTrees(); ++entry)
+  {
+    this->HyperTrees.emplace_hint(this->HyperTrees.end(),
+      this->Compact->Storage->Trees[entry].TreeIndex, this->Compact->GetTree(this, entry));
+  }
+  this->Compact = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkHyperTreeGrid::CompactTrees()
+{
+  if (this->Compact)
+  {
+    if (!this->Compact->HasModifiedTrees())
+    {
+      return;
+    }
+    this->ExpandTrees();
+  }
+
+  std::vector<vtkHyperTree*> trees;
+  trees.reserve(this->HyperTrees.size());
+  for (const auto& it : this->HyperTrees)
+  {
+    trees.emplace_back(it.second);
+  }
+  const vtkIdType numberOfTrees = static_cast<vtkIdType>(trees.size());
+
+  // Describe the trees, place them one after the other, then copy them
+  auto storage = std::make_shared<vtkHyperTreeCompactStorage>();
+  storage->Trees.resize(numberOfTrees);
+  vtkSMPTools::For(0, numberOfTrees,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType entry = begin; entry < end; ++entry)
+      {
+        trees[entry]->FillCompactEntry(storage->Trees[entry]);
+      }
+    });
+  vtkIdType parentToElderChildSize = 0;
+  vtkIdType globalIndexTableSize = 0;
+  auto treeIt = this->HyperTrees.begin();
+  for (vtkHyperTreeCompactEntry& entry : storage->Trees)
+  {
+    entry.TreeIndex = (treeIt++)->first;
+    entry.ParentToElderChildOffset = parentToElderChildSize;
+    entry.GlobalIndexTableOffset = globalIndexTableSize;
+    parentToElderChildSize += entry.ParentToElderChildSize;
+    globalIndexTableSize += entry.GlobalIndexTableSize;
+  }
+  storage->ParentToElderChild.resize(parentToElderChildSize);
+  storage->GlobalIndexTable.resize(globalIndexTableSize);
+  vtkSMPTools::For(0, numberOfTrees,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType entry = begin; entry < end; ++entry)
+      {
+        trees[entry]->CopyToCompactStorage(storage.get(), storage->Trees[entry]);
+      }
+    });
+
+  this->HyperTrees.clear();
+  this->Compact.reset(new vtkCompactTrees(storage));
+}
+
+//------------------------------------------------------------------------------
+bool vtkHyperTreeGrid::BuildCompactTrees(
+  vtkIdTypeArray* treeIndices, vtkBitArray* descriptor, vtkIdTypeArray* numberOfBits)
+{
+  const vtkIdType numberOfTrees = treeIndices->GetNumberOfValues();
+  if (numberOfBits->GetNumberOfValues() != numberOfTrees)
+  {
+    vtkErrorMacro("Expected " << numberOfTrees << " descriptor sizes, got "
+                              << numberOfBits->GetNumberOfValues() << ".");
+    return false;
+  }
+
+  // The descriptors of the trees follow each other
+  auto storage = std::make_shared<vtkHyperTreeCompactStorage>();
+  storage->Trees.resize(numberOfTrees);
+  std::vector<vtkIdType> startIndices(numberOfTrees);
+  vtkIdType descriptorSize = 0;
+  vtkIdType parentToElderChildSize = 0;
+  for (vtkIdType entry = 0; entry < numberOfTrees; ++entry)
+  {
+    vtkHyperTreeCompactEntry& treeEntry = storage->Trees[entry];
+    const vtkIdType bits = numberOfBits->GetValue(entry);
+    treeEntry.TreeIndex = treeIndices->GetValue(entry);
+    if (treeEntry.TreeIndex < 0 || treeEntry.TreeIndex >= this->GetMaxNumberOfTrees() || bits < 0)
+    {
+      vtkErrorMacro("Invalid tree " << treeEntry.TreeIndex << ".");
+      return false;
+    }
+    startIndices[entry] = descriptorSize;
+    treeEntry.ParentToElderChildOffset = parentToElderChildSize;
+    treeEntry.ParentToElderChildSize = static_cast<unsigned int>(std::max(bits, vtkIdType(1)));
+    treeEntry.GlobalIndexTableOffset = 0;
+    treeEntry.GlobalIndexTableSize = 0;
+    descriptorSize += bits;
+    parentToElderChildSize += treeEntry.ParentToElderChildSize;
+  }
+  if (descriptorSize > descriptor->GetNumberOfValues())
+  {
+    vtkErrorMacro("The descriptor has " << descriptor->GetNumberOfValues() << " bits instead of "
+                                        << descriptorSize << ".");
+    return false;
+  }
+
+  // Same decoding as vtkHyperTree::BuildFromBreadthFirstOrderDescriptor
+  const unsigned int numberOfChildren = this->NumberOfChildren;
+  storage->ParentToElderChild.resize(parentToElderChildSize);
+  vtkSMPTools::For(0, numberOfTrees,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType entry = begin; entry < end; ++entry)
+      {
+        vtkHyperTreeCompactEntry& treeEntry = storage->Trees[entry];
+        unsigned int* parentToElderChild =
+          storage->ParentToElderChild.data() + treeEntry.ParentToElderChildOffset;
+        const vtkIdType startIndex = startIndices[entry];
+        const vtkIdType bits = numberOfBits->GetValue(entry);
+        parentToElderChild[0] = std::numeric_limits<unsigned int>::max();
+        unsigned int numberOfDepths = 1;
+        vtkIdType numberOfCoarseVertices = 0;
+        vtkIdType numberOfVertices = 1;
+        vtkIdType currentDepthSize = 1;
+        vtkIdType nextDepthSize = 0;
+        vtkIdType currentPositionAtDepth = 0;
+        for (vtkIdType id = 0; id < bits; ++id)
+        {
+          if (descriptor->GetValue(startIndex + id))
+          {
+            parentToElderChild[id] = static_cast<unsigned int>(numberOfVertices);
+            numberOfVertices += numberOfChildren;
+            ++numberOfCoarseVertices;
+            nextDepthSize += numberOfChildren;
+          }
+          else
+          {
+            parentToElderChild[id] = std::numeric_limits<unsigned int>::max();
+          }
+          if (++currentPositionAtDepth == currentDepthSize)
+          {
+            ++numberOfDepths;
+            currentDepthSize = nextDepthSize;
+            nextDepthSize = 0;
+            currentPositionAtDepth = 0;
+          }
+        }
+        treeEntry.NumberOfLevels = numberOfDepths;
+        treeEntry.NumberOfNodes = numberOfCoarseVertices;
+        treeEntry.NumberOfVertices = numberOfVertices;
+      }
+    });
+
+  // Implicit global indices, in the order of the trees
+  vtkIdType globalIndexStart = 0;
+  for (vtkHyperTreeCompactEntry& treeEntry : storage->Trees)
+  {
+    treeEntry.GlobalIndexStart = globalIndexStart;
+    globalIndexStart += treeEntry.NumberOfVertices;
+  }
+
+  std::sort(storage->Trees.begin(), storage->Trees.end(),
+    [](const vtkHyperTreeCompactEntry& entry1, const vtkHyperTreeCompactEntry& entry2)
+    { return entry1.TreeIndex < entry2.TreeIndex; });
+  if (std::adjacent_find(storage->Trees.begin(), storage->Trees.end(),
+        [](const vtkHyperTreeCompactEntry& entry1, const vtkHyperTreeCompactEntry& entry2)
+        { return entry1.TreeIndex == entry2.TreeIndex; }) != storage->Trees.end())
+  {
+    vtkErrorMacro("Trees are repeated.");
+    return false;
+  }
+
+  this->HyperTrees.clear();
+  this->Compact.reset(new vtkCompactTrees(storage));
+  return true;
+}
+
 //------------------------------------------------------------------------------
 void vtkHyperTreeGrid::ShallowCopy(vtkDataObject* src)
 {
@@ -1137,6 +1535,7 @@ void vtkHyperTreeGrid::DeepCopy(vtkDataObject* src)
   // Call superclass
   this->Superclass::DeepCopy(src);
   this->HyperTrees.clear();
+  this->Compact = htg->Compact ? htg->Compact->NewCopy(this) : nullptr;
 
   for (std::map<vtkIdType, vtkSmartPointer<vtkHyperTree>>::const_iterator it =
          htg->HyperTrees.begin();
@@ -1304,11 +1703,23 @@ unsigned long vtkHyperTreeGrid::GetActualMemorySizeBytes()
   size += this->vtkDataObject::GetActualMemorySize() << 10;
 
   // Iterate over all trees in grid
-  vtkHyperTreeGridIterator it;
-  it.Initialize(this);
-  while (vtkHyperTree* tree = it.GetNextTree())
+  if (this->Compact)
+  {
+    // Compact storage and the views created on it, without creating others
+    const vtkHyperTreeCompactStorage* storage = this->Compact->Storage.get();
+    size += storage->Trees.size() * (sizeof(vtkHyperTreeCompactEntry) + sizeof(vtkHyperTree*));
+    size += storage->ParentToElderChild.size() * sizeof(unsigned int);
+    size += storage->GlobalIndexTable.size() * sizeof(vtkIdType);
+    size += this->Compact->GetViewsMemorySizeBytes();
+  }
+  else
   {
-    size += tree->GetActualMemorySizeBytes();
+    vtkHyperTreeGridIterator it;
+    it.Initialize(this);
+    while (vtkHyperTree* tree = it.GetNextTree())
+    {
+      size += tree->GetActualMemorySizeBytes();
+    }
   }
 
   // Approximate map memory size
@@ -1541,6 +1952,22 @@ vtkIdType vtkHyperTreeGrid::GetGlobalNodeIndexMax()
 {
   // Iterate over all hyper trees
   vtkIdType max = 0;
+
+  // Read the compact storage when the indices are implicit
+  if (this->Compact)
+  {
+    vtkHyperTreeCompactEntry buffer;
+    for (vtkIdType entry = 0; entry < this->Compact->GetNumberOfTrees(); ++entry)
+    {
+      const vtkHyperTreeCompactEntry& treeEntry = this->Compact->GetEntry(entry, buffer);
+      max = std::max(max,
+        treeEntry.GlobalIndexTableSize
+          ? this->Compact->GetTree(this, entry)->GetGlobalNodeIndexMax()
+          : treeEntry.GlobalIndexStart + treeEntry.NumberOfVertices - 1);
+    }
+    return max;
+  }
+
   vtkHyperTree* crtTree = nullptr;
   vtkHyperTreeGridIterator it;
   this->InitializeTreeIterator(it);
@@ -1582,11 +2009,21 @@ void vtkHyperTreeGrid::vtkHyperTreeGridIterator::Initialize(vtkHyperTreeGrid* gr
   assert(grid != nullptr);
   this->Grid = grid;
   this->Iterator = grid->HyperTrees.begin();
+  this->CompactEntry = 0;
 }
 
 //------------------------------------------------------------------------------
 vtkHyperTree* vtkHyperTreeGrid::vtkHyperTreeGridIterator::GetNextTree(vtkIdType& index)
 {
+  if (vtkCompactTrees* compact = this->Grid->Compact.get())
+  {
+    if (this->CompactEntry >= compact->GetNumberOfTrees())
+    {
+      return nullptr;
+    }
+    index = compact->Storage->Trees[this->CompactEntry].TreeIndex;
+    return compact->GetTree(this->Grid, this->CompactEntry++);
+  }
   if (this->Iterator == this->Grid->HyperTrees.end())
   {
     return nullptr;
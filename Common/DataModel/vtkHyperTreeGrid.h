@@ -66,6 +66,7 @@
 #include <cassert> // std::assert
 #include <limits>  // limits
 #include <map>     // std::map
+#include <memory>  // std::unique_ptr, std::shared_ptr
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkBitArray;
@@ -75,6 +76,7 @@ class vtkCollection;
 class vtkDataArray;
 class vtkHyperTree;
 class vtkHyperTreeGridOrientedCursor;
+class vtkHyperTreeGridScales;
 class vtkHyperTreeGridOrientedGeometryCursor;
 class vtkHyperTreeGridNonOrientedCursor;
 class vtkHyperTreeGridNonOrientedGeometryCursor;
@@ -86,6 +88,7 @@ class vtkHyperTreeGridNonOrientedMooreSuperCursorLight;
 class vtkHyperTreeGridNonOrientedUnlimitedMooreSuperCursor;
 class vtkDoubleArray;
 class vtkDataSetAttributes;
+class vtkHyperTreeCompactStorage;
 class vtkIdTypeArray;
 class vtkLine;
 class vtkPixel;
@@ -488,6 +491,8 @@ public:
   /**
    * Return tree located at given index of hyper tree grid
    * NB: This will construct a new HyperTree if grid slot is empty.
+   * Without creation, this method can be called concurrently, for instance
+   * to process the trees in parallel.
    */
   virtual vtkHyperTree* GetTree(vtkIdType index, bool create = false);
 
@@ -503,6 +508,42 @@ public:
    */
   size_t RemoveTree(vtkIdType index);
 
+  /**
+   * Store all the trees of the grid in one compact storage instead of one
+   * set of arrays per tree, see vtkHyperTreeCompactStorage. The trees are
+   * then lightweight views on the storage, only created when GetTree() or
+   * the tree iterator return them, which saves most of the memory and the
+   * allocations needed by grids with many small trees. The cursors work the
+   * same on a compact grid. A tree modified through a cursor gets its own
+   * copy of its data, and adding or removing a tree moves the trees back to
+   * the default storage. The storage is filled in parallel.
+   * Once created, a view lives as long as the trees of the grid, so that the
+   * trees returned by GetTree() stay valid: it is only released when the
+   * grid is initialized, copied over or compacted again, and it becomes the
+   * tree of the default storage when the trees are expanded. Iterating over
+   * all the trees thus keeps a view for each of them.
+   */
+  void CompactTrees();
+
+  /**
+   * Return true if the trees are stored in a compact storage.
+   */
+  bool HasCompactTrees() const { return this->Compact != nullptr; }
+
+  /**
+   * Build the trees listed in treeIndices, in parallel, directly in a
+   * compact storage (see CompactTrees()). The trees previously in the grid
+   * are removed. The breadth first order descriptors of the trees are stored
+   * one after the other in descriptor, and numberOfBits gives the number of
+   * bits of each of them, as passed to
+   * vtkHyperTree::BuildFromBreadthFirstOrderDescriptor(). The global indices
+   * are implicit and numbered in the order of treeIndices.
+   * Return false if the tree indices are invalid or repeated, or if the
+   * descriptor is too short.
+   */
+  bool BuildCompactTrees(
+    vtkIdTypeArray* treeIndices, vtkBitArray* descriptor, vtkIdTypeArray* numberOfBits);
+
   /**
    * Create shallow copy of hyper tree grid.
    */
@@ -727,6 +768,7 @@ public:
 
   protected:
     std::map<vtkIdType, vtkSmartPointer<vtkHyperTree>>::iterator Iterator;
+    vtkIdType CompactEntry = 0;
     vtkHyperTreeGrid* Grid = nullptr;
   };
 
@@ -821,6 +863,25 @@ protected:
   unsigned int BranchFactor = 0; // 2 or 3, 0 for invalid
   unsigned int Dimension = 0;    // 1, 2, or 3, 0 for invalid
 
+  /**
+   * Return the tree with given index of the compact storage, nullptr if
+   * there is none. The view on the tree is created the first time.
+   * \pre compact_trees: HasCompactTrees()
+   */
+  vtkHyperTree* GetCompactTree(vtkIdType index);
+
+  /**
+   * Move the trees of the compact storage back to the default storage.
+   */
+  void ExpandTrees();
+
+  /**
+   * Return the per-level scales of the cells of the tree with given index,
+   * given to the trees when they are created. By default, each tree gets its
+   * own scales.
+   */
+  virtual std::shared_ptr<vtkHyperTreeGridScales> GetTreeScales(vtkIdType index);
+
 private:
   // Invalid default grid parameters to force actual initialization
   unsigned int Orientation = std::numeric_limits<unsigned int>::max(); // 0, 1, or 2
@@ -867,6 +928,10 @@ protected:
 
   std::map<vtkIdType, vtkSmartPointer<vtkHyperTree>> HyperTrees;
 
+  // Compact storage of the trees, replacing HyperTrees when it is set
+  class vtkCompactTrees;
+  std::unique_ptr<vtkCompactTrees> Compact;
+
   vtkNew<vtkCellData> CellData; // Scalars, vectors, etc. associated w/ each point
 
   unsigned int DepthLimiter = std::numeric_limits<unsigned int>::max();
@@ -214,6 +214,9 @@ public:
    */
   vtkIdType FindClosestPointWithinSquaredRadius(double radius2, const double x[3], double& dist2);
 
+  // Reuse any superclass signatures that we don't override.
+  using vtkAbstractPointLocator::FindPointsWithinRadius;
+
   /**
    * Find all points within a radius R relative to a given point x. The returned
    * point ids (stored in result) are not sorted in any way. BuildLocator() should
@@ -12,6 +12,7 @@
 #include "vtkDataSetCollection.h"
 #include "vtkFloatArray.h"
 #include "vtkGarbageCollector.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
@@ -23,15 +24,23 @@
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTimerLog.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
 #include <list>
 #include <map>
+#include <numeric>
 #include <queue>
 #include <set>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 namespace
@@ -172,6 +181,278 @@ private:
 };
 }
 
+// helpers for the parallel build of the k-d tree
+namespace
+{
+// The two halves of regions with more points than this are divided
+// concurrently.
+constexpr int KdConcurrentRegionSize = 64 * 1024;
+
+// Regions with more points than this are divided with SelectLarge() instead
+// of vtkKdTree::Select(), for the top levels of the tree which do not have
+// enough regions to keep the threads busy.  Select() is faster on one thread.
+// This threshold does not depend on the number of threads, so neither does
+// the order of the points in the regions.
+constexpr int KdLargeRegionSize = 1024 * 1024;
+
+// Number of points per block of the parallel loops.
+constexpr int KdBlockSize = 16 * 1024;
+
+//------------------------------------------------------------------------------
+// Find the K-th smallest coordinate along dim, and the number of coordinates
+// strictly less than it, which is the index of its first occurrence once the
+// points are sorted.  The coordinates are counted in buckets spanning range,
+// the data bounds of the region, then the ones in the bucket of the K-th
+// smallest are gathered and selected from.  Any coordinate outside of range
+// goes to the first or last bucket, so range only needs to be a good guess.
+float SelectCoordinate(int dim, const double range[2], const float* c1, int nvals, int K,
+  int& numLess)
+{
+  constexpr int numBuckets = 4096;
+  const double origin = range[0];
+  const double scale = (range[1] > range[0]) ? numBuckets / (range[1] - range[0]) : 0.0;
+  auto bucketOf = [origin, scale](float coord)
+  {
+    const double bucket = (coord - origin) * scale;
+    if (!(bucket > 0.0))
+    {
+      return 0;
+    }
+    return bucket < numBuckets - 1 ? static_cast<int>(bucket) : numBuckets - 1;
+  };
+
+  vtkSMPThreadLocal<std::vector<int>> localCounts;
+  vtkSMPTools::For(0, nvals, KdBlockSize,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      std::vector<int>& counts = localCounts.Local();
+      counts.resize(numBuckets, 0);
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        ++counts[bucketOf(c1[3 * i + dim])];
+      }
+    });
+
+  std::vector<int> counts(numBuckets, 0);
+  for (const std::vector<int>& local : localCounts)
+  {
+    for (std::size_t bucket = 0; bucket < local.size(); ++bucket)
+    {
+      counts[bucket] += local[bucket];
+    }
+  }
+
+  int bucket = 0;
+  numLess = 0;
+  while (numLess + counts[bucket] <= K)
+  {
+    numLess += counts[bucket++];
+  }
+
+  vtkSMPThreadLocal<std::vector<float>> localCandidates;
+  vtkSMPTools::For(0, nvals, KdBlockSize,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      std::vector<float>& candidates = localCandidates.Local();
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        if (bucketOf(c1[3 * i + dim]) == bucket)
+        {
+          candidates.push_back(c1[3 * i + dim]);
+        }
+      }
+    });
+
+  std::vector<float> candidates;
+  candidates.reserve(counts[bucket]);
+  for (const std::vector<float>& local : localCandidates)
+  {
+    candidates.insert(candidates.end(), local.begin(), local.end());
+  }
+
+  auto nth = candidates.begin() + (K - numLess);
+  std::nth_element(candidates.begin(), nth, candidates.end());
+  const float value = *nth;
+  numLess += static_cast<int>(
+    std::count_if(candidates.begin(), nth, [value](float coord) { return coord < value; }));
+
+  return value;
+}
+
+//------------------------------------------------------------------------------
+void SwapPoints(float* c1, int* ids, int a, int b)
+{
+  std::swap_ranges(c1 + 3 * a, c1 + 3 * a + 3, c1 + 3 * b);
+  if (ids)
+  {
+    std::swap(ids[a], ids[b]);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Move the points whose coordinate along dim is less than value before the
+// other ones, and return the largest of these coordinates.  Each block of
+// points is partitioned in place, then the points left in the wrong half are
+// swapped pairwise.  The blocks and the pairs do not depend on the number of
+// threads, so neither does the order of the points.
+float PartitionPoints(int dim, float* c1, int* ids, int nvals, float value)
+{
+  const int numBlocks = (nvals + KdBlockSize - 1) / KdBlockSize;
+  std::vector<int> numLeft(numBlocks + 1, 0);
+  std::vector<float> leftMax(numBlocks);
+
+  vtkSMPTools::For(0, numBlocks,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType block = begin; block < end; ++block)
+      {
+        const int first = static_cast<int>(block) * KdBlockSize;
+        int i = first;
+        int j = std::min(nvals, first + KdBlockSize);
+        float blockMax = std::numeric_limits<float>::lowest();
+        while (true)
+        {
+          while ((i < j) && (c1[3 * i + dim] < value))
+          {
+            blockMax = std::max(blockMax, c1[3 * i + dim]);
+            i++;
+          }
+          while ((i < j) && !(c1[3 * (j - 1) + dim] < value))
+          {
+            j--;
+          }
+          if (i >= j)
+          {
+            break;
+          }
+          SwapPoints(c1, ids, i, j - 1);
+          blockMax = std::max(blockMax, c1[3 * i + dim]);
+          i++;
+          j--;
+        }
+        numLeft[block + 1] = i - first;
+        leftMax[block] = blockMax;
+      }
+    });
+  std::partial_sum(numLeft.begin(), numLeft.end(), numLeft.begin());
+  const int nleft = numLeft[numBlocks];
+
+  // Runs of points on the wrong side of nleft, and the number of points in
+  // the previous runs: the right points before nleft, and the left ones after.
+  struct Run
+  {
+    int Begin;
+    int End;
+    int Offset;
+  };
+  std::vector<Run> misplaced[2];
+  int numMisplaced[2] = { 0, 0 };
+  for (int block = 0; block < numBlocks; ++block)
+  {
+    const int first = block * KdBlockSize;
+    const int last = std::min(nvals, first + KdBlockSize);
+    const int split = first + numLeft[block + 1] - numLeft[block];
+    const Run runs[2] = { { split, std::min(last, nleft), 0 },
+      { std::max(first, nleft), split, 0 } };
+    for (int side = 0; side < 2; ++side)
+    {
+      if (runs[side].Begin < runs[side].End)
+      {
+        misplaced[side].push_back({ runs[side].Begin, runs[side].End, numMisplaced[side] });
+        numMisplaced[side] += runs[side].End - runs[side].Begin;
+      }
+    }
+  }
+
+  vtkSMPTools::For(0, numMisplaced[0], KdBlockSize,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      // The runs and positions of the begin-th misplaced points.
+      auto before = [](vtkIdType k, const Run& r) { return k < r.Offset; };
+      std::vector<Run>::const_iterator run[2];
+      int position[2];
+      for (int side = 0; side < 2; ++side)
+      {
+        run[side] =
+          std::upper_bound(misplaced[side].begin(), misplaced[side].end(), begin, before) - 1;
+        position[side] = run[side]->Begin + static_cast<int>(begin - run[side]->Offset);
+      }
+      for (vtkIdType k = begin; k < end; ++k)
+      {
+        for (int side = 0; side < 2; ++side)
+        {
+          if (position[side] == run[side]->End)
+          {
+            ++run[side];
+            position[side] = run[side]->Begin;
+          }
+        }
+        SwapPoints(c1, ids, position[0]++, position[1]++);
+      }
+    });
+
+  return *std::max_element(leftMax.begin(), leftMax.end());
+}
+
+//------------------------------------------------------------------------------
+// Same result as vtkKdTree::Select() for a large region.
+int SelectLarge(int dim, const double range[2], float* c1, int* ids, int nvals, double& coord)
+{
+  int mid;
+  const float value = SelectCoordinate(dim, range, c1, nvals, nvals / 2, mid);
+
+  if (mid == 0)
+  {
+    return mid; // failed to divide region
+  }
+
+  const float leftMax = PartitionPoints(dim, c1, ids, nvals, value);
+
+  coord = (static_cast<double>(value) + static_cast<double>(leftMax)) / 2.0;
+
+  return mid;
+}
+
+//------------------------------------------------------------------------------
+// Same as vtkKdNode::SetDataBounds(float*) for a child of a large region, with
+// the range along the cut direction computed in parallel.
+void SetLargeDataBounds(vtkKdNode* kd, const float* c1)
+{
+  double bounds[6];
+  kd->GetUp()->GetDataBounds(bounds);
+  const int dim = kd->GetUp()->GetDim();
+  const int npoints = kd->GetNumberOfPoints();
+  const int numBlocks = (npoints + KdBlockSize - 1) / KdBlockSize;
+  std::vector<std::array<float, 2>> ranges(numBlocks);
+
+  vtkSMPTools::For(0, numBlocks,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType block = begin; block < end; ++block)
+      {
+        const int first = static_cast<int>(block) * KdBlockSize;
+        const int last = std::min(npoints, first + KdBlockSize);
+        std::array<float, 2>& range = ranges[block];
+        range[0] = range[1] = c1[3 * first + dim];
+        for (int i = first + 1; i < last; ++i)
+        {
+          range[0] = std::min(range[0], c1[3 * i + dim]);
+          range[1] = std::max(range[1], c1[3 * i + dim]);
+        }
+      }
+    });
+
+  bounds[2 * dim] = ranges[0][0];
+  bounds[2 * dim + 1] = ranges[0][1];
+  for (const std::array<float, 2>& range : ranges)
+  {
+    bounds[2 * dim] = std::min(bounds[2 * dim], static_cast<double>(range[0]));
+    bounds[2 * dim + 1] = std::max(bounds[2 * dim + 1], static_cast<double>(range[1]));
+  }
+  kd->SetDataBounds(bounds[0], bounds[1], bounds[2], bounds[3], bounds[4], bounds[5]);
+}
+}
+
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkKdTree);
 
@@ -195,6 +476,7 @@ vtkKdTree::vtkKdTree()
 
   this->Top = nullptr;
   this->RegionList = nullptr;
+  this->FlatTree = nullptr;
 
   this->Timing = 0;
   this->TimerLog = nullptr;
@@ -637,51 +919,54 @@ float* vtkKdTree::ComputeCellCenters(vtkDataSet* set)
     }
   }
 
-  double* weights = new double[maxCellSize];
+  // The cells are fetched into a vtkGenericCell per thread, which is thread
+  // safe once a first cell was fetched (this builds the cells of poly data).
 
-  float* cptr = center;
-  double dcenter[3];
+  vtkSMPThreadLocalObject<vtkGenericCell> localCell;
+  vtkSMPThreadLocal<std::vector<double>> localWeights;
+  vtkIdType offset = 0;
 
-  if (set)
+  vtkCollectionSimpleIterator cookie;
+  this->DataSets->InitTraversal(cookie);
+  for (vtkDataSet* iset = set ? set : this->DataSets->GetNextDataSet(cookie); iset != nullptr;
+       iset = set ? nullptr : this->DataSets->GetNextDataSet(cookie))
   {
-    for (int j = 0; j < totalCells; j++)
+    vtkIdType nCells = iset->GetNumberOfCells();
+
+    if (nCells == 0)
     {
-      this->ComputeCellCenter(set->GetCell(j), dcenter, weights);
-      cptr[0] = static_cast<float>(dcenter[0]);
-      cptr[1] = static_cast<float>(dcenter[1]);
-      cptr[2] = static_cast<float>(dcenter[2]);
-      cptr += 3;
-      if (j % 1000 == 0)
-      {
-        this->UpdateSubOperationProgress(static_cast<double>(j) / totalCells);
-      }
+      continue;
     }
-  }
-  else
-  {
-    vtkCollectionSimpleIterator cookie;
-    this->DataSets->InitTraversal(cookie);
-    for (vtkDataSet* iset = this->DataSets->GetNextDataSet(cookie); iset != nullptr;
-         iset = this->DataSets->GetNextDataSet(cookie))
-    {
-      int nCells = iset->GetNumberOfCells();
 
-      for (int j = 0; j < nCells; j++)
+    iset->GetCell(0, localCell.Local());
+
+    vtkSMPTools::For(0, nCells,
+      [&](vtkIdType begin, vtkIdType end)
       {
-        this->ComputeCellCenter(iset->GetCell(j), dcenter, weights);
-        cptr[0] = static_cast<float>(dcenter[0]);
-        cptr[1] = static_cast<float>(dcenter[1]);
-        cptr[2] = static_cast<float>(dcenter[2]);
-        cptr += 3;
-        if (j % 1000 == 0)
+        vtkGenericCell* cell = localCell.Local();
+        std::vector<double>& weights = localWeights.Local();
+        weights.resize(maxCellSize);
+        const bool isFirst = vtkSMPTools::GetSingleThread();
+        double dcenter[3];
+        float* cptr = center + 3 * (offset + begin);
+
+        for (vtkIdType j = begin; j < end; j++)
         {
-          this->UpdateSubOperationProgress(static_cast<double>(j) / totalCells);
+          iset->GetCell(j, cell);
+          this->ComputeCellCenter(cell, dcenter, weights.data());
+          cptr[0] = static_cast<float>(dcenter[0]);
+          cptr[1] = static_cast<float>(dcenter[1]);
+          cptr[2] = static_cast<float>(dcenter[2]);
+          cptr += 3;
         }
-      }
-    }
-  }
+        if (isFirst)
+        {
+          this->UpdateSubOperationProgress(static_cast<double>(offset + end) / totalCells);
+        }
+      });
 
-  delete[] weights;
+    offset += nCells;
+  }
 
   this->UpdateSubOperationProgress(1.0);
   return center;
@@ -894,7 +1179,9 @@ void vtkKdTree::BuildLocatorInternal()
 
     this->ProgressOffset += this->ProgressScale;
     this->ProgressScale = 0.7;
-    this->DivideRegion(kd, ptarray, nullptr, 0);
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ vtkSMPTools::GetEstimatedNumberOfThreads(),
+                              vtkSMPTools::GetBackend(), true },
+      [&]() { this->DivideRegion(kd, ptarray, nullptr, 0); });
 
     TIMERDONE("Build tree");
 
@@ -1302,9 +1589,31 @@ int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
   int* leftIds = ids;
   int* rightIds = ids ? ids + nleft : nullptr;
 
-  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
+  // The halves of the point array are disjoint, so the halves of a large
+  // region are divided concurrently.
+  auto divideHalves = [&](vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType half = begin; half < end; ++half)
+    {
+      if (half == 0)
+      {
+        this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
+      }
+      else
+      {
+        this->DivideRegion(kd->GetRight(), c1 + nleft * 3, rightIds, level + 1);
+      }
+    }
+  };
 
-  this->DivideRegion(kd->GetRight(), c1 + nleft * 3, rightIds, level + 1);
+  if (kd->GetNumberOfPoints() > KdConcurrentRegionSize)
+  {
+    vtkSMPTools::For(0, 2, 1, divideHalves);
+  }
+  else
+  {
+    divideHalves(0, 2);
+  }
 
   return 0;
 }
@@ -1330,7 +1639,16 @@ void vtkKdTree::DoMedianFind(vtkKdNode* kd, float* c1, int* ids, int dim1, int d
       break;
     }
 
-    midpt = vtkKdTree::Select(dims[dim], c1, ids, npoints, coord);
+    if (npoints > KdLargeRegionSize)
+    {
+      const double range[2] = { kd->GetMinDataBounds()[dims[dim]],
+        kd->GetMaxDataBounds()[dims[dim]] };
+      midpt = SelectLarge(dims[dim], range, c1, ids, npoints, coord);
+    }
+    else
+    {
+      midpt = vtkKdTree::Select(dims[dim], c1, ids, npoints, coord);
+    }
 
     if (midpt == 0)
     {
@@ -1373,8 +1691,16 @@ void vtkKdTree::AddNewRegions(vtkKdNode* kd, float* c1, int midpt, int dim, doub
 
   right->SetNumberOfPoints(nright);
 
-  left->SetDataBounds(c1);
-  right->SetDataBounds(c1 + nleft * 3);
+  if (npoints > KdLargeRegionSize)
+  {
+    SetLargeDataBounds(left, c1);
+    SetLargeDataBounds(right, c1 + nleft * 3);
+  }
+  else
+  {
+    left->SetDataBounds(c1);
+    right->SetDataBounds(c1 + nleft * 3);
+  }
 }
 // Use Floyd & Rivest (1975) to find the median:
 // Given an array X with element indices ranging from L to R, and
@@ -1663,6 +1989,71 @@ void vtkKdTree::BuildRegionList()
   this->RegionList = new vtkKdNode*[this->NumberOfRegions];
 
   this->SelfRegister(this->Top);
+
+  this->BuildFlatTree();
+}
+
+//------------------------------------------------------------------------------
+void vtkKdTree::BuildFlatTree()
+{
+  delete[] this->FlatTree;
+  this->FlatTree = new flatNode_[2 * this->NumberOfRegions - 1];
+
+  // Depth first traversal, with the entry of the cut each right child
+  // belongs to.  The flat tree is only valid if the two children of each cut
+  // tile it: they are the box of their parent, split at the cut.
+
+  std::vector<std::pair<vtkKdNode*, int>> nodes(1, std::make_pair(this->Top, -1));
+  int next = 0;
+
+  while (!nodes.empty())
+  {
+    vtkKdNode* kd = nodes.back().first;
+    int cut = nodes.back().second;
+    nodes.pop_back();
+
+    if (cut >= 0)
+    {
+      this->FlatTree[cut].Next = next;
+    }
+    flatNode_& node = this->FlatTree[next];
+
+    if (kd->GetLeft() == nullptr)
+    {
+      node.Cut = 0.0;
+      node.Dim = -1;
+      node.Next = kd->GetID();
+      next++;
+      continue;
+    }
+
+    vtkKdNode* left = kd->GetLeft();
+    vtkKdNode* right = kd->GetRight();
+    int dim = kd->GetDim();
+    bool tiled = (dim >= 0) && (dim < 3);
+
+    for (int i = 0; tiled && (i < 3); i++)
+    {
+      tiled = (left->GetMinBounds()[i] == kd->GetMinBounds()[i]) &&
+        (right->GetMaxBounds()[i] == kd->GetMaxBounds()[i]) &&
+        ((i == dim) ? (left->GetMaxBounds()[i] == right->GetMinBounds()[i])
+                    : ((left->GetMaxBounds()[i] == kd->GetMaxBounds()[i]) &&
+                        (right->GetMinBounds()[i] == kd->GetMinBounds()[i])));
+    }
+
+    if (!tiled)
+    {
+      delete[] this->FlatTree;
+      this->FlatTree = nullptr;
+      return;
+    }
+
+    node.Cut = left->GetMaxBounds()[dim];
+    node.Dim = dim;
+    nodes.emplace_back(right, next);
+    nodes.emplace_back(left, -1);
+    next++;
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -1814,30 +2205,38 @@ void vtkKdTree::BuildLocatorFromPoints(vtkPoints** ptArrays, int numPtArrays)
       // Hopefully point arrays are usually floats.  This conversion will
       // really slow things down.
 
-      for (vtkIdType ii = 0; ii < npoints; ii++)
-      {
-        double* pt = ptArrays[i]->GetPoint(ii);
+      vtkPoints* ptArray = ptArrays[i];
+      float* ptr = points + ptId;
 
-        points[ptId++] = static_cast<float>(pt[0]);
-        points[ptId++] = static_cast<float>(pt[1]);
-        points[ptId++] = static_cast<float>(pt[2]);
-      }
+      vtkSMPTools::For(0, npoints,
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          double pt[3];
+          for (vtkIdType ii = begin; ii < end; ii++)
+          {
+            ptArray->GetPoint(ii, pt);
+
+            ptr[3 * ii] = static_cast<float>(pt[0]);
+            ptr[3 * ii + 1] = static_cast<float>(pt[1]);
+            ptr[3 * ii + 2] = static_cast<float>(pt[2]);
+          }
+        });
+      ptId += nvals;
     }
   }
 
-  for (ptId = 0; ptId < totalNumPoints; ptId++)
-  {
-    // Select_ dominates DivideRegion algorithm, operating on
-    // ints is much fast than operating on long longs
+  // Select_ dominates DivideRegion algorithm, operating on
+  // ints is much fast than operating on long longs
 
-    ptIds[ptId] = ptId;
-  }
+  std::iota(ptIds, ptIds + totalNumPoints, 0);
 
   TIMERDONE("Set up to build k-d tree");
 
   TIMER("Build tree");
 
-  this->DivideRegion(kd, points, ptIds, 0);
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ vtkSMPTools::GetEstimatedNumberOfThreads(),
+                            vtkSMPTools::GetBackend(), true },
+    [&]() { this->DivideRegion(kd, points, ptIds, 0); });
 
   this->SetActualLevel();
   this->BuildRegionList();
@@ -3083,6 +3482,9 @@ void vtkKdTree::FreeSearchStructure()
   delete[] this->RegionList;
   this->RegionList = nullptr;
 
+  delete[] this->FlatTree;
+  this->FlatTree = nullptr;
+
   this->NumberOfRegions = 0;
   this->SetActualLevel();
 
@@ -4158,14 +4560,15 @@ int* vtkKdTree::AllGetRegionContainingCell()
 
     float* centers = this->ComputeCellCenters(iset);
 
-    float* pt = centers;
-
-    for (int cellId = 0; cellId < setCells; cellId++)
-    {
-      listPtr[cellId] = this->GetRegionContainingPoint(pt[0], pt[1], pt[2]);
-
-      pt += 3;
-    }
+    vtkSMPTools::For(0, setCells,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType cellId = begin; cellId < end; cellId++)
+        {
+          float* pt = centers + 3 * cellId;
+          listPtr[cellId] = this->GetRegionContainingPoint(pt[0], pt[1], pt[2]);
+        }
+      });
 
     listPtr += setCells;
 
@@ -4178,8 +4581,33 @@ int* vtkKdTree::AllGetRegionContainingCell()
 //------------------------------------------------------------------------------
 int vtkKdTree::GetRegionContainingPoint(double x, double y, double z)
 {
+  if (this->FlatTree)
+  {
+    return this->FindFlatRegion(x, y, z);
+  }
   return vtkKdTree::findRegion(this->Top, x, y, z);
 }
+
+//------------------------------------------------------------------------------
+// Same result as findRegion(this->Top, x, y, z), since the children of each
+// cut tile it.
+int vtkKdTree::FindFlatRegion(double x, double y, double z)
+{
+  if (!this->Top->ContainsPoint(x, y, z, 0))
+  {
+    return -1;
+  }
+
+  const double point[3] = { x, y, z };
+  const flatNode_* node = this->FlatTree;
+
+  while (node->Dim >= 0)
+  {
+    node = (point[node->Dim] <= node->Cut) ? node + 1 : this->FlatTree + node->Next;
+  }
+
+  return node->Next;
+}
 //------------------------------------------------------------------------------
 int vtkKdTree::MinimalNumberOfConvexSubRegions(vtkIntArray* regionIdList, double** convexSubRegions)
 {
@@ -4728,6 +5156,7 @@ void vtkKdTree::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Top: " << this->Top << endl;
   os << indent << "RegionList: " << reinterpret_cast<const void*>(this->RegionList) << endl;
+  os << indent << "FlatTree: " << reinterpret_cast<const void*>(this->FlatTree) << endl;
 
   os << indent << "Timing: " << this->Timing << endl;
   os << indent << "TimerLog: " << this->TimerLog << endl;
@@ -34,6 +34,10 @@
  *     tolerance, or you can use FindPoint and FindClosestPoint to
  *     locate points in the original set that the tree was built from.
  *
+ *     The cell centers are computed, the large regions are divided and
+ *     the cells are assigned to the regions in parallel with vtkSMPTools.
+ *     The regions do not depend on the number of threads.
+ *
  * @sa
  *      vtkLocator vtkCellLocator vtkPKdTree
  */
@@ -667,6 +671,7 @@ protected:
   static void DeleteAllDescendants(vtkKdNode* nd);
 
   void BuildRegionList();
+  void BuildFlatTree();
   virtual int SelectCutDirection(vtkKdNode* kd);
   void SetActualLevel() { this->Level = vtkKdTree::ComputeLevel(this->Top); }
 
@@ -862,6 +867,22 @@ protected:
 
   int* CellRegionList;
 
+  // The cuts of the tree in depth first order, so that the region containing
+  // a point is found without following the node pointers.  The left child of
+  // a cut is the next entry.  nullptr if the regions do not tile the bounds
+  // of the tree, in which case findRegion() is used.
+
+  struct flatNode_
+  {
+    double Cut; // upper bound of the left child along Dim
+    int Dim;    // -1 for a leaf
+    int Next;   // entry of the right child, or region ID of a leaf
+  };
+
+  flatNode_* FlatTree;
+
+  int FindFlatRegion(double x, double y, double z);
+
   int MinCells;
   int NumberOfRegions; // number of leaf nodes
 
@@ -53,6 +53,9 @@ public:
    */
   void FindClosestNPoints(int N, const double x[3], vtkIdList* result) override;
 
+  // Reuse any superclass signatures that we don't override.
+  using vtkAbstractPointLocator::FindPointsWithinRadius;
+
   /**
    * Find all points within a specified radius R of position x.
    * The result is not sorted in any specific manner.
@@ -138,6 +138,9 @@ public:
   vtkIdType FindClosestPointInRegion(int regionId, double x, double y, double z, double& dist2);
   ///@}
 
+  // Reuse any superclass signatures that we don't override.
+  using vtkAbstractPointLocator::FindPointsWithinRadius;
+
   /**
    * Find all points within a specified radius of position x.
    * The result is not sorted in any specific manner.
@@ -84,6 +84,7 @@ public:
 
   // Reuse any superclass signatures that we don't override.
   using vtkAbstractPointLocator::FindClosestPoint;
+  using vtkAbstractPointLocator::FindPointsWithinRadius;
 
   /**
    * Given a position x, return the id of the point closest to it. Alternative
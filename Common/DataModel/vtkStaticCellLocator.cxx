@@ -3,6 +3,7 @@
 
 #include "vtkStaticCellLocator.h"
 
+#include "vtkAbstractCellLocator.txx"
 #include "vtkBoundingBox.h"
 #include "vtkBox.h"
 #include "vtkCellArray.h"
@@ -1436,6 +1437,50 @@ int vtkStaticCellLocator::IntersectWithLine(const double p1[3], const double p2[
   return this->Processor->IntersectWithLine(p1, p2, tol, points, cellIds, cell);
 }
 
+//------------------------------------------------------------------------------
+void vtkStaticCellLocator::FindCells(
+  vtkPoints* points, vtkIdList* cellIds, vtkDoubleArray* pcoords, double)
+{
+  this->BuildLocator();
+  vtkCellProcessor* processor = this->Processor;
+  this->BatchFindCells(points, cellIds, pcoords,
+    [processor](double x[3], vtkGenericCell* cell, int& subId, double pc[3], double* weights)
+    { return processor ? processor->FindCell(x, cell, subId, pc, weights) : -1; });
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticCellLocator::FindClosestPoints(
+  vtkPoints* points, vtkPoints* closestPoints, vtkIdList* cellIds, vtkDoubleArray* dist2)
+{
+  this->BuildLocator();
+  vtkCellProcessor* processor = this->Processor;
+  this->BatchFindClosestPoints(points, closestPoints, cellIds, dist2,
+    [processor](double x[3], double closestPoint[3], vtkGenericCell* cell, vtkIdType& cellId,
+      int& subId, double& d2, double*) -> vtkIdType
+    {
+      int inside;
+      return processor ? processor->FindClosestPointWithinRadius(
+                           x, vtkMath::Inf(), closestPoint, cell, cellId, subId, d2, inside)
+                       : 0;
+    });
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticCellLocator::IntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol,
+  vtkIdList* cellIds, vtkPoints* points, vtkDoubleArray* t)
+{
+  this->BuildLocator();
+  vtkCellProcessor* processor = this->Processor;
+  this->BatchIntersectWithLines(p1, p2, tol, cellIds, points, t,
+    [processor](const double a[3], const double b[3], double tolerance, double& tLine,
+      double x[3], double pc[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+    {
+      return processor
+        ? processor->IntersectWithLine(a, b, tolerance, tLine, x, pc, subId, cellId, cell)
+        : 0;
+    });
+}
+
 //------------------------------------------------------------------------------
 bool vtkStaticCellLocator::InsideCellBounds(double x[3], vtkIdType cellId)
 {
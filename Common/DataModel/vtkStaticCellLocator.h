@@ -193,6 +193,18 @@ public:
   vtkIdType FindCell(double x[3], double vtkNotUsed(tol2), vtkGenericCell* GenCell, int& subId,
     double pcoords[3], double* weights) override;
 
+  ///@{
+  /**
+   * Reimplemented to query the bins in parallel, with a single check that the locator is built.
+   */
+  void FindCells(vtkPoints* points, vtkIdList* cellIds, vtkDoubleArray* pcoords = nullptr,
+    double vtkNotUsed(tol2) = 0.0) override;
+  void FindClosestPoints(vtkPoints* points, vtkPoints* closestPoints, vtkIdList* cellIds,
+    vtkDoubleArray* dist2 = nullptr) override;
+  void IntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol, vtkIdList* cellIds,
+    vtkPoints* points = nullptr, vtkDoubleArray* t = nullptr) override;
+  ///@}
+
   /**
    * Quickly test if a point is inside the bounds of a particular cell.
    * This function should be used ONLY after the locator is built.
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkStaticPointLocator.h"
 
+#include "vtkAbstractPointLocator.txx"
 #include "vtkBoundingBox.h"
 #include "vtkBox.h"
 #include "vtkCellArray.h"
@@ -1925,6 +1926,54 @@ void vtkStaticPointLocator::FindPointsWithinRadius(double R, const double x[3],
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::FindClosestPoints(vtkPoints* points, vtkIdList* result)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if (this->Buckets && this->LargeIds)
+  {
+    auto buckets = static_cast<BucketList<vtkIdType>*>(this->Buckets);
+    this->BatchFindClosestPoints(
+      points, result, [buckets](const double x[3]) { return buckets->FindClosestPoint(x); });
+  }
+  else if (this->Buckets)
+  {
+    auto buckets = static_cast<BucketList<int>*>(this->Buckets);
+    this->BatchFindClosestPoints(
+      points, result, [buckets](const double x[3]) { return buckets->FindClosestPoint(x); });
+  }
+  else
+  {
+    this->BatchFindClosestPoints(points, result, [](const double*) -> vtkIdType { return -1; });
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkStaticPointLocator::FindPointsWithinRadius(
+  double R, vtkPoints* points, vtkCellArray* result)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if (this->Buckets && this->LargeIds)
+  {
+    auto buckets = static_cast<BucketList<vtkIdType>*>(this->Buckets);
+    this->BatchFindPointsWithinRadius(R, points, result,
+      [buckets](double radius, const double x[3], vtkIdList* ids)
+      { buckets->FindPointsWithinRadius(radius, x, ids); });
+  }
+  else if (this->Buckets)
+  {
+    auto buckets = static_cast<BucketList<int>*>(this->Buckets);
+    this->BatchFindPointsWithinRadius(R, points, result,
+      [buckets](double radius, const double x[3], vtkIdList* ids)
+      { buckets->FindPointsWithinRadius(radius, x, ids); });
+  }
+  else
+  {
+    this->BatchFindPointsWithinRadius(
+      R, points, result, [](double, const double*, vtkIdList*) {});
+  }
+}
+
 //------------------------------------------------------------------------------
 // This method traverses the locator along the defined ray, finding the
 // closest point to a0 when projected onto the line (a0,a1) (i.e., min
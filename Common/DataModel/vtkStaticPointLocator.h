@@ -175,6 +175,15 @@ public:
    */
   void FindPointsWithinRadius(double R, const double x[3], vtkIdList* result) override;
 
+  ///@{
+  /**
+   * Reimplemented to query the buckets in parallel, with a single check that the locator is
+   * built.
+   */
+  void FindClosestPoints(vtkPoints* points, vtkIdList* result) override;
+  void FindPointsWithinRadius(double R, vtkPoints* points, vtkCellArray* result) override;
+  ///@}
+
   /**
    * Intersect the points contained in the locator with the line defined by
    * (a0,a1). Return the point within the tolerance tol that is closest to a0
@@ -51,6 +51,17 @@ vtkUniformHyperTreeGrid::~vtkUniformHyperTreeGrid() = default;
 //------------------------------------------------------------------------------
 vtkHyperTree* vtkUniformHyperTreeGrid::GetTree(vtkIdType index, bool create)
 {
+  // Trees are added to the default storage
+  if (this->HasCompactTrees())
+  {
+    vtkHyperTree* tree = this->GetCompactTree(index);
+    if (tree || !create)
+    {
+      return tree;
+    }
+    this->ExpandTrees();
+  }
+
   // Wrap convenience macro for outside use
   vtkHyperTree* tree = GetHyperTreeFromThisMacro(index);
 
@@ -65,18 +76,24 @@ vtkHyperTree* vtkUniformHyperTreeGrid::GetTree(vtkIdType index, bool create)
 
     if (!tree->HasScales())
     {
-      if (!this->Scales)
-      {
-        this->Scales =
-          std::make_shared<vtkHyperTreeGridScales>(this->BranchFactor, this->GridScale);
-      }
-      tree->SetScales(this->Scales);
+      tree->SetScales(this->GetTreeScales(index));
     }
   }
 
   return tree;
 }
 
+//------------------------------------------------------------------------------
+std::shared_ptr<vtkHyperTreeGridScales> vtkUniformHyperTreeGrid::GetTreeScales(vtkIdType)
+{
+  // All the trees have the same scales
+  if (!this->Scales)
+  {
+    this->Scales = std::make_shared<vtkHyperTreeGridScales>(this->BranchFactor, this->GridScale);
+  }
+  return this->Scales;
+}
+
 //------------------------------------------------------------------------------
 void vtkUniformHyperTreeGrid::PrintSelf(ostream& os, vtkIndent indent)
 {
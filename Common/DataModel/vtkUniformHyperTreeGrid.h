@@ -204,6 +204,11 @@ protected:
     return this->FindDichotomic(value, 2, tolerance);
   }
 
+  /**
+   * Return the per-level scales shared by all the trees.
+   */
+  std::shared_ptr<vtkHyperTreeGridScales> GetTreeScales(vtkIdType index) override;
+
   /**
    * Storage of pre-computed per-level cell scales
    */
@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that the threaded mode of vtkCleanPolyData produces exactly the same
+// output as the serial mode when the tolerance is zero.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCleanPolyData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+constexpr int Resolution = 60;
+
+// Every quad of a grid has its own points, so most points are duplicated.
+// Some cells are made degenerate on purpose, and all cell types are present.
+void CreateInput(vtkPolyData* polyData, int dataType, bool ghosts)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataType(dataType);
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkCellArray> strips;
+
+  auto addPoint = [&](int i, int j) { return points->InsertNextPoint(0.1 * i, 0.1 * j, 0.0); };
+
+  for (int j = 0; j < Resolution; ++j)
+  {
+    for (int i = 0; i < Resolution; ++i)
+    {
+      vtkIdType quad[4] = { addPoint(i, j), addPoint(i + 1, j), addPoint(i + 1, j + 1),
+        addPoint(i, j + 1) };
+      switch ((i + j) % 7)
+      {
+        case 0: // degenerate quad -> triangle
+          quad[2] = addPoint(i + 1, j);
+          polys->InsertNextCell(4, quad);
+          break;
+        case 1: // degenerate triangle -> line
+        {
+          vtkIdType tri[3] = { quad[0], quad[1], addPoint(i, j) };
+          polys->InsertNextCell(3, tri);
+          break;
+        }
+        case 2: // triangle strip, possibly degenerate
+        {
+          vtkIdType strip[5] = { quad[0], quad[1], quad[3], quad[2], addPoint(i, j) };
+          strips->InsertNextCell((i % 2) ? 5 : 4, strip);
+          break;
+        }
+        case 3: // line with a degenerate segment, and a fully degenerate line
+        {
+          vtkIdType line[3] = { quad[0], addPoint(i, j), quad[2] };
+          lines->InsertNextCell(3, line);
+          vtkIdType point[2] = { quad[1], addPoint(i + 1, j) };
+          lines->InsertNextCell(2, point);
+          break;
+        }
+        case 4: // poly vertex with duplicated points
+        {
+          vtkIdType poly[3] = { quad[0], addPoint(i, j), quad[3] };
+          verts->InsertNextCell(3, poly);
+          break;
+        }
+        default:
+          polys->InsertNextCell(4, quad);
+          break;
+      }
+    }
+  }
+  // A point used by no cell
+  addPoint(-1, -1);
+
+  polyData->SetPoints(points);
+  polyData->SetVerts(verts);
+  polyData->SetLines(lines);
+  polyData->SetPolys(polys);
+  polyData->SetStrips(strips);
+
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  vtkNew<vtkIntArray> pointIds;
+  pointIds->SetName("PointIds");
+  pointIds->SetNumberOfValues(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    pointIds->SetValue(ptId, static_cast<int>(ptId));
+  }
+  polyData->GetPointData()->SetScalars(pointIds);
+
+  const vtkIdType numCells = polyData->GetNumberOfCells();
+  vtkNew<vtkDoubleArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfValues(numCells);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    cellIds->SetValue(cellId, static_cast<double>(cellId));
+  }
+  polyData->GetCellData()->AddArray(cellIds);
+
+  if (ghosts)
+  {
+    vtkNew<vtkUnsignedCharArray> ghostArray;
+    ghostArray->SetName(vtkDataSetAttributes::GhostArrayName());
+    ghostArray->SetNumberOfValues(numPts);
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+      ghostArray->SetValue(ptId, (ptId % 3) ? 0 : vtkDataSetAttributes::DUPLICATEPOINT);
+    }
+    polyData->GetPointData()->AddArray(ghostArray);
+  }
+}
+
+bool TestConfiguration(int dataType, bool ghosts, bool merging, bool conversions, int precision)
+{
+  vtkNew<vtkPolyData> input;
+  CreateInput(input, dataType, ghosts);
+
+  vtkNew<vtkCleanPolyData> serial;
+  serial->SetInputData(input);
+  serial->SetPointMerging(merging);
+  serial->SetConvertLinesToPoints(conversions);
+  serial->SetConvertPolysToLines(conversions);
+  serial->SetConvertStripsToPolys(conversions);
+  serial->SetOutputPointsPrecision(precision);
+  serial->Update();
+
+  vtkNew<vtkCleanPolyData> threaded;
+  threaded->SetInputData(input);
+  threaded->SetPointMerging(merging);
+  threaded->SetConvertLinesToPoints(conversions);
+  threaded->SetConvertPolysToLines(conversions);
+  threaded->SetConvertStripsToPolys(conversions);
+  threaded->SetOutputPointsPrecision(precision);
+  threaded->ThreadedMergingOn();
+  threaded->Update();
+
+  if (serial->GetOutput()->GetPoints()->GetDataType() !=
+      threaded->GetOutput()->GetPoints()->GetDataType() ||
+    !vtkTestUtilities::CompareDataObjects(serial->GetOutput(), threaded->GetOutput()))
+  {
+    std::cerr << "With data type " << dataType << ", ghosts " << ghosts << ", merging "
+              << merging << ", conversions " << conversions << ", precision " << precision
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestCleanPolyDataThreaded(int, char*[])
+{
+  bool status = true;
+  for (int dataType : { VTK_FLOAT, VTK_DOUBLE })
+  {
+    for (bool ghosts : { false, true })
+    {
+      for (bool merging : { true, false })
+      {
+        for (bool conversions : { true, false })
+        {
+          status &= TestConfiguration(
+            dataType, ghosts, merging, conversions, vtkAlgorithm::DEFAULT_PRECISION);
+        }
+      }
+    }
+    status &= TestConfiguration(dataType, false, true, true, vtkAlgorithm::SINGLE_PRECISION);
+    status &= TestConfiguration(dataType, false, true, true, vtkAlgorithm::DOUBLE_PRECISION);
+  }
+
+  // With a non-zero tolerance the merging may differ from the serial
+  // algorithm, but here the tolerance is smaller than the grid spacing.
+  vtkNew<vtkPolyData> input;
+  CreateInput(input, VTK_DOUBLE, false);
+  vtkNew<vtkCleanPolyData> serial;
+  serial->SetInputData(input);
+  serial->Update();
+  vtkNew<vtkCleanPolyData> threaded;
+  threaded->SetInputData(input);
+  threaded->ToleranceIsAbsoluteOn();
+  threaded->SetAbsoluteTolerance(1e-3);
+  threaded->ThreadedMergingOn();
+  threaded->Update();
+  if (threaded->GetOutput()->GetNumberOfPoints() != serial->GetOutput()->GetNumberOfPoints())
+  {
+    std::cerr << "Wrong number of points with a non-zero tolerance: "
+              << threaded->GetOutput()->GetNumberOfPoints() << std::endl;
+    status = false;
+  }
+
+  return status ? EXIT_SUCCESS : EXIT_FAILURE;
+}
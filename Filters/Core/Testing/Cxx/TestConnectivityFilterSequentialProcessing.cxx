@@ -0,0 +1,224 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that vtkConnectivityFilter and vtkPolyDataConnectivityFilter produce
+// exactly the same output with and without SequentialProcessing.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkConnectivityFilter.h"
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataConnectivityFilter.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+constexpr vtkIdType NumberOfClusters = 500;
+constexpr vtkIdType PointsPerCluster = 40;
+constexpr vtkIdType NumberOfTriangles = 20000;
+
+// Triangles connecting random points of random clusters, in random order,
+// so that there are many regions of various sizes whose cells are spread
+// out. A few vertices are added, and some points are not used.
+void CreateInput(vtkPolyData* polyData)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  auto randomId = [&](vtkIdType max)
+  {
+    random->Next();
+    return static_cast<vtkIdType>(random->GetValue() * max) % max;
+  };
+
+  const vtkIdType numPts = NumberOfClusters * PointsPerCluster;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    random->Next();
+    const double x = random->GetValue();
+    random->Next();
+    points->SetPoint(ptId, x, random->GetValue(), static_cast<double>(ptId / PointsPerCluster));
+  }
+
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkCellArray> verts;
+  for (vtkIdType i = 0; i < NumberOfTriangles; ++i)
+  {
+    // Small clusters get fewer triangles
+    const vtkIdType cluster = randomId(randomId(NumberOfClusters) + 1);
+    const vtkIdType size = 1 + cluster % PointsPerCluster;
+    vtkIdType tri[3];
+    for (vtkIdType& ptId : tri)
+    {
+      ptId = cluster * PointsPerCluster + randomId(size);
+    }
+    polys->InsertNextCell(3, tri);
+    if (i % 100 == 0)
+    {
+      const vtkIdType vertex = randomId(numPts);
+      verts->InsertNextCell(1, &vertex);
+    }
+  }
+  polyData->SetPoints(points);
+  polyData->SetPolys(polys);
+  polyData->SetVerts(verts);
+
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  pointIds->SetNumberOfValues(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    pointIds->SetValue(ptId, ptId);
+  }
+  polyData->GetPointData()->AddArray(pointIds);
+}
+
+// When some input points or cells are not extracted, the filters leave the
+// RegionId arrays sized to the input, with unset values past the output
+// points. Those cannot be compared point by point, so drop them. Compression
+// is turned off because it would read these unset values.
+void RemoveInputSizedRegionIds(vtkDataSet* output)
+{
+  vtkDataArray* pointIds = output->GetPointData()->GetArray("RegionId");
+  if (pointIds && pointIds->GetNumberOfTuples() != output->GetNumberOfPoints())
+  {
+    output->GetPointData()->RemoveArray("RegionId");
+  }
+  vtkDataArray* cellIds = output->GetCellData()->GetArray("RegionId");
+  if (cellIds && cellIds->GetNumberOfTuples() != output->GetNumberOfCells())
+  {
+    output->GetCellData()->RemoveArray("RegionId");
+  }
+}
+
+bool SameOutput(vtkDataSet* a, vtkDataSet* b)
+{
+  RemoveInputSizedRegionIds(a);
+  RemoveInputSizedRegionIds(b);
+  return vtkTestUtilities::CompareDataObjects(a, b);
+}
+
+bool SameRegionSizes(vtkIdTypeArray* a, vtkIdTypeArray* b)
+{
+  if (a->GetNumberOfValues() != b->GetNumberOfValues())
+  {
+    std::cerr << "Different number of regions: " << a->GetNumberOfValues() << " vs "
+              << b->GetNumberOfValues() << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    if (a->GetValue(i) != b->GetValue(i))
+    {
+      std::cerr << "Different size for region " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestPolyDataConnectivity(vtkPolyData* input, int mode)
+{
+  vtkNew<vtkPolyDataConnectivityFilter> sequential;
+  sequential->SetInputData(input);
+  sequential->SetExtractionMode(mode);
+  sequential->AddSpecifiedRegion(3);
+  sequential->AddSpecifiedRegion(17);
+  sequential->ColorRegionsOn();
+  sequential->SequentialProcessingOn();
+  sequential->Update();
+
+  vtkNew<vtkPolyDataConnectivityFilter> threaded;
+  threaded->SetInputData(input);
+  threaded->SetExtractionMode(mode);
+  threaded->AddSpecifiedRegion(3);
+  threaded->AddSpecifiedRegion(17);
+  threaded->ColorRegionsOn();
+  threaded->Update();
+
+  if (!SameOutput(sequential->GetOutput(), threaded->GetOutput()) ||
+    !SameRegionSizes(sequential->GetRegionSizes(), threaded->GetRegionSizes()))
+  {
+    std::cerr << "vtkPolyDataConnectivityFilter with mode "
+              << sequential->GetExtractionModeAsString() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool TestConnectivity(vtkDataSet* input, int mode, int assignmentMode)
+{
+  vtkNew<vtkConnectivityFilter> sequential;
+  sequential->SetInputData(input);
+  sequential->SetExtractionMode(mode);
+  sequential->AddSpecifiedRegion(3);
+  sequential->AddSpecifiedRegion(17);
+  sequential->ColorRegionsOn();
+  sequential->SetRegionIdAssignmentMode(assignmentMode);
+  sequential->CompressArraysOff();
+  sequential->SequentialProcessingOn();
+  sequential->Update();
+
+  vtkNew<vtkConnectivityFilter> threaded;
+  threaded->SetInputData(input);
+  threaded->SetExtractionMode(mode);
+  threaded->AddSpecifiedRegion(3);
+  threaded->AddSpecifiedRegion(17);
+  threaded->ColorRegionsOn();
+  threaded->SetRegionIdAssignmentMode(assignmentMode);
+  threaded->CompressArraysOff();
+  threaded->Update();
+
+  if (!SameOutput(sequential->GetOutput(), threaded->GetOutput()) ||
+    sequential->GetNumberOfExtractedRegions() != threaded->GetNumberOfExtractedRegions())
+  {
+    std::cerr << "vtkConnectivityFilter with " << input->GetClassName() << " input, mode "
+              << sequential->GetExtractionModeAsString() << ", assignment mode " << assignmentMode
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestConnectivityFilterSequentialProcessing(int, char*[])
+{
+  vtkNew<vtkPolyData> polyData;
+  CreateInput(polyData);
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(polyData->GetPoints());
+  grid->GetPointData()->ShallowCopy(polyData->GetPointData());
+  grid->Allocate(polyData->GetNumberOfCells());
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < polyData->GetNumberOfCells(); ++cellId)
+  {
+    polyData->GetCellPoints(cellId, ptIds);
+    grid->InsertNextCell(polyData->GetCellType(cellId), ptIds);
+  }
+
+  bool status = true;
+  for (int mode : { VTK_EXTRACT_LARGEST_REGION, VTK_EXTRACT_ALL_REGIONS,
+         VTK_EXTRACT_SPECIFIED_REGIONS })
+  {
+    status &= TestPolyDataConnectivity(polyData, mode);
+    for (int assignmentMode : { vtkConnectivityFilter::UNSPECIFIED,
+           vtkConnectivityFilter::CELL_COUNT_DESCENDING })
+    {
+      status &= TestConnectivity(polyData, mode, assignmentMode);
+      status &= TestConnectivity(grid, mode, assignmentMode);
+    }
+  }
+  return status ? EXIT_SUCCESS : EXIT_FAILURE;
+}
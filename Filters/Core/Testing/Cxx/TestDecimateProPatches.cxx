@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Compare the patch decimation of vtkDecimatePro to the sequential
+// algorithm: timings are reported, triangle counts and surface errors are
+// checked.
+
+#include "vtkDecimatePro.h"
+#include "vtkGenericCell.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSphereSource.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+// Largest distance from the input points to the decimated surface
+double SurfaceError(vtkPolyData* input, vtkPolyData* decimated)
+{
+  vtkNew<vtkStaticCellLocator> locator;
+  locator->SetDataSet(decimated);
+  locator->BuildLocator();
+  vtkNew<vtkGenericCell> cell;
+  double maxDist2 = 0.0;
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], closest[3], dist2;
+    vtkIdType cellId;
+    int subId;
+    input->GetPoint(ptId, x);
+    locator->FindClosestPoint(x, closest, cell, cellId, subId, dist2);
+    maxDist2 = std::max(maxDist2, dist2);
+  }
+  return std::sqrt(maxDist2);
+}
+
+bool TestReduction(vtkPolyData* input, double reduction, int numPatches)
+{
+  vtkNew<vtkTimerLog> timer;
+  const vtkIdType numTris = input->GetNumberOfPolys();
+
+  vtkNew<vtkDecimatePro> sequential;
+  sequential->SetInputData(input);
+  sequential->SetTargetReduction(reduction);
+  sequential->PreserveTopologyOff();
+  timer->StartTimer();
+  sequential->Update();
+  timer->StopTimer();
+  const double sequentialTime = timer->GetElapsedTime();
+
+  vtkNew<vtkDecimatePro> patches;
+  patches->SetInputData(input);
+  patches->SetTargetReduction(reduction);
+  patches->PreserveTopologyOff();
+  patches->PatchDecimationOn();
+  patches->SetNumberOfPatches(numPatches);
+  timer->StartTimer();
+  patches->Update();
+  timer->StopTimer();
+  const double patchesTime = timer->GetElapsedTime();
+
+  vtkPolyData* sequentialOutput = sequential->GetOutput();
+  vtkPolyData* patchesOutput = patches->GetOutput();
+  const double sequentialError = SurfaceError(input, sequentialOutput);
+  const double patchesError = SurfaceError(input, patchesOutput);
+  std::cout << "Reduction " << reduction << " of " << numTris << " triangles with "
+            << numPatches << " patches:\n  sequential " << sequentialTime << " s, "
+            << sequentialOutput->GetNumberOfPolys() << " triangles, error " << sequentialError
+            << "\n  patches " << patchesTime << " s, " << patchesOutput->GetNumberOfPolys()
+            << " triangles, error " << patchesError << "\n";
+
+  // The reduction is guaranteed in both cases; triangles are removed by two
+  // (or one on boundaries) so the counts may slightly differ.
+  const vtkIdType target = static_cast<vtkIdType>(numTris * (1.0 - reduction));
+  if (std::abs(patchesOutput->GetNumberOfPolys() - sequentialOutput->GetNumberOfPolys()) > 4 ||
+    patchesOutput->GetNumberOfPolys() > target + 4)
+  {
+    std::cerr << "Error: wrong number of triangles with patch decimation." << std::endl;
+    return false;
+  }
+  if (patchesOutput->GetPointData()->GetNumberOfArrays() !=
+    sequentialOutput->GetPointData()->GetNumberOfArrays())
+  {
+    std::cerr << "Error: wrong point data with patch decimation." << std::endl;
+    return false;
+  }
+
+  // Decimation order differs, but the error must remain of the same order.
+  if (patchesError > 2.0 * sequentialError + 1e-3 * input->GetLength())
+  {
+    std::cerr << "Error: surface error too large with patch decimation." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestDecimateProPatches(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(300);
+  sphere->SetPhiResolution(150);
+  sphere->Update();
+
+  const int numPatches = std::max(4, vtkSMPTools::GetEstimatedNumberOfThreads());
+  bool status = true;
+  for (double reduction : { 0.5, 0.9 })
+  {
+    status &= TestReduction(sphere->GetOutput(), reduction, numPatches);
+  }
+  return status ? EXIT_SUCCESS : EXIT_FAILURE;
+}
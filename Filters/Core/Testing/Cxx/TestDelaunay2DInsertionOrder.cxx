@@ -0,0 +1,168 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that vtkDelaunay2D produces the same triangulation with and without
+// the biased randomized insertion order, and that constraint edges are
+// honored. Timings are reported.
+
+#include "vtkCellArray.h"
+#include "vtkDelaunay2D.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <utility>
+
+namespace
+{
+constexpr vtkIdType NumberOfPoints = 100000;
+constexpr vtkIdType NumberOfLoopPoints = 64;
+
+// Triangles are compared as a set, independently of their order and of the
+// order of their points.
+std::set<std::array<vtkIdType, 3>> GetTriangles(vtkPolyData* polyData)
+{
+  std::set<std::array<vtkIdType, 3>> triangles;
+  vtkNew<vtkIdList> ptIds;
+  vtkCellArray* polys = polyData->GetPolys();
+  for (vtkIdType cellId = 0; cellId < polys->GetNumberOfCells(); ++cellId)
+  {
+    polys->GetCellAtId(cellId, ptIds);
+    std::array<vtkIdType, 3> key = { ptIds->GetId(0), ptIds->GetId(1), ptIds->GetId(2) };
+    std::sort(key.begin(), key.end());
+    triangles.insert(key);
+  }
+  return triangles;
+}
+
+bool HasEdge(vtkPolyData* polyData, vtkIdType p1, vtkIdType p2)
+{
+  vtkNew<vtkIdList> cells;
+  polyData->GetPointCells(p1, cells);
+  for (vtkIdType i = 0; i < cells->GetNumberOfIds(); ++i)
+  {
+    if (polyData->IsPointUsedByCell(p2, cells->GetId(i)))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool TestConfiguration(vtkPolyData* input, vtkPolyData* source, double alpha)
+{
+  vtkNew<vtkTimerLog> timer;
+
+  vtkNew<vtkDelaunay2D> inputOrder;
+  inputOrder->SetInputData(input);
+  inputOrder->SetSourceData(source);
+  inputOrder->SetAlpha(alpha);
+  timer->StartTimer();
+  inputOrder->Update();
+  timer->StopTimer();
+  const double inputOrderTime = timer->GetElapsedTime();
+
+  vtkNew<vtkDelaunay2D> brio;
+  brio->SetInputData(input);
+  brio->SetSourceData(source);
+  brio->SetAlpha(alpha);
+  brio->BiasedRandomizedInsertionOn();
+  timer->StartTimer();
+  brio->Update();
+  timer->StopTimer();
+  const double brioTime = timer->GetElapsedTime();
+
+  vtkPolyData* expected = inputOrder->GetOutput();
+  vtkPolyData* result = brio->GetOutput();
+  std::cout << "Alpha " << alpha << ", constrained " << (source != nullptr) << ": input order "
+            << inputOrderTime << " s, biased randomized order " << brioTime << " s, "
+            << result->GetNumberOfPolys() << " triangles\n";
+
+  if (expected->GetNumberOfPolys() != result->GetNumberOfPolys() ||
+    expected->GetNumberOfLines() != result->GetNumberOfLines() ||
+    expected->GetNumberOfVerts() != result->GetNumberOfVerts())
+  {
+    std::cerr << "Error: different number of cells with alpha " << alpha << ": "
+              << expected->GetNumberOfPolys() << " vs " << result->GetNumberOfPolys()
+              << " triangles" << std::endl;
+    return false;
+  }
+
+  if (!source)
+  {
+    // Random points are in general position, so the triangulation is unique.
+    if (GetTriangles(expected) != GetTriangles(result))
+    {
+      std::cerr << "Error: different triangulations with alpha " << alpha << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  // The loop edges must be in the output
+  result->BuildLinks();
+  for (vtkIdType i = 0; i < NumberOfLoopPoints; ++i)
+  {
+    const vtkIdType p1 = NumberOfPoints + i;
+    const vtkIdType p2 = NumberOfPoints + (i + 1) % NumberOfLoopPoints;
+    if (!HasEdge(result, p1, p2))
+    {
+      std::cerr << "Error: constraint edge (" << p1 << ", " << p2 << ") is missing" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestDelaunay2DInsertionOrder(int, char*[])
+{
+  // Random terrain points, followed by a circular loop of points used as a
+  // constraint.
+  vtkNew<vtkMinimalStandardRandomSequence> randomSequence;
+  randomSequence->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  points->SetDataType(VTK_DOUBLE);
+  points->SetNumberOfPoints(NumberOfPoints + NumberOfLoopPoints);
+  for (vtkIdType ptId = 0; ptId < NumberOfPoints; ++ptId)
+  {
+    double x[3];
+    for (int i = 0; i < 2; ++i)
+    {
+      randomSequence->Next();
+      x[i] = randomSequence->GetValue();
+    }
+    x[2] = 0.1 * std::sin(10.0 * x[0]) * std::cos(10.0 * x[1]);
+    points->SetPoint(ptId, x);
+  }
+  vtkNew<vtkCellArray> loop;
+  loop->InsertNextCell(NumberOfLoopPoints);
+  for (vtkIdType i = 0; i < NumberOfLoopPoints; ++i)
+  {
+    const double angle = 2.0 * vtkMath::Pi() * i / NumberOfLoopPoints;
+    points->SetPoint(NumberOfPoints + i, 0.5 + 0.3 * std::cos(angle),
+      0.5 + 0.3 * std::sin(angle), 0.0);
+    loop->InsertCellPoint(NumberOfPoints + i);
+  }
+
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  vtkNew<vtkPolyData> source;
+  source->SetPoints(points);
+  source->SetPolys(loop);
+
+  bool status = true;
+  status &= TestConfiguration(input, nullptr, 0.0);
+  status &= TestConfiguration(input, nullptr, 0.01);
+  status &= TestConfiguration(input, source, 0.0);
+  return status ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that vtkDelaunay3D produces the same triangulation with and without
+// the biased randomized insertion order. Timings are reported.
+
+#include "vtkCellArray.h"
+#include "vtkDelaunay3D.h"
+#include "vtkIdList.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <utility>
+
+namespace
+{
+using CellKey = std::pair<int, std::array<vtkIdType, 4>>;
+
+// Cells are compared as a set, independently of their order and of the
+// order of their points.
+std::set<CellKey> GetCells(vtkUnstructuredGrid* grid)
+{
+  std::set<CellKey> cells;
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    grid->GetCellPoints(cellId, ptIds);
+    std::array<vtkIdType, 4> key = { -1, -1, -1, -1 };
+    std::copy(ptIds->begin(), ptIds->end(), key.begin());
+    std::sort(key.begin(), key.begin() + ptIds->GetNumberOfIds());
+    cells.insert(CellKey(grid->GetCellType(cellId), key));
+  }
+  return cells;
+}
+
+bool TestConfiguration(vtkPolyData* input, double alpha, bool boundingTriangulation)
+{
+  vtkNew<vtkTimerLog> timer;
+
+  vtkNew<vtkDelaunay3D> inputOrder;
+  inputOrder->SetInputData(input);
+  inputOrder->SetAlpha(alpha);
+  inputOrder->SetBoundingTriangulation(boundingTriangulation);
+  timer->StartTimer();
+  inputOrder->Update();
+  timer->StopTimer();
+  const double inputOrderTime = timer->GetElapsedTime();
+
+  vtkNew<vtkDelaunay3D> brio;
+  brio->SetInputData(input);
+  brio->SetAlpha(alpha);
+  brio->SetBoundingTriangulation(boundingTriangulation);
+  brio->BiasedRandomizedInsertionOn();
+  timer->StartTimer();
+  brio->Update();
+  timer->StopTimer();
+  const double brioTime = timer->GetElapsedTime();
+
+  vtkUnstructuredGrid* expected = inputOrder->GetOutput();
+  vtkUnstructuredGrid* result = brio->GetOutput();
+  std::cout << "Alpha " << alpha << ", bounding triangulation " << boundingTriangulation
+            << ": input order " << inputOrderTime << " s, biased randomized order " << brioTime
+            << " s, " << result->GetNumberOfCells() << " cells\n";
+
+  if (expected->GetNumberOfPoints() != result->GetNumberOfPoints() ||
+    expected->GetNumberOfCells() != result->GetNumberOfCells() ||
+    GetCells(expected) != GetCells(result))
+  {
+    std::cerr << "Error: different triangulations with alpha " << alpha
+              << " and bounding triangulation " << boundingTriangulation << ": "
+              << expected->GetNumberOfCells() << " vs " << result->GetNumberOfCells()
+              << " cells" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestDelaunay3DInsertionOrder(int, char*[])
+{
+  // Random points are in general position, so the triangulation is unique.
+  vtkNew<vtkMinimalStandardRandomSequence> randomSequence;
+  randomSequence->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  points->SetDataType(VTK_DOUBLE);
+  constexpr vtkIdType numPts = 20000;
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    double x[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      randomSequence->Next();
+      x[i] = randomSequence->GetValue();
+    }
+    points->SetPoint(ptId, x);
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+
+  bool status = true;
+  status &= TestConfiguration(input, 0.0, false);
+  status &= TestConfiguration(input, 0.0, true);
+  status &= TestConfiguration(input, 0.05, false);
+  return status ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that vtkQuadricDecimation produces exactly the same output with and
+// without SequentialProcessing.
+
+#include "vtkCellArray.h"
+#include "vtkCommand.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricDecimation.h"
+#include "vtkSphereSource.h"
+#include "vtkTestErrorObserver.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+bool SameOutput(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfPolys() != b->GetNumberOfPolys())
+  {
+    std::cerr << "Different sizes: " << a->GetNumberOfPoints() << "/" << a->GetNumberOfPolys()
+              << " vs " << b->GetNumberOfPoints() << "/" << b->GetNumberOfPolys() << std::endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < a->GetNumberOfPoints(); ++ptId)
+  {
+    double xA[3], xB[3];
+    a->GetPoint(ptId, xA);
+    b->GetPoint(ptId, xB);
+    if (xA[0] != xB[0] || xA[1] != xB[1] || xA[2] != xB[2])
+    {
+      std::cerr << "Different coordinates for point " << ptId << std::endl;
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> idsA;
+  vtkNew<vtkIdList> idsB;
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfPolys(); ++cellId)
+  {
+    a->GetPolys()->GetCellAtId(cellId, idsA);
+    b->GetPolys()->GetCellAtId(cellId, idsB);
+    for (vtkIdType i = 0; i < 3; ++i)
+    {
+      if (idsA->GetId(i) != idsB->GetId(i))
+      {
+        std::cerr << "Different point ids for triangle " << cellId << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool TestConfiguration(vtkPolyData* input, bool attributes, bool volume, bool regularize)
+{
+  vtkNew<vtkQuadricDecimation> sequential;
+  sequential->SetInputData(input);
+  sequential->SetTargetReduction(0.8);
+  sequential->SetAttributeErrorMetric(attributes);
+  sequential->SetVolumePreservation(volume);
+  sequential->SetRegularize(regularize);
+  sequential->SequentialProcessingOn();
+  vtkNew<vtkTest::ErrorObserver> sequentialErrors;
+  sequential->AddObserver(vtkCommand::ErrorEvent, sequentialErrors);
+  sequential->Update();
+
+  vtkNew<vtkQuadricDecimation> threaded;
+  threaded->SetInputData(input);
+  threaded->SetTargetReduction(0.8);
+  threaded->SetAttributeErrorMetric(attributes);
+  threaded->SetVolumePreservation(volume);
+  threaded->SetRegularize(regularize);
+  vtkNew<vtkTest::ErrorObserver> threadedErrors;
+  threaded->AddObserver(vtkCommand::ErrorEvent, threadedErrors);
+  threaded->Update();
+
+  if (!SameOutput(sequential->GetOutput(), threaded->GetOutput()) ||
+    sequential->GetActualReduction() != threaded->GetActualReduction() ||
+    sequentialErrors->GetError() != threadedErrors->GetError())
+  {
+    std::cerr << "With attributes " << attributes << ", volume " << volume << ", regularize "
+              << regularize << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestQuadricDecimationSequentialProcessing(int, char*[])
+{
+  // An open sphere, so that there are boundary constraints as well
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(120);
+  sphere->SetPhiResolution(120);
+  sphere->SetStartTheta(20.0);
+  sphere->SetEndTheta(300.0);
+  sphere->Update();
+
+  vtkNew<vtkPolyData> input;
+  input->ShallowCopy(sphere->GetOutput());
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfValues(numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    double x[3];
+    input->GetPoint(ptId, x);
+    scalars->SetValue(ptId, std::sin(5.0 * x[0]) * std::cos(3.0 * x[1]));
+  }
+  input->GetPointData()->SetScalars(scalars);
+
+  bool status = true;
+  for (bool attributes : { false, true })
+  {
+    for (bool volume : { false, true })
+    {
+      for (bool regularize : { false, true })
+      {
+        status &= TestConfiguration(input, attributes, volume, regularize);
+      }
+    }
+  }
+
+  // Degenerate faces, whose attribute matrix cannot be factored, in the
+  // middle of the others: they get the attribute quadric of the previous face
+  // that could be factored, whatever the mode.
+  vtkNew<vtkPolyData> degenerate;
+  degenerate->DeepCopy(input);
+  vtkDoubleArray* degenerateScalars =
+    vtkDoubleArray::SafeDownCast(degenerate->GetPointData()->GetScalars());
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkIdList> ids;
+  const vtkIdType numPolys = input->GetNumberOfPolys();
+  for (vtkIdType cellId = 0; cellId < numPolys; ++cellId)
+  {
+    input->GetPolys()->GetCellAtId(cellId, ids);
+    polys->InsertNextCell(ids);
+    if (cellId % 1000 == 500)
+    {
+      // A flat triangle on the first edge of the face
+      double x0[3], x1[3];
+      input->GetPoint(ids->GetId(0), x0);
+      input->GetPoint(ids->GetId(1), x1);
+      const vtkIdType middle = degenerate->GetPoints()->InsertNextPoint(
+        (x0[0] + x1[0]) / 2.0, (x0[1] + x1[1]) / 2.0, (x0[2] + x1[2]) / 2.0);
+      degenerateScalars->InsertNextValue(
+        (scalars->GetValue(ids->GetId(0)) + scalars->GetValue(ids->GetId(1))) / 2.0);
+      const vtkIdType flat[3] = { ids->GetId(0), middle, ids->GetId(1) };
+      polys->InsertNextCell(3, flat);
+    }
+  }
+  degenerate->SetPolys(polys);
+  status &= TestConfiguration(degenerate, true, false, false);
+
+  return status ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check the threaded iterations of vtkSmoothPolyDataFilter against Jacobi
+// iterations computed here, and the threaded constrained smoothing.
+
+#include "vtkCellArray.h"
+#include "vtkGenericCell.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmoothPolyDataFilter.h"
+#include "vtkSphereSource.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <vector>
+
+namespace
+{
+constexpr int NumberOfIterations = 50;
+constexpr double RelaxationFactor = 0.1;
+
+// A closed sphere with some radial noise
+void CreateInput(vtkPolyData* input)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(200);
+  sphere->SetPhiResolution(100);
+  sphere->Update();
+  input->DeepCopy(sphere->GetOutput());
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkPoints* points = input->GetPoints();
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    points->GetPoint(ptId, x);
+    const double scale = random->GetNextRangeValue(0.95, 1.05);
+    points->SetPoint(ptId, x[0] * scale, x[1] * scale, x[2] * scale);
+  }
+}
+
+// Jacobi iterations on the edge neighbors: every vertex of a closed sphere
+// without feature edges is a simple vertex.
+std::vector<double> JacobiSmoothing(vtkPolyData* input)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  std::vector<std::set<vtkIdType>> neighbors(numPts);
+  vtkNew<vtkIdList> ids;
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfPolys(); ++cellId)
+  {
+    input->GetPolys()->GetCellAtId(cellId, ids);
+    for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i)
+    {
+      const vtkIdType p1 = ids->GetId(i);
+      const vtkIdType p2 = ids->GetId((i + 1) % ids->GetNumberOfIds());
+      if (p1 != p2)
+      {
+        neighbors[p1].insert(p2);
+        neighbors[p2].insert(p1);
+      }
+    }
+  }
+
+  std::vector<double> current(3 * numPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    input->GetPoint(ptId, current.data() + 3 * ptId);
+  }
+  std::vector<double> next(current);
+  for (int iteration = 0; iteration < NumberOfIterations; ++iteration)
+  {
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+      const double n = static_cast<double>(neighbors[ptId].size());
+      for (int k = 0; k < 3; ++k)
+      {
+        double mean = 0.0;
+        for (vtkIdType nei : neighbors[ptId])
+        {
+          mean += current[3 * nei + k];
+        }
+        next[3 * ptId + k] =
+          current[3 * ptId + k] + RelaxationFactor * (mean / n - current[3 * ptId + k]);
+      }
+    }
+    std::swap(current, next);
+  }
+  return current;
+}
+
+vtkPolyData* Smooth(vtkSmoothPolyDataFilter* smoother, vtkPolyData* input, bool threaded,
+  int precision, const char* name)
+{
+  vtkNew<vtkTimerLog> timer;
+  smoother->SetInputData(input);
+  smoother->SetNumberOfIterations(NumberOfIterations);
+  smoother->SetRelaxationFactor(RelaxationFactor);
+  smoother->SetOutputPointsPrecision(precision);
+  smoother->SetThreadedSmoothing(threaded);
+  timer->StartTimer();
+  smoother->Update();
+  timer->StopTimer();
+  std::cout << name << (threaded ? " threaded: " : " serial: ") << timer->GetElapsedTime()
+            << " s\n";
+  return smoother->GetOutput();
+}
+
+bool TestJacobi(vtkPolyData* input)
+{
+  const std::vector<double> expected = JacobiSmoothing(input);
+  bool status = true;
+  for (int precision : { vtkAlgorithm::DOUBLE_PRECISION, vtkAlgorithm::SINGLE_PRECISION })
+  {
+    vtkNew<vtkSmoothPolyDataFilter> serial;
+    Smooth(serial, input, false, precision, "Unconstrained");
+    vtkNew<vtkSmoothPolyDataFilter> threaded;
+    vtkPolyData* output = Smooth(threaded, input, true, precision, "Unconstrained");
+
+    const double tolerance = precision == vtkAlgorithm::SINGLE_PRECISION ? 1e-4 : 1e-12;
+    double maxError = 0.0;
+    for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+    {
+      double x[3];
+      output->GetPoint(ptId, x);
+      for (int k = 0; k < 3; ++k)
+      {
+        maxError = std::max(maxError, std::abs(x[k] - expected[3 * ptId + k]));
+      }
+    }
+    if (maxError > tolerance ||
+      output->GetPoints()->GetDataType() !=
+        (precision == vtkAlgorithm::SINGLE_PRECISION ? VTK_FLOAT : VTK_DOUBLE))
+    {
+      std::cerr << "Error: threaded smoothing differs from Jacobi iterations by " << maxError
+                << " with precision " << precision << std::endl;
+      status = false;
+    }
+  }
+  return status;
+}
+
+// Constrained smoothing: the points must stay on the source surface
+bool TestConstrained(vtkPolyData* input)
+{
+  vtkNew<vtkSmoothPolyDataFilter> serial;
+  serial->SetSourceData(input);
+  Smooth(serial, input, false, vtkAlgorithm::DEFAULT_PRECISION, "Constrained");
+
+  vtkNew<vtkSmoothPolyDataFilter> threaded;
+  threaded->SetSourceData(input);
+  vtkPolyData* output =
+    Smooth(threaded, input, true, vtkAlgorithm::DEFAULT_PRECISION, "Constrained");
+
+  vtkNew<vtkStaticCellLocator> locator;
+  locator->SetDataSet(input);
+  locator->BuildLocator();
+  vtkNew<vtkGenericCell> cell;
+  double maxDist2 = 0.0;
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], closest[3], dist2;
+    vtkIdType cellId;
+    int subId;
+    output->GetPoint(ptId, x);
+    locator->FindClosestPoint(x, closest, cell, cellId, subId, dist2);
+    maxDist2 = std::max(maxDist2, dist2);
+  }
+  if (std::sqrt(maxDist2) > 1e-6 * input->GetLength())
+  {
+    std::cerr << "Error: constrained points are off the source surface by " << std::sqrt(maxDist2)
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestSmoothPolyDataFilterThreaded(int, char*[])
+{
+  vtkNew<vtkPolyData> input;
+  CreateInput(input);
+
+  bool status = TestJacobi(input);
+  status &= TestConstrained(input);
+  return status ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that vtkTubeFilter produces the same output with and
+// without SequentialProcessing.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+#include "vtkTubeFilter.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+// Random walks, a few of them sharing points or having duplicated points,
+// with point scalars and vectors, and cell data. Vertices come first so that
+// the line cell ids do not start at zero.
+void CreateInput(vtkPolyData* input, int numLines, int lineLength)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(7);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+
+  for (int lineId = 0; lineId < numLines; ++lineId)
+  {
+    double x[3] = { random->GetNextRangeValue(-10.0, 10.0),
+      random->GetNextRangeValue(-10.0, 10.0), random->GetNextRangeValue(-10.0, 10.0) };
+    lines->InsertNextCell(lineLength);
+    for (int i = 0; i < lineLength; ++i)
+    {
+      vtkIdType ptId;
+      if (i > 0 && lineId % 13 == 0 && i % 5 == 0)
+      {
+        ptId = points->InsertNextPoint(x); // duplicated point
+      }
+      else if (lineId > 0 && lineId % 17 == 0 && i == 0)
+      {
+        ptId = lineId; // shared with another line
+        points->GetPoint(ptId, x);
+      }
+      else
+      {
+        for (int k = 0; k < 3; ++k)
+        {
+          x[k] += random->GetNextRangeValue(-0.5, 0.5);
+        }
+        ptId = points->InsertNextPoint(x);
+      }
+      lines->InsertCellPoint(ptId);
+      if (ptId == points->GetNumberOfPoints() - 1)
+      {
+        scalars->InsertNextValue(random->GetNextRangeValue(0.1, 2.0));
+        vectors->InsertNextTuple3(random->GetNextRangeValue(0.1, 1.0),
+          random->GetNextRangeValue(-1.0, 1.0), random->GetNextRangeValue(-1.0, 1.0));
+      }
+    }
+  }
+  // A line with a single point and a line with only duplicated points
+  lines->InsertNextCell(1);
+  lines->InsertCellPoint(0);
+  lines->InsertNextCell(3);
+  lines->InsertCellPoint(1);
+  lines->InsertCellPoint(1);
+  lines->InsertCellPoint(1);
+  for (vtkIdType ptId = 0; ptId < 10; ++ptId)
+  {
+    verts->InsertNextCell(1, &ptId);
+  }
+
+  input->SetPoints(points);
+  input->SetVerts(verts);
+  input->SetLines(lines);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetVectors(vectors);
+
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->InsertNextValue(static_cast<int>(cellId));
+  }
+  input->GetCellData()->AddArray(cellIds);
+}
+
+struct Configuration
+{
+  int VaryRadius;
+  int GenerateTCoords;
+  int NumberOfSides;
+  int OnRatio;
+  bool SidesShareVertices;
+  bool Capping;
+  bool UseDefaultNormal;
+};
+
+void Configure(vtkTubeFilter* tubes, vtkPolyData* input, const Configuration& config)
+{
+  tubes->SetInputData(input);
+  tubes->SetRadius(0.05);
+  tubes->SetVaryRadius(config.VaryRadius);
+  tubes->SetGenerateTCoords(config.GenerateTCoords);
+  tubes->SetNumberOfSides(config.NumberOfSides);
+  tubes->SetOnRatio(config.OnRatio);
+  tubes->SetOffset(config.OnRatio > 1 ? 1 : 0);
+  tubes->SetSidesShareVertices(config.SidesShareVertices);
+  tubes->SetCapping(config.Capping);
+  tubes->SetUseDefaultNormal(config.UseDefaultNormal);
+  tubes->SetDefaultNormal(0.3, 0.4, 0.5);
+}
+
+bool TestConfiguration(vtkPolyData* input, const Configuration& config)
+{
+  vtkNew<vtkTubeFilter> sequential;
+  Configure(sequential, input, config);
+  sequential->SequentialProcessingOn();
+  sequential->Update();
+
+  vtkNew<vtkTubeFilter> threaded;
+  Configure(threaded, input, config);
+  threaded->Update();
+
+  // The arrays are compared by name, and the texture coordinates are not named
+  for (vtkPolyData* output : { sequential->GetOutput(), threaded->GetOutput() })
+  {
+    if (vtkDataArray* tcoords = output->GetPointData()->GetTCoords())
+    {
+      tcoords->SetName("TCoords");
+    }
+  }
+  if (!vtkTestUtilities::CompareDataObjects(sequential->GetOutput(), threaded->GetOutput()))
+  {
+    std::cerr << "Error: different outputs for vary radius " << config.VaryRadius
+              << ", tcoords " << config.GenerateTCoords << ", sides " << config.NumberOfSides
+              << ", on ratio " << config.OnRatio << ", share vertices "
+              << config.SidesShareVertices << ", capping " << config.Capping
+              << ", default normal " << config.UseDefaultNormal << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestTubeFilterSequentialProcessing(int, char*[])
+{
+  vtkNew<vtkPolyData> input;
+  CreateInput(input, 2000, 50);
+
+  bool status = true;
+  const Configuration configurations[] = {
+    { VTK_VARY_RADIUS_OFF, VTK_TCOORDS_OFF, 3, 1, true, false, false },
+    { VTK_VARY_RADIUS_BY_SCALAR, VTK_TCOORDS_FROM_LENGTH, 8, 1, true, true, false },
+    { VTK_VARY_RADIUS_BY_VECTOR, VTK_TCOORDS_FROM_NORMALIZED_LENGTH, 6, 2, false, true, false },
+    { VTK_VARY_RADIUS_BY_VECTOR_NORM, VTK_TCOORDS_FROM_SCALARS, 5, 1, false, false, true },
+    { VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR, VTK_TCOORDS_OFF, 12, 3, true, true, true },
+  };
+  for (const Configuration& config : configurations)
+  {
+    status &= TestConfiguration(input, config);
+  }
+  return status ? EXIT_SUCCESS : EXIT_FAILURE;
+}
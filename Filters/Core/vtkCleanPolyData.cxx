@@ -2,20 +2,33 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkCleanPolyData.h"
 
+#include "vtkArrayListTemplate.h" // For processing attribute data
+#include "vtkBatch.h"
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkCleanPolyData);
@@ -37,6 +50,321 @@ void InsertPointUsingGlobalId(vtkIdType globalId, vtkPoints* newPts,
     ptId = it->second;
   }
 }
+
+//------------------------------------------------------------------------------
+// Helpers of the threaded algorithm. The four cell arrays of the polydata are
+// identified by their index in the traversal order of the serial algorithm.
+enum CleanCellType
+{
+  CLEAN_VERTS = 0,
+  CLEAN_LINES = 1,
+  CLEAN_POLYS = 2,
+  CLEAN_STRIPS = 3,
+  CLEAN_NUMBER_OF_TYPES = 4
+};
+
+struct CleanConversions
+{
+  bool LinesToPoints;
+  bool PolysToLines;
+  bool StripsToPolys;
+};
+
+void AtomicMin(std::atomic<vtkIdType>& value, vtkIdType candidate)
+{
+  vtkIdType current = value.load(std::memory_order_relaxed);
+  while (candidate < current &&
+    !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+  {
+  }
+}
+
+void AtomicMax(std::atomic<vtkIdType>& value, vtkIdType candidate)
+{
+  vtkIdType current = value.load(std::memory_order_relaxed);
+  while (candidate > current &&
+    !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+  {
+  }
+}
+
+// Renumber the points of a cell and remove the duplicates exactly as the
+// serial algorithm does. Return the type of the output cell, or -1 if the
+// cell is discarded.
+int ReduceCell(int type, vtkIdType npts, const vtkIdType* pts, const vtkIdType* pointMap,
+  const CleanConversions& conversions, vtkIdType* updatedPts, vtkIdType& numNewPts)
+{
+  numNewPts = 0;
+  for (vtkIdType i = 0; i < npts; ++i)
+  {
+    const vtkIdType ptId = pointMap[pts[i]];
+    if (type == CLEAN_VERTS || i == 0 || ptId != updatedPts[numNewPts - 1])
+    {
+      updatedPts[numNewPts++] = ptId;
+    }
+  }
+  if (((type == CLEAN_POLYS && numNewPts > 2) || (type == CLEAN_STRIPS && numNewPts > 1)) &&
+    updatedPts[0] == updatedPts[numNewPts - 1])
+  {
+    numNewPts--;
+  }
+
+  switch (type)
+  {
+    case CLEAN_VERTS:
+      return numNewPts > 0 ? CLEAN_VERTS : -1;
+    case CLEAN_LINES:
+      if (numNewPts >= 2)
+      {
+        return CLEAN_LINES;
+      }
+      break;
+    case CLEAN_POLYS:
+      if (numNewPts > 2)
+      {
+        return CLEAN_POLYS;
+      }
+      if (numNewPts == 2 && (npts == numNewPts || conversions.PolysToLines))
+      {
+        return CLEAN_LINES;
+      }
+      break;
+    default:
+      if (numNewPts > 3)
+      {
+        return CLEAN_STRIPS;
+      }
+      if (numNewPts == 3 && (npts == numNewPts || conversions.StripsToPolys))
+      {
+        return CLEAN_POLYS;
+      }
+      if (numNewPts == 2 && (npts == numNewPts || conversions.PolysToLines))
+      {
+        return CLEAN_LINES;
+      }
+      break;
+  }
+  if (numNewPts == 1 && (npts == numNewPts || conversions.LinesToPoints))
+  {
+    return CLEAN_VERTS;
+  }
+  return -1;
+}
+
+// Number of output cells and size of the output connectivity of each type,
+// first accumulated per batch of input cells and then turned into offsets.
+struct CleanBatchData
+{
+  vtkIdType NumberOfCells[CLEAN_NUMBER_OF_TYPES];
+  vtkIdType ConnectivitySize[CLEAN_NUMBER_OF_TYPES];
+
+  CleanBatchData()
+  {
+    std::fill_n(this->NumberOfCells, CLEAN_NUMBER_OF_TYPES, 0);
+    std::fill_n(this->ConnectivitySize, CLEAN_NUMBER_OF_TYPES, 0);
+  }
+  ~CleanBatchData() = default;
+  CleanBatchData& operator+=(const CleanBatchData& other)
+  {
+    for (int t = 0; t < CLEAN_NUMBER_OF_TYPES; ++t)
+    {
+      this->NumberOfCells[t] += other.NumberOfCells[t];
+      this->ConnectivitySize[t] += other.ConnectivitySize[t];
+    }
+    return *this;
+  }
+  CleanBatchData operator+(const CleanBatchData& other) const
+  {
+    CleanBatchData result = *this;
+    result += other;
+    return result;
+  }
+};
+using CleanBatches = vtkBatches<CleanBatchData>;
+
+// Mark the first position, in the concatenated connectivity of the four cell
+// arrays, at which each point is used. This is the order in which the serial
+// algorithm inserts the points.
+struct MarkFirstUse
+{
+  vtkCellArray* Cells;
+  vtkIdType ConnectivityBase;
+  std::atomic<vtkIdType>* FirstUse;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> CellIterator;
+
+  MarkFirstUse(vtkCellArray* cells, vtkIdType connBase, std::atomic<vtkIdType>* firstUse)
+    : Cells(cells)
+    , ConnectivityBase(connBase)
+    , FirstUse(firstUse)
+  {
+  }
+
+  void Initialize() { this->CellIterator.Local().TakeReference(this->Cells->NewIterator()); }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkCellArrayIterator* cellIter = this->CellIterator.Local();
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (; cellId < endCellId; ++cellId)
+    {
+      cellIter->GetCellAtId(cellId, npts, pts);
+      const vtkIdType position = this->ConnectivityBase + this->Cells->GetOffset(cellId);
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        AtomicMin(this->FirstUse[pts[i]], position + i);
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// First pass over the cells of one cell array: count the output cells of
+// each type in every batch.
+struct CountCells
+{
+  vtkCellArray* Cells;
+  int Type;
+  const vtkIdType* PointMap;
+  CleanConversions Conversions;
+  vtkIdType MaxCellSize;
+  CleanBatches Batches;
+  CleanBatchData Totals;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> CellIterator;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> UpdatedPts;
+  vtkCleanPolyData* Filter;
+
+  CountCells(vtkCellArray* cells, int type, const vtkIdType* pointMap,
+    const CleanConversions& conversions, vtkIdType maxCellSize, vtkCleanPolyData* filter)
+    : Cells(cells)
+    , Type(type)
+    , PointMap(pointMap)
+    , Conversions(conversions)
+    , MaxCellSize(maxCellSize)
+    , Filter(filter)
+  {
+    this->Batches.Initialize(this->Cells->GetNumberOfCells());
+  }
+
+  void Initialize()
+  {
+    this->CellIterator.Local().TakeReference(this->Cells->NewIterator());
+    this->UpdatedPts.Local().resize(this->MaxCellSize);
+  }
+
+  void operator()(vtkIdType batchId, vtkIdType endBatchId)
+  {
+    vtkCellArrayIterator* cellIter = this->CellIterator.Local();
+    vtkIdType* updatedPts = this->UpdatedPts.Local().data();
+    vtkIdType npts, numNewPts;
+    const vtkIdType* pts;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+
+    for (; batchId < endBatchId; ++batchId)
+    {
+      if (isFirst)
+      {
+        this->Filter->CheckAbort();
+      }
+      if (this->Filter->GetAbortOutput())
+      {
+        break;
+      }
+      auto& batch = this->Batches[batchId];
+      for (vtkIdType cellId = batch.BeginId; cellId < batch.EndId; ++cellId)
+      {
+        cellIter->GetCellAtId(cellId, npts, pts);
+        const int outType = ::ReduceCell(
+          this->Type, npts, pts, this->PointMap, this->Conversions, updatedPts, numNewPts);
+        if (outType >= 0)
+        {
+          batch.Data.NumberOfCells[outType]++;
+          batch.Data.ConnectivitySize[outType] += numNewPts;
+        }
+      }
+    }
+  }
+
+  void Reduce() { this->Totals = this->Batches.BuildOffsetsAndGetGlobalSum(); }
+};
+
+// Second pass over the cells of one cell array: write the output cells and
+// copy the cell data. The output cell data of a cell of type t is located
+// after all the cells of the previous types, as in the serial algorithm.
+struct GenerateCells
+{
+  vtkCellArray* Cells;
+  int Type;
+  const vtkIdType* PointMap;
+  CleanConversions Conversions;
+  vtkIdType MaxCellSize;
+  const CleanBatches& Batches;
+  CleanBatchData Base;
+  vtkIdType* Offsets[CLEAN_NUMBER_OF_TYPES];
+  vtkIdType* Connectivity[CLEAN_NUMBER_OF_TYPES];
+  vtkIdType OutputCellBase[CLEAN_NUMBER_OF_TYPES];
+  vtkIdType InputCellBase;
+  ArrayList* Arrays;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> CellIterator;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> UpdatedPts;
+
+  GenerateCells(const CountCells& count, const CleanBatchData& base, vtkIdType inputCellBase,
+    ArrayList* arrays)
+    : Cells(count.Cells)
+    , Type(count.Type)
+    , PointMap(count.PointMap)
+    , Conversions(count.Conversions)
+    , MaxCellSize(count.MaxCellSize)
+    , Batches(count.Batches)
+    , Base(base)
+    , InputCellBase(inputCellBase)
+    , Arrays(arrays)
+  {
+  }
+
+  void Initialize()
+  {
+    this->CellIterator.Local().TakeReference(this->Cells->NewIterator());
+    this->UpdatedPts.Local().resize(this->MaxCellSize);
+  }
+
+  void operator()(vtkIdType batchId, vtkIdType endBatchId)
+  {
+    vtkCellArrayIterator* cellIter = this->CellIterator.Local();
+    vtkIdType* updatedPts = this->UpdatedPts.Local().data();
+    vtkIdType npts, numNewPts;
+    const vtkIdType* pts;
+
+    for (; batchId < endBatchId; ++batchId)
+    {
+      const auto& batch = this->Batches[batchId];
+      const CleanBatchData offsets = this->Base + batch.Data;
+      vtkIdType cellCursor[CLEAN_NUMBER_OF_TYPES];
+      vtkIdType connCursor[CLEAN_NUMBER_OF_TYPES];
+      std::copy_n(offsets.NumberOfCells, CLEAN_NUMBER_OF_TYPES, cellCursor);
+      std::copy_n(offsets.ConnectivitySize, CLEAN_NUMBER_OF_TYPES, connCursor);
+
+      for (vtkIdType cellId = batch.BeginId; cellId < batch.EndId; ++cellId)
+      {
+        cellIter->GetCellAtId(cellId, npts, pts);
+        const int t = ::ReduceCell(
+          this->Type, npts, pts, this->PointMap, this->Conversions, updatedPts, numNewPts);
+        if (t >= 0)
+        {
+          this->Offsets[t][cellCursor[t]] = connCursor[t];
+          std::copy_n(updatedPts, numNewPts, this->Connectivity[t] + connCursor[t]);
+          this->Arrays->Copy(
+            this->InputCellBase + cellId, this->OutputCellBase[t] + cellCursor[t]);
+          cellCursor[t]++;
+          connCursor[t] += numNewPts;
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -58,6 +386,7 @@ vtkCleanPolyData::vtkCleanPolyData()
   this->Locator = nullptr;
   this->PieceInvariant = 1;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->ThreadedMerging = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -170,6 +499,11 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     vtkDebugMacro(<< "No data to Operate On!");
     return 1;
   }
+  if (this->ThreadedMerging &&
+    !(this->PointMerging && input->GetPointData()->GetGlobalIds() != nullptr))
+  {
+    return this->ThreadedRequestData(input, output);
+  }
   vtkIdType* updatedPts = new vtkIdType[input->GetMaxCellSize()];
 
   vtkIdType numNewPts;
@@ -709,6 +1043,284 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// The threaded algorithm reproduces the serial one without its sequential
+// dependency: the output id of a point is given by the position in the cell
+// connectivity at which the group of points merged with it is first used.
+int vtkCleanPolyData::ThreadedRequestData(vtkPolyData* input, vtkPolyData* output)
+{
+  vtkPoints* inPts = input->GetPoints();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPointData* inputPD = input->GetPointData();
+  vtkCellData* inputCD = input->GetCellData();
+  vtkPointData* outputPD = output->GetPointData();
+  vtkCellData* outputCD = output->GetCellData();
+
+  vtkCellArray* inCells[CLEAN_NUMBER_OF_TYPES] = { input->GetVerts(), input->GetLines(),
+    input->GetPolys(), input->GetStrips() };
+  vtkIdType inputCellBase[CLEAN_NUMBER_OF_TYPES];
+  vtkIdType connectivityBase[CLEAN_NUMBER_OF_TYPES];
+  vtkIdType numInCells = 0;
+  vtkIdType connectivitySize = 0;
+  for (int k = 0; k < CLEAN_NUMBER_OF_TYPES; ++k)
+  {
+    inputCellBase[k] = numInCells;
+    connectivityBase[k] = connectivitySize;
+    numInCells += inCells[k]->GetNumberOfCells();
+    connectivitySize += inCells[k]->GetNumberOfConnectivityIds();
+  }
+
+  // Transform the points once, with the precision of the output points so
+  // that coincidence is evaluated on the values that are actually stored.
+  int dataType = inPts->GetDataType();
+  if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    dataType = VTK_FLOAT;
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    dataType = VTK_DOUBLE;
+  }
+  vtkNew<vtkPoints> mappedPts;
+  mappedPts->SetDataType(dataType);
+  mappedPts->SetNumberOfPoints(numPts);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      double x[3], newx[3];
+      for (; ptId < endPtId; ++ptId)
+      {
+        inPts->GetPoint(ptId, x);
+        this->OperateOnPoint(x, newx);
+        mappedPts->SetPoint(ptId, newx);
+      }
+    });
+
+  // Group the points to merge. Each group is identified by one of its points.
+  std::vector<vtkIdType> mergeMap;
+  if (this->PointMerging)
+  {
+    vtkNew<vtkPolyData> mappedInput;
+    mappedInput->SetPoints(mappedPts);
+    vtkNew<vtkStaticPointLocator> locator;
+    locator->SetDataSet(mappedInput);
+    locator->BuildLocator();
+    mergeMap.resize(numPts);
+    locator->MergePoints(this->ToleranceIsAbsolute ? this->AbsoluteTolerance
+                                                   : this->Tolerance * input->GetLength(),
+      mergeMap.data());
+  }
+  const vtkIdType* groups = mergeMap.empty() ? nullptr : mergeMap.data();
+  this->UpdateProgress(0.25);
+
+  // Find where each point, then each group, is first used. For each group,
+  // also find the last non-ghost point in insertion order: this is the point
+  // whose data ends up in the output with the serial algorithm.
+  const vtkIdType unused = connectivitySize;
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstUse(new std::atomic<vtkIdType>[numPts]);
+  std::unique_ptr<std::atomic<vtkIdType>[]> groupFirstUse(new std::atomic<vtkIdType>[numPts]);
+  std::unique_ptr<std::atomic<vtkIdType>[]> groupLastPrimary(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      for (; ptId < endPtId; ++ptId)
+      {
+        firstUse[ptId] = unused;
+        groupFirstUse[ptId] = unused;
+        groupLastPrimary[ptId] = -1;
+      }
+    });
+  for (int k = 0; k < CLEAN_NUMBER_OF_TYPES; ++k)
+  {
+    MarkFirstUse mark(inCells[k], connectivityBase[k], firstUse.get());
+    vtkSMPTools::For(0, inCells[k]->GetNumberOfCells(), mark);
+  }
+
+  vtkUnsignedCharArray* ghosts =
+    input->HasAnyGhostPoints() ? input->GetGhostArray(vtkDataObject::POINT) : nullptr;
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      for (; ptId < endPtId; ++ptId)
+      {
+        const vtkIdType use = firstUse[ptId];
+        if (use != unused)
+        {
+          const vtkIdType group = groups ? groups[ptId] : ptId;
+          ::AtomicMin(groupFirstUse[group], use);
+          if (!ghosts || ghosts->GetValue(ptId) == 0)
+          {
+            ::AtomicMax(groupLastPrimary[group], use);
+          }
+        }
+      }
+    });
+
+  // First uses of distinct groups are distinct positions, sorting them gives
+  // the output point ids.
+  std::vector<vtkIdType> sortedFirstUse(numPts);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      for (; ptId < endPtId; ++ptId)
+      {
+        sortedFirstUse[ptId] = groupFirstUse[ptId];
+      }
+    });
+  vtkSMPTools::Sort(sortedFirstUse.begin(), sortedFirstUse.end());
+  const vtkIdType numNewPts = static_cast<vtkIdType>(
+    std::lower_bound(sortedFirstUse.begin(), sortedFirstUse.end(), unused) -
+    sortedFirstUse.begin());
+
+  // Build the point map, and the input points providing the coordinates and
+  // the attributes of each output point.
+  std::vector<vtkIdType> pointMap(numPts);
+  std::vector<vtkIdType> coordinatesSource(numNewPts);
+  std::vector<vtkIdType> dataSource(numNewPts, -1);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      for (; ptId < endPtId; ++ptId)
+      {
+        const vtkIdType use = firstUse[ptId];
+        if (use == unused)
+        {
+          pointMap[ptId] = -1;
+          continue;
+        }
+        const vtkIdType group = groups ? groups[ptId] : ptId;
+        const vtkIdType groupUse = groupFirstUse[group];
+        const vtkIdType newPtId = static_cast<vtkIdType>(
+          std::lower_bound(sortedFirstUse.begin(), sortedFirstUse.begin() + numNewPts, groupUse) -
+          sortedFirstUse.begin());
+        pointMap[ptId] = newPtId;
+        if (use == groupUse)
+        {
+          coordinatesSource[newPtId] = ptId;
+        }
+        if (use == groupLastPrimary[group])
+        {
+          dataSource[newPtId] = ptId;
+        }
+      }
+    });
+  firstUse.reset();
+  groupFirstUse.reset();
+  groupLastPrimary.reset();
+  sortedFirstUse = std::vector<vtkIdType>();
+  this->UpdateProgress(0.5);
+
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(dataType);
+  newPts->SetNumberOfPoints(numNewPts);
+  if (!this->PointMerging)
+  {
+    outputPD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  }
+  outputPD->CopyAllocate(inputPD, numNewPts);
+  ArrayList pointArrays;
+  pointArrays.AddArrays(numNewPts, inputPD, outputPD, 0.0, /*promote=*/false);
+  vtkSMPTools::For(0, numNewPts,
+    [&](vtkIdType ptId, vtkIdType endPtId)
+    {
+      double x[3];
+      for (; ptId < endPtId; ++ptId)
+      {
+        const vtkIdType source = coordinatesSource[ptId];
+        mappedPts->GetPoint(source, x);
+        newPts->SetPoint(ptId, x);
+        pointArrays.Copy(dataSource[ptId] >= 0 ? dataSource[ptId] : source, ptId);
+      }
+    });
+  output->SetPoints(newPts);
+  this->UpdateProgress(0.6);
+
+  // Count the output cells of each cell array, then generate them. Output
+  // cells keep the order of the serial algorithm: by type, then by input
+  // cell id.
+  const CleanConversions conversions{ this->ConvertLinesToPoints != 0,
+    this->ConvertPolysToLines != 0, this->ConvertStripsToPolys != 0 };
+  const vtkIdType maxCellSize = input->GetMaxCellSize();
+  std::vector<std::unique_ptr<CountCells>> counts(CLEAN_NUMBER_OF_TYPES);
+  CleanBatchData bases[CLEAN_NUMBER_OF_TYPES];
+  CleanBatchData totals;
+  for (int k = 0; k < CLEAN_NUMBER_OF_TYPES; ++k)
+  {
+    if (inCells[k]->GetNumberOfCells() > 0)
+    {
+      counts[k].reset(
+        new CountCells(inCells[k], k, pointMap.data(), conversions, maxCellSize, this));
+      vtkSMPTools::For(0, counts[k]->Batches.GetNumberOfBatches(), *counts[k]);
+      bases[k] = totals;
+      totals += counts[k]->Totals;
+    }
+  }
+  if (this->GetAbortOutput())
+  {
+    return 1;
+  }
+
+  vtkIdType outputCellBase[CLEAN_NUMBER_OF_TYPES];
+  vtkIdType numOutCells = 0;
+  vtkNew<vtkIdTypeArray> offsets[CLEAN_NUMBER_OF_TYPES];
+  vtkNew<vtkIdTypeArray> connectivity[CLEAN_NUMBER_OF_TYPES];
+  for (int t = 0; t < CLEAN_NUMBER_OF_TYPES; ++t)
+  {
+    outputCellBase[t] = numOutCells;
+    numOutCells += totals.NumberOfCells[t];
+    offsets[t]->SetNumberOfValues(totals.NumberOfCells[t] + 1);
+    offsets[t]->SetValue(totals.NumberOfCells[t], totals.ConnectivitySize[t]);
+    connectivity[t]->SetNumberOfValues(totals.ConnectivitySize[t]);
+  }
+
+  outputCD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  outputCD->CopyAllocate(inputCD, numOutCells);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numOutCells, inputCD, outputCD, 0.0, /*promote=*/false);
+  for (int k = 0; k < CLEAN_NUMBER_OF_TYPES; ++k)
+  {
+    if (counts[k])
+    {
+      GenerateCells generate(*counts[k], bases[k], inputCellBase[k], &cellArrays);
+      for (int t = 0; t < CLEAN_NUMBER_OF_TYPES; ++t)
+      {
+        generate.Offsets[t] = offsets[t]->GetPointer(0);
+        generate.Connectivity[t] = connectivity[t]->GetPointer(0);
+        generate.OutputCellBase[t] = outputCellBase[t];
+      }
+      vtkSMPTools::For(0, counts[k]->Batches.GetNumberOfBatches(), generate);
+    }
+  }
+
+  for (int t = 0; t < CLEAN_NUMBER_OF_TYPES; ++t)
+  {
+    if (totals.NumberOfCells[t] > 0)
+    {
+      vtkNew<vtkCellArray> cells;
+      cells->SetData(offsets[t], connectivity[t]);
+      switch (t)
+      {
+        case CLEAN_VERTS:
+          output->SetVerts(cells);
+          break;
+        case CLEAN_LINES:
+          output->SetLines(cells);
+          break;
+        case CLEAN_POLYS:
+          output->SetPolys(cells);
+          break;
+        default:
+          output->SetStrips(cells);
+          break;
+      }
+    }
+  }
+
+  vtkDebugMacro(<< "Removed " << numPts - numNewPts << " points and "
+                << numInCells - numOutCells << " cells");
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 // Method manages creation of locators. It takes into account the potential
 // change of tolerance (zero to non-zero).
@@ -781,6 +1393,7 @@ void vtkCleanPolyData::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "PieceInvariant: " << (this->PieceInvariant ? "On\n" : "Off\n");
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "ThreadedMerging: " << (this->ThreadedMerging ? "On\n" : "Off\n");
 }
 
 //------------------------------------------------------------------------------
@@ -53,6 +53,18 @@
  * you must add a vtkPolyVertex cell with all of the points to the PolyData
  * (or use a vtkVertexGlyphFilter) before using the vtkCleanPolyData filter.
  *
+ * If ThreadedMerging is enabled, the filter uses a non-incremental threaded
+ * algorithm instead: point coordinates are transformed with OperateOnPoint in
+ * parallel, coincident points are merged through the sorted bins of a
+ * vtkStaticPointLocator, and cells are rewritten (and degenerate cells
+ * removed or converted) in parallel. Output points are still numbered in the
+ * order in which they are first used by the cells, so that when the tolerance
+ * is zero the output is identical to the one of the serial algorithm. With a
+ * non-zero tolerance, the merged points may differ since the merging does not
+ * depend on the cell traversal order anymore. The Locator is not used in this
+ * mode, and the serial algorithm is always used when points are merged
+ * through global ids.
+ *
  * @warning
  * The vtkStaticCleanPolyData filter is similar in operation to
  * vtkCleanPolyData. However, vtkStaticCleanPolyData is non-incremental and
@@ -152,6 +164,19 @@ public:
   vtkBooleanMacro(PointMerging, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Set/Get a boolean value that controls whether the threaded algorithm
+   * is used. When on, point merging and cell rewriting are performed in
+   * parallel with vtkSMPTools, and OperateOnPoint may be called concurrently
+   * from several threads. Memory usage is higher than with the serial
+   * algorithm. By default, this is off.
+   */
+  vtkSetMacro(ThreadedMerging, vtkTypeBool);
+  vtkGetMacro(ThreadedMerging, vtkTypeBool);
+  vtkBooleanMacro(ThreadedMerging, vtkTypeBool);
+  ///@}
+
   ///@{
   /**
    * Set/Get a spatial locator for speeding the search process. By
@@ -224,6 +249,7 @@ protected:
 
   vtkTypeBool PieceInvariant;
   int OutputPointsPrecision;
+  vtkTypeBool ThreadedMerging;
 
 private:
   vtkCleanPolyData(const vtkCleanPolyData&) = delete;
@@ -237,6 +263,9 @@ private:
   void InsertUniquePoint(vtkIdTypeArray* globalIdsArray, vtkIdType ptIndex, vtkPoints* newPts,
     std::unordered_map<vtkIdType, vtkIdType>& addedGlobalIdsMap, double* point, vtkIdType& ptId);
 
+  // Threaded implementation of RequestData(), see ThreadedMerging.
+  int ThreadedRequestData(vtkPolyData* input, vtkPolyData* output);
+
   std::unordered_set<vtkIdType> CopiedPoints;
 };
 
@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkConnectedPointSetsInternal
+ * @brief   lock-free union-find over point ids
+ *
+ * vtkConnectedPointSets is a disjoint set forest over point ids that can be
+ * updated concurrently with vtkSMPTools. Roots are always linked to a smaller
+ * root, so a parent can only be replaced by one of its ancestors and Find()
+ * returns the smallest point id of the set once all the unions are done.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkConnectivityFilter vtkPolyDataConnectivityFilter
+ */
+
+#ifndef vtkConnectedPointSetsInternal_h
+#define vtkConnectedPointSetsInternal_h
+
+#include "vtkSMPTools.h"
+#include "vtkType.h"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace vtkConnectedPointSetsInternal
+{
+VTK_ABI_NAMESPACE_BEGIN
+
+class vtkConnectedPointSets
+{
+public:
+  vtkConnectedPointSets(vtkIdType numPts)
+    : Parent(new std::atomic<vtkIdType>[numPts])
+  {
+    vtkSMPTools::For(0, numPts,
+      [this](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType ptId = begin; ptId < end; ++ptId)
+        {
+          this->Parent[ptId].store(ptId, std::memory_order_relaxed);
+        }
+      });
+  }
+
+  vtkIdType Find(vtkIdType ptId)
+  {
+    vtkIdType parent = this->Parent[ptId].load();
+    while (parent != ptId)
+    {
+      // Path halving: point to the grandparent when possible
+      const vtkIdType grandParent = this->Parent[parent].load();
+      if (grandParent != parent)
+      {
+        this->Parent[ptId].compare_exchange_weak(parent, grandParent);
+      }
+      ptId = grandParent;
+      parent = this->Parent[ptId].load();
+    }
+    return ptId;
+  }
+
+  void Union(vtkIdType ptId1, vtkIdType ptId2)
+  {
+    while (true)
+    {
+      ptId1 = this->Find(ptId1);
+      ptId2 = this->Find(ptId2);
+      if (ptId1 == ptId2)
+      {
+        return;
+      }
+      if (ptId1 < ptId2)
+      {
+        std::swap(ptId1, ptId2);
+      }
+      // Fails if another thread linked ptId1 in the meantime
+      vtkIdType expected = ptId1;
+      if (this->Parent[ptId1].compare_exchange_strong(expected, ptId2))
+      {
+        return;
+      }
+    }
+  }
+
+private:
+  std::unique_ptr<std::atomic<vtkIdType>[]> Parent;
+};
+
+VTK_ABI_NAMESPACE_END
+} // namespace vtkConnectedPointSetsInternal
+
+#endif
+// VTK-HeaderTest-Exclude: vtkConnectedPointSetsInternal.h
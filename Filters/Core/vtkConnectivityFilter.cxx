@@ -4,6 +4,7 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkConnectedPointSetsInternal.h"
 #include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkFloatArray.h"
@@ -16,10 +17,17 @@
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkToImplicitTypeErasureStrategy.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkObjectFactoryNewMacro(vtkConnectivityFilter);
@@ -208,6 +216,14 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
 
   if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+    this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
+    this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION && !this->InScalars &&
+    !this->SequentialProcessing)
+  { // with scalar connectivity, regions depend on the traversal order
+    largestRegionId = this->MarkRegionsInParallel(input);
+    this->UpdateProgress(0.9);
+  }
+  else if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
@@ -588,6 +604,193 @@ void vtkConnectivityFilter::TraverseAndMark(vtkDataSet* input)
   } // while wave is not empty
 }
 
+//-------------------------------------------------------------------------------------------------
+// Without scalar connectivity, regions are the components of the cells
+// connected through their points, and TraverseAndMark() starts each of them
+// at its smallest cell. Components are found with a union-find, then each
+// region is traversed on its own since regions share no point. Point numbers
+// are made global with the number of points of the previous regions.
+vtkIdType vtkConnectivityFilter::MarkRegionsInParallel(vtkDataSet* input)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+
+  // The first calls build the internal structures of the dataset, after
+  // which GetCellPoints() and GetPointCells() are thread safe.
+  input->GetCellPoints(0, this->PointIds);
+  input->GetPointCells(0, this->CellIds);
+
+  vtkSMPThreadLocalObject<vtkIdList> tlPointIds;
+  vtkConnectedPointSetsInternal::vtkConnectedPointSets sets(numPts);
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* pointIds = tlPointIds.Local();
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        input->GetCellPoints(cellId, pointIds);
+        for (vtkIdType i = 1; i < pointIds->GetNumberOfIds(); ++i)
+        {
+          sets.Union(pointIds->GetId(0), pointIds->GetId(i));
+        }
+      }
+    });
+
+  // Keep the root of the first point of each cell, and the smallest cell of
+  // each component. Empty cells are regions of their own.
+  std::vector<vtkIdType> cellRoots(numCells);
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstCell(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        firstCell[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+      }
+    });
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* pointIds = tlPointIds.Local();
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        input->GetCellPoints(cellId, pointIds);
+        if (pointIds->GetNumberOfIds() == 0)
+        {
+          cellRoots[cellId] = -1;
+          continue;
+        }
+        const vtkIdType root = sets.Find(pointIds->GetId(0));
+        cellRoots[cellId] = root;
+        vtkIdType current = firstCell[root].load();
+        while (cellId < current && !firstCell[root].compare_exchange_weak(current, cellId))
+        {
+        }
+      }
+    });
+
+  // Regions are numbered in the order of their first cell
+  std::vector<vtkIdType> regionOffsets(numCells + 1);
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        const vtkIdType root = cellRoots[cellId];
+        regionOffsets[cellId] = (root < 0 || firstCell[root] == cellId) ? 1 : 0;
+      }
+    });
+  regionOffsets[numCells] = 0;
+  vtkSMPTools::ExclusiveScan(
+    regionOffsets.begin(), regionOffsets.end(), regionOffsets.begin(), vtkIdType(0));
+  const vtkIdType numRegions = regionOffsets[numCells];
+  std::vector<vtkIdType> seeds(numRegions);
+  std::vector<vtkIdType> rootRegions(numPts, 0);
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        if (regionOffsets[cellId + 1] != regionOffsets[cellId])
+        {
+          const vtkIdType regionId = regionOffsets[cellId];
+          seeds[regionId] = cellId;
+          if (cellRoots[cellId] >= 0)
+          {
+            rootRegions[cellRoots[cellId]] = regionId;
+          }
+        }
+      }
+    });
+  firstCell.reset();
+  cellRoots = std::vector<vtkIdType>();
+  regionOffsets = std::vector<vtkIdType>();
+
+  // Traverse the regions concurrently, with the same wave propagation as
+  // TraverseAndMark(). Points are numbered locally to their region.
+  std::vector<vtkIdType> regionNumCells(numRegions);
+  std::vector<vtkIdType> regionNumPts(numRegions + 1);
+  vtkSMPThreadLocalObject<vtkIdList> tlCellIds;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> tlWave;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> tlWave2;
+  vtkSMPTools::For(0, numRegions,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* pointIds = tlPointIds.Local();
+      vtkIdList* cellIds = tlCellIds.Local();
+      std::vector<vtkIdType>& wave = tlWave.Local();
+      std::vector<vtkIdType>& wave2 = tlWave2.Local();
+      for (vtkIdType regionId = begin; regionId < end; ++regionId)
+      {
+        vtkIdType numCellsInRegion = 0;
+        vtkIdType pointNumber = 0;
+        wave.clear();
+        wave.push_back(seeds[regionId]);
+        while (!wave.empty())
+        {
+          for (vtkIdType cellId : wave)
+          {
+            if (this->Visited[cellId] < 0)
+            {
+              this->NewCellScalars->SetValue(cellId, regionId);
+              this->Visited[cellId] = regionId;
+              numCellsInRegion++;
+              input->GetCellPoints(cellId, pointIds);
+              for (vtkIdType j = 0; j < pointIds->GetNumberOfIds(); j++)
+              {
+                const vtkIdType ptId = pointIds->GetId(j);
+                if (this->PointMap[ptId] < 0)
+                {
+                  this->PointMap[ptId] = pointNumber++;
+                }
+                input->GetPointCells(ptId, cellIds);
+                wave2.insert(wave2.end(), cellIds->begin(), cellIds->end());
+              }
+            }
+          }
+          std::swap(wave, wave2);
+          wave2.clear();
+        }
+        regionNumCells[regionId] = numCellsInRegion;
+        regionNumPts[regionId] = pointNumber;
+      }
+    });
+
+  // Make the point numbers global
+  regionNumPts[numRegions] = 0;
+  vtkSMPTools::ExclusiveScan(
+    regionNumPts.begin(), regionNumPts.end(), regionNumPts.begin(), vtkIdType(0));
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        if (this->PointMap[ptId] >= 0)
+        {
+          const vtkIdType regionId = rootRegions[sets.Find(ptId)];
+          this->PointMap[ptId] += regionNumPts[regionId];
+          this->NewScalars->SetValue(this->PointMap[ptId], regionId);
+        }
+      }
+    });
+  this->PointNumber = regionNumPts[numRegions];
+
+  vtkIdType largestRegionId = 0;
+  vtkIdType maxCellsInRegion = 0;
+  this->RegionSizes->SetNumberOfValues(numRegions);
+  for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+  {
+    if (regionNumCells[regionId] > maxCellsInRegion)
+    {
+      maxCellsInRegion = regionNumCells[regionId];
+      largestRegionId = regionId;
+    }
+    this->RegionSizes->SetValue(regionId, regionNumCells[regionId]);
+  }
+  this->RegionNumber = numRegions;
+  return largestRegionId;
+}
+
 //-------------------------------------------------------------------------------------------------
 void vtkConnectivityFilter::OrderRegionIds(
   vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds)
@@ -789,6 +992,7 @@ void vtkConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Scalar Range: (" << range[0] << ", " << range[1] << ")\n";
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
   os << indent << "Compress Arrays: " << this->CompressArrays << "\n";
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 
 //-------------------------------------------------------------------------------------------------
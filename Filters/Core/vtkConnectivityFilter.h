@@ -38,6 +38,11 @@
  * was processed and has no other significance with respect to the size of
  * or number of cells.
  *
+ * Unless SequentialProcessing is on, regions are labeled in parallel with
+ * vtkSMPTools when no seeds are used and ScalarConnectivity is off. The
+ * RegionIds and the order of the output points and cells are the same as
+ * with the sequential algorithm.
+ *
  * @sa
  * vtkPolyDataConnectivityFilter, vtkGenerateRegionIds
  */
@@ -219,6 +224,19 @@ public:
   vtkBooleanMacro(CompressArrays, bool);
   ///@}
 
+  ///@{
+  /**
+   * Force sequential processing (i.e. single thread) of the region labeling.
+   * Otherwise, when the regions are not seeded and ScalarConnectivity is off,
+   * connected regions are found with a concurrent union-find over the points
+   * and traversed concurrently. The output does not depend on this option.
+   * Default is false.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
 protected:
   vtkConnectivityFilter();
   ~vtkConnectivityFilter() override;
@@ -269,6 +287,13 @@ protected:
    */
   void TraverseAndMark(vtkDataSet* input);
 
+  /**
+   * Mark all regions in parallel. Regions are numbered and traversed as if
+   * TraverseAndMark() was called on each unvisited cell in order. Returns the
+   * id of the largest region.
+   */
+  vtkIdType MarkRegionsInParallel(vtkDataSet* input);
+
   void OrderRegionIds(vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds);
 
   /**
@@ -297,6 +322,7 @@ private:
   vtkIdList* PointIds = nullptr;
   vtkIdList* CellIds = nullptr;
   bool CompressArrays = true;
+  bool SequentialProcessing = false;
 
   vtkConnectivityFilter(const vtkConnectivityFilter&) = delete;
   void operator=(const vtkConnectivityFilter&) = delete;
@@ -5,17 +5,25 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkLine.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPlane.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkDecimatePro);
 
@@ -37,11 +45,57 @@ vtkStandardNewMacro(vtkDecimatePro);
 #define VTK_STATE_SPLIT 1
 #define VTK_STATE_SPLIT_ALL 2
 
+#define VTK_MIN_TRIS_PER_PATCH 5000
+
 // Helper functions
 static double ComputeSimpleError(double x[3], double normal[3], double point[3]);
 static double ComputeEdgeError(double x[3], double x1[3], double x2[3]);
 static double ComputeSingleTriangleError(double x[3], double x1[3], double x2[3]);
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Recursively bisect the triangles [begin, end) along the longest axis of
+// their centroids, until numPatches groups of (almost) equal size are
+// obtained. Patch boundaries are appended to offsets.
+void BisectTriangles(const std::vector<double>& centroids, vtkIdType* begin, vtkIdType* end,
+  int numPatches, std::vector<vtkIdType>& offsets, const vtkIdType* first)
+{
+  if (numPatches <= 1 || end - begin < 2)
+  {
+    offsets.push_back(end - first);
+    return;
+  }
+
+  double bounds[6] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX,
+    VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+  for (vtkIdType* tri = begin; tri < end; ++tri)
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      const double c = centroids[3 * (*tri) + i];
+      bounds[2 * i] = std::min(bounds[2 * i], c);
+      bounds[2 * i + 1] = std::max(bounds[2 * i + 1], c);
+    }
+  }
+  int axis = 0;
+  for (int i = 1; i < 3; i++)
+  {
+    if (bounds[2 * i + 1] - bounds[2 * i] > bounds[2 * axis + 1] - bounds[2 * axis])
+    {
+      axis = i;
+    }
+  }
+
+  const int numLeft = numPatches / 2;
+  vtkIdType* middle = begin + (end - begin) * numLeft / numPatches;
+  std::nth_element(begin, middle, end, [&centroids, axis](vtkIdType a, vtkIdType b)
+    { return centroids[3 * a + axis] < centroids[3 * b + axis]; });
+  BisectTriangles(centroids, begin, middle, numLeft, offsets, first);
+  BisectTriangles(centroids, middle, end, numPatches - numLeft, offsets, first);
+}
+}
+
 //------------------------------------------------------------------------------
 // Create object with specified reduction of 90% and feature angle of
 // 15 degrees. Edge splitting is on, defer splitting is on, and the
@@ -73,6 +127,8 @@ vtkDecimatePro::vtkDecimatePro()
   this->BoundaryVertexDeletion = 1;
   this->InflectionPointRatio = 10.0;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->PatchDecimation = 0;
+  this->NumberOfPatches = 0;
 
   this->Queue = nullptr;
   this->VertexError = nullptr;
@@ -185,6 +241,19 @@ int vtkDecimatePro::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  // Decimate by patches if requested and worth it
+  if (this->PatchDecimation && !this->AccumulateError && this->TargetReduction > 0.0)
+  {
+    int numPatches = this->NumberOfPatches > 0 ? this->NumberOfPatches
+                                               : vtkSMPTools::GetEstimatedNumberOfThreads();
+    numPatches = static_cast<int>(
+      std::min(static_cast<vtkIdType>(numPatches), numTris / VTK_MIN_TRIS_PER_PATCH));
+    if (numPatches > 1)
+    {
+      return this->DecimatePatches(input, output, numPatches);
+    }
+  }
+
   // Build cell data structure. Need to copy triangle connectivity data
   // so we can modify it.
   if (this->TargetReduction > 0.0)
@@ -426,6 +495,232 @@ int vtkDecimatePro::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// Decimate the mesh by spatial patches. The patches are decimated
+// concurrently by independent instances of this class, with their seams
+// fixed (the seams are boundaries of the patches and boundary vertices are
+// not deleted) and without splitting, so that the patches can be stitched
+// back using the original point ids. A final sequential pass on the stitched
+// mesh, with all the parameters of this filter, removes the remaining
+// vertices (and in particular the seams) up to the target reduction.
+int vtkDecimatePro::DecimatePatches(vtkPolyData* input, vtkPolyData* output, int numPatches)
+{
+  vtkPoints* inPts = input->GetPoints();
+  vtkPointData* inPD = input->GetPointData();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numTris = input->GetNumberOfPolys();
+
+  vtkDebugMacro(<< "Decimating " << numTris << " triangles with " << numPatches << " patches");
+
+  // Gather the triangles and their centroids
+  std::vector<vtkIdType> connectivity(3 * numTris);
+  std::vector<double> centroids(3 * numTris);
+  vtkCellArray* inPolys = input->GetPolys();
+  vtkSMPTools::For(0, numTris,
+    [&](vtkIdType beginTri, vtkIdType endTri)
+    {
+      vtkNew<vtkIdList> ptIds;
+      vtkIdType npts;
+      const vtkIdType* pts;
+      double x[3];
+      for (vtkIdType triId = beginTri; triId < endTri; ++triId)
+      {
+        inPolys->GetCellAtId(triId, npts, pts, ptIds);
+        double* c = centroids.data() + 3 * triId;
+        c[0] = c[1] = c[2] = 0.0;
+        for (int i = 0; i < 3; i++)
+        {
+          connectivity[3 * triId + i] = pts[i];
+          inPts->GetPoint(pts[i], x);
+          c[0] += x[0] / 3.0;
+          c[1] += x[1] / 3.0;
+          c[2] += x[2] / 3.0;
+        }
+      }
+    });
+
+  // Split the triangles into spatially coherent patches
+  std::vector<vtkIdType> triIds(numTris);
+  std::iota(triIds.begin(), triIds.end(), 0);
+  std::vector<vtkIdType> offsets(1, 0);
+  BisectTriangles(
+    centroids, triIds.data(), triIds.data() + numTris, numPatches, offsets, triIds.data());
+  numPatches = static_cast<int>(offsets.size()) - 1;
+
+  // Decimate the interior of each patch. The error bound is made absolute
+  // since it must refer to the bounds of the whole input.
+  std::vector<vtkSmartPointer<vtkPolyData>> decimated(numPatches);
+  const double error = this->Error;
+  vtkSMPTools::For(0, numPatches, 1,
+    [&](vtkIdType beginPatch, vtkIdType endPatch)
+    {
+      for (vtkIdType patch = beginPatch; patch < endPatch; ++patch)
+      {
+        vtkIdType* firstTri = triIds.data() + offsets[patch];
+        vtkIdType* lastTri = triIds.data() + offsets[patch + 1];
+        std::sort(firstTri, lastTri);
+
+        // Points of the patch, numbered in increasing order of original id
+        std::vector<vtkIdType> patchPtIds;
+        patchPtIds.reserve(3 * (lastTri - firstTri));
+        for (vtkIdType* tri = firstTri; tri < lastTri; ++tri)
+        {
+          patchPtIds.insert(patchPtIds.end(), connectivity.begin() + 3 * (*tri),
+            connectivity.begin() + 3 * (*tri) + 3);
+        }
+        std::sort(patchPtIds.begin(), patchPtIds.end());
+        patchPtIds.erase(std::unique(patchPtIds.begin(), patchPtIds.end()), patchPtIds.end());
+        const vtkIdType numPatchPts = static_cast<vtkIdType>(patchPtIds.size());
+
+        vtkNew<vtkPoints> patchPts;
+        patchPts->SetDataType(inPts->GetDataType());
+        patchPts->SetNumberOfPoints(numPatchPts);
+        vtkNew<vtkIdTypeArray> originalIds;
+        originalIds->SetName("vtkOriginalPointIds");
+        originalIds->SetNumberOfValues(numPatchPts);
+        double x[3];
+        for (vtkIdType i = 0; i < numPatchPts; ++i)
+        {
+          inPts->GetPoint(patchPtIds[i], x);
+          patchPts->SetPoint(i, x);
+          originalIds->SetValue(i, patchPtIds[i]);
+        }
+
+        vtkNew<vtkCellArray> patchPolys;
+        patchPolys->AllocateExact(lastTri - firstTri, 3 * (lastTri - firstTri));
+        vtkIdType triPts[3];
+        for (vtkIdType* tri = firstTri; tri < lastTri; ++tri)
+        {
+          for (int i = 0; i < 3; i++)
+          {
+            triPts[i] = std::lower_bound(patchPtIds.begin(), patchPtIds.end(),
+                          connectivity[3 * (*tri) + i]) -
+              patchPtIds.begin();
+          }
+          patchPolys->InsertNextCell(3, triPts);
+        }
+
+        vtkNew<vtkPolyData> patchMesh;
+        patchMesh->SetPoints(patchPts);
+        patchMesh->SetPolys(patchPolys);
+        patchMesh->GetPointData()->AddArray(originalIds);
+
+        vtkNew<vtkDecimatePro> decimate;
+        decimate->SetInputData(patchMesh);
+        decimate->SetTargetReduction(this->TargetReduction);
+        decimate->SetFeatureAngle(this->FeatureAngle);
+        decimate->SetPreserveTopology(this->PreserveTopology);
+        decimate->SetDegree(this->Degree);
+        decimate->SetErrorIsAbsolute(1);
+        decimate->SetAbsoluteError(error);
+        decimate->SplittingOff();
+        decimate->BoundaryVertexDeletionOff();
+        decimate->Update();
+        decimated[patch] = decimate->GetOutput();
+      }
+    });
+
+  if (this->CheckAbort())
+  {
+    return 1;
+  }
+  this->UpdateProgress(0.5);
+
+  // Stitch the patches. Points are kept in their original order.
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  vtkIdType numStitchedTris = 0;
+  for (const auto& patch : decimated)
+  {
+    vtkIdTypeArray* originalIds =
+      vtkIdTypeArray::SafeDownCast(patch->GetPointData()->GetArray("vtkOriginalPointIds"));
+    for (vtkIdType i = 0; i < patch->GetNumberOfPoints(); ++i)
+    {
+      pointMap[originalIds->GetValue(i)] = 0;
+    }
+    numStitchedTris += patch->GetNumberOfPolys();
+  }
+  vtkIdType numStitchedPts = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (pointMap[ptId] >= 0)
+    {
+      pointMap[ptId] = numStitchedPts++;
+    }
+  }
+
+  vtkNew<vtkPoints> stitchedPts;
+  stitchedPts->SetDataType(inPts->GetDataType());
+  stitchedPts->SetNumberOfPoints(numStitchedPts);
+  vtkNew<vtkPolyData> stitched;
+  stitched->GetPointData()->CopyAllocate(inPD, numStitchedPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (pointMap[ptId] >= 0)
+    {
+      stitchedPts->SetPoint(pointMap[ptId], inPts->GetPoint(ptId));
+      stitched->GetPointData()->CopyData(inPD, ptId, pointMap[ptId]);
+    }
+  }
+
+  vtkNew<vtkCellArray> stitchedPolys;
+  stitchedPolys->AllocateExact(numStitchedTris, 3 * numStitchedTris);
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkIdType triPts[3];
+  for (const auto& patch : decimated)
+  {
+    vtkIdTypeArray* originalIds =
+      vtkIdTypeArray::SafeDownCast(patch->GetPointData()->GetArray("vtkOriginalPointIds"));
+    vtkCellArray* polys = patch->GetPolys();
+    for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+    {
+      for (int i = 0; i < 3; i++)
+      {
+        triPts[i] = pointMap[originalIds->GetValue(pts[i])];
+      }
+      stitchedPolys->InsertNextCell(3, triPts);
+    }
+  }
+  decimated.clear();
+  stitched->SetPoints(stitchedPts);
+  stitched->SetPolys(stitchedPolys);
+  if (numStitchedTris == 0)
+  {
+    output->ShallowCopy(stitched);
+    this->NumberOfRemainingTris = 0;
+    return 1;
+  }
+
+  // Final pass with the actual parameters, reaching the overall reduction
+  const double reduction =
+    1.0 - (1.0 - this->TargetReduction) * numTris / static_cast<double>(numStitchedTris);
+  vtkNew<vtkDecimatePro> decimate;
+  decimate->SetInputData(stitched);
+  decimate->SetTargetReduction(std::max(0.0, std::min(1.0, reduction)));
+  decimate->SetFeatureAngle(this->FeatureAngle);
+  decimate->SetSplitting(this->Splitting);
+  decimate->SetSplitAngle(this->SplitAngle);
+  decimate->SetPreSplitMesh(this->PreSplitMesh);
+  decimate->SetPreserveTopology(this->PreserveTopology);
+  decimate->SetBoundaryVertexDeletion(this->BoundaryVertexDeletion);
+  decimate->SetDegree(this->Degree);
+  decimate->SetInflectionPointRatio(this->InflectionPointRatio);
+  decimate->SetErrorIsAbsolute(1);
+  decimate->SetAbsoluteError(error);
+  decimate->SetOutputPointsPrecision(this->OutputPointsPrecision);
+  decimate->Update();
+
+  output->ShallowCopy(decimate->GetOutput());
+  this->NumberOfRemainingTris = output->GetNumberOfPolys();
+  for (vtkIdType i = 0; i < decimate->GetNumberOfInflectionPoints(); i++)
+  {
+    this->InflectionPoints->InsertNextValue(decimate->InflectionPoints->GetValue(i));
+  }
+  this->UpdateProgress(1.0);
+
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 // Computes error to edge (distance squared)
 //
@@ -1736,5 +2031,7 @@ void vtkDecimatePro::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Inflection Points: " << this->GetNumberOfInflectionPoints() << "\n";
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Patch Decimation: " << (this->PatchDecimation ? "On\n" : "Off\n");
+  os << indent << "Number Of Patches: " << this->NumberOfPatches << "\n";
 }
 VTK_ABI_NAMESPACE_END
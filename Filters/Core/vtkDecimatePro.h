@@ -61,6 +61,13 @@
  * @warning
  * Once mesh splitting begins, the feature angle is set to the split angle.
  *
+ * @warning
+ * When PatchDecimation is on, the mesh is divided into spatial patches which
+ * are decimated concurrently, then a final sequential pass decimates the
+ * stitched patches (and in particular their seams) up to the requested
+ * reduction. The result is not the same as the one of the sequential
+ * algorithm, and InflectionPoints only refer to the final pass.
+ *
  * @sa
  * vtkDecimate vtkQuadricClustering vtkQuadricDecimation
  */
@@ -275,6 +282,35 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the parallel decimation of the mesh by patches. When on, the
+   * triangles are divided into NumberOfPatches spatially coherent patches.
+   * The interior of the patches is decimated concurrently (vertices on the
+   * patch seams are kept and no splitting occurs), then the patches are
+   * stitched and a final sequential pass decimates the whole mesh, seams
+   * included, until TargetReduction is reached. The TargetReduction, the
+   * maximum error and the other parameters keep their meaning, but the
+   * output differs from the one of the sequential algorithm. Patch
+   * decimation is not used when AccumulateError is on, since the
+   * accumulated error would not be carried between the passes. By default
+   * PatchDecimation is off.
+   */
+  vtkSetMacro(PatchDecimation, vtkTypeBool);
+  vtkGetMacro(PatchDecimation, vtkTypeBool);
+  vtkBooleanMacro(PatchDecimation, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * Specify the number of patches used when PatchDecimation is on. If set
+   * to 0 (the default), one patch per thread is used. Small meshes may use
+   * fewer patches; with a single patch the sequential algorithm is used.
+   */
+  vtkSetClampMacro(NumberOfPatches, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPatches, int);
+  ///@}
+
 protected:
   vtkDecimatePro();
   ~vtkDecimatePro() override;
@@ -296,6 +332,8 @@ protected:
   double InflectionPointRatio;
   vtkDoubleArray* InflectionPoints;
   int OutputPointsPrecision;
+  vtkTypeBool PatchDecimation;
+  int NumberOfPatches;
 
   // to replace a static object
   vtkIdList* Neighbors;
@@ -384,6 +422,7 @@ protected:
   };
 
 private:
+  int DecimatePatches(vtkPolyData* input, vtkPolyData* output, int numPatches);
   void InitializeQueue(vtkIdType numPts);
   void DeleteQueue();
   void Insert(vtkIdType id, double error = -1.0);
@@ -4,6 +4,7 @@
 
 #include "vtkAbstractTransform.h"
 #include "vtkCellArray.h"
+#include "vtkDelaunayInsertionOrderInternal.h"
 #include "vtkDoubleArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -13,10 +14,13 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkStaticPointLocator2D.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <set>
 #include <vector>
 
@@ -33,6 +37,7 @@ vtkDelaunay2D::vtkDelaunay2D()
   this->BoundingTriangulation = 0;
   this->Offset = 1.0;
   this->RandomPointInsertion = 0;
+  this->BiasedRandomizedInsertion = 0;
   this->Transform = nullptr;
   this->ProjectionPlaneMode = VTK_DELAUNAY_XY_PLANE;
 
@@ -325,6 +330,31 @@ struct GCDTraversal
   // else that is going on.
   vtkIdType GetPointId(vtkIdType idx) { return ((this->Prime * idx + this->Offset) % this->NPts); }
 };
+
+// Compute a biased randomized insertion order, the points of a round being
+// sorted along the buckets of a static locator, traversing the rows of
+// buckets in alternating directions.
+std::vector<vtkIdType> BiasedRandomizedOrder(vtkPoints* points)
+{
+  vtkNew<vtkPolyData> dataSet;
+  dataSet->SetPoints(points);
+  vtkNew<vtkStaticPointLocator2D> locator;
+  locator->SetDataSet(dataSet);
+  locator->BuildLocator();
+  int divs[2];
+  locator->GetDivisions(divs);
+
+  return vtkDelaunayInsertionOrderInternal::BiasedRandomizedOrder(points->GetNumberOfPoints(),
+    [&](vtkIdType ptId)
+    {
+      double x[3];
+      int ij[2];
+      points->GetPoint(ptId, x);
+      locator->GetBucketIndices(x, ij);
+      return static_cast<uint64_t>(ij[1]) * divs[0] +
+        static_cast<uint64_t>((ij[1] % 2) ? divs[0] - 1 - ij[0] : ij[0]);
+    });
+}
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -454,6 +484,13 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
     points->DeepCopy(tPoints);
   }
 
+  // The insertion order is computed before the bounding points are added.
+  std::vector<vtkIdType> order;
+  if (this->BiasedRandomizedInsertion)
+  {
+    order = BiasedRandomizedOrder(points);
+  }
+
   const double* bounds = points->GetBounds();
   center[0] = (bounds[0] + bounds[1]) / 2.0;
   center[1] = (bounds[2] + bounds[3]) / 2.0;
@@ -516,9 +553,16 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
   // traversed in given order, or pseudo-random order.
   //
   GCDTraversal gcdIter(numPoints);
-  for (auto idx = 0; idx < numPoints; idx++)
+  for (vtkIdType idx = 0; idx < numPoints; idx++)
   {
-    ptId = (this->RandomPointInsertion ? gcdIter.GetPointId(idx) : idx);
+    if (!order.empty())
+    {
+      ptId = order[idx];
+    }
+    else
+    {
+      ptId = (this->RandomPointInsertion ? gcdIter.GetPointId(idx) : idx);
+    }
     this->GetPoint(ptId, x);
     nei[0] = (-1); // where we are coming from...nowhere initially
 
@@ -613,10 +657,10 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
       tri[0] = 0; // no triangle found
     }
 
-    if (!(ptId % 1000))
+    if (!(idx % 1000))
     {
-      vtkDebugMacro(<< "point #" << ptId);
-      this->UpdateProgress(static_cast<double>(ptId) / numPoints);
+      vtkDebugMacro(<< "point #" << idx);
+      this->UpdateProgress(static_cast<double>(idx) / numPoints);
       if (this->CheckAbort())
       {
         break;
@@ -1641,6 +1685,8 @@ void vtkDelaunay2D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Tolerance: " << this->Tolerance << "\n";
   os << indent << "Offset: " << this->Offset << "\n";
   os << indent << "Random Point Insertion: " << (this->RandomPointInsertion ? "On" : "Off") << "\n";
+  os << indent
+     << "Biased Randomized Insertion: " << (this->BiasedRandomizedInsertion ? "On" : "Off") << "\n";
   os << indent << "Bounding Triangulation: " << (this->BoundingTriangulation ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
@@ -3,6 +3,7 @@
 
 #include "vtkDelaunay3D.h"
 
+#include "vtkDelaunayInsertionOrderInternal.h"
 #include "vtkEdgeTable.h"
 #include "vtkExecutive.h"
 #include "vtkIncrementalPointLocator.h"
@@ -17,6 +18,10 @@
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkDelaunay3D);
 
@@ -107,6 +112,49 @@ vtkDelaunayTetra* vtkTetraArray::Resize(vtkIdType sz)
   return this->Array;
 }
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Spread the 21 lower bits of v so that there are two zeros between bits.
+uint64_t SpreadBits(uint64_t v)
+{
+  v &= 0x1fffff;
+  v = (v | (v << 32)) & 0x1f00000000ffffULL;
+  v = (v | (v << 16)) & 0x1f0000ff0000ffULL;
+  v = (v | (v << 8)) & 0x100f00f00f00f00fULL;
+  v = (v | (v << 4)) & 0x10c30c30c30c30c3ULL;
+  v = (v | (v << 2)) & 0x1249249249249249ULL;
+  return v;
+}
+
+//------------------------------------------------------------------------------
+// Compute a biased randomized insertion order, the points of a round being
+// sorted along a Morton curve.
+std::vector<vtkIdType> BiasedRandomizedOrder(vtkPoints* points, const double bounds[6])
+{
+  double scale[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    const double length = bounds[2 * i + 1] - bounds[2 * i];
+    scale[i] = length > 0.0 ? 2097151.0 / length : 0.0;
+  }
+
+  return vtkDelaunayInsertionOrderInternal::BiasedRandomizedOrder(points->GetNumberOfPoints(),
+    [&](vtkIdType ptId)
+    {
+      double x[3];
+      points->GetPoint(ptId, x);
+      uint64_t code = 0;
+      for (int i = 0; i < 3; ++i)
+      {
+        const double v = std::min(2097151.0, std::max(0.0, (x[i] - bounds[2 * i]) * scale[i]));
+        code |= SpreadBits(static_cast<uint64_t>(v)) << i;
+      }
+      return code;
+    });
+}
+}
+
 // vtkDelaunay3D methods
 //
 
@@ -122,6 +170,7 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->AlphaVerts = 1;
   this->Tolerance = 0.001;
   this->BoundingTriangulation = 0;
+  this->BiasedRandomizedInsertion = 0;
   this->Offset = 2.5;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
   this->Locator = nullptr;
@@ -478,20 +527,27 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
 
   Mesh = this->InitPointInsertion(center, this->Offset * tol, numPoints, points);
 
+  std::vector<vtkIdType> order;
+  if (this->BiasedRandomizedInsertion)
+  {
+    order = BiasedRandomizedOrder(inPoints, input->GetBounds());
+  }
+
   // Insert each point into triangulation. Points laying "inside"
   // of tetra cause tetra to be deleted, leaving a void with bounding
   // faces. Combination of point and each face is used to form new
   // tetrahedra.
-  for (ptId = 0; ptId < numPoints; ptId++)
+  for (i = 0; i < numPoints; i++)
   {
+    ptId = order.empty() ? i : order[i];
     inPoints->GetPoint(ptId, x);
 
     this->InsertPoint(Mesh, points, ptId, x, holeTetras);
 
-    if (!(ptId % 250))
+    if (!(i % 250))
     {
-      vtkDebugMacro(<< "point #" << ptId);
-      this->UpdateProgress(static_cast<double>(ptId) / numPoints);
+      vtkDebugMacro(<< "point #" << i);
+      this->UpdateProgress(static_cast<double>(i) / numPoints);
       if (this->CheckAbort())
       {
         break;
@@ -1048,6 +1104,8 @@ void vtkDelaunay3D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Tolerance: " << this->Tolerance << "\n";
   os << indent << "Offset: " << this->Offset << "\n";
   os << indent << "Bounding Triangulation: " << (this->BoundingTriangulation ? "On\n" : "Off\n");
+  os << indent
+     << "Biased Randomized Insertion: " << (this->BiasedRandomizedInsertion ? "On\n" : "Off\n");
 
   if (this->Locator)
   {
@@ -187,6 +187,24 @@ public:
   vtkBooleanMacro(BoundingTriangulation, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Boolean controls whether points are inserted in a biased randomized
+   * insertion order (BRIO) instead of the order of the input. Points are
+   * randomly distributed into rounds of geometrically increasing size, and
+   * sorted along a space filling (Morton) curve within each round. This
+   * order, computed in parallel, keeps successive insertions spatially close
+   * and their cavities small, which greatly speeds up the triangulation of
+   * large point sets. The Delaunay triangulation of points in general
+   * position does not depend on the insertion order; only degenerate
+   * configurations (e.g. cospherical points) and the choice of the point kept
+   * among coincident points may differ. By default this is off.
+   */
+  vtkSetMacro(BiasedRandomizedInsertion, vtkTypeBool);
+  vtkGetMacro(BiasedRandomizedInsertion, vtkTypeBool);
+  vtkBooleanMacro(BiasedRandomizedInsertion, vtkTypeBool);
+  ///@}
+
   ///@{
   /**
    * Set / get a spatial locator for merging points. By default,
@@ -266,6 +284,7 @@ protected:
   vtkTypeBool AlphaVerts;
   double Tolerance;
   vtkTypeBool BoundingTriangulation;
+  vtkTypeBool BiasedRandomizedInsertion;
   double Offset;
   int OutputPointsPrecision;
 
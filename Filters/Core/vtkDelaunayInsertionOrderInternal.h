@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkDelaunayInsertionOrderInternal
+ * @brief   biased randomized insertion order shared by the Delaunay filters
+ *
+ * vtkDelaunayInsertionOrderInternal computes a biased randomized insertion
+ * order (BRIO, Amenta, Choi and Rote) of a set of points. Each point goes to
+ * the last round with probability 1/2, to the previous one with probability
+ * 1/4, and so on, based on a deterministic hash of its id; the first round
+ * gathers the few points left. Within a round, points are sorted along a
+ * spatial code given by the caller, so that successive insertions are close
+ * to each other. The keys are computed and sorted with vtkSMPTools.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkDelaunay2D vtkDelaunay3D
+ */
+
+#ifndef vtkDelaunayInsertionOrderInternal_h
+#define vtkDelaunayInsertionOrderInternal_h
+
+#include "vtkSMPTools.h"
+#include "vtkType.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace vtkDelaunayInsertionOrderInternal
+{
+VTK_ABI_NAMESPACE_BEGIN
+
+// Key used to sort points in a biased randomized insertion order
+struct InsertionKey
+{
+  int Round;
+  uint64_t Code;
+  vtkIdType PtId;
+
+  bool operator<(const InsertionKey& other) const
+  {
+    if (this->Round != other.Round)
+    {
+      return this->Round < other.Round;
+    }
+    if (this->Code != other.Code)
+    {
+      return this->Code < other.Code;
+    }
+    return this->PtId < other.PtId;
+  }
+};
+
+// Deterministic hash of a point id (splitmix64 finalizer)
+inline uint64_t HashId(vtkIdType id)
+{
+  uint64_t z = static_cast<uint64_t>(id) + 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+// Return the point ids in a biased randomized insertion order. The spatial
+// code of a point is given by spatialCode(ptId), which is called
+// concurrently.
+template <typename SpatialCode>
+std::vector<vtkIdType> BiasedRandomizedOrder(vtkIdType numPts, SpatialCode&& spatialCode)
+{
+  int numRounds = 1;
+  while ((static_cast<vtkIdType>(64) << numRounds) < numPts && numRounds < 62)
+  {
+    ++numRounds;
+  }
+
+  std::vector<InsertionKey> keys(numPts);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        // The number of trailing zeros of a random number follows the
+        // geometric distribution of the round sizes.
+        uint64_t hash = HashId(ptId);
+        int trailing = 0;
+        while (trailing < numRounds - 1 && !(hash & 1))
+        {
+          hash >>= 1;
+          ++trailing;
+        }
+        keys[ptId] = InsertionKey{ numRounds - 1 - trailing, spatialCode(ptId), ptId };
+      }
+    });
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+
+  std::vector<vtkIdType> order(numPts);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        order[i] = keys[i].PtId;
+      }
+    });
+  return order;
+}
+
+VTK_ABI_NAMESPACE_END
+} // namespace vtkDelaunayInsertionOrderInternal
+
+#endif
+// VTK-HeaderTest-Exclude: vtkDelaunayInsertionOrderInternal.h
@@ -5,6 +5,7 @@
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkConnectedPointSetsInternal.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -14,8 +15,14 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm> // for fill_n
+#include <atomic>
+#include <memory>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkPolyDataConnectivityFilter);
@@ -172,6 +179,14 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   vtkIdType checkAbortInterval = 0;
 
   if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+    this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
+    this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION && !this->InScalars &&
+    !this->SequentialProcessing)
+  { // label all regions at once; scalar connectivity depends on the traversal order
+    largestRegionId = this->MarkRegionsInParallel();
+    this->UpdateProgress(0.9);
+  }
+  else if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
@@ -529,6 +544,207 @@ void vtkPolyDataConnectivityFilter::TraverseAndMark()
   } // while wave is not empty
 }
 
+//------------------------------------------------------------------------------
+// Regions are the connected components of the cells through their points. The
+// sequential algorithm starts a region at each unvisited cell in increasing
+// order, i.e. at the smallest cell of each component, and numbers the points
+// as they are reached by the wave. Since regions do not share points, each
+// region can be traversed independently; the point numbers are then offset
+// by the number of points of the previous regions.
+vtkIdType vtkPolyDataConnectivityFilter::MarkRegionsInParallel()
+{
+  const vtkIdType numPts = this->Mesh->GetNumberOfPoints();
+  const vtkIdType numCells = this->Mesh->GetNumberOfCells();
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPointIds;
+
+  // Merge the points of each cell
+  vtkConnectedPointSetsInternal::vtkConnectedPointSets sets(numPts);
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* cellPointIds = tlCellPointIds.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        this->Mesh->GetCellPoints(cellId, npts, pts, cellPointIds);
+        for (vtkIdType i = 1; i < npts; ++i)
+        {
+          sets.Union(pts[0], pts[i]);
+        }
+      }
+    });
+
+  // Find the smallest cell of each component. PointMap temporarily holds the
+  // root of each point.
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstCell(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        this->PointMap[ptId] = sets.Find(ptId);
+        firstCell[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+      }
+    });
+  std::vector<vtkIdType> regionOffsets(numCells + 1);
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* cellPointIds = tlCellPointIds.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        this->Mesh->GetCellPoints(cellId, npts, pts, cellPointIds);
+        if (npts > 0)
+        {
+          std::atomic<vtkIdType>& first = firstCell[this->PointMap[pts[0]]];
+          vtkIdType current = first.load();
+          while (cellId < current && !first.compare_exchange_weak(current, cellId))
+          {
+          }
+        }
+      }
+    });
+
+  // Number the regions in the order of their first cell
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* cellPointIds = tlCellPointIds.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        this->Mesh->GetCellPoints(cellId, npts, pts, cellPointIds);
+        regionOffsets[cellId] = (npts == 0 || firstCell[this->PointMap[pts[0]]] == cellId);
+      }
+    });
+  regionOffsets[numCells] = 0;
+  vtkSMPTools::ExclusiveScan(
+    regionOffsets.begin(), regionOffsets.end(), regionOffsets.begin(), vtkIdType(0));
+  const vtkIdType numRegions = regionOffsets[numCells];
+  std::vector<vtkIdType> seeds(numRegions);
+  vtkSMPTools::For(0, numCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        if (regionOffsets[cellId + 1] != regionOffsets[cellId])
+        {
+          seeds[regionOffsets[cellId]] = cellId;
+        }
+      }
+    });
+  firstCell.reset();
+  regionOffsets = std::vector<vtkIdType>();
+
+  // The region of each root, so that points can find their region later on.
+  std::vector<vtkIdType> rootRegions(numPts);
+  vtkSMPTools::For(0, numRegions,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* cellPointIds = tlCellPointIds.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (vtkIdType regionId = begin; regionId < end; ++regionId)
+      {
+        this->Mesh->GetCellPoints(seeds[regionId], npts, pts, cellPointIds);
+        if (npts > 0)
+        {
+          rootRegions[this->PointMap[pts[0]]] = regionId;
+        }
+      }
+    });
+  std::fill_n(this->PointMap, numPts, -1);
+
+  // Traverse the regions concurrently. This is the wave propagation of
+  // TraverseAndMark(), numbering the points locally to each region.
+  std::vector<vtkIdType> regionNumCells(numRegions);
+  std::vector<vtkIdType> regionNumPts(numRegions + 1);
+  vtkSMPThreadLocal<std::vector<vtkIdType>> tlWave;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> tlWave2;
+  vtkSMPTools::For(0, numRegions,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* cellPointIds = tlCellPointIds.Local();
+      std::vector<vtkIdType>& wave = tlWave.Local();
+      std::vector<vtkIdType>& wave2 = tlWave2.Local();
+      vtkIdType npts, ncells;
+      const vtkIdType* pts;
+      vtkIdType* cells;
+      for (vtkIdType regionId = begin; regionId < end; ++regionId)
+      {
+        vtkIdType numCellsInRegion = 0;
+        vtkIdType pointNumber = 0;
+        wave.clear();
+        wave.push_back(seeds[regionId]);
+        while (!wave.empty())
+        {
+          for (vtkIdType cellId : wave)
+          {
+            if (this->Visited[cellId] < 0)
+            {
+              this->Visited[cellId] = regionId;
+              numCellsInRegion++;
+              this->Mesh->GetCellPoints(cellId, npts, pts, cellPointIds);
+              for (vtkIdType j = 0; j < npts; j++)
+              {
+                const vtkIdType ptId = pts[j];
+                if (this->PointMap[ptId] < 0)
+                {
+                  this->PointMap[ptId] = pointNumber++;
+                  this->Mesh->GetPointCells(ptId, ncells, cells);
+                  wave2.insert(wave2.end(), cells, cells + ncells);
+                }
+              }
+            }
+          }
+          std::swap(wave, wave2);
+          wave2.clear();
+        }
+        regionNumCells[regionId] = numCellsInRegion;
+        regionNumPts[regionId] = pointNumber;
+      }
+    });
+
+  // Offset the point numbers by the points of the previous regions
+  regionNumPts[numRegions] = 0;
+  vtkSMPTools::ExclusiveScan(
+    regionNumPts.begin(), regionNumPts.end(), regionNumPts.begin(), vtkIdType(0));
+  vtkIdTypeArray* newScalars = vtkArrayDownCast<vtkIdTypeArray>(this->NewScalars);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        if (this->PointMap[ptId] >= 0)
+        {
+          const vtkIdType regionId = rootRegions[sets.Find(ptId)];
+          this->PointMap[ptId] += regionNumPts[regionId];
+          newScalars->SetValue(this->PointMap[ptId], regionId);
+        }
+      }
+    });
+  this->PointNumber = regionNumPts[numRegions];
+
+  vtkIdType largestRegionId = 0;
+  vtkIdType maxCellsInRegion = 0;
+  this->RegionSizes->SetNumberOfValues(numRegions);
+  for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+  {
+    if (regionNumCells[regionId] > maxCellsInRegion)
+    {
+      maxCellsInRegion = regionNumCells[regionId];
+      largestRegionId = regionId;
+    }
+    this->RegionSizes->SetValue(regionId, regionNumCells[regionId]);
+  }
+  this->RegionNumber = numRegions;
+  return largestRegionId;
+}
+
 //------------------------------------------------------------------------------
 int vtkPolyDataConnectivityFilter::IsScalarConnected(vtkIdType cellId)
 {
@@ -666,5 +882,6 @@ void vtkPolyDataConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
@@ -31,6 +31,11 @@
  * This use of ScalarConnectivity is particularly useful for selecting cells
  * for later processing.
  *
+ * When regions are not seeded and ScalarConnectivity is off, the regions
+ * are labeled in parallel using vtkSMPTools (unless SequentialProcessing is
+ * enabled). The output, including the RegionId array and the order of the
+ * output points and cells, is identical to the sequential algorithm.
+ *
  * @sa
  * vtkConnectivityFilter
  */
@@ -218,6 +223,19 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Force sequential processing (i.e. single thread) of the region labeling.
+   * By default, when the extraction mode does not use seeds and
+   * ScalarConnectivity is off, the connected regions are found with a
+   * concurrent union-find over the points, and then traversed concurrently.
+   * The output is the same in both cases. Default is off.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
 protected:
   vtkPolyDataConnectivityFilter();
   ~vtkPolyDataConnectivityFilter() override;
@@ -243,6 +261,11 @@ protected:
 
   void TraverseAndMark();
 
+  // Label all the regions in parallel, with the same numbering as
+  // TraverseAndMark() applied to each unvisited cell in order. Returns the
+  // id of the largest region.
+  vtkIdType MarkRegionsInParallel();
+
   // used to support algorithm execution
   vtkDataArray* CellScalars;
   vtkIdList* NeighborCellPointIds;
@@ -262,6 +285,7 @@ protected:
 
   vtkTypeBool MarkVisitedPointIds;
   int OutputPointsPrecision;
+  bool SequentialProcessing = false;
 
 private:
   vtkPolyDataConnectivityFilter(const vtkPolyDataConnectivityFilter&) = delete;
@@ -37,16 +37,54 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 #include "vtkType.h"
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkQuadricDecimation);
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Temporary buffers used by each thread to compute the cost of edges.
+struct CostWorkspace
+{
+  std::vector<double> X;
+  std::vector<double> Quad;
+  std::vector<double> B;
+  std::vector<double> Data;
+  std::vector<double*> A;
+
+  void Allocate(int dimension, int quadSize)
+  {
+    if (!this->A.empty())
+    {
+      return;
+    }
+    this->X.resize(dimension);
+    this->Quad.resize(quadSize);
+    this->B.resize(dimension);
+    this->Data.resize(dimension * dimension);
+    this->A.resize(dimension);
+    for (int i = 0; i < dimension; i++)
+    {
+      this->A[i] = this->Data.data() + i * dimension;
+    }
+  }
+};
+}
+
 //------------------------------------------------------------------------------
 vtkQuadricDecimation::vtkQuadricDecimation()
 {
@@ -374,19 +412,43 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   this->UpdateProgress(0.15);
 
   vtkDebugMacro(<< "Computing Costs");
-  // Compute the cost of and target point for collapsing each edge.
-  for (i = 0; i < this->Edges->GetNumberOfEdges(); i++)
+  // Compute the cost of and target point for collapsing each edge. Each
+  // thread uses its own temporary buffers; the costs are then inserted in
+  // the priority queue in edge order, as if computed sequentially.
+  const vtkIdType numEdges = this->Edges->GetNumberOfEdges();
+  std::vector<double> costs(numEdges);
+  this->TargetPoints->SetNumberOfTuples(numEdges);
+  const int dimension = 3 + this->NumberOfComponents + this->VolumePreservation;
+  const int quadSize = 11 + 4 * this->NumberOfComponents + this->VolumePreservation;
+  vtkSMPThreadLocal<CostWorkspace> workspaces;
+  auto computeCosts = [&](vtkIdType beginEdgeId, vtkIdType endEdgeId)
   {
-    if (this->AttributeErrorMetric)
+    CostWorkspace& ws = workspaces.Local();
+    ws.Allocate(dimension, quadSize);
+    for (vtkIdType id = beginEdgeId; id < endEdgeId; ++id)
     {
-      cost = this->ComputeCost2(i, x);
-    }
-    else
-    {
-      cost = this->ComputeCost(i, x);
+      if (this->AttributeErrorMetric)
+      {
+        costs[id] = this->ComputeCost2(id, ws.X.data(), ws.Quad.data(), ws.A.data(), ws.B.data());
+      }
+      else
+      {
+        costs[id] = this->ComputeCost(id, ws.X.data(), ws.Quad.data());
+      }
+      this->TargetPoints->SetTuple(id, ws.X.data());
     }
-    this->EdgeCosts->Insert(cost, i);
-    this->TargetPoints->InsertTuple(i, x);
+  };
+  if (this->SequentialProcessing)
+  {
+    computeCosts(0, numEdges);
+  }
+  else
+  {
+    vtkSMPTools::For(0, numEdges, computeCosts);
+  }
+  for (i = 0; i < numEdges; i++)
+  {
+    this->EdgeCosts->Insert(costs[i], i);
   }
   this->UpdateProgress(0.20);
 
@@ -497,18 +559,13 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
 }
 
 //------------------------------------------------------------------------------
-void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
+bool vtkQuadricDecimation::ComputeFaceQuadric(
+  const vtkIdType* pts, double* QEM, double n[3], double& d, double& triArea2)
 {
   vtkPolyData* input = this->Mesh;
-  std::vector<double> QEM;
-  vtkIdType ptId;
-  int i, j;
-  vtkCellArray* polys;
-  vtkIdType npts;
-  const vtkIdType* pts = nullptr;
+  int i;
   double point0[3], point1[3], point2[3];
-  double n[3];
-  double tempP1[3], tempP2[3], d, triArea2;
+  double tempP1[3], tempP2[3];
   double data[16];
   double *A[4], x[4];
   int index[4];
@@ -523,198 +580,319 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
     regularizationVariance = std::pow(this->Regularization, 2);
   }
 
-  // allocate local QEM sparse matrix
-  QEM.resize(11 + (4 * this->NumberOfComponents));
+  input->GetPoint(pts[0], point0);
+  input->GetPoint(pts[1], point1);
+  input->GetPoint(pts[2], point2);
+  for (i = 0; i < 3; i++)
+  {
+    tempP1[i] = point1[i] - point0[i];
+    tempP2[i] = point2[i] - point0[i];
+  }
+  vtkMath::Cross(tempP1, tempP2, n);
+  triArea2 = vtkMath::Normalize(n);
+  triArea2 /= 2; // area of the triangle, not quad
+  d = -vtkMath::Dot(n, point0);
+  // could possible add in angle weights??
+
+  // set the geometric part of the QEM
+  // using a quadric surface equation
+  QEM[0] = n[0] * n[0]; // x²
+  QEM[1] = n[0] * n[1]; // x×y
+  QEM[2] = n[0] * n[2]; // x×z
+  QEM[3] = d * n[0];    // d×x
 
-  // clear and allocate global QEM array
-  for (ptId = 0; ptId < numPts; ptId++)
+  QEM[4] = n[1] * n[1]; // y²
+  QEM[5] = n[1] * n[2]; // y×z
+  QEM[6] = d * n[1];    // d×y
+
+  QEM[7] = n[2] * n[2]; // z²
+  QEM[8] = d * n[2];    // d×z
+
+  QEM[9] = d * d; // d²
+  QEM[10] = 1;
+
+  if (this->Regularize)
   {
-    this->ErrorQuadrics[ptId].Quadric = new double[11 + (4 * this->NumberOfComponents)];
-    for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
-    {
-      this->ErrorQuadrics[ptId].Quadric[i] = 0.0;
-    }
+    // Add in some regularizing identity \Sigma_n
+    QEM[0] += regularizationVariance;
+    QEM[4] += regularizationVariance;
+    QEM[7] += regularizationVariance;
+
+    // -\Sigma_n . q
+    QEM[3] -= regularizationVariance * point0[0];
+    QEM[6] -= regularizationVariance * point0[1];
+    QEM[8] -= regularizationVariance * point0[2];
+
+    // q^T \Sigma_n q + n^T \Sigma_q n + Tr(\Sigma_n \Sigma_q)
+    QEM[9] +=
+      regularizationVariance * (vtkMath::Dot(point0, point0) + 1 + 3 * regularizationVariance);
   }
 
-  polys = input->GetPolys();
-  // compute the QEM for each face
-  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  if (this->AttributeErrorMetric)
   {
-    input->GetPoint(pts[0], point0);
-    input->GetPoint(pts[1], point1);
-    input->GetPoint(pts[2], point2);
     for (i = 0; i < 3; i++)
     {
-      tempP1[i] = point1[i] - point0[i];
-      tempP2[i] = point2[i] - point0[i];
+      A[0][i] = point0[i];
+      A[1][i] = point1[i];
+      A[2][i] = point2[i];
+      A[3][i] = n[i];
     }
-    vtkMath::Cross(tempP1, tempP2, n);
-    triArea2 = vtkMath::Normalize(n);
-    triArea2 /= 2; // area of the triangle, not quad
-    d = -vtkMath::Dot(n, point0);
-    // could possible add in angle weights??
+    A[0][3] = A[1][3] = A[2][3] = 1;
+    A[3][3] = 0;
+
+    // should handle poorly condition matrix better
+    if (vtkMath::LUFactorLinearSystem(A, index, 4))
+    {
+      for (i = 0; i < this->NumberOfComponents; i++)
+      {
+        x[3] = 0;
+        if (i < this->AttributeComponents[0])
+        {
+          x[0] = input->GetPointData()->GetScalars()->GetComponent(pts[0], i) *
+            this->AttributeScale[0];
+          x[1] = input->GetPointData()->GetScalars()->GetComponent(pts[1], i) *
+            this->AttributeScale[0];
+          x[2] = input->GetPointData()->GetScalars()->GetComponent(pts[2], i) *
+            this->AttributeScale[0];
+        }
+        else if (i < this->AttributeComponents[1])
+        {
+          x[0] = input->GetPointData()->GetVectors()->GetComponent(
+                   pts[0], i - this->AttributeComponents[0]) *
+            this->AttributeScale[1];
+          x[1] = input->GetPointData()->GetVectors()->GetComponent(
+                   pts[1], i - this->AttributeComponents[0]) *
+            this->AttributeScale[1];
+          x[2] = input->GetPointData()->GetVectors()->GetComponent(
+                   pts[2], i - this->AttributeComponents[0]) *
+            this->AttributeScale[1];
+        }
+        else if (i < this->AttributeComponents[2])
+        {
+          x[0] = input->GetPointData()->GetNormals()->GetComponent(
+                   pts[0], i - this->AttributeComponents[1]) *
+            this->AttributeScale[2];
+          x[1] = input->GetPointData()->GetNormals()->GetComponent(
+                   pts[1], i - this->AttributeComponents[1]) *
+            this->AttributeScale[2];
+          x[2] = input->GetPointData()->GetNormals()->GetComponent(
+                   pts[2], i - this->AttributeComponents[1]) *
+            this->AttributeScale[2];
+        }
+        else if (i < this->AttributeComponents[3])
+        {
+          x[0] = input->GetPointData()->GetTCoords()->GetComponent(
+                   pts[0], i - this->AttributeComponents[2]) *
+            this->AttributeScale[3];
+          x[1] = input->GetPointData()->GetTCoords()->GetComponent(
+                   pts[1], i - this->AttributeComponents[2]) *
+            this->AttributeScale[3];
+          x[2] = input->GetPointData()->GetTCoords()->GetComponent(
+                   pts[2], i - this->AttributeComponents[2]) *
+            this->AttributeScale[3];
+        }
+        else if (i < this->AttributeComponents[4])
+        {
+          x[0] = input->GetPointData()->GetTensors()->GetComponent(
+                   pts[0], i - this->AttributeComponents[3]) *
+            this->AttributeScale[4];
+          x[1] = input->GetPointData()->GetTensors()->GetComponent(
+                   pts[1], i - this->AttributeComponents[3]) *
+            this->AttributeScale[4];
+          x[2] = input->GetPointData()->GetTensors()->GetComponent(
+                   pts[2], i - this->AttributeComponents[3]) *
+            this->AttributeScale[4];
+        }
+        vtkMath::LUSolveLinearSystem(A, index, x, 4);
 
-    // set the geometric part of the QEM
-    // using a quadric surface equation
-    QEM[0] = n[0] * n[0]; // x²
-    QEM[1] = n[0] * n[1]; // x×y
-    QEM[2] = n[0] * n[2]; // x×z
-    QEM[3] = d * n[0];    // d×x
+        // add in the contribution of this element into the QEM
+        QEM[0] += x[0] * x[0];
+        QEM[1] += x[0] * x[1];
+        QEM[2] += x[0] * x[2];
+        QEM[3] += x[0] * x[3];
 
-    QEM[4] = n[1] * n[1]; // y²
-    QEM[5] = n[1] * n[2]; // y×z
-    QEM[6] = d * n[1];    // d×y
+        QEM[4] += x[1] * x[1];
+        QEM[5] += x[1] * x[2];
+        QEM[6] += x[1] * x[3];
 
-    QEM[7] = n[2] * n[2]; // z²
-    QEM[8] = d * n[2];    // d×z
+        QEM[7] += x[2] * x[2];
+        QEM[8] += x[2] * x[3];
 
-    QEM[9] = d * d; // d²
-    QEM[10] = 1;
+        QEM[9] += x[3] * x[3];
 
-    if (this->Regularize)
+        QEM[11 + (i * 4)] = -x[0];
+        QEM[12 + (i * 4)] = -x[1];
+        QEM[13 + (i * 4)] = -x[2];
+        QEM[14 + (i * 4)] = -x[3];
+      }
+    }
+    else
     {
-      // Add in some regularizing identity \Sigma_n
-      QEM[0] += regularizationVariance;
-      QEM[4] += regularizationVariance;
-      QEM[7] += regularizationVariance;
+      // The attribute part of the QEM is left untouched
+      return false;
+    }
+  }
+  return true;
+}
 
-      // -\Sigma_n . q
-      QEM[3] -= regularizationVariance * point0[0];
-      QEM[6] -= regularizationVariance * point0[1];
-      QEM[8] -= regularizationVariance * point0[2];
+//------------------------------------------------------------------------------
+void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
+{
+  vtkPolyData* input = this->Mesh;
+  const int quadricSize = 11 + 4 * this->NumberOfComponents;
+  vtkIdType ptId;
+  int i, j;
+  bool factored = true;
 
-      // q^T \Sigma_n q + n^T \Sigma_q n + Tr(\Sigma_n \Sigma_q)
-      QEM[9] +=
-        regularizationVariance * (vtkMath::Dot(point0, point0) + 1 + 3 * regularizationVariance);
+  // clear and allocate global QEM array
+  for (ptId = 0; ptId < numPts; ptId++)
+  {
+    this->ErrorQuadrics[ptId].Quadric = new double[quadricSize];
+    for (i = 0; i < quadricSize; i++)
+    {
+      this->ErrorQuadrics[ptId].Quadric[i] = 0.0;
     }
+  }
 
-    if (this->AttributeErrorMetric)
+  if (this->SequentialProcessing)
+  {
+    // allocate local QEM sparse matrix
+    std::vector<double> QEM(quadricSize);
+    vtkCellArray* polys = input->GetPolys();
+    vtkIdType npts;
+    const vtkIdType* pts = nullptr;
+    double n[3], d, triArea2;
+
+    // compute the QEM for each face, and add it to all points of the face
+    for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
     {
+      factored &= this->ComputeFaceQuadric(pts, QEM.data(), n, d, triArea2);
       for (i = 0; i < 3; i++)
       {
-        A[0][i] = point0[i];
-        A[1][i] = point1[i];
-        A[2][i] = point2[i];
-        A[3][i] = n[i];
-      }
-      A[0][3] = A[1][3] = A[2][3] = 1;
-      A[3][3] = 0;
+        for (j = 0; j < quadricSize; j++)
+        {
+          this->ErrorQuadrics[pts[i]].Quadric[j] += QEM[j] * triArea2;
+        }
 
-      // should handle poorly condition matrix better
-      if (vtkMath::LUFactorLinearSystem(A, index, 4))
-      {
-        for (i = 0; i < this->NumberOfComponents; i++)
+        // Set volume constraint values g_vol and d_vol
+        if (this->VolumePreservation)
         {
-          x[3] = 0;
-          if (i < this->AttributeComponents[0])
-          {
-            x[0] = input->GetPointData()->GetScalars()->GetComponent(pts[0], i) *
-              this->AttributeScale[0];
-            x[1] = input->GetPointData()->GetScalars()->GetComponent(pts[1], i) *
-              this->AttributeScale[0];
-            x[2] = input->GetPointData()->GetScalars()->GetComponent(pts[2], i) *
-              this->AttributeScale[0];
-          }
-          else if (i < this->AttributeComponents[1])
-          {
-            x[0] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[0], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-            x[1] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[1], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-            x[2] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[2], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-          }
-          else if (i < this->AttributeComponents[2])
-          {
-            x[0] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[0], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-            x[1] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[1], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-            x[2] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[2], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-          }
-          else if (i < this->AttributeComponents[3])
+          // Vector g_vol
+          for (j = 0; j < 3; j++)
           {
-            x[0] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[0], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-            x[1] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[1], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-            x[2] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[2], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
+            this->VolumeConstraints[(pts[i] * 4) + j] +=
+              n[j] * triArea2 * 2.0; // triangle normal with length triArea * 2
           }
-          else if (i < this->AttributeComponents[4])
-          {
-            x[0] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[0], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-            x[1] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[1], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-            x[2] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[2], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-          }
-          vtkMath::LUSolveLinearSystem(A, index, x, 4);
-
-          // add in the contribution of this element into the QEM
-          QEM[0] += x[0] * x[0];
-          QEM[1] += x[0] * x[1];
-          QEM[2] += x[0] * x[2];
-          QEM[3] += x[0] * x[3];
-
-          QEM[4] += x[1] * x[1];
-          QEM[5] += x[1] * x[2];
-          QEM[6] += x[1] * x[3];
-
-          QEM[7] += x[2] * x[2];
-          QEM[8] += x[2] * x[3];
-
-          QEM[9] += x[3] * x[3];
-
-          QEM[11 + (i * 4)] = -x[0];
-          QEM[12 + (i * 4)] = -x[1];
-          QEM[13 + (i * 4)] = -x[2];
-          QEM[14 + (i * 4)] = -x[3];
+          // Scalar d_vol
+          this->VolumeConstraints[(pts[i] * 4) + 3] +=
+            -d * triArea2 * 2.0; // (triangle normal with length triArea * 2) * (pts[0] position)
         }
       }
-      else
+    } // for all triangles
+  }
+  else
+  {
+    // Each point gathers the QEM of the faces using it. The links list the
+    // faces of a point in increasing order (a face using a point several
+    // times is listed several times), so that the sums are evaluated in the
+    // same order as in the sequential scatter above and the quadrics are
+    // identical.
+    // When the attribute matrix of a face cannot be factored, the sequential
+    // scatter keeps the attribute part of the last previous face that could
+    // be factored (or zeros): this face is found once for all the faces.
+    // Only the attribute matrices can fail to be factored.
+    const vtkIdType numCells = this->AttributeErrorMetric ? input->GetNumberOfCells() : 0;
+    std::vector<char> cellFactored(numCells);
+    vtkSMPTools::For(0, numCells,
+      [&](vtkIdType beginCellId, vtkIdType endCellId)
       {
-        vtkErrorMacro(<< "Unable to factor attribute matrix!");
+        std::vector<double> QEM(quadricSize);
+        vtkNew<vtkIdList> cellPtIds;
+        vtkIdType npts;
+        const vtkIdType* pts = nullptr;
+        double n[3], d, triArea2;
+        for (vtkIdType cellId = beginCellId; cellId < endCellId; ++cellId)
+        {
+          input->GetCellPoints(cellId, npts, pts, cellPtIds);
+          cellFactored[cellId] = this->ComputeFaceQuadric(pts, QEM.data(), n, d, triArea2);
+        }
+      });
+    std::vector<vtkIdType> previousFactored(numCells);
+    for (vtkIdType cellId = 0, previous = -1; cellId < numCells; ++cellId)
+    {
+      previousFactored[cellId] = previous;
+      if (cellFactored[cellId])
+      {
+        previous = cellId;
       }
     }
-
-    // add the QEM to all points of the face
-    for (i = 0; i < 3; i++)
+    auto setPreviousAttributes = [&](vtkIdType cellId, double* QEM, double* previousQEM,
+                                   vtkIdList* cellPtIds)
     {
-      for (j = 0; j < 11 + 4 * this->NumberOfComponents; j++)
+      const vtkIdType previous = previousFactored[cellId];
+      if (previous < 0)
       {
-        this->ErrorQuadrics[pts[i]].Quadric[j] += QEM[j] * triArea2;
+        std::fill(QEM + 11, QEM + quadricSize, 0.0);
+        return;
       }
-
-      // Set volume constraint values g_vol and d_vol
-      if (this->VolumePreservation)
+      vtkIdType npts;
+      const vtkIdType* pts = nullptr;
+      double n[3], d, triArea2;
+      input->GetCellPoints(previous, npts, pts, cellPtIds);
+      this->ComputeFaceQuadric(pts, previousQEM, n, d, triArea2);
+      std::copy(previousQEM + 11, previousQEM + quadricSize, QEM + 11);
+    };
+    std::atomic<bool> factoredAll(true);
+    vtkSMPTools::For(0, numPts,
+      [&](vtkIdType beginPtId, vtkIdType endPtId)
       {
-        // Vector g_vol
-        for (j = 0; j < 3; j++)
+        std::vector<double> QEM(quadricSize);
+        std::vector<double> previousQEM(quadricSize);
+        vtkNew<vtkIdList> cellPtIds;
+        vtkIdType ncells, *cells;
+        vtkIdType npts;
+        const vtkIdType* pts = nullptr;
+        double n[3], d, triArea2;
+        bool localFactored = true;
+
+        for (vtkIdType pId = beginPtId; pId < endPtId; ++pId)
         {
-          this->VolumeConstraints[(pts[i] * 4) + j] +=
-            n[j] * triArea2 * 2.0; // triangle normal with length triArea * 2
+          double* quadric = this->ErrorQuadrics[pId].Quadric;
+          input->GetPointCells(pId, ncells, cells);
+          for (vtkIdType c = 0; c < ncells; ++c)
+          {
+            input->GetCellPoints(cells[c], npts, pts, cellPtIds);
+            if (!this->ComputeFaceQuadric(pts, QEM.data(), n, d, triArea2))
+            {
+              localFactored = false;
+              setPreviousAttributes(cells[c], QEM.data(), previousQEM.data(), cellPtIds);
+            }
+            for (int k = 0; k < quadricSize; k++)
+            {
+              quadric[k] += QEM[k] * triArea2;
+            }
+            if (this->VolumePreservation)
+            {
+              for (int k = 0; k < 3; k++)
+              {
+                this->VolumeConstraints[(pId * 4) + k] += n[k] * triArea2 * 2.0;
+              }
+              this->VolumeConstraints[(pId * 4) + 3] += -d * triArea2 * 2.0;
+            }
+          }
         }
-        // Scalar d_vol
-        this->VolumeConstraints[(pts[i] * 4) + 3] +=
-          -d * triArea2 * 2.0; // (triangle normal with length triArea * 2) * (pts[0] position)
-      }
-    }
-  } // for all triangles
+        if (!localFactored)
+        {
+          factoredAll = false;
+        }
+      });
+    factored = factoredAll;
+  }
+
+  if (!factored)
+  {
+    vtkErrorMacro(<< "Unable to factor attribute matrix!");
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -728,19 +906,54 @@ void vtkQuadricDecimation::AddBoundaryConstraints()
   const vtkIdType* pts;
   double t0[3], t1[3], t2[3];
   double e0[3], e1[3], n[3], c, w;
-  vtkIdList* cellIds = vtkIdList::New();
 
   // allocate local QEM space matrix
   QEM = new double[11 + 4 * this->NumberOfComponents];
 
-  for (cellId = 0; cellId < input->GetNumberOfCells(); cellId++)
+  // Find the boundary edges of each cell first, this is the expensive part.
+  // The constraints are then added sequentially to preserve the order of the
+  // sums.
+  const vtkIdType numCells = input->GetNumberOfCells();
+  std::vector<unsigned char> boundaryEdges(numCells, 0);
+  auto findBoundaryEdges = [&](vtkIdType beginCellId, vtkIdType endCellId)
+  {
+    vtkNew<vtkIdList> cellPtIds;
+    vtkNew<vtkIdList> neighbors;
+    vtkIdType numCellPts;
+    const vtkIdType* cellPts;
+    for (vtkIdType id = beginCellId; id < endCellId; ++id)
+    {
+      input->GetCellPoints(id, numCellPts, cellPts, cellPtIds);
+      for (int edge = 0; edge < 3; edge++)
+      {
+        input->GetCellEdgeNeighbors(id, cellPts[edge], cellPts[(edge + 1) % 3], neighbors);
+        if (neighbors->GetNumberOfIds() == 0)
+        {
+          boundaryEdges[id] |= 1 << edge;
+        }
+      }
+    }
+  };
+  if (this->SequentialProcessing)
+  {
+    findBoundaryEdges(0, numCells);
+  }
+  else
+  {
+    vtkSMPTools::For(0, numCells, findBoundaryEdges);
+  }
+
+  for (cellId = 0; cellId < numCells; cellId++)
   {
+    if (!boundaryEdges[cellId])
+    {
+      continue;
+    }
     input->GetCellPoints(cellId, npts, pts);
 
     for (i = 0; i < 3; i++)
     {
-      input->GetCellEdgeNeighbors(cellId, pts[i], pts[(i + 1) % 3], cellIds);
-      if (cellIds->GetNumberOfIds() == 0)
+      if (boundaryEdges[cellId] & (1 << i))
       {
         // this is a boundary
         input->GetPoint(pts[(i + 2) % 3], t0);
@@ -822,7 +1035,6 @@ void vtkQuadricDecimation::AddBoundaryConstraints()
       }
     }
   }
-  cellIds->Delete();
   delete[] QEM;
 }
 
@@ -970,6 +1182,12 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
 
 //------------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
+{
+  return this->ComputeCost(edgeId, x, this->TempQuad);
+}
+
+//------------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x, double* quad)
 {
   static const double errorNumber = 1e-10;
   double temp[3], A[3][3], b[3];
@@ -986,20 +1204,20 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
-    this->TempQuad[i] =
+    quad[i] =
       this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
-  A[0][0] = this->TempQuad[0];
-  A[0][1] = A[1][0] = this->TempQuad[1];
-  A[0][2] = A[2][0] = this->TempQuad[2];
-  A[1][1] = this->TempQuad[4];
-  A[1][2] = A[2][1] = this->TempQuad[5];
-  A[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
-  b[0] = -this->TempQuad[3];
-  b[1] = -this->TempQuad[6];
-  b[2] = -this->TempQuad[8];
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
 
   norm = vtkMath::Norm(A[0]);
   normTemp = vtkMath::Norm(A[1]);
@@ -1051,7 +1269,7 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 
   // Compute the cost
   // x'*quad*x
-  index = this->TempQuad;
+  index = quad;
   for (i = 0; i < 4; i++)
   {
     cost += (*index++) * newPoint[i] * newPoint[i];
@@ -1066,6 +1284,13 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 
 //------------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
+{
+  return this->ComputeCost2(edgeId, x, this->TempQuad, this->TempA, this->TempB);
+}
+
+//------------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeCost2(
+  vtkIdType edgeId, double* x, double* quad, double** A, double* b)
 {
   // this function is so ugly because the functionality of converting an QEM
   // into a dense matrix was not extracted into a separate function and
@@ -1081,29 +1306,29 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
 
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
-    this->TempQuad[i] =
+    quad[i] =
       this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
   // copy the temp quad into TempA
   // converting from the sparse matrix format into a dense
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
-  this->TempB[0] = -this->TempQuad[3];
-  this->TempB[1] = -this->TempQuad[6];
-  this->TempB[2] = -this->TempQuad[8];
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
   {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11 + (4 * (i - 3))];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11 + (4 * (i - 3)) + 1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11 + (4 * (i - 3)) + 2];
-    this->TempB[i] = -this->TempQuad[11 + (4 * (i - 3)) + 3];
+    A[0][i] = A[i][0] = quad[11 + (4 * (i - 3))];
+    A[1][i] = A[i][1] = quad[11 + (4 * (i - 3)) + 1];
+    A[2][i] = A[i][2] = quad[11 + (4 * (i - 3)) + 2];
+    b[i] = -quad[11 + (4 * (i - 3)) + 3];
   }
 
   // Set zero to all components of the submatrix a[3:n;3:n] and al to its diagonal
@@ -1113,11 +1338,11 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i == j)
       {
-        this->TempA[i][j] = this->TempQuad[10];
+        A[i][j] = quad[10];
       }
       else
       {
-        this->TempA[i][j] = 0;
+        A[i][j] = 0;
       }
     }
   }
@@ -1128,50 +1353,50 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i >= 3)
       {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
+        A[i][3 + this->NumberOfComponents] = 0;
+        A[3 + this->NumberOfComponents][i] = 0;
       }
       else
       {
-        this->TempA[i][3 + this->NumberOfComponents] =
+        A[i][3 + this->NumberOfComponents] =
           this->VolumeConstraints[(pointIds[0] * 4) + i];
-        this->TempA[3 + this->NumberOfComponents][i] =
+        A[3 + this->NumberOfComponents][i] =
           this->VolumeConstraints[(pointIds[0] * 4) + i];
-        this->TempA[i][3 + this->NumberOfComponents] +=
+        A[i][3 + this->NumberOfComponents] +=
           this->VolumeConstraints[(pointIds[1] * 4) + i];
-        this->TempA[3 + this->NumberOfComponents][i] +=
+        A[3 + this->NumberOfComponents][i] +=
           this->VolumeConstraints[(pointIds[1] * 4) + i];
       }
     }
     // Add constraint to b
-    this->TempB[3 + this->NumberOfComponents] = this->VolumeConstraints[(pointIds[0] * 4) + 3];
-    this->TempB[3 + this->NumberOfComponents] += this->VolumeConstraints[(pointIds[1] * 4) + 3];
+    b[3 + this->NumberOfComponents] = this->VolumeConstraints[(pointIds[0] * 4) + 3];
+    b[3 + this->NumberOfComponents] += this->VolumeConstraints[(pointIds[1] * 4) + 3];
   }
 
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    x[i] = this->TempB[i];
+    x[i] = b[i];
   }
 
   // solve A*x = b
   // this clobers A
   // need to develop a quality of the solution test??
   solveOk = vtkMath::SolveLinearSystem(
-    this->TempA, x, 3 + this->NumberOfComponents + this->VolumePreservation);
+    A, x, 3 + this->NumberOfComponents + this->VolumePreservation);
 
   // need to copy back into A
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
   {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11 + 4 * (i - 3)];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11 + 4 * (i - 3) + 1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11 + 4 * (i - 3) + 2];
+    A[0][i] = A[i][0] = quad[11 + 4 * (i - 3)];
+    A[1][i] = A[i][1] = quad[11 + 4 * (i - 3) + 1];
+    A[2][i] = A[i][2] = quad[11 + 4 * (i - 3) + 2];
   }
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
@@ -1180,11 +1405,11 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i == j)
       {
-        this->TempA[i][j] = this->TempQuad[10];
+        A[i][j] = quad[10];
       }
       else
       {
-        this->TempA[i][j] = 0;
+        A[i][j] = 0;
       }
     }
   }
@@ -1195,16 +1420,16 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i >= 3)
       {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
+        A[i][3 + this->NumberOfComponents] = 0;
+        A[3 + this->NumberOfComponents][i] = 0;
       }
       else
       {
-        this->TempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[i][3 + this->NumberOfComponents] +=
+        A[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[i][3 + this->NumberOfComponents] +=
           this->VolumeConstraints[pointIds[1] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] +=
+        A[3 + this->NumberOfComponents][i] +=
           this->VolumeConstraints[pointIds[1] * 4 + i];
       }
     }
@@ -1238,7 +1463,7 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
       temp2[i] = 0;
       for (j = 0; j < 3 + this->NumberOfComponents; ++j)
       {
-        temp2[i] += this->TempA[i][j] * v[j];
+        temp2[i] += A[i][j] * v[j];
       }
     }
 
@@ -1256,13 +1481,13 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
         temp[i] = 0;
         for (j = 0; j < 3 + this->NumberOfComponents; ++j)
         {
-          temp[i] += this->TempA[i][j] * pt1[j];
+          temp[i] += A[i][j] * pt1[j];
         }
       }
 
       for (i = 0; i < 3 + this->NumberOfComponents; i++)
       {
-        temp[i] = this->TempB[i] - temp[i];
+        temp[i] = b[i] - temp[i];
       }
 
       for (i = 0; i < 3 + this->NumberOfComponents; i++)
@@ -1291,18 +1516,18 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
   // x'*A*x - 2*b*x + d
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    cost += this->TempA[i][i] * x[i] * x[i];
+    cost += A[i][i] * x[i] * x[i];
     for (j = i + 1; j < 3 + this->NumberOfComponents + this->VolumePreservation; j++)
     {
-      cost += 2.0 * this->TempA[i][j] * x[i] * x[j];
+      cost += 2.0 * A[i][j] * x[i] * x[j];
     }
   }
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    cost -= 2.0 * this->TempB[i] * x[i];
+    cost -= 2.0 * b[i] * x[i];
   }
 
-  cost += this->TempQuad[9];
+  cost += quad[9];
 
   return cost;
 }
@@ -1591,5 +1816,6 @@ void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Normals Weight: " << this->NormalsWeight << "\n";
   os << indent << "TCoords Weight: " << this->TCoordsWeight << "\n";
   os << indent << "Tensors Weight: " << this->TensorsWeight << "\n";
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
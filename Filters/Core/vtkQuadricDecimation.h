@@ -37,6 +37,14 @@
  * Attributes" is also a good take on the subject especially as it pertains
  * to the error metric applied to attributes.
  *
+ * The setup of the decimation (quadrics of the points, detection of the
+ * boundary edges, initial cost of the edges) is performed in parallel with
+ * vtkSMPTools, unless SequentialProcessing is on. The edge collapses
+ * themselves are performed sequentially: the order in which edges are
+ * collapsed follows the global priority queue, so that the result (and in
+ * particular the ActualReduction and the error of each collapse) does not
+ * depend on the number of threads.
+ *
  * @par Thanks:
  * Thanks to Bradley Lowekamp of the National Library of Medicine/NIH for
  * contributing this class.
@@ -208,6 +216,18 @@ public:
   vtkGetMacro(ActualReduction, double);
   ///@}
 
+  ///@{
+  /**
+   * Force sequential processing (i.e. single thread) of the quadrics and
+   * edge costs computation. By default, sequential processing is off. The
+   * output is the same in both modes. This flag is typically used for
+   * benchmarking purposes.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
 protected:
   vtkQuadricDecimation();
   ~vtkQuadricDecimation() override;
@@ -225,6 +245,16 @@ protected:
    */
   void InitializeQuadrics(vtkIdType numPts);
 
+  /**
+   * Compute the quadric of a triangle face, not yet weighted by the area of
+   * the face. The normal n, the plane offset d and the area triArea2 of the
+   * face are returned as well. Returns false if the attribute matrix cannot
+   * be factored, in which case the attribute part of QEM is left unchanged.
+   * This method is thread safe.
+   */
+  bool ComputeFaceQuadric(
+    const vtkIdType* pts, double* QEM, double n[3], double& d, double& triArea2);
+
   /**
    * Free boundary edges are weighted
    */
@@ -250,6 +280,16 @@ protected:
   double ComputeCost2(vtkIdType edgeId, double* x);
   ///@}
 
+  ///@{
+  /**
+   * Same as above, but using the given temporary buffers instead of TempQuad,
+   * TempA and TempB, so that the costs of several edges can be computed
+   * concurrently.
+   */
+  double ComputeCost(vtkIdType edgeId, double* x, double* quad);
+  double ComputeCost2(vtkIdType edgeId, double* x, double* quad, double** A, double* b);
+  ///@}
+
   /**
    * Find all edges that will have an endpoint change ids because of an edge
    * collapse.  p1Id and p2Id are the endpoints of the edge.  p2Id is the
@@ -327,6 +367,8 @@ protected:
   double TCoordsWeight;
   double TensorsWeight;
 
+  bool SequentialProcessing = false;
+
   int NumberOfEdgeCollapses;
   vtkEdgeTable* Edges;
   vtkIdList* EndPoint1List;
@@ -6,6 +6,7 @@
 #include "vtkCellData.h"
 #include "vtkCellLocator.h"
 #include "vtkFloatArray.h"
+#include "vtkGenericCell.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -13,11 +14,16 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleFilter.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkSmoothPolyDataFilter);
@@ -116,6 +122,7 @@ vtkSmoothPolyDataFilter::vtkSmoothPolyDataFilter()
   this->GenerateErrorVectors = 0;
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->ThreadedSmoothing = 0;
 
   this->SmoothPoints = nullptr;
 
@@ -171,10 +178,12 @@ struct vtkSPDF_InternalParams
   T factor;
   T conv;
   vtkIdType numPts;
-  vtkMeshVertexPtr vertexPtr;
+  const vtkIdType* offsets; // smoothing stencil of point i is
+  const vtkIdType* edges;   // edges[offsets[i]] to edges[offsets[i+1]-1]
   vtkPolyData* source;
   vtkSmoothPoints* SmoothPoints;
   double* w;
+  int maxCellSize;
   vtkCellLocator* cellLocator;
 };
 
@@ -198,8 +207,8 @@ void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
     T* newPtsCoords =
       vtkAOSDataArrayTemplate<T>::FastDownCast(params.newPts->GetData())->GetPointer(0);
     T* start = newPtsCoords;
-    vtkMeshVertexPtr vertsPtr = params.vertexPtr;
-    vtkIdType npts, *edgeIdPtr;
+    vtkIdType npts;
+    const vtkIdType* edgeIdPtr;
     T dist, deltaX[3];
     double dist2, xNew[3], closestPt[3];
 
@@ -207,11 +216,10 @@ void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
     // position of its connected neighbors using the relaxation factor.
     for (vtkIdType i = 0; i < params.numPts; ++i)
     {
-      if (vertsPtr->type != VTK_FIXED_VERTEX && vertsPtr->edges &&
-        (npts = vertsPtr->edges->GetNumberOfIds()) > 0)
+      if ((npts = params.offsets[i + 1] - params.offsets[i]) > 0)
       {
         deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-        edgeIdPtr = vertsPtr->edges->GetPointer(0);
+        edgeIdPtr = params.edges + params.offsets[i];
         // Compute the mean (cumulated) direction vector
         for (vtkIdType j = 0; j < npts; ++j)
         {
@@ -265,13 +273,164 @@ void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
       {
         newPtsCoords += 3;
       }
-      ++vertsPtr;
     } // for all points
   }   // for not converged or within iteration count
 
   vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
 }
 
+// One threaded smoothing iteration: the points are moved from the
+// coordinates of the previous iteration (Current) into Next.
+template <typename T>
+struct vtkSPDF_SmoothingPass
+{
+  vtkSPDF_InternalParams<T>& Params;
+  const T* Current;
+  T* Next;
+  T MaxDist;
+
+  vtkSMPThreadLocal<T> LocalMaxDist;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double>> Weights;
+
+  vtkSPDF_SmoothingPass(vtkSPDF_InternalParams<T>& params, const T* current, T* next)
+    : Params(params)
+    , Current(current)
+    , Next(next)
+    , MaxDist(0)
+  {
+  }
+
+  void Initialize()
+  {
+    this->LocalMaxDist.Local() = 0;
+    if (this->Params.source)
+    {
+      this->Weights.Local().resize(this->Params.maxCellSize);
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const vtkIdType* offsets = this->Params.offsets;
+    const vtkIdType* edges = this->Params.edges;
+    const T factor = this->Params.factor;
+    T& maxDist = this->LocalMaxDist.Local();
+    vtkGenericCell* cell = this->Cell.Local();
+    double* w = this->Weights.Local().data();
+    double dist2, xNew[3], closestPt[3];
+
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const T* x = this->Current + 3 * i;
+      T* y = this->Next + 3 * i;
+      const vtkIdType npts = offsets[i + 1] - offsets[i];
+      if (npts == 0) // fixed point
+      {
+        y[0] = x[0];
+        y[1] = x[1];
+        y[2] = x[2];
+        continue;
+      }
+
+      // Compute the mean (cumulated) direction vector and move the point
+      T deltaX[3] = { 0, 0, 0 };
+      for (const vtkIdType* edgeIdPtr = edges + offsets[i]; edgeIdPtr != edges + offsets[i + 1];
+           ++edgeIdPtr)
+      {
+        const T* xNei = this->Current + 3 * (*edgeIdPtr);
+        deltaX[0] += xNei[0];
+        deltaX[1] += xNei[1];
+        deltaX[2] += xNei[2];
+      }
+      for (int k = 0; k < 3; ++k)
+      {
+        y[k] = x[k] + factor * (deltaX[k] / npts - x[k]);
+      }
+
+      // Constrain point to surface. Every point has its own smooth point, so
+      // they can be updated concurrently.
+      if (this->Params.source)
+      {
+        vtkSmoothPoint* sPtr = this->Params.SmoothPoints->GetSmoothPoint(i);
+        for (int k = 0; k < 3; ++k)
+        {
+          xNew[k] = y[k];
+        }
+        bool inCell = false;
+        if (sPtr->cellId >= 0) // in cell
+        {
+          this->Params.source->GetCell(sPtr->cellId, cell);
+          inCell = cell->EvaluatePosition(xNew, closestPt, sPtr->subId, sPtr->p, dist2, w) != 0;
+        }
+        if (!inCell)
+        { // not in cell anymore
+          this->Params.cellLocator->FindClosestPoint(
+            xNew, closestPt, cell, sPtr->cellId, sPtr->subId, dist2);
+        }
+        for (int k = 0; k < 3; ++k)
+        {
+          y[k] = static_cast<T>(closestPt[k]);
+        }
+      }
+
+      const T dist = vtkMath::Norm(deltaX);
+      if (dist > maxDist)
+      {
+        maxDist = dist;
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    this->MaxDist = 0;
+    for (T dist : this->LocalMaxDist)
+    {
+      this->MaxDist = std::max(this->MaxDist, dist);
+    }
+  }
+};
+
+// Threaded version of vtkSPDF_MovePoints: the iterations are double-buffered
+// so that all the points can be moved concurrently.
+template <typename T>
+void vtkSPDF_MovePointsThreaded(vtkSPDF_InternalParams<T>& params)
+{
+  T* coords = vtkAOSDataArrayTemplate<T>::FastDownCast(params.newPts->GetData())->GetPointer(0);
+  std::vector<T> buffer(3 * params.numPts);
+  T* current = coords;
+  T* next = buffer.data();
+
+  int iterationNumber = 0;
+  for (T maxDist = std::numeric_limits<T>::max();
+       maxDist > params.conv && iterationNumber < params.numberOfIterations; ++iterationNumber)
+  {
+    if (iterationNumber && !(iterationNumber % 5))
+    {
+      params.spdf->UpdateProgress(0.5 + 0.5 * iterationNumber / params.numberOfIterations);
+      if (params.spdf->CheckAbort())
+      {
+        break;
+      }
+    }
+
+    vtkSPDF_SmoothingPass<T> pass(params, current, next);
+    vtkSMPTools::For(0, params.numPts, pass);
+    maxDist = pass.MaxDist;
+    std::swap(current, next);
+  } // for not converged or within iteration count
+
+  if (current != coords)
+  {
+    vtkSMPTools::For(0, params.numPts,
+      [&](vtkIdType begin, vtkIdType end)
+      { std::copy(current + 3 * begin, current + 3 * end, coords + 3 * begin); });
+  }
+
+  vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
+}
+
 } // namespace
 
 //------------------------------------------------------------------------------
@@ -627,6 +786,38 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   (void)numFixed;
   (void)numFEdges;
 
+  // Gather the smoothing stencils in compressed (CSR) form, so that the
+  // iterations traverse contiguous memory. Fixed vertices have no stencil.
+  std::vector<vtkIdType> offsets(numPts + 1);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        offsets[ptId] = (Verts[ptId].type != VTK_FIXED_VERTEX && Verts[ptId].edges)
+          ? Verts[ptId].edges->GetNumberOfIds()
+          : 0;
+      }
+    });
+  offsets[numPts] = 0;
+  vtkSMPTools::ExclusiveScan(offsets.begin(), offsets.end(), offsets.begin(), vtkIdType(0));
+  std::vector<vtkIdType> edges(offsets[numPts]);
+  vtkSMPTools::For(0, numPts,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        if (Verts[ptId].edges)
+        {
+          const vtkIdType* ids = Verts[ptId].edges->GetPointer(0);
+          std::copy(ids, ids + (offsets[ptId + 1] - offsets[ptId]), edges.begin() + offsets[ptId]);
+          Verts[ptId].edges->Delete();
+          Verts[ptId].edges = nullptr;
+        }
+      }
+    });
+  uVerts.reset();
+
   vtkDebugMacro(<< "Beginning smoothing iterations...");
 
   // We've setup the topology...now perform Laplacian smoothing
@@ -652,16 +843,21 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   // If a Source is defined, we do constrained smoothing (that is, points are
   // constrained to the surface of the mesh object).
   std::unique_ptr<double[]> w;
+  int maxCellSize = 0;
   vtkSmartPointer<vtkCellLocator> cellLocator;
   if (source)
   {
     this->SmoothPoints = std::unique_ptr<vtkSmoothPoints>(new vtkSmoothPoints);
     vtkSmoothPoint* sPtr;
     cellLocator.TakeReference(vtkCellLocator::New());
-    auto maxCellSize = source->GetMaxCellSize();
+    maxCellSize = source->GetMaxCellSize();
     w.reset(new double[maxCellSize]);
     cellLocator->SetDataSet(source);
     cellLocator->BuildLocator();
+    if (source->NeedToBuildCells())
+    { // so that GetCell() can be called concurrently
+      source->BuildCells();
+    }
 
     for (i = 0; i < numPts; i++)
     {
@@ -682,18 +878,33 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   if (newPts->GetDataType() == VTK_DOUBLE)
   {
     vtkSPDF_InternalParams<double> params = { this, this->NumberOfIterations, newPts,
-      this->RelaxationFactor, conv, numPts, Verts, source, this->SmoothPoints.get(), w.get(),
-      cellLocator };
+      this->RelaxationFactor, conv, numPts, offsets.data(), edges.data(), source,
+      this->SmoothPoints.get(), w.get(), maxCellSize, cellLocator };
 
-    vtkSPDF_MovePoints(params);
+    if (this->ThreadedSmoothing)
+    {
+      vtkSPDF_MovePointsThreaded(params);
+    }
+    else
+    {
+      vtkSPDF_MovePoints(params);
+    }
   }
   else
   {
     vtkSPDF_InternalParams<float> params = { this, this->NumberOfIterations, newPts,
-      static_cast<float>(this->RelaxationFactor), static_cast<float>(conv), numPts, Verts, source,
-      this->SmoothPoints.get(), w.get(), cellLocator };
+      static_cast<float>(this->RelaxationFactor), static_cast<float>(conv), numPts,
+      offsets.data(), edges.data(), source, this->SmoothPoints.get(), w.get(), maxCellSize,
+      cellLocator };
 
-    vtkSPDF_MovePoints(params);
+    if (this->ThreadedSmoothing)
+    {
+      vtkSPDF_MovePointsThreaded(params);
+    }
+    else
+    {
+      vtkSPDF_MovePoints(params);
+    }
   }
 
   // Release memory if it's been allocated
@@ -743,16 +954,6 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   output->SetPolys(input->GetPolys());
   output->SetStrips(input->GetStrips());
 
-  // free up connectivity storage
-  for (i = 0; i < numPts; i++)
-  {
-    if (Verts[i].edges)
-    {
-      Verts[i].edges->Delete();
-      Verts[i].edges = nullptr;
-    }
-  }
-
   return 1;
 }
 
@@ -795,5 +996,6 @@ void vtkSmoothPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Threaded Smoothing: " << (this->ThreadedSmoothing ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
@@ -65,6 +65,11 @@
  * second input: the Source. If defined, the input mesh is constrained to
  * lie on the surface defined by the Source ivar.
  *
+ * The smoothing iterations can be threaded with the ThreadedSmoothing ivar.
+ * In that case all points are moved concurrently from their positions at
+ * the previous iteration, so the result slightly differs from the default
+ * in place iterations.
+ *
  *
  * @warning
  * The Laplacian operation reduces high frequency information in the geometry
@@ -214,6 +219,22 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the threaded smoothing iterations (off by default). When on,
+   * each iteration moves all the points concurrently, using the coordinates
+   * of the previous iteration (Jacobi iterations), instead of moving them in
+   * place one after the other (Gauss-Seidel iterations). The smoothed points
+   * are thus slightly different, and a few more iterations may be needed to
+   * reach the same amount of smoothing. Note that the iterations are
+   * performed in single precision when the output points are float (see
+   * OutputPointsPrecision), which is faster on large meshes.
+   */
+  vtkSetMacro(ThreadedSmoothing, vtkTypeBool);
+  vtkGetMacro(ThreadedSmoothing, vtkTypeBool);
+  vtkBooleanMacro(ThreadedSmoothing, vtkTypeBool);
+  ///@}
+
 protected:
   vtkSmoothPolyDataFilter();
   ~vtkSmoothPolyDataFilter() override;
@@ -231,6 +252,7 @@ protected:
   vtkTypeBool GenerateErrorScalars;
   vtkTypeBool GenerateErrorVectors;
   int OutputPointsPrecision;
+  vtkTypeBool ThreadedSmoothing;
 
   std::unique_ptr<vtkSmoothPoints> SmoothPoints;
 
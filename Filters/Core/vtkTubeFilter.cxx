@@ -2,18 +2,27 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkTubeFilter.h"
 
+#include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkTubeFilter);
@@ -71,6 +80,676 @@ struct IdPointsEqual
   vtkPoints* Points;
 };
 
+// Parameters of the tube generation, shared by all the threads.
+struct TubeParameters
+{
+  vtkPoints* InPts;
+  vtkDataArray* InNormals; // nullptr when sliding normals are generated
+  vtkDataArray* InScalars;
+  vtkDataArray* InVectors;
+  double Range[2];
+  double MaxSpeed;
+  int VaryRadius;
+  double Radius;
+  double RadiusFactor;
+  int NumberOfSides;
+  bool SidesShareVertices;
+  bool Capping;
+  int OnRatio;
+  int Offset;
+  int GenerateTCoords;
+  double TextureLength;
+  double Theta;
+};
+
+TubeParameters MakeTubeParameters(vtkTubeFilter* self, double theta)
+{
+  TubeParameters par{ nullptr, nullptr, nullptr, nullptr, { 0.0, 1.0 }, 0.0,
+    self->GetVaryRadius(), self->GetRadius(), self->GetRadiusFactor(), self->GetNumberOfSides(),
+    self->GetSidesShareVertices() != 0, self->GetCapping() != 0, self->GetOnRatio(),
+    self->GetOffset(), self->GetGenerateTCoords(), self->GetTextureLength(), theta };
+  return par;
+}
+
+// Outcome of the frame computation of a line. Warnings are reported once
+// all the lines have been processed.
+enum TubeLineStatus : unsigned char
+{
+  TUBE_LINE_SKIPPED = 0, // less than two distinct points
+  TUBE_LINE_VALID,
+  TUBE_LINE_COINCIDENT_POINTS,
+  TUBE_LINE_BAD_NORMAL,
+  TUBE_LINE_NEGATIVE_SCALAR
+};
+
+void WarnTubeLine(vtkTubeFilter* self, unsigned char status)
+{
+  switch (status)
+  {
+    case TUBE_LINE_COINCIDENT_POINTS:
+      vtkWarningWithObjectMacro(self, << "Coincident points!");
+      break;
+    case TUBE_LINE_BAD_NORMAL:
+      vtkWarningWithObjectMacro(self, << "Bad normal!");
+      break;
+    case TUBE_LINE_NEGATIVE_SCALAR:
+      vtkWarningWithObjectMacro(self, << "Scalar value less than zero, skipping line");
+      break;
+    default:
+      return;
+  }
+  vtkWarningWithObjectMacro(self, << "Could not generate points!");
+}
+
+// Local frame of a tube around a line point
+struct TubeFrame
+{
+  double W[3];
+  double NP[3];
+  double SFactor;
+};
+
+// Compute the frames of the tube around a line without consecutive
+// duplicated points. The normals are taken from par.InNormals when set,
+// otherwise lineNormals gives the normal of each point of the line.
+TubeLineStatus ComputeTubeFrames(const TubeParameters& par, vtkIdType npts, const vtkIdType* pts,
+  vtkDataArray* lineNormals, TubeFrame* frames, double startCapNormal[3], double endCapNormal[3])
+{
+  double p[3];
+  double pNext[3];
+  double sNext[3] = { 0.0, 0.0, 0.0 };
+  double sPrev[3];
+  double n[3];
+  double s[3];
+  double w[3];
+  double nP[3];
+  double v[3];
+  double sFactor = 1.0;
+
+  // Use "averaged" segment to create beveled effect.
+  // Watch out for first and last points.
+  for (vtkIdType j = 0; j < npts; j++)
+  {
+    if (j == 0) // first point
+    {
+      par.InPts->GetPoint(pts[0], p);
+      par.InPts->GetPoint(pts[1], pNext);
+      for (int i = 0; i < 3; i++)
+      {
+        sNext[i] = pNext[i] - p[i];
+        sPrev[i] = sNext[i];
+        startCapNormal[i] = -sPrev[i];
+      }
+      vtkMath::Normalize(startCapNormal);
+    }
+    else if (j == (npts - 1)) // last point
+    {
+      for (int i = 0; i < 3; i++)
+      {
+        sPrev[i] = sNext[i];
+        p[i] = pNext[i];
+        endCapNormal[i] = sNext[i];
+      }
+      vtkMath::Normalize(endCapNormal);
+    }
+    else
+    {
+      for (int i = 0; i < 3; i++)
+      {
+        p[i] = pNext[i];
+      }
+      par.InPts->GetPoint(pts[j + 1], pNext);
+      for (int i = 0; i < 3; i++)
+      {
+        sPrev[i] = sNext[i];
+        sNext[i] = pNext[i] - p[i];
+      }
+    }
+
+    if (par.InNormals)
+    {
+      par.InNormals->GetTuple(pts[j], n);
+    }
+    else
+    {
+      lineNormals->GetTuple(j, n);
+    }
+
+    if (vtkMath::Normalize(sNext) == 0.0)
+    {
+      return TUBE_LINE_COINCIDENT_POINTS;
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+      s[i] = (sPrev[i] + sNext[i]) / 2.0; // average vector
+    }
+    // if s is zero then just use sPrev cross n
+    if (vtkMath::Normalize(s) == 0.0)
+    {
+      vtkMath::Cross(sPrev, n, s);
+      vtkMath::Normalize(s);
+    }
+
+    vtkMath::Cross(s, n, w);
+    if (vtkMath::Normalize(w) == 0.0)
+    {
+      return TUBE_LINE_BAD_NORMAL;
+    }
+
+    vtkMath::Cross(w, s, nP); // create orthogonal coordinate system
+    vtkMath::Normalize(nP);
+
+    // Compute a scale factor based on scalars or vectors
+    if (par.InScalars && par.VaryRadius == VTK_VARY_RADIUS_BY_SCALAR)
+    {
+      sFactor = 1.0 +
+        ((par.RadiusFactor - 1.0) * (par.InScalars->GetComponent(pts[j], 0) - par.Range[0]) /
+          (par.Range[1] - par.Range[0]));
+    }
+    else if (par.InVectors && par.VaryRadius == VTK_VARY_RADIUS_BY_VECTOR)
+    {
+      par.InVectors->GetTuple(pts[j], v);
+      sFactor = sqrt(par.MaxSpeed / vtkMath::Norm(v));
+      sFactor = std::min(sFactor, par.RadiusFactor);
+    }
+    else if (par.InVectors && par.VaryRadius == VTK_VARY_RADIUS_BY_VECTOR_NORM)
+    {
+      par.InVectors->GetTuple(pts[j], v);
+      sFactor = 1.0 + (par.RadiusFactor - 1.0) * vtkMath::Norm(v) / par.MaxSpeed;
+    }
+    else if (par.InScalars && par.VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR)
+    {
+      sFactor = par.InScalars->GetComponent(pts[j], 0);
+      if (sFactor < 0.0)
+      {
+        return TUBE_LINE_NEGATIVE_SCALAR;
+      }
+    }
+
+    TubeFrame& frame = frames[j];
+    for (int i = 0; i < 3; i++)
+    {
+      frame.W[i] = w[i];
+      frame.NP[i] = nP[i];
+    }
+    frame.SFactor = sFactor;
+  }
+  return TUBE_LINE_VALID;
+}
+
+// Writes the tubes into the preallocated output arrays. CellId and
+// ConnectivityId are the output ranges of the current line.
+struct TubeArraysOutput
+{
+  vtkPoints* NewPts;
+  vtkFloatArray* NewNormals;
+  vtkFloatArray* NewTCoords;
+  ArrayList* PointArrays;
+  ArrayList* CellArrays;
+  vtkIdType* StripOffsets;
+  vtkIdType* StripConnectivity;
+  vtkIdType CellId;
+  vtkIdType ConnectivityId;
+
+  void SetPoint(vtkIdType ptId, const double x[3], const double normal[3], vtkIdType inPtId)
+  {
+    this->NewPts->SetPoint(ptId, x);
+    this->NewNormals->SetTuple(ptId, normal);
+    this->PointArrays->Copy(inPtId, ptId);
+  }
+
+  void GetPoint(vtkIdType ptId, double x[3]) { this->NewPts->GetPoint(ptId, x); }
+
+  void InsertNextStrip(vtkIdType vtkNotUsed(npts), vtkIdType inCellId)
+  {
+    this->StripOffsets[this->CellId] = this->ConnectivityId;
+    this->CellArrays->Copy(inCellId, this->CellId);
+    ++this->CellId;
+  }
+
+  void InsertStripPoint(vtkIdType ptId) { this->StripConnectivity[this->ConnectivityId++] = ptId; }
+
+  void SetTCoords(vtkIdType ptId, double tc, double tcy)
+  {
+    this->NewTCoords->SetTuple2(ptId, tc, tcy);
+  }
+};
+
+// Inserts the tubes into growing arrays, as done by the deprecated helper
+// methods of vtkTubeFilter.
+struct TubeInsertOutput
+{
+  vtkPoints* NewPts;
+  vtkFloatArray* NewNormals;
+  vtkFloatArray* NewTCoords;
+  vtkPointData* InPD;
+  vtkPointData* OutPD;
+  vtkCellData* InCD;
+  vtkCellData* OutCD;
+  vtkCellArray* NewStrips;
+
+  void SetPoint(vtkIdType ptId, const double x[3], const double normal[3], vtkIdType inPtId)
+  {
+    this->NewPts->InsertPoint(ptId, x);
+    this->NewNormals->InsertTuple(ptId, normal);
+    this->OutPD->CopyData(this->InPD, inPtId, ptId);
+  }
+
+  void GetPoint(vtkIdType ptId, double x[3]) { this->NewPts->GetPoint(ptId, x); }
+
+  void InsertNextStrip(vtkIdType npts, vtkIdType inCellId)
+  {
+    vtkIdType outCellId = this->NewStrips->InsertNextCell(npts);
+    this->OutCD->CopyData(this->InCD, inCellId, outCellId);
+  }
+
+  void InsertStripPoint(vtkIdType ptId) { this->NewStrips->InsertCellPoint(ptId); }
+
+  void SetTCoords(vtkIdType ptId, double tc, double tcy)
+  {
+    this->NewTCoords->InsertTuple2(ptId, tc, tcy);
+  }
+};
+
+// Create the points around a line from its frames, starting at offset. The
+// points of the caps are placed at the tail end of the points.
+template <typename TubeOutput>
+void GenerateTubePoints(const TubeParameters& par, vtkIdType npts, const vtkIdType* pts,
+  const TubeFrame* frames, const double startCapNormal[3], const double endCapNormal[3],
+  vtkIdType offset, TubeOutput& output)
+{
+  double p[3], normal[3], s[3];
+  vtkIdType ptId = offset;
+
+  for (vtkIdType j = 0; j < npts; j++)
+  {
+    par.InPts->GetPoint(pts[j], p);
+    const double* w = frames[j].W;
+    const double* nP = frames[j].NP;
+    const double sFactor = frames[j].SFactor;
+    if (par.SidesShareVertices)
+    {
+      for (int k = 0; k < par.NumberOfSides; k++)
+      {
+        for (int i = 0; i < 3; i++)
+        {
+          normal[i] = w[i] * cos((double)k * par.Theta) + nP[i] * sin((double)k * par.Theta);
+          s[i] = p[i] + par.Radius * sFactor * normal[i];
+        }
+        output.SetPoint(ptId, s, normal, pts[j]);
+        ptId++;
+      } // for each side
+    }
+    else
+    {
+      double n_left[3], n_right[3];
+      for (int k = 0; k < par.NumberOfSides; k++)
+      {
+        for (int i = 0; i < 3; i++)
+        {
+          // Create duplicate vertices at each point
+          // and adjust the associated normals so that they are
+          // oriented with the facets. This preserves the tube's
+          // polygonal appearance, as if by flat-shading around the tube,
+          // while still allowing smooth (gouraud) shading along the
+          // tube as it bends.
+          normal[i] = w[i] * cos((double)(k + 0.0) * par.Theta) +
+            nP[i] * sin((double)(k + 0.0) * par.Theta);
+          n_right[i] = w[i] * cos((double)(k - 0.5) * par.Theta) +
+            nP[i] * sin((double)(k - 0.5) * par.Theta);
+          n_left[i] = w[i] * cos((double)(k + 0.5) * par.Theta) +
+            nP[i] * sin((double)(k + 0.5) * par.Theta);
+          s[i] = p[i] + par.Radius * sFactor * normal[i];
+        }
+        output.SetPoint(ptId, s, n_right, pts[j]);
+        output.SetPoint(ptId + 1, s, n_left, pts[j]);
+        ptId += 2;
+      } // for each side
+    }   // else separate vertices
+  }     // for all points in polyline
+
+  // Produce end points for cap. They are placed at tail end of points.
+  if (par.Capping)
+  {
+    const int numCapSides = par.SidesShareVertices ? par.NumberOfSides : 2 * par.NumberOfSides;
+    const int capIncr = par.SidesShareVertices ? 1 : 2;
+
+    // the start cap
+    for (int k = 0; k < numCapSides; k += capIncr)
+    {
+      output.GetPoint(offset + k, s);
+      output.SetPoint(ptId, s, startCapNormal, pts[0]);
+      ptId++;
+    }
+    // the end cap
+    const vtkIdType endOffset = offset + (npts - 1) * numCapSides;
+    for (int k = 0; k < numCapSides; k += capIncr)
+    {
+      output.GetPoint(endOffset + k, s);
+      output.SetPoint(ptId, s, endCapNormal, pts[npts - 1]);
+      ptId++;
+    }
+  } // if capping
+}
+
+// Create the strips of the sides of a line whose points start at offset,
+// followed by the strips of its caps.
+template <typename TubeOutput>
+void GenerateTubeStrips(const TubeParameters& par, vtkIdType npts, vtkIdType offset,
+  vtkIdType inCellId, TubeOutput& output)
+{
+  const int numSidePts = par.SidesShareVertices ? par.NumberOfSides : 2 * par.NumberOfSides;
+  for (int k = par.Offset; k < (par.NumberOfSides + par.Offset); k += par.OnRatio)
+  {
+    int i1, i2;
+    if (par.SidesShareVertices)
+    {
+      i1 = k % par.NumberOfSides;
+      i2 = (k + 1) % par.NumberOfSides;
+    }
+    else
+    {
+      i1 = 2 * (k % par.NumberOfSides) + 1;
+      i2 = 2 * ((k + 1) % par.NumberOfSides);
+    }
+    output.InsertNextStrip(npts * 2, inCellId);
+    for (vtkIdType i = 0; i < npts; i++)
+    {
+      const vtkIdType i3 = i * numSidePts;
+      output.InsertStripPoint(offset + i2 + i3);
+      output.InsertStripPoint(offset + i1 + i3);
+    }
+  } // for each side of the tube
+
+  // Take care of capping. The caps are n-sided polygons that can be
+  // easily triangle stripped.
+  if (par.Capping)
+  {
+    vtkIdType startIdx = offset + npts * numSidePts;
+    int i1, i2, k;
+
+    // The start cap
+    output.InsertNextStrip(par.NumberOfSides, inCellId);
+    output.InsertStripPoint(startIdx);
+    output.InsertStripPoint(startIdx + 1);
+    for (i1 = par.NumberOfSides - 1, i2 = 2, k = 0; k < (par.NumberOfSides - 2); k++)
+    {
+      output.InsertStripPoint((k % 2) ? startIdx + i2++ : startIdx + i1--);
+    }
+
+    // The end cap - reversed order to be consistent with normal
+    startIdx += par.NumberOfSides;
+    output.InsertNextStrip(par.NumberOfSides, inCellId);
+    output.InsertStripPoint(startIdx);
+    output.InsertStripPoint(startIdx + par.NumberOfSides - 1);
+    for (i1 = par.NumberOfSides - 2, i2 = 1, k = 0; k < (par.NumberOfSides - 2); k++)
+    {
+      output.InsertStripPoint((k % 2) ? startIdx + i1-- : startIdx + i2++);
+    }
+  }
+}
+
+// Create the texture coordinates of the points of a line starting at offset.
+template <typename TubeOutput>
+void GenerateTubeTextureCoords(const TubeParameters& par, vtkIdType npts, const vtkIdType* pts,
+  vtkIdType offset, TubeOutput& output)
+{
+  const int numSides = par.SidesShareVertices ? par.NumberOfSides : 2 * par.NumberOfSides;
+  double tc = 0.0;
+
+  auto setTCoords = [&](vtkIdType i)
+  {
+    for (int k = 0; k < numSides; k++)
+    {
+      double tcy = static_cast<double>(k) / (numSides - 1);
+      output.SetTCoords(offset + i * numSides + k, tc, tcy);
+    }
+  };
+
+  if (par.GenerateTCoords == VTK_TCOORDS_FROM_SCALARS)
+  {
+    const double s0 = par.InScalars->GetTuple1(pts[0]);
+    for (vtkIdType i = 0; i < npts; i++)
+    {
+      tc = (par.InScalars->GetTuple1(pts[i]) - s0) / par.TextureLength;
+      setTCoords(i);
+    }
+  }
+  else if (par.GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ||
+    par.GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
+  {
+    double xPrev[3], x[3], length = 0.0, len = 0.0;
+    if (par.GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
+    {
+      par.InPts->GetPoint(pts[0], xPrev);
+      for (vtkIdType i = 0; i < npts; i++)
+      {
+        par.InPts->GetPoint(pts[i], x);
+        length += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
+        xPrev[0] = x[0];
+        xPrev[1] = x[1];
+        xPrev[2] = x[2];
+      }
+    }
+
+    par.InPts->GetPoint(pts[0], xPrev);
+    for (vtkIdType i = 0; i < npts; i++)
+    {
+      par.InPts->GetPoint(pts[i], x);
+      len += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
+      tc = par.GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ? len / par.TextureLength
+                                                          : len / length;
+      setTCoords(i);
+      xPrev[0] = x[0];
+      xPrev[1] = x[1];
+      xPrev[2] = x[2];
+    }
+  }
+
+  // Capping, set the endpoints as appropriate
+  if (par.Capping)
+  {
+    const vtkIdType startIdx = offset + npts * numSides;
+    for (int ik = 0; ik < par.NumberOfSides; ik++)
+    {
+      output.SetTCoords(startIdx + ik, 0.0, 0.0);
+    }
+    for (int ik = 0; ik < par.NumberOfSides; ik++)
+    {
+      output.SetTCoords(startIdx + par.NumberOfSides + ik, tc, 0.0);
+    }
+  }
+}
+
+// Point ids and frames of all the lines, computed by the counting pass and
+// used by the generation pass. The point ids and frames of a line are stored
+// at the offset of the line in the input connectivity.
+struct TubeLines
+{
+  std::vector<unsigned char> Status;
+  std::vector<vtkIdType> NumberOfPoints; // without consecutive duplicates
+  std::unique_ptr<vtkIdType[]> Ids;
+  std::unique_ptr<TubeFrame[]> Frames;
+  std::vector<double> CapNormals; // start and end cap normals of each line
+
+  TubeLines(vtkCellArray* lines)
+    : Status(lines->GetNumberOfCells())
+    , NumberOfPoints(lines->GetNumberOfCells())
+    , Ids(new vtkIdType[lines->GetNumberOfConnectivityIds()])
+    , Frames(new TubeFrame[lines->GetNumberOfConnectivityIds()])
+    , CapNormals(6 * lines->GetNumberOfCells())
+  {
+  }
+};
+
+// Thread local storage used to compute the sliding normals of a line on a
+// copy of it, so that lines sharing points do not conflict.
+struct SlidingNormals
+{
+  vtkSmartPointer<vtkIdList> CellIds;
+  std::vector<vtkIdType> LocalIds;
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkCellArray> Polyline;
+  vtkSmartPointer<vtkFloatArray> Normals;
+
+  void Initialize()
+  {
+    this->CellIds = vtkSmartPointer<vtkIdList>::New();
+    this->Points = vtkSmartPointer<vtkPoints>::New();
+    this->Points->SetDataTypeToDouble();
+    this->Polyline = vtkSmartPointer<vtkCellArray>::New();
+    this->Normals = vtkSmartPointer<vtkFloatArray>::New();
+    this->Normals->SetNumberOfComponents(3);
+  }
+
+  vtkDataArray* Compute(vtkPoints* inPts, vtkIdType npts, const vtkIdType* pts)
+  {
+    this->Points->SetNumberOfPoints(npts);
+    this->LocalIds.resize(npts);
+    double x[3];
+    for (vtkIdType j = 0; j < npts; ++j)
+    {
+      inPts->GetPoint(pts[j], x);
+      this->Points->SetPoint(j, x);
+      this->LocalIds[j] = j;
+    }
+    this->Polyline->Reset();
+    this->Polyline->InsertNextCell(npts, this->LocalIds.data());
+    vtkPolyLine::GenerateSlidingNormals(this->Points, this->Polyline, this->Normals);
+    return this->Normals;
+  }
+};
+
+// First pass of the tube generation: compute the frames of each line and
+// count its output points, strips and strip connectivity.
+struct CountTubes
+{
+  const TubeParameters& Parameters;
+  vtkCellArray* Lines;
+  vtkTubeFilter* Filter;
+  TubeLines& Tubes;
+  vtkIdType* NumberOfPoints;
+  vtkIdType* NumberOfCells;
+  vtkIdType* ConnectivitySize;
+  vtkSMPThreadLocal<SlidingNormals> Normals;
+
+  CountTubes(const TubeParameters& parameters, vtkCellArray* lines, vtkTubeFilter* filter,
+    TubeLines& tubes, vtkIdType* numPts, vtkIdType* numCells, vtkIdType* connSize)
+    : Parameters(parameters)
+    , Lines(lines)
+    , Filter(filter)
+    , Tubes(tubes)
+    , NumberOfPoints(numPts)
+    , NumberOfCells(numCells)
+    , ConnectivitySize(connSize)
+  {
+  }
+
+  void Initialize() { this->Normals.Local().Initialize(); }
+
+  void operator()(vtkIdType lineId, vtkIdType endLineId)
+  {
+    const TubeParameters& par = this->Parameters;
+    SlidingNormals& normals = this->Normals.Local();
+    const vtkIdType numSideStrips = (par.NumberOfSides + par.OnRatio - 1) / par.OnRatio;
+    const int numSidePts = par.SidesShareVertices ? par.NumberOfSides : 2 * par.NumberOfSides;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+
+    for (; lineId < endLineId; ++lineId)
+    {
+      if (isFirst)
+      {
+        this->Filter->CheckAbort();
+      }
+      if (this->Filter->GetAbortOutput())
+      {
+        break;
+      }
+      this->NumberOfPoints[lineId] = 0;
+      this->NumberOfCells[lineId] = 0;
+      this->ConnectivitySize[lineId] = 0;
+
+      // Remove degenerate lines to avoid warnings
+      vtkIdType npts;
+      const vtkIdType* ptsOrig;
+      this->Lines->GetCellAtId(lineId, npts, ptsOrig, normals.CellIds);
+      const vtkIdType lineOffset = this->Lines->GetOffset(lineId);
+      vtkIdType* pts = this->Tubes.Ids.get() + lineOffset;
+      std::copy(ptsOrig, ptsOrig + npts, pts);
+      npts = static_cast<vtkIdType>(std::unique(pts, pts + npts, IdPointsEqual(par.InPts)) - pts);
+      this->Tubes.NumberOfPoints[lineId] = npts;
+      if (npts < 2)
+      {
+        this->Tubes.Status[lineId] = TUBE_LINE_SKIPPED;
+        continue;
+      }
+
+      double* capNormals = this->Tubes.CapNormals.data() + 6 * lineId;
+      this->Tubes.Status[lineId] = ComputeTubeFrames(par, npts, pts,
+        par.InNormals ? nullptr : normals.Compute(par.InPts, npts, pts),
+        this->Tubes.Frames.get() + lineOffset, capNormals, capNormals + 3);
+      if (this->Tubes.Status[lineId] != TUBE_LINE_VALID)
+      {
+        continue;
+      }
+      this->NumberOfPoints[lineId] = numSidePts * npts;
+      this->NumberOfCells[lineId] = numSideStrips;
+      this->ConnectivitySize[lineId] = numSideStrips * 2 * npts;
+      if (par.Capping)
+      {
+        this->NumberOfPoints[lineId] += 2 * par.NumberOfSides;
+        this->NumberOfCells[lineId] += 2;
+        this->ConnectivitySize[lineId] += 2 * par.NumberOfSides;
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Second pass of the tube generation: each valid line writes its points,
+// normals, texture coordinates, strips and attributes at the offsets
+// computed from the first pass.
+struct GenerateTubesWorker
+{
+  const TubeParameters& Parameters;
+  vtkCellArray* Lines;
+  vtkIdType FirstLineCellId;
+  const TubeLines& Tubes;
+  const vtkIdType* PointOffsets;
+  const vtkIdType* CellOffsets;
+  const vtkIdType* ConnectivityOffsets;
+  TubeArraysOutput Output;
+
+  void operator()(vtkIdType lineId, vtkIdType endLineId)
+  {
+    const TubeParameters& par = this->Parameters;
+    TubeArraysOutput output = this->Output;
+    for (; lineId < endLineId; ++lineId)
+    {
+      if (this->Tubes.Status[lineId] != TUBE_LINE_VALID)
+      {
+        continue;
+      }
+      const vtkIdType npts = this->Tubes.NumberOfPoints[lineId];
+      const vtkIdType lineOffset = this->Lines->GetOffset(lineId);
+      const vtkIdType* pts = this->Tubes.Ids.get() + lineOffset;
+      const double* capNormals = this->Tubes.CapNormals.data() + 6 * lineId;
+      const vtkIdType offset = this->PointOffsets[lineId];
+      GenerateTubePoints(par, npts, pts, this->Tubes.Frames.get() + lineOffset, capNormals,
+        capNormals + 3, offset, output);
+      output.CellId = this->CellOffsets[lineId];
+      output.ConnectivityId = this->ConnectivityOffsets[lineId];
+      GenerateTubeStrips(par, npts, offset, this->FirstLineCellId + lineId, output);
+      if (output.NewTCoords)
+      {
+        GenerateTubeTextureCoords(par, npts, pts, offset, output);
+      }
+    }
+  }
+};
+
 }
 
 int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
@@ -101,14 +780,9 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
   int deleteNormals = 0;
   vtkFloatArray* newNormals;
   vtkIdType i;
-  double range[2], maxSpeed = 0;
+  double range[2] = { 0.0, 1.0 }, maxSpeed = 0;
   vtkCellArray* newStrips;
-  vtkIdType npts = 0;
-  const vtkIdType* ptsOrig = nullptr;
-  vtkIdType offset = 0;
   vtkFloatArray* newTCoords = nullptr;
-  bool abort = false;
-  vtkIdType inCellId;
   double oldRadius = 1.0;
 
   // Check input and initialize
@@ -139,14 +813,10 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
     newPts->SetDataType(VTK_DOUBLE);
   }
 
-  newPts->Allocate(numNewPts);
   newNormals = vtkFloatArray::New();
   newNormals->SetName("TubeNormals");
   newNormals->SetNumberOfComponents(3);
-  newNormals->Allocate(3 * numNewPts);
   newStrips = vtkCellArray::New();
-  newStrips->AllocateEstimate(1, numNewPts);
-  vtkCellArray* singlePolyline = vtkCellArray::New();
 
   // Point data: copy scalars, vectors, tcoords. Normals may be computed here.
   outPD->CopyNormalsOff();
@@ -156,34 +826,28 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
   {
     newTCoords = vtkFloatArray::New();
     newTCoords->SetNumberOfComponents(2);
-    newTCoords->Allocate(numNewPts);
     outPD->CopyTCoordsOff();
   }
   outPD->CopyAllocate(pd, numNewPts);
 
-  int generateNormals = 0;
-  if (!(inNormals = pd->GetNormals()) || this->UseDefaultNormal)
+  if (this->UseDefaultNormal)
   {
     deleteNormals = 1;
     inNormals = vtkFloatArray::New();
     inNormals->SetNumberOfComponents(3);
     inNormals->SetNumberOfTuples(numPts);
-
-    if (this->UseDefaultNormal)
-    {
-      for (i = 0; i < numPts; i++)
-      {
-        inNormals->SetTuple(i, this->DefaultNormal);
-      }
-    }
-    else
+    for (i = 0; i < numPts; i++)
     {
-      // Normal generation has been moved to lower in the function.
-      // This allows each different polylines to share vertices, but have
-      // their normals (and hence their tubes) calculated independently
-      generateNormals = 1;
+      inNormals->SetTuple(i, this->DefaultNormal);
     }
   }
+  else
+  {
+    // Without input normals, sliding normals are generated for each line.
+    // This allows each different polylines to share vertices, but have
+    // their normals (and hence their tubes) calculated independently
+    inNormals = pd->GetNormals();
+  }
 
   // If varying width, get appropriate info.
   //
@@ -224,73 +888,20 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
   //  triangle strips. Texture coordinates are optionally generated.
   //
   this->Theta = 2.0 * vtkMath::Pi() / this->NumberOfSides;
-  vtkPolyLine* lineNormalGenerator = vtkPolyLine::New();
-  // the line cellIds start after the last vert cellId
-  inCellId = input->GetNumberOfVerts();
-  int checkAbortInterval = std::min(numLines / 10 + 1, (vtkIdType)1000);
-  int progressCounter = 0;
-  for (inLines->InitTraversal(); inLines->GetNextCell(npts, ptsOrig) && !abort; inCellId++)
+  if (this->SequentialProcessing)
   {
-    this->UpdateProgress((double)inCellId / numLines);
-    if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
-    {
-      abort = this->CheckAbort();
-      break;
-    }
-    progressCounter++;
-
-    // Make a copy of point indices to avoid modifying input polydata cells
-    // while removing degenerate lines.
-    if (npts < 2)
-    {
-      continue; // skip tubing this polyline
-    }
-    std::vector<vtkIdType> ptsCopy(ptsOrig, ptsOrig + npts);
-    vtkIdType* pts = ptsCopy.data();
-
-    // remove degenerate lines to avoid warnings
-    npts = static_cast<vtkIdType>(std::unique(pts, pts + npts, IdPointsEqual(inPts)) - pts);
-    if (npts < 2)
-    {
-      continue; // skip tubing this polyline
-    }
-
-    // If necessary calculate normals, each polyline calculates its
-    // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
-    {
-      singlePolyline->Reset(); // avoid instantiation
-      singlePolyline->InsertNextCell(npts, pts);
-      vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals);
-    }
-
-    // Generate the points around the polyline. The tube is not stripped
-    // if the polyline is bad.
-    //
-    if (!this->GeneratePoints(offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars,
-          range, inVectors, maxSpeed, inNormals))
-    {
-      vtkWarningMacro(<< "Could not generate points!");
-      continue; // skip tubing this polyline
-    }
-
-    // Generate the strips for this polyline (including caps)
-    //
-    this->GenerateStrips(offset, npts, pts, inCellId, cd, outCD, newStrips);
-
-    // Generate the texture coordinates for this polyline
-    //
-    if (newTCoords)
-    {
-      this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
-    }
-
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset, npts);
-
-  } // for all polylines
-
-  singlePolyline->Delete();
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1, "Sequential", false },
+      [&]()
+      {
+        this->GenerateTubes(input, output, inNormals, inScalars, range, inVectors, maxSpeed,
+          newPts, newNormals, newTCoords, newStrips);
+      });
+  }
+  else
+  {
+    this->GenerateTubes(input, output, inNormals, inScalars, range, inVectors, maxSpeed, newPts,
+      newNormals, newTCoords, newStrips);
+  }
 
   // reset the radius to ite original value if necessary
   if (this->VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR)
@@ -319,236 +930,108 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
   outPD->SetNormals(newNormals);
   newNormals->Delete();
-  lineNormalGenerator->Delete();
 
   output->Squeeze();
 
   return 1;
 }
 
+void vtkTubeFilter::GenerateTubes(vtkPolyData* input, vtkPolyData* output,
+  vtkDataArray* inNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors,
+  double maxSpeed, vtkPoints* newPts, vtkFloatArray* newNormals, vtkFloatArray* newTCoords,
+  vtkCellArray* newStrips)
+{
+  vtkCellArray* inLines = input->GetLines();
+  const vtkIdType numLines = inLines->GetNumberOfCells();
+  TubeParameters parameters = MakeTubeParameters(this, this->Theta);
+  parameters.InPts = input->GetPoints();
+  parameters.InNormals = inNormals;
+  parameters.InScalars = inScalars;
+  parameters.InVectors = inVectors;
+  parameters.Range[0] = range[0];
+  parameters.Range[1] = range[1];
+  parameters.MaxSpeed = maxSpeed;
+
+  // Compute the frames of the lines and count their output, then turn the
+  // counts into offsets in the output arrays.
+  TubeLines tubes(inLines);
+  std::vector<vtkIdType> pointOffsets(numLines + 1, 0);
+  std::vector<vtkIdType> cellOffsets(numLines + 1, 0);
+  std::vector<vtkIdType> connOffsets(numLines + 1, 0);
+  CountTubes count(parameters, inLines, this, tubes, pointOffsets.data(), cellOffsets.data(),
+    connOffsets.data());
+  vtkSMPTools::For(0, numLines, count);
+  if (this->GetAbortOutput())
+  {
+    return;
+  }
+  for (vtkIdType lineId = 0; lineId < numLines; ++lineId)
+  {
+    WarnTubeLine(this, tubes.Status[lineId]);
+  }
+  vtkSMPTools::ExclusiveScan(
+    pointOffsets.begin(), pointOffsets.end(), pointOffsets.begin(), vtkIdType(0));
+  vtkSMPTools::ExclusiveScan(
+    cellOffsets.begin(), cellOffsets.end(), cellOffsets.begin(), vtkIdType(0));
+  vtkSMPTools::ExclusiveScan(
+    connOffsets.begin(), connOffsets.end(), connOffsets.begin(), vtkIdType(0));
+  const vtkIdType numNewPts = pointOffsets[numLines];
+  const vtkIdType numNewCells = cellOffsets[numLines];
+  this->UpdateProgress(0.5);
+
+  // Generate the tubes into the preallocated arrays
+  newPts->SetNumberOfPoints(numNewPts);
+  newNormals->SetNumberOfTuples(numNewPts);
+  if (newTCoords)
+  {
+    newTCoords->SetNumberOfTuples(numNewPts);
+  }
+  vtkNew<vtkIdTypeArray> stripOffsets;
+  stripOffsets->SetNumberOfValues(numNewCells + 1);
+  stripOffsets->SetValue(numNewCells, connOffsets[numLines]);
+  vtkNew<vtkIdTypeArray> stripConnectivity;
+  stripConnectivity->SetNumberOfValues(connOffsets[numLines]);
+
+  ArrayList pointArrays;
+  pointArrays.AddArrays(numNewPts, input->GetPointData(), output->GetPointData(), 0.0,
+    /*promote=*/false);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(numNewCells, input->GetCellData(), output->GetCellData(), 0.0,
+    /*promote=*/false);
+
+  GenerateTubesWorker generate{ parameters, inLines, input->GetNumberOfVerts(), tubes,
+    pointOffsets.data(), cellOffsets.data(), connOffsets.data(),
+    { newPts, newNormals, newTCoords, &pointArrays, &cellArrays, stripOffsets->GetPointer(0),
+      stripConnectivity->GetPointer(0), 0, 0 } };
+  vtkSMPTools::For(0, numLines, generate);
+  newStrips->SetData(stripOffsets, stripConnectivity);
+}
+
 int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
   vtkPoints* inPts, vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD,
   vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors,
   double maxSpeed, vtkDataArray* inNormals)
 {
-  vtkIdType j;
-  int i, k;
-  double p[3];
-  double pNext[3];
-  double sNext[3] = { 0.0, 0.0, 0.0 };
-  double sPrev[3];
-  double startCapNorm[3], endCapNorm[3];
-  double n[3];
-  double s[3];
-  // double bevelAngle;
-  double w[3];
-  double nP[3];
-  double sFactor = 1.0;
-  double normal[3];
-  vtkIdType ptId = offset;
-
-  // Use "averaged" segment to create beveled effect.
-  // Watch out for first and last points.
-  //
-  for (j = 0; j < npts; j++)
-  {
-    if (j == 0) // first point
-    {
-      inPts->GetPoint(pts[0], p);
-      inPts->GetPoint(pts[1], pNext);
-      for (i = 0; i < 3; i++)
-      {
-        sNext[i] = pNext[i] - p[i];
-        sPrev[i] = sNext[i];
-        startCapNorm[i] = -sPrev[i];
-      }
-      vtkMath::Normalize(startCapNorm);
-    }
-    else if (j == (npts - 1)) // last point
-    {
-      for (i = 0; i < 3; i++)
-      {
-        sPrev[i] = sNext[i];
-        p[i] = pNext[i];
-        endCapNorm[i] = sNext[i];
-      }
-      vtkMath::Normalize(endCapNorm);
-    }
-    else
-    {
-      for (i = 0; i < 3; i++)
-      {
-        p[i] = pNext[i];
-      }
-      inPts->GetPoint(pts[j + 1], pNext);
-      for (i = 0; i < 3; i++)
-      {
-        sPrev[i] = sNext[i];
-        sNext[i] = pNext[i] - p[i];
-      }
-    }
-
-    inNormals->GetTuple(pts[j], n);
-
-    if (vtkMath::Normalize(sNext) == 0.0)
-    {
-      vtkWarningMacro(<< "Coincident points!");
-      return 0;
-    }
-
-    for (i = 0; i < 3; i++)
-    {
-      s[i] = (sPrev[i] + sNext[i]) / 2.0; // average vector
-    }
-    // if s is zero then just use sPrev cross n
-    if (vtkMath::Normalize(s) == 0.0)
-    {
-      vtkDebugMacro(<< "Using alternate bevel vector");
-      vtkMath::Cross(sPrev, n, s);
-      if (vtkMath::Normalize(s) == 0.0)
-      {
-        vtkDebugMacro(<< "Using alternate bevel vector");
-      }
-    }
-
-    /*    if ( (bevelAngle = vtkMath::Dot(sNext,sPrev)) > 1.0 )
-          {
-          bevelAngle = 1.0;
-          }
-        if ( bevelAngle < -1.0 )
-          {
-          bevelAngle = -1.0;
-          }
-        bevelAngle = acos((double)bevelAngle) / 2.0; //(0->90 degrees)
-        if ( (bevelAngle = cos(bevelAngle)) == 0.0 )
-          {
-          bevelAngle = 1.0;
-          }
-
-        bevelAngle = this->Radius / bevelAngle; //keep tube constant radius
-    */
-    vtkMath::Cross(s, n, w);
-    if (vtkMath::Normalize(w) == 0.0)
-    {
-      vtkWarningMacro(<< "Bad normal s = " << s[0] << " " << s[1] << " " << s[2] << " n = " << n[0]
-                      << " " << n[1] << " " << n[2]);
-      return 0;
-    }
-
-    vtkMath::Cross(w, s, nP); // create orthogonal coordinate system
-    vtkMath::Normalize(nP);
-
-    // Compute a scale factor based on scalars or vectors
-    if (inScalars && this->VaryRadius == VTK_VARY_RADIUS_BY_SCALAR)
-    {
-      sFactor = 1.0 +
-        ((this->RadiusFactor - 1.0) * (inScalars->GetComponent(pts[j], 0) - range[0]) /
-          (range[1] - range[0]));
-    }
-    else if (inVectors && this->VaryRadius == VTK_VARY_RADIUS_BY_VECTOR)
-    {
-      sFactor = sqrt(maxSpeed / vtkMath::Norm(inVectors->GetTuple(pts[j])));
-      sFactor = std::min(sFactor, this->RadiusFactor);
-    }
-    else if (inVectors && this->VaryRadius == VTK_VARY_RADIUS_BY_VECTOR_NORM)
-    {
-      sFactor =
-        1.0 + (this->RadiusFactor - 1.0) * vtkMath::Norm(inVectors->GetTuple(pts[j])) / maxSpeed;
-    }
-    else if (inScalars && this->VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR)
-    {
-      sFactor = inScalars->GetComponent(pts[j], 0);
-      if (sFactor < 0.0)
-      {
-        vtkWarningMacro(<< "Scalar value less than zero, skipping line");
-        return 0;
-      }
-    }
-
-    // create points around line
-    if (this->SidesShareVertices)
-    {
-      for (k = 0; k < this->NumberOfSides; k++)
-      {
-        for (i = 0; i < 3; i++)
-        {
-          normal[i] = w[i] * cos((double)k * this->Theta) + nP[i] * sin((double)k * this->Theta);
-          s[i] = p[i] + this->Radius * sFactor * normal[i];
-        }
-        newPts->InsertPoint(ptId, s);
-        newNormals->InsertTuple(ptId, normal);
-        outPD->CopyData(pd, pts[j], ptId);
-        ptId++;
-      } // for each side
-    }
-    else
-    {
-      double n_left[3], n_right[3];
-      for (k = 0; k < this->NumberOfSides; k++)
-      {
-        for (i = 0; i < 3; i++)
-        {
-          // Create duplicate vertices at each point
-          // and adjust the associated normals so that they are
-          // oriented with the facets. This preserves the tube's
-          // polygonal appearance, as if by flat-shading around the tube,
-          // while still allowing smooth (gouraud) shading along the
-          // tube as it bends.
-          normal[i] = w[i] * cos((double)(k + 0.0) * this->Theta) +
-            nP[i] * sin((double)(k + 0.0) * this->Theta);
-          n_right[i] = w[i] * cos((double)(k - 0.5) * this->Theta) +
-            nP[i] * sin((double)(k - 0.5) * this->Theta);
-          n_left[i] = w[i] * cos((double)(k + 0.5) * this->Theta) +
-            nP[i] * sin((double)(k + 0.5) * this->Theta);
-          s[i] = p[i] + this->Radius * sFactor * normal[i];
-        }
-        newPts->InsertPoint(ptId, s);
-        newNormals->InsertTuple(ptId, n_right);
-        outPD->CopyData(pd, pts[j], ptId);
-        newPts->InsertPoint(ptId + 1, s);
-        newNormals->InsertTuple(ptId + 1, n_left);
-        outPD->CopyData(pd, pts[j], ptId + 1);
-        ptId += 2;
-      } // for each side
-    }   // else separate vertices
-  }     // for all points in polyline
-
-  // Produce end points for cap. They are placed at tail end of points.
-  if (this->Capping)
+  TubeParameters par = MakeTubeParameters(this, this->Theta);
+  par.InPts = inPts;
+  par.InNormals = inNormals;
+  par.InScalars = inScalars;
+  par.InVectors = inVectors;
+  par.Range[0] = range[0];
+  par.Range[1] = range[1];
+  par.MaxSpeed = maxSpeed;
+
+  std::vector<TubeFrame> frames(npts);
+  double startCapNormal[3], endCapNormal[3];
+  TubeLineStatus status =
+    ComputeTubeFrames(par, npts, pts, nullptr, frames.data(), startCapNormal, endCapNormal);
+  if (status != TUBE_LINE_VALID)
   {
-    int numCapSides = this->NumberOfSides;
-    int capIncr = 1;
-    if (!this->SidesShareVertices)
-    {
-      numCapSides = 2 * this->NumberOfSides;
-      capIncr = 2;
-    }
-
-    // the start cap
-    for (k = 0; k < numCapSides; k += capIncr)
-    {
-      newPts->GetPoint(offset + k, s);
-      newPts->InsertPoint(ptId, s);
-      newNormals->InsertTuple(ptId, startCapNorm);
-      outPD->CopyData(pd, pts[0], ptId);
-      ptId++;
-    }
-    // the end cap
-    int endOffset = offset + (npts - 1) * this->NumberOfSides;
-    if (!this->SidesShareVertices)
-    {
-      endOffset = offset + 2 * (npts - 1) * this->NumberOfSides;
-    }
-    for (k = 0; k < numCapSides; k += capIncr)
-    {
-      newPts->GetPoint(endOffset + k, s);
-      newPts->InsertPoint(ptId, s);
-      newNormals->InsertTuple(ptId, endCapNorm);
-      outPD->CopyData(pd, pts[npts - 1], ptId);
-      ptId++;
-    }
-  } // if capping
-
+    WarnTubeLine(this, status);
+    return 0;
+  }
+  TubeInsertOutput output{ newPts, newNormals, nullptr, pd, outPD, nullptr, nullptr, nullptr };
+  GenerateTubePoints(par, npts, pts, frames.data(), startCapNormal, endCapNormal, offset, output);
   return 1;
 }
 
@@ -556,196 +1039,20 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
   const vtkIdType* vtkNotUsed(pts), vtkIdType inCellId, vtkCellData* cd, vtkCellData* outCD,
   vtkCellArray* newStrips)
 {
-  vtkIdType i, outCellId;
-  int k;
-  int i1, i2, i3;
-
-  if (this->SidesShareVertices)
-  {
-    for (k = this->Offset; k < (this->NumberOfSides + this->Offset); k += this->OnRatio)
-    {
-      i1 = k % this->NumberOfSides;
-      i2 = (k + 1) % this->NumberOfSides;
-      outCellId = newStrips->InsertNextCell(npts * 2);
-      outCD->CopyData(cd, inCellId, outCellId);
-      for (i = 0; i < npts; i++)
-      {
-        i3 = i * this->NumberOfSides;
-        newStrips->InsertCellPoint(offset + i2 + i3);
-        newStrips->InsertCellPoint(offset + i1 + i3);
-      }
-    } // for each side of the tube
-  }
-  else
-  {
-    for (k = this->Offset; k < (this->NumberOfSides + this->Offset); k += this->OnRatio)
-    {
-      i1 = 2 * (k % this->NumberOfSides) + 1;
-      i2 = 2 * ((k + 1) % this->NumberOfSides);
-      outCellId = newStrips->InsertNextCell(npts * 2);
-      outCD->CopyData(cd, inCellId, outCellId);
-      for (i = 0; i < npts; i++)
-      {
-        i3 = i * 2 * this->NumberOfSides;
-        newStrips->InsertCellPoint(offset + i2 + i3);
-        newStrips->InsertCellPoint(offset + i1 + i3);
-      }
-    } // for each side of the tube
-  }
-
-  // Take care of capping. The caps are n-sided polygons that can be
-  // easily triangle stripped.
-  if (this->Capping)
-  {
-    vtkIdType startIdx = offset + npts * this->NumberOfSides;
-    vtkIdType idx;
-
-    if (!this->SidesShareVertices)
-    {
-      startIdx = offset + 2 * npts * this->NumberOfSides;
-    }
-
-    // The start cap
-    outCellId = newStrips->InsertNextCell(this->NumberOfSides);
-    outCD->CopyData(cd, inCellId, outCellId);
-    newStrips->InsertCellPoint(startIdx);
-    newStrips->InsertCellPoint(startIdx + 1);
-    for (i1 = this->NumberOfSides - 1, i2 = 2, k = 0; k < (this->NumberOfSides - 2); k++)
-    {
-      if ((k % 2))
-      {
-        idx = startIdx + i2;
-        newStrips->InsertCellPoint(idx);
-        i2++;
-      }
-      else
-      {
-        idx = startIdx + i1;
-        newStrips->InsertCellPoint(idx);
-        i1--;
-      }
-    }
-
-    // The end cap - reversed order to be consistent with normal
-    startIdx += this->NumberOfSides;
-    outCellId = newStrips->InsertNextCell(this->NumberOfSides);
-    outCD->CopyData(cd, inCellId, outCellId);
-    newStrips->InsertCellPoint(startIdx);
-    newStrips->InsertCellPoint(startIdx + this->NumberOfSides - 1);
-    for (i1 = this->NumberOfSides - 2, i2 = 1, k = 0; k < (this->NumberOfSides - 2); k++)
-    {
-      if ((k % 2))
-      {
-        idx = startIdx + i1;
-        newStrips->InsertCellPoint(idx);
-        i1--;
-      }
-      else
-      {
-        idx = startIdx + i2;
-        newStrips->InsertCellPoint(idx);
-        i2++;
-      }
-    }
-  }
+  TubeParameters par = MakeTubeParameters(this, this->Theta);
+  TubeInsertOutput output{ nullptr, nullptr, nullptr, nullptr, nullptr, cd, outCD, newStrips };
+  GenerateTubeStrips(par, npts, offset, inCellId, output);
 }
 
 void vtkTubeFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
   vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords)
 {
-  vtkIdType i;
-  int k;
-  double tc = 0.0;
-
-  int numSides = this->NumberOfSides;
-  if (!this->SidesShareVertices)
-  {
-    numSides = 2 * this->NumberOfSides;
-  }
-
-  double s0, s;
-  if (this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS)
-  {
-    s0 = inScalars->GetTuple1(pts[0]);
-    for (i = 0; i < npts; i++)
-    {
-      s = inScalars->GetTuple1(pts[i]);
-      tc = (s - s0) / this->TextureLength;
-      for (k = 0; k < numSides; k++)
-      {
-        double tcy = static_cast<double>(k) / (numSides - 1);
-        newTCoords->InsertTuple2(offset + i * numSides + k, tc, tcy);
-      }
-    }
-  }
-  else if (this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH)
-  {
-    double xPrev[3], x[3], len = 0.0;
-    inPts->GetPoint(pts[0], xPrev);
-    for (i = 0; i < npts; i++)
-    {
-      inPts->GetPoint(pts[i], x);
-      len += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
-      tc = len / this->TextureLength;
-      for (k = 0; k < numSides; k++)
-      {
-        double tcy = static_cast<double>(k) / (numSides - 1);
-        newTCoords->InsertTuple2(offset + i * numSides + k, tc, tcy);
-      }
-
-      xPrev[0] = x[0];
-      xPrev[1] = x[1];
-      xPrev[2] = x[2];
-    }
-  }
-  else if (this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
-  {
-    double xPrev[3], x[3], length = 0.0, len = 0.0;
-    inPts->GetPoint(pts[0], xPrev);
-    for (i = 0; i < npts; i++)
-    {
-      inPts->GetPoint(pts[i], x);
-      length += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
-      xPrev[0] = x[0];
-      xPrev[1] = x[1];
-      xPrev[2] = x[2];
-    }
-
-    inPts->GetPoint(pts[0], xPrev);
-    for (i = 0; i < npts; i++)
-    {
-      inPts->GetPoint(pts[i], x);
-      len += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
-      tc = len / length;
-      for (k = 0; k < numSides; k++)
-      {
-        double tcy = static_cast<double>(k) / (numSides - 1);
-        newTCoords->InsertTuple2(offset + i * numSides + k, tc, tcy);
-      }
-      xPrev[0] = x[0];
-      xPrev[1] = x[1];
-      xPrev[2] = x[2];
-    }
-  }
-
-  // Capping, set the endpoints as appropriate
-  if (this->Capping)
-  {
-    int ik;
-    vtkIdType startIdx = offset + npts * numSides;
-
-    // start cap
-    for (ik = 0; ik < this->NumberOfSides; ik++)
-    {
-      newTCoords->InsertTuple2(startIdx + ik, 0.0, 0.0);
-    }
-
-    // end cap
-    for (ik = 0; ik < this->NumberOfSides; ik++)
-    {
-      newTCoords->InsertTuple2(startIdx + this->NumberOfSides + ik, tc, 0.0);
-    }
-  }
+  TubeParameters par = MakeTubeParameters(this, this->Theta);
+  par.InPts = inPts;
+  par.InScalars = inScalars;
+  TubeInsertOutput output{ nullptr, nullptr, newTCoords, nullptr, nullptr, nullptr, nullptr,
+    nullptr };
+  GenerateTubeTextureCoords(par, npts, pts, offset, output);
 }
 
 // Compute the number of points in this tube
@@ -836,5 +1143,6 @@ void vtkTubeFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Generate TCoords: " << this->GetGenerateTCoordsAsString() << endl;
   os << indent << "Texture Length: " << this->TextureLength << endl;
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << endl;
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
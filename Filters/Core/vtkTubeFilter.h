@@ -23,6 +23,11 @@
  * common use is to combine this filter with vtkStreamTracer to generate
  * streamtubes.
  *
+ * Unless SequentialProcessing is on, the tubes are generated in parallel
+ * with vtkSMPTools: the size of the output of each line is computed first,
+ * then the points, strips and attributes of all the lines are generated
+ * concurrently into preallocated arrays.
+ *
  * @warning
  * The number of tube sides must be greater than 3. If you wish to use fewer
  * sides (i.e., a ribbon), use vtkRibbonFilter.
@@ -43,6 +48,7 @@
 #ifndef vtkTubeFilter_h
 #define vtkTubeFilter_h
 
+#include "vtkDeprecation.h"       // For VTK_DEPRECATED_IN_9_7_0
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 #include "vtkWrappingHints.h" // For VTK_MARSHALAUTO
@@ -65,6 +71,7 @@ class vtkDataArray;
 class vtkFloatArray;
 class vtkPointData;
 class vtkPoints;
+class vtkPolyData;
 
 class VTKFILTERSCORE_EXPORT VTK_MARSHALAUTO vtkTubeFilter : public vtkPolyDataAlgorithm
 {
@@ -221,6 +228,16 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * Force sequential processing (i.e. single thread) of the lines. The output
+   * does not depend on this option. Default is false.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
 protected:
   vtkTubeFilter();
   ~vtkTubeFilter() override = default;
@@ -241,18 +258,30 @@ protected:
   int GenerateTCoords; // control texture coordinate generation
   int OutputPointsPrecision;
   double TextureLength; // this length is mapped to [0,1) texture space
+  bool SequentialProcessing = false;
 
-  // Helper methods
+  // Helper methods, the filter now generates the tubes with GenerateTubes()
+  VTK_DEPRECATED_IN_9_7_0("The tubes are generated by GenerateTubes()")
   int GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkPoints* inPts,
     vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD, vtkFloatArray* newNormals,
     vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors, double maxSpeed,
     vtkDataArray* inNormals);
+  VTK_DEPRECATED_IN_9_7_0("The tubes are generated by GenerateTubes()")
   void GenerateStrips(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkIdType inCellId,
     vtkCellData* cd, vtkCellData* outCD, vtkCellArray* newStrips);
+  VTK_DEPRECATED_IN_9_7_0("The tubes are generated by GenerateTubes()")
   void GenerateTextureCoords(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
     vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords);
+  VTK_DEPRECATED_IN_9_7_0("The tubes are generated by GenerateTubes()")
   vtkIdType ComputeOffset(vtkIdType offset, vtkIdType npts);
 
+  // Generation of the tubes of all the lines with vtkSMPTools. inNormals is
+  // nullptr when sliding normals are generated for each line.
+  void GenerateTubes(vtkPolyData* input, vtkPolyData* output, vtkDataArray* inNormals,
+    vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors, double maxSpeed,
+    vtkPoints* newPts, vtkFloatArray* newNormals, vtkFloatArray* newTCoords,
+    vtkCellArray* newStrips);
+
   // Helper data members
   double Theta;
 
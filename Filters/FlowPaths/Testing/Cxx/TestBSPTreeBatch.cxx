@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that the threaded build of vtkModifiedBSPTree does not depend on the
+// number of threads, that the default build still draws its split axes with
+// rand(), and that the batched intersections match the single ones.
+
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdListCollection.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkModifiedBSPTree.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSuperquadricSource.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool SameLeaves(vtkModifiedBSPTree* tree1, vtkModifiedBSPTree* tree2)
+{
+  auto leaves1 = vtkSmartPointer<vtkIdListCollection>::Take(tree1->GetLeafNodeCellInformation());
+  auto leaves2 = vtkSmartPointer<vtkIdListCollection>::Take(tree2->GetLeafNodeCellInformation());
+  if (!leaves1 || !leaves2 || tree1->GetLevel() != tree2->GetLevel() ||
+    leaves1->GetNumberOfItems() != leaves2->GetNumberOfItems())
+  {
+    return false;
+  }
+  for (int i = 0; i < leaves1->GetNumberOfItems(); ++i)
+  {
+    vtkIdList* cells1 = leaves1->GetItem(i);
+    vtkIdList* cells2 = leaves2->GetItem(i);
+    if (cells1->GetNumberOfIds() != cells2->GetNumberOfIds() ||
+      !std::equal(cells1->begin(), cells1->end(), cells2->begin()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//------------------------------------------------------------------------------
+int TestBSPTreeBatch(int, char*[])
+{
+  vtkNew<vtkSuperquadricSource> source;
+  source->ToroidalOn();
+  source->SetZAxisOfSymmetry();
+  source->SetSize(1.0);
+  source->SetThickness(0.3);
+  source->SetPhiRoundness(0.8);
+  source->SetThetaRoundness(0.8);
+  source->SetThetaResolution(256);
+  source->SetPhiResolution(128);
+  source->Update();
+  vtkPolyData* torus = source->GetOutput();
+
+  // The default build draws the same axes after the same seed.
+  vtkNew<vtkModifiedBSPTree> tree;
+  tree->SetDataSet(torus);
+  srand(1);
+  tree->BuildLocator();
+  vtkNew<vtkModifiedBSPTree> randomTree;
+  randomTree->SetDataSet(torus);
+  srand(1);
+  randomTree->BuildLocator();
+  if (tree->GetDeterministicBuild() || !SameLeaves(tree, randomTree))
+  {
+    std::cerr << "The default tree does not depend on the seed of rand() only." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  tree->DeterministicBuildOn();
+  tree->BuildLocator();
+  vtkNew<vtkModifiedBSPTree> serialTree;
+  serialTree->SetDataSet(torus);
+  serialTree->DeterministicBuildOn();
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { serialTree->BuildLocator(); });
+  if (!SameLeaves(tree, serialTree))
+  {
+    std::cerr << "The tree depends on the number of threads." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Random segments, followed by a grid of parallel segments.
+  vtkNew<vtkPoints> p1;
+  p1->SetDataTypeToDouble();
+  vtkNew<vtkPoints> p2;
+  p2->SetDataTypeToDouble();
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(7);
+  for (int i = 0; i < 2000; ++i)
+  {
+    double a[3], b[3];
+    for (int d = 0; d < 3; ++d)
+    {
+      a[d] = random->GetNextRangeValue(-1.5, 1.5);
+      b[d] = random->GetNextRangeValue(-1.5, 1.5);
+    }
+    p1->InsertNextPoint(a);
+    p2->InsertNextPoint(b);
+  }
+  for (int j = 0; j < 50; ++j)
+  {
+    for (int i = 0; i < 50; ++i)
+    {
+      const double x = -1.4 + 2.8 * i / 49.0;
+      const double y = -1.4 + 2.8 * j / 49.0;
+      p1->InsertNextPoint(x, y, -1.0);
+      p2->InsertNextPoint(x + 0.1, y, 1.0);
+    }
+  }
+
+  const double tol = 1e-6;
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkPoints> intersections;
+  intersections->SetDataTypeToDouble();
+  vtkNew<vtkDoubleArray> t;
+  tree->IntersectWithLines(p1, p2, tol, cellIds, intersections, t);
+  if (cellIds->GetNumberOfIds() != p1->GetNumberOfPoints())
+  {
+    std::cerr << "Wrong size of the IntersectWithLines output." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkGenericCell> cell;
+  vtkIdType numberOfHits = 0;
+  for (vtkIdType i = 0; i < p1->GetNumberOfPoints(); ++i)
+  {
+    double a[3], b[3], x[3], batchX[3], pcoords[3], tLine = 0.0;
+    int subId;
+    vtkIdType cellId = -1;
+    p1->GetPoint(i, a);
+    p2->GetPoint(i, b);
+    if (!tree->IntersectWithLine(a, b, tol, tLine, x, pcoords, subId, cellId, cell))
+    {
+      cellId = -1;
+    }
+    intersections->GetPoint(i, batchX);
+    if (cellId != cellIds->GetId(i) ||
+      (cellId >= 0 &&
+        (tLine != t->GetValue(i) || x[0] != batchX[0] || x[1] != batchX[1] || x[2] != batchX[2])))
+    {
+      std::cerr << "IntersectWithLines found cell " << cellIds->GetId(i) << " instead of "
+                << cellId << " for segment " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+    numberOfHits += cellId >= 0;
+  }
+  if (numberOfHits == 0 || numberOfHits == p1->GetNumberOfPoints())
+  {
+    std::cerr << "The segments must both hit and miss the surface." << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -3,6 +3,7 @@
 
 #include "vtkModifiedBSPTree.h"
 
+#include "vtkAbstractCellLocator.txx"
 #include "vtkAppendPolyData.h"
 #include "vtkBox.h"
 #include "vtkCubeSource.h"
@@ -10,6 +11,7 @@
 #include "vtkIdListCollection.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
 #include "vtkSMPTools.h"
 
 #include <algorithm>
@@ -32,6 +34,10 @@ enum
   NEG_Z
 };
 
+// The nodes with more cells than this partition their cells and subdivide
+// their children concurrently.
+static const vtkIdType concurrent_subdivision_size = 4096;
+
 //////////////////////////////////////////////////////////////////////////////
 // Main management and support for tree
 //////////////////////////////////////////////////////////////////////////////
@@ -70,8 +76,6 @@ public:
 
 typedef cell_extents* cell_extents_List;
 
-static int global_list_count = 0;
-
 //------------------------------------------------------------------------------
 class Sorted_cell_extents_Lists
 {
@@ -86,7 +90,6 @@ public:
       Mins[i] = new cell_extents[nCells]; // max num <= nCells/2 ?
       Maxs[i] = new cell_extents[nCells];
     }
-    global_list_count += 1;
   }
   ~Sorted_cell_extents_Lists()
   {
@@ -95,7 +98,6 @@ public:
       delete[] (this->Mins[i]);
       delete[] (this->Maxs[i]);
     }
-    global_list_count -= 1;
   }
 };
 
@@ -140,7 +142,7 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
 
   // create the root node
   this->mRoot = std::make_shared<BSPNode>();
-  this->mRoot->mAxis = rand() % 3;
+  this->mRoot->mAxis = this->DeterministicBuild ? 0 : rand() % 3;
   this->mRoot->depth = 0;
 
   this->ComputeCellBounds();
@@ -177,8 +179,14 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
   // call the recursive subdivision routine
   vtkDebugMacro(<< "Beginning Subdivision");
 
-  Subdivide(this->mRoot.get(), lists, this->DataSet, numCells, 0, this->MaxLevel,
-    this->NumberOfCellsPerNode, this->Level);
+  // Large nodes are subdivided concurrently, see Subdivide.
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ vtkSMPTools::GetEstimatedNumberOfThreads(),
+                            vtkSMPTools::GetBackend(), true },
+    [&]()
+    {
+      Subdivide(this->mRoot.get(), lists, this->DataSet, numCells, 0, this->MaxLevel,
+        this->NumberOfCellsPerNode, this->Level);
+    });
   delete lists;
 
   // Child nodes are responsible for freeing the temporary sorted lists
@@ -203,6 +211,10 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
   {
     MaxDepth = depth;
   }
+  // Large nodes partition their 6 lists concurrently. They also subdivide their children
+  // concurrently when the axes do not come from rand().
+  const bool concurrent = nCells > concurrent_subdivision_size;
+  const bool concurrentChildren = concurrent && this->DeterministicBuild;
   //
   // Make sure child nodes are clear to start with
   node->mChild[2] = node->mChild[1] = node->mChild[0] = nullptr;
@@ -210,8 +222,6 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
   // Do we want to subdivide this node ?
   //
   double pDiv = 0.0;
-  double cellBounds[6], *cellBoundsPtr;
-  cellBoundsPtr = cellBounds;
   if ((nCells > maxCells) && (depth < maxlevel))
   {
     // test for optimal subdivision
@@ -251,11 +261,14 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
     // construct the 3 children
     if (found)
     {
+      // in a deterministic build, the children start their search on the next
+      // axis, so that the tree does not depend on the order in which the nodes
+      // are subdivided
       for (int i = 0; i < 3; i++)
       {
         node->mChild[i] = new BSPNode();
         node->mChild[i]->depth = node->depth + 1;
-        node->mChild[i]->mAxis = rand() % 3;
+        node->mChild[i]->mAxis = this->DeterministicBuild ? (node->mAxis + 1) % 3 : rand() % 3;
       }
       Daxis = node->mAxis;
       Sorted_cell_extents_Lists* left = new Sorted_cell_extents_Lists(nCells);
@@ -264,85 +277,67 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
       // we ought to keep track of how many we are adding to each list
       vtkIdType Cmin_l[3] = { 0, 0, 0 }, Cmin_m[3] = { 0, 0, 0 }, Cmin_r[3] = { 0, 0, 0 };
       vtkIdType Cmax_l[3] = { 0, 0, 0 }, Cmax_m[3] = { 0, 0, 0 }, Cmax_r[3] = { 0, 0, 0 };
-      // Partition the cells into the correct child lists
-      // here we use the lists for the axis we're dividing along
-      for (vtkIdType i = 0; i < nCells; i++)
-      {
-        // process the MIN-List
-        cell_extents ext = lists->Mins[Daxis][i];
-        // max is on left of middle node
-        if (ext.max < pDiv)
-        {
-          left->Mins[Daxis][Cmin_l[Daxis]++] = ext;
-        }
-        // min is on right of middle node
-        else if (ext.min > pDiv)
-        {
-          right->Mins[Daxis][Cmin_r[Daxis]++] = ext;
-        }
-        // neither - must be one of ours
-        else
-        {
-          mid->Mins[Daxis][Cmin_m[Daxis]++] = ext;
-        }
-        //
-        // process the MAX-List
-        ext = lists->Maxs[Daxis][i];
-        // max is on left of middle node
-        if (ext.max < pDiv)
-        {
-          left->Maxs[Daxis][Cmax_l[Daxis]++] = ext;
-        }
-        // min is on right of middle node
-        else if (ext.min > pDiv)
-        {
-          right->Maxs[Daxis][Cmax_r[Daxis]++] = ext;
-        }
-        // neither - must be one of ours
-        else
-        {
-          mid->Maxs[Daxis][Cmax_m[Daxis]++] = ext;
-        }
-      }
-      // construct the sorted list of extents for the 2 remaining axes
-      // do everything in order so our sorted lists aren't munged
-      for (Daxis = (node->mAxis + 1) % 3; Daxis != node->mAxis; Daxis = (Daxis + 1) % 3)
+      // Partition the cells into the correct child lists, for each of the
+      // 6 lists independently
+      auto partition = [&](int axis, bool maxs)
       {
+        cell_extents_List extents = maxs ? lists->Maxs[axis] : lists->Mins[axis];
+        cell_extents_List leftExtents = maxs ? left->Maxs[axis] : left->Mins[axis];
+        cell_extents_List midExtents = maxs ? mid->Maxs[axis] : mid->Mins[axis];
+        cell_extents_List rightExtents = maxs ? right->Maxs[axis] : right->Mins[axis];
+        vtkIdType& Cl = maxs ? Cmax_l[axis] : Cmin_l[axis];
+        vtkIdType& Cm = maxs ? Cmax_m[axis] : Cmin_m[axis];
+        vtkIdType& Cr = maxs ? Cmax_r[axis] : Cmin_r[axis];
+        double extBounds[6], *extBoundsPtr;
+        extBoundsPtr = extBounds;
         for (vtkIdType i = 0; i < nCells; i++)
         {
-          // process the MIN-List
-          cell_extents ext = lists->Mins[Daxis][i];
-          // check whether we intersect the cell bounds
-          this->GetCellBounds(ext.cell_ID, cellBoundsPtr);
-          if (cellBoundsPtr[2 * node->mAxis + 1] < pDiv)
-          {
-            left->Mins[Daxis][Cmin_l[Daxis]++] = ext;
-          }
-          else if (cellBoundsPtr[2 * node->mAxis] > pDiv)
+          cell_extents ext = extents[i];
+          double extMin, extMax;
+          // here we use the lists for the axis we're dividing along
+          if (axis == Daxis)
           {
-            right->Mins[Daxis][Cmin_r[Daxis]++] = ext;
+            extMin = ext.min;
+            extMax = ext.max;
           }
+          // check whether we intersect the cell bounds
           else
           {
-            mid->Mins[Daxis][Cmin_m[Daxis]++] = ext;
+            this->GetCellBounds(ext.cell_ID, extBoundsPtr);
+            extMin = extBoundsPtr[2 * Daxis];
+            extMax = extBoundsPtr[2 * Daxis + 1];
           }
-          //
-          // process the MAX-List
-          ext = lists->Maxs[Daxis][i];
-          this->GetCellBounds(ext.cell_ID, cellBoundsPtr);
-          if (cellBoundsPtr[2 * node->mAxis + 1] < pDiv)
+          // max is on left of middle node
+          if (extMax < pDiv)
           {
-            left->Maxs[Daxis][Cmax_l[Daxis]++] = ext;
+            leftExtents[Cl++] = ext;
           }
-          else if (cellBoundsPtr[2 * node->mAxis] > pDiv)
+          // min is on right of middle node
+          else if (extMin > pDiv)
           {
-            right->Maxs[Daxis][Cmax_r[Daxis]++] = ext;
+            rightExtents[Cr++] = ext;
           }
+          // neither - must be one of ours
           else
           {
-            mid->Maxs[Daxis][Cmax_m[Daxis]++] = ext;
+            midExtents[Cm++] = ext;
           }
         }
+      };
+      auto partitionLists = [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType list = begin; list < end; list++)
+        {
+          partition(static_cast<int>(list / 2), (list % 2) != 0);
+        }
+      };
+      if (concurrent)
+      {
+        vtkSMPTools::For(0, 6, 1, partitionLists);
+      }
+      else
+      {
+        partitionLists(0, 6);
       }
       //
       // Better check we didn't make a diddly
@@ -395,39 +390,43 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
         //
         // And of course, we really ought to subdivide again - Hoorah!
         // NB: it is possible for a node to be empty now, so check and delete if necessary
-        if (Cmin_l[0])
-        {
-          Subdivide(
-            node->mChild[0], left, dataset, Cmin_l[0], depth + 1, maxlevel, maxCells, MaxDepth);
-        }
-        else
+        if (!Cmin_l[0])
         {
           vtkWarningMacro(<< "Child 0 Empty ! - this shouldn't happen");
         }
-        delete left;
-
-        if (Cmin_m[0])
-        {
-          Subdivide(
-            node->mChild[1], mid, dataset, Cmin_m[0], depth + 1, maxlevel, maxCells, MaxDepth);
-        }
-        else
+        if (!Cmin_m[0])
         {
           delete node->mChild[1];
           node->mChild[1] = nullptr;
         }
-        delete mid;
-
-        if (Cmin_r[0])
+        if (!Cmin_r[0])
         {
-          Subdivide(
-            node->mChild[2], right, dataset, Cmin_r[0], depth + 1, maxlevel, maxCells, MaxDepth);
+          vtkWarningMacro(<< "Child 2 Empty ! - this shouldn't happen");
+        }
+        Sorted_cell_extents_Lists* childLists[3] = { left, mid, right };
+        const vtkIdType childCells[3] = { Cmin_l[0], Cmin_m[0], Cmin_r[0] };
+        int childDepths[3] = { MaxDepth, MaxDepth, MaxDepth };
+        auto subdivideChildren = [&](vtkIdType begin, vtkIdType end)
+        {
+          for (vtkIdType i = begin; i < end; i++)
+          {
+            if (childCells[i])
+            {
+              Subdivide(node->mChild[i], childLists[i], dataset, childCells[i], depth + 1,
+                maxlevel, maxCells, childDepths[i]);
+            }
+            delete childLists[i];
+          }
+        };
+        if (concurrentChildren)
+        {
+          vtkSMPTools::For(0, 3, 1, subdivideChildren);
         }
         else
         {
-          vtkWarningMacro(<< "Child 2 Empty ! - this shouldn't happen");
+          subdivideChildren(0, 3);
         }
-        delete right;
+        MaxDepth = std::max({ childDepths[0], childDepths[1], childDepths[2] });
         //
         npn += 1; // Parent node
         //
@@ -594,6 +593,55 @@ int BSPNode::getDominantAxis(const double dir[3])
   }
 }
 
+//------------------------------------------------------------------------------
+// The cells already tested by a single ray, and the stack of nodes to visit
+struct single_ray_state
+{
+  std::vector<bool> cellHasBeenVisited;
+  nodestack ns;
+  single_ray_state(vtkIdType nCells)
+    : cellHasBeenVisited(nCells, false)
+  {
+  }
+  bool Visit(vtkIdType cId)
+  {
+    if (cellHasBeenVisited[cId])
+    {
+      return false;
+    }
+    cellHasBeenVisited[cId] = true;
+    return true;
+  }
+};
+
+//------------------------------------------------------------------------------
+// The same for the rays of a batch, tested one after the other by a thread.
+// The cells are stamped with the number of the ray that tests them, so the
+// marks do not need to be cleared between the rays.
+struct batch_ray_state
+{
+  std::vector<vtkIdType> cellStamps;
+  vtkIdType ray = 0;
+  nodestack ns;
+  void NextRay(vtkIdType nCells)
+  {
+    if (cellStamps.empty())
+    {
+      cellStamps.resize(nCells, 0);
+    }
+    ray++;
+  }
+  bool Visit(vtkIdType cId)
+  {
+    if (cellStamps[cId] == ray)
+    {
+      return false;
+    }
+    cellStamps[cId] = ray;
+    return true;
+  }
+};
+
 //------------------------------------------------------------------------------
 int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3], double tol,
   double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
@@ -603,6 +651,40 @@ int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3]
   {
     return 0;
   }
+  single_ray_state state(this->DataSet->GetNumberOfCells());
+  return this->IntersectWithLineInternal(p1, p2, tol, t, x, pcoords, subId, cellId, cell, state);
+}
+
+//------------------------------------------------------------------------------
+void vtkModifiedBSPTree::IntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol,
+  vtkIdList* cellIds, vtkPoints* points, vtkDoubleArray* t)
+{
+  this->BuildLocator();
+  const bool empty = !this->mRoot;
+  const vtkIdType nCells = empty ? 0 : this->DataSet->GetNumberOfCells();
+  vtkSMPThreadLocal<batch_ray_state> localState;
+  this->BatchIntersectWithLines(p1, p2, tol, cellIds, points, t,
+    [this, &localState, empty, nCells](const double a[3], const double b[3], double tolerance,
+      double& tLine, double x[3], double pc[3], int& subId, vtkIdType& cellId,
+      vtkGenericCell* cell)
+    {
+      if (empty)
+      {
+        return 0;
+      }
+      batch_ray_state& state = localState.Local();
+      state.NextRay(nCells);
+      return this->IntersectWithLineInternal(
+        a, b, tolerance, tLine, x, pc, subId, cellId, cell, state);
+    });
+}
+
+//------------------------------------------------------------------------------
+template <typename TRayState>
+int vtkModifiedBSPTree::IntersectWithLineInternal(const double p1[3], const double p2[3],
+  double tol, double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId,
+  vtkGenericCell* cell, TRayState& state)
+{
   BSPNode *node, *Near, *Mid, *Far;
   double tmin, tmax, tDist, tHitCell, tBest = VTK_DOUBLE_MAX, xBest[3], pCoordsBest[3];
   double rayDir[3], x0[3], x1[3], hitCellBoundsPosition[3], cellBounds[6], *cellBoundsPtr;
@@ -618,9 +700,8 @@ int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3]
   {
     return false;
   }
-  std::vector<bool> cellHasBeenVisited(this->DataSet->GetNumberOfCells(), false);
   // Ok, setup a stack and various params
-  nodestack ns;
+  nodestack& ns = state.ns;
   // setup our axis optimized ray box edge stuff
   int axis = BSPNode::getDominantAxis(rayDir);
   double (*_getMinDist)(const double origin[3], const double dir[3], const double B[6]);
@@ -701,9 +782,8 @@ int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3]
     for (int i = 0; i < node->num_cells; i++)
     {
       cId = node->sorted_cell_lists[axis][i];
-      if (!cellHasBeenVisited[cId])
+      if (state.Visit(cId))
       {
-        cellHasBeenVisited[cId] = true;
         this->GetCellBounds(cId, cellBoundsPtr);
         if (_getMinDist(p1, rayDir, cellBoundsPtr) > tBest)
         {
@@ -1044,11 +1124,14 @@ void vtkModifiedBSPTree::ShallowCopy(vtkAbstractCellLocator* locator)
   this->CellBoundsSharedPtr = cellLocator->CellBoundsSharedPtr; // This is important
   this->CellBounds = this->CellBoundsSharedPtr.get() ? this->CellBoundsSharedPtr->data() : nullptr;
 
+  // vtkModifiedBSPTree parameters
+  this->DeterministicBuild = cellLocator->DeterministicBuild;
+
   // vtkCellTreeLocator parameters
   this->mRoot = cellLocator->mRoot; // This is important
-  this->npn = cellLocator->npn;
-  this->nln = cellLocator->nln;
-  this->tot_depth = cellLocator->tot_depth;
+  this->npn = cellLocator->npn.load();
+  this->nln = cellLocator->nln.load();
+  this->tot_depth = cellLocator->tot_depth.load();
   this->BuildTime.Modified();
 }
 
@@ -1059,6 +1142,7 @@ void vtkModifiedBSPTree::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "npn: " << this->npn << "\n";
   os << indent << "nln: " << this->nln << "\n";
   os << indent << "tot_depth: " << this->tot_depth << "\n";
+  os << indent << "DeterministicBuild: " << this->DeterministicBuild << "\n";
 }
 
 //////////////////////////////////////////////////////////////////////////////
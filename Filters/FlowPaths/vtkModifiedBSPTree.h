@@ -63,6 +63,9 @@
  * Cells are only sorted into 6 lists once - before tree creation, each node
  * segments the lists and passes them down to the new child nodes whilst
  * maintaining sorted order. This makes for an efficient subdivision strategy.
+ * The cells of large nodes are partitioned with vtkSMPTools. With
+ * DeterministicBuild on, the large nodes also subdivide their children
+ * concurrently.
  *
  * @warning
  * vtkModifiedBSPTree utilizes the following parent class parameters:
@@ -130,6 +133,8 @@
 #include "vtkFiltersFlowPathsModule.h" // For export macro
 #include "vtkSmartPointer.h"           // required because it is nice
 
+#include <atomic> // For std::atomic
+
 VTK_ABI_NAMESPACE_BEGIN
 class Sorted_cell_extents_Lists;
 class BSPNode;
@@ -157,6 +162,20 @@ public:
   using vtkAbstractCellLocator::FindCell;
   using vtkAbstractCellLocator::IntersectWithLine;
 
+  ///@{
+  /**
+   * Choose the axis along which each node starts its search for a split.
+   * When off (the default), the axis is picked with rand() as it always was,
+   * and the tree is built serially, in the order of the random draws. When
+   * on, the axes are cycled from the x axis: the tree is then the same for
+   * every build, whatever the number of threads, and the children of large
+   * nodes are subdivided concurrently.
+   */
+  vtkSetMacro(DeterministicBuild, vtkTypeBool);
+  vtkGetMacro(DeterministicBuild, vtkTypeBool);
+  vtkBooleanMacro(DeterministicBuild, vtkTypeBool);
+  ///@}
+
   /**
    * Return intersection point (if any) AND the cell which was intersected by
    * the finite line. The cell is returned as a cell id and as a generic cell.
@@ -178,6 +197,15 @@ public:
   int IntersectWithLine(const double p1[3], const double p2[3], double tol, vtkPoints* points,
     vtkIdList* cellIds, vtkGenericCell* cell) override;
 
+  /**
+   * Intersect the line segments going from the points of `p1` to the points of `p2` with the
+   * data set, see vtkAbstractCellLocator::IntersectWithLines(). The results are the ones of
+   * IntersectWithLine(), but the memory marking the cells tested by a segment is allocated
+   * once per thread instead of once per segment.
+   */
+  void IntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol, vtkIdList* cellIds,
+    vtkPoints* points = nullptr, vtkDoubleArray* t = nullptr) override;
+
   /**
    * Take the passed line segment and intersect it with the data set.
    * For each intersection with the bounds of a cell, the cellIds
@@ -237,15 +265,24 @@ protected:
 
   void BuildLocatorInternal() override;
   std::shared_ptr<BSPNode> mRoot; // bounding box root node
-  int npn;
-  int nln;
-  int tot_depth;
+  std::atomic<int> npn;
+  std::atomic<int> nln;
+  std::atomic<int> tot_depth;
+  vtkTypeBool DeterministicBuild = false;
 
-  // The main subdivision routine
+  // The main subdivision routine, large nodes subdivide their children
+  // concurrently when the build is deterministic
   void Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lists, vtkDataSet* dataSet,
     vtkIdType nCells, int depth, int maxlevel, vtkIdType maxCells, int& MaxDepth);
 
 private:
+  // Intersect a line with the cells, the state holds the cells already tested
+  // and the stack of nodes of the traversal
+  template <typename TRayState>
+  int IntersectWithLineInternal(const double p1[3], const double p2[3], double tol, double& t,
+    double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell,
+    TRayState& state);
+
   vtkModifiedBSPTree(const vtkModifiedBSPTree&) = delete;
   void operator=(const vtkModifiedBSPTree&) = delete;
 };
@@ -2,7 +2,9 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkOBBTree.h"
 
+#include "vtkAbstractCellLocator.txx"
 #include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkLine.h"
 #include "vtkMath.h"
@@ -10,9 +12,15 @@
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -43,129 +51,209 @@ vtkStandardNewMacro(vtkOBBTree);
     }                                                                                              \
   } while (false)
 
+namespace
+{
+// The cells of a node are processed in blocks of this size, and the results of the blocks are
+// combined in order, so that the tree does not depend on the number of threads.
+constexpr vtkIdType OBBBlockSize = 1024;
+
+// The two children of the nodes having more cells than this are built concurrently.
+constexpr vtkIdType OBBConcurrentBuildSize = 8 * OBBBlockSize;
+
+// IntersectWithLines() traverses the tree once for packets of this many segments, whose
+// intersection with a node is tracked by the bits of a mask.
+constexpr int OBBPacketSize = 64;
+using OBBRayMask = std::uint64_t;
+
 //------------------------------------------------------------------------------
-vtkOBBNode::vtkOBBNode()
+vtkIdType GetNumberOfBlocks(vtkIdType numCells)
 {
-  this->Cells = nullptr;
-  this->Parent = nullptr;
-  this->Kids = nullptr;
+  return (numCells + OBBBlockSize - 1) / OBBBlockSize;
 }
 
 //------------------------------------------------------------------------------
-vtkOBBNode::~vtkOBBNode()
+// Call functor(block, begin, end, cellPts) for each block of cells, concurrently when there are
+// several blocks. cellPts is a scratch list for the points of the cells.
+template <typename Functor>
+void ForEachBlock(vtkIdType numCells, Functor&& functor)
 {
-  delete[] this->Kids;
-  if (this->Cells)
+  const vtkIdType numBlocks = GetNumberOfBlocks(numCells);
+  if (numBlocks <= 1)
   {
-    this->Cells->Delete();
+    vtkNew<vtkIdList> cellPts;
+    functor(0, 0, numCells, cellPts.Get());
+    return;
   }
+  vtkSMPThreadLocalObject<vtkIdList> localCellPts;
+  vtkSMPTools::For(0, numBlocks,
+    [&](vtkIdType firstBlock, vtkIdType lastBlock)
+    {
+      vtkIdList* cellPts = localCellPts.Local();
+      for (vtkIdType block = firstBlock; block < lastBlock; ++block)
+      {
+        functor(block, block * OBBBlockSize, std::min(numCells, (block + 1) * OBBBlockSize),
+          cellPts);
+      }
+    });
 }
 
 //------------------------------------------------------------------------------
-// Construct with automatic computation of divisions, averaging
-// 25 cells per octant.
-vtkOBBTree::vtkOBBTree()
+// Area weighted moments of the triangles of a set of cells.
+struct OBBMoments
 {
-  this->DataSet = nullptr;
-  this->Level = 0;
-  this->MaxLevel = 12;
-  this->Tolerance = 0.01;
-  this->Tree = nullptr;
-  this->PointsList = nullptr;
-  this->InsertedPoints = nullptr;
-  this->OBBCount = 0;
-}
+  double Mass = 0.0;
+  double Mean[3] = { 0.0, 0.0, 0.0 };
+  double A[3][3] = { { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } };
 
-//------------------------------------------------------------------------------
-vtkOBBTree::~vtkOBBTree()
-{
-  this->FreeSearchStructure();
-}
+  void Add(const OBBMoments& other)
+  {
+    this->Mass += other.Mass;
+    for (int i = 0; i < 3; i++)
+    {
+      this->Mean[i] += other.Mean[i];
+      for (int j = 0; j < 3; j++)
+      {
+        this->A[i][j] += other.A[i][j];
+      }
+    }
+  }
+};
 
 //------------------------------------------------------------------------------
-void vtkOBBTree::FreeSearchStructure()
+void AddCellMoments(vtkDataSet* dataSet, const vtkIdType* cells, vtkIdType begin, vtkIdType end,
+  vtkIdList* cellPts, OBBMoments& moments)
 {
-  if (this->Tree)
-  {
-    this->DeleteTree(this->Tree);
-    delete this->Tree;
-    this->Tree = nullptr;
-  }
+  vtkIdType numPts, pId, qId, rId;
+  const vtkIdType* ptIds;
+  double p[3], q[3], r[3], xp[3], dp0[3], dp1[3], c[3], tri_mass;
+  double* a0 = moments.A[0];
+  double* a1 = moments.A[1];
+  double* a2 = moments.A[2];
+
+  for (vtkIdType i = begin; i < end; i++)
+  {
+    const vtkIdType cellId = cells[i];
+    const int type = dataSet->GetCellType(cellId);
+    dataSet->GetCellPoints(cellId, numPts, ptIds, cellPts);
+    for (vtkIdType j = 0; j < numPts - 2; j++)
+    {
+      vtkCELLTRIANGLES(ptIds, type, j, pId, qId, rId);
+      if (pId < 0)
+      {
+        continue;
+      }
+      dataSet->GetPoint(pId, p);
+      dataSet->GetPoint(qId, q);
+      dataSet->GetPoint(rId, r);
+      // p, q, and r are the oriented triangle points.
+      // Compute the components of the moment of inertia tensor.
+      for (int k = 0; k < 3; k++)
+      {
+        // two edge vectors
+        dp0[k] = q[k] - p[k];
+        dp1[k] = r[k] - p[k];
+        // centroid
+        c[k] = (p[k] + q[k] + r[k]) / 3;
+      }
+      vtkMath::Cross(dp0, dp1, xp);
+      tri_mass = 0.5 * vtkMath::Norm(xp);
+      moments.Mass += tri_mass;
+      for (int k = 0; k < 3; k++)
+      {
+        moments.Mean[k] += tri_mass * c[k];
+      }
+
+      // on-diagonal terms
+      a0[0] += tri_mass * (9 * c[0] * c[0] + p[0] * p[0] + q[0] * q[0] + r[0] * r[0]) / 12;
+      a1[1] += tri_mass * (9 * c[1] * c[1] + p[1] * p[1] + q[1] * q[1] + r[1] * r[1]) / 12;
+      a2[2] += tri_mass * (9 * c[2] * c[2] + p[2] * p[2] + q[2] * q[2] + r[2] * r[2]) / 12;
+
+      // off-diagonal terms
+      a0[1] += tri_mass * (9 * c[0] * c[1] + p[0] * p[1] + q[0] * q[1] + r[0] * r[1]) / 12;
+      a0[2] += tri_mass * (9 * c[0] * c[2] + p[0] * p[2] + q[0] * q[2] + r[0] * r[2]) / 12;
+      a1[2] += tri_mass * (9 * c[1] * c[2] + p[1] * p[2] + q[1] * q[2] + r[1] * r[2]) / 12;
+    } // end foreach triangle
+  }   // end foreach cell
 }
 
 //------------------------------------------------------------------------------
-void vtkOBBTree::DeleteTree(vtkOBBNode* OBBptr)
+// Extend the parametric range of the points of a set of cells along the lines going from mean
+// to the points of axisEnds.
+void AddCellExtent(vtkDataSet* dataSet, const vtkIdType* cells, vtkIdType begin, vtkIdType end,
+  vtkIdList* cellPts, const double mean[3], const double axisEnds[3][3], double tMin[3],
+  double tMax[3])
 {
-  if (OBBptr->Kids != nullptr)
+  vtkIdType numPts;
+  const vtkIdType* ptIds;
+  double p[3], closest[3], t;
+  for (vtkIdType i = begin; i < end; i++)
   {
-    this->DeleteTree(OBBptr->Kids[0]);
-    this->DeleteTree(OBBptr->Kids[1]);
-    delete OBBptr->Kids[0];
-    delete OBBptr->Kids[1];
+    dataSet->GetCellPoints(cells[i], numPts, ptIds, cellPts);
+    for (vtkIdType j = 0; j < numPts; j++)
+    {
+      dataSet->GetPoint(ptIds[j], p);
+      for (int k = 0; k < 3; k++)
+      {
+        vtkLine::DistanceToLine(p, mean, axisEnds[k], t, closest);
+        tMin[k] = std::min(t, tMin[k]);
+        tMax[k] = std::max(t, tMax[k]);
+      }
+    }
   }
 }
 
 //------------------------------------------------------------------------------
-// Compute an OBB from the list of points given. Return the corner point
-// and the three axes defining the orientation of the OBB. Also return
-// a sorted list of relative "sizes" of axes for comparison purposes.
-void vtkOBBTree::ComputeOBB(
-  vtkPoints* pts, double corner[3], double max[3], double mid[3], double min[3], double size[3])
+// Compute the OBB of a list of cells, see vtkOBBTree::ComputeOBB. The points of the cells
+// shared by several cells are projected several times, which does not change their extent.
+void ComputeCellsOBB(vtkDataSet* dataSet, vtkIdList* cellList, double corner[3], double max[3],
+  double mid[3], double min[3], double size[3])
 {
-  int i;
-  vtkIdType numPts, pointId;
-  double x[3], mean[3], xp[3], *v[3], v0[3], v1[3], v2[3];
+  const vtkIdType numCells = cellList->GetNumberOfIds();
+  const vtkIdType* cells = cellList->GetPointer(0);
+  const vtkIdType numBlocks = GetNumberOfBlocks(numCells);
+  int i, j;
+  double mean[3], *v[3], v0[3], v1[3], v2[3];
   double *a[3], a0[3], a1[3], a2[3];
-  double tMin[3], tMax[3], closest[3], t;
+  double tMin[3], tMax[3];
 
   //
-  // Compute mean
+  // Compute mean & moments
   //
-  numPts = pts->GetNumberOfPoints();
-  mean[0] = mean[1] = mean[2] = 0.0;
-  for (pointId = 0; pointId < numPts; pointId++)
+  std::vector<OBBMoments> blockMoments(numBlocks);
+  ForEachBlock(numCells,
+    [&](vtkIdType block, vtkIdType begin, vtkIdType end, vtkIdList* cellPts)
+    { AddCellMoments(dataSet, cells, begin, end, cellPts, blockMoments[block]); });
+  OBBMoments moments;
+  for (const OBBMoments& blockMoment : blockMoments)
   {
-    pts->GetPoint(pointId, x);
-    for (i = 0; i < 3; i++)
-    {
-      mean[i] += x[i];
-    }
+    moments.Add(blockMoment);
   }
+
+  // normalize data
   for (i = 0; i < 3; i++)
   {
-    mean[i] /= numPts;
+    mean[i] = moments.Mean[i] / moments.Mass;
   }
 
-  //
-  // Compute covariance matrix
-  //
+  // matrix is symmetric
   a[0] = a0;
   a[1] = a1;
   a[2] = a2;
   for (i = 0; i < 3; i++)
   {
-    a0[i] = a1[i] = a2[i] = 0.0;
-  }
-
-  for (pointId = 0; pointId < numPts; pointId++)
-  {
-    pts->GetPoint(pointId, x);
-    xp[0] = x[0] - mean[0];
-    xp[1] = x[1] - mean[1];
-    xp[2] = x[2] - mean[2];
-    for (i = 0; i < 3; i++)
+    for (j = i; j < 3; j++)
     {
-      a0[i] += xp[0] * xp[i];
-      a1[i] += xp[1] * xp[i];
-      a2[i] += xp[2] * xp[i];
+      a[i][j] = a[j][i] = moments.A[i][j];
     }
-  } // for all points
+  }
 
+  // get covariance from moments
   for (i = 0; i < 3; i++)
   {
-    a0[i] /= numPts;
-    a1[i] /= numPts;
-    a2[i] /= numPts;
+    for (j = 0; j < 3; j++)
+    {
+      a[i][j] = a[i][j] / moments.Mass - mean[i] * mean[j];
+    }
   }
 
   //
@@ -185,29 +273,36 @@ void vtkOBBTree::ComputeOBB(
   min[1] = v[1][2];
   min[2] = v[2][2];
 
+  double axisEnds[3][3];
   for (i = 0; i < 3; i++)
   {
-    a[0][i] = mean[i] + max[i];
-    a[1][i] = mean[i] + mid[i];
-    a[2][i] = mean[i] + min[i];
+    axisEnds[0][i] = mean[i] + max[i];
+    axisEnds[1][i] = mean[i] + mid[i];
+    axisEnds[2][i] = mean[i] + min[i];
   }
 
   //
   // Create oriented bounding box by projecting points onto eigenvectors.
   //
+  std::vector<std::array<double, 6>> blockExtents(
+    numBlocks, { VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX,
+                 -VTK_DOUBLE_MAX });
+  ForEachBlock(numCells,
+    [&](vtkIdType block, vtkIdType begin, vtkIdType end, vtkIdList* cellPts)
+    {
+      double* extent = blockExtents[block].data();
+      AddCellExtent(dataSet, cells, begin, end, cellPts, mean, axisEnds, extent, extent + 3);
+    });
   tMin[0] = tMin[1] = tMin[2] = VTK_DOUBLE_MAX;
   tMax[0] = tMax[1] = tMax[2] = -VTK_DOUBLE_MAX;
-
-  for (pointId = 0; pointId < numPts; pointId++)
+  for (const auto& extent : blockExtents)
   {
-    pts->GetPoint(pointId, x);
     for (i = 0; i < 3; i++)
     {
-      vtkLine::DistanceToLine(x, mean, a[i], t, closest);
-      tMin[i] = std::min(t, tMin[i]);
-      tMax[i] = std::max(t, tMax[i]);
+      tMin[i] = std::min(extent[i], tMin[i]);
+      tMax[i] = std::max(extent[i + 3], tMax[i]);
     }
-  } // for all points
+  }
 
   for (i = 0; i < 3; i++)
   {
@@ -220,174 +315,392 @@ void vtkOBBTree::ComputeOBB(
 }
 
 //------------------------------------------------------------------------------
-// a method to compute the OBB of a dataset without having to go through the
-// Execute method; It does set
-void vtkOBBTree::ComputeOBB(
-  vtkDataSet* input, double corner[3], double max[3], double mid[3], double min[3], double size[3])
+// Assign the cells to the sides of the plane of normal n going through p: rightSide is set to
+// 1 for the cells on the positive side. Cells straddling the plane are assigned according to
+// their centroid. Return the number of cells on the positive side.
+vtkIdType ClassifyCells(vtkDataSet* dataSet, vtkIdList* cellList, const double n[3],
+  const double p[3], unsigned char* rightSide)
 {
-  vtkIdType numPts, numCells, i;
-  vtkIdList* cellList;
-  vtkDataSet* origDataSet;
-
-  vtkDebugMacro(<< "Computing OBB");
+  const vtkIdType numCells = cellList->GetNumberOfIds();
+  const vtkIdType* cells = cellList->GetPointer(0);
+  std::vector<vtkIdType> blockCounts(GetNumberOfBlocks(numCells), 0);
+  ForEachBlock(numCells,
+    [&](vtkIdType block, vtkIdType begin, vtkIdType end, vtkIdList* cellPts)
+    {
+      vtkIdType numPts;
+      const vtkIdType* ptIds;
+      double x[3], c[3], val;
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        dataSet->GetCellPoints(cells[i], numPts, ptIds, cellPts);
+        c[0] = c[1] = c[2] = 0.0;
+        bool negative = false, positive = false;
+        for (vtkIdType j = 0; j < numPts; j++)
+        {
+          dataSet->GetPoint(ptIds[j], x);
+          val = n[0] * (x[0] - p[0]) + n[1] * (x[1] - p[1]) + n[2] * (x[2] - p[2]);
+          c[0] += x[0];
+          c[1] += x[1];
+          c[2] += x[2];
+          if (val < 0.0)
+          {
+            negative = true;
+          }
+          else
+          {
+            positive = true;
+          }
+        }
 
-  if (input == nullptr || (numPts = input->GetNumberOfPoints()) < 1 ||
-    (input->GetNumberOfCells()) < 1)
+        if (negative && positive)
+        { // Use centroid to decide straddle cases
+          c[0] /= numPts;
+          c[1] /= numPts;
+          c[2] /= numPts;
+          negative = n[0] * (c[0] - p[0]) + n[1] * (c[1] - p[1]) + n[2] * (c[2] - p[2]) < 0.0;
+        }
+        rightSide[i] = negative ? 0 : 1;
+        blockCounts[block] += rightSide[i];
+      }
+    });
+  vtkIdType numInRHnode = 0;
+  for (vtkIdType count : blockCounts)
   {
-    vtkErrorMacro(<< "Can't compute OBB - no data available!");
-    return;
+    numInRHnode += count;
   }
-  numCells = input->GetNumberOfCells();
-
-  // save previous value of DataSet and reset after calling ComputeOBB because
-  // computeOBB used this->DataSet internally
-  origDataSet = this->DataSet;
-  this->DataSet = input;
+  return numInRHnode;
+}
 
-  // these are other member variables that ComputeOBB requires
-  this->OBBCount = 0;
-  this->InsertedPoints = new int[numPts];
-  for (i = 0; i < numPts; i++)
-  {
-    this->InsertedPoints[i] = 0;
-  }
-  this->PointsList = vtkPoints::New();
-  this->PointsList->Allocate(numPts);
+//------------------------------------------------------------------------------
+// Recursive construction of the tree, see vtkOBBTree::BuildTree.
+struct OBBTreeBuilder
+{
+  vtkDataSet* DataSet;
+  int MaxLevel;
+  int NumberOfCellsPerNode;
+  bool RetainCellLists;
+  std::atomic<int> Level;
+  std::atomic<int> NumberOfNodes;
 
-  cellList = vtkIdList::New();
-  cellList->Allocate(numCells);
-  for (i = 0; i < numCells; i++)
+  OBBTreeBuilder(vtkDataSet* dataSet, int maxLevel, int numberOfCellsPerNode,
+    bool retainCellLists, int level)
+    : DataSet(dataSet)
+    , MaxLevel(maxLevel)
+    , NumberOfCellsPerNode(numberOfCellsPerNode)
+    , RetainCellLists(retainCellLists)
+    , Level(level)
+    , NumberOfNodes(0)
   {
-    cellList->InsertId(i, i);
   }
 
-  this->ComputeOBB(cellList, corner, max, mid, min, size);
-
-  this->DataSet = origDataSet;
-  delete[] this->InsertedPoints;
-  this->PointsList->Delete();
-  cellList->Delete();
-}
+  // Frees its first argument, or keeps it in the node if it is a leaf.
+  void Build(vtkIdList* cells, vtkOBBNode* OBBptr, int level);
+};
 
 //------------------------------------------------------------------------------
-// Compute an OBB from the list of cells given. Return the corner point
-// and the three axes defining the orientation of the OBB. Also return
-// a sorted list of relative "sizes" of axes for comparison purposes.
-void vtkOBBTree::ComputeOBB(
-  vtkIdList* cells, double corner[3], double max[3], double mid[3], double min[3], double size[3])
+void OBBTreeBuilder::Build(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
 {
-  vtkIdType numCells, i, j, cellId, ptId, pId, qId, rId;
-  int k, type;
-  vtkIdType numPts = 0;
-  const vtkIdType* ptIds = nullptr;
-  double p[3], q[3], r[3], mean[3], xp[3], *v[3], v0[3], v1[3], v2[3];
-  double *a[3], a0[3], a1[3], a2[3];
-  double tMin[3], tMax[3], closest[3], t;
-  double dp0[3], dp1[3], tri_mass, tot_mass, c[3];
+  const vtkIdType numCells = cells->GetNumberOfIds();
+  double size[3];
 
-  this->OBBCount++;
-  this->PointsList->Reset();
+  int deepestLevel = this->Level.load();
+  while (level > deepestLevel && !this->Level.compare_exchange_weak(deepestLevel, level))
+  {
+  }
+  this->NumberOfNodes++;
   //
-  // Compute mean & moments
+  // Now compute the OBB
   //
+  ComputeCellsOBB(
+    this->DataSet, cells, OBBptr->Corner, OBBptr->Axes[0], OBBptr->Axes[1], OBBptr->Axes[2], size);
 
-  numCells = cells->GetNumberOfIds();
-  mean[0] = mean[1] = mean[2] = 0.0;
-  tot_mass = 0.0;
-  a[0] = a0;
-  a[1] = a1;
-  a[2] = a2;
-  for (i = 0; i < 3; i++)
+  //
+  // Check whether to continue recursing; if so, create two children and
+  // assign cells to appropriate child.
+  //
+  if (level < this->MaxLevel && numCells > this->NumberOfCellsPerNode)
   {
-    a0[i] = a1[i] = a2[i] = 0.0;
+    std::vector<unsigned char> rightSide(numCells);
+    double n[3], p[3], ratio, bestRatio;
+    int splitAcceptable, splitPlane, foundBestSplit, bestPlane = 0, i;
+    vtkIdType numInLHnode = 0, numInRHnode = 0;
+
+    // loop over three split planes to find acceptable one
+    for (i = 0; i < 3; i++) // compute split point
+    {
+      p[i] = OBBptr->Corner[i] + OBBptr->Axes[0][i] / 2.0 + OBBptr->Axes[1][i] / 2.0 +
+        OBBptr->Axes[2][i] / 2.0;
+    }
+
+    bestRatio = 1.0; // worst case ratio
+    foundBestSplit = 0;
+    for (splitPlane = 0, splitAcceptable = 0; !splitAcceptable && splitPlane < 3;)
+    {
+      // compute split normal
+      for (i = 0; i < 3; i++)
+      {
+        n[i] = OBBptr->Axes[splitPlane][i];
+      }
+      vtkMath::Normalize(n);
+
+      // assign cells to the appropriate child
+      numInRHnode = ClassifyCells(this->DataSet, cells, n, p, rightSide.data());
+      numInLHnode = numCells - numInRHnode;
+
+      // evaluate this split
+      ratio = fabs(((double)numInRHnode - numInLHnode) / numCells);
+
+      // see whether we've found acceptable split plane
+      if (ratio < 0.6 || foundBestSplit) // accept right off the bat
+      {
+        splitAcceptable = 1;
+      }
+      else
+      { // not a great split try another
+        if (ratio < bestRatio)
+        {
+          bestRatio = ratio;
+          bestPlane = splitPlane;
+        }
+        if (++splitPlane == 3 && bestRatio < 0.95)
+        { // at closing time, even the ugly ones look good
+          splitPlane = bestPlane;
+          foundBestSplit = 1;
+        }
+      } // try another split
+
+    } // for each split
+
+    if (splitAcceptable) // otherwise recursion terminates
+    {
+      vtkIdList* kidCells[2] = { vtkIdList::New(), vtkIdList::New() };
+      kidCells[0]->Allocate(numInLHnode);
+      kidCells[1]->Allocate(numInRHnode);
+      for (vtkIdType cellIdx = 0; cellIdx < numCells; cellIdx++)
+      {
+        kidCells[rightSide[cellIdx]]->InsertNextId(cells->GetId(cellIdx));
+      }
+      cells->Delete();
+      cells = nullptr; // don't need to keep anymore
+
+      OBBptr->Kids = new vtkOBBNode*[2];
+      for (i = 0; i < 2; i++)
+      {
+        OBBptr->Kids[i] = new vtkOBBNode;
+        OBBptr->Kids[i]->Parent = OBBptr;
+      }
+      auto buildKids = [&](vtkIdType firstKid, vtkIdType lastKid)
+      {
+        for (vtkIdType kid = firstKid; kid < lastKid; kid++)
+        {
+          this->Build(kidCells[kid], OBBptr->Kids[kid], level + 1);
+        }
+      };
+      if (numCells > OBBConcurrentBuildSize)
+      {
+        vtkSMPTools::For(0, 2, 1, buildKids);
+      }
+      else
+      {
+        buildKids(0, 2);
+      }
+    }
+  } // if should build tree
+
+  if (cells && this->RetainCellLists)
+  {
+    cells->Squeeze();
+    OBBptr->Cells = cells;
   }
+  else if (cells)
+  {
+    cells->Delete();
+  }
+}
 
-  for (i = 0; i < numCells; i++)
+//------------------------------------------------------------------------------
+// Same as vtkOBBTree::LineIntersectsNode, for the segments a[r], b[r] whose bit r is set in
+// mask. Return the mask of the segments intersecting the node.
+OBBRayMask LinesIntersectNode(vtkOBBNode* pA, double tolerance, const double a[][3],
+  const double b[][3], OBBRayMask mask)
+{
+  for (int ii = 0; ii < 3 && mask; ii++)
   {
-    cellId = cells->GetId(i);
-    type = this->DataSet->GetCellType(cellId);
-    switch (this->DataSet->GetDataObjectType())
-    {
-      case VTK_POLY_DATA:
-        ((vtkPolyData*)this->DataSet)->GetCellPoints(cellId, numPts, ptIds);
-        break;
-      case VTK_UNSTRUCTURED_GRID:
-        ((vtkUnstructuredGrid*)this->DataSet)->GetCellPoints(cellId, numPts, ptIds);
-        break;
-      default:
-        vtkErrorMacro(<< "DataSet " << this->DataSet->GetClassName() << " not supported.");
-        break;
+    // computing A range is easy...
+    const double rangeAmin = vtkMath::Dot(pA->Corner, pA->Axes[ii]);
+    const double rangeAmax = rangeAmin + vtkMath::Dot(pA->Axes[ii], pA->Axes[ii]);
+    double eps = tolerance;
+    if (eps != 0)
+    { // avoid sqrt call if tolerance check isn't being done
+      eps *= sqrt(fabs(rangeAmax - rangeAmin));
     }
-    for (j = 0; j < numPts - 2; j++)
+
+    for (int r = 0; r < OBBPacketSize; r++)
     {
-      vtkCELLTRIANGLES(ptIds, type, j, pId, qId, rId);
-      if (pId < 0)
+      const OBBRayMask bit = OBBRayMask(1) << r;
+      if (!(mask & bit))
       {
         continue;
       }
-      this->DataSet->GetPoint(pId, p);
-      this->DataSet->GetPoint(qId, q);
-      this->DataSet->GetPoint(rId, r);
-      // p, q, and r are the oriented triangle points.
-      // Compute the components of the moment of inertia tensor.
-      for (k = 0; k < 3; k++)
+      // compute B range...
+      double rangeBmin = vtkMath::Dot(a[r], pA->Axes[ii]);
+      double rangeBmax = rangeBmin;
+      const double dotB = vtkMath::Dot(b[r], pA->Axes[ii]);
+      if (dotB < rangeBmin)
       {
-        // two edge vectors
-        dp0[k] = q[k] - p[k];
-        dp1[k] = r[k] - p[k];
-        // centroid
-        c[k] = (p[k] + q[k] + r[k]) / 3;
+        rangeBmin = dotB;
       }
-      vtkMath::Cross(dp0, dp1, xp);
-      tri_mass = 0.5 * vtkMath::Norm(xp);
-      tot_mass += tri_mass;
-      for (k = 0; k < 3; k++)
+      else
       {
-        mean[k] += tri_mass * c[k];
+        rangeBmax = dotB;
       }
+      if ((rangeAmax + eps < rangeBmin) || (rangeBmax + eps < rangeAmin))
+      {
+        mask &= ~bit;
+      }
+    }
+  }
+  return mask;
+}
+}
 
-      // on-diagonal terms
-      a0[0] += tri_mass * (9 * c[0] * c[0] + p[0] * p[0] + q[0] * q[0] + r[0] * r[0]) / 12;
-      a1[1] += tri_mass * (9 * c[1] * c[1] + p[1] * p[1] + q[1] * q[1] + r[1] * r[1]) / 12;
-      a2[2] += tri_mass * (9 * c[2] * c[2] + p[2] * p[2] + q[2] * q[2] + r[2] * r[2]) / 12;
+//------------------------------------------------------------------------------
+vtkOBBNode::vtkOBBNode()
+{
+  this->Cells = nullptr;
+  this->Parent = nullptr;
+  this->Kids = nullptr;
+}
 
-      // off-diagonal terms
-      a0[1] += tri_mass * (9 * c[0] * c[1] + p[0] * p[1] + q[0] * q[1] + r[0] * r[1]) / 12;
-      a0[2] += tri_mass * (9 * c[0] * c[2] + p[0] * p[2] + q[0] * q[2] + r[0] * r[2]) / 12;
-      a1[2] += tri_mass * (9 * c[1] * c[2] + p[1] * p[2] + q[1] * q[2] + r[1] * r[2]) / 12;
-    } // end foreach triangle
+//------------------------------------------------------------------------------
+vtkOBBNode::~vtkOBBNode()
+{
+  delete[] this->Kids;
+  if (this->Cells)
+  {
+    this->Cells->Delete();
+  }
+}
+
+// The constructor initializes the deprecated PointsList and InsertedPoints.
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+
+//------------------------------------------------------------------------------
+// Construct with automatic computation of divisions, averaging
+// 25 cells per octant.
+vtkOBBTree::vtkOBBTree()
+{
+  this->DataSet = nullptr;
+  this->Level = 0;
+  this->MaxLevel = 12;
+  this->Tolerance = 0.01;
+  this->Tree = nullptr;
+  this->OBBCount = 0;
+}
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#pragma GCC diagnostic pop
+#endif
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+//------------------------------------------------------------------------------
+vtkOBBTree::~vtkOBBTree()
+{
+  this->FreeSearchStructure();
+}
+
+//------------------------------------------------------------------------------
+void vtkOBBTree::FreeSearchStructure()
+{
+  if (this->Tree)
+  {
+    this->DeleteTree(this->Tree);
+    delete this->Tree;
+    this->Tree = nullptr;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkOBBTree::DeleteTree(vtkOBBNode* OBBptr)
+{
+  if (OBBptr->Kids != nullptr)
+  {
+    this->DeleteTree(OBBptr->Kids[0]);
+    this->DeleteTree(OBBptr->Kids[1]);
+    delete OBBptr->Kids[0];
+    delete OBBptr->Kids[1];
+  }
+}
+
+//------------------------------------------------------------------------------
+// Compute an OBB from the list of points given. Return the corner point
+// and the three axes defining the orientation of the OBB. Also return
+// a sorted list of relative "sizes" of axes for comparison purposes.
+void vtkOBBTree::ComputeOBB(
+  vtkPoints* pts, double corner[3], double max[3], double mid[3], double min[3], double size[3])
+{
+  int i;
+  vtkIdType numPts, pointId;
+  double x[3], mean[3], xp[3], *v[3], v0[3], v1[3], v2[3];
+  double *a[3], a0[3], a1[3], a2[3];
+  double tMin[3], tMax[3], closest[3], t;
 
-    // While computing cell moments, gather all the cell's
-    // point coordinates into a single list.
-    //
-    for (j = 0; j < numPts; j++)
+  //
+  // Compute mean
+  //
+  numPts = pts->GetNumberOfPoints();
+  mean[0] = mean[1] = mean[2] = 0.0;
+  for (pointId = 0; pointId < numPts; pointId++)
+  {
+    pts->GetPoint(pointId, x);
+    for (i = 0; i < 3; i++)
     {
-      if (this->InsertedPoints[ptIds[j]] != this->OBBCount)
-      {
-        this->InsertedPoints[ptIds[j]] = this->OBBCount;
-        this->PointsList->InsertNextPoint(this->DataSet->GetPoint(ptIds[j]));
-      }
-    } // for all points of this cell
-  }   // end foreach cell
-
-  // normalize data
+      mean[i] += x[i];
+    }
+  }
   for (i = 0; i < 3; i++)
   {
-    mean[i] = mean[i] / tot_mass;
+    mean[i] /= numPts;
   }
 
-  // matrix is symmetric
-  a1[0] = a0[1];
-  a2[0] = a0[2];
-  a2[1] = a1[2];
-
-  // get covariance from moments
+  //
+  // Compute covariance matrix
+  //
+  a[0] = a0;
+  a[1] = a1;
+  a[2] = a2;
   for (i = 0; i < 3; i++)
   {
-    for (j = 0; j < 3; j++)
+    a0[i] = a1[i] = a2[i] = 0.0;
+  }
+
+  for (pointId = 0; pointId < numPts; pointId++)
+  {
+    pts->GetPoint(pointId, x);
+    xp[0] = x[0] - mean[0];
+    xp[1] = x[1] - mean[1];
+    xp[2] = x[2] - mean[2];
+    for (i = 0; i < 3; i++)
     {
-      a[i][j] = a[i][j] / tot_mass - mean[i] * mean[j];
+      a0[i] += xp[0] * xp[i];
+      a1[i] += xp[1] * xp[i];
+      a2[i] += xp[2] * xp[i];
     }
+  } // for all points
+
+  for (i = 0; i < 3; i++)
+  {
+    a0[i] /= numPts;
+    a1[i] /= numPts;
+    a2[i] /= numPts;
   }
 
   //
@@ -420,13 +733,12 @@ void vtkOBBTree::ComputeOBB(
   tMin[0] = tMin[1] = tMin[2] = VTK_DOUBLE_MAX;
   tMax[0] = tMax[1] = tMax[2] = -VTK_DOUBLE_MAX;
 
-  numPts = this->PointsList->GetNumberOfPoints();
-  for (ptId = 0; ptId < numPts; ptId++)
+  for (pointId = 0; pointId < numPts; pointId++)
   {
-    this->PointsList->GetPoint(ptId, p);
+    pts->GetPoint(pointId, x);
     for (i = 0; i < 3; i++)
     {
-      vtkLine::DistanceToLine(p, mean, a[i], t, closest);
+      vtkLine::DistanceToLine(x, mean, a[i], t, closest);
       tMin[i] = std::min(t, tMin[i]);
       tMax[i] = std::max(t, tMax[i]);
     }
@@ -442,6 +754,80 @@ void vtkOBBTree::ComputeOBB(
   }
 }
 
+//------------------------------------------------------------------------------
+// a method to compute the OBB of a dataset without having to go through the
+// Execute method; It does set
+void vtkOBBTree::ComputeOBB(
+  vtkDataSet* input, double corner[3], double max[3], double mid[3], double min[3], double size[3])
+{
+  vtkIdType numCells, i;
+  vtkIdList* cellList;
+  vtkDataSet* origDataSet;
+
+  vtkDebugMacro(<< "Computing OBB");
+
+  if (input == nullptr || input->GetNumberOfPoints() < 1 || (input->GetNumberOfCells()) < 1)
+  {
+    vtkErrorMacro(<< "Can't compute OBB - no data available!");
+    return;
+  }
+  if (!this->PrepareDataSet(input))
+  {
+    return;
+  }
+  numCells = input->GetNumberOfCells();
+
+  // save previous value of DataSet and reset after calling ComputeOBB because
+  // computeOBB used this->DataSet internally
+  origDataSet = this->DataSet;
+  this->DataSet = input;
+
+  // these are other member variables that ComputeOBB requires
+  this->OBBCount = 0;
+
+  cellList = vtkIdList::New();
+  cellList->SetNumberOfIds(numCells);
+  for (i = 0; i < numCells; i++)
+  {
+    cellList->SetId(i, i);
+  }
+
+  this->ComputeOBB(cellList, corner, max, mid, min, size);
+
+  this->DataSet = origDataSet;
+  cellList->Delete();
+}
+
+//------------------------------------------------------------------------------
+// Check that the cells of the data set can be traversed, and build them so
+// that they can be traversed concurrently.
+bool vtkOBBTree::PrepareDataSet(vtkDataSet* dataSet)
+{
+  if (dataSet->GetDataObjectType() != VTK_POLY_DATA &&
+    dataSet->GetDataObjectType() != VTK_UNSTRUCTURED_GRID)
+  {
+    vtkErrorMacro(<< "DataSet " << dataSet->GetClassName() << " not supported.");
+    return false;
+  }
+  vtkIdType numPts;
+  const vtkIdType* ptIds;
+  vtkNew<vtkIdList> cellPts;
+  dataSet->GetCellType(0);
+  dataSet->GetCellPoints(0, numPts, ptIds, cellPts);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Compute an OBB from the list of cells given. Return the corner point
+// and the three axes defining the orientation of the OBB. Also return
+// a sorted list of relative "sizes" of axes for comparison purposes.
+void vtkOBBTree::ComputeOBB(
+  vtkIdList* cells, double corner[3], double max[3], double mid[3], double min[3], double size[3])
+{
+  this->OBBCount++;
+  ComputeCellsOBB(this->DataSet, cells, corner, max, mid, min, size);
+}
+
 //------------------------------------------------------------------------------
 // Efficient check for whether a line p1,p2 intersects with triangle
 // pt1,pt2,pt3 to within specified tolerance.  This is included here
@@ -969,6 +1355,105 @@ int vtkOBBTree::IntersectWithLine(const double a0[3], const double a1[3], double
   return 0;
 }
 
+//------------------------------------------------------------------------------
+// The segments are intersected by packets: the tree is traversed once for all the
+// segments of a packet, and each cell of the leaves intersected by at least one of
+// them is fetched once. The nodes and the cells are visited in the same order as
+// IntersectWithLine() does, so that the results are the same.
+void vtkOBBTree::IntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol, vtkIdList* cellIds,
+  vtkPoints* points, vtkDoubleArray* t)
+{
+  this->BuildLocator();
+  // Check and resize the outputs, with no intersection found.
+  this->BatchIntersectWithLines(p1, p2, tol, cellIds, points, t,
+    [](const double*, const double*, double, double&, double*, double*, int&, vtkIdType&,
+      vtkGenericCell*) { return 0; });
+  const vtkIdType numLines = cellIds->GetNumberOfIds();
+  if (this->Tree == nullptr || numLines == 0)
+  {
+    return;
+  }
+
+  const vtkIdType numPackets = (numLines + OBBPacketSize - 1) / OBBPacketSize;
+  vtkSMPThreadLocalObject<vtkGenericCell> localCell;
+  vtkSMPTools::For(0, numPackets,
+    [&](vtkIdType firstPacket, vtkIdType lastPacket)
+    {
+      vtkGenericCell* cell = localCell.Local();
+      std::vector<std::pair<vtkOBBNode*, OBBRayMask>> OBBstack;
+      OBBstack.reserve(this->GetLevel() + 1);
+      double a[OBBPacketSize][3], b[OBBPacketSize][3], tBest[OBBPacketSize];
+      double xBest[OBBPacketSize][3], tHit, x[3], pcoords[3];
+      vtkIdType cellIdBest[OBBPacketSize];
+      int subId;
+      for (vtkIdType packet = firstPacket; packet < lastPacket; packet++)
+      {
+        const vtkIdType first = packet * OBBPacketSize;
+        const int numRays = static_cast<int>(std::min<vtkIdType>(OBBPacketSize, numLines - first));
+        for (int r = 0; r < numRays; r++)
+        {
+          p1->GetPoint(first + r, a[r]);
+          p2->GetPoint(first + r, b[r]);
+          tBest[r] = VTK_DOUBLE_MAX;
+          cellIdBest[r] = -1;
+        }
+
+        OBBstack.emplace_back(this->Tree,
+          numRays == OBBPacketSize ? ~OBBRayMask(0) : (OBBRayMask(1) << numRays) - 1);
+        while (!OBBstack.empty())
+        { // simulate recursion without the overhead or limitations
+          vtkOBBNode* node = OBBstack.back().first;
+          const OBBRayMask mask =
+            LinesIntersectNode(node, this->Tolerance, a, b, OBBstack.back().second);
+          OBBstack.pop_back();
+          if (!mask)
+          {
+            continue;
+          }
+          if (node->Kids == nullptr)
+          { // then this is a leaf node...get Cells
+            for (vtkIdType ii = 0; ii < node->Cells->GetNumberOfIds(); ii++)
+            {
+              vtkIdType thisId = node->Cells->GetId(ii);
+              this->DataSet->GetCell(thisId, cell);
+              for (int r = 0; r < numRays; r++)
+              {
+                if ((mask & (OBBRayMask(1) << r)) &&
+                  cell->IntersectWithLine(a[r], b[r], tol, tHit, x, pcoords, subId) &&
+                  tHit < tBest[r])
+                { // line intersects cell, and it's the best one
+                  tBest[r] = tHit;
+                  xBest[r][0] = x[0];
+                  xBest[r][1] = x[1];
+                  xBest[r][2] = x[2];
+                  cellIdBest[r] = thisId;
+                }
+              }
+            }
+          }
+          else
+          { // push kids onto stack
+            OBBstack.emplace_back(node->Kids[0], mask);
+            OBBstack.emplace_back(node->Kids[1], mask);
+          }
+        } // end while
+
+        for (int r = 0; r < numRays; r++)
+        {
+          cellIds->SetId(first + r, cellIdBest[r]);
+          if (points)
+          {
+            points->SetPoint(first + r, cellIdBest[r] >= 0 ? xBest[r] : a[r]);
+          }
+          if (t)
+          {
+            t->SetValue(first + r, cellIdBest[r] >= 0 ? tBest[r] : 0.0);
+          }
+        }
+      }
+    });
+}
+
 //------------------------------------------------------------------------------
 void vtkOBBNode::DebugPrintTree(int level, double* leaf_vol, int* minCells, int* maxCells)
 {
@@ -1049,36 +1534,32 @@ void vtkOBBTree::ForceBuildLocator()
 //------------------------------------------------------------------------------
 void vtkOBBTree::BuildLocatorInternal()
 {
-  vtkIdType numPts, numCells, i;
+  vtkIdType numCells, i;
   vtkIdList* cellList;
 
   vtkDebugMacro(<< "Building OBB tree");
 
-  numPts = this->DataSet->GetNumberOfPoints();
-  numCells = this->DataSet->GetNumberOfCells();
-  if (this->DataSet == nullptr || numPts < 1 || numCells < 1)
+  if (this->DataSet == nullptr || this->DataSet->GetNumberOfPoints() < 1 ||
+    (numCells = this->DataSet->GetNumberOfCells()) < 1)
   {
     vtkErrorMacro(<< "Can't build OBB tree - no data available!");
     return;
   }
-
-  this->OBBCount = 0;
-  this->InsertedPoints = new int[numPts];
-  for (i = 0; i < numPts; i++)
+  if (!this->PrepareDataSet(this->DataSet))
   {
-    this->InsertedPoints[i] = 0;
+    return;
   }
-  this->PointsList = vtkPoints::New();
-  this->PointsList->Allocate(numPts);
+
+  this->OBBCount = 0;
 
   //
   // Begin recursively creating OBB's
   //
   cellList = vtkIdList::New();
-  cellList->Allocate(numCells);
+  cellList->SetNumberOfIds(numCells);
   for (i = 0; i < numCells; i++)
   {
-    cellList->InsertId(i, i);
+    cellList->SetId(i, i);
   }
 
   this->FreeSearchStructure();
@@ -1099,12 +1580,6 @@ void vtkOBBTree::BuildLocatorInternal()
     std::cout.flush();
   }
 
-  //
-  // Clean up
-  //
-  delete[] this->InsertedPoints;
-  this->PointsList->Delete();
-
   this->BuildTime.Modified();
 }
 
@@ -1113,164 +1588,15 @@ void vtkOBBTree::BuildLocatorInternal()
 // frees its first argument
 void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
 {
-  vtkIdType i, j, numCells = cells->GetNumberOfIds();
-  vtkIdType cellId;
-  vtkIdType ptId;
-  vtkIdList* cellPts = vtkIdList::New();
-  double size[3];
-
-  this->Level = std::max(level, this->Level);
-  //
-  // Now compute the OBB
-  //
-  this->ComputeOBB(cells, OBBptr->Corner, OBBptr->Axes[0], OBBptr->Axes[1], OBBptr->Axes[2], size);
-
-  //
-  // Check whether to continue recursing; if so, create two children and
-  // assign cells to appropriate child.
-  //
-  if (level < this->MaxLevel && numCells > this->NumberOfCellsPerNode)
-  {
-    vtkIdList* LHlist = vtkIdList::New();
-    LHlist->Allocate(cells->GetNumberOfIds() / 2);
-    vtkIdList* RHlist = vtkIdList::New();
-    RHlist->Allocate(cells->GetNumberOfIds() / 2);
-    double n[3], p[3], c[3], x[3], val, ratio, bestRatio;
-    int negative, positive, splitAcceptable, splitPlane;
-    int foundBestSplit, bestPlane = 0, numPts;
-    int numInLHnode, numInRHnode;
-
-    // loop over three split planes to find acceptable one
-    for (i = 0; i < 3; i++) // compute split point
-    {
-      p[i] = OBBptr->Corner[i] + OBBptr->Axes[0][i] / 2.0 + OBBptr->Axes[1][i] / 2.0 +
-        OBBptr->Axes[2][i] / 2.0;
-    }
-
-    bestRatio = 1.0; // worst case ratio
-    foundBestSplit = 0;
-    for (splitPlane = 0, splitAcceptable = 0; !splitAcceptable && splitPlane < 3;)
-    {
-      // compute split normal
-      for (i = 0; i < 3; i++)
-      {
-        n[i] = OBBptr->Axes[splitPlane][i];
-      }
-      vtkMath::Normalize(n);
-
-      // traverse cells, assigning to appropriate child list as necessary
-      for (i = 0; i < numCells; i++)
-      {
-        cellId = cells->GetId(i);
-        this->DataSet->GetCellPoints(cellId, cellPts);
-        c[0] = c[1] = c[2] = 0.0;
-        numPts = cellPts->GetNumberOfIds();
-        for (negative = positive = j = 0; j < numPts; j++)
-        {
-          ptId = cellPts->GetId(j);
-          this->DataSet->GetPoint(ptId, x);
-          val = n[0] * (x[0] - p[0]) + n[1] * (x[1] - p[1]) + n[2] * (x[2] - p[2]);
-          c[0] += x[0];
-          c[1] += x[1];
-          c[2] += x[2];
-          if (val < 0.0)
-          {
-            negative = 1;
-          }
-          else
-          {
-            positive = 1;
-          }
-        }
-
-        if (negative && positive)
-        { // Use centroid to decide straddle cases
-          c[0] /= numPts;
-          c[1] /= numPts;
-          c[2] /= numPts;
-          if (n[0] * (c[0] - p[0]) + n[1] * (c[1] - p[1]) + n[2] * (c[2] - p[2]) < 0.0)
-          {
-            LHlist->InsertNextId(cellId);
-          }
-          else
-          {
-            RHlist->InsertNextId(cellId);
-          }
-        }
-        else
-        {
-          if (negative)
-          {
-            LHlist->InsertNextId(cellId);
-          }
-          else
-          {
-            RHlist->InsertNextId(cellId);
-          }
-        }
-      } // for all cells
-
-      // evaluate this split
-      numInLHnode = LHlist->GetNumberOfIds();
-      numInRHnode = RHlist->GetNumberOfIds();
-      ratio = fabs(((double)numInRHnode - numInLHnode) / numCells);
-
-      // see whether we've found acceptable split plane
-      if (ratio < 0.6 || foundBestSplit) // accept right off the bat
-      {
-        splitAcceptable = 1;
-      }
-      else
-      { // not a great split try another
-        LHlist->Reset();
-        RHlist->Reset();
-        if (ratio < bestRatio)
-        {
-          bestRatio = ratio;
-          bestPlane = splitPlane;
-        }
-        if (++splitPlane == 3 && bestRatio < 0.95)
-        { // at closing time, even the ugly ones look good
-          splitPlane = bestPlane;
-          foundBestSplit = 1;
-        }
-      } // try another split
-
-    } // for each split
-
-    if (splitAcceptable) // otherwise recursion terminates
-    {
-      vtkOBBNode* LHnode = new vtkOBBNode;
-      vtkOBBNode* RHnode = new vtkOBBNode;
-      OBBptr->Kids = new vtkOBBNode*[2];
-      OBBptr->Kids[0] = LHnode;
-      OBBptr->Kids[1] = RHnode;
-      LHnode->Parent = OBBptr;
-      RHnode->Parent = OBBptr;
-
-      cells->Delete();
-      cells = nullptr; // don't need to keep anymore
-      this->BuildTree(LHlist, LHnode, level + 1);
-      this->BuildTree(RHlist, RHnode, level + 1);
-    }
-    else
-    {
-      // free up local objects
-      LHlist->Delete();
-      RHlist->Delete();
-    }
-  } // if should build tree
-
-  if (cells && this->RetainCellLists)
-  {
-    cells->Squeeze();
-    OBBptr->Cells = cells;
-  }
-  else if (cells)
-  {
-    cells->Delete();
-  }
-  cellPts->Delete();
+  OBBTreeBuilder builder(
+    this->DataSet, this->MaxLevel, this->NumberOfCellsPerNode, this->RetainCellLists, this->Level);
+  // The children of the large nodes are built concurrently, and so are the
+  // loops over the cells of these nodes.
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ vtkSMPTools::GetEstimatedNumberOfThreads(),
+                            vtkSMPTools::GetBackend(), true },
+    [&]() { builder.Build(cells, OBBptr, level); });
+  this->Level = builder.Level;
+  this->OBBCount += builder.NumberOfNodes;
 }
 
 //------------------------------------------------------------------------------
@@ -1896,22 +2222,6 @@ void vtkOBBTree::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Tree: (null)\n";
   }
-  if (this->PointsList)
-  {
-    os << indent << "PointsList " << this->PointsList << "\n";
-  }
-  else
-  {
-    os << indent << "PointsList: (null)\n";
-  }
-  if (this->InsertedPoints)
-  {
-    os << indent << "InsertedPoints " << this->InsertedPoints << "\n";
-  }
-  else
-  {
-    os << indent << "InsertedPoints: (null)\n";
-  }
 
   os << indent << "OBBCount " << this->OBBCount << "\n";
 }
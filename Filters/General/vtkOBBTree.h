@@ -17,6 +17,8 @@
  * is found that (approximately) divides the number cells in half. These are
  * then assigned to the children OBB's. This process then continues until
  * the MaxLevel ivar limits the recursion, or no split plane can be found.
+ * The build is threaded with vtkSMPTools, and the tree does not depend on
+ * the number of threads.
  *
  * A good reference for OBB-trees is Gottschalk & Manocha in Proceedings of
  * Siggraph `96.
@@ -55,6 +57,7 @@
 #define vtkOBBTree_h
 
 #include "vtkAbstractCellLocator.h"
+#include "vtkDeprecation.h"          // For VTK_DEPRECATED_IN_9_7_0
 #include "vtkFiltersGeneralModule.h" // For export macro
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -122,6 +125,16 @@ public:
   int IntersectWithLine(
     const double a0[3], const double a1[3], vtkPoints* points, vtkIdList* cellIds) override;
 
+  /**
+   * Intersect the line segments going from the points of `p1` to the points of `p2` with the
+   * data set, see vtkAbstractCellLocator::IntersectWithLines(). The results are the ones of
+   * IntersectWithLine(), but the tree is traversed once for packets of consecutive segments,
+   * which is faster when neighbor segments intersect the same nodes, e.g. for the rays cast
+   * from a camera or from the points of a grid.
+   */
+  void IntersectWithLines(vtkPoints* p1, vtkPoints* p2, double tol, vtkIdList* cellIds,
+    vtkPoints* points = nullptr, vtkDoubleArray* t = nullptr) override;
+
   /**
    * Compute an OBB from the list of points given. Return the corner point
    * and the three axes defining the orientation of the OBB. Also return
@@ -203,10 +216,18 @@ protected:
   void ComputeOBB(vtkIdList* cells, double corner[3], double max[3], double mid[3], double min[3],
     double size[3]);
 
+  // Check that the cells of the data set are supported, and prepare them
+  // to be traversed concurrently.
+  bool PrepareDataSet(vtkDataSet* dataSet);
+
   vtkOBBNode* Tree;
+  // Build the subtree of a node. The children of the large nodes are built
+  // concurrently.
   void BuildTree(vtkIdList* cells, vtkOBBNode* parent, int level);
-  vtkPoints* PointsList;
-  int* InsertedPoints;
+  VTK_DEPRECATED_IN_9_7_0("Not used anymore")
+  vtkPoints* PointsList = nullptr;
+  VTK_DEPRECATED_IN_9_7_0("Not used anymore")
+  int* InsertedPoints = nullptr;
   int OBBCount;
 
   void DeleteTree(vtkOBBNode* OBBptr);
@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that vtkRibbonFilter produces the same output with and without
+// SequentialProcessing.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRibbonFilter.h"
+#include "vtkTestUtilities.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+// Helices of various radii and pitches, each one starting at the last point
+// of the previous one, with point scalars and cell data.
+void CreateInput(vtkPolyData* input, int numLines, int lineLength)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkIntArray> cellIds;
+  cellIds->SetName("CellIds");
+
+  for (int lineId = 0; lineId < numLines; ++lineId)
+  {
+    const double radius = 0.5 + (lineId % 7) * 0.25;
+    const double pitch = 0.1 + (lineId % 5) * 0.05;
+    const double center[2] = { (lineId % 71) * 3.0, (lineId / 71) * 3.0 };
+    lines->InsertNextCell(lineLength);
+    cellIds->InsertNextValue(lineId);
+    for (int i = 0; i < lineLength; ++i)
+    {
+      if (i == 0 && lineId > 0)
+      {
+        lines->InsertCellPoint(points->GetNumberOfPoints() - 1);
+        continue;
+      }
+      const double angle = 0.3 * i + lineId;
+      lines->InsertCellPoint(points->InsertNextPoint(center[0] + radius * std::cos(angle),
+        center[1] + radius * std::sin(angle), pitch * i));
+      scalars->InsertNextValue(0.1 + std::fabs(std::sin(0.1 * i + lineId)));
+    }
+  }
+
+  input->SetPoints(points);
+  input->SetLines(lines);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetCellData()->AddArray(cellIds);
+}
+
+struct Configuration
+{
+  bool VaryWidth;
+  int GenerateTCoords;
+  double Angle;
+  bool UseDefaultNormal;
+};
+
+void Configure(vtkRibbonFilter* ribbons, vtkPolyData* input, const Configuration& config)
+{
+  ribbons->SetInputData(input);
+  ribbons->SetWidth(0.05);
+  ribbons->SetVaryWidth(config.VaryWidth);
+  ribbons->SetGenerateTCoords(config.GenerateTCoords);
+  ribbons->SetAngle(config.Angle);
+  ribbons->SetUseDefaultNormal(config.UseDefaultNormal);
+  ribbons->SetDefaultNormal(0.3, 0.4, 0.5);
+}
+}
+
+int TestRibbonFilterSequentialProcessing(int, char*[])
+{
+  vtkNew<vtkPolyData> input;
+  CreateInput(input, 5000, 50);
+
+  bool status = true;
+  const Configuration configurations[] = {
+    { false, VTK_TCOORDS_OFF, 0.0, false },
+    { true, VTK_TCOORDS_FROM_LENGTH, 30.0, false },
+    { true, VTK_TCOORDS_FROM_NORMALIZED_LENGTH, 0.0, true },
+    { false, VTK_TCOORDS_FROM_SCALARS, 90.0, true },
+  };
+  for (const Configuration& config : configurations)
+  {
+    vtkNew<vtkRibbonFilter> sequential;
+    Configure(sequential, input, config);
+    sequential->SequentialProcessingOn();
+    sequential->Update();
+
+    vtkNew<vtkRibbonFilter> threaded;
+    Configure(threaded, input, config);
+    threaded->Update();
+
+    // The arrays are compared by name, and the normals and the texture
+    // coordinates are not named
+    for (vtkPolyData* output : { sequential->GetOutput(), threaded->GetOutput() })
+    {
+      output->GetPointData()->GetNormals()->SetName("Normals");
+      if (vtkDataArray* tcoords = output->GetPointData()->GetTCoords())
+      {
+        tcoords->SetName("TCoords");
+      }
+    }
+    if (!vtkTestUtilities::CompareDataObjects(sequential->GetOutput(), threaded->GetOutput()))
+    {
+      std::cerr << "Error: different outputs for vary width " << config.VaryWidth << ", tcoords "
+                << config.GenerateTCoords << ", angle " << config.Angle << ", default normal "
+                << config.UseDefaultNormal << std::endl;
+      status = false;
+    }
+  }
+  return status ? EXIT_SUCCESS : EXIT_FAILURE;
+}
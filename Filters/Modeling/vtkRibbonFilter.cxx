@@ -2,17 +2,27 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkRibbonFilter.h"
 
+#include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <memory>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkRibbonFilter);
@@ -45,6 +55,505 @@ vtkRibbonFilter::vtkRibbonFilter()
 
 vtkRibbonFilter::~vtkRibbonFilter() = default;
 
+namespace
+{
+
+// Parameters of the ribbon generation, shared by all the threads.
+struct RibbonParameters
+{
+  vtkPoints* InPts;
+  vtkDataArray* InNormals; // nullptr when sliding normals are generated
+  vtkDataArray* InScalars;
+  double Range[2];
+  bool VaryWidth;
+  double Width;
+  double WidthFactor;
+  int GenerateTCoords;
+  double TextureLength;
+  double Theta;
+};
+
+RibbonParameters MakeRibbonParameters(vtkRibbonFilter* self, double theta)
+{
+  RibbonParameters par{ nullptr, nullptr, nullptr, { 0.0, 1.0 }, self->GetVaryWidth() != 0,
+    self->GetWidth(), self->GetWidthFactor(), self->GetGenerateTCoords(), self->GetTextureLength(),
+    theta };
+  return par;
+}
+
+// Outcome of the frame computation of a line. Warnings are reported once
+// all the lines have been processed.
+enum RibbonLineStatus : unsigned char
+{
+  RIBBON_LINE_TOO_SHORT = 0,
+  RIBBON_LINE_VALID,
+  RIBBON_LINE_NO_NORMALS,
+  RIBBON_LINE_COINCIDENT_POINTS,
+  RIBBON_LINE_BAD_NORMAL
+};
+
+void WarnRibbonLine(vtkRibbonFilter* self, unsigned char status, bool alternateBevel)
+{
+  if (alternateBevel)
+  {
+    vtkWarningWithObjectMacro(self, << "Using alternate bevel vector");
+  }
+  switch (status)
+  {
+    case RIBBON_LINE_TOO_SHORT:
+      vtkWarningWithObjectMacro(self, << "Less than two points in line!");
+      break;
+    case RIBBON_LINE_NO_NORMALS:
+      vtkWarningWithObjectMacro(self, << "No normals for line!");
+      break;
+    case RIBBON_LINE_COINCIDENT_POINTS:
+      vtkWarningWithObjectMacro(self, << "Coincident points!");
+      vtkWarningWithObjectMacro(self, << "Could not generate points!");
+      break;
+    case RIBBON_LINE_BAD_NORMAL:
+      vtkWarningWithObjectMacro(self, << "Bad normal!");
+      vtkWarningWithObjectMacro(self, << "Could not generate points!");
+      break;
+    default:
+      break;
+  }
+}
+
+// Compute the two ribbon points and the normal (sm, sp and nP) at each point
+// of a line, 9 values per point. The normals are taken from par.InNormals
+// when set, otherwise lineNormals gives the normal of each point of the line.
+RibbonLineStatus ComputeRibbonFrames(const RibbonParameters& par, vtkIdType npts,
+  const vtkIdType* pts, vtkDataArray* lineNormals, double* frames, bool& alternateBevel)
+{
+  double p[3];
+  double pNext[3];
+  double sNext[3] = { 0, 0, 0 };
+  double sPrev[3];
+  double n[3];
+  double s[3], v[3];
+  double w[3];
+  double nP[3];
+  double sFactor = 1.0;
+  alternateBevel = false;
+
+  // Use "averaged" segment to create beveled effect.
+  // Watch out for first and last points.
+  for (vtkIdType j = 0; j < npts; j++)
+  {
+    if (j == 0) // first point
+    {
+      par.InPts->GetPoint(pts[0], p);
+      par.InPts->GetPoint(pts[1], pNext);
+      for (int i = 0; i < 3; i++)
+      {
+        sNext[i] = pNext[i] - p[i];
+        sPrev[i] = sNext[i];
+      }
+    }
+    else if (j == (npts - 1)) // last point
+    {
+      for (int i = 0; i < 3; i++)
+      {
+        sPrev[i] = sNext[i];
+        p[i] = pNext[i];
+      }
+    }
+    else
+    {
+      for (int i = 0; i < 3; i++)
+      {
+        p[i] = pNext[i];
+      }
+      par.InPts->GetPoint(pts[j + 1], pNext);
+      for (int i = 0; i < 3; i++)
+      {
+        sPrev[i] = sNext[i];
+        sNext[i] = pNext[i] - p[i];
+      }
+    }
+
+    if (par.InNormals)
+    {
+      par.InNormals->GetTuple(pts[j], n);
+    }
+    else
+    {
+      lineNormals->GetTuple(j, n);
+    }
+
+    if (vtkMath::Normalize(sNext) == 0.0)
+    {
+      return RIBBON_LINE_COINCIDENT_POINTS;
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+      s[i] = (sPrev[i] + sNext[i]) / 2.0; // average vector
+    }
+    // if s is zero then just use sPrev cross n
+    if (vtkMath::Normalize(s) == 0.0)
+    {
+      alternateBevel = true;
+      vtkMath::Cross(sPrev, n, s);
+      vtkMath::Normalize(s);
+    }
+
+    vtkMath::Cross(s, n, w);
+    if (vtkMath::Normalize(w) == 0.0)
+    {
+      return RIBBON_LINE_BAD_NORMAL;
+    }
+
+    vtkMath::Cross(w, s, nP); // create orthogonal coordinate system
+    vtkMath::Normalize(nP);
+
+    // Compute a scale factor based on scalars or vectors
+    if (par.InScalars && par.VaryWidth) // varying by scalar values
+    {
+      sFactor = 1.0 +
+        ((par.WidthFactor - 1.0) * (par.InScalars->GetComponent(pts[j], 0) - par.Range[0]) /
+          (par.Range[1] - par.Range[0]));
+    }
+
+    double* frame = frames + 9 * j;
+    for (int i = 0; i < 3; i++)
+    {
+      v[i] = (w[i] * cos(par.Theta) + nP[i] * sin(par.Theta));
+      frame[i] = p[i] - par.Width * sFactor * v[i];     // sm
+      frame[3 + i] = p[i] + par.Width * sFactor * v[i]; // sp
+      frame[6 + i] = nP[i];
+    }
+  }
+  return RIBBON_LINE_VALID;
+}
+
+// Writes the ribbons into the preallocated output arrays. CellId and
+// ConnectivityId are the output ranges of the current line.
+struct RibbonArraysOutput
+{
+  vtkPoints* NewPts;
+  vtkFloatArray* NewNormals;
+  vtkFloatArray* NewTCoords;
+  ArrayList* PointArrays;
+  ArrayList* CellArrays;
+  vtkIdType* StripOffsets;
+  vtkIdType* StripConnectivity;
+  vtkIdType CellId;
+  vtkIdType ConnectivityId;
+
+  void SetPoint(vtkIdType ptId, const double x[3], const double normal[3], vtkIdType inPtId)
+  {
+    this->NewPts->SetPoint(ptId, x);
+    this->NewNormals->SetTuple(ptId, normal);
+    this->PointArrays->Copy(inPtId, ptId);
+  }
+
+  void InsertNextStrip(vtkIdType vtkNotUsed(npts), vtkIdType inCellId)
+  {
+    this->StripOffsets[this->CellId] = this->ConnectivityId;
+    this->CellArrays->Copy(inCellId, this->CellId);
+    ++this->CellId;
+  }
+
+  void InsertStripPoint(vtkIdType ptId) { this->StripConnectivity[this->ConnectivityId++] = ptId; }
+
+  void SetTCoords(vtkIdType ptId, double tc, double tcy)
+  {
+    this->NewTCoords->SetTuple2(ptId, tc, tcy);
+  }
+};
+
+// Inserts the ribbons into growing arrays, as done by the deprecated helper
+// methods of vtkRibbonFilter.
+struct RibbonInsertOutput
+{
+  vtkPoints* NewPts;
+  vtkFloatArray* NewNormals;
+  vtkFloatArray* NewTCoords;
+  vtkPointData* InPD;
+  vtkPointData* OutPD;
+  vtkCellData* InCD;
+  vtkCellData* OutCD;
+  vtkCellArray* NewStrips;
+
+  void SetPoint(vtkIdType ptId, const double x[3], const double normal[3], vtkIdType inPtId)
+  {
+    this->NewPts->InsertPoint(ptId, x);
+    this->NewNormals->InsertTuple(ptId, normal);
+    this->OutPD->CopyData(this->InPD, inPtId, ptId);
+  }
+
+  void InsertNextStrip(vtkIdType npts, vtkIdType inCellId)
+  {
+    vtkIdType outCellId = this->NewStrips->InsertNextCell(npts);
+    this->OutCD->CopyData(this->InCD, inCellId, outCellId);
+  }
+
+  void InsertStripPoint(vtkIdType ptId) { this->NewStrips->InsertCellPoint(ptId); }
+
+  void SetTCoords(vtkIdType ptId, double tc, double tcy)
+  {
+    this->NewTCoords->InsertTuple2(ptId, tc, tcy);
+  }
+};
+
+// Create the points of a ribbon, on both sides of the line, from its frames.
+template <typename RibbonOutput>
+void GenerateRibbonPoints(vtkIdType npts, const vtkIdType* pts, const double* frames,
+  vtkIdType offset, RibbonOutput& output)
+{
+  vtkIdType ptId = offset;
+  for (vtkIdType j = 0; j < npts; j++)
+  {
+    const double* frame = frames + 9 * j;
+    output.SetPoint(ptId++, frame, frame + 6, pts[j]);
+    output.SetPoint(ptId++, frame + 3, frame + 6, pts[j]);
+  }
+}
+
+// Create the strip of a ribbon whose points start at offset.
+template <typename RibbonOutput>
+void GenerateRibbonStrip(vtkIdType npts, vtkIdType offset, vtkIdType inCellId, RibbonOutput& output)
+{
+  output.InsertNextStrip(npts * 2, inCellId);
+  for (vtkIdType i = 0; i < 2 * npts; i++)
+  {
+    output.InsertStripPoint(offset + i);
+  }
+}
+
+// Create the texture coordinates of the points of a ribbon starting at offset.
+template <typename RibbonOutput>
+void GenerateRibbonTextureCoords(const RibbonParameters& par, vtkIdType npts,
+  const vtkIdType* pts, vtkIdType offset, RibbonOutput& output)
+{
+  // The first texture coordinate is always 0.
+  for (int k = 0; k < 2; k++)
+  {
+    output.SetTCoords(offset + k, 0.0, 0.0);
+  }
+  if (par.GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && par.InScalars)
+  {
+    const double s0 = par.InScalars->GetTuple1(pts[0]);
+    for (vtkIdType i = 1; i < npts; i++)
+    {
+      const double tc = (par.InScalars->GetTuple1(pts[i]) - s0) / par.TextureLength;
+      for (int k = 0; k < 2; k++)
+      {
+        output.SetTCoords(offset + i * 2 + k, tc, 0.0);
+      }
+    }
+  }
+  else if (par.GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ||
+    par.GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
+  {
+    double xPrev[3], x[3], length = 0.0, len = 0.0;
+    if (par.GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
+    {
+      par.InPts->GetPoint(pts[0], xPrev);
+      for (vtkIdType i = 1; i < npts; i++)
+      {
+        par.InPts->GetPoint(pts[i], x);
+        length += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
+        xPrev[0] = x[0];
+        xPrev[1] = x[1];
+        xPrev[2] = x[2];
+      }
+    }
+
+    par.InPts->GetPoint(pts[0], xPrev);
+    for (vtkIdType i = 1; i < npts; i++)
+    {
+      par.InPts->GetPoint(pts[i], x);
+      len += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
+      const double tc =
+        par.GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ? len / par.TextureLength : len / length;
+      for (int k = 0; k < 2; k++)
+      {
+        output.SetTCoords(offset + i * 2 + k, tc, 0.0);
+      }
+      xPrev[0] = x[0];
+      xPrev[1] = x[1];
+      xPrev[2] = x[2];
+    }
+  }
+}
+
+// Frames of all the lines, computed by the counting pass and used by the
+// generation pass. The frames of a line are stored at the offset of the line
+// in the input connectivity.
+struct RibbonLines
+{
+  std::vector<unsigned char> Status;
+  std::vector<unsigned char> AlternateBevel;
+  std::unique_ptr<double[]> Frames;
+
+  RibbonLines(vtkCellArray* lines)
+    : Status(lines->GetNumberOfCells())
+    , AlternateBevel(lines->GetNumberOfCells())
+    , Frames(new double[9 * lines->GetNumberOfConnectivityIds()])
+  {
+  }
+};
+
+// Thread local storage used to compute the sliding normals of a line on a
+// copy of it, so that lines sharing points do not conflict.
+struct SlidingNormals
+{
+  vtkSmartPointer<vtkIdList> CellIds;
+  std::vector<vtkIdType> LocalIds;
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkCellArray> Polyline;
+  vtkSmartPointer<vtkFloatArray> Normals;
+
+  void Initialize()
+  {
+    this->CellIds = vtkSmartPointer<vtkIdList>::New();
+    this->Points = vtkSmartPointer<vtkPoints>::New();
+    this->Points->SetDataTypeToDouble();
+    this->Polyline = vtkSmartPointer<vtkCellArray>::New();
+    this->Normals = vtkSmartPointer<vtkFloatArray>::New();
+    this->Normals->SetNumberOfComponents(3);
+  }
+
+  // Return nullptr if the normals cannot be generated
+  vtkDataArray* Compute(vtkPoints* inPts, vtkIdType npts, const vtkIdType* pts)
+  {
+    this->Points->SetNumberOfPoints(npts);
+    this->LocalIds.resize(npts);
+    double x[3];
+    for (vtkIdType j = 0; j < npts; ++j)
+    {
+      inPts->GetPoint(pts[j], x);
+      this->Points->SetPoint(j, x);
+      this->LocalIds[j] = j;
+    }
+    this->Polyline->Reset();
+    this->Polyline->InsertNextCell(npts, this->LocalIds.data());
+    return vtkPolyLine::GenerateSlidingNormals(this->Points, this->Polyline, this->Normals)
+      ? this->Normals
+      : nullptr;
+  }
+};
+
+// First pass of the ribbon generation: compute the frames of each line and
+// count its output points. Each valid line produces one strip.
+struct CountRibbons
+{
+  const RibbonParameters& Parameters;
+  vtkCellArray* Lines;
+  vtkRibbonFilter* Filter;
+  RibbonLines& Ribbons;
+  vtkIdType* NumberOfPoints;
+  vtkSMPThreadLocal<SlidingNormals> Normals;
+
+  CountRibbons(const RibbonParameters& parameters, vtkCellArray* lines, vtkRibbonFilter* filter,
+    RibbonLines& ribbons, vtkIdType* numPts)
+    : Parameters(parameters)
+    , Lines(lines)
+    , Filter(filter)
+    , Ribbons(ribbons)
+    , NumberOfPoints(numPts)
+  {
+  }
+
+  void Initialize() { this->Normals.Local().Initialize(); }
+
+  void operator()(vtkIdType lineId, vtkIdType endLineId)
+  {
+    const RibbonParameters& par = this->Parameters;
+    SlidingNormals& normals = this->Normals.Local();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+
+    for (; lineId < endLineId; ++lineId)
+    {
+      if (isFirst)
+      {
+        this->Filter->CheckAbort();
+      }
+      if (this->Filter->GetAbortOutput())
+      {
+        break;
+      }
+      this->NumberOfPoints[lineId] = 0;
+      vtkIdType npts;
+      const vtkIdType* pts;
+      this->Lines->GetCellAtId(lineId, npts, pts, normals.CellIds);
+      if (npts < 2)
+      {
+        this->Ribbons.Status[lineId] = RIBBON_LINE_TOO_SHORT;
+        continue;
+      }
+      vtkDataArray* lineNormals = nullptr;
+      if (!par.InNormals && !(lineNormals = normals.Compute(par.InPts, npts, pts)))
+      {
+        this->Ribbons.Status[lineId] = RIBBON_LINE_NO_NORMALS;
+        continue;
+      }
+      bool alternateBevel;
+      this->Ribbons.Status[lineId] = ComputeRibbonFrames(par, npts, pts, lineNormals,
+        this->Ribbons.Frames.get() + 9 * this->Lines->GetOffset(lineId), alternateBevel);
+      this->Ribbons.AlternateBevel[lineId] = alternateBevel;
+      if (this->Ribbons.Status[lineId] == RIBBON_LINE_VALID)
+      {
+        this->NumberOfPoints[lineId] = 2 * npts;
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+// Second pass of the ribbon generation: each valid line writes its points,
+// normals, texture coordinates, strip and attributes at the offsets computed
+// from the first pass.
+struct GenerateRibbonsWorker
+{
+  const RibbonParameters& Parameters;
+  vtkCellArray* Lines;
+  const RibbonLines& Ribbons;
+  const vtkIdType* PointOffsets;
+  const vtkIdType* CellIds;
+  RibbonArraysOutput Output;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkIdList>> CellPointIds;
+
+  void Initialize() { this->CellPointIds.Local() = vtkSmartPointer<vtkIdList>::New(); }
+
+  void operator()(vtkIdType lineId, vtkIdType endLineId)
+  {
+    RibbonArraysOutput output = this->Output;
+    vtkIdList* cellPointIds = this->CellPointIds.Local();
+    for (; lineId < endLineId; ++lineId)
+    {
+      if (this->Ribbons.Status[lineId] != RIBBON_LINE_VALID)
+      {
+        continue;
+      }
+      vtkIdType npts;
+      const vtkIdType* pts;
+      this->Lines->GetCellAtId(lineId, npts, pts, cellPointIds);
+      const vtkIdType offset = this->PointOffsets[lineId];
+      GenerateRibbonPoints(npts, pts,
+        this->Ribbons.Frames.get() + 9 * this->Lines->GetOffset(lineId), offset, output);
+
+      // As in the sequential algorithm, the cell data are copied from the
+      // cell whose id is the line index. The connectivity of the strips is
+      // the list of the output points.
+      output.CellId = this->CellIds[lineId];
+      output.ConnectivityId = offset;
+      GenerateRibbonStrip(npts, offset, lineId, output);
+      if (output.NewTCoords)
+      {
+        GenerateRibbonTextureCoords(this->Parameters, npts, pts, offset, output);
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+}
+
 int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
@@ -72,14 +581,9 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   int deleteNormals = 0;
   vtkFloatArray* newNormals;
   vtkIdType i;
-  double range[2];
+  double range[2] = { 0.0, 1.0 };
   vtkCellArray* newStrips;
-  vtkIdType npts = 0;
-  const vtkIdType* pts = nullptr;
-  vtkIdType offset = 0;
   vtkFloatArray* newTCoords = nullptr;
-  bool abort = false;
-  vtkIdType inCellId;
 
   // Check input and initialize
   //
@@ -94,13 +598,9 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   // Create the geometry and topology
   numNewPts = 2 * numPts;
   newPts = vtkPoints::New();
-  newPts->Allocate(numNewPts);
   newNormals = vtkFloatArray::New();
   newNormals->SetNumberOfComponents(3);
-  newNormals->Allocate(3 * numNewPts);
   newStrips = vtkCellArray::New();
-  newStrips->AllocateEstimate(1, numNewPts);
-  vtkCellArray* singlePolyline = vtkCellArray::New();
 
   // Point data: copy scalars, vectors, tcoords. Normals may be computed here.
   outPD->CopyNormalsOff();
@@ -110,35 +610,28 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   {
     newTCoords = vtkFloatArray::New();
     newTCoords->SetNumberOfComponents(2);
-    newTCoords->Allocate(numNewPts);
     outPD->CopyTCoordsOff();
   }
   outPD->CopyAllocate(pd, numNewPts);
 
-  int generateNormals = 0;
-  inNormals = this->GetInputArrayToProcess(1, inputVector);
-  if (!inNormals || this->UseDefaultNormal)
+  if (this->UseDefaultNormal)
   {
     deleteNormals = 1;
     inNormals = vtkFloatArray::New();
     inNormals->SetNumberOfComponents(3);
     inNormals->SetNumberOfTuples(numPts);
-
-    if (this->UseDefaultNormal)
+    for (i = 0; i < numPts; i++)
     {
-      for (i = 0; i < numPts; i++)
-      {
-        inNormals->SetTuple(i, this->DefaultNormal);
-      }
-    }
-    else
-    {
-      // Normal generation has been moved to lower in the function.
-      // This allows each different polylines to share vertices, but have
-      // their normals (and hence their ribbons) calculated independently
-      generateNormals = 1;
+      inNormals->SetTuple(i, this->DefaultNormal);
     }
   }
+  else
+  {
+    // Without input normals, sliding normals are generated for each line.
+    // This allows each different polylines to share vertices, but have
+    // their normals (and hence their ribbons) calculated independently
+    inNormals = this->GetInputArrayToProcess(1, inputVector);
+  }
 
   // If varying width, get appropriate info.
   //
@@ -162,59 +655,20 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   //  triangle strips. Texture coordinates are optionally generated.
   //
   this->Theta = vtkMath::RadiansFromDegrees(this->Angle);
-  vtkPolyLine* lineNormalGenerator = vtkPolyLine::New();
-  for (inCellId = 0, inLines->InitTraversal(); inLines->GetNextCell(npts, pts) && !abort;
-       inCellId++)
+  if (this->SequentialProcessing)
   {
-    this->UpdateProgress((double)inCellId / numLines);
-    abort = this->CheckAbort();
-
-    if (npts < 2)
-    {
-      vtkWarningMacro(<< "Less than two points in line!");
-      continue; // skip tubing this polyline
-    }
-
-    // If necessary calculate normals, each polyline calculates its
-    // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
-    {
-      singlePolyline->Reset(); // avoid instantiation
-      singlePolyline->InsertNextCell(npts, pts);
-      if (!vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals))
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1, "Sequential", false },
+      [&]()
       {
-        vtkWarningMacro(<< "No normals for line!");
-        continue; // skip tubing this polyline
-      }
-    }
-
-    // Generate the points around the polyline. The strip is not created
-    // if the polyline is bad.
-    //
-    if (!this->GeneratePoints(
-          offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars, range, inNormals))
-    {
-      vtkWarningMacro(<< "Could not generate points!");
-      continue; // skip ribboning this polyline
-    }
-
-    // Generate the strip for this polyline
-    //
-    this->GenerateStrip(offset, npts, pts, inCellId, cd, outCD, newStrips);
-
-    // Generate the texture coordinates for this polyline
-    //
-    if (newTCoords)
-    {
-      this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
-    }
-
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset, npts);
-
-  } // for all polylines
-
-  singlePolyline->Delete();
+        this->GenerateRibbons(input, output, inNormals, inScalars, range, newPts, newNormals,
+          newTCoords, newStrips);
+      });
+  }
+  else
+  {
+    this->GenerateRibbons(
+      input, output, inNormals, inScalars, range, newPts, newNormals, newTCoords, newStrips);
+  }
 
   // Update ourselves
   //
@@ -237,142 +691,99 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
   outPD->SetNormals(newNormals);
   newNormals->Delete();
-  lineNormalGenerator->Delete();
 
   output->Squeeze();
 
   return 1;
 }
 
+void vtkRibbonFilter::GenerateRibbons(vtkPolyData* input, vtkPolyData* output,
+  vtkDataArray* inNormals, vtkDataArray* inScalars, double range[2], vtkPoints* newPts,
+  vtkFloatArray* newNormals, vtkFloatArray* newTCoords, vtkCellArray* newStrips)
+{
+  vtkCellArray* inLines = input->GetLines();
+  const vtkIdType numLines = inLines->GetNumberOfCells();
+  RibbonParameters parameters = MakeRibbonParameters(this, this->Theta);
+  parameters.InPts = input->GetPoints();
+  parameters.InNormals = inNormals;
+  parameters.InScalars = inScalars;
+  parameters.Range[0] = range[0];
+  parameters.Range[1] = range[1];
+
+  // Compute the frames of the lines and count their output points, then turn
+  // the counts into offsets in the output arrays.
+  RibbonLines ribbons(inLines);
+  std::vector<vtkIdType> pointOffsets(numLines + 1, 0);
+  CountRibbons count(parameters, inLines, this, ribbons, pointOffsets.data());
+  vtkSMPTools::For(0, numLines, count);
+  if (this->GetAbortOutput())
+  {
+    return;
+  }
+  std::vector<vtkIdType> cellIds(numLines + 1, 0);
+  for (vtkIdType lineId = 0; lineId < numLines; ++lineId)
+  {
+    WarnRibbonLine(this, ribbons.Status[lineId], ribbons.AlternateBevel[lineId] != 0);
+    cellIds[lineId] = ribbons.Status[lineId] == RIBBON_LINE_VALID ? 1 : 0;
+  }
+  vtkSMPTools::ExclusiveScan(
+    pointOffsets.begin(), pointOffsets.end(), pointOffsets.begin(), vtkIdType(0));
+  vtkSMPTools::ExclusiveScan(cellIds.begin(), cellIds.end(), cellIds.begin(), vtkIdType(0));
+  const vtkIdType numNewPts = pointOffsets[numLines];
+  const vtkIdType numNewCells = cellIds[numLines];
+  this->UpdateProgress(0.5);
+
+  // Generate the ribbons into the preallocated arrays
+  newPts->SetNumberOfPoints(numNewPts);
+  newNormals->SetNumberOfTuples(numNewPts);
+  if (newTCoords)
+  {
+    newTCoords->SetNumberOfTuples(numNewPts);
+  }
+  vtkNew<vtkIdTypeArray> stripOffsets;
+  stripOffsets->SetNumberOfValues(numNewCells + 1);
+  stripOffsets->SetValue(numNewCells, numNewPts);
+  vtkNew<vtkIdTypeArray> stripConnectivity;
+  stripConnectivity->SetNumberOfValues(numNewPts);
+
+  ArrayList pointArrays;
+  pointArrays.AddArrays(
+    numNewPts, input->GetPointData(), output->GetPointData(), 0.0, /*promote=*/false);
+  ArrayList cellArrays;
+  cellArrays.AddArrays(
+    numNewCells, input->GetCellData(), output->GetCellData(), 0.0, /*promote=*/false);
+
+  GenerateRibbonsWorker generate{ parameters, inLines, ribbons, pointOffsets.data(),
+    cellIds.data(),
+    { newPts, newNormals, newTCoords, &pointArrays, &cellArrays, stripOffsets->GetPointer(0),
+      stripConnectivity->GetPointer(0), 0, 0 },
+    {} };
+  vtkSMPTools::For(0, numLines, generate);
+  newStrips->SetData(stripOffsets, stripConnectivity);
+}
+
 int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
   vtkPoints* inPts, vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD,
   vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals)
 {
-  vtkIdType j;
-  int i;
-  double p[3];
-  double pNext[3];
-  double sNext[3] = { 0, 0, 0 };
-  double sPrev[3];
-  double n[3];
-  double s[3], sp[3], sm[3], v[3];
-  // double bevelAngle;
-  double w[3];
-  double nP[3];
-  double sFactor = 1.0;
-  vtkIdType ptId = offset;
-
-  // Use "averaged" segment to create beveled effect.
-  // Watch out for first and last points.
-  //
-  for (j = 0; j < npts; j++)
+  RibbonParameters par = MakeRibbonParameters(this, this->Theta);
+  par.InPts = inPts;
+  par.InNormals = inNormals;
+  par.InScalars = inScalars;
+  par.Range[0] = range[0];
+  par.Range[1] = range[1];
+
+  std::vector<double> frames(9 * npts);
+  bool alternateBevel;
+  RibbonLineStatus status =
+    ComputeRibbonFrames(par, npts, pts, nullptr, frames.data(), alternateBevel);
+  WarnRibbonLine(this, status, alternateBevel);
+  if (status != RIBBON_LINE_VALID)
   {
-    if (j == 0) // first point
-    {
-      inPts->GetPoint(pts[0], p);
-      inPts->GetPoint(pts[1], pNext);
-      for (i = 0; i < 3; i++)
-      {
-        sNext[i] = pNext[i] - p[i];
-        sPrev[i] = sNext[i];
-      }
-    }
-    else if (j == (npts - 1)) // last point
-    {
-      for (i = 0; i < 3; i++)
-      {
-        sPrev[i] = sNext[i];
-        p[i] = pNext[i];
-      }
-    }
-    else
-    {
-      for (i = 0; i < 3; i++)
-      {
-        p[i] = pNext[i];
-      }
-      inPts->GetPoint(pts[j + 1], pNext);
-      for (i = 0; i < 3; i++)
-      {
-        sPrev[i] = sNext[i];
-        sNext[i] = pNext[i] - p[i];
-      }
-    }
-
-    inNormals->GetTuple(pts[j], n);
-
-    if (vtkMath::Normalize(sNext) == 0.0)
-    {
-      vtkWarningMacro(<< "Coincident points!");
-      return 0;
-    }
-
-    for (i = 0; i < 3; i++)
-    {
-      s[i] = (sPrev[i] + sNext[i]) / 2.0; // average vector
-    }
-    // if s is zero then just use sPrev cross n
-    if (vtkMath::Normalize(s) == 0.0)
-    {
-      vtkWarningMacro(<< "Using alternate bevel vector");
-      vtkMath::Cross(sPrev, n, s);
-      if (vtkMath::Normalize(s) == 0.0)
-      {
-        vtkWarningMacro(<< "Using alternate bevel vector");
-      }
-    }
-    /*
-        if ( (bevelAngle = vtkMath::Dot(sNext,sPrev)) > 1.0 )
-          {
-          bevelAngle = 1.0;
-          }
-        if ( bevelAngle < -1.0 )
-          {
-          bevelAngle = -1.0;
-          }
-        bevelAngle = acos((double)bevelAngle) / 2.0; //(0->90 degrees)
-        if ( (bevelAngle = cos(bevelAngle)) == 0.0 )
-          {
-          bevelAngle = 1.0;
-          }
-
-        bevelAngle = this->Width / bevelAngle; //keep ribbon constant width
-    */
-    vtkMath::Cross(s, n, w);
-    if (vtkMath::Normalize(w) == 0.0)
-    {
-      vtkWarningMacro(<< "Bad normal s = " << s[0] << " " << s[1] << " " << s[2] << " n = " << n[0]
-                      << " " << n[1] << " " << n[2]);
-      return 0;
-    }
-
-    vtkMath::Cross(w, s, nP); // create orthogonal coordinate system
-    vtkMath::Normalize(nP);
-
-    // Compute a scale factor based on scalars or vectors
-    if (inScalars && this->VaryWidth) // varying by scalar values
-    {
-      sFactor = 1.0 +
-        ((this->WidthFactor - 1.0) * (inScalars->GetComponent(pts[j], 0) - range[0]) /
-          (range[1] - range[0]));
-    }
-
-    for (i = 0; i < 3; i++)
-    {
-      v[i] = (w[i] * cos(this->Theta) + nP[i] * sin(this->Theta));
-      sp[i] = p[i] + this->Width * sFactor * v[i];
-      sm[i] = p[i] - this->Width * sFactor * v[i];
-    }
-    newPts->InsertPoint(ptId, sm);
-    newNormals->InsertTuple(ptId, nP);
-    outPD->CopyData(pd, pts[j], ptId);
-    ptId++;
-    newPts->InsertPoint(ptId, sp);
-    newNormals->InsertTuple(ptId, nP);
-    outPD->CopyData(pd, pts[j], ptId);
-    ptId++;
-  } // for all points in polyline
-
+    return 0;
+  }
+  RibbonInsertOutput output{ newPts, newNormals, nullptr, pd, outPD, nullptr, nullptr, nullptr };
+  GenerateRibbonPoints(npts, pts, frames.data(), offset, output);
   return 1;
 }
 
@@ -380,90 +791,19 @@ void vtkRibbonFilter::GenerateStrip(vtkIdType offset, vtkIdType npts,
   const vtkIdType* vtkNotUsed(pts), vtkIdType inCellId, vtkCellData* cd, vtkCellData* outCD,
   vtkCellArray* newStrips)
 {
-  vtkIdType i, idx, outCellId;
-
-  outCellId = newStrips->InsertNextCell(npts * 2);
-  outCD->CopyData(cd, inCellId, outCellId);
-  for (i = 0; i < npts; i++)
-  {
-    idx = 2 * i;
-    newStrips->InsertCellPoint(offset + idx);
-    newStrips->InsertCellPoint(offset + idx + 1);
-  }
+  RibbonInsertOutput output{ nullptr, nullptr, nullptr, nullptr, nullptr, cd, outCD, newStrips };
+  GenerateRibbonStrip(npts, offset, inCellId, output);
 }
 
 void vtkRibbonFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
   vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords)
 {
-  vtkIdType i;
-  int k;
-  double tc;
-
-  double s0, s;
-  // The first texture coordinate is always 0.
-  for (k = 0; k < 2; k++)
-  {
-    newTCoords->InsertTuple2(offset + k, 0.0, 0.0);
-  }
-  if (this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars)
-  {
-    s0 = inScalars->GetTuple1(pts[0]);
-    for (i = 1; i < npts; i++)
-    {
-      s = inScalars->GetTuple1(pts[i]);
-      tc = (s - s0) / this->TextureLength;
-      for (k = 0; k < 2; k++)
-      {
-        newTCoords->InsertTuple2(offset + i * 2 + k, tc, 0.0);
-      }
-    }
-  }
-  else if (this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH)
-  {
-    double xPrev[3], x[3], len = 0.0;
-    inPts->GetPoint(pts[0], xPrev);
-    for (i = 1; i < npts; i++)
-    {
-      inPts->GetPoint(pts[i], x);
-      len += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
-      tc = len / this->TextureLength;
-      for (k = 0; k < 2; k++)
-      {
-        newTCoords->InsertTuple2(offset + i * 2 + k, tc, 0.0);
-      }
-      xPrev[0] = x[0];
-      xPrev[1] = x[1];
-      xPrev[2] = x[2];
-    }
-  }
-  else if (this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
-  {
-    double xPrev[3], x[3], length = 0.0, len = 0.0;
-    inPts->GetPoint(pts[0], xPrev);
-    for (i = 1; i < npts; i++)
-    {
-      inPts->GetPoint(pts[i], x);
-      length += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
-      xPrev[0] = x[0];
-      xPrev[1] = x[1];
-      xPrev[2] = x[2];
-    }
-
-    inPts->GetPoint(pts[0], xPrev);
-    for (i = 1; i < npts; i++)
-    {
-      inPts->GetPoint(pts[i], x);
-      len += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
-      tc = len / length;
-      for (k = 0; k < 2; k++)
-      {
-        newTCoords->InsertTuple2(offset + i * 2 + k, tc, 0.0);
-      }
-      xPrev[0] = x[0];
-      xPrev[1] = x[1];
-      xPrev[2] = x[2];
-    }
-  }
+  RibbonParameters par = MakeRibbonParameters(this, this->Theta);
+  par.InPts = inPts;
+  par.InScalars = inScalars;
+  RibbonInsertOutput output{ nullptr, nullptr, newTCoords, nullptr, nullptr, nullptr, nullptr,
+    nullptr };
+  GenerateRibbonTextureCoords(par, npts, pts, offset, output);
 }
 
 // Compute the number of points in this ribbon
@@ -510,5 +850,6 @@ void vtkRibbonFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Generate TCoords: " << this->GetGenerateTCoordsAsString() << endl;
   os << indent << "Texture Length: " << this->TextureLength << endl;
+  os << indent << "Sequential Processing: " << (this->SequentialProcessing ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
@@ -11,6 +11,11 @@
  * the local line segment. An offset angle can be specified to rotate the
  * ribbon with respect to the normal.
  *
+ * Unless SequentialProcessing is on, the ribbons are generated in parallel
+ * with vtkSMPTools: the lines are validated and their output is counted
+ * first, then the ribbons of all the lines are generated concurrently into
+ * preallocated arrays.
+ *
  * @warning
  * The input line must not have duplicate points, or normals at points that
  * are parallel to the incoming/outgoing line segments. (Duplicate points
@@ -24,6 +29,7 @@
 #ifndef vtkRibbonFilter_h
 #define vtkRibbonFilter_h
 
+#include "vtkDeprecation.h"           // For VTK_DEPRECATED_IN_9_7_0
 #include "vtkFiltersModelingModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
@@ -136,6 +142,16 @@ public:
   vtkGetMacro(TextureLength, double);
   ///@}
 
+  ///@{
+  /**
+   * Force sequential processing (i.e. single thread) of the lines. The output
+   * does not depend on this option. Default is false.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
 protected:
   vtkRibbonFilter();
   ~vtkRibbonFilter() override;
@@ -149,17 +165,28 @@ protected:
   vtkTypeBool UseDefaultNormal;
   int GenerateTCoords;  // control texture coordinate generation
   double TextureLength; // this length is mapped to [0,1) texture space
+  bool SequentialProcessing = false;
 
-  // Helper methods
+  // Helper methods, the filter now generates the ribbons with GenerateRibbons()
+  VTK_DEPRECATED_IN_9_7_0("The ribbons are generated by GenerateRibbons()")
   int GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkPoints* inPts,
     vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD, vtkFloatArray* newNormals,
     vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals);
+  VTK_DEPRECATED_IN_9_7_0("The ribbons are generated by GenerateRibbons()")
   void GenerateStrip(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkIdType inCellId,
     vtkCellData* cd, vtkCellData* outCD, vtkCellArray* newStrips);
+  VTK_DEPRECATED_IN_9_7_0("The ribbons are generated by GenerateRibbons()")
   void GenerateTextureCoords(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
     vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords);
+  VTK_DEPRECATED_IN_9_7_0("The ribbons are generated by GenerateRibbons()")
   vtkIdType ComputeOffset(vtkIdType offset, vtkIdType npts);
 
+  // Generation of the ribbons of all the lines with vtkSMPTools. inNormals
+  // is nullptr when sliding normals are generated for each line.
+  void GenerateRibbons(vtkPolyData* input, vtkPolyData* output, vtkDataArray* inNormals,
+    vtkDataArray* inScalars, double range[2], vtkPoints* newPts, vtkFloatArray* newNormals,
+    vtkFloatArray* newTCoords, vtkCellArray* newStrips);
+
   // Helper data members
   double Theta;
 
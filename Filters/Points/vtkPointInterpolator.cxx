@@ -16,9 +16,11 @@
 #include "vtkInformationVector.h"
 #include "vtkLinearKernel.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkStaticPointLocator.h"
@@ -55,6 +57,14 @@ struct ProbePoints
   vtkSMPThreadLocalObject<vtkIdList> PIds;
   vtkSMPThreadLocalObject<vtkDoubleArray> Weights;
 
+  // Null points assigned the closest point, which are all located in Reduce().
+  struct NullPoint
+  {
+    vtkIdType PtId;
+    double X[3];
+  };
+  vtkSMPThreadLocal<std::vector<NullPoint>> NullPoints;
+
   ProbePoints(vtkPointInterpolator* ptInt, vtkDataSet* input, vtkPointData* inPD,
     vtkPointData* outPD, char* valid)
     : PointInterpolator(ptInt)
@@ -94,7 +104,7 @@ struct ProbePoints
   }
 
   // When null point is encountered
-  void AssignNullPoint(const double x[3], vtkIdList* pIds, vtkDoubleArray* weights, vtkIdType ptId)
+  void AssignNullPoint(const double x[3], vtkIdType ptId)
   {
     if (this->Strategy == vtkPointInterpolator::MASK_POINTS)
     {
@@ -107,12 +117,7 @@ struct ProbePoints
     }
     else // vtkPointInterpolator::CLOSEST_POINT:
     {
-      pIds->SetNumberOfIds(1);
-      vtkIdType pId = this->Locator->FindClosestPoint(x);
-      pIds->SetId(0, pId);
-      weights->SetNumberOfTuples(1);
-      weights->SetValue(0, 1.0);
-      this->Arrays.Interpolate(1, pIds->GetPointer(0), weights->GetPointer(0), ptId);
+      this->NullPoints.Local().push_back(NullPoint{ ptId, { x[0], x[1], x[2] } });
     }
   }
 
@@ -135,12 +140,46 @@ struct ProbePoints
       }
       else
       {
-        this->AssignNullPoint(x, pIds, weights, ptId);
+        this->AssignNullPoint(x, ptId);
       } // null point
     }   // for all dataset points
   }
 
-  void Reduce() {}
+  // Locate the closest points of the null points with a single batched query.
+  void Reduce()
+  {
+    std::vector<NullPoint> nullPoints;
+    for (auto& localNullPoints : this->NullPoints)
+    {
+      nullPoints.insert(nullPoints.end(), localNullPoints.begin(), localNullPoints.end());
+    }
+    const vtkIdType numNullPts = static_cast<vtkIdType>(nullPoints.size());
+    if (numNullPts == 0)
+    {
+      return;
+    }
+
+    vtkNew<vtkPoints> points;
+    points->SetDataTypeToDouble();
+    points->SetNumberOfPoints(numNullPts);
+    for (vtkIdType i = 0; i < numNullPts; ++i)
+    {
+      points->SetPoint(i, nullPoints[i].X);
+    }
+    vtkNew<vtkIdList> closestIds;
+    this->Locator->FindClosestPoints(points, closestIds);
+
+    vtkSMPTools::For(0, numNullPts,
+      [&](vtkIdType i, vtkIdType end)
+      {
+        double weight = 1.0;
+        for (; i < end; ++i)
+        {
+          vtkIdType pId = closestIds->GetId(i);
+          this->Arrays.Interpolate(1, &pId, &weight, nullPoints[i].PtId);
+        }
+      });
+  }
 
 }; // ProbePoints
 
@@ -197,7 +236,7 @@ struct ImageProbePoints : public ProbePoints
           }
           else
           {
-            this->AssignNullPoint(x, pIds, weights, ptId);
+            this->AssignNullPoint(x, ptId);
           } // null point
 
         } // over i
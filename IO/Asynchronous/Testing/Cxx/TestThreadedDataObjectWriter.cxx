@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that the callbacks given to Then() run once their write is done, with
+// its success, and that the failures of the writes are reported.
+
+#include "vtkCommand.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+#include "vtkThreadedDataObjectWriter.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+vtkIdType ReadNumberOfPoints(const std::string& fileName)
+{
+  vtkNew<vtkXMLPolyDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  return reader->GetOutput()->GetNumberOfPoints();
+}
+}
+
+int TestThreadedDataObjectWriter(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string prefix = std::string(tempDir) + "/TestThreadedDataObjectWriter";
+  delete[] tempDir;
+
+  vtkNew<vtkThreadedDataObjectWriter> writer;
+  writer->SetNumberOfThreads(2);
+  writer->SetMaximumNumberOfPendingWrites(3);
+
+  // Each callback reads back the file of its write, which must be complete.
+  const int numberOfWrites = 8;
+  std::mutex mutex;
+  std::vector<int> writesDone;
+  std::vector<vtkIdType> numberOfPoints(numberOfWrites);
+  std::vector<vtkThreadedDataObjectWriter::WriteFuture> writeFutures;
+  std::vector<vtkThreadedDataObjectWriter::CallbackFuture> callbackFutures;
+  vtkNew<vtkSphereSource> sphere;
+  for (int i = 0; i < numberOfWrites; ++i)
+  {
+    sphere->SetThetaResolution(8 + i);
+    sphere->Update();
+    numberOfPoints[i] = sphere->GetOutput()->GetNumberOfPoints();
+    const std::string fileName = prefix + std::to_string(i) + ".vtp";
+    writeFutures.emplace_back(writer->Submit(sphere->GetOutput(), fileName.c_str()));
+    callbackFutures.emplace_back(writer->Then(writeFutures.back(),
+      [&, i, fileName](bool success)
+      {
+        const bool complete = success && ::ReadNumberOfPoints(fileName) == numberOfPoints[i];
+        std::lock_guard<std::mutex> lock(mutex);
+        writesDone.push_back(complete ? i : -1);
+      }));
+    if (!writeFutures.back() || !callbackFutures.back())
+    {
+      vtkLog(ERROR, "Cannot queue the write of " << fileName);
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The future of a callback is ready once the callback has run.
+  callbackFutures.front()->Wait();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (std::find(writesDone.begin(), writesDone.end(), 0) == writesDone.end())
+    {
+      vtkLog(ERROR, "The future of a callback was ready before the callback ran");
+      return EXIT_FAILURE;
+    }
+  }
+
+  writer->Wait();
+  if (writer->GetNumberOfPendingWrites() != 0 || writer->GetNumberOfFailedWrites() != 0 ||
+    static_cast<int>(writesDone.size()) != numberOfWrites)
+  {
+    vtkLog(ERROR, "Wrong counts of writes after Wait()");
+    return EXIT_FAILURE;
+  }
+  for (int i = 0; i < numberOfWrites; ++i)
+  {
+    if (writesDone[i] < 0 || !writeFutures[i]->Get())
+    {
+      vtkLog(ERROR, "A callback ran before its file was written");
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A write that fails gives false to its future and to its callbacks.
+  vtkNew<vtkTest::ErrorObserver> writerObserver;
+  vtkNew<vtkXMLPolyDataWriter> failingWriter;
+  failingWriter->AddObserver(vtkCommand::ErrorEvent, writerObserver);
+  failingWriter->SetFileName((prefix + "_missing_directory/file.vtp").c_str());
+  auto failingWrite = writer->Submit(sphere->GetOutput(), failingWriter);
+  int failureReported = 0;
+  auto failingCallback = writer->Then(failingWrite,
+    [&](bool success)
+    {
+      failureReported = success ? 1 : 2;
+    });
+  if (!failingWrite || !failingCallback)
+  {
+    vtkLog(ERROR, "Cannot queue the failing write");
+    return EXIT_FAILURE;
+  }
+  failingCallback->Wait();
+  if (failingWrite->Get() || failureReported != 2 || !writerObserver->GetError())
+  {
+    vtkLog(ERROR, "The failure of a write was not reported");
+    return EXIT_FAILURE;
+  }
+  writer->Wait();
+  if (writer->GetNumberOfFailedWrites() != 1)
+  {
+    vtkLog(ERROR, "Wrong number of failed writes: " << writer->GetNumberOfFailedWrites());
+    return EXIT_FAILURE;
+  }
+
+  // Nothing is queued for an unknown extension.
+  vtkNew<vtkTest::ErrorObserver> observer;
+  writer->AddObserver(vtkCommand::ErrorEvent, observer);
+  auto unknownWrite = writer->Submit(sphere->GetOutput(), (prefix + ".unknown").c_str());
+  if (unknownWrite || writer->Then(unknownWrite, [](bool) {}) ||
+    observer->CheckErrorMessage("unknown extension"))
+  {
+    vtkLog(ERROR, "A write with an unknown extension was queued");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
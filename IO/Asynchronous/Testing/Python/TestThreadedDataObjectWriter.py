@@ -0,0 +1,54 @@
+#!/usr/bin/env python
+import sys
+
+from vtkmodules.vtkFiltersSources import vtkSphereSource
+from vtkmodules.vtkIOAsynchronous import vtkThreadedDataObjectWriter
+from vtkmodules.vtkIOLegacy import vtkPolyDataReader
+from vtkmodules.vtkIOXML import vtkXMLPolyDataReader
+from vtkmodules.vtkImagingCore import vtkRTAnalyticSource
+from vtkmodules.util.misc import vtkGetTempDir
+
+VTK_TEMP_DIR = vtkGetTempDir()
+
+sphere = vtkSphereSource()
+image = vtkRTAnalyticSource()
+image.Update()
+
+writer = vtkThreadedDataObjectWriter()
+writer.SetNumberOfThreads(3)
+# Small bound, so that the writes must wait for each other
+writer.SetMaximumNumberOfPendingWrites(2)
+
+# Write a new data object at each iteration, as the caller would do
+expected = {}
+for i in range(12):
+    sphere.SetThetaResolution(8 + i)
+    sphere.Update()
+    polyData = sphere.GetOutput().NewInstance()
+    polyData.DeepCopy(sphere.GetOutput())
+    for extension in ('vtp', 'vtk'):
+        filePath = '%s/threaded-data-object-writer-%d.%s' % (VTK_TEMP_DIR, i, extension)
+        if not writer.Write(polyData, filePath):
+            print('Cannot queue', filePath)
+            sys.exit(1)
+        expected[filePath] = polyData.GetNumberOfPoints()
+    if writer.GetNumberOfPendingWrites() > 2:
+        print('Too many pending writes')
+        sys.exit(1)
+
+if not writer.Write(image.GetOutput(), '%s/threaded-data-object-writer.vti' % VTK_TEMP_DIR):
+    print('Cannot queue the image')
+    sys.exit(1)
+
+writer.Wait()
+if writer.GetNumberOfPendingWrites() != 0 or writer.GetNumberOfFailedWrites() != 0:
+    print('Wrong write counts')
+    sys.exit(1)
+
+for filePath, numberOfPoints in expected.items():
+    reader = vtkXMLPolyDataReader() if filePath.endswith('.vtp') else vtkPolyDataReader()
+    reader.SetFileName(filePath)
+    reader.Update()
+    if reader.GetOutput().GetNumberOfPoints() != numberOfPoints:
+        print('Wrong number of points in', filePath)
+        sys.exit(1)
@@ -0,0 +1,303 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkThreadedDataObjectWriter.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkBMPWriter.h"
+#include "vtkDataObject.h"
+#include "vtkErrorCode.h"
+#include "vtkGenericDataObjectWriter.h"
+#include "vtkImageData.h"
+#include "vtkJPEGWriter.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPNGWriter.h"
+#include "vtkPNMWriter.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTIFFWriter.h"
+#include "vtkXMLDataObjectWriter.h"
+#include "vtkXMLMultiBlockDataWriter.h"
+#include "vtkXMLWriter.h"
+
+#if VTK_MODULE_ENABLE_VTK_IOHDF
+#include "vtkHDFWriter.h"
+#endif
+#if VTK_MODULE_ENABLE_VTK_IOPLY
+#include "vtkPLYWriter.h"
+#endif
+
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+//****************************************************************************
+namespace
+{
+template <class WriterT>
+vtkSmartPointer<vtkAlgorithm> NewWriter(const char* fileName)
+{
+  auto writer = vtkSmartPointer<WriterT>::New();
+  writer->SetFileName(fileName);
+  return writer;
+}
+
+// Return a writer for `data` based on the extension of `fileName`, or nullptr.
+vtkSmartPointer<vtkAlgorithm> NewWriter(vtkDataObject* data, const char* fileName)
+{
+  const std::string extension =
+    vtksys::SystemTools::LowerCase(vtksys::SystemTools::GetFilenameLastExtension(fileName));
+
+  if (extension == ".vtk")
+  {
+    return ::NewWriter<vtkGenericDataObjectWriter>(fileName);
+  }
+#if VTK_MODULE_ENABLE_VTK_IOHDF
+  if (extension == ".vtkhdf" || extension == ".hdf")
+  {
+    return ::NewWriter<vtkHDFWriter>(fileName);
+  }
+#endif
+  if (extension == ".vtm" && vtkMultiBlockDataSet::SafeDownCast(data))
+  {
+    return ::NewWriter<vtkXMLMultiBlockDataWriter>(fileName);
+  }
+#if VTK_MODULE_ENABLE_VTK_IOPLY
+  if (extension == ".ply" && vtkPolyData::SafeDownCast(data))
+  {
+    return ::NewWriter<vtkPLYWriter>(fileName);
+  }
+#endif
+  if (vtkImageData::SafeDownCast(data))
+  {
+    if (extension == ".png")
+    {
+      return ::NewWriter<vtkPNGWriter>(fileName);
+    }
+    if (extension == ".jpg" || extension == ".jpeg")
+    {
+      return ::NewWriter<vtkJPEGWriter>(fileName);
+    }
+    if (extension == ".bmp")
+    {
+      return ::NewWriter<vtkBMPWriter>(fileName);
+    }
+    if (extension == ".ppm" || extension == ".pnm")
+    {
+      return ::NewWriter<vtkPNMWriter>(fileName);
+    }
+    if (extension == ".tif" || extension == ".tiff")
+    {
+      return ::NewWriter<vtkTIFFWriter>(fileName);
+    }
+  }
+
+  // XML writers are chosen from the data type, the extension must match it.
+  vtkSmartPointer<vtkXMLWriter> writer;
+  writer.TakeReference(vtkXMLDataObjectWriter::NewWriter(data->GetDataObjectType()));
+  if (writer && extension == std::string(".") + writer->GetDefaultFileExtension())
+  {
+    writer->SetFileName(fileName);
+    return writer;
+  }
+  return nullptr;
+}
+}
+
+VTK_ABI_NAMESPACE_BEGIN
+//****************************************************************************
+class vtkThreadedDataObjectWriter::vtkInternals
+{
+public:
+  std::mutex Mutex;
+  std::condition_variable TaskDone;
+  int NumberOfPendingTasks = 0;
+  vtkIdType NumberOfFailedWrites = 0;
+
+  // Declared last so that its threads are joined before the members above
+  // are destroyed.
+  vtkNew<vtkThreadedCallbackQueue> Queue;
+
+  // Block until fewer than `maximum` tasks are pending, then count a new one.
+  void AddTask(int maximum)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    if (maximum > 0)
+    {
+      this->TaskDone.wait(lock, [&] { return this->NumberOfPendingTasks < maximum; });
+    }
+    ++this->NumberOfPendingTasks;
+  }
+
+  void RemoveTask(bool failed)
+  {
+    // Notify while holding the lock: once it is released, Wait() may return
+    // and the writer may be deleted.
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    --this->NumberOfPendingTasks;
+    this->NumberOfFailedWrites += failed;
+    this->TaskDone.notify_all();
+  }
+
+  // HDF5 is not built thread-safe by default.
+  static std::mutex& GetHDFMutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+};
+
+vtkStandardNewMacro(vtkThreadedDataObjectWriter);
+//------------------------------------------------------------------------------
+vtkThreadedDataObjectWriter::vtkThreadedDataObjectWriter()
+  : Internals(new vtkInternals())
+{
+  this->Internals->Queue->SetNumberOfThreads(this->NumberOfThreads);
+}
+
+//------------------------------------------------------------------------------
+vtkThreadedDataObjectWriter::~vtkThreadedDataObjectWriter()
+{
+  this->Wait();
+  delete this->Internals;
+  this->Internals = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataObjectWriter::SetNumberOfThreads(int numberOfThreads)
+{
+  numberOfThreads = std::max(numberOfThreads, 1);
+  if (this->NumberOfThreads != numberOfThreads)
+  {
+    this->NumberOfThreads = numberOfThreads;
+    this->Internals->Queue->SetNumberOfThreads(numberOfThreads);
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+bool vtkThreadedDataObjectWriter::Write(vtkDataObject* data, const char* fileName)
+{
+  return this->Submit(data, fileName) != nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool vtkThreadedDataObjectWriter::Write(vtkDataObject* data, vtkAlgorithm* writer)
+{
+  return this->Submit(data, writer) != nullptr;
+}
+
+//------------------------------------------------------------------------------
+vtkThreadedDataObjectWriter::WriteFuture vtkThreadedDataObjectWriter::Submit(
+  vtkDataObject* data, const char* fileName)
+{
+  if (!data || !fileName)
+  {
+    vtkErrorMacro("A data object and a file name are required.");
+    return nullptr;
+  }
+  vtkSmartPointer<vtkAlgorithm> writer = ::NewWriter(data, fileName);
+  if (!writer)
+  {
+    vtkErrorMacro(
+      "Cannot write " << data->GetClassName() << " to \"" << fileName << "\": unknown extension.");
+    return nullptr;
+  }
+  return this->Submit(data, writer);
+}
+
+//------------------------------------------------------------------------------
+vtkThreadedDataObjectWriter::WriteFuture vtkThreadedDataObjectWriter::Submit(
+  vtkDataObject* data, vtkAlgorithm* writer)
+{
+  if (!data || !writer || writer->GetNumberOfInputPorts() < 1)
+  {
+    vtkErrorMacro("A data object and a writer with an input port are required.");
+    return nullptr;
+  }
+
+  // The caller may modify the structure of the data object once it is queued.
+  vtkSmartPointer<vtkDataObject> copy;
+  copy.TakeReference(data->NewInstance());
+  copy->ShallowCopy(data);
+
+  this->Internals->AddTask(this->MaximumNumberOfPendingWrites);
+  vtkInternals* internals = this->Internals;
+  vtkSmartPointer<vtkAlgorithm> writerPointer = writer;
+  return this->Internals->Queue->Push(
+    [internals, writerPointer, copy]()
+    {
+      std::unique_lock<std::mutex> hdfLock(vtkInternals::GetHDFMutex(), std::defer_lock);
+      if (writerPointer->IsA("vtkHDFWriter"))
+      {
+        hdfLock.lock();
+      }
+      writerPointer->SetInputDataObject(0, copy);
+      writerPointer->Modified();
+      writerPointer->Update();
+      const bool success = writerPointer->GetErrorCode() == vtkErrorCode::NoError;
+      writerPointer->SetInputDataObject(0, nullptr);
+      internals->RemoveTask(!success);
+      return success;
+    });
+}
+
+//------------------------------------------------------------------------------
+vtkThreadedDataObjectWriter::CallbackFuture vtkThreadedDataObjectWriter::Then(
+  const WriteFuture& future, std::function<void(bool)> callback)
+{
+  if (!future)
+  {
+    return nullptr;
+  }
+  this->Internals->AddTask(0);
+  vtkInternals* internals = this->Internals;
+  std::array<WriteFuture, 1> prior{ { future } };
+  return this->Internals->Queue->PushDependent(prior,
+    [internals, future, callback]()
+    {
+      if (callback)
+      {
+        callback(future->Get());
+      }
+      internals->RemoveTask(false);
+    });
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataObjectWriter::Wait()
+{
+  vtkInternals* internals = this->Internals;
+  std::unique_lock<std::mutex> lock(internals->Mutex);
+  internals->TaskDone.wait(lock, [internals] { return internals->NumberOfPendingTasks == 0; });
+}
+
+//------------------------------------------------------------------------------
+int vtkThreadedDataObjectWriter::GetNumberOfPendingWrites()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->NumberOfPendingTasks;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkThreadedDataObjectWriter::GetNumberOfFailedWrites()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->NumberOfFailedWrites;
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataObjectWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
+  os << indent << "MaximumNumberOfPendingWrites: " << this->MaximumNumberOfPendingWrites << "\n";
+  os << indent << "NumberOfPendingWrites: " << this->GetNumberOfPendingWrites() << "\n";
+  os << indent << "NumberOfFailedWrites: " << this->GetNumberOfFailedWrites() << "\n";
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class    vtkThreadedDataObjectWriter
+ * @brief    write data objects on worker threads, without blocking the caller
+ *
+ * vtkThreadedDataObjectWriter queues writes of any data object and performs them on a pool of
+ * worker threads, so that the caller can compute the next data object while the previous ones
+ * are encoded and written to disk.
+ *
+ * The writer is either chosen from the file extension, or given already configured:
+ * - `.vtk`: legacy format, vtkGenericDataObjectWriter
+ * - `.vti`, `.vtp`, `.vtu`, `.vtr`, `.vts`, `.vtt`, `.htg`: XML format matching the data type,
+ *   see vtkXMLDataObjectWriter
+ * - `.vtm`: XML multiblock format, vtkXMLMultiBlockDataWriter
+ * - `.vtkhdf`, `.hdf`: VTKHDF format, vtkHDFWriter, when the IOHDF module is enabled
+ * - `.ply`: PLY format for polygonal data, vtkPLYWriter, when the IOPLY module is enabled
+ * - `.png`, `.jpg`, `.jpeg`, `.bmp`, `.ppm`, `.pnm`, `.tif`, `.tiff`: images
+ *
+ * Each queued write holds a shallow copy of the data object: the caller may release or modify
+ * the data object structure, but must not modify the arrays it holds in place until the write
+ * is done. The number of writes queued or running is bounded by MaximumNumberOfPendingWrites,
+ * which makes Write() block when the disk cannot keep up with the computation.
+ *
+ * In C++, Submit() returns a future giving the success of the write, and Then() runs a
+ * callback once a write is done.
+ *
+ * HDF5 is not thread-safe by default, so VTKHDF files are written one at a time.
+ *
+ * @sa vtkThreadedImageWriter vtkThreadedCallbackQueue
+ */
+
+#ifndef vtkThreadedDataObjectWriter_h
+#define vtkThreadedDataObjectWriter_h
+
+#include "vtkIOAsynchronousModule.h" // For export macro
+#include "vtkObject.h"
+#include "vtkThreadedCallbackQueue.h" // For vtkThreadedCallbackQueue::SharedFuturePointer
+
+#include <functional> // For std::function
+
+VTK_ABI_NAMESPACE_BEGIN
+class vtkAlgorithm;
+class vtkDataObject;
+
+class VTKIOASYNCHRONOUS_EXPORT vtkThreadedDataObjectWriter : public vtkObject
+{
+public:
+  static vtkThreadedDataObjectWriter* New();
+  vtkTypeMacro(vtkThreadedDataObjectWriter, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Number of worker threads writing the queued data objects.
+   * Default is 2.
+   */
+  void SetNumberOfThreads(int numberOfThreads);
+  vtkGetMacro(NumberOfThreads, int);
+  ///@}
+
+  ///@{
+  /**
+   * Maximum number of writes queued or running. When it is reached, Write() and Submit() block
+   * until a write is done, which bounds the memory held by the queued data objects.
+   * 0 means no limit. Default is 16.
+   */
+  vtkSetClampMacro(MaximumNumberOfPendingWrites, int, 0, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfPendingWrites, int);
+  ///@}
+
+  /**
+   * Queue the writing of `data` to `fileName`, with a writer chosen from the file extension.
+   * Return false if the data object cannot be written to this file type, in which case
+   * nothing is queued.
+   */
+  bool Write(vtkDataObject* data, VTK_FILEPATH const char* fileName);
+
+  /**
+   * Queue the writing of `data` with `writer`, a configured writer algorithm, e.g. with its file
+   * name and compression set. The writer must not be used elsewhere until the write is done.
+   * Return false if nothing is queued.
+   */
+  bool Write(vtkDataObject* data, vtkAlgorithm* writer);
+
+  /**
+   * Block until all the queued writes and callbacks are done.
+   */
+  void Wait();
+
+  /**
+   * Get the number of writes and callbacks queued or running.
+   */
+  int GetNumberOfPendingWrites();
+
+  /**
+   * Get the number of writes that failed since this object was created.
+   */
+  vtkIdType GetNumberOfFailedWrites();
+
+#if !defined(__WRAP__)
+  using WriteFuture = vtkThreadedCallbackQueue::SharedFuturePointer<bool>;
+  using CallbackFuture = vtkThreadedCallbackQueue::SharedFuturePointer<void>;
+
+  ///@{
+  /**
+   * Same as Write(), but return a future whose value is true if the data object was written
+   * successfully, or nullptr if nothing is queued.
+   */
+  WriteFuture Submit(vtkDataObject* data, const char* fileName);
+  WriteFuture Submit(vtkDataObject* data, vtkAlgorithm* writer);
+  ///@}
+
+  /**
+   * Call `callback` on a worker thread once the write of `future` is done, with the success of
+   * the write. Return the future of the callback, or nullptr if `future` is nullptr.
+   */
+  CallbackFuture Then(const WriteFuture& future, std::function<void(bool)> callback);
+#endif
+
+protected:
+  vtkThreadedDataObjectWriter();
+  ~vtkThreadedDataObjectWriter() override;
+
+private:
+  vtkThreadedDataObjectWriter(const vtkThreadedDataObjectWriter&) = delete;
+  void operator=(const vtkThreadedDataObjectWriter&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+  int NumberOfThreads = 2;
+  int MaximumNumberOfPendingWrites = 16;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif
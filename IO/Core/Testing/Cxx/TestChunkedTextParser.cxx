@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkChunkedTextParser.h"
+#include "vtkMemoryResourceStream.h"
+#include "vtkNew.h"
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define Check(expr, message)                                                                       \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(expr))                                                                                   \
+    {                                                                                              \
+      vtkErrorWithObjectMacro(nullptr, "Test failed: \n" << message);                              \
+      return false;                                                                                \
+    }                                                                                              \
+  } while (false)
+
+namespace
+{
+bool TestTokens()
+{
+  std::string text;
+  for (int i = 0; i < 1000; ++i)
+  {
+    text += std::to_string(i * 0.5) + (i % 7 == 0 ? "\n" : "  ");
+  }
+  text += " trailing";
+
+  vtkNew<vtkChunkedTextParser> parser;
+  parser->SetChunkSize(13);
+  Check(parser->SetText(text.data(), text.size(), vtkChunkedTextParser::Unit::Token, 1000) == 1000,
+    "Wrong number of tokens");
+  Check(parser->GetNumberOfChunks() > 100, "The text was not split");
+  Check(text.compare(parser->GetEnd(), std::string::npos, "   trailing") == 0,
+    "Wrong end of the tokens");
+
+  std::vector<double> values(1000);
+  Check(parser->ParseTokens(values.data()), "Cannot parse the tokens");
+  for (int i = 0; i < 1000; ++i)
+  {
+    Check(values[i] == i * 0.5, "Wrong value " << i);
+  }
+
+  std::vector<int> integers(1000);
+  Check(!parser->ParseTokens(integers.data()), "Decimal numbers must not be parsed as integers");
+
+  Check(parser->SetText(text.data(), text.size(), vtkChunkedTextParser::Unit::Token) == 1001,
+    "Wrong number of tokens without limit");
+  Check(parser->GetEnd() == text.size(), "Wrong end of the text");
+  values.resize(1001);
+  Check(!parser->ParseTokens(values.data()), "A word must not be parsed as a number");
+  return true;
+}
+
+bool TestRead()
+{
+  std::string text;
+  for (int i = 0; i < 5000; ++i)
+  {
+    text += std::to_string(i) + (i % 10 == 9 ? "\r\n" : " ");
+  }
+  text += "CELLS 3";
+
+  // Reads end in the middle of tokens.
+  vtkNew<vtkChunkedTextParser> parser;
+  parser->SetChunkSize(101);
+  std::istringstream stream(text);
+  Check(parser->Read(stream, vtkChunkedTextParser::Unit::Token, 5000) == 5000,
+    "Wrong number of tokens read");
+  std::vector<vtkIdType> values(5000);
+  Check(parser->ParseTokens(values.data()), "Cannot parse the tokens read");
+  for (int i = 0; i < 5000; ++i)
+  {
+    Check(values[i] == i, "Wrong value read " << i);
+  }
+  Check(text.compare(parser->GetEnd(), std::string::npos, "\r\nCELLS 3") == 0,
+    "Wrong end of the tokens read");
+
+  vtkNew<vtkMemoryResourceStream> resource;
+  resource->SetBuffer(text.data(), text.size());
+  Check(parser->Read(resource, vtkChunkedTextParser::Unit::Line, 123) == 123,
+    "Wrong number of lines read");
+  Check(parser->GetEnd() == text.find("1230 "), "Wrong end of the lines read");
+
+  std::atomic<vtkIdType> numberOfLines(0);
+  std::atomic<bool> valid(true);
+  parser->ForEachChunk(
+    [&](std::size_t, const char* begin, const char* end, vtkIdType firstLine)
+    {
+      vtkChunkedTextParser::ForEachLine(begin, end,
+        [&](const char* first, const char* last)
+        {
+          int value = 0;
+          if (!vtkChunkedTextParser::ParseValue(first, last, value) || value != firstLine * 10)
+          {
+            valid = false;
+          }
+          ++firstLine;
+          ++numberOfLines;
+        });
+    });
+  Check(valid && numberOfLines == 123, "Wrong lines");
+
+  resource->Seek(parser->GetEnd(), vtkResourceStream::SeekDirection::Begin);
+  Check(parser->Read(resource, vtkChunkedTextParser::Unit::Line) == 378, "Wrong last lines");
+  Check(parser->GetEnd() == parser->GetSize(), "The last line must end the text");
+  return true;
+}
+}
+
+int TestChunkedTextParser(int, char*[])
+{
+  if (!TestTokens() || !TestRead())
+  {
+    return 1;
+  }
+  return 0;
+}
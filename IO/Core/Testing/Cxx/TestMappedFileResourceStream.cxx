@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkFloatArray.h"
+#include "vtkMappedFileResourceStream.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkTestUtilities.h"
+
+#include <vtksys/FStream.hxx>
+
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define Check(expr, message)                                                                       \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(expr))                                                                                   \
+    {                                                                                              \
+      vtkErrorWithObjectMacro(nullptr, "Test failed: \n" << message);                              \
+      return false;                                                                                \
+    }                                                                                              \
+  } while (false)
+
+namespace
+{
+constexpr const char header[] = "Header!!";
+constexpr std::size_t headerSize = sizeof(header) - 1;
+constexpr int numberOfValues = 3000;
+
+bool TestStream(const std::string& path)
+{
+  vtkNew<vtkMappedFileResourceStream> stream;
+  Check(stream->EndOfStream(), "A closed stream must be at end of stream");
+  Check(!stream->Open((path + ".missing").c_str()), "Missing file must not be mapped");
+  Check(stream->Open(path.c_str()), "Cannot map the file");
+  Check(stream->GetSize() == headerSize + numberOfValues * sizeof(float), "Wrong size");
+  Check(std::memcmp(stream->GetData(), header, headerSize) == 0, "Wrong mapped data");
+
+  std::array<char, headerSize> buffer;
+  Check(stream->Read(buffer.data(), 6) == 6, "Read wrong size");
+  Check(std::strncmp(buffer.data(), "Header", 6) == 0, "Read wrong data");
+  Check(stream->Tell() == 6, "Tell wrong position");
+  Check(stream->Seek(-2, vtkResourceStream::SeekDirection::Current) == 4, "Seek wrong position");
+  Check(stream->Read(buffer.data(), 2) == 2, "Read wrong size");
+  Check(std::strncmp(buffer.data(), "er", 2) == 0, "Read wrong data");
+
+  float last = 0;
+  Check(stream->Seek(-4, vtkResourceStream::SeekDirection::End) ==
+      static_cast<vtkTypeInt64>(stream->GetSize() - 4),
+    "Seek wrong position");
+  Check(stream->Read(&last, sizeof(last)) == sizeof(last), "Read wrong size");
+  Check(!stream->EndOfStream(), "Reach end of file too early");
+  Check(last == numberOfValues - 1, "Read wrong value");
+  Check(stream->Read(buffer.data(), 1) == 0, "Read past the end");
+  Check(stream->EndOfStream(), "Last read must lead the stream to EOS");
+
+  Check(!stream->Open(nullptr), "Open(nullptr) must return false");
+  Check(stream->GetData() == nullptr && stream->GetSize() == 0, "Stream not closed");
+  return true;
+}
+
+bool TestMapIntoArray(const std::string& path)
+{
+  vtkNew<vtkFloatArray> array;
+  array->SetNumberOfComponents(3);
+  {
+    vtkNew<vtkMappedFileResourceStream> stream;
+    Check(stream->Open(path.c_str()), "Cannot map the file");
+    Check(!stream->MapIntoArray(array, headerSize + 2, 10), "Misaligned region must be refused");
+    Check(!stream->MapIntoArray(array, headerSize, numberOfValues), "Region past end of file");
+    vtkNew<vtkSOADataArrayTemplate<float>> soa;
+    Check(!stream->MapIntoArray(soa, headerSize, 10), "SOA arrays must be refused");
+    Check(stream->MapIntoArray(array, headerSize, numberOfValues / 3), "Cannot map the region");
+    Check(reinterpret_cast<const unsigned char*>(array->GetPointer(0)) ==
+        static_cast<const unsigned char*>(stream->GetData()) + headerSize,
+      "The array does not use the mapped region");
+  }
+
+  // The array keeps the mapping alive after the stream is deleted.
+  Check(array->GetNumberOfTuples() == numberOfValues / 3, "Wrong number of tuples");
+  for (int i = 0; i < numberOfValues; ++i)
+  {
+    Check(array->GetValue(i) == i, "Wrong value " << i);
+  }
+
+  // Modifications stay private to the array.
+  array->SetValue(0, -1.f);
+  vtkNew<vtkFloatArray> other;
+  vtkNew<vtkMappedFileResourceStream> stream;
+  Check(stream->Open(path.c_str()), "Cannot map the file");
+  Check(stream->MapIntoArray(other, headerSize, numberOfValues), "Cannot map the region");
+  Check(other->GetValue(0) == 0.f, "The file was modified");
+
+  // Growing the array copies it out of the mapping.
+  array->InsertNextTuple3(1, 2, 3);
+  Check(array->GetValue(0) == -1.f && array->GetValue(numberOfValues + 2) == 3.f,
+    "Wrong values after reallocation");
+  return true;
+}
+}
+
+int TestMappedFileResourceStream(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string path = std::string(tempDir) + "/mapped_resource.raw";
+  delete[] tempDir;
+
+  std::vector<float> values(numberOfValues);
+  for (int i = 0; i < numberOfValues; ++i)
+  {
+    values[i] = static_cast<float>(i);
+  }
+  {
+    vtksys::ofstream file(path.c_str(), std::ios_base::binary);
+    file.write(header, headerSize);
+    file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+  }
+
+  if (!TestStream(path) || !TestMapIntoArray(path))
+  {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,236 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkChunkedTextParser.h"
+
+#include "vtkObjectFactory.h"
+#include "vtkResourceStream.h"
+
+#include <algorithm>
+
+VTK_ABI_NAMESPACE_BEGIN
+
+vtkStandardNewMacro(vtkChunkedTextParser);
+
+namespace
+{
+//------------------------------------------------------------------------------
+bool IsSeparator(vtkChunkedTextParser::Unit unit, char c)
+{
+  return unit == vtkChunkedTextParser::Unit::Line ? c == '\n'
+                                                  : vtkChunkedTextParser::IsWhitespace(c);
+}
+
+//------------------------------------------------------------------------------
+// Count the units beginning in [begin, end), which starts after a separator.
+vtkIdType CountUnits(vtkChunkedTextParser::Unit unit, const char* begin, const char* end)
+{
+  vtkIdType count = 0;
+  if (unit == vtkChunkedTextParser::Unit::Line)
+  {
+    count = static_cast<vtkIdType>(std::count(begin, end, '\n'));
+    if (begin != end && end[-1] != '\n')
+    {
+      ++count;
+    }
+  }
+  else
+  {
+    bool inToken = false;
+    for (; begin != end; ++begin)
+    {
+      const bool whitespace = vtkChunkedTextParser::IsWhitespace(*begin);
+      count += !whitespace && !inToken;
+      inToken = !whitespace;
+    }
+  }
+  return count;
+}
+
+//------------------------------------------------------------------------------
+// Return the end of the n-th unit beginning in [begin, end), n > 0.
+const char* FindUnitEnd(
+  vtkChunkedTextParser::Unit unit, const char* begin, const char* end, vtkIdType n)
+{
+  if (unit == vtkChunkedTextParser::Unit::Line)
+  {
+    for (; begin != end; ++begin)
+    {
+      if (*begin == '\n' && --n == 0)
+      {
+        return begin + 1;
+      }
+    }
+    return end;
+  }
+
+  bool inToken = false;
+  for (; begin != end; ++begin)
+  {
+    const bool whitespace = vtkChunkedTextParser::IsWhitespace(*begin);
+    if (whitespace && inToken && --n == 0)
+    {
+      return begin;
+    }
+    inToken = !whitespace;
+  }
+  return end;
+}
+
+//------------------------------------------------------------------------------
+std::size_t ReadBytes(vtkResourceStream* stream, char* buffer, std::size_t size)
+{
+  return stream->Read(buffer, size);
+}
+
+//------------------------------------------------------------------------------
+std::size_t ReadBytes(std::istream& stream, char* buffer, std::size_t size)
+{
+  stream.read(buffer, static_cast<std::streamsize>(size));
+  return static_cast<std::size_t>(stream.gcount());
+}
+}
+
+//------------------------------------------------------------------------------
+vtkChunkedTextParser::vtkChunkedTextParser() = default;
+
+//------------------------------------------------------------------------------
+vtkChunkedTextParser::~vtkChunkedTextParser() = default;
+
+//------------------------------------------------------------------------------
+vtkIdType vtkChunkedTextParser::Read(vtkResourceStream* stream, Unit unit, vtkIdType count)
+{
+  if (!stream)
+  {
+    return this->SetText(nullptr, 0, unit, count);
+  }
+  return this->ReadUnits(stream, unit, count);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkChunkedTextParser::Read(std::istream& stream, Unit unit, vtkIdType count)
+{
+  return this->ReadUnits(stream, unit, count);
+}
+
+//------------------------------------------------------------------------------
+template <typename Stream>
+vtkIdType vtkChunkedTextParser::ReadUnits(Stream& stream, Unit unit, vtkIdType count)
+{
+  this->Text.clear();
+  std::size_t request = static_cast<std::size_t>(this->ChunkSize);
+  while (true)
+  {
+    const std::size_t size = this->Text.size();
+    this->Text.resize(size + request);
+    const std::size_t read = ::ReadBytes(stream, this->Text.data() + size, request);
+    this->Text.resize(size + read);
+
+    const bool complete = read < request;
+    // Splitting is only needed to know if enough units were read
+    if (complete || count != VTK_ID_MAX)
+    {
+      const vtkIdType numberOfUnits = this->Split(unit, count, complete);
+      if (complete || numberOfUnits >= count)
+      {
+        return numberOfUnits;
+      }
+    }
+    request = this->Text.size();
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkChunkedTextParser::SetText(
+  const char* text, std::size_t size, Unit unit, vtkIdType count)
+{
+  this->Text.assign(text, text + size);
+  return this->Split(unit, count, true);
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkChunkedTextParser::Split(Unit unit, vtkIdType count, bool complete)
+{
+  this->Chunks.clear();
+  this->NumberOfUnits = 0;
+  this->End = 0;
+
+  // An incomplete unit at the end of the text is left out.
+  const char* text = this->Text.data();
+  std::size_t size = this->Text.size();
+  if (!complete)
+  {
+    while (size > 0 && !::IsSeparator(unit, text[size - 1]))
+    {
+      --size;
+    }
+  }
+  if (count <= 0 || size == 0)
+  {
+    return 0;
+  }
+
+  // Chunks end after a separator, so that no unit is shared by two chunks.
+  const auto chunkSize = static_cast<std::size_t>(this->ChunkSize);
+  for (std::size_t begin = 0; begin < size;)
+  {
+    std::size_t end = begin + std::min(chunkSize, size - begin);
+    while (end < size && !::IsSeparator(unit, text[end - 1]))
+    {
+      ++end;
+    }
+    this->Chunks.push_back(Chunk{ begin, end, 0, 0 });
+    begin = end;
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(this->Chunks.size()), 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        Chunk& chunk = this->Chunks[i];
+        chunk.NumberOfUnits = ::CountUnits(unit, text + chunk.Begin, text + chunk.End);
+      }
+    });
+
+  // Number the units, and drop the ones after the count-th one.
+  vtkIdType firstUnit = 0;
+  for (std::size_t i = 0; i < this->Chunks.size(); ++i)
+  {
+    Chunk& chunk = this->Chunks[i];
+    chunk.FirstUnit = firstUnit;
+    if (firstUnit + chunk.NumberOfUnits >= count)
+    {
+      chunk.NumberOfUnits = count - firstUnit;
+      chunk.End = static_cast<std::size_t>(
+        ::FindUnitEnd(unit, text + chunk.Begin, text + chunk.End, chunk.NumberOfUnits) - text);
+      this->Chunks.resize(i + 1);
+      break;
+    }
+    firstUnit += chunk.NumberOfUnits;
+  }
+  this->NumberOfUnits = this->Chunks.back().FirstUnit + this->Chunks.back().NumberOfUnits;
+
+  // Trailing whitespace after the last token is not part of the units.
+  this->End = this->Chunks.back().End;
+  if (unit == Unit::Token)
+  {
+    while (this->End > 0 && IsWhitespace(text[this->End - 1]))
+    {
+      --this->End;
+    }
+  }
+  return this->NumberOfUnits;
+}
+
+//------------------------------------------------------------------------------
+void vtkChunkedTextParser::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "ChunkSize: " << this->ChunkSize << "\n";
+  os << indent << "Size: " << this->Text.size() << "\n";
+  os << indent << "NumberOfChunks: " << this->Chunks.size() << "\n";
+  os << indent << "NumberOfUnits: " << this->NumberOfUnits << "\n";
+  os << indent << "End: " << this->End << "\n";
+}
+
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,274 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkChunkedTextParser_h
+#define vtkChunkedTextParser_h
+
+#include "vtkIOCoreModule.h" // For export macro
+#include "vtkObject.h"
+#include "vtkSMPTools.h"        // For vtkSMPTools::For
+#include "vtkValueFromString.h" // For vtkValueFromString
+
+#include <atomic>      // For std::atomic
+#include <cstddef>     // For std::size_t
+#include <cstring>     // For std::memchr
+#include <istream>     // For std::istream
+#include <type_traits> // For std::conditional
+#include <vector>      // For std::vector
+
+VTK_ABI_NAMESPACE_BEGIN
+
+class vtkResourceStream;
+
+/**
+ * @brief Parse text in chunks, concurrently
+ *
+ * vtkChunkedTextParser holds text read from a stream, and splits it into
+ * chunks of about ChunkSize bytes that end with complete lines or complete
+ * whitespace separated tokens. The chunks can then be parsed concurrently
+ * with ForEachChunk, each chunk knowing the index of its first line or
+ * token, so that the results can be written directly at their place or
+ * stitched together afterwards. ParseTokens does this for a sequence of
+ * whitespace separated numbers.
+ *
+ * Values are converted with vtkValueFromString, as vtkResourceParser does.
+ *
+ * Quick how to:
+ * - Read the text and split it using `Read` or `SetText`, for a number of lines or tokens
+ * - Parse the chunks with `ForEachChunk`, or the tokens as values with `ParseTokens`
+ * - Use `GetEnd` to know where the last line or token ends, for instance to continue reading
+ *   from there with another parser.
+ */
+class VTKIOCORE_EXPORT vtkChunkedTextParser : public vtkObject
+{
+public:
+  static vtkChunkedTextParser* New();
+  vtkTypeMacro(vtkChunkedTextParser, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * The units in which the text is split: lines ending with `\n`, or
+   * tokens separated by whitespace.
+   */
+  enum class Unit
+  {
+    Line,
+    Token
+  };
+
+  ///@{
+  /**
+   * Approximate size, in bytes, of the chunks, which are extended to the end
+   * of their last unit. This is also the size of the first read of `Read`.
+   * Default is 256 KiB.
+   */
+  vtkSetClampMacro(ChunkSize, vtkIdType, 1, VTK_ID_MAX);
+  vtkGetMacro(ChunkSize, vtkIdType);
+  ///@}
+
+  ///@{
+  /**
+   * Read from the current position of `stream` until the text holds `count`
+   * units or the stream ends, then split these units in chunks. The stream
+   * is usually read past the last unit: GetEnd() gives the number of bytes
+   * used by the units. A unit at the end of the stream is complete even if
+   * it is not followed by a separator.
+   *
+   * The text read before is discarded.
+   *
+   * @return the number of units, at most `count`.
+   */
+  vtkIdType Read(vtkResourceStream* stream, Unit unit, vtkIdType count = VTK_ID_MAX);
+  vtkIdType Read(std::istream& stream, Unit unit, vtkIdType count = VTK_ID_MAX);
+  ///@}
+
+  /**
+   * Copy `size` bytes from `text` and split them in chunks of at most
+   * `count` units, as Read does.
+   */
+  vtkIdType SetText(const char* text, std::size_t size, Unit unit, vtkIdType count = VTK_ID_MAX);
+
+  ///@{
+  /**
+   * Get the text read by the last call to Read or SetText.
+   */
+  const char* GetText() const { return this->Text.data(); }
+  std::size_t GetSize() const { return this->Text.size(); }
+  ///@}
+
+  /**
+   * Get the number of units in the chunks.
+   */
+  vtkIdType GetNumberOfUnits() const { return this->NumberOfUnits; }
+
+  /**
+   * Get the offset in the text just after the last unit of the chunks: after
+   * the `\n` of the last line, or after the last character of the last token.
+   */
+  std::size_t GetEnd() const { return this->End; }
+
+  /**
+   * Get the number of chunks.
+   */
+  std::size_t GetNumberOfChunks() const { return this->Chunks.size(); }
+
+  /**
+   * Call `functor(chunkIndex, begin, end, firstUnit)` for each chunk,
+   * concurrently. [begin, end) holds the complete units of the chunk, and
+   * `firstUnit` is the index of its first unit in the text.
+   */
+  template <typename Functor>
+  void ForEachChunk(Functor&& functor) const;
+
+  /**
+   * Convert the tokens of the chunks to values, concurrently, and write them
+   * in `values`, which must hold GetNumberOfUnits() values. The chunks must
+   * have been split in tokens.
+   *
+   * @return false if a token is not a valid value, in which case the content
+   * of `values` is undefined.
+   */
+  template <typename T>
+  bool ParseTokens(T* values) const;
+
+  /**
+   * Call `functor(begin, end)` for each line of [begin, end), without its
+   * `\n`.
+   */
+  template <typename Functor>
+  static void ForEachLine(const char* begin, const char* end, Functor&& functor);
+
+  /**
+   * Return true if `c` is a space, a tab, a line feed, a carriage return, a
+   * vertical tab or a form feed.
+   */
+  static bool IsWhitespace(char c)
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  /**
+   * Return the first character of [first, last) that is not whitespace, or
+   * `last`.
+   */
+  static const char* SkipWhitespace(const char* first, const char* last)
+  {
+    while (first != last && IsWhitespace(*first))
+    {
+      ++first;
+    }
+    return first;
+  }
+
+  /**
+   * Skip the leading whitespace of [first, last), then convert the next
+   * token to `value`. `char` values are parsed as `signed char`.
+   *
+   * @return the end of the token, or nullptr if the token is not a valid
+   * value or if it is not followed by whitespace or `last`.
+   */
+  template <typename T>
+  static const char* ParseValue(const char* first, const char* last, T& value);
+
+protected:
+  vtkChunkedTextParser();
+  ~vtkChunkedTextParser() override;
+
+private:
+  vtkChunkedTextParser(const vtkChunkedTextParser&) = delete;
+  void operator=(const vtkChunkedTextParser&) = delete;
+
+  template <typename Stream>
+  vtkIdType ReadUnits(Stream& stream, Unit unit, vtkIdType count);
+
+  /**
+   * Split the text in chunks of at most `count` units. If `complete` is
+   * false, a unit at the end of the text without separator is ignored, as it
+   * may continue in the stream.
+   */
+  vtkIdType Split(Unit unit, vtkIdType count, bool complete);
+
+  struct Chunk
+  {
+    std::size_t Begin;
+    std::size_t End;
+    vtkIdType FirstUnit;
+    vtkIdType NumberOfUnits;
+  };
+
+  vtkIdType ChunkSize = 1 << 18;
+  std::vector<char> Text;
+  std::vector<Chunk> Chunks;
+  vtkIdType NumberOfUnits = 0;
+  std::size_t End = 0;
+};
+
+//------------------------------------------------------------------------------
+template <typename Functor>
+void vtkChunkedTextParser::ForEachChunk(Functor&& functor) const
+{
+  vtkSMPTools::For(0, static_cast<vtkIdType>(this->Chunks.size()), 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const Chunk& chunk = this->Chunks[i];
+        functor(static_cast<std::size_t>(i), this->Text.data() + chunk.Begin,
+          this->Text.data() + chunk.End, chunk.FirstUnit);
+      }
+    });
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+bool vtkChunkedTextParser::ParseTokens(T* values) const
+{
+  std::atomic<bool> valid(true);
+  this->ForEachChunk(
+    [&](std::size_t, const char* begin, const char* end, vtkIdType firstUnit)
+    {
+      T* value = values + firstUnit;
+      for (begin = SkipWhitespace(begin, end); begin != end && valid;
+           begin = SkipWhitespace(begin, end))
+      {
+        begin = ParseValue(begin, end, *value++);
+        if (!begin)
+        {
+          valid = false;
+          return;
+        }
+      }
+    });
+  return valid;
+}
+
+//------------------------------------------------------------------------------
+template <typename Functor>
+void vtkChunkedTextParser::ForEachLine(const char* begin, const char* end, Functor&& functor)
+{
+  while (begin != end)
+  {
+    const char* eol = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+    functor(begin, eol ? eol : end);
+    begin = eol ? eol + 1 : end;
+  }
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+const char* vtkChunkedTextParser::ParseValue(const char* first, const char* last, T& value)
+{
+  using ParsedType = typename std::conditional<std::is_same<T, char>::value, signed char, T>::type;
+  first = SkipWhitespace(first, last);
+  ParsedType parsed;
+  const std::size_t consumed = vtkValueFromString(first, last, parsed);
+  if (consumed == 0 || (first + consumed != last && !IsWhitespace(first[consumed])))
+  {
+    return nullptr;
+  }
+  value = static_cast<T>(parsed);
+  return first + consumed;
+}
+
+VTK_ABI_NAMESPACE_END
+
+#endif
@@ -16,6 +16,12 @@
  * should be implemented with this in mind to provide a predictable
  * compressor interface for vtkDataCompressor users.
  *
+ * @par Note:
+ * The VTK XML writers and readers call CompressBuffer and UncompressBuffer
+ * concurrently from several threads on the same compressor, unless their
+ * SequentialProcessing option is on.  Subclasses should not modify their
+ * state in these methods.
+ *
  * @par Thanks:
  * Homogeneous CompressionLevel behavior contributed by Quincy Wofford
  * (qwofford@lanl.gov) and John Patchett (patchett@lanl.gov)
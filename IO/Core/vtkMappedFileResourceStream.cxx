@@ -0,0 +1,292 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkMappedFileResourceStream.h"
+
+#include "vtkDataArray.h"
+#include "vtkObjectFactory.h"
+
+#include <algorithm> // std::min
+#include <cstring>   // std::memcpy
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef _WIN32
+#include <vtksys/Encoding.hxx>
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+VTK_ABI_NAMESPACE_BEGIN
+
+vtkStandardNewMacro(vtkMappedFileResourceStream);
+
+//------------------------------------------------------------------------------
+// A private, copy-on-write mapping of a whole file.
+struct vtkMappedFileResourceStream::vtkMapping
+{
+  unsigned char* Data = nullptr;
+  std::size_t Size = 0;
+
+  vtkMapping() = default;
+  vtkMapping(const vtkMapping&) = delete;
+  vtkMapping& operator=(const vtkMapping&) = delete;
+
+  ~vtkMapping()
+  {
+    if (this->Data)
+    {
+#ifdef _WIN32
+      ::UnmapViewOfFile(this->Data);
+#else
+      ::munmap(this->Data, this->Size);
+#endif
+    }
+  }
+
+  // Return false if the file cannot be opened or mapped.
+  bool Map(const char* path)
+  {
+#ifdef _WIN32
+    const std::wstring wpath = vtksys::Encoding::ToWindowsExtendedPath(path);
+    HANDLE file = ::CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      return false;
+    }
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size))
+    {
+      ::CloseHandle(file);
+      return false;
+    }
+    this->Size = static_cast<std::size_t>(size.QuadPart);
+    if (this->Size > 0)
+    {
+      // The view keeps the file mapping alive after its handle is closed.
+      HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+      if (mapping)
+      {
+        this->Data = static_cast<unsigned char*>(::MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+        ::CloseHandle(mapping);
+      }
+    }
+    ::CloseHandle(file);
+#else
+    int file = ::open(path, O_RDONLY);
+    if (file < 0)
+    {
+      return false;
+    }
+    struct stat status;
+    if (::fstat(file, &status) != 0)
+    {
+      ::close(file);
+      return false;
+    }
+    this->Size = static_cast<std::size_t>(status.st_size);
+    if (this->Size > 0)
+    {
+      void* data = ::mmap(nullptr, this->Size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+      this->Data = data == MAP_FAILED ? nullptr : static_cast<unsigned char*>(data);
+    }
+    ::close(file);
+#endif
+    return this->Size == 0 || this->Data != nullptr;
+  }
+};
+
+namespace
+{
+// Mappings used by data arrays, by region address. Arrays only call a free
+// function with the address of their storage, so this keeps the mappings
+// alive until the last array using them releases its storage.
+struct vtkMappedRegions
+{
+  std::mutex Mutex;
+  std::map<void*, std::vector<std::shared_ptr<void>>> Regions;
+};
+
+vtkMappedRegions& GetMappedRegions()
+{
+  // Never destroyed: arrays may be freed during static destruction.
+  static vtkMappedRegions* regions = new vtkMappedRegions;
+  return *regions;
+}
+
+void ReleaseMappedRegion(void* region)
+{
+  std::shared_ptr<void> mapping; // unmapped outside of the lock, if last user
+  vtkMappedRegions& regions = GetMappedRegions();
+  std::lock_guard<std::mutex> lock(regions.Mutex);
+  auto iter = regions.Regions.find(region);
+  if (iter != regions.Regions.end())
+  {
+    mapping = std::move(iter->second.back());
+    iter->second.pop_back();
+    if (iter->second.empty())
+    {
+      regions.Regions.erase(iter);
+    }
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+vtkMappedFileResourceStream::vtkMappedFileResourceStream()
+  : vtkResourceStream{ true }
+{
+}
+
+//------------------------------------------------------------------------------
+vtkMappedFileResourceStream::~vtkMappedFileResourceStream() = default;
+
+//------------------------------------------------------------------------------
+bool vtkMappedFileResourceStream::Open(VTK_FILEPATH const char* path)
+{
+  this->Mapping.reset();
+  this->Pos = 0;
+  this->Eos = true;
+
+  if (path)
+  {
+    auto mapping = std::make_shared<vtkMapping>();
+    if (mapping->Map(path))
+    {
+      this->Mapping = std::move(mapping);
+      this->Eos = false;
+    }
+  }
+
+  this->Modified();
+  return this->Mapping != nullptr;
+}
+
+//------------------------------------------------------------------------------
+std::size_t vtkMappedFileResourceStream::Read(void* buffer, std::size_t bytes)
+{
+  if (bytes == 0 || !this->Mapping)
+  {
+    return 0;
+  }
+
+  const auto sbytes = static_cast<vtkTypeInt64>(bytes);
+  const auto ssize = static_cast<vtkTypeInt64>(this->Mapping->Size);
+  const auto read = this->Pos < 0 ? 0 : std::min(sbytes, ssize - this->Pos);
+
+  if (read <= 0)
+  {
+    this->Eos = true;
+    return 0;
+  }
+
+  std::memcpy(buffer, this->Mapping->Data + this->Pos, static_cast<std::size_t>(read));
+  this->Pos += read;
+  this->Eos = read != sbytes;
+
+  return read;
+}
+
+//------------------------------------------------------------------------------
+bool vtkMappedFileResourceStream::EndOfStream()
+{
+  return this->Eos;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeInt64 vtkMappedFileResourceStream::Seek(vtkTypeInt64 pos, SeekDirection dir)
+{
+  if (!this->Mapping)
+  {
+    return -1;
+  }
+
+  if (dir == SeekDirection::Begin)
+  {
+    this->Pos = pos;
+  }
+  else if (dir == SeekDirection::Current)
+  {
+    this->Pos += pos;
+  }
+  else
+  {
+    this->Pos = static_cast<vtkTypeInt64>(this->Mapping->Size) + pos;
+  }
+
+  this->Eos = false;
+  return this->Pos;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeInt64 vtkMappedFileResourceStream::Tell()
+{
+  return this->Pos;
+}
+
+//------------------------------------------------------------------------------
+const void* vtkMappedFileResourceStream::GetData() const
+{
+  return this->Mapping ? this->Mapping->Data : nullptr;
+}
+
+//------------------------------------------------------------------------------
+std::size_t vtkMappedFileResourceStream::GetSize() const
+{
+  return this->Mapping ? this->Mapping->Size : 0;
+}
+
+//------------------------------------------------------------------------------
+bool vtkMappedFileResourceStream::MapIntoArray(
+  vtkDataArray* array, vtkTypeInt64 offset, vtkIdType numberOfTuples)
+{
+  if (!this->Mapping || !array || !array->HasStandardMemoryLayout() || offset < 0 ||
+    numberOfTuples < 0)
+  {
+    return false;
+  }
+
+  const vtkIdType numberOfValues = numberOfTuples * array->GetNumberOfComponents();
+  const int valueSize = array->GetDataTypeSize();
+  const vtkTypeInt64 size = static_cast<vtkTypeInt64>(numberOfValues) * valueSize;
+  if (valueSize <= 0 || offset % valueSize != 0 ||
+    offset + size > static_cast<vtkTypeInt64>(this->Mapping->Size))
+  {
+    return false;
+  }
+  if (numberOfValues == 0)
+  {
+    array->SetNumberOfTuples(0);
+    return true;
+  }
+
+  void* region = this->Mapping->Data + offset;
+  {
+    vtkMappedRegions& regions = GetMappedRegions();
+    std::lock_guard<std::mutex> lock(regions.Mutex);
+    regions.Regions[region].push_back(this->Mapping);
+  }
+  array->SetVoidArray(region, numberOfValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+  array->SetArrayFreeFunction(&ReleaseMappedRegion);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkMappedFileResourceStream::PrintSelf(ostream& os, vtkIndent indent)
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Mapped: " << (this->Mapping ? "yes" : "no") << "\n";
+  os << indent << "Size: " << this->GetSize() << "\n";
+  os << indent << "Position: " << this->Pos << "\n";
+}
+
+VTK_ABI_NAMESPACE_END
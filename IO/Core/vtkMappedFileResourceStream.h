@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#ifndef vtkMappedFileResourceStream_h
+#define vtkMappedFileResourceStream_h
+
+#include "vtkIOCoreModule.h" // For export macro
+#include "vtkResourceStream.h"
+
+#include <memory> // for std::shared_ptr
+
+VTK_ABI_NAMESPACE_BEGIN
+
+class vtkDataArray;
+
+/**
+ * @brief vtkResourceStream implementation for memory-mapped file input
+ *
+ * `vtkMappedFileResourceStream` maps a whole file in memory instead of
+ * reading it through buffered calls. Besides the usual stream functions, it
+ * gives access to the mapped bytes, and it can hand regions of the file to
+ * data arrays as their storage, so that readers of raw binary data do not
+ * need to allocate and copy. The pages of the file are then loaded when they
+ * are first accessed.
+ *
+ * The mapping is private: the arrays can be modified, the modified pages are
+ * copied and the file is never written to.
+ */
+class VTKIOCORE_EXPORT vtkMappedFileResourceStream : public vtkResourceStream
+{
+public:
+  vtkTypeMacro(vtkMappedFileResourceStream, vtkResourceStream);
+  static vtkMappedFileResourceStream* New();
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * @brief Map a file
+   *
+   * Mapping a file resets the stream to initial position: Tell() = 0.
+   * EndOfStream is set to true if the mapping failed.
+   * If path is nullptr, the current file is only unmapped. Regions handed to
+   * data arrays stay valid until the arrays release them.
+   * This function will increase modified time.
+   *
+   * @param path the file path
+   * @return true if the file was successfully mapped, false otherwise.
+   * Return false if path is nullptr.
+   */
+  bool Open(VTK_FILEPATH const char* path);
+
+  ///@{
+  /**
+   * @brief Override vtkResourceStream functions
+   */
+  std::size_t Read(void* buffer, std::size_t bytes) override;
+  bool EndOfStream() override;
+  vtkTypeInt64 Seek(vtkTypeInt64 pos, SeekDirection dir) override;
+  vtkTypeInt64 Tell() override;
+  ///@}
+
+  /**
+   * Get a pointer to the mapped file content, nullptr if no file is mapped
+   * or if the file is empty.
+   */
+  const void* GetData() const;
+
+  /**
+   * Get the size of the mapped file in bytes.
+   */
+  std::size_t GetSize() const;
+
+  /**
+   * @brief Use a region of the mapped file as the storage of `array`.
+   *
+   * The region starts at byte `offset` and holds `numberOfTuples` tuples
+   * of `array`, whose value type and number of components must be set. The
+   * values are used as is: the file must be in the native byte order. The
+   * region must be inside the file, and `offset` must be a multiple of the
+   * size of the array values. `array` must have the standard memory layout,
+   * like vtkAOSDataArrayTemplate.
+   *
+   * The mapping is kept alive until `array` frees or reallocates its
+   * storage, even if this stream is closed or deleted.
+   *
+   * @return true on success, false otherwise, in which case `array` is not
+   * modified.
+   */
+  bool MapIntoArray(vtkDataArray* array, vtkTypeInt64 offset, vtkIdType numberOfTuples);
+
+protected:
+  vtkMappedFileResourceStream();
+  ~vtkMappedFileResourceStream() override;
+  vtkMappedFileResourceStream(const vtkMappedFileResourceStream&) = delete;
+  vtkMappedFileResourceStream& operator=(const vtkMappedFileResourceStream&) = delete;
+
+private:
+  struct vtkMapping;
+
+  std::shared_ptr<vtkMapping> Mapping;
+  vtkTypeInt64 Pos = 0;
+  bool Eos = true;
+};
+
+VTK_ABI_NAMESPACE_END
+
+#endif
@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that reading the time steps of binary and ascii EnSight Gold cases
+// again, when the offsets of the variables are known, gives the same output
+// as a new reader, and that the known offsets and the concurrent parsing of
+// ascii values are used.
+
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkEnSightGoldBinaryReader.h"
+#include "vtkEnSightGoldReader.h"
+#include "vtkGenericEnSightReader.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <string>
+
+namespace
+{
+bool TestTimeSteps(const std::string& fileName)
+{
+  vtkNew<vtkGenericEnSightReader> reader;
+  reader->SetCaseFileName(fileName.c_str());
+
+  for (double time : { 1.0, 0.0, 1.0, 0.0 })
+  {
+    vtkNew<vtkGenericEnSightReader> expected;
+    expected->SetCaseFileName(fileName.c_str());
+    expected->SetTimeValue(time);
+    expected->Update();
+
+    reader->SetTimeValue(time);
+    reader->Update();
+    if (!vtkTestUtilities::CompareDataObjects(expected->GetOutput(), reader->GetOutput()))
+    {
+      vtkLog(ERROR, "Wrong output for time " << time << " of " << fileName);
+      return false;
+    }
+  }
+
+  // The last two time steps were read before: the values of their variables
+  // must have been read from the known offsets.
+  auto binaryReader = vtkEnSightGoldBinaryReader::SafeDownCast(reader->GetReader());
+  if (binaryReader && binaryReader->GetNumberOfVariableOffsetsCacheHits() == 0)
+  {
+    vtkLog(ERROR, "The offsets of the variables were not reused for " << fileName);
+    return false;
+  }
+  return true;
+}
+
+double Value(int node, int step)
+{
+  return 0.5 * node - step;
+}
+
+/**
+ * Write an ascii EnSight Gold case with a part of `count` points and a scalar
+ * per node over two time steps in `directory`. Return the name of the case
+ * file.
+ */
+std::string WriteLargeASCIICase(const std::string& directory, int count)
+{
+  const std::string name = "TestEnSightGoldReaderTimeSteps";
+  const std::string prefix = directory + "/" + name;
+  std::ofstream caseFile(prefix + ".case");
+  caseFile << "FORMAT\ntype: ensight gold\n\nGEOMETRY\nmodel: " << name << ".geo\n\n"
+           << "VARIABLE\nscalar per node: 1 values " << name << "*.scl\n\n"
+           << "TIME\ntime set: 1\nnumber of steps: 2\nfilename start number: 0\n"
+           << "filename increment: 1\ntime values: 0 1\n";
+
+  std::ofstream geometry(prefix + ".geo");
+  geometry << "Large ascii case\npoints\nnode id off\nelement id given\n"
+           << "part\n" << std::setw(10) << 1 << "\npoints\ncoordinates\n"
+           << std::setw(10) << count << "\n";
+  geometry << std::scientific << std::setprecision(5);
+  for (int component = 0; component < 3; ++component)
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      geometry << std::setw(12) << static_cast<double>(component == 0 ? i : i % (component + 6))
+               << "\n";
+    }
+  }
+  // The ids of the elements, then their nodes.
+  geometry << "point\n" << std::setw(10) << count << "\n";
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      geometry << std::setw(10) << i + 1 << "\n";
+    }
+  }
+
+  for (int step = 0; step < 2; ++step)
+  {
+    std::ofstream variable(prefix + std::to_string(step) + ".scl");
+    variable << "values\npart\n" << std::setw(10) << 1 << "\ncoordinates\n";
+    variable << std::scientific << std::setprecision(5);
+    for (int i = 0; i < count; ++i)
+    {
+      variable << std::setw(12) << ::Value(i, step) << "\n";
+    }
+  }
+  return prefix + ".case";
+}
+
+bool TestConcurrentParsing(const std::string& fileName, int count)
+{
+  vtkNew<vtkGenericEnSightReader> reader;
+  reader->SetCaseFileName(fileName.c_str());
+  for (int step : { 1, 0 })
+  {
+    reader->SetTimeValue(step);
+    reader->Update();
+    auto output = vtkDataSet::SafeDownCast(reader->GetOutput()->GetBlock(0));
+    vtkDataArray* values = output ? output->GetPointData()->GetArray("values") : nullptr;
+    if (!values || values->GetNumberOfTuples() != count)
+    {
+      vtkLog(ERROR, "Missing values for time " << step << " of " << fileName);
+      return false;
+    }
+    for (int i = 0; i < count; ++i)
+    {
+      if (values->GetComponent(i, 0) != ::Value(i, step))
+      {
+        vtkLog(ERROR, "Wrong value " << i << " for time " << step << " of " << fileName);
+        return false;
+      }
+    }
+  }
+
+  auto asciiReader = vtkEnSightGoldReader::SafeDownCast(reader->GetReader());
+  if (!asciiReader || asciiReader->GetNumberOfConcurrentlyParsedBlocks() < 2)
+  {
+    vtkLog(ERROR, "The values of " << fileName << " were not parsed concurrently");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestEnSightGoldReaderTimeSteps(int argc, char* argv[])
+{
+  bool success = true;
+  for (const char* name : { "Data/EnSight/blow2_bin.case", "Data/EnSight/blow2_ascii.case" })
+  {
+    char* fileName = vtkTestUtilities::ExpandDataFileName(argc, argv, name);
+    success &= ::TestTimeSteps(fileName);
+    delete[] fileName;
+  }
+
+  // The parts of blow2 are too small to be parsed concurrently.
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const int count = 5000;
+  const std::string largeCase = ::WriteLargeASCIICase(tempDir, count);
+  delete[] tempDir;
+  success &= ::TestTimeSteps(largeCase);
+  success &= ::TestConcurrentParsing(largeCase, count);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -13,6 +13,7 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkStringScanner.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
@@ -24,10 +25,12 @@
 
 #include <algorithm> /* std::remove */
 #include <array>
+#include <atomic>
 #include <cctype>
 #include <map>
 #include <numeric>
 #include <string>
+#include <utility>
 #include <vector>
 
 #define VTK_STAT_STRUCT vtksys::SystemTools::Stat_t
@@ -170,6 +173,148 @@ public:
 
     return nullptr;
   }
+
+  /**
+   * Values of a variable for a part, stored as `NumberOfBlocks` float arrays
+   * of `NumberOfTuples` values starting at `Offset` in the file.
+   */
+  struct VariableSection
+  {
+    vtkSmartPointer<vtkFloatArray> Array;
+    vtkTypeInt64 Offset;
+    vtkIdType NumberOfTuples;
+    int NumberOfBlocks;
+    int Component;
+  };
+
+  /**
+   * Return true if the values following `sectionHeader` are neither "undef"
+   * nor "partial", so that they can be located without reading them.
+   */
+  static bool IsPlainSection(const char* sectionHeader)
+  {
+    vtksys::RegularExpression regEx("^[^ ]+ ([^ ]+)");
+    return !regEx.find(sectionHeader) ||
+      (regEx.match(1) != "undef" && regEx.match(1) != "partial");
+  }
+
+  /**
+   * Create the array of a part, as ReadVariableFloats does, and add the
+   * section of the file at `offset` holding its values to `sections`.
+   * Returns the number of bytes of the section.
+   */
+  static vtkTypeInt64 AddVariableSection(std::vector<VariableSection>& sections,
+    vtkEnSightGoldBinaryReader* self, vtkTypeInt64 offset, const char* description,
+    vtkDataSetAttributes* dsa, vtkIdType numElements, int numComponents, int component)
+  {
+    VariableSection section{ nullptr, offset, numElements, 1, 0 };
+    if (numComponents > 1 && component > 0)
+    {
+      section.Array = vtkFloatArray::SafeDownCast(dsa->GetArray(description));
+      assert(section.Array && section.Array->GetNumberOfComponents() == numComponents);
+      section.Component = component;
+    }
+    else
+    {
+      section.Array = vtk::TakeSmartPointer(vtkFloatArray::New());
+      section.Array->SetNumberOfComponents(numComponents);
+      section.Array->SetNumberOfTuples(numElements);
+      section.NumberOfBlocks = (numComponents > 1 && component == -1) ? numComponents : 1;
+    }
+    sections.push_back(section);
+    return section.NumberOfBlocks *
+      (static_cast<vtkTypeInt64>(sizeof(float)) * numElements + self->FortranSkipBytes);
+  }
+
+  /**
+   * Read the values of the sections concurrently, each thread opening the
+   * file again. Large sections are split so that a few big parts are also
+   * read concurrently.
+   */
+  static bool ReadVariableSections(
+    vtkEnSightGoldBinaryReader* self, const std::vector<VariableSection>& sections)
+  {
+    struct Task
+    {
+      const VariableSection* Section;
+      int Block;
+      vtkIdType FirstTuple;
+      vtkIdType NumberOfTuples;
+    };
+    constexpr vtkIdType maximumTaskSize = 1 << 20;
+    std::vector<Task> tasks;
+    for (const auto& section : sections)
+    {
+      for (int block = 0; block < section.NumberOfBlocks; ++block)
+      {
+        for (vtkIdType first = 0; first < section.NumberOfTuples; first += maximumTaskSize)
+        {
+          tasks.push_back(Task{ &section, block, first,
+            std::min(maximumTaskSize, section.NumberOfTuples - first) });
+        }
+      }
+    }
+    if (tasks.empty())
+    {
+      return true;
+    }
+
+    const std::string& fileName = self->GoldFileName;
+    const vtkTypeInt64 headerSize = self->Fortran ? 4 : 0;
+    const bool littleEndian = self->ByteOrder == FILE_LITTLE_ENDIAN;
+    std::atomic<bool> valid(true);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()),
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        vtksys::ifstream file(fileName.c_str(), ios::in | ios::binary);
+        std::vector<float> buffer;
+        for (vtkIdType i = begin; i < end && valid; ++i)
+        {
+          const Task& task = tasks[i];
+          const VariableSection& section = *task.Section;
+          const vtkTypeInt64 blockSize =
+            static_cast<vtkTypeInt64>(sizeof(float)) * section.NumberOfTuples +
+            self->FortranSkipBytes;
+          file.seekg(section.Offset + task.Block * blockSize + headerSize +
+              static_cast<vtkTypeInt64>(sizeof(float)) * task.FirstTuple,
+            ios::beg);
+
+          const int numComponents = section.Array->GetNumberOfComponents();
+          float* values = numComponents == 1 ? section.Array->GetPointer(task.FirstTuple) : nullptr;
+          if (!values)
+          {
+            buffer.resize(task.NumberOfTuples);
+            values = buffer.data();
+          }
+          if (!file.read(reinterpret_cast<char*>(values), sizeof(float) * task.NumberOfTuples))
+          {
+            valid = false;
+            return;
+          }
+          if (littleEndian)
+          {
+            vtkByteSwap::Swap4LERange(values, task.NumberOfTuples);
+          }
+          else
+          {
+            vtkByteSwap::Swap4BERange(values, task.NumberOfTuples);
+          }
+
+          if (numComponents > 1)
+          {
+            const int component = section.NumberOfBlocks > 1
+              ? vtkUtilities::GetDestinationComponent(task.Block, numComponents)
+              : section.Component;
+            float* tuples = section.Array->GetPointer(task.FirstTuple * numComponents);
+            for (vtkIdType j = 0; j < task.NumberOfTuples; ++j)
+            {
+              tuples[j * numComponents + component] = values[j];
+            }
+          }
+        }
+      });
+    return valid;
+  }
 };
 
 vtkStandardNewMacro(vtkEnSightGoldBinaryReader);
@@ -185,6 +330,29 @@ public:
   std::map<MapKey, MapValue> Map;
 };
 
+class vtkEnSightGoldBinaryReader::VariableOffsetMapInternal
+{
+public:
+  // Offset of the values of a part, -1 if there are none.
+  struct PartOffset
+  {
+    int PartId;
+    vtkIdType NumberOfElements;
+    vtkTypeInt64 Offset;
+  };
+
+  // The parts of a time step, valid while the file is not modified.
+  struct TimeStepOffsets
+  {
+    vtkTypeUInt64 FileSize;
+    long ModifiedTime;
+    std::vector<PartOffset> Parts;
+  };
+
+  // Key is the file name and the offset of the time step in the file.
+  std::map<std::pair<std::string, vtkTypeInt64>, TimeStepOffsets> Map;
+};
+
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
 
@@ -192,6 +360,7 @@ public:
 vtkEnSightGoldBinaryReader::vtkEnSightGoldBinaryReader()
 {
   this->FileOffsets = new vtkEnSightGoldBinaryReader::FileOffsetMapInternal;
+  this->VariableOffsets = new vtkEnSightGoldBinaryReader::VariableOffsetMapInternal;
 
   this->GoldIFile = nullptr;
   this->FileSize = 0;
@@ -206,6 +375,7 @@ vtkEnSightGoldBinaryReader::vtkEnSightGoldBinaryReader()
 vtkEnSightGoldBinaryReader::~vtkEnSightGoldBinaryReader()
 {
   delete this->FileOffsets;
+  delete this->VariableOffsets;
   delete this->GoldIFile;
   this->GoldIFile = nullptr;
 }
@@ -235,6 +405,7 @@ int vtkEnSightGoldBinaryReader::OpenFile(const char* filename)
     mode |= ios::binary;
 #endif
     this->GoldIFile = new vtksys::ifstream(filename, mode);
+    this->GoldFileName = filename;
   }
   else
   {
@@ -1576,6 +1747,70 @@ bool vtkEnSightGoldBinaryReader::ReadVariableArray(const char* description,
   vtkMultiBlockDataSet* compositeOutput, int attributeType, int numComponents,
   int component /*=-1*/)
 {
+  using PartOffset = VariableOffsetMapInternal::PartOffset;
+  std::vector<vtkUtilities::VariableSection> sections;
+
+  auto addArray = [&](vtkDataSetAttributes* dsa, vtkFloatArray* array)
+  {
+    array->SetName(description);
+    dsa->AddArray(array);
+    if (numComponents == 1 && dsa->GetScalars() == nullptr)
+    {
+      dsa->SetScalars(array);
+    }
+    else if (numComponents == 3 && dsa->GetVectors() == nullptr)
+    {
+      dsa->SetVectors(array);
+    }
+  };
+
+  auto readSections = [&]()
+  {
+    if (!vtkUtilities::ReadVariableSections(this, sections))
+    {
+      vtkErrorMacro("Read failed");
+      return false;
+    }
+    return true;
+  };
+
+  // When this time step was read before, and the parts did not change, the
+  // values are read from their known offsets.
+  const auto key = std::make_pair(
+    this->GoldFileName, static_cast<vtkTypeInt64>(this->GoldIFile->tellg()));
+  const long modifiedTime = vtksys::SystemTools::ModifiedTime(this->GoldFileName);
+  auto cached = this->VariableOffsets->Map.find(key);
+  if (cached != this->VariableOffsets->Map.end())
+  {
+    bool sameParts = cached->second.FileSize == this->FileSize &&
+      cached->second.ModifiedTime == modifiedTime;
+    for (auto part = cached->second.Parts.begin(); sameParts && part != cached->second.Parts.end();
+         ++part)
+    {
+      const int realId = this->InsertNewPartId(part->PartId);
+      auto output = this->GetDataSetFromBlock(compositeOutput, realId);
+      sameParts = output->GetNumberOfElements(attributeType) == part->NumberOfElements;
+    }
+    if (sameParts)
+    {
+      ++this->NumberOfVariableOffsetsCacheHits;
+      for (const PartOffset& part : cached->second.Parts)
+      {
+        if (part.Offset >= 0)
+        {
+          const int realId = this->InsertNewPartId(part.PartId);
+          auto output = this->GetDataSetFromBlock(compositeOutput, realId);
+          auto dsa = output->GetAttributes(attributeType);
+          vtkUtilities::AddVariableSection(sections, this, part.Offset, description, dsa,
+            part.NumberOfElements, numComponents, component);
+          addArray(dsa, sections.back().Array);
+        }
+      }
+      return readSections();
+    }
+    this->VariableOffsets->Map.erase(cached);
+  }
+
   char line[80];
 
   // read description.
@@ -1587,6 +1822,11 @@ bool vtkEnSightGoldBinaryReader::ReadVariableArray(const char* description,
     return this->GoldIFile->eof() ? 0 : this->ReadLine(line);
   };
 
+  // The offsets are only kept when all the values can be located without
+  // reading them.
+  std::vector<PartOffset> partOffsets;
+  bool cacheOffsets = true;
+
   int lineRead = this->ReadLine(line); // "part".
   while (lineRead && strncmp(line, "part", 4) == 0)
   {
@@ -1601,6 +1841,7 @@ bool vtkEnSightGoldBinaryReader::ReadVariableArray(const char* description,
     // If the part has zero elements, it may or may not be followed by this section
     // identifier.
     const auto numElements = output->GetNumberOfElements(attributeType);
+    partOffsets.push_back(PartOffset{ partId, numElements, -1 });
 
     lineRead = this->ReadLine(line); // "coordinates", "block", "element" or next "part"
     if (lineRead && strncmp(line, "part", 4) == 0)
@@ -1624,15 +1865,30 @@ bool vtkEnSightGoldBinaryReader::ReadVariableArray(const char* description,
     // type]" in which case the data is read in chunks rather than a whole.
     if (attributeType != vtkDataObject::CELL || strncmp(line, "block", 5) == 0)
     {
-      // read full data.
-      array = vtkUtilities::ReadVariableFloats(
-        line, this, description, dsa, numElements, numComponents, component);
+      if (vtkUtilities::IsPlainSection(line))
+      {
+        // locate the data, it is read concurrently with the other parts.
+        const vtkTypeInt64 offset = this->GoldIFile->tellg();
+        const vtkTypeInt64 size = vtkUtilities::AddVariableSection(
+          sections, this, offset, description, dsa, numElements, numComponents, component);
+        array = sections.back().Array;
+        partOffsets.back().Offset = offset;
+        this->GoldIFile->seekg(offset + size, ios::beg);
+      }
+      else
+      {
+        // read full data.
+        array = vtkUtilities::ReadVariableFloats(
+          line, this, description, dsa, numElements, numComponents, component);
+        cacheOffsets = false;
+      }
 
       lineRead = advance();
     }
     else
     {
       // okay, we are reading in chunks per element type.
+      cacheOffsets = false;
 
       // lets allocate (or get) target array.
       if (component <= 0)
@@ -1674,20 +1930,15 @@ bool vtkEnSightGoldBinaryReader::ReadVariableArray(const char* description,
 
     if (array)
     {
-      array->SetName(description);
-      dsa->AddArray(array);
-      if (numComponents == 1 && dsa->GetScalars() == nullptr)
-      {
-        dsa->SetScalars(array);
-      }
-      else if (numComponents == 3 && dsa->GetVectors() == nullptr)
-      {
-        dsa->SetVectors(array);
-      }
+      addArray(dsa, array);
     }
   }
 
-  return true;
+  if (cacheOffsets)
+  {
+    this->VariableOffsets->Map[key] = { this->FileSize, modifiedTime, std::move(partOffsets) };
+  }
+  return readSections();
 }
 
 //------------------------------------------------------------------------------
@@ -3511,6 +3762,8 @@ int vtkEnSightGoldBinaryReader::ReadFloatArray(float* result, vtkIdType numFloat
 void vtkEnSightGoldBinaryReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfVariableOffsetsCacheHits: " << this->NumberOfVariableOffsetsCacheHits
+     << endl;
 }
 
 // Seeks the IFile to the cached timestep nearest the target timestep.
@@ -14,6 +14,10 @@
  * array of real values) and _i (for the array if imaginary values).  Complex
  * scalar variables are stored as a single array with 2 components, real and
  * imaginary, listed in that order.
+ *
+ * The values of the variables are read concurrently with vtkSMPTools, each
+ * thread using its own handle on the file. The location of the values of each
+ * part is kept, so that reading a time step again does not scan the file.
  * @warning
  * You must manually call Update on this reader and then connect the rest
  * of the pipeline because (due to the nature of the file format) it is
@@ -31,6 +35,8 @@
 #include "vtkEnSightReader.h"
 #include "vtkIOEnSightModule.h" // For export macro
 
+#include <string> // For std::string
+
 VTK_ABI_NAMESPACE_BEGIN
 class vtkMultiBlockDataSet;
 
@@ -41,6 +47,13 @@ public:
   vtkTypeMacro(vtkEnSightGoldBinaryReader, vtkEnSightReader);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  /**
+   * Get the number of variable arrays read from the offsets of their parts
+   * kept from a previous read of the same time step, without scanning the
+   * file, since the reader was created.
+   */
+  vtkGetMacro(NumberOfVariableOffsetsCacheHits, vtkIdType);
+
 protected:
   vtkEnSightGoldBinaryReader();
   ~vtkEnSightGoldBinaryReader() override;
@@ -232,12 +245,20 @@ protected:
   int FortranSkipBytes; // Number of bytes to skip when seeking within a fortran-written file
 
   istream* GoldIFile;
+  // The name of the opened file, to read it from several threads.
+  std::string GoldFileName;
   // The size of the file could be used to choose byte order.
   vtkTypeUInt64 FileSize;
 
   class FileOffsetMapInternal;
   FileOffsetMapInternal* FileOffsets;
 
+  // Offsets of the values of each part in the variable files, by file and
+  // time step, so that a time step is read again without scanning the file.
+  class VariableOffsetMapInternal;
+  VariableOffsetMapInternal* VariableOffsets;
+  vtkIdType NumberOfVariableOffsetsCacheHits = 0;
+
 private:
   int SizeOfInt;
   vtkEnSightGoldBinaryReader(const vtkEnSightGoldBinaryReader&) = delete;
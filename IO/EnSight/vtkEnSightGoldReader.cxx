@@ -4,6 +4,7 @@
 
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
+#include "vtkChunkedTextParser.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkImageData.h"
@@ -20,6 +21,7 @@
 #include "vtksys/FStream.hxx"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <map>
 #include <numeric>
@@ -36,6 +38,50 @@ public:
   std::map<std::string, std::map<int, long>> Map;
 };
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Read `count` values, one per line, parsing the lines concurrently. Returns
+// false, leaving the stream where it was, if a line does not hold exactly one
+// value, so that the caller can read them line by line instead.
+bool vtkEnSightGoldReaderReadValues(istream* is, vtkIdType count, std::vector<float>& values)
+{
+  const std::streampos start = is->tellg();
+  if (count < 1024 || start < 0)
+  {
+    return false;
+  }
+
+  vtkNew<vtkChunkedTextParser> parser;
+  std::atomic<bool> valid(parser->Read(*is, vtkChunkedTextParser::Unit::Line, count) == count);
+  if (valid)
+  {
+    values.resize(count);
+    parser->ForEachChunk(
+      [&](std::size_t, const char* begin, const char* end, vtkIdType line)
+      {
+        vtkChunkedTextParser::ForEachLine(begin, end,
+          [&](const char* first, const char* last)
+          {
+            const char* next = vtkChunkedTextParser::ParseValue(first, last, values[line++]);
+            if (!next || vtkChunkedTextParser::SkipWhitespace(next, last) != last)
+            {
+              valid = false;
+            }
+          });
+      });
+  }
+
+  is->clear();
+  is->seekg(start);
+  if (valid)
+  {
+    is->ignore(static_cast<std::streamsize>(parser->GetEnd()));
+  }
+  return valid;
+}
+}
+
 class vtkEnSightGoldReader::UndefPartialHelper
 {
   bool HasUndef = false;
@@ -115,10 +161,21 @@ public:
     else
     {
       const auto undefValue = std::nanf("1");
-      for (vtkIdType cc = 0, max = array->GetNumberOfTuples(); cc < max; ++cc)
+      const vtkIdType max = array->GetNumberOfTuples();
+      std::vector<float> values;
+      const bool read = ::vtkEnSightGoldReaderReadValues(self->IS, max, values);
+      if (read)
       {
-        self->ReadNextDataLine(line);
-        const double val = vtk::scan_value<float>(std::string_view(line))->value();
+        ++self->NumberOfConcurrentlyParsedBlocks;
+      }
+      for (vtkIdType cc = 0; cc < max; ++cc)
+      {
+        if (!read)
+        {
+          self->ReadNextDataLine(line);
+        }
+        const double val =
+          read ? values[cc] : vtk::scan_value<float>(std::string_view(line))->value();
         if (this->HasUndef && val == this->Undef)
         {
           array->InsertComponent(cc, component, undefValue);
@@ -2734,5 +2791,7 @@ int vtkEnSightGoldReader::CreateImageDataOutput(
 void vtkEnSightGoldReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfConcurrentlyParsedBlocks: " << this->NumberOfConcurrentlyParsedBlocks
+     << endl;
 }
 VTK_ABI_NAMESPACE_END
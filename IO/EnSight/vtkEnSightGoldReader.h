@@ -41,6 +41,13 @@ public:
   vtkTypeMacro(vtkEnSightGoldReader, vtkEnSightReader);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  /**
+   * Get the number of blocks of variable values parsed concurrently since the
+   * reader was created. Blocks of fewer than 1024 values, or not written one
+   * value per line, are parsed serially and are not counted.
+   */
+  vtkGetMacro(NumberOfConcurrentlyParsedBlocks, vtkIdType);
+
 protected:
   vtkEnSightGoldReader();
   ~vtkEnSightGoldReader() override;
@@ -151,6 +158,8 @@ protected:
   class FileOffsetMapInternal;
   FileOffsetMapInternal* FileOffsets;
 
+  vtkIdType NumberOfConcurrentlyParsedBlocks = 0;
+
 private:
   vtkEnSightGoldReader(const vtkEnSightGoldReader&) = delete;
   void operator=(const vtkEnSightGoldReader&) = delete;
@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that readers of the same file share their arrays through the shared
+// cache, and that prefetching the next time step gives the same output.
+
+#include "vtkExodusIICache.h"
+#include "vtkExodusIIReader.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+void SetUp(vtkExodusIIReader* reader, const std::string& fileName)
+{
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateInformation();
+  reader->SetAllArrayStatus(vtkExodusIIReader::NODAL, 1);
+  reader->SetAllArrayStatus(vtkExodusIIReader::ELEM_BLOCK, 1);
+  reader->SetAllArrayStatus(vtkExodusIIReader::GLOBAL, 1);
+}
+
+bool Compare(vtkExodusIIReader* expected, vtkExodusIIReader* reader, int step)
+{
+  expected->SetTimeStep(step);
+  expected->Update();
+  reader->SetTimeStep(step);
+  reader->Update();
+  if (!vtkTestUtilities::CompareDataObjects(expected->GetOutput(), reader->GetOutput()))
+  {
+    std::cerr << "Wrong output for time step " << step << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestExodusSharedCache(int argc, char* argv[])
+{
+  char* fname = vtkTestUtilities::ExpandDataFileName(argc, argv, "Data/can.ex2");
+  const std::string fileName = fname;
+  delete[] fname;
+
+  vtkExodusIICache* sharedCache = vtkExodusIICache::GetSharedCache();
+  sharedCache->SetCacheCapacity(64.);
+  sharedCache->Clear();
+  sharedCache->ResetStatistics();
+
+  vtkNew<vtkExodusIIReader> expected;
+  SetUp(expected, fileName);
+
+  vtkNew<vtkExodusIIReader> first;
+  first->UseSharedCacheOn();
+  SetUp(first, fileName);
+  if (!Compare(expected, first, 3))
+  {
+    return EXIT_FAILURE;
+  }
+  if (sharedCache->GetNumberOfHits() != 0 || sharedCache->GetNumberOfMisses() == 0)
+  {
+    std::cerr << "The first read must only miss the shared cache" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A second reader of the same file reads the arrays from the shared cache.
+  vtkNew<vtkExodusIIReader> second;
+  second->UseSharedCacheOn();
+  SetUp(second, fileName);
+  sharedCache->ResetStatistics();
+  if (!Compare(expected, second, 3))
+  {
+    return EXIT_FAILURE;
+  }
+  if (sharedCache->GetNumberOfHits() == 0 || sharedCache->GetNumberOfMisses() != 0)
+  {
+    std::cerr << "The second reader must only hit the shared cache, got "
+              << sharedCache->GetNumberOfHits() << " hits and "
+              << sharedCache->GetNumberOfMisses() << " misses" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Once a time step is read, the next one is read in the background.
+  first->PrefetchNextTimeStepOn();
+  for (int step : { 10, 11, 12, 43, 0 })
+  {
+    sharedCache->ResetStatistics();
+    if (!Compare(expected, first, step))
+    {
+      return EXIT_FAILURE;
+    }
+    if (step == 11 || step == 12)
+    {
+      if (sharedCache->GetNumberOfMisses() != 0)
+      {
+        std::cerr << "Time step " << step << " was not prefetched" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // The other reader also benefits from the prefetched time step.
+  sharedCache->ResetStatistics();
+  if (!Compare(expected, second, 1) || sharedCache->GetNumberOfMisses() != 0)
+  {
+    std::cerr << "Time step 1 was not shared" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The output does not depend on the shared cache capacity.
+  sharedCache->SetCacheCapacity(0.);
+  if (!Compare(expected, second, 20) || !Compare(expected, first, 21))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -5,14 +5,17 @@
 #include "vtkDataArray.h"
 #include "vtkObjectFactory.h"
 
+#include <vtksys/SystemTools.hxx>
+
 #include <iostream>
+#include <utility>
 
 // Define VTK_EXO_DBG_CACHE to print cache adds, drops, and replacements.
 // #undef VTK_EXO_DBG_CACHE
 
 #define VTK_EXO_PRT_KEY(ckey)                                                                      \
-  "(" << (ckey).Time << ", " << (ckey).ObjectType << ", " << (ckey).ObjectId << ", "               \
-      << (ckey).ArrayId << ")"
+  "(" << (ckey).FileId << ", " << (ckey).Time << ", " << (ckey).ObjectType << ", "                 \
+      << (ckey).ObjectId << ", " << (ckey).ArrayId << ")"
 #define VTK_EXO_PRT_ARR(cval)                                                                      \
   " [" << (cval) << "," << ((cval) ? (cval)->GetActualMemorySize() / 1024. : 0.) << "/"            \
        << this->Size << "/" << this->Capacity << "]"
@@ -89,34 +92,49 @@ vtkExodusIICache::~vtkExodusIICache()
 
 void vtkExodusIICache::PrintSelf(ostream& os, vtkIndent indent)
 {
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Capacity: " << this->Capacity << " MiB\n";
   os << indent << "Size: " << this->Size << " MiB\n";
   os << indent << "Cache: " << &this->Cache << " (" << this->Cache.size() << ")\n";
   os << indent << "LRU: " << &this->LRU << "\n";
+  os << indent << "NumberOfHits: " << this->NumberOfHits << "\n";
+  os << indent << "NumberOfMisses: " << this->NumberOfMisses << "\n";
+  os << indent << "NumberOfEvictions: " << this->NumberOfEvictions << "\n";
 }
 
 void vtkExodusIICache::Clear()
 {
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
   // printCache( this->Cache, this->LRU );
   this->ReduceToSize(0.);
 }
 
 void vtkExodusIICache::SetCacheCapacity(double sizeInMiB)
 {
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
   if (sizeInMiB == this->Capacity)
     return;
 
   if (this->Size > sizeInMiB)
   {
+    const std::size_t numberOfEntries = this->Cache.size();
     this->ReduceToSize(sizeInMiB);
+    this->NumberOfEvictions += static_cast<vtkIdType>(numberOfEntries - this->Cache.size());
   }
 
   this->Capacity = sizeInMiB < 0 ? 0 : sizeInMiB;
 }
 
+double vtkExodusIICache::GetSpaceLeft()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
+  return this->Capacity - this->Size;
+}
+
 int vtkExodusIICache::ReduceToSize(double newSize)
 {
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
   int deletedSomething = 0;
   while (this->Size > newSize && !this->LRU.empty())
   {
@@ -160,6 +178,8 @@ int vtkExodusIICache::ReduceToSize(double newSize)
 
 void vtkExodusIICache::Insert(vtkExodusIICacheKey& key, vtkDataArray* value)
 {
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
+  const std::size_t numberOfEntries = this->Cache.size();
   double vsize = value ? value->GetActualMemorySize() / 1024. : 0.;
 
   vtkExodusIICacheRef it = this->Cache.find(key);
@@ -197,28 +217,48 @@ void vtkExodusIICache::Insert(vtkExodusIICacheKey& key, vtkDataArray* value)
     std::cout << "Adding " << VTK_EXO_PRT_KEY(key) << VTK_EXO_PRT_ARR(value) << "\n";
 #endif // VTK_EXO_DBG_CACHE
     iret.first->second->LRUEntry = this->LRU.insert(this->LRU.begin(), iret.first);
+    if (this->Cache.size() <= numberOfEntries)
+    {
+      this->NumberOfEvictions += static_cast<vtkIdType>(numberOfEntries + 1 - this->Cache.size());
+    }
   }
   // printCache( this->Cache, this->LRU );
 }
 
 vtkDataArray*& vtkExodusIICache::Find(const vtkExodusIICacheKey& key)
 {
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
   static vtkDataArray* dummy = nullptr;
 
   vtkExodusIICacheRef it = this->Cache.find(key);
   if (it != this->Cache.end())
   {
+    ++this->NumberOfHits;
     this->LRU.erase(it->second->LRUEntry);
     it->second->LRUEntry = this->LRU.insert(this->LRU.begin(), it);
     return it->second->Value;
   }
 
+  ++this->NumberOfMisses;
   dummy = nullptr;
   return dummy;
 }
 
+vtkSmartPointer<vtkDataArray> vtkExodusIICache::Lookup(const vtkExodusIICacheKey& key)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
+  return this->Find(key);
+}
+
+bool vtkExodusIICache::Contains(const vtkExodusIICacheKey& key)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
+  return this->Cache.find(key) != this->Cache.end();
+}
+
 int vtkExodusIICache::Invalidate(const vtkExodusIICacheKey& key)
 {
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
   vtkExodusIICacheRef it = this->Cache.find(key);
   if (it != this->Cache.end())
   {
@@ -249,6 +289,7 @@ int vtkExodusIICache::Invalidate(const vtkExodusIICacheKey& key)
 
 int vtkExodusIICache::Invalidate(const vtkExodusIICacheKey& key, const vtkExodusIICacheKey& pattern)
 {
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
   vtkExodusIICacheRef it;
   int nDropped = 0;
   it = this->Cache.begin();
@@ -288,6 +329,7 @@ int vtkExodusIICache::Invalidate(const vtkExodusIICacheKey& key, const vtkExodus
 
 void vtkExodusIICache::RecomputeSize()
 {
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
   this->Size = 0.;
   vtkExodusIICacheRef it;
   for (it = this->Cache.begin(); it != this->Cache.end(); ++it)
@@ -298,4 +340,57 @@ void vtkExodusIICache::RecomputeSize()
     }
   }
 }
+
+vtkIdType vtkExodusIICache::GetNumberOfHits()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
+  return this->NumberOfHits;
+}
+
+vtkIdType vtkExodusIICache::GetNumberOfMisses()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
+  return this->NumberOfMisses;
+}
+
+vtkIdType vtkExodusIICache::GetNumberOfEvictions()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
+  return this->NumberOfEvictions;
+}
+
+void vtkExodusIICache::ResetStatistics()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+  this->NumberOfEvictions = 0;
+}
+
+vtkExodusIICache* vtkExodusIICache::GetSharedCache()
+{
+  static vtkSmartPointer<vtkExodusIICache> sharedCache = []
+  {
+    auto cache = vtkSmartPointer<vtkExodusIICache>::New();
+    cache->SetCacheCapacity(0.);
+    return cache;
+  }();
+  return sharedCache;
+}
+
+int vtkExodusIICache::GetSharedFileId(const std::string& fileName)
+{
+  static std::mutex mutex;
+  static std::map<std::pair<std::string, long>, int> fileIds;
+  const std::pair<std::string, long> file(
+    vtksys::SystemTools::CollapseFullPath(fileName), vtksys::SystemTools::ModifiedTime(fileName));
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = fileIds.find(file);
+  if (it == fileIds.end())
+  {
+    it = fileIds.emplace(file, static_cast<int>(fileIds.size()) + 1).first;
+  }
+  return it->second;
+}
 VTK_ABI_NAMESPACE_END
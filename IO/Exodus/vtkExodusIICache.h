@@ -24,12 +24,22 @@
 // entries O(1). Each cache entry stores an iterator into
 // the list of references so that it can be located quickly for
 // removal.
+//
+// All the methods of the cache are thread-safe. GetSharedCache()
+// returns a cache shared by all the readers of the process, in which
+// the keys also hold a file id given by GetSharedFileId(), so that
+// readers of the same file share their arrays within a single
+// capacity. Use Lookup() rather than Find() on a shared cache: the
+// arrays it returns stay valid when other threads evict them.
 
 #include "vtkIOExodusModule.h" // For export macro
 #include "vtkObject.h"
+#include "vtkSmartPointer.h" // For vtkSmartPointer
 
-#include <list> // use for LRU ordering
-#include <map>  // used for cache storage
+#include <list>   // use for LRU ordering
+#include <map>    // used for cache storage
+#include <mutex>  // for std::recursive_mutex
+#include <string> // for std::string
 
 VTK_ABI_NAMESPACE_BEGIN
 class VTKIOEXODUS_EXPORT vtkExodusIICacheKey
@@ -39,19 +49,22 @@ public:
   int ObjectType;
   int ObjectId;
   int ArrayId;
+  int FileId; // 0, except in the shared cache
   vtkExodusIICacheKey()
   {
     Time = -1;
     ObjectType = -1;
     ObjectId = -1;
     ArrayId = -1;
+    FileId = 0;
   }
-  vtkExodusIICacheKey(int time, int objType, int objId, int arrId)
+  vtkExodusIICacheKey(int time, int objType, int objId, int arrId, int fileId = 0)
   {
     Time = time;
     ObjectType = objType;
     ObjectId = objId;
     ArrayId = arrId;
+    FileId = fileId;
   }
   vtkExodusIICacheKey(const vtkExodusIICacheKey& src)
   {
@@ -59,10 +72,13 @@ public:
     ObjectType = src.ObjectType;
     ObjectId = src.ObjectId;
     ArrayId = src.ArrayId;
+    FileId = src.FileId;
   }
   vtkExodusIICacheKey& operator=(const vtkExodusIICacheKey& src) = default;
   bool match(const vtkExodusIICacheKey& other, const vtkExodusIICacheKey& pattern) const
   {
+    if (pattern.FileId && this->FileId != other.FileId)
+      return false;
     if (pattern.Time && this->Time != other.Time)
       return false;
     if (pattern.ObjectType && this->ObjectType != other.ObjectType)
@@ -75,6 +91,10 @@ public:
   }
   bool operator<(const vtkExodusIICacheKey& other) const
   {
+    if (this->FileId < other.FileId)
+      return true;
+    else if (this->FileId > other.FileId)
+      return false;
     if (this->Time < other.Time)
       return true;
     else if (this->Time > other.Time)
@@ -138,7 +158,7 @@ public:
    * This is the difference between the capacity and the size of the cache.
    * The result is in MiB.
    */
-  double GetSpaceLeft() { return this->Capacity - this->Size; }
+  double GetSpaceLeft();
 
   /** Remove cache entries until the size of the cache is at or below the given size.
    * Returns a nonzero value if deletions were required.
@@ -153,6 +173,14 @@ public:
    */
   vtkDataArray*& Find(const vtkExodusIICacheKey&);
 
+  /** Like Find(), but return a new reference to the array, which stays valid even if another
+   * thread drops the entry from the cache. Return nullptr if the entry does not exist.
+   */
+  vtkSmartPointer<vtkDataArray> Lookup(const vtkExodusIICacheKey&);
+
+  /// Return true if a cache entry exists, without marking it as recently used.
+  bool Contains(const vtkExodusIICacheKey&);
+
   /** Invalidate a cache entry (drop it from the cache) if the key exists.
    * This does nothing if the cache entry does not exist.
    * Returns 1 if the cache entry existed prior to this call and 0 otherwise.
@@ -170,6 +198,27 @@ public:
    */
   int Invalidate(const vtkExodusIICacheKey& key, const vtkExodusIICacheKey& pattern);
 
+  ///@{
+  /** Statistics of the cache since its creation or the last call to ResetStatistics():
+   * the number of Find() or Lookup() calls that found their entry (hits) or not (misses), and
+   * the number of entries dropped to keep the cache within its capacity (evictions).
+   */
+  vtkIdType GetNumberOfHits();
+  vtkIdType GetNumberOfMisses();
+  vtkIdType GetNumberOfEvictions();
+  void ResetStatistics();
+  ///@}
+
+  /** Return the cache shared by the readers with UseSharedCache on. Its capacity is 0 MiB until
+   * set with SetCacheCapacity().
+   */
+  static vtkExodusIICache* GetSharedCache();
+
+  /** Return the id identifying a file in the keys of the shared cache. The id changes when the
+   * file is modified, so that arrays read before are not used anymore.
+   */
+  static int GetSharedFileId(const std::string& fileName);
+
 protected:
   /// Default constructor
   vtkExodusIICache();
@@ -198,6 +247,14 @@ protected:
   /// The actual LRU list (indices into the cache ordered least to most recently used).
   vtkExodusIICacheLRU LRU;
 
+  /// Statistics, see GetNumberOfHits().
+  vtkIdType NumberOfHits = 0;
+  vtkIdType NumberOfMisses = 0;
+  vtkIdType NumberOfEvictions = 0;
+
+  /// Protects all the members, the methods calling each other.
+  std::recursive_mutex Mutex;
+
 private:
   vtkExodusIICache(const vtkExodusIICache&) = delete;
   void operator=(const vtkExodusIICache&) = delete;
@@ -40,6 +40,7 @@
 #include <algorithm>
 #include <deque>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -306,6 +307,9 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 
   this->Cache = vtkExodusIICache::New();
   this->CacheSize = 0;
+  this->UseSharedCache = false;
+  this->PrefetchNextTimeStep = false;
+  this->SharedFileId = 0;
 
   this->HasModeShapes = 0;
   this->ModeShapeTime = -1.;
@@ -337,6 +341,7 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 //------------------------------------------------------------------------------
 vtkExodusIIReaderPrivate::~vtkExodusIIReaderPrivate()
 {
+  this->WaitForPrefetch();
   this->CloseFile();
   this->Cache->Delete();
   this->CacheSize = 0;
@@ -1525,6 +1530,15 @@ void vtkExodusIIReaderPrivate::InsertSetSides(
 vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
 {
   vtkDataArray* arr;
+  // Time-dependent arrays are also looked up in the cache shared with other readers, and
+  // recorded to read the same arrays of the next time step when prefetching.
+  const bool shared = this->UseSharedCache && this->SharedFileId &&
+    vtkExodusIIReaderPrivate::IsSharedType(key.ObjectType);
+  if (shared)
+  {
+    this->TimeStepKeys.insert(vtkExodusIICacheKey(-1, key.ObjectType, key.ObjectId, key.ArrayId));
+  }
+
   // Never cache points deflected for a mode shape animation... doubles don't make good keys.
   if (this->HasModeShapes && key.ObjectType == vtkExodusIIReader::NODAL_COORDS)
   {
@@ -1541,10 +1555,67 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
     return arr;
   }
 
-  int exoid = this->Exoid;
-  int maxNameLength = this->Parent->GetMaxNameLength();
+  // Shared arrays are looked up, read and inserted under the lock of the shared cache, so that
+  // an array wanted by several readers, or by a prefetch task, is read once.
+  vtkExodusIICacheKey sharedKey(
+    key.Time, key.ObjectType, key.ObjectId, key.ArrayId, this->SharedFileId);
+  std::unique_lock<std::recursive_mutex> lock(
+    vtkExodusIIReaderPrivate::GetSharedCacheMutex(), std::defer_lock);
+  if (shared)
+  {
+    lock.lock();
+    vtkSmartPointer<vtkDataArray> sharedArr = vtkExodusIICache::GetSharedCache()->Lookup(sharedKey);
+    if (sharedArr)
+    {
+      this->Cache->Insert(key, sharedArr);
+      return sharedArr;
+    }
+  }
 
   // If array is nullptr, try reading it from file.
+  arr = this->ReadArray(key, this->Exoid);
+
+  // Even if the array is larger than the allowable cache size, it will keep the most recent
+  // insertion. So, we delete our reference knowing that the Cache will keep the object "alive"
+  // until whatever called GetCacheOrRead() references the array. But, once you get an array from
+  // GetCacheOrRead(), you better start running!
+  if (arr)
+  {
+    if (shared)
+    {
+      vtkExodusIICache::GetSharedCache()->Insert(sharedKey, arr);
+    }
+    this->Cache->Insert(key, arr);
+    arr->FastDelete();
+  }
+  return arr;
+}
+
+//------------------------------------------------------------------------------
+bool vtkExodusIIReaderPrivate::IsSharedType(int objectType)
+{
+  switch (objectType)
+  {
+    case vtkExodusIIReader::GLOBAL:
+    case vtkExodusIIReader::NODAL:
+    case vtkExodusIIReader::EDGE_BLOCK:
+    case vtkExodusIIReader::FACE_BLOCK:
+    case vtkExodusIIReader::ELEM_BLOCK:
+    case vtkExodusIIReader::NODE_SET:
+    case vtkExodusIIReader::EDGE_SET:
+    case vtkExodusIIReader::FACE_SET:
+    case vtkExodusIIReader::SIDE_SET:
+    case vtkExodusIIReader::ELEM_SET:
+      return true;
+    default:
+      return false;
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkDataArray* vtkExodusIIReaderPrivate::ReadArray(vtkExodusIICacheKey key, int exoid)
+{
+  vtkDataArray* arr = nullptr;
   if (key.ObjectType == vtkExodusIIReader::GLOBAL)
   {
     // need to assemble result array from smaller ones.
@@ -2781,6 +2852,8 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
     char* cdum = nullptr;
     int i, j;
 
+    const int maxNameLength =
+      static_cast<int>(ex_inquire_int(exoid, EX_INQ_DB_MAX_USED_NAME_LENGTH));
     vtkCharArray* carr = vtkCharArray::New();
     carr->SetName("QA_Records");
     carr->SetNumberOfComponents(maxNameLength + 1);
@@ -2846,17 +2919,87 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
                                                                   << " which I know nothing about");
     arr = nullptr;
   }
+  return arr;
+}
 
-  // Even if the array is larger than the allowable cache size, it will keep the most recent
-  // insertion. So, we delete our reference knowing that the Cache will keep the object "alive"
-  // until whatever called GetCacheOrRead() references the array. But, once you get an array from
-  // GetCacheOrRead(), you better start running!
-  if (arr)
+//------------------------------------------------------------------------------
+std::recursive_mutex& vtkExodusIIReaderPrivate::GetSharedCacheMutex()
+{
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+
+//------------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::PrefetchTimeStep(const char* fileName, int timeStep)
+{
+  this->WaitForPrefetch();
+  if (!fileName || this->TimeStepKeys.empty())
   {
-    this->Cache->Insert(key, arr);
-    arr->FastDelete();
+    return;
+  }
+
+  // A single background thread is enough: the reads of shared arrays are serialized anyway.
+  static vtkSmartPointer<vtkThreadedCallbackQueue> queue = []
+  {
+    auto callbackQueue = vtkSmartPointer<vtkThreadedCallbackQueue>::New();
+    callbackQueue->SetNumberOfThreads(1);
+    return callbackQueue;
+  }();
+
+  std::vector<vtkExodusIICacheKey> keys(this->TimeStepKeys.begin(), this->TimeStepKeys.end());
+  this->TimeStepKeys.clear();
+  const std::string name = fileName;
+  const int fileId = this->SharedFileId;
+  this->Prefetch = queue->Push(
+    [this, name, keys, fileId, timeStep]()
+    {
+      // The lock is taken for each array, so that the readers are not blocked until the whole
+      // time step is read.
+      std::recursive_mutex& mutex = vtkExodusIIReaderPrivate::GetSharedCacheMutex();
+      std::unique_lock<std::recursive_mutex> lock(mutex);
+      vtkExodusIICache* sharedCache = vtkExodusIICache::GetSharedCache();
+      int appWordSize = this->AppWordSize;
+      int diskWordSize = this->DiskWordSize;
+      float version;
+      const int exoid = ex_open(name.c_str(), EX_READ, &appWordSize, &diskWordSize, &version);
+      if (exoid <= 0)
+      {
+        return;
+      }
+#ifdef VTK_USE_64BIT_IDS
+      ex_set_int64_status(exoid, EX_ALL_INT64_API);
+#endif
+      lock.unlock();
+      for (const vtkExodusIICacheKey& key : keys)
+      {
+        std::lock_guard<std::recursive_mutex> keyLock(mutex);
+        vtkExodusIICacheKey sharedKey(timeStep, key.ObjectType, key.ObjectId, key.ArrayId, fileId);
+        if (sharedCache->Contains(sharedKey))
+        {
+          continue;
+        }
+        vtkDataArray* arr =
+          this->ReadArray(vtkExodusIICacheKey(timeStep, key.ObjectType, key.ObjectId, key.ArrayId),
+            exoid);
+        if (arr)
+        {
+          sharedCache->Insert(sharedKey, arr);
+          arr->Delete();
+        }
+      }
+      lock.lock();
+      ex_close(exoid);
+    });
+}
+
+//------------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::WaitForPrefetch()
+{
+  if (this->Prefetch)
+  {
+    this->Prefetch->Wait();
+    this->Prefetch = nullptr;
   }
-  return arr;
 }
 
 //------------------------------------------------------------------------------
@@ -3799,6 +3942,9 @@ void vtkExodusIIReaderPrivate::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Array Cache:\n";
   this->Cache->PrintSelf(os, inden2);
+  os << indent << "UseSharedCache: " << this->UseSharedCache << "\n";
+  os << indent << "PrefetchNextTimeStep: " << this->PrefetchNextTimeStep << "\n";
+  os << indent << "SharedFileId: " << this->SharedFileId << "\n";
 
   os << indent << "SqueezePoints: " << this->SqueezePoints << "\n";
   os << indent << "ApplyDisplacements: " << this->ApplyDisplacements << "\n";
@@ -3841,6 +3987,7 @@ int vtkExodusIIReaderPrivate::OpenFile(const char* filename)
   // this is because in our current version of the ExodusII libraries the exo Id isn't used
   // in the ex_set_max_name_length() function.
   ex_set_max_name_length(this->Exoid, this->Parent->GetMaxNameLength());
+  this->SharedFileId = vtkExodusIICache::GetSharedFileId(filename);
 
   vtkIdType numNodesInFile;
   char dummyChar;
@@ -4701,6 +4848,8 @@ int vtkExodusIIReaderPrivate::SetUpEmptyGrid(vtkMultiBlockDataSet* output)
 void vtkExodusIIReaderPrivate::Reset()
 {
   vtkLogF(TRACE, "vtkExodusIIReaderPrivate(%p)::Reset", static_cast<void*>(this));
+  this->WaitForPrefetch();
+  this->TimeStepKeys.clear();
   this->CloseFile();
   this->ResetCache(); // must come before BlockInfo and SetInfo are cleared.
   this->BlockInfo.clear();
@@ -5417,6 +5566,9 @@ int vtkExodusIIReader::RequestInformation(vtkInformation* vtkNotUsed(request),
   int newMetadata = 0;
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
 
+  // The metadata must not change while a prefetch task reads arrays.
+  this->Metadata->WaitForPrefetch();
+
   // If the metadata is older than the filename
   if (this->GetMetadataMTime() < this->FileNameMTime)
   {
@@ -5483,6 +5635,7 @@ int vtkExodusIIReader::RequestInformation(vtkInformation* vtkNotUsed(request),
 int vtkExodusIIReader::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
 {
+  this->Metadata->WaitForPrefetch();
   if (!this->FileName || !this->Metadata->OpenFile(this->FileName))
   {
     vtkErrorMacro("Unable to open file \"" << (this->FileName ? this->FileName : "(null)")
@@ -5544,8 +5697,15 @@ int vtkExodusIIReader::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  this->Metadata->TimeStepKeys.clear();
   this->Metadata->RequestData(this->TimeStep, output);
 
+  if (this->GetUseSharedCache() && this->GetPrefetchNextTimeStep() && !this->GetHasModeShapes() &&
+    this->TimeStep + 1 < this->Metadata->GetNumberOfTimeSteps())
+  {
+    this->Metadata->PrefetchTimeStep(this->FileName, this->TimeStep + 1);
+  }
+
   return 1;
 }
 
@@ -6690,6 +6850,30 @@ double vtkExodusIIReader::GetCacheSize()
   return this->Metadata->GetCacheSize();
 }
 
+void vtkExodusIIReader::SetUseSharedCache(bool use)
+{
+  if (this->Metadata->GetUseSharedCache() != use)
+  {
+    this->Metadata->SetUseSharedCache(use);
+    this->Modified();
+  }
+}
+
+bool vtkExodusIIReader::GetUseSharedCache()
+{
+  return this->Metadata->GetUseSharedCache();
+}
+
+void vtkExodusIIReader::SetPrefetchNextTimeStep(bool prefetch)
+{
+  this->Metadata->SetPrefetchNextTimeStep(prefetch);
+}
+
+bool vtkExodusIIReader::GetPrefetchNextTimeStep()
+{
+  return this->Metadata->GetPrefetchNextTimeStep();
+}
+
 void vtkExodusIIReader::SetSqueezePoints(bool sp)
 {
   this->Metadata->SetSqueezePoints(sp ? 1 : 0);
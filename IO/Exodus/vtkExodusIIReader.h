@@ -778,6 +778,36 @@ public:
    */
   double GetCacheSize();
 
+  ///@{
+  /**
+   * Should time-dependent result arrays also be kept in vtkExodusIICache::GetSharedCache(),
+   * a thread-safe cache shared by all the readers of the process, so that readers of the
+   * same file, e.g. one per view or per piece, read each array once? The capacity of the
+   * shared cache, in MiB, is set with vtkExodusIICache::GetSharedCache()->SetCacheCapacity()
+   * and its hit and miss counts are reported by the same object.
+   * Default is false.
+   */
+  void SetUseSharedCache(bool use);
+  bool GetUseSharedCache();
+  vtkBooleanMacro(UseSharedCache, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Should the arrays of the next time step be read into the shared cache, in the
+   * background, once a time step has been read? This lets the next update, or
+   * another reader of the same file, find them in the cache while the current time
+   * step is processed. Only used when UseSharedCache is true. The background read
+   * only excludes the reads of shared arrays by the other readers: as their other
+   * calls to the Exodus library may run meanwhile, prefetching while other readers
+   * update on other threads requires a thread-safe build of the NetCDF library.
+   * Default is false.
+   */
+  void SetPrefetchNextTimeStep(bool prefetch);
+  bool GetPrefetchNextTimeStep();
+  vtkBooleanMacro(PrefetchNextTimeStep, bool);
+  ///@}
+
   ///@{
   /**
    * Should the reader output only points used by elements in the output mesh,
@@ -10,9 +10,12 @@
 #include "vtkExodusIIReader.h" // for vtkExodusIIReader
 #include "vtkObject.h"
 #include "vtkStdString.h"               // for vtkStdString
+#include "vtkThreadedCallbackQueue.h"   // for vtkThreadedCallbackQueue::SharedFuturePointer
 #include "vtksys/RegularExpression.hxx" // for vtksys::RegularExpression
 
 #include <map>    // for std::map
+#include <mutex>  // for std::recursive_mutex
+#include <set>    // for std::set
 #include <vector> // for std::vector
 
 #include "vtkIOExodusModule.h" // For export macro
@@ -86,6 +89,30 @@ public:
   /// Get the size of the cache in MiB.
   vtkGetMacro(CacheSize, double);
 
+  /// Set/get whether raw arrays are also shared through vtkExodusIICache::GetSharedCache().
+  vtkSetMacro(UseSharedCache, bool);
+  vtkGetMacro(UseSharedCache, bool);
+
+  /// Set/get whether RequestData() reads the arrays of the next time step in the background.
+  vtkSetMacro(PrefetchNextTimeStep, bool);
+  vtkGetMacro(PrefetchNextTimeStep, bool);
+
+  /** Read, in the background, the arrays of time step \a timeStep matching the time-dependent
+   * arrays read by the last RequestData(), and add them to the shared cache.
+   * The file is opened again by the background task, so that this can be called after
+   * CloseFile().
+   */
+  void PrefetchTimeStep(const char* fileName, int timeStep);
+
+  /// Wait for the end of the task started by PrefetchTimeStep(), if any.
+  void WaitForPrefetch();
+
+  /** Return the mutex held while an array of the shared cache is looked up, read and inserted,
+   * by a reader or by a prefetch task, so that each array is read once. Nothing else is
+   * serialized across readers.
+   */
+  static std::recursive_mutex& GetSharedCacheMutex();
+
   /** Return the number of time steps in the open file.
    * You must have called RequestInformation() before
    * invoking this member function.
@@ -631,6 +658,14 @@ protected:
    */
   vtkDataArray* GetCacheOrRead(vtkExodusIICacheKey);
 
+  /** Read the array for the specified cache key from the file \a exoid, without using the
+   * cache. The caller owns the returned reference.
+   */
+  vtkDataArray* ReadArray(vtkExodusIICacheKey key, int exoid);
+
+  /// Return true if arrays of this object type are read as-is and can be shared across readers.
+  static bool IsSharedType(int objectType);
+
   /** Return the index of an object type (in a private list of all object types).
    * This returns a 0-based index if the object type was found and -1 if it
    * was not.
@@ -817,6 +852,17 @@ protected:
   /// The size of the cache in MiB.
   double CacheSize;
 
+  /// Use vtkExodusIICache::GetSharedCache() in addition to Cache.
+  bool UseSharedCache;
+  /// Read the next time step into the shared cache after each RequestData().
+  bool PrefetchNextTimeStep;
+  /// The file id in the keys of the shared cache, set by OpenFile().
+  int SharedFileId;
+  /// The time-dependent keys read since the last prefetch, with their Time set to -1.
+  std::set<vtkExodusIICacheKey> TimeStepKeys;
+  /// The task started by PrefetchTimeStep().
+  vtkThreadedCallbackQueue::SharedFuturePointer<void> Prefetch;
+
   vtkTypeBool ApplyDisplacements;
   float DisplacementMagnitude;
   vtkTypeBool HasModeShapes;
@@ -4,10 +4,12 @@
 
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkChunkedTextParser.h"
 #include "vtkFileResourceStream.h"
 #include "vtkFloatArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMemoryResourceStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
@@ -16,11 +18,114 @@
 
 #include <cctype>
 #include <sstream>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkOBJReader);
 
+namespace
+{
+// Kinds of lines whose values are parsed concurrently: "v", "vt" and "vn",
+// with the number of values stored for each.
+constexpr const char* OBJValueCommands[3] = { "v", "vt", "vn" };
+constexpr int OBJValueCounts[3] = { 3, 2, 3 };
+// Whether an additional value is accepted: "w" for vertices and "z" for tcoords.
+constexpr bool OBJOptionalValue[3] = { true, true, false };
+
+// The "v", "vt" and "vn" lines of a chunk of an OBJ file, with their values.
+// Lines holding anything else than their values are left to the main loop,
+// which reports the issues.
+struct OBJChunkValues
+{
+  std::vector<vtkTypeInt64> Offsets[3]; // just after the command of the lines
+  std::vector<double> Values[3];
+
+  void ParseLine(const char* text, const char* first, const char* last)
+  {
+    first = vtkChunkedTextParser::SkipWhitespace(first, last);
+    const char* command = first;
+    while (first != last && !vtkChunkedTextParser::IsWhitespace(*first))
+    {
+      ++first;
+    }
+    const std::string_view commandView(command, first - command);
+
+    for (int kind = 0; kind < 3; ++kind)
+    {
+      if (commandView == OBJValueCommands[kind])
+      {
+        double values[4];
+        const char* it = first;
+        for (int i = 0; i < OBJValueCounts[kind] && it; ++i)
+        {
+          it = vtkChunkedTextParser::ParseValue(it, last, values[i]);
+        }
+        if (it && OBJOptionalValue[kind] && vtkChunkedTextParser::SkipWhitespace(it, last) != last)
+        {
+          it = vtkChunkedTextParser::ParseValue(it, last, values[3]);
+        }
+        if (it && vtkChunkedTextParser::SkipWhitespace(it, last) == last)
+        {
+          this->Offsets[kind].push_back(static_cast<vtkTypeInt64>(first - text));
+          this->Values[kind].insert(
+            this->Values[kind].end(), values, values + OBJValueCounts[kind]);
+        }
+        return;
+      }
+    }
+  }
+};
+
+// Give the values of the lines of a kind, in the order of the file.
+class OBJValuesCursor
+{
+public:
+  OBJValuesCursor(const std::vector<OBJChunkValues>& chunks, int kind)
+    : Chunks(chunks)
+    , Kind(kind)
+  {
+  }
+
+  // Return the values of the line whose command ends at `offset`, nullptr if
+  // the values of this line were not parsed.
+  const double* Find(vtkTypeInt64 offset)
+  {
+    while (this->Chunk < this->Chunks.size())
+    {
+      const std::vector<vtkTypeInt64>& offsets = this->Chunks[this->Chunk].Offsets[this->Kind];
+      if (this->Line == offsets.size())
+      {
+        ++this->Chunk;
+        this->Line = 0;
+      }
+      else if (offsets[this->Line] < offset)
+      {
+        ++this->Line;
+      }
+      else if (offsets[this->Line] > offset)
+      {
+        return nullptr;
+      }
+      else
+      {
+        const std::size_t line = this->Line++;
+        return this->Chunks[this->Chunk].Values[this->Kind].data() +
+          OBJValueCounts[this->Kind] * line;
+      }
+    }
+    return nullptr;
+  }
+
+private:
+  const std::vector<OBJChunkValues>& Chunks;
+  const int Kind;
+  std::size_t Chunk = 0;
+  std::size_t Line = 0;
+};
+}
+
 //------------------------------------------------------------------------------
 vtkOBJReader::vtkOBJReader()
 {
@@ -134,8 +239,28 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
     return 0;
   }
 
+  // The values of the "v", "vt" and "vn" lines, which make most of the files,
+  // are parsed concurrently by chunks of lines. The other lines are parsed in
+  // order from the text in memory.
+  vtkNew<vtkChunkedTextParser> text;
+  text->Read(stream, vtkChunkedTextParser::Unit::Line);
+  std::vector<OBJChunkValues> chunkValues(text->GetNumberOfChunks());
+  text->ForEachChunk(
+    [&](std::size_t chunk, const char* begin, const char* end, vtkIdType)
+    {
+      vtkChunkedTextParser::ForEachLine(begin, end,
+        [&](const char* first, const char* last)
+        { chunkValues[chunk].ParseLine(text->GetText(), first, last); });
+    });
+  OBJValuesCursor vertexValues(chunkValues, 0);
+  OBJValuesCursor tcoordValues(chunkValues, 1);
+  OBJValuesCursor normalValues(chunkValues, 2);
+
+  vtkNew<vtkMemoryResourceStream> textStream;
+  textStream->SetBuffer(text->GetText(), text->GetSize());
+
   vtkNew<vtkResourceParser> parser;
-  parser->SetStream(stream);
+  parser->SetStream(textStream);
   parser->StopOnNewLineOn();
 
   const std::string noMaterialName = "NO_MATERIAL";
@@ -316,6 +441,11 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
 
       result = flushLine();
     }
+    else if (const double* point = command == "v" ? vertexValues.Find(parser->Tell()) : nullptr)
+    {
+      points->InsertNextPoint(point);
+      result = parser->DiscardLine();
+    }
     else if (command == "v") // vertex/point
     {
       std::array<double, 3> point;
@@ -349,6 +479,11 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
 
       result = flushLine();
     }
+    else if (const double* tcoord = command == "vt" ? tcoordValues.Find(parser->Tell()) : nullptr)
+    {
+      tcoords->InsertNextTuple(tcoord);
+      result = parser->DiscardLine();
+    }
     else if (command == "vt") // tcoord
     {
       std::array<double, 2> tcoord;
@@ -382,6 +517,11 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
 
       result = flushLine();
     }
+    else if (const double* normal = command == "vn" ? normalValues.Find(parser->Tell()) : nullptr)
+    {
+      normals->InsertNextTuple(normal);
+      result = parser->DiscardLine();
+    }
     else if (command == "vn") // normals
     {
       std::array<double, 3> normal;
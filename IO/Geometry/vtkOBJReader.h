@@ -11,6 +11,11 @@
  * When selecting input method, `Stream` has an higher priority than `Filename`.
  * If both are null, reader outputs nothing.
  *
+ * The whole file is read into memory, and the values of its vertices, texture
+ * coordinates and normals are parsed concurrently before the output is built.
+ * Reading a file then temporarily needs about twice its size in memory, in
+ * addition to the output.
+ *
  * @sa
  * vtkOBJImporter
  */
@@ -5,6 +5,7 @@
 #include "vtkByteSwap.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkChunkedTextParser.h"
 #include "vtkErrorCode.h"
 #include "vtkFileResourceStream.h"
 #include "vtkFloatArray.h"
@@ -27,6 +28,9 @@
 #include <cmath>
 #include <cstdlib>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -395,10 +399,8 @@ inline std::string stlParseExpected(const std::string& expected, const std::stri
 }
 
 // Get three space-delimited floats from string.
-bool stlReadVertex(char* buf, float vertCoord[3])
+bool stlReadVertex(std::string_view buffer, float vertCoord[3])
 {
-  std::string_view buffer = buf;
-
   for (int i = 0; i < 3; ++i)
   {
     auto result = vtk::scan_value<float>(buffer);
@@ -413,6 +415,121 @@ bool stlReadVertex(char* buf, float vertCoord[3])
   return true;
 }
 
+// Kind of the lines of an ASCII STL file, given by their first word.
+enum class StlLine : unsigned char
+{
+  Empty,
+  Solid,
+  Color,
+  Facet,
+  Outer,
+  Vertex,
+  BadVertex, // "vertex" without three valid coordinates
+  EndLoop,
+  EndFacet,
+  EndSolid,
+  Other
+};
+
+constexpr std::pair<const char*, StlLine> StlKeywords[] = { { "solid", StlLine::Solid },
+  { "color", StlLine::Color }, { "facet", StlLine::Facet }, { "outer", StlLine::Outer },
+  { "vertex", StlLine::Vertex }, { "endloop", StlLine::EndLoop },
+  { "endfacet", StlLine::EndFacet }, { "endsolid", StlLine::EndSolid } };
+
+const char* stlLineName(StlLine kind)
+{
+  if (kind == StlLine::BadVertex)
+  {
+    return "vertex";
+  }
+  for (const auto& keyword : StlKeywords)
+  {
+    if (keyword.second == kind)
+    {
+      return keyword.first;
+    }
+  }
+  return "";
+}
+
+// Lines of a chunk of an ASCII STL file, lexed independently of the others.
+struct StlLexedChunk
+{
+  std::vector<StlLine> Lines;
+  std::vector<float> Coords;      // Three per Vertex line
+  std::vector<std::string> Words; // Argument of Solid lines, lower case word of Other lines
+
+  void Lex(const char* begin, const char* end)
+  {
+    vtkChunkedTextParser::ForEachLine(
+      begin, end, [this](const char* first, const char* last) { this->LexLine(first, last); });
+  }
+
+  void LexLine(const char* first, const char* last)
+  {
+    first = vtkChunkedTextParser::SkipWhitespace(first, last);
+    if (first == last)
+    {
+      this->Lines.push_back(StlLine::Empty);
+      return;
+    }
+
+    // The first word, in lower case
+    std::string cmd;
+    const char* arg = first;
+    for (; arg != last && !vtkChunkedTextParser::IsWhitespace(*arg); ++arg)
+    {
+      cmd += static_cast<char>(tolower(static_cast<unsigned char>(*arg)));
+    }
+    arg = vtkChunkedTextParser::SkipWhitespace(arg, last);
+
+    StlLine kind = StlLine::Other;
+    for (const auto& keyword : StlKeywords)
+    {
+      if (cmd == keyword.first)
+      {
+        kind = keyword.second;
+        break;
+      }
+    }
+
+    if (kind == StlLine::Vertex)
+    {
+      float coords[3];
+      const char* it = arg;
+      for (int i = 0; i < 3 && it; ++i)
+      {
+        it = vtkChunkedTextParser::SkipWhitespace(it, last);
+        const std::size_t consumed = vtkValueFromString(it, last, coords[i]);
+        it = consumed ? it + consumed : nullptr;
+      }
+      // Fallback on the scanner for the syntaxes not handled above
+      if (!it && !stlReadVertex(std::string_view(arg, last - arg), coords))
+      {
+        kind = StlLine::BadVertex;
+      }
+      else
+      {
+        this->Coords.insert(this->Coords.end(), coords, coords + 3);
+      }
+    }
+    else if (kind == StlLine::Solid)
+    {
+      // strip end-of-line characters from the end
+      while (last != arg && (last[-1] == '\r' || last[-1] == '\n'))
+      {
+        --last;
+      }
+      this->Words.emplace_back(arg, last);
+    }
+    else if (kind == StlLine::Other)
+    {
+      this->Words.push_back(std::move(cmd));
+    }
+    this->Lines.push_back(kind);
+  }
+};
+
 } // end of anonymous namespace
 
 // https://en.wikipedia.org/wiki/STL_%28file_format%29#ASCII_STL
@@ -448,9 +565,17 @@ bool vtkSTLReader::ReadASCIISTL(
   this->SetBinaryHeader(nullptr);
   std::string header;
 
-  std::string line;   // line buffer
-  float vertCoord[3]; // scratch space when parsing "vertex %f %f %f"
-  vtkIdType pts[3];   // point ids for building triangles
+  // The lines are lexed and their coordinates parsed concurrently, by chunks,
+  // then the chunks are checked in order.
+  vtkResourceStream* stream = parser->GetStream();
+  stream->Seek(parser->Tell(), vtkResourceStream::SeekDirection::Begin);
+  vtkNew<vtkChunkedTextParser> text;
+  text->Read(stream, vtkChunkedTextParser::Unit::Line);
+  std::vector<StlLexedChunk> chunks(text->GetNumberOfChunks());
+  text->ForEachChunk([&chunks](std::size_t chunk, const char* begin, const char* end, vtkIdType)
+    { chunks[chunk].Lex(begin, end); });
+
+  vtkIdType pts[3]; // point ids for building triangles
   int vertOff = 0;
 
   int solidId = -1;
@@ -469,11 +594,20 @@ bool vtkSTLReader::ReadASCIISTL(
 
   std::string errorMessage;
 
+  // position of the next line, and of the next coordinates and words of its chunk
+  std::size_t chunkId = 0;
+  std::size_t lineId = 0;
+  std::size_t coordId = 0;
+  std::size_t wordId = 0;
+
   for (StlAsciiScanState state = scanSolid; errorMessage.empty(); /*nil*/)
   {
-    vtkParseResult res = parser->ReadLine(line);
-    char* cmd = line.data();
-    if (res == vtkParseResult::EndOfStream)
+    while (chunkId < chunks.size() && lineId == chunks[chunkId].Lines.size())
+    {
+      ++chunkId;
+      lineId = coordId = wordId = 0;
+    }
+    if (chunkId == chunks.size())
     {
       // If scanning for the next "solid" this is a valid way to exit,
       // but is an error if scanning for the initial "solid" or any other token
@@ -523,14 +657,11 @@ bool vtkSTLReader::ReadASCIISTL(
       break;
     }
 
-    // Cue to the first non-space.
-    while (isspace(*cmd))
-    {
-      ++cmd;
-    }
+    StlLexedChunk& chunk = chunks[chunkId];
+    const StlLine kind = chunk.Lines[lineId++];
 
     // An empty line - try again
-    if (!*cmd)
+    if (kind == StlLine::Empty)
     {
       // Increment line-number, but not while still in the header
       if (lineNum)
@@ -538,26 +669,11 @@ bool vtkSTLReader::ReadASCIISTL(
       continue;
     }
 
-    // Ensure consistent case on the first token and separate from
-    // subsequent arguments
-
-    char* arg = cmd;
-    while (*arg && !isspace(*arg))
-    {
-      *arg = tolower(*arg);
-      ++arg;
-    }
-
-    // Terminate first token (cmd)
-    if (*arg)
+    const std::string cmd = kind == StlLine::Other ? chunk.Words[wordId++] : stlLineName(kind);
+    const float* vertCoord = kind == StlLine::Vertex ? chunk.Coords.data() + coordId : nullptr;
+    if (kind == StlLine::Vertex)
     {
-      *arg = '\0';
-      ++arg;
-
-      while (isspace(*arg))
-      {
-        ++arg;
-      }
+      coordId += 3;
     }
 
     ++lineNum;
@@ -567,23 +683,16 @@ bool vtkSTLReader::ReadASCIISTL(
     {
       case scanSolid:
       {
-        if (!strcmp(cmd, "solid"))
+        if (kind == StlLine::Solid)
         {
           ++solidId;
           state = scanFacet; // Next state
+          const std::string& arg = chunk.Words[wordId++];
           if (!header.empty())
           {
             header += "\n";
           }
-          if (*arg)
-          {
-            header += arg;
-            // strip end-of-line character from the end
-            while (!header.empty() && (header.back() == '\r' || header.back() == '\n'))
-            {
-              header.pop_back();
-            }
-          }
+          header += arg;
         }
         else
         {
@@ -593,17 +702,17 @@ bool vtkSTLReader::ReadASCIISTL(
       }
       case scanFacet:
       {
-        if (!strcmp(cmd, "color"))
+        if (kind == StlLine::Color)
         {
           // Optional 'color' entry (after solid) - continue looking for 'facet'
           continue;
         }
 
-        if (!strcmp(cmd, "facet"))
+        if (kind == StlLine::Facet)
         {
           state = scanLoop; // Next state
         }
-        else if (!strcmp(cmd, "endsolid"))
+        else if (kind == StlLine::EndSolid)
         {
           // Finished with 'endsolid' - find next solid
           state = scanSolid;
@@ -616,7 +725,7 @@ bool vtkSTLReader::ReadASCIISTL(
       }
       case scanLoop:
       {
-        if (!strcmp(cmd, "outer")) // More pedantic => && !strcmp(arg, "loop")
+        if (kind == StlLine::Outer) // More pedantic => && !strcmp(arg, "loop")
         {
           state = scanVerts; // Next state
         }
@@ -628,36 +737,33 @@ bool vtkSTLReader::ReadASCIISTL(
       }
       case scanVerts:
       {
-        if (!strcmp(cmd, "vertex"))
+        if (kind == StlLine::Vertex)
         {
-          if (stlReadVertex(arg, vertCoord))
+          pts[vertOff] = newPts->InsertNextPoint(vertCoord);
+          ++vertOff; // Next vertex
+
+          if (vertOff >= 3)
           {
-            pts[vertOff] = newPts->InsertNextPoint(vertCoord);
-            ++vertOff; // Next vertex
+            // Finished this triangle.
+            vertOff = 0;
+            state = scanEndLoop; // Next state
 
-            if (vertOff >= 3)
+            // Save as cell
+            newPolys->InsertNextCell(3, pts);
+            if (scalars)
             {
-              // Finished this triangle.
-              vertOff = 0;
-              state = scanEndLoop; // Next state
-
-              // Save as cell
-              newPolys->InsertNextCell(3, pts);
-              if (scalars)
-              {
-                scalars->InsertNextValue(solidId);
-              }
-
-              if ((newPolys->GetNumberOfCells() % 5000) == 0)
-              {
-                this->UpdateProgress((newPolys->GetNumberOfCells() % 50000) / 50000.0);
-              }
+              scalars->InsertNextValue(solidId);
+            }
+
+            if ((newPolys->GetNumberOfCells() % 5000) == 0)
+            {
+              this->UpdateProgress((newPolys->GetNumberOfCells() % 50000) / 50000.0);
             }
           }
-          else
-          {
-            errorMessage = "Parse error reading STL vertex";
-          }
+        }
+        else if (kind == StlLine::BadVertex)
+        {
+          errorMessage = "Parse error reading STL vertex";
         }
         else
         {
@@ -667,7 +773,7 @@ bool vtkSTLReader::ReadASCIISTL(
       }
       case scanEndLoop:
       {
-        if (!strcmp(cmd, "endloop"))
+        if (kind == StlLine::EndLoop)
         {
           state = scanEndFacet; // Next state
         }
@@ -679,7 +785,7 @@ bool vtkSTLReader::ReadASCIISTL(
       }
       case scanEndFacet:
       {
-        if (!strcmp(cmd, "endfacet"))
+        if (kind == StlLine::EndFacet)
         {
           state = scanFacet; // Next facet, or endsolid
         }
@@ -691,7 +797,7 @@ bool vtkSTLReader::ReadASCIISTL(
       }
       case scanEndSolid:
       {
-        if (!strcmp(cmd, "endsolid"))
+        if (kind == StlLine::EndSolid)
         {
           state = scanSolid; // Start over again
         }
@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that reading compressed chunks concurrently and keeping previous time
+// steps in the cache give the same output as the default reader, when going
+// back and forth in time, and that a file rewritten in place is read again.
+
+// VTK_DEPRECATED_IN_9_7_0
+#define VTK_DEPRECATION_LEVEL 0
+
+#include "vtkCleanUnstructuredGrid.h"
+#include "vtkHDFReader.h"
+#include "vtkHDFWriter.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkSpatioTemporalHarmonicsSource.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdlib>
+#include <string>
+
+int TestHDFReaderChunksAndCache(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string fileName = std::string(tempDirCStr) + "/TestHDFReaderChunksAndCache.vtkhdf";
+  delete[] tempDirCStr;
+
+  vtkNew<vtkSpatioTemporalHarmonicsSource> harmonics;
+  vtkNew<vtkCleanUnstructuredGrid> clean;
+  clean->SetInputConnection(harmonics->GetOutputPort());
+
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputConnection(clean->GetOutputPort());
+  writer->SetFileName(fileName.c_str());
+  writer->SetWriteAllTimeSteps(true);
+  writer->SetChunkSize(500);
+  writer->SetCompressionLevel(4);
+  if (!writer->Write())
+  {
+    vtkLog(ERROR, "Cannot write " << fileName);
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkHDFReader> expected;
+  expected->SetFileName(fileName.c_str());
+
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->ReadChunksConcurrentlyOn();
+  reader->SetCacheMemoryLimit(64 * 1024 * 1024);
+
+  auto compare = [&](vtkIdType step)
+  {
+    expected->SetStep(step);
+    expected->Update();
+    reader->SetStep(step);
+    reader->Update();
+    if (!vtkTestUtilities::CompareDataObjects(expected->GetOutput(), reader->GetOutput()))
+    {
+      vtkLog(ERROR, "Wrong output for step " << step);
+      return false;
+    }
+    return true;
+  };
+
+  // First visit of each time step: nothing can be recalled from the cache,
+  // and the compressed arrays are read by chunks.
+  for (vtkIdType step : { 0, 1, 2, 3, 4, 5 })
+  {
+    if (!compare(step))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  if (reader->GetNumberOfArraysRecalledFromCache() != 0)
+  {
+    vtkLog(ERROR,
+      "Unexpected cache hits on first visits: " << reader->GetNumberOfArraysRecalledFromCache());
+    return EXIT_FAILURE;
+  }
+  if (reader->GetNumberOfArraysReadByChunks() == 0)
+  {
+    vtkLog(ERROR, "The chunks were not read concurrently");
+    return EXIT_FAILURE;
+  }
+
+  // Going back in time reuses the arrays of previous time steps, a new time
+  // step reads them from the file.
+  vtkIdType recalled = 0;
+  for (vtkIdType step : { 3, 1, 4, 0, 5, 19, 0 })
+  {
+    const vtkIdType readByChunks = reader->GetNumberOfArraysReadByChunks();
+    if (!compare(step))
+    {
+      return EXIT_FAILURE;
+    }
+    const bool hit = reader->GetNumberOfArraysRecalledFromCache() > recalled;
+    const bool read = reader->GetNumberOfArraysReadByChunks() > readByChunks;
+    if (hit != (step != 19) || read != (step == 19))
+    {
+      vtkLog(ERROR, "Wrong cache use for step " << step << ": hit " << hit << ", read " << read);
+      return EXIT_FAILURE;
+    }
+    recalled = reader->GetNumberOfArraysRecalledFromCache();
+  }
+  if (expected->GetNumberOfArraysRecalledFromCache() != 0 ||
+    expected->GetNumberOfArraysReadByChunks() != 0)
+  {
+    vtkLog(ERROR, "The default reader must not keep previous time steps nor read by chunks");
+    return EXIT_FAILURE;
+  }
+
+  // Reducing the limit releases cached arrays, the output must not change.
+  reader->SetCacheMemoryLimit(1024);
+  for (vtkIdType step : { 2, 4 })
+  {
+    if (!compare(step))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  if (reader->GetNumberOfArraysRecalledFromCache() != recalled)
+  {
+    vtkLog(ERROR, "Arrays recalled from a cache too small to keep them");
+    return EXIT_FAILURE;
+  }
+
+  // The memory limit enables the cache even when UseCache is off.
+  vtkNew<vtkHDFReader> uncached;
+  uncached->SetFileName(fileName.c_str());
+  uncached->UseCacheOff();
+  uncached->SetCacheMemoryLimit(64 * 1024 * 1024);
+  for (vtkIdType step : { 0, 1, 0 })
+  {
+    uncached->SetStep(step);
+    uncached->Update();
+  }
+  if (uncached->GetNumberOfArraysRecalledFromCache() == 0)
+  {
+    vtkLog(ERROR, "The memory limit did not enable the cache");
+    return EXIT_FAILURE;
+  }
+
+  // A file rewritten in place is not read from the cache.
+  harmonics->SetWholeExtent(0, 4, 0, 4, 0, 4);
+  if (!writer->Write())
+  {
+    vtkLog(ERROR, "Cannot rewrite " << fileName);
+    return EXIT_FAILURE;
+  }
+  vtkNew<vtkHDFReader> rewritten;
+  rewritten->SetFileName(fileName.c_str());
+  rewritten->SetStep(2);
+  rewritten->Update();
+  reader->SetCacheMemoryLimit(64 * 1024 * 1024);
+  reader->SetStep(2);
+  reader->Modified();
+  reader->Update();
+  if (!vtkTestUtilities::CompareDataObjects(rewritten->GetOutput(), reader->GetOutput()))
+  {
+    vtkLog(ERROR, "Arrays of the file before it was rewritten were reused");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that writing asynchronously gives the same files as writing
+// synchronously, for temporal and non temporal inputs, and that the errors of
+// the background thread are reported.
+
+#include "vtkCleanUnstructuredGrid.h"
+#include "vtkCommand.h"
+#include "vtkErrorCode.h"
+#include "vtkHDFReader.h"
+#include "vtkHDFWriter.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkSpatioTemporalHarmonicsSource.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+bool CompareFiles(const std::string& expectedName, const std::string& fileName, int numberOfSteps)
+{
+  vtkNew<vtkHDFReader> expected;
+  expected->SetFileName(expectedName.c_str());
+  vtkNew<vtkHDFReader> reader;
+  reader->SetFileName(fileName.c_str());
+  for (int step = 0; step < numberOfSteps; ++step)
+  {
+    expected->SetStep(step);
+    expected->Update();
+    reader->SetStep(step);
+    reader->Update();
+    if (!vtkTestUtilities::CompareDataObjects(expected->GetOutput(), reader->GetOutput()))
+    {
+      vtkLog(ERROR, "Wrong output for step " << step << " of " << fileName);
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestHDFWriterAsynchronous(int argc, char* argv[])
+{
+  char* tempDirCStr =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string prefix = std::string(tempDirCStr) + "/TestHDFWriterAsynchronous";
+  delete[] tempDirCStr;
+
+  vtkNew<vtkSpatioTemporalHarmonicsSource> harmonics;
+  vtkNew<vtkCleanUnstructuredGrid> clean;
+  clean->SetInputConnection(harmonics->GetOutputPort());
+
+  // Temporal input, written step by step on the background thread.
+  const std::string expectedName = prefix + "_sync.vtkhdf";
+  vtkNew<vtkHDFWriter> writer;
+  writer->SetInputConnection(clean->GetOutputPort());
+  writer->SetFileName(expectedName.c_str());
+  writer->SetWriteAllTimeSteps(true);
+  writer->SetCompressionLevel(4);
+  if (!writer->Write())
+  {
+    vtkLog(ERROR, "Cannot write " << expectedName);
+    return EXIT_FAILURE;
+  }
+
+  const std::string asyncName = prefix + "_async.vtkhdf";
+  writer->SetFileName(asyncName.c_str());
+  writer->WriteAsynchronouslyOn();
+  writer->SetMaximumNumberOfPendingSteps(1);
+  if (!writer->Write())
+  {
+    vtkLog(ERROR, "Cannot write " << asyncName);
+    return EXIT_FAILURE;
+  }
+  if (!writer->Flush())
+  {
+    vtkLog(ERROR, "Flush failed for " << asyncName);
+    return EXIT_FAILURE;
+  }
+  if (writer->GetNumberOfPendingSteps() != 0)
+  {
+    vtkLog(ERROR, "Steps are still pending after Flush");
+    return EXIT_FAILURE;
+  }
+  if (!::CompareFiles(expectedName, asyncName, 20))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Non temporal inputs, several files queued before being written. The last
+  // file is completed when the writer is deleted.
+  const std::string staticName = prefix + "_static.vtkhdf";
+  vtkNew<vtkHDFWriter> staticWriter;
+  staticWriter->SetInputConnection(clean->GetOutputPort());
+  staticWriter->SetFileName(staticName.c_str());
+  staticWriter->Write();
+
+  {
+    vtkNew<vtkHDFWriter> asyncWriter;
+    asyncWriter->SetInputConnection(clean->GetOutputPort());
+    asyncWriter->WriteAsynchronouslyOn();
+    asyncWriter->SetMaximumNumberOfPendingSteps(3);
+    for (int i = 0; i < 3; ++i)
+    {
+      const std::string fileName = prefix + "_static" + std::to_string(i) + ".vtkhdf";
+      asyncWriter->SetFileName(fileName.c_str());
+      asyncWriter->Write();
+    }
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    if (!::CompareFiles(staticName, prefix + "_static" + std::to_string(i) + ".vtkhdf", 1))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A file that cannot be created: the step is queued, its errors are
+  // reported when flushing.
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  vtkNew<vtkHDFWriter> failingWriter;
+  failingWriter->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  failingWriter->SetInputConnection(clean->GetOutputPort());
+  failingWriter->WriteAsynchronouslyOn();
+  const std::string failingName = prefix + "_missing_directory/file.vtkhdf";
+  failingWriter->SetFileName(failingName.c_str());
+  failingWriter->Write();
+  if (failingWriter->Flush() || failingWriter->GetErrorCode() == vtkErrorCode::NoError ||
+    !errorObserver->GetError())
+  {
+    vtkLog(ERROR, "The error of the background thread was not reported for " << failingName);
+    return EXIT_FAILURE;
+  }
+  if (errorObserver->CheckErrorMessage("Could not create file"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
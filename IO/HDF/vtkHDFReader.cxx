@@ -43,7 +43,10 @@
 
 #include <algorithm>
 #include <iostream>
+#include <list>
 #include <numeric>
+#include <sstream>
+#include <tuple>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -107,8 +110,15 @@ std::pair<bool, vtkSmartPointer<vtkDataArray>> ReadFromFileOrCache(ImplT* impl,
   }
   else
   {
-    array = vtk::TakeSmartPointer(mData ? impl->NewMetadataArray(name.c_str(), offset, size)
-                                        : impl->NewArray(tag, name.c_str(), offset, size));
+    if (cache)
+    {
+      array = vtkDataArray::SafeDownCast(cache->Recall(tag, cacheName, offset, size));
+    }
+    if (!array)
+    {
+      array = vtk::TakeSmartPointer(mData ? impl->NewMetadataArray(name.c_str(), offset, size)
+                                          : impl->NewArray(tag, name.c_str(), offset, size));
+    }
     if (!array)
     {
       vtkErrorWithObjectMacro(nullptr, "Cannot read the " + cacheName + " array from file");
@@ -203,7 +213,9 @@ bool ReadPolyDataPiece(T* impl, std::shared_ptr<CacheT> cache, vtkIdType pointOf
 //----------------------------------------------------------------------------
 /*
  * A data cache for avoiding supplemental read of data that doesn't change from
- * one time step to the next
+ * one time step to the next. Within a memory limit, it also keeps the arrays
+ * previously read for other extents, so that they are not read again when
+ * going back to a time step.
  */
 struct vtkHDFReader::DataCache
 {
@@ -254,8 +266,7 @@ struct vtkHDFReader::DataCache
   {
     std::vector<vtkIdType> buff(offset.size());
     std::copy(offset.begin(), offset.end(), buff.begin());
-    this->Map.emplace(KeyT{ attribute, name },
-      ValueT{ std::move(buff), static_cast<vtkSmartPointer<vtkAbstractArray>>(array) });
+    this->SetValue(KeyT{ attribute, name }, std::move(buff), array);
   }
 
   template <typename OffT>
@@ -271,11 +282,8 @@ struct vtkHDFReader::DataCache
   void Set(int attribute, const std::string& name, const OffT& offset, const OffT& size,
     vtkSmartPointer<ArrayT> array)
   {
-    auto key = KeyT{ attribute, name };
-    this->Map.erase(key); // remove previous cache if any
     std::vector<vtkIdType> buff{ static_cast<vtkIdType>(offset), static_cast<vtkIdType>(size) };
-    this->Map.emplace(
-      key, ValueT{ std::move(buff), static_cast<vtkSmartPointer<vtkAbstractArray>>(array) });
+    this->SetValue(KeyT{ attribute, name }, std::move(buff), array);
   }
 
   vtkSmartPointer<vtkAbstractArray> Get(int attribute, const std::string& name)
@@ -288,8 +296,122 @@ struct vtkHDFReader::DataCache
     return it->second.second;
   }
 
+  /*
+   * Return an array previously read for this extent, or nullptr if it is
+   * not kept anymore.
+   */
+  template <typename T>
+  vtkSmartPointer<vtkAbstractArray> Recall(
+    int attribute, const std::string& name, const T& currentOffset)
+  {
+    HistoryKeyT key{ attribute, name, std::vector<vtkIdType>(currentOffset.size()) };
+    std::transform(currentOffset.begin(), currentOffset.end(), std::get<2>(key).begin(),
+      [](auto value) { return static_cast<vtkIdType>(value); });
+    auto it = this->HistoryMap.find(key);
+    if (it == this->HistoryMap.end())
+    {
+      return nullptr;
+    }
+    this->History.splice(this->History.begin(), this->History, it->second);
+    ++this->NumberOfRecalls;
+    return it->second->Array;
+  }
+
+  template <typename OffT>
+  vtkSmartPointer<vtkAbstractArray> Recall(
+    int attribute, const std::string& name, const OffT& currentOffset, const OffT& currentSize)
+  {
+    std::vector<vtkIdType> buff{ static_cast<vtkIdType>(currentOffset),
+      static_cast<vtkIdType>(currentSize) };
+    return this->Recall(attribute, name, buff);
+  }
+
+  /*
+   * Number of arrays returned by Recall().
+   */
+  vtkIdType GetNumberOfRecalls() const { return this->NumberOfRecalls; }
+
+  /*
+   * Set the memory limit of previously read arrays, in bytes.
+   */
+  void SetMemoryLimit(vtkTypeUInt64 limit)
+  {
+    this->MemoryLimit = limit;
+    this->Evict();
+  }
+
+  /*
+   * Forget everything when the data is read from another file or stream.
+   */
+  void SetSource(const std::string& source)
+  {
+    if (source != this->Source)
+    {
+      this->Source = source;
+      this->Map.clear();
+      this->HistoryMap.clear();
+      this->History.clear();
+      this->HistorySize = 0;
+    }
+  }
+
 private:
+  using HistoryKeyT = std::tuple<int, std::string, std::vector<vtkIdType>>;
+  struct HistoryEntry
+  {
+    HistoryKeyT Key;
+    vtkSmartPointer<vtkAbstractArray> Array;
+    vtkTypeUInt64 Size;
+  };
+
+  template <typename ArrayT>
+  void SetValue(const KeyT& key, std::vector<vtkIdType>&& extent, vtkSmartPointer<ArrayT> array)
+  {
+    this->Remember(HistoryKeyT{ key.first, key.second, extent }, array);
+    this->Map.erase(key); // remove previous cache if any
+    this->Map.emplace(
+      key, ValueT{ std::move(extent), static_cast<vtkSmartPointer<vtkAbstractArray>>(array) });
+  }
+
+  void Remember(HistoryKeyT&& key, vtkAbstractArray* array)
+  {
+    const vtkTypeUInt64 size = static_cast<vtkTypeUInt64>(array->GetActualMemorySize()) * 1024;
+    if (this->MemoryLimit == 0 || size > this->MemoryLimit)
+    {
+      return;
+    }
+    auto it = this->HistoryMap.find(key);
+    if (it != this->HistoryMap.end())
+    {
+      this->HistorySize -= it->second->Size;
+      this->History.erase(it->second);
+      this->HistoryMap.erase(it);
+    }
+    this->History.push_front(HistoryEntry{ key, array, size });
+    this->HistoryMap.emplace(std::move(key), this->History.begin());
+    this->HistorySize += size;
+    this->Evict();
+  }
+
+  void Evict()
+  {
+    while (this->HistorySize > this->MemoryLimit)
+    {
+      this->HistorySize -= this->History.back().Size;
+      this->HistoryMap.erase(this->History.back().Key);
+      this->History.pop_back();
+    }
+  }
+
   std::map<KeyT, ValueT> Map;
+  std::string Source;
+
+  // Previously read arrays, the most recently used first
+  std::list<HistoryEntry> History;
+  std::map<HistoryKeyT, std::list<HistoryEntry>::iterator> HistoryMap;
+  vtkTypeUInt64 HistorySize = 0;
+  vtkTypeUInt64 MemoryLimit = 0;
+  vtkIdType NumberOfRecalls = 0;
 };
 
 //----------------------------------------------------------------------------
@@ -347,6 +469,11 @@ void vtkHDFReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Step: " << this->Step << "\n";
   os << indent << "TimeValue: " << this->TimeValue << "\n";
   os << indent << "TimeRange: " << this->TimeRange[0] << " - " << this->TimeRange[1] << "\n";
+  os << indent << "CacheMemoryLimit: " << this->CacheMemoryLimit << "\n";
+  os << indent << "ReadChunksConcurrently: " << (this->ReadChunksConcurrently ? "true" : "false")
+     << "\n";
+  os << indent << "NumberOfArraysRecalledFromCache: " << this->Cache->GetNumberOfRecalls() << "\n";
+  os << indent << "NumberOfArraysReadByChunks: " << this->NumberOfArraysReadByChunks << "\n";
   if (this->Stream)
   {
     os << indent << "Stream: "
@@ -773,8 +900,8 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkImageData* data)
         }
 
         bool cacheHit = false;
-        // VTK_DEPRECATED_IN_9_7_0 Remove this->UseCache
-        if (this->UseCache && this->Cache->CheckExistsAndEqual(attributeType, name, fileExtent))
+        if (this->IsCacheEnabled() &&
+          this->Cache->CheckExistsAndEqual(attributeType, name, fileExtent))
         {
           array = vtkDataArray::SafeDownCast(this->Cache->Get(attributeType, name));
           if (!array)
@@ -786,8 +913,14 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkImageData* data)
         }
         else
         {
-          if ((array = vtk::TakeSmartPointer(
-                 this->Impl->NewArray(attributeType, name.c_str(), fileExtent))) == nullptr)
+          if (this->IsCacheEnabled())
+          {
+            array =
+              vtkDataArray::SafeDownCast(this->Cache->Recall(attributeType, name, fileExtent));
+          }
+          if (!array &&
+            (array = vtk::TakeSmartPointer(
+               this->Impl->NewArray(attributeType, name.c_str(), fileExtent))) == nullptr)
           {
             vtkErrorMacro("Error reading array " << name);
             return 0;
@@ -801,8 +934,7 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkImageData* data)
           this->Impl->AttachDatasetAttributeToArray(attributeType, array, attributes);
           attributes->AddArray(array);
 
-          // VTK_DEPRECATED_IN_9_7_0 Remove this->UseCache
-          if (this->UseCache)
+          if (this->IsCacheEnabled())
           {
             this->Cache->Set(attributeType, name, fileExtent, array);
           }
@@ -848,8 +980,7 @@ int vtkHDFReader::AddFieldArrays(vtkDataObject* data)
     }
 
     bool cacheHit = false;
-    // VTK_DEPRECATED_IN_9_7_0 Remove this->UseCache
-    if (this->UseCache &&
+    if (this->IsCacheEnabled() &&
       this->Cache->CheckExistsAndEqual(vtkDataObject::FIELD, name, offset, size[1]))
     {
       array = this->Cache->Get(vtkDataObject::FIELD, name);
@@ -862,8 +993,13 @@ int vtkHDFReader::AddFieldArrays(vtkDataObject* data)
     }
     else
     {
-      if ((array = vtk::TakeSmartPointer(
-             this->Impl->NewFieldArray(name.c_str(), offset, size[1], size[0]))) == nullptr)
+      if (this->IsCacheEnabled())
+      {
+        array = this->Cache->Recall(vtkDataObject::FIELD, name, offset, size[1]);
+      }
+      if (!array &&
+        (array = vtk::TakeSmartPointer(
+           this->Impl->NewFieldArray(name.c_str(), offset, size[1], size[0]))) == nullptr)
       {
         vtkErrorMacro("Error reading array " << name);
         return 0;
@@ -874,8 +1010,7 @@ int vtkHDFReader::AddFieldArrays(vtkDataObject* data)
     if (!cacheHit)
     {
       data->GetAttributesAsFieldData(vtkDataObject::FIELD)->AddArray(array);
-      // VTK_DEPRECATED_IN_9_7_0 Remove this->UseCache
-      if (this->UseCache)
+      if (this->IsCacheEnabled())
       {
         this->Cache->Set(vtkDataObject::FIELD, name, offset, size[1], array);
       }
@@ -971,10 +1106,9 @@ bool vtkHDFReader::ReadAMRData(vtkOverlappingAMR* data, unsigned int maxLevel,
             }
           }
 
-          // VTK_DEPRECATED_IN_9_7_0 Remove this->UseCache
-          auto [cacheArray, array] =
-            ::ReadFromFileOrCache(this->Impl, this->UseCache ? this->Cache : nullptr, attributeType,
-              name, "_" + levelGroupName, offset + dataOffset, dataSize, false);
+          auto [cacheArray, array] = ::ReadFromFileOrCache(this->Impl,
+            this->IsCacheEnabled() ? this->Cache : nullptr, attributeType, name,
+            "_" + levelGroupName, offset + dataOffset, dataSize, false);
           if (!array)
           {
             vtkErrorMacro("Error reading array " << name);
@@ -1025,9 +1159,8 @@ int vtkHDFReader::Read(const std::vector<vtkIdType>& numberOfPoints,
   {
     std::string modifier = "_" + vtk::to_string(filePiece) + "_" + this->CompositeCachePath;
 
-    // VTK_DEPRECATED_IN_9_7_0 Remove this->UseCache
-    return ::ReadFromFileOrCache(
-      this->Impl, this->UseCache ? this->Cache : nullptr, tag, name, modifier, offset, size, mData);
+    return ::ReadFromFileOrCache(this->Impl, this->IsCacheEnabled() ? this->Cache : nullptr, tag,
+      name, modifier, offset, size, mData);
   };
 
   vtkIdType startingCellOffset = !geoOffsets.CellOffsets.empty() ? geoOffsets.CellOffsets[0] : 0;
@@ -1465,11 +1598,11 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkPolyData* data, vtkPartitione
       pieceData = pd.Get();
     }
 
-    // VTK_DEPRECATED_IN_9_7_0 Remove this->UseCache
     // populate the poly data piece
-    if (!::ReadPolyDataPiece(this->Impl, this->UseCache ? this->Cache : nullptr, pointOffset,
-          numberOfPoints[filePiece], cellOffsets, pieceNumberOfCells, connectivityOffsets,
-          pieceNumberOfConnectivityIds, filePiece, pieceData, this->CompositeCachePath))
+    if (!::ReadPolyDataPiece(this->Impl, this->IsCacheEnabled() ? this->Cache : nullptr,
+          pointOffset, numberOfPoints[filePiece], cellOffsets, pieceNumberOfCells,
+          connectivityOffsets, pieceNumberOfConnectivityIds, filePiece, pieceData,
+          this->CompositeCachePath))
     {
       vtkErrorMacro(
         "There was an error in reading the " << filePiece << " piece of the poly data file.");
@@ -1507,11 +1640,10 @@ int vtkHDFReader::Read(vtkInformation* outInfo, vtkPolyData* data, vtkPartitione
               arrayOffset += buff - startingOffsets[attributeType];
             }
           }
-          // VTK_DEPRECATED_IN_9_7_0 Remove this->UseCache
-          auto [cacheArray, array] =
-            ::ReadFromFileOrCache(this->Impl, this->UseCache ? this->Cache : nullptr, attributeType,
-              name, "_" + vtk::to_string(filePiece) + this->CompositeCachePath, arrayOffset,
-              numberOf[attributeType], false);
+          auto [cacheArray, array] = ::ReadFromFileOrCache(this->Impl,
+            this->IsCacheEnabled() ? this->Cache : nullptr, attributeType, name,
+            "_" + vtk::to_string(filePiece) + this->CompositeCachePath, arrayOffset,
+            numberOf[attributeType], false);
           if (!array)
           {
             vtkErrorMacro("Error reading array " << name);
@@ -2004,6 +2136,18 @@ int vtkHDFReader::RequestData(vtkInformation* vtkNotUsed(request),
     return 0;
   }
 
+  // A file rewritten in place or a modified stream is another source.
+  std::ostringstream source;
+  if (this->Stream)
+  {
+    source << this->Stream.Get() << ":" << this->Stream->GetMTime();
+  }
+  else
+  {
+    source << this->FileName << ":" << vtksys::SystemTools::FileLength(this->FileName) << ":"
+           << vtksys::SystemTools::ModifiedTime(this->FileName);
+  }
+  this->Cache->SetSource(source.str());
   this->CompositeCachePath.clear();
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
   if (!outInfo)
@@ -2130,6 +2274,30 @@ vtkMTimeType vtkHDFReader::GetMTime()
   return mtime;
 }
 
+//----------------------------------------------------------------------------
+void vtkHDFReader::SetCacheMemoryLimit(vtkTypeUInt64 limit)
+{
+  if (this->CacheMemoryLimit != limit)
+  {
+    this->CacheMemoryLimit = limit;
+    this->Cache->SetMemoryLimit(limit);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkHDFReader::IsCacheEnabled() const
+{
+  // VTK_DEPRECATED_IN_9_7_0 Remove this->UseCache
+  return this->UseCache || this->CacheMemoryLimit > 0;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkHDFReader::GetNumberOfArraysRecalledFromCache()
+{
+  return this->Cache->GetNumberOfRecalls();
+}
+
 //----------------------------------------------------------------------------
 // VTK_DEPRECATED_IN_9_7_0
 bool vtkHDFReader::GetUseCache()
@@ -172,6 +172,47 @@ public:
   virtual void UseCacheOff();
   ///@}
 
+  ///@{
+  /**
+   * Maximum memory, in bytes, used to keep arrays read for previous time
+   * steps or pieces, in addition to the arrays of the last read. When the
+   * reader goes back to a time step whose arrays are still in the cache,
+   * they are reused instead of being read again, the least recently used
+   * arrays being released first when the limit is reached. This makes
+   * going back and forth in time much faster, at the cost of memory.
+   * Default is 0: only the arrays of the last read are kept, to reuse the
+   * ones that do not change from one time step to the next.
+   */
+  void SetCacheMemoryLimit(vtkTypeUInt64 limit);
+  vtkGetMacro(CacheMemoryLimit, vtkTypeUInt64);
+  ///@}
+
+  ///@{
+  /**
+   * When on, arrays stored in chunked datasets compressed with deflate (with
+   * or without shuffle) are read chunk by chunk: the raw chunks are read from
+   * the file, then decompressed concurrently with vtkSMPTools, instead of
+   * being decompressed one after the other by HDF5. The arrays are the same
+   * in both cases. Other datasets are read as usual.
+   * Default is false.
+   */
+  vtkSetMacro(ReadChunksConcurrently, bool);
+  vtkGetMacro(ReadChunksConcurrently, bool);
+  vtkBooleanMacro(ReadChunksConcurrently, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Statistics of the reads since the reader was created: the number of
+   * arrays reused from the arrays kept for previous time steps or pieces
+   * (see CacheMemoryLimit), and the number of arrays read chunk by chunk (see
+   * ReadChunksConcurrently). The arrays reused because they do not change
+   * from one time step to the next are not counted.
+   */
+  vtkIdType GetNumberOfArraysRecalledFromCache();
+  vtkGetMacro(NumberOfArraysReadByChunks, vtkIdType);
+  ///@}
+
   ///@{
   /**
    * Choose the maximum level to read for AMR structures.
@@ -306,9 +347,18 @@ protected:
   unsigned int MaximumLevelsToReadByDefaultForAMR = 0;
 
   bool UseCache = true;
+  vtkTypeUInt64 CacheMemoryLimit = 0;
+  bool ReadChunksConcurrently = false;
+  vtkIdType NumberOfArraysReadByChunks = 0;
   struct DataCache;
   std::shared_ptr<DataCache> Cache;
 
+  /**
+   * Return true if the arrays are cached: when UseCache is on, or when
+   * CacheMemoryLimit is not 0.
+   */
+  bool IsCacheEnabled() const;
+
 private:
   vtkHDFReader(const vtkHDFReader&) = delete;
   void operator=(const vtkHDFReader&) = delete;
@@ -316,8 +316,7 @@ std::vector<std::string> vtkHDFReader::Implementation::GetOrderedChildrenOfGroup
 vtkDataArray* vtkHDFReader::Implementation::NewArray(
   int attributeType, const char* name, const std::vector<hsize_t>& fileExtent)
 {
-  return vtkHDFUtilities::NewArrayForGroup(
-    this->AttributeDataGroup[attributeType], name, fileExtent);
+  return this->NewArrayForGroup(this->AttributeDataGroup[attributeType], name, fileExtent);
 }
 
 //------------------------------------------------------------------------------
@@ -325,8 +324,7 @@ vtkDataArray* vtkHDFReader::Implementation::NewArray(
   int attributeType, const char* name, hsize_t offset, hsize_t size)
 {
   std::vector<hsize_t> fileExtent = { offset, offset + size };
-  return vtkHDFUtilities::NewArrayForGroup(
-    this->AttributeDataGroup[attributeType], name, fileExtent);
+  return this->NewArrayForGroup(this->AttributeDataGroup[attributeType], name, fileExtent);
 }
 
 //------------------------------------------------------------------------------
@@ -376,7 +374,21 @@ vtkDataArray* vtkHDFReader::Implementation::NewMetadataArray(
   const char* name, hsize_t offset, hsize_t size)
 {
   std::vector<hsize_t> fileExtent = { offset, offset + size };
-  return vtkHDFUtilities::NewArrayForGroup(this->VTKGroup, name, fileExtent);
+  return this->NewArrayForGroup(this->VTKGroup, name, fileExtent);
+}
+
+//------------------------------------------------------------------------------
+vtkDataArray* vtkHDFReader::Implementation::NewArrayForGroup(
+  hid_t group, const char* name, const std::vector<hsize_t>& fileExtent)
+{
+  bool readByChunks = false;
+  vtkDataArray* array = vtkHDFUtilities::NewArrayForGroup(
+    group, name, fileExtent, this->Reader->GetReadChunksConcurrently(), &readByChunks);
+  if (array && readByChunks)
+  {
+    ++this->Reader->NumberOfArraysReadByChunks;
+  }
+  return array;
 }
 
 //------------------------------------------------------------------------------
@@ -286,6 +286,13 @@ private:
   std::array<int, 2> Version;
   vtkHDFReader* Reader;
 
+  /**
+   * Read an array with the ReadChunksConcurrently option of the reader, and
+   * count the arrays read by chunks.
+   */
+  vtkDataArray* NewArrayForGroup(
+    hid_t group, const char* name, const std::vector<hsize_t>& fileExtent);
+
   ///@{
   /**
    * Specific methods and structure of AMR support.
@@ -16,6 +16,7 @@
 #include "vtkLongArray.h"
 #include "vtkLongLongArray.h"
 #include "vtkMemoryResourceStream.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkSignedCharArray.h"
 #include "vtkStringArray.h"
@@ -25,7 +26,10 @@
 #include "vtkUnsignedLongLongArray.h"
 #include "vtkUnsignedShortArray.h"
 
+#include "vtk_zlib.h"
+
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <iterator>
 #include <sstream>
@@ -160,10 +164,274 @@ vtkDataArray* NewVtkDataArray()
   }
 }
 
+//------------------------------------------------------------------------------
+/**
+ * Description of a chunked dataset whose chunks can be decoded without HDF5:
+ * its filters are only deflate and shuffle, and it is stored with the
+ * memory type so no conversion is needed.
+ */
+struct ChunkLayout
+{
+  std::vector<hsize_t> ChunkDims;
+  std::vector<H5Z_filter_t> Filters;
+  std::size_t ElementSize = 0;
+  std::size_t ChunkBytes = 0;
+};
+
+//------------------------------------------------------------------------------
+bool GetChunkLayout(hid_t dataset, hid_t nativeType, std::size_t rank, ChunkLayout& layout)
+{
+  vtkHDF::ScopedH5PHandle plist = H5Dget_create_plist(dataset);
+  if (plist < 0 || H5Pget_layout(plist) != H5D_CHUNKED)
+  {
+    return false;
+  }
+  layout.ChunkDims.resize(rank);
+  if (H5Pget_chunk(plist, static_cast<int>(rank), layout.ChunkDims.data()) !=
+    static_cast<int>(rank))
+  {
+    return false;
+  }
+  int numberOfFilters = H5Pget_nfilters(plist);
+  for (int i = 0; i < numberOfFilters; ++i)
+  {
+    unsigned int flags = 0;
+    std::size_t numberOfValues = 0;
+    H5Z_filter_t filter =
+      H5Pget_filter2(plist, i, &flags, &numberOfValues, nullptr, 0, nullptr, nullptr);
+    if (filter != H5Z_FILTER_DEFLATE && filter != H5Z_FILTER_SHUFFLE)
+    {
+      return false;
+    }
+    layout.Filters.push_back(filter);
+  }
+  vtkHDF::ScopedH5THandle fileType = H5Dget_type(dataset);
+  if (fileType < 0 || H5Tequal(fileType, nativeType) <= 0)
+  {
+    return false;
+  }
+  layout.ElementSize = H5Tget_size(nativeType);
+  layout.ChunkBytes = layout.ElementSize;
+  for (hsize_t dim : layout.ChunkDims)
+  {
+    layout.ChunkBytes *= dim;
+  }
+  return layout.ChunkBytes > 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+ * Undo the filters of a raw chunk, in the reverse order of the pipeline,
+ * skipping the filters flagged in `mask`. `scratch` is a work buffer.
+ */
+bool DecodeChunk(const ChunkLayout& layout, unsigned int mask, std::vector<unsigned char>& chunk,
+  std::vector<unsigned char>& scratch)
+{
+  for (std::size_t i = layout.Filters.size(); i-- > 0;)
+  {
+    if (mask & (1u << i))
+    {
+      continue;
+    }
+    scratch.resize(layout.ChunkBytes);
+    if (layout.Filters[i] == H5Z_FILTER_DEFLATE)
+    {
+      uLongf size = static_cast<uLongf>(scratch.size());
+      if (uncompress(scratch.data(), &size, chunk.data(), static_cast<uLong>(chunk.size())) !=
+          Z_OK ||
+        size != scratch.size())
+      {
+        return false;
+      }
+    }
+    else
+    {
+      if (chunk.size() != layout.ChunkBytes)
+      {
+        return false;
+      }
+      // Bytes are grouped by significance, trailing bytes are left as is.
+      const std::size_t elementSize = layout.ElementSize;
+      const std::size_t numberOfElements = chunk.size() / elementSize;
+      for (std::size_t byte = 0; byte < elementSize; ++byte)
+      {
+        const unsigned char* source = chunk.data() + byte * numberOfElements;
+        for (std::size_t element = 0; element < numberOfElements; ++element)
+        {
+          scratch[element * elementSize + byte] = source[element];
+        }
+      }
+      std::copy(chunk.begin() + numberOfElements * elementSize, chunk.end(),
+        scratch.begin() + numberOfElements * elementSize);
+    }
+    std::swap(chunk, scratch);
+  }
+  return chunk.size() == layout.ChunkBytes;
+}
+
+//------------------------------------------------------------------------------
+/**
+ * Copy the part of a decoded chunk starting at `chunkStart` that is inside
+ * the selection (`start`, `count`) to the selection buffer `data`.
+ */
+void CopyChunkToSelection(const ChunkLayout& layout, const unsigned char* chunk,
+  const hsize_t* chunkStart, const std::vector<hsize_t>& start, const std::vector<hsize_t>& count,
+  unsigned char* data)
+{
+  const std::size_t rank = count.size();
+  std::vector<hsize_t> first(rank), last(rank);
+  for (std::size_t d = 0; d < rank; ++d)
+  {
+    first[d] = std::max(chunkStart[d], start[d]);
+    last[d] = std::min(chunkStart[d] + layout.ChunkDims[d], start[d] + count[d]);
+  }
+  const std::size_t runBytes = (last[rank - 1] - first[rank - 1]) * layout.ElementSize;
+  std::vector<hsize_t> index = first;
+  while (true)
+  {
+    std::size_t chunkOffset = 0;
+    std::size_t dataOffset = 0;
+    for (std::size_t d = 0; d < rank; ++d)
+    {
+      chunkOffset = chunkOffset * layout.ChunkDims[d] + (index[d] - chunkStart[d]);
+      dataOffset = dataOffset * count[d] + (index[d] - start[d]);
+    }
+    std::copy_n(chunk + chunkOffset * layout.ElementSize, runBytes,
+      data + dataOffset * layout.ElementSize);
+
+    // Next run: increment the index on all dimensions but the last one.
+    std::size_t d = rank - 1;
+    while (d > 0)
+    {
+      --d;
+      if (++index[d] < last[d])
+      {
+        break;
+      }
+      index[d] = first[d];
+      if (d == 0)
+      {
+        return;
+      }
+    }
+    if (rank == 1)
+    {
+      return;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+/**
+ * Read the hyperslab (`start`, `count`) of a chunked dataset chunk by chunk:
+ * raw chunks are read by batches with H5Dread_chunk, then inflated and
+ * copied to `data` concurrently with vtkSMPTools, as HDF5 itself is not
+ * thread safe. Return false if the dataset is not suitable, or if anything
+ * fails, in which case the caller should read it with H5Dread.
+ */
+bool ReadChunksConcurrently(hid_t dataset, hid_t nativeType, const std::vector<hsize_t>& start,
+  const std::vector<hsize_t>& count, void* data)
+{
+  const std::size_t rank = count.size();
+  ChunkLayout layout;
+  if (!::GetChunkLayout(dataset, nativeType, rank, layout))
+  {
+    return false;
+  }
+
+  // Chunk grid coordinates of the chunks intersecting the selection
+  std::vector<hsize_t> firstChunk(rank), lastChunk(rank);
+  std::size_t numberOfChunks = 1;
+  for (std::size_t d = 0; d < rank; ++d)
+  {
+    if (count[d] == 0)
+    {
+      return false;
+    }
+    firstChunk[d] = start[d] / layout.ChunkDims[d];
+    lastChunk[d] = (start[d] + count[d] - 1) / layout.ChunkDims[d];
+    numberOfChunks *= lastChunk[d] - firstChunk[d] + 1;
+  }
+  if (numberOfChunks < 2)
+  {
+    return false;
+  }
+  std::vector<hsize_t> chunkStarts;
+  chunkStarts.reserve(numberOfChunks * rank);
+  std::vector<hsize_t> chunkIndex = firstChunk;
+  for (std::size_t c = 0; c < numberOfChunks; ++c)
+  {
+    for (std::size_t d = 0; d < rank; ++d)
+    {
+      chunkStarts.push_back(chunkIndex[d] * layout.ChunkDims[d]);
+    }
+    for (std::size_t d = rank; d-- > 0;)
+    {
+      if (++chunkIndex[d] <= lastChunk[d])
+      {
+        break;
+      }
+      chunkIndex[d] = firstChunk[d];
+    }
+  }
+
+  // Unallocated chunks and parallel file drivers make HDF5 errors that are
+  // handled by falling back to H5Dread.
+  ::ScopedH5EQuiet quiet;
+  const std::size_t batchSize =
+    8 * static_cast<std::size_t>(std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads()));
+  std::vector<std::vector<unsigned char>> chunks(std::min(batchSize, numberOfChunks));
+  std::vector<unsigned int> masks(chunks.size());
+  for (std::size_t batchStart = 0; batchStart < numberOfChunks; batchStart += batchSize)
+  {
+    const std::size_t batchEnd = std::min(batchStart + batchSize, numberOfChunks);
+    for (std::size_t c = batchStart; c < batchEnd; ++c)
+    {
+      const hsize_t* chunkStart = chunkStarts.data() + c * rank;
+      hsize_t storageSize = 0;
+      if (H5Dget_chunk_storage_size(dataset, chunkStart, &storageSize) < 0 || storageSize == 0)
+      {
+        return false;
+      }
+      std::vector<unsigned char>& chunk = chunks[c - batchStart];
+      chunk.resize(static_cast<std::size_t>(storageSize));
+      uint32_t mask = 0;
+      if (H5Dread_chunk(dataset, H5P_DEFAULT, chunkStart, &mask, chunk.data()) < 0)
+      {
+        return false;
+      }
+      masks[c - batchStart] = mask;
+    }
+
+    std::atomic<bool> failed(false);
+    vtkSMPTools::For(batchStart, batchEnd,
+      [&](std::size_t begin, std::size_t end)
+      {
+        std::vector<unsigned char> scratch;
+        for (std::size_t c = begin; c < end && !failed; ++c)
+        {
+          std::vector<unsigned char>& chunk = chunks[c - batchStart];
+          if (!::DecodeChunk(layout, masks[c - batchStart], chunk, scratch))
+          {
+            failed = true;
+            return;
+          }
+          ::CopyChunkToSelection(layout, chunk.data(), chunkStarts.data() + c * rank, start,
+            count, static_cast<unsigned char*>(data));
+        }
+      });
+    if (failed)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 //------------------------------------------------------------------------------
 template <typename T>
-bool NewArray(
-  hid_t dataset, const std::vector<hsize_t>& fileExtent, hsize_t numberOfComponents, T* data)
+bool NewArray(hid_t dataset, const std::vector<hsize_t>& fileExtent, hsize_t numberOfComponents,
+  T* data, bool readChunksConcurrently, bool* readByChunks)
 {
   hid_t nativeType = vtkHDFUtilities::TemplateTypeToHdfNativeType<T>();
   std::vector<hsize_t> count(fileExtent.size() / 2), start(fileExtent.size() / 2);
@@ -205,6 +473,14 @@ bool NewArray(
   }
 
   // read hyperslab
+  if (readChunksConcurrently && ::ReadChunksConcurrently(dataset, nativeType, start, count, data))
+  {
+    if (readByChunks)
+    {
+      *readByChunks = true;
+    }
+    return true;
+  }
   if (H5Dread(dataset, nativeType, memspace, filespace, H5P_DEFAULT, data) < 0)
   {
     std::stringstream starts;
@@ -227,8 +503,8 @@ bool NewArray(
 
 //------------------------------------------------------------------------------
 template <typename T>
-vtkDataArray* NewArray(
-  hid_t dataset, const std::vector<hsize_t>& fileExtent, hsize_t numberOfComponents)
+vtkDataArray* NewArray(hid_t dataset, const std::vector<hsize_t>& fileExtent,
+  hsize_t numberOfComponents, bool readChunksConcurrently, bool* readByChunks)
 {
   int numberOfTuples = 1;
   size_t ndims = fileExtent.size() / 2;
@@ -241,7 +517,8 @@ vtkDataArray* NewArray(
   array->SetNumberOfComponents(numberOfComponents);
   array->SetNumberOfTuples(numberOfTuples);
   T* data = array->GetPointer(0);
-  if (!::NewArray(dataset, fileExtent, numberOfComponents, data))
+  if (!::NewArray(
+        dataset, fileExtent, numberOfComponents, data, readChunksConcurrently, readByChunks))
   {
     array->Delete();
     array = nullptr;
@@ -249,8 +526,8 @@ vtkDataArray* NewArray(
   return array;
 }
 
-using ArrayReader = vtkDataArray*(
-  hid_t dataset, const std::vector<hsize_t>& fileExtent, hsize_t numberOfComponents);
+using ArrayReader = vtkDataArray*(hid_t dataset, const std::vector<hsize_t>& fileExtent,
+  hsize_t numberOfComponents, bool readChunksConcurrently, bool* readByChunks);
 using TypeReaderMap = std::map<::TypeDescription, ArrayReader*>;
 
 //------------------------------------------------------------------------------
@@ -946,8 +1223,13 @@ hid_t vtkHDFUtilities::OpenDataSet(
 
 //------------------------------------------------------------------------------
 vtkDataArray* vtkHDFUtilities::NewArrayForGroup(hid_t dataset, hid_t nativeType,
-  const std::vector<hsize_t>& dims, const std::vector<hsize_t>& parameterExtent)
+  const std::vector<hsize_t>& dims, const std::vector<hsize_t>& parameterExtent,
+  bool readChunksConcurrently, bool* readByChunks)
 {
+  if (readByChunks)
+  {
+    *readByChunks = false;
+  }
   vtkDataArray* array = nullptr;
   try
   {
@@ -998,7 +1280,7 @@ vtkDataArray* vtkHDFUtilities::NewArrayForGroup(hid_t dataset, hid_t nativeType,
     }
     else
     {
-      array = builder(dataset, extent, numberOfComponents);
+      array = builder(dataset, extent, numberOfComponents, readChunksConcurrently, readByChunks);
     }
   }
   catch (const std::exception& e)
@@ -1010,9 +1292,13 @@ vtkDataArray* vtkHDFUtilities::NewArrayForGroup(hid_t dataset, hid_t nativeType,
 }
 
 //------------------------------------------------------------------------------
-vtkDataArray* vtkHDFUtilities::NewArrayForGroup(
-  hid_t group, const char* name, const std::vector<hsize_t>& parameterExtent)
+vtkDataArray* vtkHDFUtilities::NewArrayForGroup(hid_t group, const char* name,
+  const std::vector<hsize_t>& parameterExtent, bool readChunksConcurrently, bool* readByChunks)
 {
+  if (readByChunks)
+  {
+    *readByChunks = false;
+  }
   std::vector<hsize_t> dims;
   hid_t tempNativeType = H5I_INVALID_HID;
   vtkHDF::ScopedH5DHandle dataset =
@@ -1023,7 +1309,8 @@ vtkDataArray* vtkHDFUtilities::NewArrayForGroup(
     return nullptr;
   }
 
-  return vtkHDFUtilities::NewArrayForGroup(dataset, nativeType, dims, parameterExtent);
+  return vtkHDFUtilities::NewArrayForGroup(
+    dataset, nativeType, dims, parameterExtent, readChunksConcurrently, readByChunks);
 }
 
 //------------------------------------------------------------------------------
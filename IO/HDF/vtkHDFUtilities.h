@@ -269,11 +269,18 @@ VTKIOHDF_EXPORT hid_t OpenDataSet(
  * fileExtent.size()>>1 == ndims - in this case we read a scalar
  * fileExtent.size()>>1 + 1 == ndims - in this case we read an array with
  *                           the number of components > 1.
+ * If readChunksConcurrently is true and the dataset is chunked with only
+ * deflate and shuffle filters, the chunks covering the slab are read
+ * directly and decompressed concurrently with vtkSMPTools. Otherwise, or if
+ * this fails, the slab is read with H5Dread. If not null, readByChunks is set
+ * to whether the chunks were read directly.
  */
 VTKIOHDF_EXPORT vtkDataArray* NewArrayForGroup(hid_t dataset, hid_t nativeType,
-  const std::vector<hsize_t>& dims, const std::vector<hsize_t>& parameterExtent);
-VTKIOHDF_EXPORT vtkDataArray* NewArrayForGroup(
-  hid_t group, const char* name, const std::vector<hsize_t>& parameterExtent);
+  const std::vector<hsize_t>& dims, const std::vector<hsize_t>& parameterExtent,
+  bool readChunksConcurrently = false, bool* readByChunks = nullptr);
+VTKIOHDF_EXPORT vtkDataArray* NewArrayForGroup(hid_t group, const char* name,
+  const std::vector<hsize_t>& parameterExtent, bool readChunksConcurrently = false,
+  bool* readByChunks = nullptr);
 ///@}
 
 /**
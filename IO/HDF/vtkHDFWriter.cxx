@@ -3,6 +3,7 @@
 #include "vtkHDFWriter.h"
 
 #include "vtkAbstractArray.h"
+#include "vtkCallbackCommand.h"
 #include "vtkDataAssembly.h"
 #include "vtkDataObjectTree.h"
 #include "vtkDataObjectTreeIterator.h"
@@ -23,6 +24,7 @@
 #include "vtkPartitionedDataSetCollection.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringFormatter.h"
+#include "vtkThreadedCallbackQueue.h"
 
 #include "vtkPolyData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -79,6 +81,31 @@ std::string GetExternalBlockFileName(const std::string&& filename, const std::st
   // <FileName>_<BlockName>.vtkhdf
   return filename + "_" + blockname + ".vtkhdf";
 }
+
+/**
+ * Return the queue used for asynchronous writes. Its single thread is shared by all the
+ * writers, so that only one of them uses HDF5 at a time. Each writer keeps a reference to it,
+ * so that it outlives the writers flushed during the destruction of static objects.
+ */
+vtkSmartPointer<vtkThreadedCallbackQueue> GetWritingQueue()
+{
+  static vtkSmartPointer<vtkThreadedCallbackQueue> queue =
+    vtkSmartPointer<vtkThreadedCallbackQueue>::New();
+  return queue;
+}
+
+/**
+ * Append the error messages of a writer used on the background thread to a string.
+ */
+void RecordStepError(vtkObject*, unsigned long, void* clientData, void* callData)
+{
+  std::string* errors = static_cast<std::string*>(clientData);
+  if (!errors->empty())
+  {
+    *errors += "\n";
+  }
+  *errors += static_cast<const char*>(callData);
+}
 }
 
 //------------------------------------------------------------------------------
@@ -102,6 +129,7 @@ vtkHDFWriter::vtkHDFWriter()
 //------------------------------------------------------------------------------
 vtkHDFWriter::~vtkHDFWriter()
 {
+  this->Flush();
   this->SetFileName(nullptr);
   if (this->UsesDummyController)
   {
@@ -185,7 +213,14 @@ int vtkHDFWriter::RequestData(vtkInformation* request,
     return 1;
   }
 
-  this->WriteData();
+  if (this->WriteAsynchronously && this->NbPieces == 1)
+  {
+    this->WriteDataAsynchronously();
+  }
+  else
+  {
+    this->WriteData();
+  }
 
   if (this->IsTemporal)
   {
@@ -236,10 +271,141 @@ void vtkHDFWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Overwrite: " << (this->Overwrite ? "yes" : "no") << "\n";
   os << indent << "WriteAllTimeSteps: " << (this->WriteAllTimeSteps ? "yes" : "no") << "\n";
   os << indent << "ChunkSize: " << this->ChunkSize << "\n";
+  os << indent << "WriteAsynchronously: " << (this->WriteAsynchronously ? "yes" : "no") << "\n";
+  os << indent << "MaximumNumberOfPendingSteps: " << this->MaximumNumberOfPendingSteps << "\n";
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::Flush()
+{
+  bool success = true;
+  while (!this->Impl->PendingSteps.empty())
+  {
+    success &= this->PopPendingStep();
+  }
+  return success;
+}
+
+//------------------------------------------------------------------------------
+bool vtkHDFWriter::PopPendingStep()
+{
+  auto step = this->Impl->PendingSteps.front();
+  this->Impl->PendingSteps.pop_front();
+  const std::string& errors = step->Get();
+  if (!errors.empty())
+  {
+    vtkErrorMacro(<< "Could not write a step asynchronously: " << errors);
+    this->SetErrorCode(vtkErrorCode::UnknownError);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+int vtkHDFWriter::GetNumberOfPendingSteps()
+{
+  return this->Impl->NumberOfPendingSteps;
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFWriter::WriteDataAsynchronously()
+{
+  this->SetErrorCode(vtkErrorCode::NoError);
+  vtkDataObject* input = vtkDataObject::SafeDownCast(this->GetInput());
+  if (!input)
+  {
+    vtkErrorMacro(<< "A vtkDataObject input is required.");
+    return;
+  }
+
+  // The steps of a file are written by a writer holding a copy of the settings, so that this
+  // one can be modified and used again while they are pending.
+  if (this->CurrentTimeIndex == 0 || !this->Impl->StepWriter)
+  {
+    auto writer = vtkSmartPointer<vtkHDFWriter>::New();
+    writer->SetFileName(this->FileName);
+    writer->Overwrite = this->Overwrite;
+    writer->WriteAllTimeSteps = this->WriteAllTimeSteps;
+    writer->UseExternalComposite = this->UseExternalComposite;
+    writer->UseExternalTimeSteps = this->UseExternalTimeSteps;
+    writer->UseExternalPartitions = this->UseExternalPartitions;
+    writer->ChunkSize = this->ChunkSize;
+    writer->CompressionLevel = this->CompressionLevel;
+    writer->timeSteps = this->timeSteps;
+    writer->IsTemporal = this->IsTemporal;
+    writer->NumberOfTimeSteps = this->NumberOfTimeSteps;
+    if (!writer->UsesDummyController)
+    {
+      // Never synchronize with other processes from the writing thread. The global controller
+      // was not registered by the writer.
+      writer->Controller = nullptr;
+      writer->UsesDummyController = true;
+      writer->SetController(vtkDummyController::New());
+    }
+    writer->NbPieces = 1;
+    writer->CurrentPiece = 0;
+    // The errors of a step are reported by this writer once the step is written.
+    vtkNew<vtkCallbackCommand> errorObserver;
+    errorObserver->SetCallback(::RecordStepError);
+    errorObserver->SetClientData(&writer->Impl->StepErrors);
+    writer->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+    this->Impl->StepWriter = writer;
+  }
+
+  // Block while too many steps are pending. Steps of a writer are written in order, so the
+  // oldest futures are the ones of the written steps. The errors of the written steps are
+  // reported now.
+  auto& pendingSteps = this->Impl->PendingSteps;
+  while (this->Impl->NumberOfPendingSteps >= this->MaximumNumberOfPendingSteps &&
+    !pendingSteps.empty())
+  {
+    this->PopPendingStep();
+  }
+  while (pendingSteps.size() > static_cast<std::size_t>(this->Impl->NumberOfPendingSteps))
+  {
+    this->PopPendingStep();
+  }
+
+  auto snapshot = vtk::TakeSmartPointer(input->NewInstance());
+  snapshot->ShallowCopy(input);
+  const int timeIndex = this->CurrentTimeIndex;
+  const bool lastStep = !this->IsTemporal || timeIndex + 1 >= this->NumberOfTimeSteps;
+  vtkSmartPointer<vtkHDFWriter> writer = this->Impl->StepWriter;
+  std::atomic<int>* numberOfPendingSteps = &this->Impl->NumberOfPendingSteps;
+  if (!this->Impl->Queue)
+  {
+    this->Impl->Queue = ::GetWritingQueue();
+  }
+  ++(*numberOfPendingSteps);
+  pendingSteps.emplace_back(this->Impl->Queue->Push(
+    [writer, snapshot, timeIndex, lastStep, numberOfPendingSteps]()
+    {
+      writer->Impl->StepErrors.clear();
+      writer->CurrentTimeIndex = timeIndex;
+      writer->WriteDataObject(snapshot);
+      if (lastStep)
+      {
+        writer->Impl->CloseFile();
+      }
+      std::string errors = std::move(writer->Impl->StepErrors);
+      --(*numberOfPendingSteps);
+      return errors;
+    }));
+
+  if (lastStep)
+  {
+    this->Impl->StepWriter = nullptr;
+  }
 }
 
 //------------------------------------------------------------------------------
 void vtkHDFWriter::WriteData()
+{
+  this->WriteDataObject(vtkDataObject::SafeDownCast(this->GetInput()));
+}
+
+//------------------------------------------------------------------------------
+void vtkHDFWriter::WriteDataObject(vtkDataObject* input)
 {
   this->Impl->SetSubFilesReady(false);
 
@@ -267,8 +433,6 @@ void vtkHDFWriter::WriteData()
   // Wait for the file to be created
   this->Controller->Barrier();
 
-  vtkDataObject* input = vtkDataObject::SafeDownCast(this->GetInput());
-
   // Write the time step data in an external file
   if (this->NbPieces == 1 && this->IsTemporal && this->UseExternalTimeSteps)
   {
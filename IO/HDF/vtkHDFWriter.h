@@ -182,6 +182,55 @@ public:
   vtkGetMacro(UseExternalPartitions, bool);
   ///@}
 
+  ///@{
+  /**
+   * When set, the steps are compressed and written on a background thread, and Write()
+   * returns as soon as the current step is queued. The queued step shares the arrays of the
+   * input through a shallow copy of it: they must not be modified in place until the step is
+   * written, new arrays should be given to the writer instead. The settings of the writer are
+   * copied when a file is started, so the writer can be modified and used again for another file
+   * while the steps of the previous one are written.
+   *
+   * All asynchronous writers share a single background thread, so they never use HDF5 at the
+   * same time. If HDF5 is not built thread-safe, it must not be used elsewhere in the application
+   * while steps are pending, see Flush().
+   *
+   * This option is ignored when writing with more than one process, as the processes synchronize
+   * while writing.
+   * Default is false.
+   */
+  vtkSetMacro(WriteAsynchronously, bool);
+  vtkGetMacro(WriteAsynchronously, bool);
+  vtkBooleanMacro(WriteAsynchronously, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Maximum number of steps queued or being written when WriteAsynchronously is set. When it is
+   * reached, writing another step blocks until the oldest pending step is written, which bounds
+   * the memory used by the queued steps.
+   * Default is 2: a step can be queued while the previous one is written.
+   */
+  vtkSetClampMacro(MaximumNumberOfPendingSteps, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfPendingSteps, int);
+  ///@}
+
+  /**
+   * Block until all the steps queued by this writer are written. Once the last time step of a
+   * file is written, the file is closed and complete. This is also done when the writer is
+   * deleted.
+   *
+   * Return false if one of the steps could not be written: its errors are then reported by this
+   * writer, and the error code is set. The errors of the steps written while writing another
+   * step are reported by the Write() call that waited for them, which then returns false.
+   */
+  bool Flush();
+
+  /**
+   * Get the number of steps of this writer that are queued or being written.
+   */
+  int GetNumberOfPendingSteps();
+
 protected:
   /**
    * Override vtkWriter's ProcessRequest method, in order to dispatch the request
@@ -212,6 +261,22 @@ private:
    */
   void WriteData() override;
 
+  /**
+   * Write `input` as the step CurrentTimeIndex.
+   */
+  void WriteDataObject(vtkDataObject* input);
+
+  /**
+   * Queue a shallow copy of the input, to be written as the current step on the background
+   * thread.
+   */
+  void WriteDataAsynchronously();
+
+  /**
+   * Wait for the oldest pending step and report its errors. Return false on error.
+   */
+  bool PopPendingStep();
+
   /**
    * Dispatch the input vtkDataObject to the right writing function, depending on its dynamic type.
    * Data will be written in the specified group, which must already exist.
@@ -403,6 +468,8 @@ private:
   bool UseExternalPartitions = false;
   int ChunkSize = 25000;
   int CompressionLevel = 0;
+  bool WriteAsynchronously = false;
+  int MaximumNumberOfPendingSteps = 2;
 
   // Temporal-related private variables
   std::vector<double> timeSteps;
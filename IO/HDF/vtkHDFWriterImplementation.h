@@ -15,9 +15,13 @@
 #include "vtkHDF5ScopedHandle.h"
 #include "vtkHDFUtilities.h"
 #include "vtkHDFWriter.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadedCallbackQueue.h"
 #include "vtkType.h"
 
 #include <array>
+#include <atomic>
+#include <deque>
 #include <string>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -313,6 +317,23 @@ public:
   Implementation(vtkHDFWriter* writer);
   virtual ~Implementation();
 
+  ///@{
+  /**
+   * State of asynchronous writes: the queue of the background thread, the writer of the file
+   * being written, the futures of the steps pushed to the queue, oldest first, holding the
+   * errors of each step, and the number of steps not written yet.
+   */
+  vtkSmartPointer<vtkThreadedCallbackQueue> Queue;
+  vtkSmartPointer<vtkHDFWriter> StepWriter;
+  std::deque<vtkThreadedCallbackQueue::SharedFuturePointer<std::string>> PendingSteps;
+  std::atomic<int> NumberOfPendingSteps{ 0 };
+  ///@}
+
+  /**
+   * Errors reported by the writer of a step while it is written on the background thread.
+   */
+  std::string StepErrors;
+
 private:
   vtkHDFWriter* Writer;
   vtkHDF::ScopedH5FHandle File;
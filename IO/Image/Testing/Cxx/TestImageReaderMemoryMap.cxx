@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that vtkImageReader gives the same output when memory mapping a raw
+// file, for the whole extent and for a range of slices.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageReader.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+
+#include <vtksys/FStream.hxx>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+bool CompareReads(const std::string& fileName, const int* extent)
+{
+  vtkNew<vtkImageReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetFileDimensionality(3);
+  reader->SetDataScalarTypeToUnsignedShort();
+  reader->SetNumberOfScalarComponents(2);
+  reader->SetDataExtent(0, 31, 0, 23, 0, 15);
+  reader->SetHeaderSize(16);
+
+  reader->UpdateExtent(extent);
+  vtkNew<vtkImageData> expected;
+  expected->DeepCopy(reader->GetOutput());
+
+  reader->MemoryMapFileOn();
+  reader->UpdateExtent(extent);
+  vtkImageData* mapped = reader->GetOutput();
+
+  int mappedExtent[6];
+  mapped->GetExtent(mappedExtent);
+  for (int i = 0; i < 6; ++i)
+  {
+    if (mappedExtent[i] != extent[i])
+    {
+      std::cerr << "Error: wrong extent for the mapped image" << std::endl;
+      return false;
+    }
+  }
+  vtkDataArray* expectedScalars = expected->GetPointData()->GetScalars();
+  vtkDataArray* mappedScalars = mapped->GetPointData()->GetScalars();
+  if (!mappedScalars || mappedScalars->GetNumberOfComponents() != 2 ||
+    mappedScalars->GetNumberOfTuples() != expectedScalars->GetNumberOfTuples())
+  {
+    std::cerr << "Error: wrong scalars for the mapped image" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < expectedScalars->GetNumberOfValues(); ++i)
+  {
+    if (mappedScalars->GetComponent(i / 2, i % 2) != expectedScalars->GetComponent(i / 2, i % 2))
+    {
+      std::cerr << "Error: wrong value " << i << " for the mapped image" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestImageReaderMemoryMap(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string fileName = std::string(tempDir) + "/TestImageReaderMemoryMap.raw";
+  delete[] tempDir;
+
+  std::vector<unsigned short> values(32 * 24 * 16 * 2);
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = static_cast<unsigned short>(i * 7);
+  }
+  {
+    const char header[16] = "raw volume";
+    vtksys::ofstream file(fileName.c_str(), std::ios_base::binary);
+    file.write(header, sizeof(header));
+    file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(values[0]));
+  }
+
+  const int whole[6] = { 0, 31, 0, 23, 0, 15 };
+  const int slices[6] = { 0, 31, 0, 23, 5, 9 };
+  const int subExtent[6] = { 2, 20, 0, 23, 5, 9 };
+  bool status = CompareReads(fileName, whole);
+  status &= CompareReads(fileName, slices);
+  status &= CompareReads(fileName, subExtent);
+  return status ? EXIT_SUCCESS : EXIT_FAILURE;
+}
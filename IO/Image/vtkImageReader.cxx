@@ -367,6 +367,15 @@ void vtkImageReaderUpdate1(vtkImageReader* self, vtkImageData* data, T* inPtr)
 // are assumed to be the same as the file extent/order.
 void vtkImageReader::ExecuteDataWithInformation(vtkDataObject* output, vtkInformation* outInfo)
 {
+  // The file can be mapped if its values are used as is.
+  vtkImageData* mapped = vtkImageData::SafeDownCast(output);
+  if (mapped && (this->FileName || this->FilePattern) && !this->Transform &&
+    this->DataMask == static_cast<vtkTypeUInt64>(~0UL) && this->MapFileIntoOutput(mapped, outInfo))
+  {
+    mapped->GetPointData()->GetScalars()->SetName(this->ScalarArrayName);
+    return;
+  }
+
   vtkImageData* data = this->AllocateOutputData(output, outInfo);
 
   void* ptr = nullptr;
@@ -11,6 +11,8 @@
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMappedFileResourceStream.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -363,6 +365,7 @@ void vtkImageReader2::PrintSelf(ostream& os, vtkIndent indent)
   os << ")\n";
 
   os << indent << "HeaderSize: " << this->HeaderSize << "\n";
+  os << indent << "MemoryMapFile: " << this->MemoryMapFile << "\n";
 
   if (this->InternalFileName)
   {
@@ -672,11 +675,64 @@ void vtkImageReader2Update(vtkImageReader2* self, vtkImageData* data, OT* outPtr
   }
 }
 
+//------------------------------------------------------------------------------
+bool vtkImageReader2::MapFileIntoOutput(vtkImageData* data, vtkInformation* outInfo)
+{
+  // The requested extent must be a contiguous range of slices of a single
+  // file, stored bottom up in the native byte order.
+  int extent[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), extent);
+  if (!this->MemoryMapFile || this->Stream || this->FileNames || this->GetSwapBytes() ||
+    !this->FileLowerLeft || this->GetFileDimensionality() != 3 ||
+    extent[0] != this->DataExtent[0] || extent[1] != this->DataExtent[1] ||
+    extent[2] != this->DataExtent[2] || extent[3] != this->DataExtent[3] ||
+    extent[4] < this->DataExtent[4] || extent[5] > this->DataExtent[5] || extent[4] > extent[5])
+  {
+    return false;
+  }
+
+  this->ComputeDataIncrements();
+  this->ComputeInternalFileName(0);
+  if (!this->InternalFileName)
+  {
+    return false;
+  }
+  const vtkTypeInt64 offset = static_cast<vtkTypeInt64>(this->GetHeaderSize(extent[4])) +
+    static_cast<vtkTypeInt64>(extent[4] - this->DataExtent[4]) * this->DataIncrements[2];
+  const vtkIdType numberOfTuples = static_cast<vtkIdType>(extent[1] - extent[0] + 1) *
+    (extent[3] - extent[2] + 1) * (extent[5] - extent[4] + 1);
+
+  vtkSmartPointer<vtkDataArray> scalars =
+    vtk::TakeSmartPointer(vtkDataArray::CreateDataArray(this->DataScalarType));
+  if (!scalars)
+  {
+    return false;
+  }
+  scalars->SetNumberOfComponents(this->NumberOfScalarComponents);
+  vtkNew<vtkMappedFileResourceStream> stream;
+  if (!stream->Open(this->InternalFileName) ||
+    !stream->MapIntoArray(scalars, offset, numberOfTuples))
+  {
+    return false;
+  }
+
+  data->SetExtent(extent);
+  data->GetPointData()->SetScalars(scalars);
+  return true;
+}
+
 //------------------------------------------------------------------------------
 // This function reads a data from a file.  The datas extent/axes
 // are assumed to be the same as the file extent/order.
 void vtkImageReader2::ExecuteDataWithInformation(vtkDataObject* output, vtkInformation* outInfo)
 {
+  vtkImageData* mapped = vtkImageData::SafeDownCast(output);
+  if (mapped && (this->FileName || this->FilePattern) && this->MapFileIntoOutput(mapped, outInfo))
+  {
+    mapped->GetPointData()->GetScalars()->SetName("ImageFile");
+    return;
+  }
+
   vtkImageData* data = this->AllocateOutputData(output, outInfo);
 
   void* ptr;
@@ -258,6 +258,22 @@ public:
   vtkBooleanMacro(SwapBytes, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * When on, and the requested extent is stored contiguously in a single
+   * file in the native byte order, map the file in memory with
+   * vtkMappedFileResourceStream and use the mapped region as the output
+   * scalars instead of reading it.  Opening is then almost instantaneous and
+   * the data is loaded from the file when first accessed.  Modifying the
+   * output does not modify the file.  Other cases fall back to regular reads.
+   * Only readers of raw data relying on this class to read the pixels, like
+   * vtkImageReader, use this option.  Default is off.
+   */
+  vtkSetMacro(MemoryMapFile, bool);
+  vtkGetMacro(MemoryMapFile, bool);
+  vtkBooleanMacro(MemoryMapFile, bool);
+  ///@}
+
   istream* GetFile() { return this->File; }
   vtkGetVectorMacro(DataIncrements, unsigned long, 4);
 
@@ -360,6 +376,16 @@ protected:
   void ExecuteDataWithInformation(vtkDataObject* data, vtkInformation* outInfo) override;
   virtual void ComputeDataIncrements();
 
+  /**
+   * Use a memory mapping of the file as the output scalars when
+   * MemoryMapFile is on and the requested extent allows it.  On success,
+   * the output extent and scalars are set and true is returned.  Otherwise
+   * the output is not modified.
+   */
+  bool MapFileIntoOutput(vtkImageData* data, vtkInformation* outInfo);
+
+  bool MemoryMapFile = false;
+
 private:
   vtkImageReader2(const vtkImageReader2&) = delete;
   void operator=(const vtkImageReader2&) = delete;
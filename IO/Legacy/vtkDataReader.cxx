@@ -8,6 +8,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
+#include "vtkChunkedTextParser.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDoubleArray.h"
 #include "vtkErrorCode.h"
@@ -29,6 +30,7 @@
 #include "vtkLegacyReaderVersion.h"
 #include "vtkLongArray.h"
 #include "vtkLookupTable.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
@@ -1553,12 +1555,50 @@ int vtkReadBinaryData(istream* IS, T* data, vtkIdType numTuples, vtkIdType numCo
   return 1;
 }
 
+// Read large arrays of ascii data by chunks, converted concurrently. Returns
+// false with the stream unchanged if the values cannot be read this way, as
+// when the stream cannot be repositioned after the last value or when a value
+// is not written the way vtkValueFromString expects.
+template <class T>
+bool vtkReadASCIIDataConcurrently(istream* IS, T* data, vtkIdType numValues)
+{
+  if (numValues < 1024)
+  {
+    return false;
+  }
+  const std::streampos start = IS->tellg();
+  if (start == std::streampos(-1))
+  {
+    return false;
+  }
+
+  vtkNew<vtkChunkedTextParser> parser;
+  const bool valid =
+    parser->Read(*IS, vtkChunkedTextParser::Unit::Token, numValues) == numValues &&
+    parser->ParseTokens(data);
+
+  // Characters are counted from the start, seeking past them would not work
+  // on streams translating line endings.
+  IS->clear();
+  IS->seekg(start);
+  if (valid)
+  {
+    IS->ignore(static_cast<std::streamsize>(parser->GetEnd()));
+  }
+  return valid;
+}
+
 // General templated function to read data of various types.
 template <class T>
 int vtkReadASCIIData(vtkDataReader* self, T* data, vtkIdType numTuples, vtkIdType numComp)
 {
   vtkIdType i, j;
 
+  if (vtkReadASCIIDataConcurrently(self->GetIStream(), data, numTuples * numComp))
+  {
+    return 1;
+  }
+
   for (i = 0; i < numTuples; i++)
   {
     for (j = 0; j < numComp; j++)
@@ -3225,7 +3265,7 @@ int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
     }
     vtkByteSwap::Swap4BERange(data, size);
   }
-  else // ascii
+  else if (!vtkReadASCIIDataConcurrently(this->IS, data, size)) // ascii
   {
     for (i = 0; i < size; i++)
     {
@@ -0,0 +1,182 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that the elements of ascii PLY files written one per line are parsed
+// concurrently, that the other files are parsed serially, and that both give
+// the same output.
+
+#include "vtkCellArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPLY.h"
+#include "vtkPLYReader.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct Vertex
+{
+  float x[3];
+};
+
+struct Face
+{
+  unsigned char nverts;
+  int* verts;
+};
+
+/**
+ * Make an ascii PLY file with `count` vertices and triangles. When
+ * `splitFaces` is true, the faces are written on two lines each.
+ */
+std::string MakePLY(int count, bool splitFaces)
+{
+  std::ostringstream text;
+  text << "ply\nformat ascii 1.0\n"
+       << "element vertex " << count << "\n"
+       << "property float x\nproperty float y\nproperty float z\n"
+       << "element face " << count << "\n"
+       << "property list uchar int vertex_indices\nend_header\n";
+  for (int i = 0; i < count; ++i)
+  {
+    text << 0.5 * i << " " << i % 7 << " " << -i << "\n";
+  }
+  for (int i = 0; i < count; ++i)
+  {
+    text << "3 " << i << (splitFaces ? "\n" : " ") << (i + 1) % count << " " << (i + 2) % count
+         << "\n";
+  }
+  return text.str();
+}
+
+/**
+ * Read the elements of `text` with the PLY library and check them. Return
+ * false if they are wrong, or if the vertices and the faces are not parsed
+ * concurrently as expected.
+ */
+bool ReadElements(
+  const std::string& text, int count, bool concurrentVertices, bool concurrentFaces)
+{
+  PlyProperty vertexProps[] = {
+    { "x", PLY_FLOAT, PLY_FLOAT, static_cast<int>(offsetof(Vertex, x)), 0, 0, 0, 0 },
+    { "y", PLY_FLOAT, PLY_FLOAT, static_cast<int>(offsetof(Vertex, x) + sizeof(float)), 0, 0, 0,
+      0 },
+    { "z", PLY_FLOAT, PLY_FLOAT, static_cast<int>(offsetof(Vertex, x) + 2 * sizeof(float)), 0, 0,
+      0, 0 },
+  };
+  PlyProperty faceProps[] = {
+    { "vertex_indices", PLY_INT, PLY_INT, static_cast<int>(offsetof(Face, verts)), 1, PLY_UCHAR,
+      PLY_UCHAR, static_cast<int>(offsetof(Face, nverts)) },
+  };
+
+  int numberOfElements = 0;
+  char** elementNames = nullptr;
+  PlyFile* ply = vtkPLY::ply_open_for_reading_from_string(text, &numberOfElements, &elementNames);
+  if (!ply)
+  {
+    vtkLog(ERROR, "Cannot open the PLY text");
+    return false;
+  }
+
+  bool valid = true;
+  for (int i = 0; i < numberOfElements; ++i)
+  {
+    int numberOfElems = 0, numberOfProps = 0;
+    vtkPLY::ply_get_element_description(ply, elementNames[i], &numberOfElems, &numberOfProps);
+    if (!strcmp(elementNames[i], "vertex"))
+    {
+      for (PlyProperty& prop : vertexProps)
+      {
+        vtkPLY::ply_get_property(ply, elementNames[i], &prop);
+      }
+      std::vector<Vertex> vertices(numberOfElems);
+      if (vtkPLY::ply_get_elements(ply, vertices.data(), numberOfElems, sizeof(Vertex)) !=
+        concurrentVertices)
+      {
+        vtkLog(ERROR,
+          "The vertices were not parsed " << (concurrentVertices ? "concurrently" : "serially"));
+        valid = false;
+      }
+      for (int j = 0; j < count && valid; ++j)
+      {
+        const float* x = vertices[j].x;
+        if (x[0] != 0.5f * j || x[1] != j % 7 || x[2] != -j)
+        {
+          vtkLog(ERROR, "Wrong vertex " << j);
+          valid = false;
+        }
+      }
+    }
+    else if (!strcmp(elementNames[i], "face"))
+    {
+      vtkPLY::ply_get_property(ply, elementNames[i], &faceProps[0]);
+      std::vector<Face> faces(numberOfElems);
+      if (vtkPLY::ply_get_elements(ply, faces.data(), numberOfElems, sizeof(Face)) !=
+        concurrentFaces)
+      {
+        vtkLog(
+          ERROR, "The faces were not parsed " << (concurrentFaces ? "concurrently" : "serially"));
+        valid = false;
+      }
+      for (int j = 0; j < count; ++j)
+      {
+        const Face& face = faces[j];
+        if (valid &&
+          (face.nverts != 3 || face.verts[0] != j || face.verts[1] != (j + 1) % count ||
+            face.verts[2] != (j + 2) % count))
+        {
+          vtkLog(ERROR, "Wrong face " << j);
+          valid = false;
+        }
+        free(face.verts);
+      }
+    }
+    free(elementNames[i]);
+  }
+  free(elementNames);
+  vtkPLY::ply_close(ply);
+  return valid;
+}
+}
+
+int TestPLYReaderConcurrentASCII(int, char*[])
+{
+  const int count = 5000;
+  const std::string oneElementPerLine = ::MakePLY(count, false);
+  const std::string splitFaces = ::MakePLY(count, true);
+
+  // Faces on several lines are parsed serially, but the vertices still are
+  // parsed concurrently. Few elements are always parsed serially.
+  if (!::ReadElements(oneElementPerLine, count, true, true) ||
+    !::ReadElements(splitFaces, count, true, false) ||
+    !::ReadElements(::MakePLY(100, false), 100, false, false))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkPLYReader> expected;
+  expected->ReadFromInputStringOn();
+  expected->SetInputString(splitFaces);
+  expected->Update();
+  vtkNew<vtkPLYReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(oneElementPerLine);
+  reader->Update();
+  if (reader->GetOutput()->GetNumberOfPoints() != count ||
+    reader->GetOutput()->GetNumberOfPolys() != count ||
+    !vtkTestUtilities::CompareDataObjects(expected->GetOutput(), reader->GetOutput()))
+  {
+    vtkLog(ERROR, "Wrong output of vtkPLYReader");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -23,10 +23,12 @@ chars representing red, green and blue.
 
 #include "vtkPLY.h"
 #include "vtkByteSwap.h"
+#include "vtkChunkedTextParser.h"
 #include "vtkFileResourceStream.h"
 #include "vtkHeap.h"
 #include "vtkMath.h"
 #include "vtkMemoryResourceStream.h"
+#include "vtkNew.h"
 #include "vtkResourceParser.h"
 #include "vtkStringFormatter.h"
 #include "vtkStringScanner.h"
@@ -34,6 +36,7 @@ chars representing red, green and blue.
 #include <vtksys/FStream.hxx>
 #include <vtksys/SystemTools.hxx>
 
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -995,6 +998,35 @@ void vtkPLY::ply_get_element(PlyFile* plyfile, void* elem_ptr)
     binary_get_element(plyfile, (char*)elem_ptr);
 }
 
+/******************************************************************************
+Read several consecutive elements from the file, like as many calls to
+ply_get_element() would. In ascii files, elements written one per line are
+parsed concurrently.
+
+Entry:
+  plyfile   - file identifier
+  elems_ptr - pointer to the location of the first element
+  count     - number of elements to read
+  elem_size - size of an element, the distance between two elements
+
+Exit:
+  returns true if the elements were parsed concurrently
+******************************************************************************/
+
+bool vtkPLY::ply_get_elements(PlyFile* plyfile, void* elems_ptr, int count, size_t elem_size)
+{
+  char* elems = static_cast<char*>(elems_ptr);
+  if (plyfile->file_type == PLY_ASCII && ascii_get_elements(plyfile, elems, count, elem_size))
+  {
+    return true;
+  }
+  for (int i = 0; i < count; i++)
+  {
+    ply_get_element(plyfile, elems + i * elem_size);
+  }
+  return false;
+}
+
 /******************************************************************************
 Extract the comments from the header information of a PLY file.
 
@@ -1589,6 +1621,198 @@ bool vtkPLY::ascii_get_element(PlyFile* plyfile, char* elem_ptr)
   return true;
 }
 
+namespace
+{
+/* Parse an ascii item of the given type at the beginning of [first, last), like get_ascii_item() */
+bool parse_ascii_item(const char*& first, const char* last, int type, int* int_val,
+  unsigned int* uint_val, double* double_val)
+{
+  switch (type)
+  {
+    case PLY_CHAR:
+    case PLY_INT8:
+    case PLY_UCHAR:
+    case PLY_UINT8:
+    case PLY_SHORT:
+    case PLY_INT16:
+    case PLY_USHORT:
+    case PLY_UINT16:
+    case PLY_INT:
+    case PLY_INT32:
+      first = vtkChunkedTextParser::ParseValue(first, last, *int_val);
+      *uint_val = static_cast<unsigned int>(*int_val);
+      break;
+
+    case PLY_UINT:
+    case PLY_UINT32:
+      first = vtkChunkedTextParser::ParseValue(first, last, *uint_val);
+      *int_val = static_cast<int>(*uint_val);
+      break;
+
+    case PLY_FLOAT:
+    case PLY_FLOAT32:
+    case PLY_DOUBLE:
+    case PLY_FLOAT64:
+      first = vtkChunkedTextParser::ParseValue(first, last, *double_val);
+      break;
+
+    default:
+      first = nullptr;
+  }
+  return first != nullptr;
+}
+
+/* Free the lists stored in an element read by parse_ascii_element() */
+void free_ascii_element_lists(PlyElement* elem, char* elem_ptr, int nprops)
+{
+  for (int j = 0; j < nprops; j++)
+  {
+    if (elem->props[j]->is_list && elem->store_prop[j])
+    {
+      free(*(char**)(elem_ptr + elem->props[j]->offset));
+    }
+  }
+}
+
+/* Parse an element without other_props from the line [first, last), like
+   ascii_get_element(). Returns false if the line does not hold exactly the
+   element, in which case nothing is allocated. */
+bool parse_ascii_element(PlyElement* elem, const char* first, const char* last, char* elem_ptr)
+{
+  int int_val = 0;
+  unsigned int uint_val = 0;
+  double double_val = 0.0;
+
+  for (int j = 0; j < elem->nprops; j++)
+  {
+    PlyProperty* prop = elem->props[j];
+    const int store_it = elem->store_prop[j];
+    bool valid = true;
+    // Whether the list of this property was allocated and stored
+    bool list_stored = false;
+
+    if (prop->is_list)
+    {
+      valid = parse_ascii_item(first, last, prop->count_external, &int_val, &uint_val, &double_val);
+      const int list_count = int_val;
+      if (valid && list_count >= 0 && store_it)
+      {
+        vtkPLY::store_item(
+          elem_ptr + prop->count_offset, prop->count_internal, int_val, uint_val, double_val);
+        const int item_size = ply_type_size[prop->internal_type];
+        char* item = list_count == 0 ? nullptr : (char*)myalloc(item_size * list_count);
+        *(char**)(elem_ptr + prop->offset) = item;
+        list_stored = true;
+        for (int k = 0; k < list_count && valid; k++, item += item_size)
+        {
+          valid = parse_ascii_item(first, last, prop->external_type, &int_val, &uint_val,
+            &double_val);
+          vtkPLY::store_item(item, prop->internal_type, int_val, uint_val, double_val);
+        }
+      }
+      else
+      {
+        valid = valid && list_count >= 0;
+        for (int k = 0; k < list_count && valid; k++)
+        {
+          valid = parse_ascii_item(first, last, prop->external_type, &int_val, &uint_val,
+            &double_val);
+        }
+      }
+    }
+    else
+    {
+      valid = parse_ascii_item(first, last, prop->external_type, &int_val, &uint_val, &double_val);
+      if (valid && store_it)
+      {
+        vtkPLY::store_item(elem_ptr + prop->offset, prop->internal_type, int_val, uint_val,
+          double_val);
+      }
+    }
+
+    if (!valid)
+    {
+      free_ascii_element_lists(elem, elem_ptr, list_stored ? j + 1 : j);
+      return false;
+    }
+  }
+
+  if (vtkChunkedTextParser::SkipWhitespace(first, last) != last)
+  {
+    free_ascii_element_lists(elem, elem_ptr, elem->nprops);
+    return false;
+  }
+  return true;
+}
+}
+
+/******************************************************************************
+Read consecutive elements from an ascii file, one per line, concurrently.
+Returns false, without reading anything, when elements are not written one per
+line, or if they have other_props.
+******************************************************************************/
+
+bool vtkPLY::ascii_get_elements(PlyFile* plyfile, char* elems, int count, size_t elem_size)
+{
+  PlyElement* elem = plyfile->which_elem;
+  vtkResourceParser* parser = plyfile->parser;
+  vtkResourceStream* stream = plyfile->is;
+  if (count < 1024 || elem->other_offset != NO_OTHER_PROPS || !stream->SupportSeek())
+  {
+    return false;
+  }
+
+  // Elements start on a new line, after the end of the previous one.
+  const vtkTypeInt64 start = parser->Tell();
+  if (parser->DiscardUntil([](char c) { return !vtkChunkedTextParser::IsWhitespace(c); }) !=
+    vtkParseResult::Ok)
+  {
+    parser->Seek(start, vtkResourceStream::SeekDirection::Begin);
+    return false;
+  }
+  const vtkTypeInt64 first = parser->Tell();
+  stream->Seek(first, vtkResourceStream::SeekDirection::Begin);
+
+  vtkNew<vtkChunkedTextParser> text;
+  std::vector<char> parsed(count, 0);
+  std::atomic<bool> valid(text->Read(stream, vtkChunkedTextParser::Unit::Line, count) == count);
+  if (valid)
+  {
+    text->ForEachChunk(
+      [&](std::size_t, const char* begin, const char* end, vtkIdType line)
+      {
+        vtkChunkedTextParser::ForEachLine(begin, end,
+          [&](const char* lineBegin, const char* lineEnd)
+          {
+            if (valid)
+            {
+              char* elem_ptr = elems + line * elem_size;
+              parsed[line] = parse_ascii_element(elem, lineBegin, lineEnd, elem_ptr);
+              valid = valid && parsed[line];
+            }
+            ++line;
+          });
+      });
+  }
+
+  if (!valid)
+  {
+    for (int i = 0; i < count; i++)
+    {
+      if (parsed[i])
+      {
+        free_ascii_element_lists(elem, elems + i * elem_size, elem->nprops);
+      }
+    }
+    parser->Seek(start, vtkResourceStream::SeekDirection::Begin);
+    return false;
+  }
+
+  parser->Seek(first + static_cast<vtkTypeInt64>(text->GetEnd()),
+    vtkResourceStream::SeekDirection::Begin);
+  return true;
+}
+
 /******************************************************************************
 Read an element from a binary file.
 
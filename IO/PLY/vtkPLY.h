@@ -175,6 +175,7 @@ public:
   static void ply_get_property(PlyFile*, const char*, PlyProperty*);
   static PlyOtherProp* ply_get_other_properties(PlyFile*, const char*, int);
   static void ply_get_element(PlyFile*, void*);
+  static bool ply_get_elements(PlyFile*, void*, int, size_t);
   static char** ply_get_comments(PlyFile*, int*);
   static char** ply_get_obj_info(PlyFile*, int*);
   static void ply_close(PlyFile*);
@@ -207,6 +208,7 @@ public:
   static void get_ascii_item(vtkResourceParser*, int, int*, unsigned int*, double*);
   static bool get_binary_item(PlyFile*, int, int*, unsigned int*, double*);
   static bool ascii_get_element(PlyFile*, char*);
+  static bool ascii_get_elements(PlyFile*, char*, int, size_t);
   static bool binary_get_element(PlyFile*, char*);
   static void* my_alloc(size_t, int, const char*);
   static int get_prop_type(const char*);
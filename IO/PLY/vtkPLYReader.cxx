@@ -100,6 +100,11 @@ vtkPLYReader::~vtkPLYReader()
 
 namespace
 { // required so we don't violate ODR
+// Maximum number of elements read at once. This bounds the memory used by
+// the elements, and by the lists of the faces, while keeping batches large
+// enough to be parsed concurrently.
+constexpr int PLYElementsBatchSize = 1 << 16;
+
 typedef struct _plyVertex
 {
   float x[3]; // the usual 3-space position of a vertex
@@ -403,10 +408,15 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
         rgbPoints->SetNumberOfTuples(numPts);
       }
 
-      plyVertex vertex;
+      std::vector<plyVertex> vertices(std::min(numPts, ::PLYElementsBatchSize));
       for (int j = 0; j < numPts; j++)
       {
-        vtkPLY::ply_get_element(ply, (void*)&vertex);
+        if (j % ::PLYElementsBatchSize == 0)
+        {
+          vtkPLY::ply_get_elements(ply, vertices.data(),
+            std::min(::PLYElementsBatchSize, numPts - j), sizeof(plyVertex));
+        }
+        const plyVertex& vertex = vertices[j % ::PLYElementsBatchSize];
         pts->SetPoint(j, vertex.x);
         if (texCoordsPointsAvailable)
         {
@@ -450,7 +460,7 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
       numPolys = numElems;
       vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
       polys->AllocateEstimate(numPolys, 3);
-      plyFace face;
+      std::vector<plyFace> faces;
       vtkIdType vtkVerts[256];
 
       // Get the face properties
@@ -489,10 +499,15 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
 
       // grab all the face elements
       vtkNew<vtkPolygon> cell;
+      faces.resize(std::min(numPolys, ::PLYElementsBatchSize));
       for (int j = 0; j < numPolys; j++)
       {
-        // grab and element from the file
-        vtkPLY::ply_get_element(ply, (void*)&face);
+        if (j % ::PLYElementsBatchSize == 0)
+        {
+          vtkPLY::ply_get_elements(ply, faces.data(),
+            std::min(::PLYElementsBatchSize, numPolys - j), sizeof(plyFace));
+        }
+        plyFace& face = faces[j % ::PLYElementsBatchSize];
         for (int k = 0; k < face.nverts; k++)
         {
           vtkVerts[k] = face.verts[k];
@@ -82,6 +82,7 @@ vtkXMLWriterBase* vtkXMLCompositeDataSetWriterHelper::GetWriter(int dataType)
     writer->SetByteOrder(this->Writer->GetByteOrder());
     writer->SetCompressor(this->Writer->GetCompressor());
     writer->SetBlockSize(this->Writer->GetBlockSize());
+    writer->SetSequentialProcessing(this->Writer->GetSequentialProcessing());
     writer->SetDataMode(this->Writer->GetDataMode());
     writer->SetEncodeAppendedData(this->Writer->GetEncodeAppendedData());
     writer->SetHeaderType(this->Writer->GetHeaderType());
@@ -35,6 +35,7 @@ bool vtkXMLDataWriterHelper::OpenFile()
   this->SetByteOrder(this->Writer->GetByteOrder());
   this->SetCompressor(this->Writer->GetCompressor());
   this->SetBlockSize(this->Writer->GetBlockSize());
+  this->SetSequentialProcessing(this->Writer->GetSequentialProcessing());
   this->SetDataMode(this->Writer->GetDataMode());
   this->SetEncodeAppendedData(this->Writer->GetEncodeAppendedData());
   this->SetHeaderType(this->Writer->GetHeaderType());
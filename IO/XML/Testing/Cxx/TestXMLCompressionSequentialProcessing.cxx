@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that the concurrent block compression of the XML writers produces
+// byte-identical files, and that the concurrent decompression of the XML
+// readers gives back the written data.
+
+#include "vtkDoubleArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTimerLog.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+std::string Write(vtkPolyData* input, int compressor, int dataMode, bool encode, bool sequential)
+{
+  vtkNew<vtkTimerLog> timer;
+  vtkNew<vtkXMLPolyDataWriter> writer;
+  writer->SetInputData(input);
+  writer->WriteToOutputStringOn();
+  writer->SetCompressorType(compressor);
+  writer->SetDataMode(dataMode);
+  writer->SetEncodeAppendedData(encode);
+  writer->SetBlockSize(4096);
+  writer->SetSequentialProcessing(sequential);
+  timer->StartTimer();
+  writer->Write();
+  timer->StopTimer();
+  std::cout << "Compressor " << compressor << ", data mode " << dataMode << ", encoded " << encode
+            << (sequential ? ", sequential write: " : ", threaded write: ")
+            << timer->GetElapsedTime() << " s\n";
+  return writer->GetOutputString();
+}
+
+bool ReadAndCompare(vtkPolyData* input, const std::string& content, bool sequential)
+{
+  vtkNew<vtkXMLPolyDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(content);
+  reader->SetSequentialProcessing(sequential);
+  reader->Update();
+  vtkPolyData* output = reader->GetOutput();
+  if (output->GetNumberOfPoints() != input->GetNumberOfPoints() ||
+    output->GetNumberOfPolys() != input->GetNumberOfPolys())
+  {
+    std::cerr << "Error: wrong sizes when reading back" << std::endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    input->GetPoint(ptId, x);
+    output->GetPoint(ptId, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Error: wrong coordinates for point " << ptId << std::endl;
+      return false;
+    }
+  }
+  vtkDataArray* inArray = input->GetPointData()->GetArray("Random");
+  vtkDataArray* outArray = output->GetPointData()->GetArray("Random");
+  if (!outArray || outArray->GetNumberOfValues() != inArray->GetNumberOfValues())
+  {
+    std::cerr << "Error: wrong Random array when reading back" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < inArray->GetNumberOfValues(); ++i)
+  {
+    if (inArray->GetComponent(i, 0) != outArray->GetComponent(i, 0))
+    {
+      std::cerr << "Error: wrong value " << i << " in Random array" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLCompressionSequentialProcessing(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(400);
+  sphere->SetPhiResolution(200);
+  sphere->Update();
+  vtkNew<vtkPolyData> input;
+  input->ShallowCopy(sphere->GetOutput());
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(3);
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Random");
+  values->SetNumberOfTuples(input->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < values->GetNumberOfValues(); ++i)
+  {
+    values->SetValue(i, random->GetNextRangeValue(0.0, 1.0));
+  }
+  input->GetPointData()->AddArray(values);
+
+  const int compressors[] = { vtkXMLWriterBase::ZLIB, vtkXMLWriterBase::LZ4,
+    vtkXMLWriterBase::LZMA };
+  bool status = true;
+  for (int compressor : compressors)
+  {
+    for (int dataMode : { vtkXMLWriterBase::Binary, vtkXMLWriterBase::Appended })
+    {
+      for (bool encode : { true, false })
+      {
+        if (dataMode == vtkXMLWriterBase::Binary && !encode)
+        {
+          continue;
+        }
+        const std::string sequential = Write(input, compressor, dataMode, encode, true);
+        const std::string threaded = Write(input, compressor, dataMode, encode, false);
+        if (sequential != threaded)
+        {
+          std::cerr << "Error: the threaded writer does not produce the same file" << std::endl;
+          status = false;
+          continue;
+        }
+        status &= ReadAndCompare(input, threaded, true);
+        status &= ReadAndCompare(input, threaded, false);
+      }
+    }
+  }
+  return status ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that the parallel XML readers and the composite reader produce the
+// same output when reading their pieces concurrently.
+
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkTesting.h"
+#include "vtkXMLMultiBlockDataReader.h"
+#include "vtkXMLMultiBlockDataWriter.h"
+#include "vtkXMLPImageDataReader.h"
+#include "vtkXMLPImageDataWriter.h"
+#include "vtkXMLPPolyDataReader.h"
+#include "vtkXMLPPolyDataWriter.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+template <typename ReaderT>
+bool CompareReads(const std::string& fileName, int numberOfThreads)
+{
+  vtkNew<ReaderT> sequential;
+  sequential->SetFileName(fileName.c_str());
+  sequential->Update();
+
+  vtkNew<ReaderT> concurrent;
+  concurrent->SetFileName(fileName.c_str());
+  concurrent->ReadPiecesConcurrentlyOn();
+  concurrent->SetNumberOfPieceReadingThreads(numberOfThreads);
+  concurrent->Update();
+
+  if (!vtkTestUtilities::CompareDataObjects(
+        sequential->GetOutputDataObject(0), concurrent->GetOutputDataObject(0)))
+  {
+    std::cerr << "Error: concurrent read of " << fileName << " with " << numberOfThreads
+              << " threads differs from the sequential read" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestXMLReadPiecesConcurrently(int argc, char* argv[])
+{
+  vtkNew<vtkTesting> testing;
+  testing->AddArguments(argc, argv);
+  const std::string tempDir = testing->GetTempDirectory();
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(32);
+  sphere->Update();
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(40, 30, 20);
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  values->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < values->GetNumberOfTuples(); ++i)
+  {
+    values->SetValue(i, 0.5 * i);
+  }
+  image->GetPointData()->SetScalars(values);
+
+  const std::string pvtp = tempDir + "/TestXMLReadPiecesConcurrently.pvtp";
+  vtkNew<vtkXMLPPolyDataWriter> polyWriter;
+  polyWriter->SetInputConnection(sphere->GetOutputPort());
+  polyWriter->SetFileName(pvtp.c_str());
+  polyWriter->SetNumberOfPieces(8);
+  polyWriter->SetStartPiece(0);
+  polyWriter->SetEndPiece(7);
+  polyWriter->Write();
+
+  const std::string pvti = tempDir + "/TestXMLReadPiecesConcurrently.pvti";
+  vtkNew<vtkXMLPImageDataWriter> imageWriter;
+  imageWriter->SetInputData(image);
+  imageWriter->SetFileName(pvti.c_str());
+  imageWriter->SetNumberOfPieces(6);
+  imageWriter->SetStartPiece(0);
+  imageWriter->SetEndPiece(5);
+  imageWriter->Write();
+
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  blocks->SetNumberOfBlocks(6);
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    sphere->SetCenter(i, 0, 0);
+    sphere->Update();
+    vtkNew<vtkPolyData> block;
+    block->ShallowCopy(sphere->GetOutput());
+    blocks->SetBlock(i, block);
+  }
+  blocks->SetBlock(5, image);
+  const std::string vtm = tempDir + "/TestXMLReadPiecesConcurrently.vtm";
+  vtkNew<vtkXMLMultiBlockDataWriter> blockWriter;
+  blockWriter->SetInputData(blocks);
+  blockWriter->SetFileName(vtm.c_str());
+  blockWriter->Write();
+
+  bool status = true;
+  for (int numberOfThreads : { 0, 1, 3 })
+  {
+    status &= CompareReads<vtkXMLPPolyDataReader>(pvtp, numberOfThreads);
+    status &= CompareReads<vtkXMLPImageDataReader>(pvti, numberOfThreads);
+    status &= CompareReads<vtkXMLMultiBlockDataReader>(vtm, numberOfThreads);
+  }
+  return status ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -3,10 +3,12 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkXMLCompositeDataReader.h"
 
+#include "vtkCallbackCommand.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataArraySelection.h"
 #include "vtkDataSet.h"
+#include "vtkErrorCode.h"
 #include "vtkEventForwarderCommand.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerKey.h"
@@ -16,8 +18,10 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
+#include "vtkThreadedCallbackQueue.h"
 #include "vtkUniformGrid.h"
 #include "vtkXMLDataElement.h"
 #include "vtkXMLDataParser.h"
@@ -33,6 +37,8 @@
 #include <algorithm>
 #include <map>
 #include <set>
+#include <utility>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -63,8 +69,85 @@ struct vtkXMLCompositeDataReaderInternals
   unsigned int NumDataSets;
   std::set<int> UpdateIndices;
   bool HasUpdateRestriction;
+
+  // When ReadPiecesConcurrently is on, ReadComposite is first run to collect
+  // the leaves to read, which are then read concurrently.
+  bool CollectingLeaves = false;
+  std::vector<std::pair<vtkXMLDataElement*, std::string>> LeavesToRead;
+  std::map<vtkXMLDataElement*, vtkSmartPointer<vtkDataObject>> ReadLeaves;
 };
 
+namespace
+{
+// Create a reader of the given class name, or nullptr if the type is unknown.
+vtkXMLReader* NewReaderOfType(const char* type)
+{
+  if (strcmp(type, "vtkXMLImageDataReader") == 0)
+  {
+    return vtkXMLImageDataReader::New();
+  }
+  if (strcmp(type, "vtkXMLUnstructuredGridReader") == 0)
+  {
+    return vtkXMLUnstructuredGridReader::New();
+  }
+  if (strcmp(type, "vtkXMLPolyDataReader") == 0)
+  {
+    return vtkXMLPolyDataReader::New();
+  }
+  if (strcmp(type, "vtkXMLRectilinearGridReader") == 0)
+  {
+    return vtkXMLRectilinearGridReader::New();
+  }
+  if (strcmp(type, "vtkXMLStructuredGridReader") == 0)
+  {
+    return vtkXMLStructuredGridReader::New();
+  }
+  if (strcmp(type, "vtkXMLTableReader") == 0)
+  {
+    return vtkXMLTableReader::New();
+  }
+  if (strcmp(type, "vtkXMLHyperTreeGridReader") == 0)
+  {
+    return vtkXMLHyperTreeGridReader::New();
+  }
+  if (strcmp(type, "vtkXMLStatisticalModelReader") == 0)
+  {
+    return vtkXMLStatisticalModelReader::New();
+  }
+  return nullptr;
+}
+
+// Name of the reader class for the extension of the given file, or nullptr.
+const char* GetReaderTypeForFile(const std::string& fileName)
+{
+  // Get the file extension.
+  std::string ext = vtksys::SystemTools::GetFilenameLastExtension(fileName);
+  if (!ext.empty())
+  {
+    // remove "." from the extension.
+    ext.erase(0, 1);
+  }
+
+  // Search for the reader matching this extension.
+  for (const vtkXMLCompositeDataReaderEntry* readerEntry =
+         vtkXMLCompositeDataReaderInternals::ReaderList;
+       readerEntry->extension; ++readerEntry)
+  {
+    if (ext == readerEntry->extension)
+    {
+      return readerEntry->name;
+    }
+  }
+  return nullptr;
+}
+
+// Flags a reader as failed when it reports an error.
+void FlagReadFailure(vtkObject*, unsigned long, void* clientData, void*)
+{
+  *static_cast<char*>(clientData) = 1;
+}
+}
+
 //------------------------------------------------------------------------------
 vtkXMLCompositeDataReader::vtkXMLCompositeDataReader()
   : PieceDistribution(Block)
@@ -96,6 +179,8 @@ void vtkXMLCompositeDataReader::PrintSelf(ostream& os, vtkIndent indent)
       os << "Invalid (!!)\n";
       break;
   }
+  os << indent << "ReadPiecesConcurrently: " << this->ReadPiecesConcurrently << "\n";
+  os << indent << "NumberOfPieceReadingThreads: " << this->NumberOfPieceReadingThreads << "\n";
 
   this->Superclass::PrintSelf(os, indent);
 }
@@ -226,39 +311,7 @@ vtkXMLReader* vtkXMLCompositeDataReader::GetReaderOfType(const char* type)
     return iter->second;
   }
 
-  vtkXMLReader* reader = nullptr;
-  if (strcmp(type, "vtkXMLImageDataReader") == 0)
-  {
-    reader = vtkXMLImageDataReader::New();
-  }
-  else if (strcmp(type, "vtkXMLUnstructuredGridReader") == 0)
-  {
-    reader = vtkXMLUnstructuredGridReader::New();
-  }
-  else if (strcmp(type, "vtkXMLPolyDataReader") == 0)
-  {
-    reader = vtkXMLPolyDataReader::New();
-  }
-  else if (strcmp(type, "vtkXMLRectilinearGridReader") == 0)
-  {
-    reader = vtkXMLRectilinearGridReader::New();
-  }
-  else if (strcmp(type, "vtkXMLStructuredGridReader") == 0)
-  {
-    reader = vtkXMLStructuredGridReader::New();
-  }
-  else if (strcmp(type, "vtkXMLTableReader") == 0)
-  {
-    reader = vtkXMLTableReader::New();
-  }
-  else if (strcmp(type, "vtkXMLHyperTreeGridReader") == 0)
-  {
-    reader = vtkXMLHyperTreeGridReader::New();
-  }
-  else if (strcmp(type, "vtkXMLStatisticalModelReader") == 0)
-  {
-    reader = vtkXMLStatisticalModelReader::New();
-  }
+  vtkXMLReader* reader = NewReaderOfType(type);
   if (reader)
   {
     if (this->GetParserErrorObserver())
@@ -280,27 +333,7 @@ vtkXMLReader* vtkXMLCompositeDataReader::GetReaderOfType(const char* type)
 //------------------------------------------------------------------------------
 vtkXMLReader* vtkXMLCompositeDataReader::GetReaderForFile(const std::string& fileName)
 {
-  // Get the file extension.
-  std::string ext = vtksys::SystemTools::GetFilenameLastExtension(fileName);
-  if (!ext.empty())
-  {
-    // remove "." from the extension.
-    ext.erase(0, 1);
-  }
-
-  // Search for the reader matching this extension.
-  const char* rname = nullptr;
-  for (const vtkXMLCompositeDataReaderEntry* readerEntry =
-         vtkXMLCompositeDataReaderInternals::ReaderList;
-       !rname && readerEntry->extension; ++readerEntry)
-  {
-    if (ext == readerEntry->extension)
-    {
-      rname = readerEntry->name;
-    }
-  }
-
-  return this->GetReaderOfType(rname);
+  return this->GetReaderOfType(GetReaderTypeForFile(fileName));
 }
 
 //------------------------------------------------------------------------------
@@ -376,10 +409,90 @@ void vtkXMLCompositeDataReader::ReadXMLData()
     this->Internal->HasUpdateRestriction = false;
   }
 
+  if (this->ReadPiecesConcurrently)
+  {
+    this->ReadLeavesConcurrently(composite, filePath.c_str());
+  }
+
   // All processes create the entire tree structure however, but each one only
   // reads the datasets assigned to it.
   unsigned int dataSetIndex = 0;
   this->ReadComposite(this->GetPrimaryElement(), composite, filePath.c_str(), dataSetIndex);
+  this->Internal->ReadLeaves.clear();
+}
+
+//------------------------------------------------------------------------------
+void vtkXMLCompositeDataReader::ReadLeavesConcurrently(
+  vtkCompositeDataSet* composite, const char* filePath)
+{
+  // Collect the leaves this process reads by building a throw-away tree.
+  vtkSmartPointer<vtkCompositeDataSet> scratch = vtk::TakeSmartPointer(composite->NewInstance());
+  unsigned int dataSetIndex = 0;
+  this->Internal->CollectingLeaves = true;
+  this->ReadComposite(this->GetPrimaryElement(), scratch, filePath, dataSetIndex);
+  this->Internal->CollectingLeaves = false;
+
+  auto leaves = std::move(this->Internal->LeavesToRead);
+  this->Internal->LeavesToRead.clear();
+  if (leaves.size() < 2)
+  {
+    return;
+  }
+
+  // The cached readers cannot be shared between threads: each leaf gets its
+  // own reader.  Errors are not reported from the worker threads, failed
+  // leaves are read again by ReadComposite with the usual error reporting.
+  const std::size_t numberOfLeaves = leaves.size();
+  std::vector<vtkSmartPointer<vtkXMLReader>> readers(numberOfLeaves);
+  std::vector<char> failed(numberOfLeaves, 0);
+  for (std::size_t i = 0; i < numberOfLeaves; ++i)
+  {
+    const char* type = GetReaderTypeForFile(leaves[i].second);
+    if (!type)
+    {
+      continue;
+    }
+    vtkSmartPointer<vtkXMLReader> reader = vtk::TakeSmartPointer(NewReaderOfType(type));
+    vtkNew<vtkCallbackCommand> onError;
+    onError->SetCallback(&FlagReadFailure);
+    onError->SetClientData(&failed[i]);
+    reader->AddObserver(vtkCommand::ErrorEvent, onError);
+    reader->SetParserErrorObserver(onError);
+    reader->SetFileName(leaves[i].second.c_str());
+    reader->SetSequentialProcessing(this->GetSequentialProcessing());
+    reader->GetPointDataArraySelection()->CopySelections(this->PointDataArraySelection);
+    reader->GetCellDataArraySelection()->CopySelections(this->CellDataArraySelection);
+    reader->GetColumnArraySelection()->CopySelections(this->ColumnArraySelection);
+    readers[i] = reader;
+  }
+
+  int numberOfThreads = this->NumberOfPieceReadingThreads > 0
+    ? this->NumberOfPieceReadingThreads
+    : vtkSMPTools::GetEstimatedNumberOfThreads();
+  numberOfThreads = std::max(1, std::min(numberOfThreads, static_cast<int>(numberOfLeaves)));
+
+  vtkNew<vtkThreadedCallbackQueue> queue;
+  queue->SetNumberOfThreads(numberOfThreads);
+  std::vector<vtkThreadedCallbackQueue::SharedFuturePointer<void>> futures;
+  for (std::size_t i = 0; i < numberOfLeaves; ++i)
+  {
+    if (readers[i])
+    {
+      futures.emplace_back(queue->Push([&readers, i]() { readers[i]->Update(); }));
+    }
+  }
+  queue->Wait(futures);
+
+  for (std::size_t i = 0; i < numberOfLeaves; ++i)
+  {
+    vtkDataObject* output = readers[i] ? readers[i]->GetOutputDataObject(0) : nullptr;
+    if (output && !failed[i] && readers[i]->GetErrorCode() == vtkErrorCode::NoError)
+    {
+      vtkSmartPointer<vtkDataObject> outputCopy = vtk::TakeSmartPointer(output->NewInstance());
+      outputCopy->ShallowCopy(output);
+      this->Internal->ReadLeaves[leaves[i].first] = outputCopy;
+    }
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -472,6 +585,19 @@ vtkDataObject* vtkXMLCompositeDataReader::ReadDataObject(
   { // No filename in XML element. Not necessarily an error.
     return nullptr;
   }
+  if (this->Internal->CollectingLeaves)
+  {
+    this->Internal->LeavesToRead.emplace_back(xmlElem, fileName);
+    return nullptr;
+  }
+  auto readLeaf = this->Internal->ReadLeaves.find(xmlElem);
+  if (readLeaf != this->Internal->ReadLeaves.end())
+  {
+    vtkDataObject* leaf = readLeaf->second;
+    leaf->Register(this);
+    this->Internal->ReadLeaves.erase(readLeaf);
+    return leaf;
+  }
   vtkXMLReader* reader = this->GetReaderForFile(fileName);
   if (!reader)
   {
@@ -479,6 +605,7 @@ vtkDataObject* vtkXMLCompositeDataReader::ReadDataObject(
     return nullptr;
   }
   reader->SetFileName(fileName.c_str());
+  reader->SetSequentialProcessing(this->GetSequentialProcessing());
   reader->GetPointDataArraySelection()->CopySelections(this->PointDataArraySelection);
   reader->GetCellDataArraySelection()->CopySelections(this->CellDataArraySelection);
   reader->GetColumnArraySelection()->CopySelections(this->ColumnArraySelection);
@@ -541,6 +668,7 @@ void vtkXMLCompositeDataReader::SyncDataArraySelections(
     return;
   }
   reader->SetFileName(fileName.c_str());
+  reader->SetSequentialProcessing(this->GetSequentialProcessing());
   // initialize array selection so we don't have any residual array selections
   // from previous use of the reader.
   reader->GetPointDataArraySelection()->RemoveAllArrays();
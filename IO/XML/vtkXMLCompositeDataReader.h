@@ -60,6 +60,28 @@ public:
   vtkGetMacro(PieceDistribution, int);
   /**@}*/
 
+  ///@{
+  /**
+   * When on, the files of the datasets assigned to this reader are read
+   * concurrently before the composite dataset is assembled, in the same
+   * order as when reading them one after the other.  Each file gets its own
+   * reader.  Default is off.
+   */
+  vtkSetMacro(ReadPiecesConcurrently, bool);
+  vtkGetMacro(ReadPiecesConcurrently, bool);
+  vtkBooleanMacro(ReadPiecesConcurrently, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Maximum number of files read at the same time when
+   * ReadPiecesConcurrently is on.  0, the default, uses
+   * vtkSMPTools::GetEstimatedNumberOfThreads().
+   */
+  vtkSetClampMacro(NumberOfPieceReadingThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPieceReadingThreads, int);
+  ///@}
+
   ///@{
   /**
    * Get the output data object for a port on this algorithm.
@@ -158,7 +180,13 @@ private:
     unsigned int datasetIndex, unsigned int numDatasets, int numPieces);
   ///@}
 
+  // Read the leaves assigned to this process concurrently. ReadDataObject
+  // then returns them instead of reading the files.
+  void ReadLeavesConcurrently(vtkCompositeDataSet* composite, const char* filePath);
+
   int PieceDistribution;
+  bool ReadPiecesConcurrently = false;
+  int NumberOfPieceReadingThreads = 0;
 
   vtkXMLCompositeDataReaderInternals* Internal;
 };
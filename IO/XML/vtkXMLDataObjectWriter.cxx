@@ -95,6 +95,7 @@ int vtkXMLDataObjectWriter::WriteInternal()
     writer->SetByteOrder(this->GetByteOrder());
     writer->SetCompressor(this->GetCompressor());
     writer->SetBlockSize(this->GetBlockSize());
+    writer->SetSequentialProcessing(this->GetSequentialProcessing());
     writer->SetDataMode(this->GetDataMode());
     writer->SetEncodeAppendedData(this->GetEncodeAppendedData());
     writer->SetWriteTimeValue(this->GetWriteTimeValue());
@@ -9,11 +9,16 @@
 #include "vtkDataSet.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkThreadedCallbackQueue.h"
 #include "vtkXMLDataElement.h"
 #include "vtkXMLDataReader.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <sstream>
 
@@ -39,6 +44,8 @@ void vtkXMLPDataReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "NumberOfPieces: " << this->NumberOfPieces << "\n";
+  os << indent << "ReadPiecesConcurrently: " << this->ReadPiecesConcurrently << "\n";
+  os << indent << "NumberOfPieceReadingThreads: " << this->NumberOfPieceReadingThreads << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -322,6 +329,7 @@ int vtkXMLPDataReader::ReadPiece(vtkXMLDataElement* ePiece)
   this->PieceReaders[this->Piece]->AddObserver(
     vtkCommand::ProgressEvent, this->PieceProgressObserver);
   reader->SetFileName(pieceFileName);
+  reader->SetSequentialProcessing(this->GetSequentialProcessing());
 
   delete[] pieceFileName;
 
@@ -349,6 +357,76 @@ int vtkXMLPDataReader::ReadPieceData(int index)
   return this->ReadPieceData();
 }
 
+//------------------------------------------------------------------------------
+bool vtkXMLPDataReader::UpdatePieceReadersConcurrently(
+  const std::vector<int>& pieces, const std::function<void(int)>& update)
+{
+  if (!this->ReadPiecesConcurrently || pieces.size() < 2)
+  {
+    return false;
+  }
+
+  // Setup the readers as ReadPieceData(int) does.  Unreadable pieces are
+  // reported when they are read sequentially.
+  std::vector<int> readablePieces;
+  for (int piece : pieces)
+  {
+    if (!this->CanReadPiece(piece))
+    {
+      continue;
+    }
+    vtkXMLDataReader* reader = this->PieceReaders[piece];
+    reader->SetAbortExecute(0);
+    reader->GetPointDataArraySelection()->CopySelections(this->PointDataArraySelection);
+    reader->GetCellDataArraySelection()->CopySelections(this->CellDataArraySelection);
+    // PieceProgressCallback works on the current piece only.
+    reader->RemoveObserver(this->PieceProgressObserver);
+    readablePieces.push_back(piece);
+  }
+
+  int numberOfThreads = this->NumberOfPieceReadingThreads > 0
+    ? this->NumberOfPieceReadingThreads
+    : vtkSMPTools::GetEstimatedNumberOfThreads();
+  numberOfThreads = std::max(1, std::min(numberOfThreads, static_cast<int>(readablePieces.size())));
+
+  vtkNew<vtkThreadedCallbackQueue> queue;
+  queue->SetNumberOfThreads(numberOfThreads);
+  std::atomic<bool> abort(false);
+  std::vector<vtkThreadedCallbackQueue::SharedFuturePointer<void>> futures;
+  futures.reserve(readablePieces.size());
+  for (int piece : readablePieces)
+  {
+    futures.emplace_back(queue->Push(
+      [&update, &abort, piece]()
+      {
+        if (!abort)
+        {
+          update(piece);
+        }
+      }));
+  }
+
+  // Report progress from this thread, in piece order.
+  float progressRange[2] = { 0.f, 0.f };
+  this->GetProgressRange(progressRange);
+  for (std::size_t i = 0; i < futures.size(); ++i)
+  {
+    queue->Get(futures[i]);
+    this->UpdateProgressDiscrete(progressRange[0] +
+      (progressRange[1] - progressRange[0]) * static_cast<float>(i + 1) / futures.size());
+    if (this->AbortExecute)
+    {
+      abort = true;
+    }
+  }
+
+  for (int piece : readablePieces)
+  {
+    this->PieceReaders[piece]->AddObserver(vtkCommand::ProgressEvent, this->PieceProgressObserver);
+  }
+  return true;
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLPDataReader::ReadPieceData()
 {
@@ -18,6 +18,9 @@
 #include "vtkIOXMLModule.h" // For export macro
 #include "vtkXMLPDataObjectReader.h"
 
+#include <functional> // For std::function
+#include <vector>     // For std::vector
+
 VTK_ABI_NAMESPACE_BEGIN
 class vtkAbstractArray;
 class vtkDataSet;
@@ -35,6 +38,30 @@ public:
    */
   void CopyOutputInformation(vtkInformation* outInfo, int port) override;
 
+  ///@{
+  /**
+   * When on, the piece files assigned to this reader are read concurrently,
+   * then appended to the output in piece order, so that the output is the
+   * same as when reading them one after the other.  This pays off when many
+   * pieces are read by a single process, for instance from a parallel file
+   * system.  Progress is then only reported once each piece is read, and
+   * aborting only stops between pieces.  Default is off.
+   */
+  vtkSetMacro(ReadPiecesConcurrently, bool);
+  vtkGetMacro(ReadPiecesConcurrently, bool);
+  vtkBooleanMacro(ReadPiecesConcurrently, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Maximum number of pieces read at the same time when
+   * ReadPiecesConcurrently is on.  0, the default, uses
+   * vtkSMPTools::GetEstimatedNumberOfThreads().
+   */
+  vtkSetClampMacro(NumberOfPieceReadingThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPieceReadingThreads, int);
+  ///@}
+
 protected:
   vtkXMLPDataReader();
   ~vtkXMLPDataReader() override;
@@ -96,6 +123,17 @@ protected:
    */
   virtual int ReadPieceData();
 
+  /**
+   * When ReadPiecesConcurrently is on, prepare the readers of the given
+   * pieces the way ReadPieceData(int) does, then run `update` on them
+   * concurrently.  `update` must run the same pipeline request as the
+   * subclass ReadPieceData(), which then finds the piece readers up to date
+   * and only copies their output.  Pieces that cannot be read are skipped.
+   * Returns false when nothing was done.
+   */
+  bool UpdatePieceReadersConcurrently(
+    const std::vector<int>& pieces, const std::function<void(int piece)>& update);
+
   /**
    * Read the information relative to the dataset and allocate the needed structures according to it
    */
@@ -125,6 +163,9 @@ protected:
   vtkXMLDataElement* PPointDataElement;
   vtkXMLDataElement* PCellDataElement;
 
+  bool ReadPiecesConcurrently = false;
+  int NumberOfPieceReadingThreads = 0;
+
 private:
   vtkXMLPDataReader(const vtkXMLPDataReader&) = delete;
   void operator=(const vtkXMLPDataReader&) = delete;
@@ -532,6 +532,7 @@ int vtkXMLPHyperTreeGridReader::ReadPiece(vtkXMLDataElement* ePiece)
   this->PieceReaders[this->Piece]->AddObserver(
     vtkCommand::ProgressEvent, this->PieceProgressObserver);
   reader->SetFileName(pieceFileName);
+  reader->SetSequentialProcessing(this->GetSequentialProcessing());
 
   delete[] pieceFileName;
 
@@ -11,7 +11,10 @@
 #include "vtkXMLDataElement.h"
 #include "vtkXMLStructuredDataReader.h"
 
+#include <array>
+#include <map>
 #include <sstream>
+#include <vector>
 
 //------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
@@ -125,6 +128,37 @@ void vtkXMLPStructuredDataReader::ReadXMLData()
     fractions[i] = fractions[i] / fractions[n];
   }
 
+  // Read the pieces concurrently if requested. Only pieces providing a
+  // single sub-extent are read ahead, the loop below then finds their
+  // readers up to date and copies the sub-extents in order.
+  if (this->ReadPiecesConcurrently)
+  {
+    std::map<int, int> subExtentOfPiece;
+    for (i = 0; i < n; ++i)
+    {
+      int piece = this->ExtentSplitter->GetSubExtentSource(i);
+      auto inserted = subExtentOfPiece.emplace(piece, i);
+      if (!inserted.second)
+      {
+        inserted.first->second = -1;
+      }
+    }
+    std::vector<int> pieces;
+    std::vector<std::array<int, 6>> subExtents(this->NumberOfPieces);
+    for (const auto& pieceAndSubExtent : subExtentOfPiece)
+    {
+      if (pieceAndSubExtent.second >= 0)
+      {
+        pieces.push_back(pieceAndSubExtent.first);
+        this->ExtentSplitter->GetSubExtent(
+          pieceAndSubExtent.second, subExtents[pieceAndSubExtent.first].data());
+      }
+    }
+    this->UpdatePieceReadersConcurrently(pieces,
+      [this, &subExtents](int piece)
+      { this->PieceReaders[piece]->UpdateExtent(subExtents[piece].data()); });
+  }
+
   // Read the data needed from each sub-extent.
   for (i = 0; (i < n && !this->AbortExecute && !this->DataError); ++i)
   {
@@ -557,6 +557,7 @@ int vtkXMLPTableReader::ReadPiece(vtkXMLDataElement* ePiece)
   this->PieceReaders[this->Piece]->AddObserver(
     vtkCommand::ProgressEvent, this->PieceProgressObserver);
   reader->SetFileName(pieceFileName);
+  reader->SetSequentialProcessing(this->GetSequentialProcessing());
 
   delete[] pieceFileName;
 
@@ -13,6 +13,9 @@
 #include "vtkXMLDataElement.h"
 #include "vtkXMLUnstructuredDataReader.h"
 
+#include <numeric>
+#include <vector>
+
 //------------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
 vtkXMLPUnstructuredDataReader::vtkXMLPUnstructuredDataReader()
@@ -289,6 +292,16 @@ void vtkXMLPUnstructuredDataReader::ReadXMLData()
     fractions[index + 1] = fractions[index + 1] / fractions[this->EndPiece - this->StartPiece];
   }
 
+  // Read the pieces concurrently if requested. The loop below then finds the
+  // piece readers up to date and appends their outputs in order.
+  if (this->ReadPiecesConcurrently)
+  {
+    std::vector<int> pieces(this->EndPiece - this->StartPiece);
+    std::iota(pieces.begin(), pieces.end(), this->StartPiece);
+    this->UpdatePieceReadersConcurrently(pieces,
+      [this](int piece) { this->PieceReaders[piece]->UpdatePiece(0, 1, this->UpdateGhostLevel); });
+  }
+
   // Read the data needed from each piece.
   for (int i = this->StartPiece; (i < this->EndPiece && !this->AbortExecute && !this->DataError);
        ++i)
@@ -39,6 +39,10 @@
 #include "vtkXMLReaderVersion.h"
 #include "vtkZLibDataCompressor.h"
 
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+#include "vtkZstdDataCompressor.h"
+#endif
+
 #include "vtksys/Encoding.hxx"
 #include "vtksys/FStream.hxx"
 #include <vtksys/SystemTools.hxx>
@@ -262,6 +266,7 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "NumberOfTimeSteps:" << this->NumberOfTimeSteps << "\n";
   os << indent << "TimeStepRange:(" << this->TimeStepRange[0] << "," << this->TimeStepRange[1]
      << ")\n";
+  os << indent << "SequentialProcessing:" << this->SequentialProcessing << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -528,6 +533,7 @@ void vtkXMLReader::CreateXMLParser()
     this->DestroyXMLParser();
   }
   this->XMLParser = vtkXMLDataParser::New();
+  this->XMLParser->SetSequentialProcessing(this->SequentialProcessing);
 }
 
 //------------------------------------------------------------------------------
@@ -568,6 +574,12 @@ void vtkXMLReader::SetupCompressor(const char* type)
     {
       compressor = vtkLZMADataCompressor::New();
     }
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+    else if (strcmp(type, "vtkZstdDataCompressor") == 0)
+    {
+      compressor = vtkZstdDataCompressor::New();
+    }
+#endif
   }
 
   if (!compressor)
@@ -222,6 +222,17 @@ public:
   vtkSetVector2Macro(TimeStepRange, int);
   ///@}
 
+  ///@{
+  /**
+   * Force the compressed data blocks to be decompressed one after another.
+   * By default, they are decompressed concurrently with vtkSMPTools (see
+   * vtkXMLDataParser::SetSequentialProcessing).  The default is false.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
   /**
    * Returns the internal XML parser. This can be used to access
    * the XML DOM after RequestInformation() was called.
@@ -556,6 +567,8 @@ private:
 
   bool ReadFromInputStream = false;
 
+  bool SequentialProcessing = false;
+
   // The stream used to read the input if it is in a file.
   istream* FileStream;
   // The stream used to read the input if it is in a string.
@@ -33,6 +33,8 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkStringFormatter.h"
@@ -1001,6 +1003,13 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
     }
 
+    // Compress and write the blocks still pending.
+    if (result && !this->FlushCompressionBlocks())
+    {
+      result = 0;
+    }
+    this->PendingCompressionBlocks.clear();
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
     {
@@ -1363,6 +1372,19 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
+  if (!this->SequentialProcessing)
+  {
+    // Keep a copy of the block, the data buffer is reused by the caller.
+    // Blocks are compressed concurrently once enough of them are pending.
+    this->PendingCompressionBlocks.emplace_back(data, data + size);
+    const size_t batchSize = 8 * static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+    if (this->PendingCompressionBlocks.size() >= batchSize)
+    {
+      return this->FlushCompressionBlocks();
+    }
+    return 1;
+  }
+
   // Compress the data.
   vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
 
@@ -1386,6 +1408,55 @@ int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
   return result;
 }
 
+//------------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks()
+{
+  std::vector<std::vector<unsigned char>>& blocks = this->PendingCompressionBlocks;
+  if (blocks.empty())
+  {
+    return 1;
+  }
+
+  // Compress all pending blocks concurrently. The compressors do not keep
+  // any state between calls so they can be shared by the threads.
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray>> outputArrays(blocks.size());
+  vtkDataCompressor* compressor = this->Compressor;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType blockId = begin; blockId < end; ++blockId)
+      {
+        const std::vector<unsigned char>& block = blocks[blockId];
+        outputArrays[blockId] =
+          vtk::TakeSmartPointer(compressor->Compress(block.data(), block.size()));
+      }
+    });
+  blocks.clear();
+
+  // Write the compressed blocks in order.
+  int result = 1;
+  for (vtkUnsignedCharArray* outputArray : outputArrays)
+  {
+    if (!outputArray)
+    {
+      vtkErrorMacro("Error compressing data block.");
+      return 0;
+    }
+    size_t outputSize = outputArray->GetNumberOfTuples();
+    if (!this->DataStream->Write(outputArray->GetPointer(0), outputSize))
+    {
+      result = 0;
+    }
+    this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
+  }
+  this->Stream->flush();
+  if (this->Stream->fail())
+  {
+    this->SetErrorCode(vtkErrorCode::GetLastSystemError());
+  }
+  return result;
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionHeader()
 {
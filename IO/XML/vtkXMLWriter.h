@@ -22,6 +22,7 @@
 #include "vtkXMLWriterBase.h"
 
 #include <sstream> // For ostringstream ivar
+#include <vector>  // For std::vector ivar
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkAbstractArray;
@@ -142,6 +143,9 @@ protected:
   vtkXMLDataHeader* CompressionHeader;
   vtkTypeInt64 CompressionHeaderPosition;
 
+  // Uncompressed blocks waiting to be compressed concurrently.
+  std::vector<std::vector<unsigned char>> PendingCompressionBlocks;
+
   // The output stream used to write binary and appended data.  May
   // transparently encode the data.
   vtkOutputStream* DataStream;
@@ -257,6 +261,7 @@ protected:
   void PerformByteSwap(void* data, size_t numWords, size_t wordSize);
   int CreateCompressionHeader(size_t size);
   int WriteCompressionBlock(unsigned char* data, size_t size);
+  int FlushCompressionBlocks();
   int WriteCompressionHeader();
   size_t GetWordTypeSize(int dataType);
   const char* GetWordTypeName(int dataType);
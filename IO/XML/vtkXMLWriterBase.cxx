@@ -11,6 +11,10 @@
 #include "vtkXMLReaderVersion.h"
 #include "vtkZLibDataCompressor.h"
 
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+#include "vtkZstdDataCompressor.h"
+#endif
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkCxxSetObjectMacro(vtkXMLWriterBase, Compressor, vtkDataCompressor);
 //----------------------------------------------------------------------------
@@ -100,6 +104,7 @@ void vtkXMLWriterBase::SetCompressorType(int compressorType)
     }
     this->Compressor = vtkZLibDataCompressor::New();
     this->Compressor->SetCompressionLevel(this->CompressionLevel);
+    this->CompressionLevel = this->Compressor->GetCompressionLevel();
     this->Modified();
   }
   else if (compressorType == LZ4)
@@ -110,6 +115,7 @@ void vtkXMLWriterBase::SetCompressorType(int compressorType)
     }
     this->Compressor = vtkLZ4DataCompressor::New();
     this->Compressor->SetCompressionLevel(this->CompressionLevel);
+    this->CompressionLevel = this->Compressor->GetCompressionLevel();
     this->Modified();
   }
   else if (compressorType == LZMA)
@@ -120,8 +126,24 @@ void vtkXMLWriterBase::SetCompressorType(int compressorType)
     }
     this->Compressor = vtkLZMADataCompressor::New();
     this->Compressor->SetCompressionLevel(this->CompressionLevel);
+    this->CompressionLevel = this->Compressor->GetCompressionLevel();
     this->Modified();
   }
+  else if (compressorType == ZSTD)
+  {
+#if VTK_MODULE_ENABLE_VTK_IOZstd
+    if (this->Compressor)
+    {
+      this->Compressor->Delete();
+    }
+    this->Compressor = vtkZstdDataCompressor::New();
+    this->Compressor->SetCompressionLevel(this->CompressionLevel);
+    this->CompressionLevel = this->Compressor->GetCompressionLevel();
+    this->Modified();
+#else
+    vtkErrorMacro("Zstd compression requires the VTK::IOZstd module.");
+#endif
+  }
   else
   {
     vtkWarningMacro("Invalid compressorType:" << compressorType);
@@ -130,18 +152,24 @@ void vtkXMLWriterBase::SetCompressorType(int compressorType)
 //------------------------------------------------------------------------------
 void vtkXMLWriterBase::SetCompressionLevel(int compressionLevel)
 {
-  constexpr int min = 1;
-  constexpr int max = 9;
   vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting "
                 << "CompressionLevel  to " << compressionLevel);
-  compressionLevel = std::clamp(compressionLevel, min, max);
+  // The compressor clamps the level to the range it supports, which always
+  // includes 1 to 9. Without compressor, the level is clamped to 1 to 9.
+  if (this->Compressor)
+  {
+    this->Compressor->SetCompressionLevel(compressionLevel);
+    compressionLevel = this->Compressor->GetCompressionLevel();
+  }
+  else
+  {
+    constexpr int min = 1;
+    constexpr int max = 9;
+    compressionLevel = std::clamp(compressionLevel, min, max);
+  }
   if (this->CompressionLevel != compressionLevel)
   {
     this->CompressionLevel = compressionLevel;
-    if (this->Compressor)
-    {
-      this->Compressor->SetCompressionLevel(compressionLevel);
-    }
     this->Modified();
   }
 }
@@ -257,5 +285,6 @@ void vtkXMLWriterBase::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
+  os << indent << "SequentialProcessing: " << this->SequentialProcessing << "\n";
 }
 VTK_ABI_NAMESPACE_END
@@ -139,24 +139,29 @@ public:
     NONE,
     ZLIB,
     LZ4,
-    LZMA
+    LZMA,
+    ZSTD
   };
 
   ///@{
   /**
    * Convenience functions to set the compressor to certain known types.
+   * ZSTD requires the VTK::IOZstd module.
    */
   void SetCompressorType(int compressorType);
   void SetCompressorTypeToNone() { this->SetCompressorType(NONE); }
   void SetCompressorTypeToLZ4() { this->SetCompressorType(LZ4); }
   void SetCompressorTypeToZLib() { this->SetCompressorType(ZLIB); }
   void SetCompressorTypeToLZMA() { this->SetCompressorType(LZMA); }
+  void SetCompressorTypeToZstd() { this->SetCompressorType(ZSTD); }
   ///@}
 
   ///@{
   /**
    * Get/Set compression level.
    * 1 (worst compression, fastest) ... 9 (best compression, slowest).
+   * The level is clamped to the range supported by the compressor, for
+   * instance vtkZstdDataCompressor also accepts negative and higher levels.
    */
   void SetCompressionLevel(int compressorLevel);
   vtkGetMacro(CompressionLevel, int);
@@ -173,6 +178,20 @@ public:
   vtkGetMacro(BlockSize, size_t);
   ///@}
 
+  ///@{
+  /**
+   * Force the compression blocks to be compressed one after another.  By
+   * default, consecutive blocks are buffered and compressed concurrently
+   * with vtkSMPTools, then written in order: the files are byte-identical
+   * in both cases.  The compressor must support concurrent calls to its
+   * Compress methods, which is the case of the compressors provided by VTK.
+   * The default is false.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
   ///@{
   /**
    * Get/Set the data mode used for the file's data.  The options are
@@ -263,6 +282,9 @@ protected:
   // 1 (worst compression, fastest) ... 9 (best compression, slowest)
   int CompressionLevel;
 
+  // Whether compression blocks are compressed one after another.
+  bool SequentialProcessing = false;
+
   // This variable is used to ease transition to new versions of VTK XML files.
   // If data that needs to be written satisfies certain conditions,
   // the writer can use the previous file version version.
@@ -8,6 +8,7 @@
 #include "vtkDataCompressor.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkStringScanner.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
@@ -15,6 +16,7 @@
 #undef vtkXMLDataHeaderPrivate_DoNotInclude
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cctype>
 #include <memory>
@@ -105,6 +107,7 @@ void vtkXMLDataParser::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Progress: " << this->Progress << "\n";
   os << indent << "Abort: " << this->Abort << "\n";
   os << indent << "AttributesEncoding: " << this->AttributesEncoding << "\n";
+  os << indent << "SequentialProcessing: " << this->SequentialProcessing << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -628,6 +631,47 @@ unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block)
   return decompressBuffer;
 }
 
+//------------------------------------------------------------------------------
+int vtkXMLDataParser::ReadBlocks(
+  vtkTypeUInt64 firstBlock, vtkTypeUInt64 endBlock, unsigned char* buffer, size_t wordSize)
+{
+  // The compressed blocks are contiguous in the stream: read them at once.
+  vtkTypeInt64 const beginOffset = this->BlockStartOffsets[firstBlock];
+  size_t const compressedSize = static_cast<size_t>(this->BlockStartOffsets[endBlock - 1] +
+    this->BlockCompressedSizes[endBlock - 1] - beginOffset);
+  if (!this->DataStream->Seek(beginOffset))
+  {
+    return 0;
+  }
+  std::vector<unsigned char> readBuffer(compressedSize);
+  if (this->DataStream->Read(readBuffer.data(), compressedSize) < compressedSize)
+  {
+    return 0;
+  }
+
+  // Decompress and byte swap the blocks concurrently.  Only complete blocks
+  // are read here so they all have the same uncompressed size.
+  size_t const blockSize = this->BlockUncompressedSize;
+  std::atomic<bool> failed(false);
+  vtkSMPTools::For(static_cast<vtkIdType>(firstBlock), static_cast<vtkIdType>(endBlock),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType block = begin; block < end; ++block)
+      {
+        unsigned char* outputPointer = buffer + (block - firstBlock) * blockSize;
+        if (!this->Compressor->Uncompress(readBuffer.data() +
+                (this->BlockStartOffsets[block] - beginOffset),
+              this->BlockCompressedSizes[block], outputPointer, blockSize))
+        {
+          failed = true;
+          return;
+        }
+        this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
+      }
+    });
+  return !failed;
+}
+
 //------------------------------------------------------------------------------
 size_t vtkXMLDataParser::ReadUncompressedData(
   unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize)
@@ -794,7 +838,28 @@ size_t vtkXMLDataParser::ReadCompressedData(
     // Report progress.
     this->UpdateProgress(float(outputPointer - data) / length);
 
-    unsigned int currentBlock = firstBlock + 1;
+    vtkTypeUInt64 currentBlock = firstBlock + 1;
+    if (!this->SequentialProcessing)
+    {
+      // Decompress the complete blocks by batches, processed concurrently.
+      vtkTypeUInt64 const batchSize =
+        8 * static_cast<vtkTypeUInt64>(vtkSMPTools::GetEstimatedNumberOfThreads());
+      while (currentBlock != lastBlock && !this->Abort)
+      {
+        vtkTypeUInt64 const endBlock = std::min(currentBlock + batchSize, lastBlock);
+        if (!this->ReadBlocks(currentBlock, endBlock, outputPointer, wordSize))
+        {
+          return 0;
+        }
+
+        // Advance the pointer to the beginning of the next batch.
+        outputPointer += (endBlock - currentBlock) * blockSize;
+        currentBlock = endBlock;
+
+        // Report progress.
+        this->UpdateProgress(float(outputPointer - data) / length);
+      }
+    }
     for (; currentBlock != lastBlock && !this->Abort; ++currentBlock)
     {
       // Read this block.
@@ -91,6 +91,19 @@ public:
   vtkGetObjectMacro(Compressor, vtkDataCompressor);
   ///@}
 
+  ///@{
+  /**
+   * Force the compression blocks to be decompressed one after another.  By
+   * default, consecutive complete blocks are read at once and decompressed
+   * concurrently with vtkSMPTools.  The compressor must support concurrent
+   * calls to its Uncompress methods, which is the case of the compressors
+   * provided by VTK.  The default is false.
+   */
+  vtkSetMacro(SequentialProcessing, bool);
+  vtkGetMacro(SequentialProcessing, bool);
+  vtkBooleanMacro(SequentialProcessing, bool);
+  ///@}
+
   /**
    * Get the size of a word of the given type.
    */
@@ -175,6 +188,8 @@ protected:
   size_t FindBlockSize(vtkTypeUInt64 block);
   int ReadBlock(vtkTypeUInt64 block, unsigned char* buffer);
   unsigned char* ReadBlock(vtkTypeUInt64 block);
+  int ReadBlocks(
+    vtkTypeUInt64 firstBlock, vtkTypeUInt64 endBlock, unsigned char* buffer, size_t wordSize);
   size_t ReadUncompressedData(
     unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize);
   size_t ReadCompressedData(
@@ -231,6 +246,7 @@ protected:
   size_t PartialLastBlockUncompressedSize;
   size_t* BlockCompressedSizes;
   vtkTypeInt64* BlockStartOffsets;
+  bool SequentialProcessing = false;
 
   // Ascii data parsing.
   unsigned char* AsciiDataBuffer;
@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Round trip data through vtkZstdDataCompressor with various settings, and
+// through the VTK XML writer and reader.
+
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+#include "vtkZstdDataCompressor.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+bool RoundTrip(vtkZstdDataCompressor* compressor, const std::vector<float>& values)
+{
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(values.data());
+  const size_t size = values.size() * sizeof(float);
+  vtkSmartPointer<vtkUnsignedCharArray> compressed =
+    vtk::TakeSmartPointer(compressor->Compress(data, size));
+  if (!compressed)
+  {
+    std::cerr << "Error: compression failed" << std::endl;
+    return false;
+  }
+  vtkSmartPointer<vtkUnsignedCharArray> uncompressed = vtk::TakeSmartPointer(
+    compressor->Uncompress(compressed->GetPointer(0), compressed->GetNumberOfValues(), size));
+  if (!uncompressed || uncompressed->GetNumberOfValues() != static_cast<vtkIdType>(size) ||
+    std::memcmp(uncompressed->GetPointer(0), data, size) != 0)
+  {
+    std::cerr << "Error: wrong decompressed data" << std::endl;
+    return false;
+  }
+  std::cout << "Level " << compressor->GetCompressionLevel() << ", long distance matching "
+            << compressor->GetLongDistanceMatching() << ", workers "
+            << compressor->GetNumberOfWorkers() << ", dictionary "
+            << compressor->GetDictionarySize() << ": " << size << " -> "
+            << compressed->GetNumberOfValues() << " bytes\n";
+  return true;
+}
+
+bool TestXMLRoundTrip()
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(100);
+  sphere->SetPhiResolution(50);
+  sphere->Update();
+  vtkPolyData* input = sphere->GetOutput();
+
+  vtkNew<vtkXMLPolyDataWriter> writer;
+  writer->SetInputData(input);
+  writer->WriteToOutputStringOn();
+  writer->SetCompressorTypeToZstd();
+  writer->Write();
+  if (!vtkZstdDataCompressor::SafeDownCast(writer->GetCompressor()))
+  {
+    std::cerr << "Error: the writer does not use a vtkZstdDataCompressor" << std::endl;
+    return false;
+  }
+
+  vtkNew<vtkXMLPolyDataReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(writer->GetOutputString());
+  reader->Update();
+  vtkPolyData* output = reader->GetOutput();
+  if (output->GetNumberOfPoints() != input->GetNumberOfPoints() ||
+    output->GetNumberOfPolys() != input->GetNumberOfPolys())
+  {
+    std::cerr << "Error: wrong data read back from the XML file" << std::endl;
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    input->GetPoint(ptId, x);
+    output->GetPoint(ptId, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Error: wrong coordinates for point " << ptId << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// The compression level of the writer is the one used by its compressor.
+bool TestWriterCompressionLevel()
+{
+  vtkNew<vtkXMLPolyDataWriter> writer;
+  writer->SetCompressorTypeToNone();
+  writer->SetCompressionLevel(42);
+  const int noneLevel = writer->GetCompressionLevel();
+  writer->SetCompressorTypeToZstd();
+  writer->SetCompressionLevel(19);
+  const int zstdLevel = writer->GetCompressionLevel();
+  writer->SetCompressorTypeToZLib();
+  const int zlibLevel = writer->GetCompressionLevel();
+  if (noneLevel != 9 || zstdLevel != 19 || zlibLevel != 9 ||
+    writer->GetCompressor()->GetCompressionLevel() != zlibLevel)
+  {
+    std::cerr << "Error: wrong compression levels " << noneLevel << ", " << zstdLevel << ", "
+              << zlibLevel << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestZstdDataCompressor(int, char*[])
+{
+  // A smooth field, similar to simulation data.
+  std::vector<float> values(1 << 20);
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = static_cast<float>(std::sin(0.001 * i) * std::cos(0.00003 * i));
+  }
+
+  bool status = true;
+  vtkNew<vtkZstdDataCompressor> compressor;
+  for (int level : { -5, 1, 3, 9, 19 })
+  {
+    compressor->SetCompressionLevel(level);
+    status &= RoundTrip(compressor, values);
+  }
+  compressor->SetCompressionLevel(3);
+  compressor->LongDistanceMatchingOn();
+  status &= RoundTrip(compressor, values);
+  compressor->SetNumberOfWorkers(2);
+  status &= RoundTrip(compressor, values);
+  compressor->LongDistanceMatchingOff();
+  compressor->SetNumberOfWorkers(0);
+
+  // Use the beginning of the field as a raw dictionary.
+  compressor->SetDictionary(
+    reinterpret_cast<const unsigned char*>(values.data()), 1024 * sizeof(float));
+  status &= RoundTrip(compressor, values);
+  compressor->SetDictionary(nullptr, 0);
+
+  status &= TestXMLRoundTrip();
+  status &= TestWriterCompressionLevel();
+  return status ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,270 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkZstdDataCompressor.h"
+#include "vtkObjectFactory.h"
+
+#include <zstd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+VTK_ABI_NAMESPACE_BEGIN
+vtkStandardNewMacro(vtkZstdDataCompressor);
+
+struct vtkZstdDataCompressor::vtkInternals
+{
+  ZSTD_CDict* CompressionDictionary = nullptr;
+  ZSTD_DDict* DecompressionDictionary = nullptr;
+
+  // Contexts not used by any call. The XML writers and readers call the
+  // compressor once per block, from several threads: each call takes a
+  // context from the pool and gives it back, so that only as many contexts as
+  // concurrent calls are ever allocated.
+  std::mutex ContextsMutex;
+  std::vector<ZSTD_CCtx*> CompressionContexts;
+  std::vector<ZSTD_DCtx*> DecompressionContexts;
+
+  std::atomic<bool> WorkersWarningShown{ false };
+
+  ~vtkInternals()
+  {
+    this->Clear();
+    for (ZSTD_CCtx* context : this->CompressionContexts)
+    {
+      ZSTD_freeCCtx(context);
+    }
+    for (ZSTD_DCtx* context : this->DecompressionContexts)
+    {
+      ZSTD_freeDCtx(context);
+    }
+  }
+
+  void Clear()
+  {
+    ZSTD_freeCDict(this->CompressionDictionary);
+    this->CompressionDictionary = nullptr;
+    ZSTD_freeDDict(this->DecompressionDictionary);
+    this->DecompressionDictionary = nullptr;
+  }
+
+  // The returned context has its default parameters and no dictionary.
+  ZSTD_CCtx* AcquireCompressionContext()
+  {
+    ZSTD_CCtx* context = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(this->ContextsMutex);
+      if (!this->CompressionContexts.empty())
+      {
+        context = this->CompressionContexts.back();
+        this->CompressionContexts.pop_back();
+      }
+    }
+    if (!context)
+    {
+      return ZSTD_createCCtx();
+    }
+    ZSTD_CCtx_reset(context, ZSTD_reset_session_and_parameters);
+    return context;
+  }
+
+  void ReleaseCompressionContext(ZSTD_CCtx* context)
+  {
+    std::lock_guard<std::mutex> lock(this->ContextsMutex);
+    this->CompressionContexts.push_back(context);
+  }
+
+  ZSTD_DCtx* AcquireDecompressionContext()
+  {
+    ZSTD_DCtx* context = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(this->ContextsMutex);
+      if (!this->DecompressionContexts.empty())
+      {
+        context = this->DecompressionContexts.back();
+        this->DecompressionContexts.pop_back();
+      }
+    }
+    if (!context)
+    {
+      return ZSTD_createDCtx();
+    }
+    ZSTD_DCtx_reset(context, ZSTD_reset_session_and_parameters);
+    return context;
+  }
+
+  void ReleaseDecompressionContext(ZSTD_DCtx* context)
+  {
+    std::lock_guard<std::mutex> lock(this->ContextsMutex);
+    this->DecompressionContexts.push_back(context);
+  }
+};
+
+//------------------------------------------------------------------------------
+vtkZstdDataCompressor::vtkZstdDataCompressor()
+  : Internals(new vtkInternals)
+{
+  this->CompressionLevel = ZSTD_CLEVEL_DEFAULT;
+}
+
+//------------------------------------------------------------------------------
+vtkZstdDataCompressor::~vtkZstdDataCompressor() = default;
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "CompressionLevel: " << this->CompressionLevel << endl;
+  os << indent << "LongDistanceMatching: " << this->LongDistanceMatching << endl;
+  os << indent << "NumberOfWorkers: " << this->NumberOfWorkers << endl;
+  os << indent << "DictionarySize: " << this->Dictionary.size() << endl;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+  size_t uncompressedSize, unsigned char* compressedData, size_t compressionSpace)
+{
+  // Each call uses its own context, which keeps this method safe to call from
+  // several threads.
+  ZSTD_CCtx* context = this->Internals->AcquireCompressionContext();
+  if (!context)
+  {
+    vtkErrorMacro("Memory allocation failed.");
+    return 0;
+  }
+
+  size_t result = ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, this->CompressionLevel);
+  if (!ZSTD_isError(result) && this->LongDistanceMatching)
+  {
+    result = ZSTD_CCtx_setParameter(context, ZSTD_c_enableLongDistanceMatching, 1);
+  }
+  if (!ZSTD_isError(result) && this->NumberOfWorkers > 0 &&
+    ZSTD_isError(ZSTD_CCtx_setParameter(context, ZSTD_c_nbWorkers, this->NumberOfWorkers)) &&
+    !this->Internals->WorkersWarningShown.exchange(true))
+  {
+    vtkWarningMacro("The zstd library does not support multithreading, "
+                    "compressing in the calling thread.");
+  }
+  if (!ZSTD_isError(result) && this->Internals->CompressionDictionary)
+  {
+    result = ZSTD_CCtx_refCDict(context, this->Internals->CompressionDictionary);
+  }
+  if (!ZSTD_isError(result))
+  {
+    result = ZSTD_compress2(
+      context, compressedData, compressionSpace, uncompressedData, uncompressedSize);
+  }
+  this->Internals->ReleaseCompressionContext(context);
+
+  if (ZSTD_isError(result))
+  {
+    vtkErrorMacro("Zstd compression error: " << ZSTD_getErrorName(result));
+    return 0;
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::UncompressBuffer(unsigned char const* compressedData,
+  size_t compressedSize, unsigned char* uncompressedData, size_t uncompressedSize)
+{
+  ZSTD_DCtx* context = this->Internals->AcquireDecompressionContext();
+  if (!context)
+  {
+    vtkErrorMacro("Memory allocation failed.");
+    return 0;
+  }
+
+  size_t result = 0;
+  if (this->Internals->DecompressionDictionary)
+  {
+    result = ZSTD_DCtx_refDDict(context, this->Internals->DecompressionDictionary);
+  }
+  if (!ZSTD_isError(result))
+  {
+    result = ZSTD_decompressDCtx(
+      context, uncompressedData, uncompressedSize, compressedData, compressedSize);
+  }
+  this->Internals->ReleaseDecompressionContext(context);
+
+  if (ZSTD_isError(result))
+  {
+    vtkErrorMacro("Zstd decompression error: " << ZSTD_getErrorName(result));
+    return 0;
+  }
+  if (result != uncompressedSize)
+  {
+    vtkErrorMacro("Decompression produced " << result << " bytes, expected " << uncompressedSize
+                                            << ".");
+    return 0;
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+int vtkZstdDataCompressor::GetCompressionLevel()
+{
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): returning CompressionLevel "
+                << this->CompressionLevel);
+  return this->CompressionLevel;
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetCompressionLevel(int compressionLevel)
+{
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting CompressionLevel to "
+                << compressionLevel);
+  compressionLevel = std::min(std::max(compressionLevel, ZSTD_minCLevel()), ZSTD_maxCLevel());
+  if (this->CompressionLevel != compressionLevel)
+  {
+    this->CompressionLevel = compressionLevel;
+    // The digested compression dictionary depends on the level.
+    this->UpdateDigestedDictionaries();
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetDictionary(const unsigned char* dictionary, size_t size)
+{
+  if (!dictionary)
+  {
+    size = 0;
+  }
+  if (size == this->Dictionary.size() &&
+    std::equal(this->Dictionary.begin(), this->Dictionary.end(), dictionary))
+  {
+    return;
+  }
+  this->Dictionary.assign(dictionary, dictionary + size);
+  this->UpdateDigestedDictionaries();
+  this->Modified();
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::UpdateDigestedDictionaries()
+{
+  this->Internals->Clear();
+  if (this->Dictionary.empty())
+  {
+    return;
+  }
+  this->Internals->CompressionDictionary =
+    ZSTD_createCDict(this->Dictionary.data(), this->Dictionary.size(), this->CompressionLevel);
+  this->Internals->DecompressionDictionary =
+    ZSTD_createDDict(this->Dictionary.data(), this->Dictionary.size());
+  if (!this->Internals->CompressionDictionary || !this->Internals->DecompressionDictionary)
+  {
+    vtkErrorMacro("Could not load the zstd dictionary.");
+    this->Internals->Clear();
+  }
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  return ZSTD_compressBound(size);
+}
+VTK_ABI_NAMESPACE_END
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkZstdDataCompressor
+ * @brief   Data compression using Zstandard.
+ *
+ * vtkZstdDataCompressor provides a concrete vtkDataCompressor class
+ * using Zstandard (zstd) for compressing and uncompressing data.
+ *
+ * The compression level is passed to zstd as is. Levels 1 to 9 follow the
+ * vtkDataCompressor convention (1 is fastest, 9 gives the best ratio among
+ * them); zstd also accepts higher levels up to ZSTD_maxCLevel() and
+ * negative "fast" levels down to ZSTD_minCLevel(), which trade compression
+ * ratio for speed. vtkXMLWriterBase::SetCompressionLevel passes these levels
+ * through to the compressor.
+ *
+ * Long distance matching and multithreaded compression of each frame can be
+ * enabled; neither is required to decompress the data. Multithreaded
+ * compression requires a zstd library built with multithreading support.
+ *
+ * A raw or trained dictionary may also be provided. The same dictionary is
+ * then needed to uncompress the data. Since the VTK XML readers instantiate
+ * their compressor from the class name stored in the file, a dictionary
+ * should not be used when writing VTK XML files.
+ *
+ * The compression and decompression methods do not modify the compressor,
+ * so they can be called concurrently.
+ */
+
+#ifndef vtkZstdDataCompressor_h
+#define vtkZstdDataCompressor_h
+
+#include "vtkDataCompressor.h"
+#include "vtkIOZstdModule.h" // For export macro
+
+#include <memory> // For std::unique_ptr
+#include <vector> // For std::vector
+
+VTK_ABI_NAMESPACE_BEGIN
+class VTKIOZSTD_EXPORT vtkZstdDataCompressor : public vtkDataCompressor
+{
+public:
+  vtkTypeMacro(vtkZstdDataCompressor, vtkDataCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  static vtkZstdDataCompressor* New();
+
+  /**
+   *  Get the maximum space that may be needed to store data of the
+   *  given uncompressed size after compression.  This is the minimum
+   *  size of the output buffer that can be passed to the four-argument
+   *  Compress method.
+   */
+  size_t GetMaximumCompressionSpace(size_t size) override;
+
+  ///@{
+  /**
+   * Get/Set the compression level, clamped between ZSTD_minCLevel() and
+   * ZSTD_maxCLevel().  The default is 3, the zstd default level.
+   */
+  void SetCompressionLevel(int compressionLevel) override;
+  int GetCompressionLevel() override;
+  ///@}
+
+  ///@{
+  /**
+   * Enable long distance matching, which finds matches in a large window
+   * (128 MB) and improves the ratio of large inputs with long-range
+   * redundancy.  The default is false.
+   */
+  vtkSetMacro(LongDistanceMatching, bool);
+  vtkGetMacro(LongDistanceMatching, bool);
+  vtkBooleanMacro(LongDistanceMatching, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Number of zstd worker threads compressing each frame.  0, the default,
+   * compresses in the calling thread.  Only large buffers benefit from
+   * workers: the VTK XML writers already compress their blocks concurrently.
+   */
+  vtkSetClampMacro(NumberOfWorkers, int, 0, 200);
+  vtkGetMacro(NumberOfWorkers, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set the dictionary used to compress and uncompress data, either a raw
+   * content or a dictionary trained with `zstd --train`.  The dictionary is
+   * copied.  Pass a null pointer or a zero size to remove the dictionary.
+   */
+  void SetDictionary(const unsigned char* dictionary, size_t size);
+  const unsigned char* GetDictionary() { return this->Dictionary.data(); }
+  size_t GetDictionarySize() { return this->Dictionary.size(); }
+  ///@}
+
+protected:
+  vtkZstdDataCompressor();
+  ~vtkZstdDataCompressor() override;
+
+  int CompressionLevel;
+  bool LongDistanceMatching = false;
+  int NumberOfWorkers = 0;
+  std::vector<unsigned char> Dictionary;
+
+  // Compression method required by vtkDataCompressor.
+  size_t CompressBuffer(unsigned char const* uncompressedData, size_t uncompressedSize,
+    unsigned char* compressedData, size_t compressionSpace) override;
+  // Decompression method required by vtkDataCompressor.
+  size_t UncompressBuffer(unsigned char const* compressedData, size_t compressedSize,
+    unsigned char* uncompressedData, size_t uncompressedSize) override;
+
+private:
+  vtkZstdDataCompressor(const vtkZstdDataCompressor&) = delete;
+  void operator=(const vtkZstdDataCompressor&) = delete;
+
+  // Digested dictionaries, shared by all compression and decompression
+  // calls. They are rebuilt when the dictionary or the level change. The
+  // internals also pool the zstd contexts reused from call to call.
+  void UpdateDigestedDictionaries();
+  struct vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+VTK_ABI_NAMESPACE_END
+#endif